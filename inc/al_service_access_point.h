@@ -4,6 +4,8 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <chrono>
+#include <map>
 
 
 #include "al_service_data_unit.h"
@@ -54,6 +56,22 @@ public:
 	 */
 	void serviceAccessPointDataRequest(AlServiceDataUnit& message);
 
+	/**!
+	 * @brief Sends a frame straight from the caller's buffer.
+	 *
+	 * Each fragment is written with one sendmsg() of the serialized header and a slice of
+	 * @p payload, so the frame is not copied in user space.
+	 *
+	 * @param[in] source Source AL MAC address.
+	 * @param[in] destination Destination AL MAC address.
+	 * @param[in] payload The 1905 frame.
+	 * @param[in] length Length of the frame in bytes.
+	 *
+	 * @note Throws AlServiceException on the same conditions as the AlServiceDataUnit overload.
+	 */
+	void serviceAccessPointDataRequest(const MacAddress& source, const MacAddress& destination,
+	                                   const unsigned char *payload, size_t length);
+
     // Executes service indication primitive (receive a message)
     
 	/**!
@@ -70,6 +88,62 @@ public:
 	 */
 	AlServiceDataUnit serviceAccessPointDataIndication();  // Fills and returns an AlServiceDataUnit object
 
+	/**!
+	 * @brief Receives the next SDU into @p message.
+	 *
+	 * Same as the returning overload, except the payload of @p message is resized in place
+	 * so a caller that keeps one AlServiceDataUnit per connection does not allocate once
+	 * its payload has grown to the largest SDU.
+	 *
+	 * @param[out] message The data unit received at the service access point.
+	 *
+	 * @note Throws AlServiceException on the same conditions as the returning overload.
+	 */
+	void serviceAccessPointDataIndication(AlServiceDataUnit& message);
+
+    // Non-blocking service indication primitive (receive every message that is ready)
+
+	/**!
+	 * @brief Drains the data socket without blocking and returns the completed SDUs.
+	 *
+	 * Fragments are reassembled per source and destination AL MAC, so fragments of
+	 * different senders may interleave. Each frame is read as its fixed size header, then
+	 * fragmentSize payload bytes for a non-last fragment or what its sender wrote for the
+	 * last one. A frame split over several reads is resumed on the next call. An out of
+	 * order fragment drops only the affected partial SDU. Partial SDUs older than the
+	 * reassembly timeout are discarded. Meant to be called when select() reports the data
+	 * socket readable.
+	 *
+	 * The caller keeps @p sdus from one call to the next. Completed SDUs are written to its
+	 * first @p count elements, received in place into their payload buffers, and the vector
+	 * only grows when a batch is larger than any before it.
+	 *
+	 * @param[in,out] sdus Slots the completed SDUs are received into.
+	 * @param[in] maxSdus Stop after this many completed SDUs, the rest is left in the socket.
+	 * @param[out] count Number of completed SDUs at the front of @p sdus.
+	 *
+	 * @returns PrimitiveError::Success once the socket has no more data or the batch is full,
+	 * PrimitiveError::SocketClosed if the peer went away, PrimitiveError::IndicationFailed on
+	 * any other receive error.
+	 *
+	 * @note Does not throw.
+	 */
+	PrimitiveError serviceAccessPointDataIndication(std::vector<AlServiceDataUnit>& sdus, size_t maxSdus, size_t& count);
+
+	/**!
+	 * @brief Connects the data and control sockets again after the peer went away.
+	 *
+	 * The new connections take over the existing descriptor numbers, so descriptors handed
+	 * out by getDataSocketDescriptor() stay valid. Partial SDUs are dropped and the last
+	 * registration request, if any, is sent again.
+	 *
+	 * @returns PrimitiveError::Success once connected and registered, the failing primitive's
+	 * error otherwise. The previous connections are left in place on failure.
+	 *
+	 * @note Does not throw.
+	 */
+	PrimitiveError reconnect();
+
      // Executes service request primitive (send a message)
     
 	/**!
@@ -152,6 +226,48 @@ public:
 
 
     private:
+    // Largest payload carried by one fragment, a fragment with its header fits in 1500 bytes
+    static constexpr size_t fragmentSize = 1485;
+
+    // Partial SDUs not completed within this time are dropped
+    static constexpr std::chrono::seconds reassemblyTimeout{5};
+
+    // Source and destination AL MAC of a fragment stream
+    using StreamKey = std::array<uint8_t, 12>;
+
+    // SDU being reassembled for one stream, the payload grows in place and is kept for the stream's next SDU
+    struct Reassembly {
+        AlServiceDataUnit sdu;
+        size_t received;
+        uint8_t nextFragmentId;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    // Frame being read off the data stream, its header and payload may arrive over several reads
+    struct PendingFrame {
+        unsigned char header[AlServiceDataUnit::headerSize] = {};
+        size_t headerRead = 0;
+        size_t payloadRead = 0;
+        bool discard = false;  // out of order, read to stay in step with the stream and dropped
+    };
+
+	/**!
+	 * @brief Drops partial SDUs that exceeded the reassembly timeout.
+	 */
+	void expireReassembly(std::chrono::steady_clock::time_point now);
+
+	/**!
+	 * @brief Throws if the service is not registered for sending data.
+	 */
+	void checkRegistration() const;
+
+	/**!
+	 * @brief Writes one fragment as header and payload slice, retrying short writes.
+	 *
+	 * @returns Number of bytes written, -1 on error.
+	 */
+	ssize_t sendFragment(const unsigned char *header, const unsigned char *data, size_t length);
+
     MacAddress alMacAddressLocal;
     int alDataSocketDescriptor;
     std::string alDataSocketpath = "/tmp/al_data_socket"; // Unix socket path initialized
@@ -159,6 +275,9 @@ public:
     std::string alControlSocketpath = "/tmp/al_control_socket"; // Unix socket path initialized
     AlServiceRegistrationResponse registrationResponse;  // Private member instance
     AlServiceRegistrationRequest registrationRequest;  // Private member instance
+    bool registrationSent = false;  // registrationRequest was sent and is replayed by reconnect()
+    std::map<StreamKey, Reassembly> reassembly;  // Partial SDUs of the non-blocking receiver
+    PendingFrame pendingFrame;  // Partial frame of the non-blocking receiver
 };
 
 #endif // AL_SERVICE_ACCESS_POINT_H
@@ -20,6 +20,9 @@ private:
     std::vector<unsigned char> payload;   // Buffer for storing payload binary data 
 
 public:
+    // Size of the serialized header: source and destination AL MAC, isFragment, isLastFragment, fragmentId
+    static constexpr size_t headerSize = 15;
+
     // Constructor
     
 	/**!
@@ -204,6 +207,22 @@ public:
 	 * @note Ensure that the data vector is properly formatted before calling this function.
 	 */
 	void deserialize(const std::vector<unsigned char>& data);
+
+	/**!
+	 * @brief Serializes only the header of the data unit.
+	 *
+	 * Used by the scatter/gather send path, where the payload is sent from the caller's buffer.
+	 *
+	 * @param[out] buffer Destination of at least headerSize bytes.
+	 */
+	void serializeHeader(unsigned char *buffer) const;
+
+	/**!
+	 * @brief Deserializes only the header of the data unit, the payload is left untouched.
+	 *
+	 * @param[in] buffer Source of at least headerSize bytes.
+	 */
+	void deserializeHeader(const unsigned char *buffer);
     
 };
 
@@ -19,7 +19,8 @@ enum class PrimitiveError {
     DeserializationError,     ///< Error during deserialization
     UnknownError,             ///< An unspecified or unknown error occurred.
     RegistrationError,         ///< Registration was not succesflu
-    FragmentOutOfOrder       //fragementation failure
+    FragmentOutOfOrder,       //fragementation failure
+    Success                   ///< No error, returned by the non-throwing primitives.
 };
 
 // Custom exception class for AlServiceAccessPoint, take advantage of standard exception handling while also providing custom behavior.
@@ -27,6 +27,75 @@
 #include <mariadb/mysql.h>
 #endif
 
+ /**!
+  * @brief Typed view of the current row of a result set.
+  *
+  * The columns are decoded in place from the row buffers of the client library, the lengths
+  * being fetched once per row, so that a table is loaded in a single pass without copying every
+  * value into an intermediate string first. Column indices are 1-based, as in db_client_t.
+  */
+ class db_row_t {
+	const char *const *m_row;
+	const unsigned long *m_lengths;
+	unsigned int m_num_cols;
+
+ public:
+
+	 /**!
+	  * @brief Points the view at a row of the result set.
+	  *
+	  * @param[in] row Column values, each NUL terminated, NULL for SQL NULL.
+	  * @param[in] lengths Lengths of the column values.
+	  * @param[in] num_cols Number of columns.
+	  */
+	 void set(const char *const *row, const unsigned long *lengths, unsigned int num_cols);
+
+	 /**!
+	  * @brief Retrieve the raw value of a column.
+	  *
+	  * @param[in] col Column index (1-based).
+	  * @param[out] len Length of the value, may be NULL.
+	  *
+	  * @returns The NUL terminated value, or NULL for SQL NULL or a column out of range.
+	  */
+	 const char *get_value(unsigned int col, size_t *len);
+
+	 /**!
+	  * @brief Retrieve an integer column, 0 for SQL NULL.
+	  */
+	 int get_number(unsigned int col);
+
+	 /**!
+	  * @brief Retrieve a string column into a buffer, truncated to @p size and always NUL terminated.
+	  *
+	  * @returns @p str, set to the empty string for SQL NULL.
+	  */
+	 char *get_string(unsigned int col, char *str, size_t size);
+
+	 /**!
+	  * @brief Retrieve a MAC address column, written as xx:xx:xx:xx:xx:xx or xxxxxxxxxxxx.
+	  *
+	  * @param[in] col Column index (1-based).
+	  * @param[out] mac MAC address, zeroed for SQL NULL or a malformed value.
+	  *
+	  * @returns 0 on success, -1 if the value is NULL or malformed.
+	  */
+	 int get_mac(unsigned int col, unsigned char *mac);
+
+	 /**!
+	  * @brief Retrieve a hex encoded binary column.
+	  *
+	  * @param[in] col Column index (1-based).
+	  * @param[out] buff Decoded bytes.
+	  * @param[in] size Size of @p buff, longer values are truncated.
+	  *
+	  * @returns Number of bytes decoded.
+	  */
+	 unsigned int get_hex(unsigned int col, unsigned char *buff, unsigned int size);
+
+	 db_row_t();
+ };
+
  /**!
   * @brief Database client class to manage database connections and queries.
   *
@@ -85,13 +154,15 @@
 	  * This function takes a SQL query as input and executes it on the connected database.
 	  *
 	  * @param[in] query SQL query to execute. This should be a valid SQL statement.
+	  * @param[out] status 0 if the query succeeded, -1 otherwise, may be NULL. Statements that return no
+	  *       rows, such as insert, update or delete, return NULL on success too and tell it only here.
 	  *
-	  * @returns Pointer to result context on success, NULL on failure.
+	  * @returns Pointer to result context on success, NULL on failure or if the query returned no rows.
 	  *
 	  * @note Caller is responsible for handling the returned result context.
 	  *       The context will be automatically freed when next_result() returns false.
 	  */
-	 void *execute(const char *query);
+	 void *execute(const char *query, int *status = NULL);
 
 
 	 /**!
@@ -111,6 +182,21 @@
 	 bool next_result(void *ctx);
 
 
+	 /**!
+	  * @brief Retrieve the next row from the query execution as a typed view.
+	  *
+	  * This is next_result() for loaders decoding every column of every row, see db_row_t.
+	  *
+	  * @param[in] ctx Result context obtained from a previous call to execute().
+	  * @param[out] row View of the row, valid until the next call.
+	  *
+	  * @returns True if there is another row, false otherwise.
+	  *
+	  * @note When this function returns false, it automatically frees the result context.
+	  */
+	 bool next_row(void *ctx, db_row_t& row);
+
+
 	 /**!
 	  * @brief Retrieve a string value from the result context.
 	  *
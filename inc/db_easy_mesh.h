@@ -23,9 +23,16 @@
 #include "db_column.h"
 #include "db_client.h"
 #include <cjson/cJSON.h>
+#include <string>
+#include <unordered_map>
 
 class db_easy_mesh_t {
 
+	// row key, the value of the first column, to the content hash of the row last written or loaded
+	std::unordered_map<std::string, unsigned long long>	m_persisted = {};
+
+	static unsigned long long content_hash(const void *data, size_t len);
+
 public: 
     db_table_name_t m_table_name;
     unsigned int    m_num_cols;
@@ -262,6 +269,40 @@ public:
 	 */
 	bool entry_exists_in_table(db_client_t& db_client, void *key);
 
+	/**!
+	 * @brief Records a write of the table in its in-memory shadow.
+	 *
+	 * The shadow holds the key and a content hash of every row in the table, kept by update_db() after each
+	 * successful write and by sync_db() for each loaded row, so that get_dm_orch_type() can tell an insert
+	 * from an update or no change without querying the database.
+	 *
+	 * @param[in] key Row key, the value of the first column.
+	 * @param[in] op Insert or update records the row, delete forgets it.
+	 * @param[in] data Content the row was written from.
+	 * @param[in] len Length of @p data.
+	 */
+	void set_persisted(const char *key, dm_orch_type_t op, const void *data, size_t len);
+
+	/**!
+	 * @brief Checks the shadow for a row of the table.
+	 *
+	 * @param[in] key Row key, the value of the first column.
+	 *
+	 * @returns True if the row was written or loaded and not deleted since.
+	 */
+	bool is_persisted(const char *key);
+
+	/**!
+	 * @brief Checks the shadow for a row of the table holding the given content.
+	 *
+	 * @param[in] key Row key, the value of the first column.
+	 * @param[in] data Content to compare with the content the row was last written from.
+	 * @param[in] len Length of @p data.
+	 *
+	 * @returns True if the row exists and its content hash matches.
+	 */
+	bool is_persisted_unchanged(const char *key, const void *data, size_t len);
+
     
 	/**!
 	 * @brief Inserts a row into the database using the provided database client.
@@ -65,7 +65,7 @@ public:
     dm_op_class_t m_op_class[EM_MAX_OPCLASS];
 	unsigned int	m_num_policy;
 	dm_policy_t	m_policy[EM_MAX_POLICIES];
-	hash_map_t		*m_scan_result_map = NULL;
+	dm_scan_result_store_t	*m_scan_result_store = NULL;
     hash_map_t  	*m_sta_map = NULL;
     hash_map_t      *m_sta_assoc_map = NULL;
     hash_map_t      *m_sta_dassoc_map = NULL;
@@ -1398,11 +1398,11 @@ public:
 	/**!
 	 * @brief Retrieves the number of scan results available.
 	 *
-	 * This function returns the count of scan results stored in the scan result map.
+	 * This function returns the count of scan results stored in the scan result store.
 	 *
 	 * @returns The number of scan results.
 	 */
-	unsigned int	get_num_scan_results() { return hash_map_count(m_scan_result_map); }
+	unsigned int	get_num_scan_results() { return (m_scan_result_store != NULL) ? m_scan_result_store->count():0; }
 	
 	/**!
 	 * @brief Retrieves the scan result at the specified index.
@@ -1417,6 +1417,15 @@ public:
 	 * @note Ensure that the index is within the valid range of available scan results.
 	 */
 	dm_scan_result_t *get_scan_result(unsigned int index);
+
+	/**!
+	 * @brief Drops scan results that were not refreshed within @p max_age seconds.
+	 *
+	 * @param[in] max_age Age in seconds after which a result is removed.
+	 *
+	 * @returns The number of results removed.
+	 */
+	unsigned int	expire_scan_results(unsigned int max_age);
     
 	/**!
 	 * @brief Updates the scan results with the provided scan result data.
@@ -2340,6 +2349,18 @@ public:
 	 */
 	bool db_cfg_type_is_set() { return m_db_cfg_param.db_cfg_type > 0; }
 
+	/**!
+	 * @brief Marks a change that stays in memory, readers of the data model see it but the database is not written.
+	 *
+	 * @param[in] type The part of the data model that changed.
+	 */
+	void set_unsaved_cfg_type(db_cfg_type_t type) { m_db_cfg_param.unsaved_cfg_type |= static_cast<unsigned int>(type); }
+
+	/**!
+	 * @brief Takes the db_cfg_type_t bits marked by set_unsaved_cfg_type() since the last call.
+	 */
+	unsigned int take_unsaved_cfg_type() { unsigned int type = m_db_cfg_param.unsaved_cfg_type; m_db_cfg_param.unsaved_cfg_type = 0; return type; }
+
     
 	/**!
 	 * @brief Handles the dirty device management state.
@@ -31,10 +31,14 @@
 #include "dm_sta_list.h"
 #include "dm_policy_list.h"
 #include "dm_scan_result_list.h"
+#include "dm_metrics_rollup_list.h"
 #include "dm_dpp.h"
 #include "db_client.h"
 #include "dm_easy_mesh_list.h"
 #include "em_network_topo.h"
+#include "em_channel_planner.h"
+#include "em_client_cap_cache.h"
+#include "em_fanout.h"
 
 class em_cmd_t;
 class dm_easy_mesh_t;
@@ -53,6 +57,10 @@ class dm_easy_mesh_ctrl_t :
 
     dm_easy_mesh_list_t	m_data_model_list;
 	em_network_topo_t   *m_topology;
+	dm_metrics_rollup_list_t	m_metrics_rollup;
+	em_client_cap_cache_t	m_client_cap_cache;
+	unsigned long long	m_update_gen;	// data model changes applied to the tables so far
+	unsigned int	m_changed_cfg;	// db_cfg_type_t bits of those changes not taken yet
 
     
 	/**!
@@ -253,6 +261,20 @@ public:
 	 * @note Ensure that the event and command structures are properly initialized before calling this function.
 	 */
 	int analyze_set_channel(em_bus_event_t *evt, em_cmd_t *cmd[]);
+
+	/**!
+	 * @brief Turns the moves of the channel planner into set channel commands.
+	 *
+	 * The anticipated channel preference of each agent is set to the planned channel in the band of
+	 * the move, and the commands target the planned radios only.
+	 *
+	 * @param[in] moves Moves of a planning pass.
+	 * @param[in] num_moves Number of moves, at most EM_CLI_MAX_ARGS.
+	 * @param[out] cmd Array of command pointers to be filled.
+	 *
+	 * @returns Number of commands created, 0 if no move matched a known agent.
+	 */
+	int analyze_channel_plan(const em_chan_plan_move_t *moves, unsigned int num_moves, em_cmd_t *cmd[]);
     
 	/**!
 	 * @brief Analyzes the scan channel based on the provided event and command.
@@ -273,20 +295,39 @@ public:
 	int analyze_scan_channel(em_bus_event_t *evt, em_cmd_t *cmd[]);
     
 	/**!
-	 * @brief Analyzes and sets the policy based on the given event and command.
+	 * @brief Lists the devices a SetPolicy event targets.
 	 *
-	 * This function processes the event and command to determine the appropriate policy settings.
+	 * @param[in] evt Pointer to the event structure containing the SetPolicy subdoc.
+	 * @param[out] devices AL MACs of the devices, in subdoc order.
 	 *
-	 * @param[in] evt Pointer to the event structure containing event details.
-	 * @param[in] cmd Array of pointers to command structures to be processed.
+	 * @returns int Number of devices.
+	 * @retval Negative parse error if the subdoc does not decode.
+	 */
+	int analyze_set_policy_devices(em_bus_event_t *evt, std::vector<em_fanout_target_t>& devices);
+
+	/**!
+	 * @brief Builds the set policy commands of one device of a SetPolicy event.
 	 *
-	 * @returns int Status code indicating success or failure of the operation.
-	 * @retval 0 on success.
-	 * @retval Non-zero error code on failure.
+	 * @param[in] evt Pointer to the event structure containing the SetPolicy subdoc.
+	 * @param[in] index Index of the device in the subdoc.
+	 * @param[out] cmd Array of pointers receiving the commands.
 	 *
-	 * @note Ensure that the event and command structures are properly initialized before calling this function.
+	 * @returns int Number of commands built.
+	 * @retval Negative parse error if the subdoc does not decode.
+	 */
+	int analyze_set_policy(em_bus_event_t *evt, unsigned int index, em_cmd_t *cmd[]);
+
+	/**!
+	 * @brief Builds the set policy commands resending the policy TLVs a device did not acknowledge.
+	 *
+	 * The commands carry the committed data model of the device, each radio sends what it has overdue.
+	 *
+	 * @param[in] dm Data model of the device.
+	 * @param[out] cmd Array of pointers receiving the commands.
+	 *
+	 * @returns int Number of commands built.
 	 */
-	int analyze_set_policy(em_bus_event_t *evt, em_cmd_t *cmd[]);
+	int analyze_policy_retry(dm_easy_mesh_t *dm, em_cmd_t *cmd[]);
     
 	/**!
 	 * @brief Analyzes the DPP start event and command.
@@ -1219,6 +1260,11 @@ public:
 	 * @note Ensure that the key provided is valid and corresponds to an existing station in the data model list.
 	 */
 	dm_sta_t *get_sta(const char *key) { return m_data_model_list.get_sta(key); }
+
+	/**!
+	 * @brief Retrieves a station from the data model list by its binary key.
+	 */
+	dm_sta_t *get_sta(const em_sta_key_t *key) { return m_data_model_list.get_sta(key); }
     
 	/**!
 	 * @brief Removes a station from the data model list.
@@ -1243,6 +1289,11 @@ public:
 	 */
 	void put_sta(const char *key, const dm_sta_t *sta) { m_data_model_list.put_sta(key, sta); }
 
+	/**!
+	 * @brief Puts a station entry into the data model list by its binary key.
+	 */
+	void put_sta(const em_sta_key_t *key, const dm_sta_t *sta) { m_data_model_list.put_sta(key, sta); }
+
     
 	/**!
 	 * @brief Retrieves the first operational class from the data model list.
@@ -1569,6 +1620,32 @@ public:
 	 * @note Ensure that the system is properly initialized before calling this function.
 	 */
 	int load_tables();
+
+	/**!
+	 * @brief Writes a closed metrics rollup bucket to the MetricsRollup table.
+	 *
+	 * @returns 0 on success, -1 on failure.
+	 */
+	int persist_metrics_rollup(const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, const em_metrics_bucket_t *bucket) {
+		return m_metrics_rollup.persist(m_db_client, mac, id, resolution, bucket);
+	}
+
+	/**!
+	 * @brief Retrieves the client capability cache consulted on every STA association.
+	 */
+	em_client_cap_cache_t *get_client_cap_cache() { return &m_client_cap_cache; }
+
+	/**!
+	 * @brief Count of data model changes applied to the tables, it moves whenever a data model changed.
+	 */
+	unsigned long long get_update_gen() { return m_update_gen; }
+
+	/**!
+	 * @brief Takes the db_cfg_type_t bits of the changes applied since the last call.
+	 *
+	 * A topology change reports db_cfg_type_network_list_update.
+	 */
+	unsigned int take_changed_cfg() { unsigned int cfg = m_changed_cfg; m_changed_cfg = 0; return cfg; }
     
 	/**!
 	 * @brief Loads the network SSID table.
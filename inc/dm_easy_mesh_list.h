@@ -20,6 +20,7 @@
 #ifndef DM_EM_LIST_H
 #define DM_EM_LIST_H
 
+#include <unordered_map>
 #include "em_base.h"
 #include "dm_easy_mesh.h"
 
@@ -30,6 +31,37 @@ class dm_easy_mesh_list_t {
     unsigned int m_num_networks;
     hash_map_t  *m_list;
     em_mgr_t *m_mgr;
+    // radio MAC, packed in the low 48 bits, to the data model holding the radio
+    std::unordered_map<unsigned long long, dm_easy_mesh_t *>	m_radio_dm = {};
+
+	static unsigned long long mac_key(const unsigned char *mac);
+
+	/**!
+	 * @brief Finds the data model holding a radio.
+	 *
+	 * Resolved through m_radio_dm, the entry is checked against the radios of the data model
+	 * and rebuilt by walking every data model when it is missing or stale.
+	 *
+	 * @param[in] ruid MAC of the radio.
+	 *
+	 * @returns The data model, or NULL if no data model holds the radio.
+	 */
+	dm_easy_mesh_t *find_dm_by_radio(const unsigned char *ruid);
+
+	/**!
+	 * @brief Drops the m_radio_dm entries of a data model about to be deleted.
+	 */
+	void unindex_data_model(dm_easy_mesh_t *dm);
+
+	/**!
+	 * @brief Finds the STA that reported a beacon based scan result.
+	 *
+	 * @param[in] dm Data model of the device the STA is associated to.
+	 * @param[in] sta_mac MAC of the scanning STA.
+	 *
+	 * @returns The STA, or NULL if it is not known to the data model.
+	 */
+	dm_sta_t *find_scanner_sta(dm_easy_mesh_t *dm, mac_address_t sta_mac);
 
 public:
 
@@ -475,6 +507,13 @@ public:
 	 * @note Ensure that the key provided is valid and corresponds to an existing station.
 	 */
 	dm_sta_t *get_sta(const char *key);
+
+	/**!
+	 * @brief Retrieves the station with the given binary key, see em_sta_key_t.
+	 *
+	 * @returns The station if found, otherwise NULL.
+	 */
+	dm_sta_t *get_sta(const em_sta_key_t *key);
     
 	/**!
 	 * @brief Removes a station identified by the given key.
@@ -499,6 +538,11 @@ public:
 	 */
 	void put_sta(const char *key, const dm_sta_t *sta);
 
+	/**!
+	 * @brief Adds or updates the station with the given binary key, see em_sta_key_t.
+	 */
+	void put_sta(const em_sta_key_t *key, const dm_sta_t *sta);
+
     
 	/**!
 	 * @brief Retrieves the first network SSID from the list.
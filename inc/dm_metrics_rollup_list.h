@@ -0,0 +1,76 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DM_METRICS_ROLLUP_LIST_H
+#define DM_METRICS_ROLLUP_LIST_H
+
+#include "em_base.h"
+#include "db_easy_mesh.h"
+#include "em_metrics_store.h"
+
+typedef struct {
+	em_long_string_t	id;
+	mac_addr_str_t	entity;
+	char	metric[16];
+	unsigned int	resolution;
+	unsigned int	start;
+	unsigned int	count;
+	int	min;
+	int	max;
+	int	avg;
+	int	p95;
+} em_metrics_rollup_info_t;
+
+/**
+ * @brief Append only table of closed metrics rollups.
+ *
+ * The raw samples stay in em_metrics_store_t, only the buckets of persisted rollup levels are
+ * written here, one row per series per bucket. Nothing is read back into memory on start.
+ */
+class dm_metrics_rollup_list_t : public db_easy_mesh_t {
+
+public:
+
+	/**!
+	 * @brief Initializes the table name and columns.
+	 *
+	 * @returns 0 on success.
+	 */
+	int init();
+
+	/**!
+	 * @brief Writes one closed rollup bucket.
+	 *
+	 * @returns 0 on success, -1 on failure.
+	 */
+	int persist(db_client_t& db_client, const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, const em_metrics_bucket_t *bucket);
+
+	void init_table();
+	void init_columns();
+	int sync_db(db_client_t& db_client, void *ctx);
+	int update_db(db_client_t& db_client, dm_orch_type_t op, void *data);
+	bool search_db(db_client_t& db_client, void *ctx, void *key);
+	bool operator == (const db_easy_mesh_t& obj);
+	int set_config(db_client_t& db_client, const cJSON *obj, void *parent_id);
+	int get_config(cJSON *obj, void *parent_id, bool summary = false);
+
+	dm_metrics_rollup_list_t();
+	~dm_metrics_rollup_list_t();
+};
+
+#endif
@@ -19,11 +19,30 @@
 #ifndef DM_SCAN_RESULT_H
 #define DM_SCAN_RESULT_H
 
+#include <time.h>
+#include <vector>
+#include <unordered_map>
 #include "em_base.h"
 
+#define EM_MAX_SCAN_RESULTS		512
+#define EM_SCAN_RESULT_MAX_AGE		600	// seconds without a report before a result is aged out
+#define EM_SCAN_RESULT_NBR_SLOTS	(2 * EM_MAX_NEIGHBORS)
+
+// Binary identity of a scan result within one data model, the network id is implied by the owner
+typedef struct {
+	mac_address_t	dev_mac;
+	mac_address_t	scanner_mac;
+	unsigned char	op_class;
+	unsigned char	channel;
+	unsigned char	scanner_type;
+} __attribute__((__packed__)) dm_scan_result_key_t;
+
 class dm_scan_result_t {
 public:
     em_scan_result_t    m_scan_result;
+	unsigned int	m_store_index;		// position in the owning dm_scan_result_store_t
+	time_t	m_last_update;			// monotonic seconds, used for aging
+	unsigned char	m_nbr_slot[EM_SCAN_RESULT_NBR_SLOTS];	// bssid hash -> neighbor index + 1
 
 public:
     
@@ -114,6 +133,42 @@ public:
 	 */
 	bool has_same_id(em_scan_result_id_t *);
 
+	/**!
+	 * @brief Builds the binary store key of a scan result id.
+	 *
+	 * @param[in] id Scan result id, the network id is not part of the key.
+	 * @param[out] key Packed key.
+	 */
+	static void make_key(const em_scan_result_id_t *id, dm_scan_result_key_t *key);
+
+	/**!
+	 * @brief Looks up a neighbor by BSSID through the per result index.
+	 *
+	 * @param[in] bssid BSSID of the neighbor.
+	 *
+	 * @returns Index into m_scan_result.neighbor, or -1 if the BSSID is not known.
+	 */
+	int find_neighbor(const unsigned char *bssid);
+
+	/**!
+	 * @brief Inserts a neighbor or overwrites the entry with the same BSSID.
+	 *
+	 * @param[in] nbr Neighbor as reported.
+	 *
+	 * @returns Index of the neighbor, or -1 if the result already holds EM_MAX_NEIGHBORS entries.
+	 */
+	int upsert_neighbor(const em_neighbor_t *nbr);
+
+	/**!
+	 * @brief Rebuilds the BSSID index after m_scan_result.neighbor was written directly.
+	 */
+	void reindex_neighbors();
+
+	/**!
+	 * @brief Records the time of the last update, used by dm_scan_result_store_t::expire().
+	 */
+	void touch();
+
     
 	/**!
 	 * @brief Processes the scan result and returns a dm_scan_result_t object.
@@ -172,4 +227,88 @@ public:
 	virtual ~dm_scan_result_t();
 };
 
+struct dm_scan_result_key_hash_t {
+	size_t operator()(const dm_scan_result_key_t& key) const;
+};
+
+struct dm_scan_result_key_eq_t {
+	bool operator()(const dm_scan_result_key_t& a, const dm_scan_result_key_t& b) const {
+		return memcmp(&a, &b, sizeof(dm_scan_result_key_t)) == 0;
+	}
+};
+
+/**
+ * @brief Scan results of one data model.
+ *
+ * Results are found in O(1) through a binary key, iterated in insertion order and addressed
+ * by position. The store owns the results; the oldest one is evicted once EM_MAX_SCAN_RESULTS
+ * is reached and results not updated for a while can be aged out with expire().
+ */
+class dm_scan_result_store_t {
+	std::unordered_map<dm_scan_result_key_t, dm_scan_result_t *, dm_scan_result_key_hash_t, dm_scan_result_key_eq_t>	m_map;
+	std::vector<dm_scan_result_t *>	m_list;
+
+	void erase_at(unsigned int index);
+
+public:
+
+	/**!
+	 * @brief Finds the result with the given id.
+	 *
+	 * @returns The result, or NULL if there is none.
+	 */
+	dm_scan_result_t *find(const em_scan_result_id_t *id);
+
+	/**!
+	 * @brief Creates an empty result for the given id, evicting the oldest result if the store is full.
+	 *
+	 * @returns The existing result if the id is already present, otherwise the new one.
+	 */
+	dm_scan_result_t *create(const em_scan_result_id_t *id);
+
+	/**!
+	 * @brief Removes and frees the result with the given id.
+	 *
+	 * @returns 0 if a result was removed, -1 otherwise.
+	 */
+	int remove(const em_scan_result_id_t *id);
+
+	/**!
+	 * @brief Removes results whose last update is older than @p max_age seconds.
+	 *
+	 * @returns Number of results removed.
+	 */
+	unsigned int expire(unsigned int max_age);
+
+	/**!
+	 * @brief Removes and frees all results.
+	 */
+	void clear();
+
+	/**!
+	 * @brief Returns the result at @p index in insertion order, or NULL if out of range.
+	 */
+	dm_scan_result_t *get(unsigned int index) { return (index < m_list.size()) ? m_list[index]:NULL; }
+
+	/**!
+	 * @brief Iteration in insertion order, stable as long as no result is removed.
+	 */
+	dm_scan_result_t *get_first() { return get(0); }
+	dm_scan_result_t *get_next(dm_scan_result_t *res) { return (contains(res) == true) ? get(res->m_store_index + 1):NULL; }
+
+	/**!
+	 * @brief Checks whether @p res is owned by this store.
+	 */
+	bool contains(const dm_scan_result_t *res) const {
+		return (res != NULL) && (res->m_store_index < m_list.size()) && (m_list[res->m_store_index] == res);
+	}
+
+	unsigned int count() const { return static_cast<unsigned int> (m_list.size()); }
+
+	dm_scan_result_store_t();
+	dm_scan_result_store_t(const dm_scan_result_store_t&) = delete;
+	dm_scan_result_store_t& operator = (const dm_scan_result_store_t&) = delete;
+	~dm_scan_result_store_t();
+};
+
 #endif
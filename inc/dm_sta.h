@@ -21,6 +21,17 @@
 
 #include "em_base.h"
 
+/**
+ * @brief Binary form of the "sta@bssid@ruid" key of the STA maps.
+ *
+ * Lookups go through this key, the string is only produced where a hash_map_t, JSON or DB row needs it.
+ */
+typedef struct {
+	mac_address_t	sta;
+	bssid_t	bssid;
+	mac_address_t	ruid;
+} em_sta_key_t;
+
 class dm_sta_t {
 public:
     em_sta_info_t    m_sta_info;
@@ -105,6 +116,29 @@ public:
 	 * @note Ensure that the key is correctly formatted to extract valid addresses.
 	 */
 	static void parse_sta_bss_radio_from_key(const char *key, mac_address_t sta, bssid_t bssid, mac_address_t radio);
+
+	/**!
+	 * @brief Parses a "sta@bssid@ruid" key into its binary form.
+	 *
+	 * @param[in] key The key string.
+	 * @param[out] out The binary key.
+	 */
+	static void parse_key(const char *key, em_sta_key_t *out);
+
+	/**!
+	 * @brief Formats a binary key as the "sta@bssid@ruid" string used by the STA maps.
+	 *
+	 * @param[in] key The binary key.
+	 * @param[out] str The key string, same text as three macbytes_to_string() joined by '@'.
+	 *
+	 * @returns @p str.
+	 */
+	static char *key_to_string(const em_sta_key_t *key, em_long_string_t str);
+
+	/**!
+	 * @brief Retrieves the binary key of the STA.
+	 */
+	void get_key(em_sta_key_t *key) const;
     
 	/**!
 	 * @brief Decodes the capabilities of a station.
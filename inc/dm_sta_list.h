@@ -172,18 +172,7 @@ public:
 	 * @note Ensure that the database client is properly initialized before calling this function.
 	 */
 	bool search_db(db_client_t& db_client, void *ctx, void *key);
-    
-	/**!
-	 * @brief Compares a database client with a station.
-	 *
-	 * This function checks if the given database client matches the specified station.
-	 *
-	 * @param[in] db_client Reference to the database client object to be compared.
-	 * @param[in] sta Reference to the station object to compare against.
-	 *
-	 * @returns True if the database client matches the station, false otherwise.
-	 */
-	bool compare_db(db_client_t& db_client, const dm_sta_t& sta);
+
     bool operator == (const db_easy_mesh_t& obj);
     
 	/**!
@@ -293,6 +282,13 @@ public:
 	 * @note This is a pure virtual function and must be implemented by derived classes.
 	 */
 	virtual dm_sta_t *get_sta(const char *key) = 0;
+
+	/**!
+	 * @brief Retrieves a station by its binary key, see em_sta_key_t.
+	 *
+	 * @note This is a pure virtual function and must be implemented by derived classes.
+	 */
+	virtual dm_sta_t *get_sta(const em_sta_key_t *key) = 0;
     
 	/**!
 	 * @brief Removes a station identified by the given key.
@@ -320,6 +316,13 @@ public:
 	 */
 	virtual void put_sta(const char *key, const dm_sta_t *sta) = 0;
 
+	/**!
+	 * @brief Adds a station entry by its binary key, see em_sta_key_t.
+	 *
+	 * @note This is a pure virtual function and must be implemented by derived classes.
+	 */
+	virtual void put_sta(const em_sta_key_t *key, const dm_sta_t *sta) = 0;
+
 };
 
 #endif
@@ -3,10 +3,16 @@
 
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "em_base.h"
 #include "ec_crypto.h"
+#include "ec_session_cache.h"
+
+// Connection contexts are kept after configuration for reconfiguration, hence the long idle TTL
+#define EC_CONN_CACHE_CAPACITY  256
+#define EC_CONN_CACHE_TTL_S     (24 * 60 * 60)
 
 
 /**
@@ -96,6 +102,22 @@ using get_fbss_info_func = std::function<cJSON*(ec_connection_context_t *)>;
  */
 using can_onboard_additional_aps_func = std::function<bool(void)>;
 
+/**
+ * @brief Arms a timer serviced by the EasyMesh manager thread.
+ * @param ms Delay in milliseconds
+ * @param periodic Re-arm the timer every ms
+ * @param cb Callback, run on the manager thread
+ * @return The timer id, used to cancel the timer
+ */
+using add_timer_func = std::function<unsigned int(unsigned int, bool, std::function<void()>)>;
+
+/**
+ * @brief Cancels a timer armed through add_timer_func.
+ * @param id The timer id
+ * @return 0 on success, -1 if the timer already expired
+ */
+using cancel_timer_func = std::function<int(unsigned int)>;
+
 class ec_configurator_t {
 public:
     
@@ -361,13 +383,21 @@ public:
 	 * @note If the connection is not found, the function returns immediately without performing any action.
 	 */
 	inline void teardown_connection(const std::string& mac) {
-        auto conn = m_connections.find(mac);
-        if (conn == m_connections.end()) return;
-        auto &c_ctx = conn->second;
-        ec_crypto::free_connection_ctx(&c_ctx);
-        ec_crypto::free_ephemeral_context(&c_ctx.eph_ctx, c_ctx.nonce_len, c_ctx.digest_len);
+        // The cache frees the connection and ephemeral contexts through release_conn_ctx()
+        std::lock_guard<std::mutex> lock(m_conn_lock);
+        m_connections.erase(ec_session_cache::mac_key(mac));
     }
 
+	/**
+	 * @brief Collects the hit/miss/eviction counters of the session caches of this configurator.
+	 *
+	 * @param[out] stats The counters, summed over all caches
+	 */
+	virtual void get_session_cache_stats(ec_session_cache_stats_t& stats) {
+		std::lock_guard<std::mutex> lock(m_conn_lock);
+		stats = m_connections.get_stats();
+	}
+
     
 	/**!
 	 * @brief Retrieves the MAC address.
@@ -389,6 +419,17 @@ public:
 	ec_configurator_t(const ec_configurator_t&) = delete;
     ec_configurator_t& operator=(const ec_configurator_t&) = delete;
 
+	/**
+	 * @brief Sets the functions used to arm and cancel manager timers, e.g. for DPP exchange deadlines
+	 *
+	 * @param[in] add_timer_fn Function to arm a timer
+	 * @param[in] cancel_timer_fn Function to cancel a timer
+	 */
+	inline void set_timer_fns(add_timer_func add_timer_fn, cancel_timer_func cancel_timer_fn) {
+		m_add_timer = add_timer_fn;
+		m_cancel_timer = cancel_timer_fn;
+	}
+
 protected:
 
     std::string m_mac_addr;
@@ -407,8 +448,37 @@ protected:
 
     can_onboard_additional_aps_func m_can_onboard_additional_aps;
 
-    // The connections to the Enrollees/Agents
-    std::map<std::string, ec_connection_context_t> m_connections = {};
+    add_timer_func m_add_timer = nullptr;
+
+    cancel_timer_func m_cancel_timer = nullptr;
+
+	/**
+	 * @brief Frees the OpenSSL objects and key material of a connection context dropped from m_connections.
+	 */
+	static inline void release_conn_ctx(const uint64_t&, ec_connection_context_t& c_ctx) {
+		ec_crypto::free_connection_ctx(&c_ctx);
+	}
+
+    // The connections to the Enrollees/Agents, keyed by packed Enrollee MAC
+    ec_session_cache_t<uint64_t, ec_connection_context_t> m_connections{EC_CONN_CACHE_CAPACITY, EC_CONN_CACHE_TTL_S, &ec_configurator_t::release_conn_ctx};
+
+    // Guards m_connections, whose contexts are also looked up from crypto pool workers
+    std::mutex m_conn_lock = {};
+
+	/**
+	 * @brief Keeps the connection context of an Enrollee from being evicted while a crypto pool job uses it.
+	 *
+	 * @return true if the Enrollee has a connection context
+	 */
+	inline bool pin_conn_ctx(uint64_t key) {
+		std::lock_guard<std::mutex> lock(m_conn_lock);
+		return m_connections.pin(key);
+	}
+
+	inline void unpin_conn_ctx(uint64_t key) {
+		std::lock_guard<std::mutex> lock(m_conn_lock);
+		m_connections.unpin(key);
+	}
 
     
 	/**!
@@ -425,10 +495,20 @@ protected:
 	 * @note Ensure that the MAC address provided is valid and exists in the connections map.
 	 */
 	inline ec_connection_context_t* get_conn_ctx(const std::string& mac) {
-        if (m_connections.find(mac) == m_connections.end()) {
-            return NULL;
-        }
-        return &m_connections[mac];    
+        std::lock_guard<std::mutex> lock(m_conn_lock);
+        return m_connections.find(ec_session_cache::mac_key(mac));
+    }
+
+	/**!
+	 * @brief Retrieves the connection context for a given binary MAC address.
+	 *
+	 * @param[in] mac The MAC address for which the connection context is requested.
+	 *
+	 * @returns A pointer to the connection context, NULL if the MAC address is not found in the connections.
+	 */
+	inline ec_connection_context_t* get_conn_ctx(const uint8_t mac[ETH_ALEN]) {
+        std::lock_guard<std::mutex> lock(m_conn_lock);
+        return m_connections.find(ec_session_cache::mac_key(mac));
     }
 
     
@@ -469,12 +549,12 @@ protected:
 	 * @note Ensure that the MAC address provided is valid and corresponds to an existing connection.
 	 */
 	inline ec_data_t* get_boot_data(const std::string& mac) {
-        auto conn = m_connections.find(mac);
-        if (conn == m_connections.end()) {
+        auto conn_ctx = get_conn_ctx(mac);
+        if (!conn_ctx) {
             printf("%s:%d: Connection context not found for enrollee MAC %s\n", __func__, __LINE__, mac.c_str());
             return NULL;  // Return reference to static empty context
         }
-        return &conn->second.boot_data;
+        return &conn_ctx->boot_data;
     }
 
     
@@ -489,10 +569,9 @@ protected:
 	 * @note If the MAC address is not found in the connections, the function returns without action.
 	 */
 	inline void clear_conn_eph_ctx(const std::string& mac) {
-        auto conn = m_connections.find(mac);
-        if (conn == m_connections.end()) return;
-        auto &c_ctx = conn->second;
-        ec_crypto::free_ephemeral_context(&c_ctx.eph_ctx, c_ctx.nonce_len, c_ctx.digest_len);
+        auto c_ctx = get_conn_ctx(mac);
+        if (!c_ctx) return;
+        ec_crypto::free_ephemeral_context(&c_ctx->eph_ctx, c_ctx->nonce_len, c_ctx->digest_len);
     }
 
 };
@@ -32,6 +32,18 @@ namespace easyconnect {
 
 }
 
+/**
+ * @brief Encodings of a Configurator public key (C-sign-key, ppKey) that are the same for every Enrollee,
+ * computed once with ec_crypto::init_key_artifacts() instead of for each Connector and Configuration object.
+ */
+struct ec_key_artifacts_t {
+    uint8_t key_hash[SHA256_DIGEST_LENGTH] = {};    // compute_key_hash(key), only with a key
+    std::string kid = {};                           // base64(key_hash), only with a key
+    std::string x = {};                             // JWK coordinates, base64
+    std::string y = {};
+    std::string jws_header = {};                    // base64url of the "dppCon" JWS Protected Header, only with a key
+};
+
 class ec_crypto {
 public:
 
@@ -87,6 +99,41 @@ public:
 	static bool init_connection_ctx(ec_connection_context_t& c_ctx, const SSL_KEY *boot_key);
 
     
+	/**
+	 * @brief Get the process wide EC group of a named curve.
+	 *
+	 * The group is created once per curve, with its generator multiples precomputed where OpenSSL allows it,
+	 * and is never freed. It is only read after creation so connections on any thread can share it.
+	 *
+	 * @param[in] nid The curve NID.
+	 *
+	 * @return const EC_GROUP* The shared group, NULL if the curve is unknown.
+	 */
+	static const EC_GROUP *get_shared_group(int nid);
+
+	/**
+	 * @brief Whether @p group was returned by get_shared_group() and must not be freed.
+	 */
+	static bool is_shared_group(const EC_GROUP *group);
+
+	/**
+	 * @brief Get the curve NID of an EC key without creating a group, NID_undef on failure.
+	 */
+	static int get_key_nid(const SSL_KEY *key);
+
+	/**
+	 * @brief Compute the Enrollee independent encodings of a Configurator public key.
+	 *
+	 * @param[in] c_ctx Connection context on the key's curve, for its BN_CTX.
+	 * @param[in] key The key to hash and to build the JWS header for (C-sign-key), NULL to only encode @p point (ppKey).
+	 * @param[in] point The public key, NULL to take it from @p key.
+	 * @param[out] art The encodings.
+	 *
+	 * @return bool true on success
+	 */
+	static bool init_key_artifacts(ec_connection_context_t& c_ctx, const SSL_KEY *key, const EC_POINT *point, ec_key_artifacts_t& art);
+
+    
 	/**
 	 * @brief Compute the hash of the provided buffer
 	 *
@@ -585,7 +632,7 @@ public:
         if (ctx->boot_data.responder_boot_key) em_crypto_t::free_key(const_cast<SSL_KEY*>(ctx->boot_data.responder_boot_key));
         if (ctx->boot_data.initiator_boot_key) em_crypto_t::free_key(const_cast<SSL_KEY*>(ctx->boot_data.initiator_boot_key));
 
-        if (ctx->group) EC_GROUP_free(const_cast<EC_GROUP*>(ctx->group));
+        if (ctx->group && !is_shared_group(ctx->group)) EC_GROUP_free(const_cast<EC_GROUP*>(ctx->group));
         if (ctx->order) BN_free(ctx->order);
         if (ctx->prime) BN_free(ctx->prime);
         if (ctx->bn_ctx) BN_CTX_free(ctx->bn_ctx);
@@ -674,6 +721,11 @@ public:
 	 */
 	static std::optional<std::string> generate_connector(const cJSON* jws_header, const cJSON* jws_payload, SSL_KEY* sign_key);
 
+	/**
+	 * @brief Generate a connector from an already base64url encoded JWS Protected Header, e.g. ec_key_artifacts_t::jws_header.
+	 */
+	static std::optional<std::string> generate_connector(const std::string& base64_jws_header, const cJSON* jws_payload, SSL_KEY* sign_key);
+
     
 	/**
 	 * @brief Get the JWS Protected Header from a connector
@@ -768,6 +820,11 @@ public:
 	 */
 	static cJSON* create_jws_header(const std::string& type, const SSL_KEY *c_signing_key);
 
+	/**
+	 * @brief Create a JWS Protected Header from the cached encodings of the C-sign-key.
+	 */
+	static cJSON* create_jws_header(const std::string& type, const ec_key_artifacts_t& c_sign_key);
+
     
 	/**
 	 * @brief Create a JWS Payload
@@ -830,6 +887,11 @@ public:
 	 */
 	static cJSON* create_csign_object(ec_connection_context_t& c_ctx, SSL_KEY *c_signing_key);
 
+	/**
+	 * @brief Create a csign object from the cached encodings of the C-sign-key.
+	 */
+	static cJSON* create_csign_object(const ec_key_artifacts_t& c_sign_key);
+
     
 	/**
 	 * @brief Derive public ppKey from Configurator Signing Key (must share the same key group)
@@ -870,6 +932,11 @@ public:
 	 * @endcode
 	 */
 	static cJSON *create_ppkey_object(ec_connection_context_t& c_ctx);
+
+	/**
+	 * @brief Create a ppKey object from the cached encodings of the ppKey.
+	 */
+	static cJSON *create_ppkey_object(const ec_key_artifacts_t& pp_key);
 };
 
 #endif // EC_CRYPTO_H
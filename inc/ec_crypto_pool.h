@@ -0,0 +1,134 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EC_CRYPTO_POOL_H
+#define EC_CRYPTO_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define EC_CRYPTO_POOL_MAX_WORKERS 4
+
+/**
+ * @brief Hands a callback to the thread owning the pool, e.g. as a 0 ms timer of the manager timer wheel.
+ */
+using ec_crypto_post_func = std::function<void(std::function<void()>)>;
+
+/**
+ * @brief Counters of a crypto pool.
+ */
+typedef struct {
+    uint64_t submitted;
+    uint64_t completed;
+    size_t in_flight;       // strands with a job queued or running
+    size_t max_in_flight;
+} ec_crypto_pool_stats_t;
+
+/**
+ * @brief Worker pool running the EC operations of DPP exchanges (ECDH, HKDF, Connector signing) off the owner thread.
+ *
+ * A job is a pair of functions: the work runs on a worker thread, the completion is posted back to the owner
+ * thread through the post function and runs there. Jobs carry a strand key, the packed Enrollee MAC: jobs of one
+ * strand run one at a time in submission order, and the next one is only started once the completion of the
+ * previous one has run on the owner thread, so a completion can safely update the state the next work reads.
+ * Jobs of different strands run concurrently, up to the number of workers.
+ *
+ * Destroying the pool joins the workers; queued jobs are dropped and completions not yet run are skipped.
+ */
+class ec_crypto_pool_t {
+public:
+
+	using work_func = std::function<void()>;
+	using done_func = std::function<void()>;
+
+	/**
+	 * @brief Construct a crypto pool
+	 *
+	 * @param[in] num_workers Number of worker threads, 0 for the number of CPUs capped at EC_CRYPTO_POOL_MAX_WORKERS
+	 * @param[in] post Function handing a completion to the owner thread
+	 */
+	ec_crypto_pool_t(unsigned int num_workers, ec_crypto_post_func post);
+
+	~ec_crypto_pool_t();
+
+	ec_crypto_pool_t(const ec_crypto_pool_t&) = delete;
+	ec_crypto_pool_t& operator=(const ec_crypto_pool_t&) = delete;
+
+	/**
+	 * @brief Queue a job at the end of its strand.
+	 *
+	 * @param[in] key Strand key
+	 * @param[in] work Runs on a worker thread, may be nullptr to only order @p done behind the strand
+	 * @param[in] done Runs on the owner thread after @p work, may be nullptr
+	 */
+	void submit(uint64_t key, work_func work, done_func done);
+
+	/**
+	 * @brief Queue a job at the front of its strand, to continue a multi-step exchange from a completion
+	 * before any job submitted meanwhile.
+	 */
+	void submit_next(uint64_t key, work_func work, done_func done);
+
+	/**
+	 * @brief Whether the strand has a job queued or running.
+	 */
+	bool is_busy(uint64_t key);
+
+	ec_crypto_pool_stats_t get_stats();
+
+	inline unsigned int get_num_workers() const { return static_cast<unsigned int>(m_workers.size()); }
+
+private:
+	struct job_t {
+		work_func work;
+		done_func done;
+	};
+
+	struct strand_t {
+		std::deque<job_t> jobs = {};
+		bool running = false;
+	};
+
+	// Shared with the posted completions, which may outlive the pool
+	struct state_t {
+		std::mutex lock = {};
+		std::condition_variable cond = {};
+		std::unordered_map<uint64_t, strand_t> strands = {};
+		std::deque<uint64_t> ready = {};
+		bool exit = false;
+		ec_crypto_pool_stats_t stats = {};
+	};
+
+	void enqueue(uint64_t key, job_t job, bool front);
+	void worker();
+	static void complete(const std::shared_ptr<state_t>& state, uint64_t key);
+
+	std::shared_ptr<state_t> m_state;
+	ec_crypto_post_func m_post;
+	std::vector<std::thread> m_workers = {};
+};
+
+#endif // EC_CRYPTO_POOL_H
@@ -2,8 +2,13 @@
 #define EC_CTRL_CONFIGURATOR_H
 
 #include "ec_configurator.h"
+#include "ec_crypto_pool.h"
+#include <memory>
 #include <unordered_map>
 
+// Crypto pool workers for proxied DPP exchanges, 0 for one per CPU (see EC_CRYPTO_POOL_MAX_WORKERS)
+#define EC_CTRL_CRYPTO_WORKERS 0
+
 // forward decl
 struct cJSON;
 
@@ -13,6 +18,17 @@ typedef enum {
 	dpp_config_obj_fbss,
 } dpp_config_obj_type_e;
 
+/**
+ * @brief The Configurator's own keys on one curve, shared by every Enrollee configured on that curve,
+ * along with their Enrollee independent encodings.
+ */
+struct ec_configurator_keys_t {
+    SSL_KEY *c_signing_key = NULL;      // (c-sign-key, C-sign-key)
+    EC_POINT *ppk = NULL;               // Public privacy protection key
+    ec_key_artifacts_t c_sign = {};
+    ec_key_artifacts_t pp_key = {};
+};
+
 class ec_ctrl_configurator_t : public ec_configurator_t {
 public:
     
@@ -262,6 +278,59 @@ private:
 	 */
 	cJSON *finalize_config_obj(cJSON *base, ec_connection_context_t& conn_ctx, dpp_config_obj_type_e config_obj_type);
 
+	/**
+	 * @brief Handles one proxied DPP frame from an Enrollee, on the owner thread or on a crypto pool worker.
+	 *
+	 * @return true if the frame was handled successfully
+	 */
+	bool handle_proxied_frame(ec_frame_type_t frame_type, uint8_t *encap_frame, uint16_t encap_frame_len, uint8_t src_mac[ETH_ALEN]);
+
+	/**
+	 * @brief Queues a proxied DPP frame on the Enrollee's crypto pool strand.
+	 *
+	 * Authentication Responses and DPP Configuration Requests, whose handling is dominated by ECDH, HKDF and
+	 * Connector signing, are handled on a worker; the data model lookups they need are made here, up front, and
+	 * the frames they send are sent from the owner thread once the job completes. Other frames of an Enrollee
+	 * with a job in flight are handled on the owner thread behind it, to keep the order of the exchange.
+	 *
+	 * @return true if the frame was queued
+	 */
+	bool dispatch_to_crypto_pool(ec_frame_type_t frame_type, uint8_t *encap_frame, uint16_t encap_frame_len, uint8_t src_mac[ETH_ALEN]);
+
+	/**
+	 * @brief Sends a Proxied Encap DPP message, or queues it for the owner thread when called from a crypto pool worker.
+	 */
+	bool send_encap_dpp(em_encap_dpp_t *encap_tlv, size_t encap_tlv_len, em_dpp_chirp_value_t *chirp_tlv, size_t chirp_tlv_len);
+
+	/**
+	 * @brief Base DPP Configuration object from the data model, prefetched when called from a crypto pool worker.
+	 */
+	cJSON *get_config_obj_base(dpp_config_obj_type_e config_obj_type, ec_connection_context_t *conn_ctx);
+
+	/**
+	 * @brief Whether another AP may be onboarded, prefetched when called from a crypto pool worker.
+	 */
+	bool can_onboard_additional_aps();
+
+	/**
+	 * @brief Get the Configurator keys on the curve of @p c_ctx, generating them on first use.
+	 *
+	 * EasyConnect 7.5: the Configurator generates its (c-sign-key, C-sign-key) pair when it is set up, and signs the
+	 * Connectors of all Enrollees with it. Safe to call from crypto pool workers.
+	 *
+	 * @param[in] c_ctx Connection context of an Enrollee.
+	 * @param[in] create Whether to generate the keys if there are none yet on this curve.
+	 *
+	 * @return The keys, nullptr on failure or if there are none and @p create is false.
+	 */
+	std::shared_ptr<const ec_configurator_keys_t> get_configurator_keys(ec_connection_context_t& c_ctx, bool create = true);
+
+	std::unique_ptr<ec_crypto_pool_t> m_crypto_pool = nullptr;
+
+	std::mutex m_keys_lock = {};
+	// Keyed by curve NID
+	std::unordered_map<int, std::shared_ptr<const ec_configurator_keys_t>> m_keys = {};
+
     /**
      * @brief Maps Enrollee MAC (as string) to onboarded status. True if onboarded (now a Proxy Agent), false if still onboarding / onboarding failed.
      * 
@@ -185,6 +185,17 @@ public:
 	ec_enrollee_t(const ec_enrollee_t&) = delete;
     ec_enrollee_t& operator=(const ec_enrollee_t&) = delete;
 
+	/**
+	 * @brief Sets the functions used to arm and cancel manager timers
+	 *
+	 * @param add_timer_fn Function to arm a timer
+	 * @param cancel_timer_fn Function to cancel a timer
+	 */
+	inline void set_timer_fns(add_timer_func add_timer_fn, cancel_timer_func cancel_timer_fn) {
+		m_add_timer = add_timer_fn;
+		m_cancel_timer = cancel_timer_fn;
+	}
+
 	/**
 	 * @brief Adds a frequency to send Presence Announcement frames on
 	 * 
@@ -280,6 +291,12 @@ private:
 	 */	
 	bsta_connect_func m_bsta_connect_fn;
 
+	/**
+	 * @brief Functions to arm and cancel timers on the EasyMesh manager thread
+	 */
+	add_timer_func m_add_timer = nullptr;
+	cancel_timer_func m_cancel_timer = nullptr;
+
 
 
     const ec_dpp_capabilities_t m_dpp_caps = {{
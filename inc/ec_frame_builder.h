@@ -0,0 +1,181 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EC_FRAME_BUILDER_H
+#define EC_FRAME_BUILDER_H
+
+#include "ec_util.h"
+
+#include <string>
+#include <utility>
+
+// Enough for every DPP Authentication frame on P-256/P-384 without growing the buffer
+#define EC_FRAME_BUILDER_DEFAULT_CAPACITY 512
+// Wrapped Data may hold one more Wrapped Data (e.g. { R-auth }ke inside the Authentication Response)
+#define EC_FRAME_BUILDER_MAX_WRAP_DEPTH 2
+
+/**
+ * @brief Builds an EasyConnect frame in a single buffer.
+ *
+ * The frame header and the attributes are written in place, one after the other, into a buffer sized
+ * up front for the whole frame; the buffer only grows (geometrically) if a frame outgrows it.
+ * A Wrapped Data attribute is opened with begin_wrapped(), its attributes are added as plaintext right
+ * behind the reserved SIV tag, and end_wrapped() encrypts them with AES-SIV where they are.
+ * finish() hands the buffer to the caller, ready for send_action_frame(), so building a frame
+ * costs one allocation and no copies instead of one realloc per attribute plus a copy per wrap.
+ *
+ * Errors are sticky: once an add fails, every following call is a no-op and finish() returns {NULL, 0},
+ * so a frame can be built without checking each step.
+ *
+ * The layout is byte for byte what ec_util::add_attrib(), ec_util::add_wrapped_data_attr() and
+ * ec_util::copy_attrs_to_frame() produce.
+ */
+class ec_frame_builder_t {
+public:
+
+	/**
+	 * @brief Construct a frame builder
+	 *
+	 * @param[in] capacity Initial size of the buffer in bytes
+	 */
+	explicit ec_frame_builder_t(size_t capacity = EC_FRAME_BUILDER_DEFAULT_CAPACITY);
+
+	~ec_frame_builder_t();
+
+	ec_frame_builder_t(const ec_frame_builder_t&) = delete;
+	ec_frame_builder_t& operator=(const ec_frame_builder_t&) = delete;
+
+	/**
+	 * @brief Start a DPP Public Action frame with the default WFA parameters and the given type.
+	 *
+	 * @param[in] type The frame type
+	 *
+	 * @return true on success, false if the buffer could not be allocated
+	 */
+	bool begin(ec_frame_type_t type);
+
+	/**
+	 * @brief Start a frame with a zeroed header of @p base_len bytes, e.g. a GAS frame, or an
+	 * attribute-only buffer (DPP Configuration object) when @p base_len is 0.
+	 *
+	 * The header is filled in by the caller through base().
+	 *
+	 * @param[in] base_len Length of the fixed part of the frame preceding the attributes
+	 *
+	 * @return true on success, false if the buffer could not be allocated
+	 */
+	bool begin(size_t base_len);
+
+	/**
+	 * @brief Append an attribute.
+	 *
+	 * @param[in] id The attribute ID, in host byte ordering.
+	 * @param[in] len The length of the attribute data, in host byte ordering.
+	 * @param[in] data The attribute data. If NULL, @p len zeroed bytes are reserved and returned.
+	 *
+	 * @return uint8_t* The data of the attribute in the buffer (valid until the next add), NULL on failure
+	 */
+	uint8_t *add_attrib(ec_attrib_id_t id, uint16_t len, const uint8_t *data);
+
+	/**
+	 * @brief Append a string attribute (without the terminating NUL).
+	 */
+	inline uint8_t *add_attrib(ec_attrib_id_t id, const std::string& str) {
+		return add_attrib(id, static_cast<uint16_t>(str.length()), reinterpret_cast<const uint8_t *>(str.c_str()));
+	}
+
+	/**
+	 * @brief Append a one octet attribute.
+	 */
+	inline uint8_t *add_attrib(ec_attrib_id_t id, uint8_t val) {
+		return add_attrib(id, sizeof(uint8_t), &val);
+	}
+
+	/**
+	 * @brief Append a two octet attribute, @p val in host byte ordering as ec_util::add_attrib() does.
+	 */
+	inline uint8_t *add_attrib(ec_attrib_id_t id, uint16_t val) {
+		return add_attrib(id, sizeof(uint16_t), reinterpret_cast<const uint8_t *>(&val));
+	}
+
+	/**
+	 * @brief Open a Wrapped Data attribute. Attributes added until the matching end_wrapped() are encrypted.
+	 *
+	 * @return true on success, false if the nesting is deeper than EC_FRAME_BUILDER_MAX_WRAP_DEPTH
+	 */
+	bool begin_wrapped();
+
+	/**
+	 * @brief Close the innermost Wrapped Data attribute and encrypt its attributes in place.
+	 *
+	 * With @p use_aad, the AAD are the frame header (when there is one) and the attributes preceding
+	 * the Wrapped Data attribute at its own nesting level, as in ec_util::add_wrapped_data_attr().
+	 *
+	 * @param[in] use_aad Whether to use AAD in the encryption.
+	 * @param[in] key The key to use for encryption (SIV_256).
+	 *
+	 * @return true on success
+	 */
+	bool end_wrapped(bool use_aad, const uint8_t *key);
+
+	/**
+	 * @brief Hand the finished frame to the caller.
+	 *
+	 * The builder is left empty; the next begin() allocates a new buffer.
+	 *
+	 * @return std::pair<uint8_t*, size_t> The heap allocated frame and its length, {NULL, 0} if building it failed.
+	 *
+	 * @warning The frame must be freed by the caller with free().
+	 */
+	std::pair<uint8_t *, size_t> finish();
+
+	/**
+	 * @brief Drop the frame being built, keeping the buffer for the next begin().
+	 */
+	void reset();
+
+	/**
+	 * @brief The frame being built; only valid until the next add.
+	 */
+	inline uint8_t *base() { return m_buff; }
+	inline ec_frame_t *frame() { return reinterpret_cast<ec_frame_t *>(m_buff); }
+
+	/**
+	 * @brief Length of the frame and of its attributes so far
+	 */
+	inline size_t len() const { return m_len; }
+	inline size_t attribs_len() const { return m_len - m_base_len; }
+
+	inline bool failed() const { return m_failed; }
+
+private:
+	bool reserve(size_t extra);
+
+	uint8_t *m_buff = NULL;
+	size_t m_cap = 0;
+	size_t m_len = 0;
+	size_t m_base_len = 0;
+	size_t m_init_cap;
+	bool m_failed = false;
+
+	// Offsets of the open Wrapped Data attributes, innermost last
+	size_t m_wrap_off[EC_FRAME_BUILDER_MAX_WRAP_DEPTH] = {};
+	unsigned int m_wrap_depth = 0;
+};
+
+#endif // EC_FRAME_BUILDER_H
@@ -211,6 +211,18 @@ public:
 		return m_enrollee->is_onboarding();
 	}
 
+	/**
+	 * @brief Get the hit/miss/eviction counters of the configurator session caches.
+	 *
+	 * @param stats The counters, zeroed if this node has no configurator
+	 */
+	inline void get_session_cache_stats(ec_session_cache_stats_t& stats) {
+		stats = {};
+		if (m_configurator) {
+			m_configurator->get_session_cache_stats(stats);
+		}
+	}
+
 	/**
 	 * @brief Handle a CCE information element being heard
 	 * (add the frequency the CCE IE was heard on to Enrollee's list of Presence Announcement frequencies)
@@ -236,6 +248,16 @@ public:
 	 */
 	bool handle_bss_info_event(const wifi_bss_info_t& bss_info);
 
+	/**
+	 * @brief Set the functions the configurator or enrollee use to arm and cancel EasyMesh manager timers
+	 *
+	 * The functions are kept and handed to a configurator created later, e.g. on upgrade to a proxy agent.
+	 *
+	 * @param add_timer_fn Function to arm a timer
+	 * @param cancel_timer_fn Function to cancel a timer
+	 */
+	void set_timer_fns(add_timer_func add_timer_fn, cancel_timer_func cancel_timer_fn);
+
 
 private:
     bool m_is_controller;
@@ -253,6 +275,8 @@ private:
     std::unique_ptr<ec_configurator_t> m_configurator;
     std::unique_ptr<ec_enrollee_t> m_enrollee;
     toggle_cce_func m_toggle_cce_fn;
+    add_timer_func m_add_timer_fn = nullptr;
+    cancel_timer_func m_cancel_timer_fn = nullptr;
 };
 
 #endif // EC_MANAGER_H
\ No newline at end of file
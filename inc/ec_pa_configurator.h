@@ -6,6 +6,15 @@
 #include <map>
 #include <vector>
 
+// Stored DPP Authentication Requests wait for the Enrollee's next chirp
+#define EC_PA_CHIRP_CACHE_CAPACITY      64
+#define EC_PA_CHIRP_CACHE_TTL_S         600
+#define EC_PA_RECFG_CACHE_CAPACITY      16
+#define EC_PA_RECFG_CACHE_TTL_S         3600
+// GAS sessions only span one configuration exchange
+#define EC_PA_GAS_CACHE_CAPACITY        64
+#define EC_PA_GAS_CACHE_TTL_S           60
+
 class ec_pa_configurator_t : public ec_configurator_t {
 public:
     
@@ -188,12 +197,19 @@ public:
      */
     toggle_cce_func m_toggle_cce;
 
+	/**
+	 * @brief Collects the hit/miss/eviction counters of the connection cache and of the Proxy Agent frame caches.
+	 *
+	 * @param[out] stats The counters, summed over all caches
+	 */
+	void get_session_cache_stats(ec_session_cache_stats_t& stats) override;
+
 private:
     // Private member variables go here
     /*
      * Map from Chirp Hash to DPP Authentication Request
      */
-    std::map<std::string, std::vector<uint8_t>> m_chirp_hash_frame_map = {};
+    ec_session_cache_t<std::string, std::vector<uint8_t>> m_chirp_hash_frame_map{EC_PA_CHIRP_CACHE_CAPACITY, EC_PA_CHIRP_CACHE_TTL_S};
 
 	/**
 	 * @brief Map of stored DPP Reconfiguration Authentication Requests
@@ -201,15 +217,25 @@ private:
 	 * Key -> C-sign key hash as a string
 	 * Value -> Vector of DPP Reconfiguration Authentication Request frames
 	 */
-	std::unordered_map<std::string, std::vector<uint8_t>> m_stored_recfg_auth_frames_map = {};
+	ec_session_cache_t<std::string, std::vector<uint8_t>> m_stored_recfg_auth_frames_map{EC_PA_RECFG_CACHE_CAPACITY, EC_PA_RECFG_CACHE_TTL_S};
 
 	/**
 	 * @brief Stored GAS frame session dialog tokens with peers.
 	 * 
-	 * Key -> Peer MAC, as a string
+	 * Key -> Peer MAC, packed with ec_session_cache::mac_key()
 	 * Value -> GAS session dialog token for the peer.
 	 */
-	std::unordered_map<std::string, uint8_t> m_gas_session_dialog_tokens = {};
+	ec_session_cache_t<uint64_t, uint8_t> m_gas_session_dialog_tokens{EC_PA_GAS_CACHE_CAPACITY, EC_PA_GAS_CACHE_TTL_S};
+
+	/**
+	 * @brief Frees the GAS Comeback Response fragments that were not sent to a peer.
+	 */
+	static inline void release_gas_frames(const uint64_t&, std::vector<ec_gas_comeback_response_frame_t*>& fragments) {
+		for (auto *f : fragments) {
+			free(f);
+		}
+		fragments.clear();
+	}
 
 	/**
 	 * @brief Sends a "dummy" GAS Initial Response frame indicating to the Peer that we have fragmented data for it
@@ -234,7 +260,8 @@ private:
 	 * @brief Queue'd fragments to be sent to a peer once they indicate (via a GAS Comeback Request frame) that they are ready to receive more fragments
 	 * 
 	 */
-	std::unordered_map<std::string, std::vector<ec_gas_comeback_response_frame_t*>> m_gas_frames_to_be_sent = {};
+	ec_session_cache_t<uint64_t, std::vector<ec_gas_comeback_response_frame_t*>> m_gas_frames_to_be_sent{EC_PA_GAS_CACHE_CAPACITY,
+		EC_PA_GAS_CACHE_TTL_S, &ec_pa_configurator_t::release_gas_frames};
 
 protected:
     // Protected member variables and methods go here
@@ -0,0 +1,287 @@
+#ifndef EC_SESSION_CACHE_H
+#define EC_SESSION_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Counters of a session cache, summed over caches by ec_session_cache_stats_add().
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;     // least recently used entries dropped to stay within the capacity
+    uint64_t expirations;   // entries dropped after being idle for longer than the TTL
+    size_t size;
+} ec_session_cache_stats_t;
+
+/**
+ * @brief Adds the counters of @p src to @p dst.
+ */
+inline void ec_session_cache_stats_add(ec_session_cache_stats_t& dst, const ec_session_cache_stats_t& src) {
+    dst.hits += src.hits;
+    dst.misses += src.misses;
+    dst.inserts += src.inserts;
+    dst.evictions += src.evictions;
+    dst.expirations += src.expirations;
+    dst.size += src.size;
+}
+
+namespace ec_session_cache {
+
+    /**
+     * @brief Packs a binary MAC address into a cache key.
+     */
+    inline uint64_t mac_key(const uint8_t mac[6]) {
+        uint64_t key = 0;
+        for (int i = 0; i < 6; i++) {
+            key = (key << 8) | mac[i];
+        }
+        return key;
+    }
+
+    /**
+     * @brief Packs a MAC address string as produced by util::mac_to_string() into a cache key.
+     *
+     * @return The key, 0 if the string is not a MAC address.
+     */
+    inline uint64_t mac_key(const std::string& mac) {
+        uint64_t key = 0;
+        int digits = 0;
+        for (char c : mac) {
+            int nibble;
+            if (c >= '0' && c <= '9') nibble = c - '0';
+            else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+            else continue;
+            key = (key << 4) | static_cast<uint64_t>(nibble);
+            digits++;
+        }
+        return (digits == 12) ? key : 0;
+    }
+}
+
+/**
+ * @brief Bounded map of per peer EasyConnect session state with LRU and idle TTL eviction.
+ *
+ * Entries live in a list ordered by last use, most recent first, indexed by a hash map, so a lookup
+ * refreshes an entry in O(1) and the entries to drop are always at the tail. An entry not used for
+ * ttl_s seconds is dropped on the next lookup of it or on the next insert; an insert into a full
+ * cache drops the least recently used entry. Every dropped or replaced value is handed to the
+ * release function first, which frees whatever the value owns (OpenSSL objects, frame buffers).
+ *
+ * Pointers returned by find() and insert() stay valid until the entry is dropped. An entry pinned with
+ * pin() is neither evicted nor expired until unpinned, so its value can be used outside the owner thread.
+ * The cache is not locked, callers sharing it between threads serialize access themselves.
+ *
+ * @tparam K Key type, a packed MAC address (see ec_session_cache::mac_key()) or a hash string
+ * @tparam V Value type
+ */
+template <typename K, typename V, typename H = std::hash<K>>
+class ec_session_cache_t {
+public:
+
+    /**
+     * @brief Frees the resources owned by a value before it is dropped.
+     */
+    using release_func = std::function<void(const K&, V&)>;
+
+    /**
+     * @brief Construct a session cache
+     *
+     * @param capacity Maximum number of entries, at least 1
+     * @param ttl_s Idle time in seconds after which an entry is dropped, 0 to keep entries until evicted or erased
+     * @param release Function freeing the resources of a dropped value, nullptr if values own nothing
+     */
+    ec_session_cache_t(size_t capacity, unsigned int ttl_s, release_func release = nullptr) :
+        m_capacity((capacity == 0) ? 1 : capacity), m_ttl(std::chrono::seconds(ttl_s)), m_release(release) {
+    }
+
+    ~ec_session_cache_t() {
+        clear();
+    }
+
+    ec_session_cache_t(const ec_session_cache_t&) = delete;
+    ec_session_cache_t& operator=(const ec_session_cache_t&) = delete;
+
+    /**
+     * @brief Looks up an entry and marks it as the most recently used.
+     *
+     * @return The value, nullptr if the key is unknown or the entry expired
+     */
+    V* find(const K& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if ((it->second->pins == 0) && is_expired(*it->second, now)) {
+            m_stats.expirations++;
+            m_stats.misses++;
+            drop(it->second);
+            return nullptr;
+        }
+        it->second->last_used = now;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        m_stats.hits++;
+        return &it->second->value;
+    }
+
+    /**
+     * @brief Adds an entry, or replaces the value of an existing one after releasing it.
+     *
+     * Expired entries are dropped first, then the least recently used ones while the cache is full.
+     *
+     * @return The stored value
+     */
+    V& insert(const K& key, V value) {
+        auto now = std::chrono::steady_clock::now();
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            release(*it->second);
+            it->second->value = std::move(value);
+            it->second->last_used = now;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            m_stats.inserts++;
+            return it->second->value;
+        }
+
+        expire(now);
+        while (m_lru.size() >= m_capacity) {
+            // Evict the least recently used entry not pinned, the cache overflows if every entry is pinned
+            auto victim = m_lru.end();
+            for (auto rit = m_lru.rbegin(); rit != m_lru.rend(); ++rit) {
+                if (rit->pins == 0) {
+                    victim = std::prev(rit.base());
+                    break;
+                }
+            }
+            if (victim == m_lru.end()) {
+                break;
+            }
+            m_stats.evictions++;
+            drop(victim);
+        }
+
+        m_lru.push_front(entry_t{key, std::move(value), now, 0});
+        m_index[key] = m_lru.begin();
+        m_stats.inserts++;
+        return m_lru.front().value;
+    }
+
+    /**
+     * @brief Keeps an entry from being evicted or expired until the matching unpin(). Pins nest.
+     *
+     * @return true if the key was present
+     */
+    bool pin(const K& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        it->second->pins++;
+        return true;
+    }
+
+    /**
+     * @brief Releases a pin taken with pin(); the entry's idle time restarts.
+     */
+    void unpin(const K& key) {
+        auto it = m_index.find(key);
+        if ((it == m_index.end()) || (it->second->pins == 0)) {
+            return;
+        }
+        it->second->pins--;
+        it->second->last_used = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Releases and drops an entry, pinned or not.
+     *
+     * @return true if the key was present
+     */
+    bool erase(const K& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        drop(it->second);
+        return true;
+    }
+
+    /**
+     * @brief Drops every entry idle for longer than the TTL.
+     */
+    void expire() {
+        expire(std::chrono::steady_clock::now());
+    }
+
+    /**
+     * @brief Releases and drops every entry.
+     */
+    void clear() {
+        for (auto& entry : m_lru) {
+            release(entry);
+        }
+        m_lru.clear();
+        m_index.clear();
+    }
+
+    inline size_t size() const { return m_lru.size(); }
+
+    inline ec_session_cache_stats_t get_stats() const {
+        ec_session_cache_stats_t stats = m_stats;
+        stats.size = m_lru.size();
+        return stats;
+    }
+
+private:
+    struct entry_t {
+        K key;
+        V value;
+        std::chrono::steady_clock::time_point last_used;
+        unsigned int pins;
+    };
+
+    using entry_iter_t = typename std::list<entry_t>::iterator;
+
+    inline bool is_expired(const entry_t& entry, std::chrono::steady_clock::time_point now) const {
+        return (m_ttl.count() != 0) && ((now - entry.last_used) > m_ttl);
+    }
+
+    inline void release(entry_t& entry) {
+        if (m_release) {
+            m_release(entry.key, entry.value);
+        }
+    }
+
+    void drop(entry_iter_t it) {
+        release(*it);
+        m_index.erase(it->key);
+        m_lru.erase(it);
+    }
+
+    void expire(std::chrono::steady_clock::time_point now) {
+        // The tail is the least recently used, stop at the first entry still alive or pinned
+        while (!m_lru.empty() && (m_lru.back().pins == 0) && is_expired(m_lru.back(), now)) {
+            m_stats.expirations++;
+            drop(std::prev(m_lru.end()));
+        }
+    }
+
+    size_t m_capacity;
+    std::chrono::steady_clock::duration m_ttl;
+    release_func m_release;
+    std::list<entry_t> m_lru = {};
+    std::unordered_map<K, entry_iter_t, H> m_index = {};
+    ec_session_cache_stats_t m_stats = {};
+};
+
+#endif // EC_SESSION_CACHE_H
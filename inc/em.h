@@ -32,6 +32,7 @@
 #include "em_policy_cfg.h"
 #include "dm_easy_mesh.h"
 #include "em_sm.h"
+#include "em_timer.h"
 
 #include "util.h"
 
@@ -62,6 +63,8 @@ class em_t :
     bool    m_exit;
     bool m_is_al_em;
     bool dev_test_enable;
+	std::set<unsigned int>	m_timer_ids;	// armed through add_timer(), cancelled in deinit()
+	pthread_mutex_t	m_timer_lock;
 	
 	/**
 	 * @brief Set of hashed messages that have been sent in co-located systems
@@ -453,6 +456,30 @@ public:
 	 */
 	em_mgr_t *get_mgr() { return m_mgr; }
 
+	/**!
+	 * @brief Arms a manager timer owned by this node.
+	 *
+	 * The callback runs on the manager thread. Timers still armed when the node is
+	 * deinitialized are cancelled and will not start afterwards. A callback that is
+	 * already running when cancel_timer() or deinit() is called from another thread is
+	 * not waited for, so a callback that references the node must only be cancelled
+	 * from the manager thread or be harmless to run once more during teardown.
+	 *
+	 * @param[in] ms Delay in milliseconds.
+	 * @param[in] periodic Re-arm the timer every @p ms.
+	 * @param[in] cb Callback.
+	 *
+	 * @returns Timer id for cancel_timer().
+	 */
+	unsigned int add_timer(unsigned int ms, bool periodic, em_timer_cb_t cb);
+
+	/**!
+	 * @brief Cancels a timer armed with add_timer().
+	 *
+	 * @returns 0 on success, -1 if the timer already expired or does not exist.
+	 */
+	int cancel_timer(unsigned int id);
+
     
 	/**!
 	 * @brief Retrieves the EC Manager instance.
@@ -512,6 +539,11 @@ public:
 	 * @returns The current state of the state machine as an em_state_t.
 	 */
 	em_state_t get_state() { return m_sm.get_state(); }
+
+	/**!
+	 * @brief Retrieves a copy of the transition counts, timeouts and dwell time histograms of the state machine.
+	 */
+	em_sm_stats_t get_sm_stats() { return m_sm.get_stats(); }
     
 	/**!
 	 * @brief Sets the state of the state machine.
@@ -651,6 +683,34 @@ public:
 	 */
 	em_cmd_t *get_current_cmd()  { return m_cmd; }    
 
+	/**!
+	 * @brief Retrieves the metrics time series store of the manager.
+	 *
+	 * @returns The store, or NULL if the manager keeps no metrics history.
+	 */
+	em_metrics_store_t *get_metrics_store();
+
+	/**!
+	 * @brief Retrieves the channel planner of the manager.
+	 *
+	 * @returns The planner, or NULL if the manager does not plan channels.
+	 */
+	em_channel_planner_t *get_channel_planner();
+
+	/**!
+	 * @brief Retrieves the client steering engine of the manager.
+	 *
+	 * @returns The engine, or NULL if the manager does not steer clients.
+	 */
+	em_steer_engine_t *get_steer_engine();
+
+	/**!
+	 * @brief Retrieves the client capability cache of the manager.
+	 *
+	 * @returns The cache, or NULL if the manager does not query client capabilities.
+	 */
+	em_client_cap_cache_t *get_client_cap_cache();
+
     
 	/**!
 	 * @brief Retrieves the crypto object.
@@ -49,12 +49,15 @@ extern "C"
 #define EM_PROTO_TOUT   1
 #define EM_METRICS_REQ_MULT 5
 #define EM_MGR_TOUT     500 // in milliseconds
+#define EM_MGR_MAX_EVENT_BATCH	64 // events dispatched before due timers are serviced
 #define EM_1_TOUT_MULT 	2
 #define EM_2_TOUT_MULT 	4	
 #define EM_5_TOUT_MULT 	10	
 #define EM_CTRL_CAP_SZ  8
 #define MIN_MAC_LEN 12
 #define MAX_EM_BUFF_SZ  1024
+#define EM_MAX_SAP_BATCH    32
+#define EM_SAP_RECONNECT_INTERVAL   1   // seconds between attempts to reach the IEEE1905 application again
 #define EM_MAX_FRAME_BODY_LEN	512
 #define MAX_VENDOR_INFO 5
 #define EM_MAX_BEACON_MEASUREMENT_LEN  400
@@ -1955,6 +1958,7 @@ typedef enum {
     em_cmd_type_mld_reconfig,
     em_cmd_type_beacon_report,
     em_cmd_type_ap_metrics_report,
+    em_cmd_type_get_metrics,
 
     em_cmd_type_max,
 } em_cmd_type_t;
@@ -2606,6 +2610,7 @@ typedef enum {
     em_bus_event_type_assoc_status,
     em_bus_event_type_ap_metrics_report,
     em_bus_event_type_bss_info,
+    em_bus_event_type_get_metrics,
 
     em_bus_event_type_max
 } em_bus_event_type_t;
@@ -2729,6 +2734,7 @@ typedef enum {
 typedef struct {
     unsigned int db_cfg_type;
 	em_long_string_t	db_cfg_criteria[EM_MAX_DB_CFG_CRITERIA];
+	unsigned int	unsaved_cfg_type;	// db_cfg_type_t bits of changes kept in memory only, never written to the database
 } em_db_cfg_param_t;
 
 typedef struct{
@@ -2857,6 +2863,7 @@ typedef enum {
 
 typedef struct {
     bool collapsed;
+    bool modified;     // the node or a descendant changed in the last merge_network_tree()
     unsigned int orig_node_ctr;
     unsigned int node_ctr;
     unsigned int node_pos;
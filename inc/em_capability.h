@@ -22,6 +22,7 @@
 #include "em_base.h"
 #include "dm_easy_mesh.h"
 #include "em.h"
+#include "em_client_cap_cache.h"
 
 class em_cmd_t;
 class em_capability_t {
@@ -215,6 +216,13 @@ class em_capability_t {
 	 * @note This is a pure virtual function and must be implemented by derived classes.
 	 */
 	virtual em_cmd_t *get_current_cmd() = 0;
+
+	/**!
+	 * @brief Retrieves the client capability cache of the service, if it keeps one.
+	 *
+	 * @returns The cache, or NULL when every report is stored as received.
+	 */
+	virtual em_client_cap_cache_t *get_client_cap_cache() = 0;
     
 	/**!
 	 * @brief Creates the basic capabilities for an AP radio.
@@ -592,6 +600,15 @@ class em_capability_t {
 	 */
 	int handle_client_cap_report(unsigned char *data, unsigned int len);
 
+	/**!
+	 * @brief Queues a reported STA for the STA list update of the data model.
+	 *
+	 * @param[in] dm Data model of the reporting agent.
+	 * @param[in] sta_info STA, BSS and capabilities.
+	 * @param[in] changed False when the capabilities repeat the cached ones, a STA already stored on the BSS is then left as is.
+	 */
+	void store_client_cap(dm_easy_mesh_t *dm, em_sta_info_t *sta_info, bool changed);
+
 public:
     
 	/**!
@@ -20,6 +20,7 @@
 #define EM_CHANNEL_H
 
 #include "em_base.h"
+#include "em_channel_planner.h"
 
 class em_cmd_t;
 class em_channel_t {
@@ -752,6 +753,13 @@ public:
 	 */
 	virtual em_freq_band_t get_band() = 0;
 
+	/**!
+	 * @brief Retrieves the channel planner of the service, if it runs one.
+	 *
+	 * @returns The planner, or NULL when scan reports should only update the data model.
+	 */
+	virtual em_channel_planner_t *get_channel_planner() = 0;
+
     
 	/**!
 	 * @brief Constructor for em_channel_t.
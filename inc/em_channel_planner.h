@@ -0,0 +1,204 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_CHANNEL_PLANNER_H
+#define EM_CHANNEL_PLANNER_H
+
+#include <time.h>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "em_base.h"
+
+#define EM_CHAN_PLAN_TICK_S		5	// planning pass period
+#define EM_CHAN_PLAN_BIN_MHZ		5	// resolution of the per band spectrum grid
+#define EM_CHAN_PLAN_UNIT		1000	// weight of a strong neighbour sharing a 20 MHz channel
+#define EM_CHAN_PLAN_HYSTERESIS		1000	// minimum gain of a move
+#define EM_CHAN_PLAN_HYSTERESIS_PCT	25	// and minimum share of the current cost
+#define EM_CHAN_PLAN_HOLD_S		600	// minimum time between two moves of a radio
+#define EM_CHAN_PLAN_SETTLE_S		30	// data model channel ignored after a move until the agent reports it
+#define EM_CHAN_PLAN_MAX_MOVES		4	// moves emitted per pass
+#define EM_CHAN_PLAN_BW_BONUS		500	// cost credit per bandwidth doubling
+#define EM_CHAN_PLAN_PREF_PENALTY	1500	// channel listed in the radio's channel preference report
+#define EM_CHAN_PLAN_DFS_PENALTY	500
+#define EM_CHAN_PLAN_UTIL_WEIGHT	2000	// channel fully utilised as measured by the scanner
+#define EM_CHAN_PLAN_SCAN_MAX_AGE	600	// seconds, as EM_SCAN_RESULT_MAX_AGE
+#define EM_CHAN_PLAN_MIN_RSSI		-95	// weaker neighbours do not count
+#define EM_CHAN_PLAN_MAX_RSSI		-45	// full weight from here
+
+typedef struct {
+	mac_address_t	al_mac;
+	mac_address_t	ruid;
+	unsigned char	op_class;
+	unsigned char	channel;
+	unsigned char	prev_op_class;
+	unsigned char	prev_channel;
+	long long	gain;		// cost reduction, EM_CHAN_PLAN_UNIT per strong co-channel neighbour
+} em_chan_plan_move_t;
+
+typedef struct {
+	unsigned int	num_radios;
+	unsigned int	num_planned;	// radios with a current channel and candidates
+	unsigned int	num_edges;	// pairs of mesh radios hearing each other
+	unsigned int	num_scans;
+	unsigned long long	passes;
+	unsigned long long	scored;		// radios scored, only the ones touched since their last pass are
+	unsigned long long	moves;
+	unsigned long long	held;		// better channel found but not worth a move yet
+} em_chan_plan_stats_t;
+
+// sends the Channel Selection Requests of @p num moves, returns -1 if none could be sent
+using em_chan_plan_apply_func = std::function<int(const em_chan_plan_move_t *moves, unsigned int num)>;
+
+/**
+ * @brief Controller channel planner driven by the channel scan reports of the agents.
+ *
+ * Each radio keeps an interference load over a 5 MHz grid of its band. Neighbours outside
+ * the mesh add their RSSI and channel utilisation weighted span from the scan reports; mesh
+ * radios heard in a scan become edges of an interference graph and add the span of their
+ * current channel. Edge weights are the sum of both directions, so they are symmetric.
+ *
+ * The load is kept up to date incrementally: a scan result replaces only its own previous
+ * contribution and a channel change only touches the radios on the edges of the radio that
+ * moved. Both mark the radios whose load changed, and a pass only scores those, so a new
+ * scan report costs work proportional to its neighbours rather than to the network.
+ *
+ * Scoring builds the prefix sums of the load, after which every candidate operating class and
+ * channel costs two lookups. A move is emitted when the best candidate improves on the current
+ * channel by EM_CHAN_PLAN_HYSTERESIS and EM_CHAN_PLAN_HYSTERESIS_PCT, at most once per
+ * EM_CHAN_PLAN_HOLD_S per radio and EM_CHAN_PLAN_MAX_MOVES per pass.
+ *
+ * Scan results come from the em threads, the sync and the passes from the manager thread.
+ */
+class em_channel_planner_t {
+	typedef struct {
+		unsigned char	op_class = 0;
+		unsigned char	channel = 0;
+		unsigned short	lo = 0;		// occupied bins [lo, hi) of the band grid
+		unsigned short	hi = 0;
+		int	bias = 0;		// preference, DFS and bandwidth terms
+	} cand_t;
+
+	typedef struct {
+		unsigned short	lo = 0;
+		unsigned short	hi = 0;
+		int	weight = 0;
+	} span_t;
+
+	// contribution of one scan result of a radio
+	typedef struct {
+		unsigned long long	ruid = 0;
+		std::vector<span_t>	spans = {};	// neighbours outside the mesh and the channel utilisation
+		std::vector<std::pair<unsigned long long, int> >	heard = {};	// mesh radios
+		time_t	last_update = 0;
+	} scan_t;
+
+	typedef struct {
+		mac_address_t	al_mac = {};
+		int	grid = -1;
+		unsigned int	generation = 0;
+		bool	observed = false;
+		unsigned long long	sig = 0;	// operating classes the candidates were built from
+		std::vector<cand_t>	cands = {};
+		cand_t	cur = {};
+		bool	has_cur = false;
+		std::vector<int>	load = {};		// interference per bin of the band grid
+		std::unordered_map<unsigned long long, int>	edges = {};	// mesh radios hearing or heard by this one
+		unsigned int	num_scans = 0;
+		bool	dirty = false;
+		time_t	last_move = 0;
+	} radio_t;
+
+	std::mutex	m_lock;
+	std::unordered_map<unsigned long long, radio_t>	m_radios;
+	std::unordered_map<unsigned long long, scan_t>	m_scans;	// ruid, op class and channel
+	std::unordered_map<unsigned long long, std::pair<unsigned long long, unsigned int> >	m_bss;	// mesh BSSID to ruid, generation
+	em_chan_plan_apply_func	m_apply;
+	unsigned int	m_generation;
+	std::vector<long long>	m_prefix;
+	em_chan_plan_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static void key_to_mac(unsigned long long key, unsigned char *mac);
+	static time_t now_s();
+	static bool make_span(int grid, unsigned int centre, unsigned int width, unsigned short *lo, unsigned short *hi);
+	static bool make_cand(int grid, unsigned int op_class, unsigned int channel, cand_t *cand);
+	static bool nbr_span(unsigned int channel, const em_neighbor_t *nbr, int grid, span_t *span);	// NULL nbr for the scanned channel
+	static int nbr_weight(const em_neighbor_t *nbr);
+
+	radio_t& get_radio(unsigned long long key);
+	void add_span(radio_t& radio, const span_t& span, int sign);
+	void add_heard(unsigned long long from, unsigned long long to, int weight);
+	void set_current(unsigned long long key, radio_t& radio, const cand_t *cand);
+	void drop_scan(unsigned long long key);
+	void rebuild_load(unsigned long long key, radio_t& radio);
+	long long cost(const cand_t& cand);
+	void build_candidates(radio_t& radio, const em_op_class_info_t *op_classes[], unsigned int num, const unsigned char *ruid);
+
+public:
+
+	/**!
+	 * @brief Returns the band grid of an operating class, -1 for a class the planner does not plan.
+	 *
+	 * Operating classes of the same band share a grid.
+	 */
+	static int get_op_class_grid(unsigned int op_class);
+
+	/**!
+	 * @brief Starts a sync pass, radios and BSSes not observed until end_sync() are no longer planned.
+	 */
+	void begin_sync();
+
+	/**!
+	 * @brief Reports a radio of a configured agent.
+	 *
+	 * @param[in] ruid Radio.
+	 * @param[in] al_mac AL MAC address of the agent.
+	 * @param[in] op_classes Capability and current operating classes of the radio and the preference
+	 * operating classes of the agent, other entries are ignored. Candidates are only rebuilt when these change.
+	 * @param[in] num Number of operating classes.
+	 */
+	void observe_radio(const unsigned char *ruid, const unsigned char *al_mac, const em_op_class_info_t *op_classes[], unsigned int num);
+
+	/**!
+	 * @brief Reports a BSS of the mesh, scan neighbours with this BSSID are edges to @p ruid.
+	 */
+	void observe_bss(const unsigned char *bssid, const unsigned char *ruid);
+
+	void end_sync();
+
+	/**!
+	 * @brief Replaces the contribution of a channel scan result of radio @p res->id.scanner_mac.
+	 */
+	void update_scan_result(const em_scan_result_t *res);
+
+	/**!
+	 * @brief Ages out scan results, scores the radios touched since the last pass and emits the moves.
+	 *
+	 * @returns Number of moves emitted.
+	 */
+	unsigned int run();
+
+	const em_chan_plan_stats_t *get_stats();
+
+	em_channel_planner_t(em_chan_plan_apply_func apply);
+	~em_channel_planner_t();
+};
+
+#endif
@@ -21,6 +21,7 @@
 
 #include "em_base.h"
 #include "em_cmd_exec.h"
+#include "em_dm_snapshot.h"
 
 class em_cli_t {
     
@@ -40,6 +41,7 @@ class em_cli_t {
 	 */
 	em_cmd_t& get_command(char *in, size_t in_len, em_network_node_t *node = NULL);
     em_long_string_t	m_lib_dbg_file_name;
+	em_dm_snapshot_t	m_dm_snapshot;
 public:
 
 	em_cli_params_t	m_params;
@@ -140,6 +142,11 @@ public:
 	 */
 	void dump_lib_dbg(char *str);
 
+	/**!
+	 * @brief Retrieves the reader of the controller data model snapshot, mapped on first use.
+	 */
+	em_dm_snapshot_t *get_dm_snapshot() { return &m_dm_snapshot; }
+
 	/**!
 	 * @brief Constructor for the em_cli_t class.
 	 *
@@ -289,6 +289,19 @@ extern "C" {
 	 */
 	em_network_node_t *clone_network_tree(em_network_node_t *node);
 
+	/**!
+	 * @brief Merges a freshly fetched network tree into the current one.
+	 *
+	 * Unchanged subtrees of @p prev are kept, changed nodes and their ancestors are flagged in
+	 * display_info.modified.
+	 *
+	 * @param[in,out] prev Current tree.
+	 * @param[in] next New tree, still to be freed by the caller.
+	 *
+	 * @returns Number of changed nodes, 0 when the trees are identical.
+	 */
+	unsigned int merge_network_tree(em_network_node_t *prev, em_network_node_t *next);
+
 	/**!
 	 * @brief Clones a network tree for display purposes.
 	 *
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_CLIENT_CAP_CACHE_H
+#define EM_CLIENT_CAP_CACHE_H
+
+#include <time.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "em_base.h"
+
+#define EM_CLIENT_CAP_TTL_S		300	// seconds reported capabilities answer new associations
+#define EM_CLIENT_CAP_QUERY_TIMEOUT_S	5	// seconds a query stays outstanding before the next association re-sends it
+
+typedef enum {
+	em_client_cap_lookup_miss,	// no fresh capabilities, the caller sends the query
+	em_client_cap_lookup_hit,	// fresh capabilities returned, no query needed
+	em_client_cap_lookup_pending,	// a query to the same agent is outstanding, its report answers this BSS too
+} em_client_cap_lookup_t;
+
+// (Re)Association Request frame body of a Client Capability Report, immutable once cached
+typedef std::shared_ptr<const std::vector<unsigned char>> em_client_cap_body_t;
+
+typedef struct {
+	bssid_t	bssid;
+	mac_address_t	ruid;
+} em_client_cap_waiter_t;
+
+typedef struct {
+	unsigned int	num_stas;
+	unsigned int	num_pending;
+	unsigned long long	hits;		// associations answered from the cache
+	unsigned long long	misses;		// queries sent
+	unsigned long long	coalesced;	// associations folded into an outstanding query
+	unsigned long long	changed;	// reports with new capabilities
+	unsigned long long	unchanged;	// reports repeating the cached capabilities
+	unsigned long long	expired;
+} em_client_cap_stats_t;
+
+/**
+ * @brief Controller cache of the Client Capability Reports, keyed by STA.
+ *
+ * Every STA keeps the frame body of its last report, its FNV-1a hash and the time it was received.
+ * An association looked up within EM_CLIENT_CAP_TTL_S of the report is answered from the cache
+ * without a Client Capability Query. Otherwise one query per STA and agent is outstanding at a
+ * time: further associations of the STA on BSSes of that agent wait for its report instead of
+ * sending their own.
+ *
+ * The frame body is held once per STA and handed out as a shared pointer, a report repeating the
+ * cached capabilities keeps the existing body.
+ *
+ * Lookups come from the manager thread, reports from the em threads.
+ */
+class em_client_cap_cache_t {
+	typedef struct {
+		unsigned long long	agent = 0;
+		time_t	time = 0;
+		std::vector<em_client_cap_waiter_t>	waiters = {};
+	} pending_t;
+
+	typedef struct {
+		em_client_cap_body_t	body = nullptr;
+		unsigned long long	hash = 0;
+		time_t	time = 0;
+		std::vector<pending_t>	pending = {};	// one per agent queried
+	} entry_t;
+
+	std::mutex	m_lock;
+	std::unordered_map<unsigned long long, entry_t>	m_entries;
+	em_client_cap_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static time_t now_s();
+
+public:
+
+	/**!
+	 * @brief Hashes a frame body, FNV-1a.
+	 */
+	static unsigned long long hash(const unsigned char *body, unsigned int len);
+
+	/**!
+	 * @brief Looks the capabilities of a STA up for its association to a BSS.
+	 *
+	 * @param[in] sta STA.
+	 * @param[in] agent AL MAC of the agent the STA associated to.
+	 * @param[in] bssid BSS the STA associated to.
+	 * @param[in] ruid Radio of the BSS.
+	 * @param[out] body Cached frame body, set on a hit only.
+	 *
+	 * @returns em_client_cap_lookup_miss when the caller must send the query, which is then outstanding.
+	 */
+	em_client_cap_lookup_t lookup(const unsigned char *sta, const unsigned char *agent, const unsigned char *bssid,
+		const unsigned char *ruid, em_client_cap_body_t *body);
+
+	/**!
+	 * @brief Stores the Client Capability Report of a STA and ends the query outstanding to the agent.
+	 *
+	 * @param[in] sta STA.
+	 * @param[in] agent AL MAC of the reporting agent.
+	 * @param[in] body Frame body of the report.
+	 * @param[in] len Length of @p body.
+	 * @param[out] shared Cached frame body, the existing one when unchanged.
+	 * @param[out] waiters BSSes whose associations waited for this report.
+	 *
+	 * @returns true if the capabilities are new or differ from the cached ones.
+	 */
+	bool update(const unsigned char *sta, const unsigned char *agent, const unsigned char *body, unsigned int len,
+		em_client_cap_body_t *shared, std::vector<em_client_cap_waiter_t> *waiters);
+
+	/**!
+	 * @brief Drops timed out queries and STAs whose capabilities are past EM_CLIENT_CAP_TTL_S.
+	 *
+	 * @returns Number of STAs dropped.
+	 */
+	unsigned int expire();
+
+	const em_client_cap_stats_t *get_stats();
+
+	em_client_cap_cache_t();
+	~em_client_cap_cache_t();
+};
+
+#endif
@@ -41,6 +41,8 @@ public:
     unsigned int m_rd_op_class;
     unsigned int m_rd_channel;
     unsigned int m_db_cfg_type;
+    unsigned int m_fanout_job;      // em_fanout_t job the command was dispatched for, 0 if none
+    unsigned int m_fanout_index;
 
 public:
     
@@ -631,6 +633,15 @@ public:
 	 * @note Ensure that the command type provided is valid to avoid unexpected results.
 	 */
 	static const char *get_cmd_type_str(em_cmd_type_t type);    
+
+	/**!
+	 * @brief Retrieves the string a command output status is reported with, as in the Status of a reply.
+	 *
+	 * @param[in] status The command output status.
+	 *
+	 * @returns A constant character pointer to the string representation of the status.
+	 */
+	static const char *get_out_status_str(em_cmd_out_status_t status);
     
 	/**!
 	 * @brief Dumps the bus event details.
@@ -28,6 +28,15 @@ extern em_cli_t g_cli;
 class em_cmd_cli_t : public em_cmd_exec_t {
 
     em_cli_t& m_cli = g_cli;
+
+	/**!
+	 * @brief Answers a get command from the controller data model snapshot.
+	 *
+	 * @param[out] result Reply, formatted as the controller would send it.
+	 *
+	 * @returns 0 if the snapshot holds the subdoc, -1 if the command must go to the controller.
+	 */
+	int read_dm_snapshot(char *result);
 public:
     static em_cmd_t m_client_cmd_spec[];
 public:
@@ -59,6 +59,29 @@ public:
 	 */
 	int send_result(em_cmd_out_status_t status);
 
+	/**!
+	 * @brief Keeps the connection of the command being handled open once its handler returns.
+	 *
+	 * The connection is no longer the one send_result(em_cmd_out_status_t) answers, the command that
+	 * held it replies with send_result(int, em_cmd_out_status_t, const char *) once its outcome is known.
+	 *
+	 * @returns The connection, -1 if there is none.
+	 */
+	int hold_result();
+
+	/**!
+	 * @brief Replies on a connection kept with hold_result() and closes it.
+	 *
+	 * @param[in] sock The connection.
+	 * @param[in] status The status of the command.
+	 * @param[in] result JSON document reported as the Result, NULL for none.
+	 *
+	 * @returns int
+	 * @retval 0 on success
+	 * @retval -1 on failure
+	 */
+	static int send_result(int sock, em_cmd_out_status_t status, const char *result);
+
     
 	/**!
 	 * @brief Constructor for em_cmd_ctrl_t class.
@@ -717,6 +717,16 @@ public:
 	static void free_key(SSL_KEY* key);
 
     
+	/**
+	 * @brief Take a reference on an SSL_KEY object, to share it without copying.
+	 *
+	 * @param[in] key The SSL_KEY object to reference.
+	 *
+	 * @return SSL_KEY* @p key, NULL on failure. Each reference is released with free_key().
+	 */
+	static SSL_KEY* ref_key(SSL_KEY* key);
+
+    
 	/**
 	 * @brief Write an SSL_KEY to a PEM file
 	 *
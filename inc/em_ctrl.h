@@ -19,12 +19,17 @@
 #ifndef EMCTRL_H
 #define EMCTRL_H
 
+#include <map>
 #include "em.h"
 #include "em_mgr.h"
 #include "dm_easy_mesh_ctrl.h"
 #include "em_orch_ctrl.h"
 #include "bus.h"
 #include "em_dev_test_ctrl.h"
+#include "em_sta_metrics_sched.h"
+#include "em_fanout.h"
+#include "em_disc_sched.h"
+#include "em_dm_snapshot.h"
 
 class em_cmd_ctrl_t;
 class AlServiceAccessPoint;
@@ -36,7 +41,85 @@ class em_ctrl_t : public em_mgr_t {
     em_orch_ctrl_t *m_orch;
 	bus_handle_t m_bus_hdl;
 	em_dev_test_t dev_test;
-    
+	em_sta_metrics_sched_t m_sta_metrics;
+	unsigned int m_sta_metrics_timer;
+	unsigned int m_sta_metrics_log_ticks;
+	em_metrics_store_t m_metrics_store;
+	em_channel_planner_t m_channel_planner;
+	unsigned int m_channel_plan_log_ticks;
+	em_steer_engine_t m_steer_engine;
+	em_policy_sync_t m_policy_sync;
+	em_fanout_t m_fanout;
+	std::map<unsigned int, int> m_fanout_replies;	// CLI connections answered once their job finishes, by job
+	em_disc_sched_t m_disc_sched;
+	em_dm_snapshot_t m_dm_snapshot;
+	unsigned int m_dm_snapshot_pending;	// db_cfg_type_t bits of the changes not published yet
+    
+	/**!
+	 * @brief Feeds the associated STAs of every configured radio to the STA link metrics scheduler.
+	 */
+	void sync_sta_metrics();
+
+	/**!
+	 * @brief Sends Associated STA Link Metrics Queries for @p num STAs through the em of radio @p ruid.
+	 *
+	 * @returns 0 if every query was sent, -1 otherwise.
+	 */
+	int send_sta_metrics_queries(const unsigned char *ruid, mac_address_t *stas, unsigned int num);
+
+	/**!
+	 * @brief Feeds the operating classes and BSSes of every configured radio to the channel planner.
+	 */
+	void sync_channel_planner();
+
+	/**!
+	 * @brief Submits the set channel commands of @p num channel planner moves.
+	 *
+	 * @returns 0 if the commands were submitted, -1 otherwise.
+	 */
+	int apply_channel_plan(const em_chan_plan_move_t *moves, unsigned int num);
+
+	/**!
+	 * @brief Feeds the BSSes, steering policies and associated STAs of every configured radio to the steering engine.
+	 */
+	void sync_steer_engine();
+
+	/**!
+	 * @brief Submits the client steering command of a steering engine decision.
+	 *
+	 * @returns 0 if the command was submitted, -1 otherwise.
+	 */
+	int apply_steer_request(const em_steer_req_params_t *req);
+
+	/**!
+	 * @brief Submits set policy commands resending the policy TLVs agent radios did not acknowledge in time.
+	 */
+	void retry_policy_requests();
+
+	/**!
+	 * @brief Builds and submits the commands of the fan-out targets that fit in their job window.
+	 */
+	void dispatch_fanout();
+
+	/**!
+	 * @brief Times out lost fan-out targets, logs the composite result of every job that finished and
+	 * replies to the CLI command that started it with the outcome of each target.
+	 */
+	void expire_fanout();
+
+	/**!
+	 * @brief Sends a Topology Query to every agent the discovery scheduler finds due and logs the lost ones.
+	 */
+	void probe_topology();
+
+	/**!
+	 * @brief Republishes to the shared memory snapshot the subdocs of the get commands the last data model changes touched.
+	 *
+	 * Runs right after the dirty data models are flushed, and only renews the heartbeat if nothing changed.
+	 * Nothing is rendered while no reader has the snapshot mapped.
+	 */
+	void publish_dm_snapshot();
+
 	/**!
 	 * @brief Handles a bus event.
 	 *
@@ -367,6 +450,15 @@ public:
 	 * @note Ensure that the event structure is properly initialized before calling this function.
 	 */
 	void handle_get_dm_data(em_bus_event_t *evt);
+
+	/**!
+	 * @brief Handles the retrieval of metrics history.
+	 *
+	 * Encodes the rollups of one entity, or a summary of the store when the entity is "all", into the subdoc of the event.
+	 *
+	 * @param[in] evt Pointer to the event structure, args[2] holds the entity MAC and the subdoc name an optional "@<resolution>" suffix.
+	 */
+	void handle_get_metrics(em_bus_event_t *evt);
     
 	/**!
 	 * @brief Handles the DM commit event.
@@ -469,6 +561,55 @@ public:
 	 * @note If the AL MAC address is not provided, the function will use a default value.
 	 */
 	dm_easy_mesh_t *get_data_model(const char *net_id, const unsigned char *al_mac = NULL) { return m_data_model.get_data_model(net_id, al_mac); }
+
+	/**!
+	 * @brief Retrieves the metrics time series store fed by the metrics handlers.
+	 *
+	 * @returns A pointer to the controller's store.
+	 */
+	em_metrics_store_t *get_metrics_store() { return &m_metrics_store; }
+
+	/**!
+	 * @brief Retrieves the channel planner fed by the channel scan reports.
+	 *
+	 * @returns A pointer to the controller's planner.
+	 */
+	em_channel_planner_t *get_channel_planner() { return &m_channel_planner; }
+
+	/**!
+	 * @brief Retrieves the client steering engine fed by the metrics and steering reports.
+	 *
+	 * @returns A pointer to the controller's engine.
+	 */
+	em_steer_engine_t *get_steer_engine() { return &m_steer_engine; }
+
+	/**!
+	 * @brief Retrieves the client capability cache of the data model.
+	 *
+	 * @returns A pointer to the controller's cache.
+	 */
+	em_client_cap_cache_t *get_client_cap_cache() { return m_data_model.get_client_cap_cache(); }
+
+	/**!
+	 * @brief Retrieves the record of the policy TLVs acknowledged by the agents.
+	 *
+	 * @returns A pointer to the controller's record.
+	 */
+	em_policy_sync_t *get_policy_sync() { return &m_policy_sync; }
+
+	/**!
+	 * @brief Retrieves the fan-out of the commands that target every agent.
+	 *
+	 * @returns A pointer to the controller's fan-out.
+	 */
+	em_fanout_t *get_fanout() { return &m_fanout; }
+
+	/**!
+	 * @brief Retrieves the per agent scheduler of the topology probes.
+	 *
+	 * @returns A pointer to the controller's scheduler.
+	 */
+	em_disc_sched_t *get_disc_sched() { return &m_disc_sched; }
     
 	/**!
 	 * @brief Creates a data model for the specified network ID and interface.
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_DISC_SCHED_H
+#define EM_DISC_SCHED_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "em_base.h"
+
+#define EM_DISC_MIN_INTERVAL_MS		5000	// new, changed or silent neighbours
+#define EM_DISC_MAX_INTERVAL_MS		60000	// neighbours whose topology did not change for a while
+#define EM_DISC_MAX_MISSED		3	// unanswered probes in a row before a neighbour is lost
+
+typedef struct {
+	unsigned int	num_neighbours;
+	unsigned int	num_lost;
+	unsigned long long	probes;
+	unsigned long long	responses;
+	unsigned long long	changed;	// responses that differ from the previous one, the topology is rebuilt
+	unsigned long long	unchanged;	// responses identical to the previous one, the rebuild is skipped
+	unsigned long long	notified;	// topology notifications, each one re-probes right away
+	unsigned long long	missed;
+	unsigned long long	losses;
+	unsigned long long	recoveries;
+} em_disc_stats_t;
+
+typedef struct {
+	mac_address_t	al;
+	unsigned int	missed;		// probes of the neighbour unanswered in a row
+} em_disc_probe_t;
+
+/**
+ * @brief Per neighbour scheduling of the topology probes.
+ *
+ * Each neighbour, keyed by its AL MAC, is probed on its own interval. A response identical to the
+ * previous one doubles the interval up to EM_DISC_MAX_INTERVAL_MS; a response that differs, a topology
+ * notification or a missed probe drops it back to EM_DISC_MIN_INTERVAL_MS so a flapping link is followed
+ * closely while the stable part of the mesh is left alone. A probe still unanswered when the next one is
+ * due counts as missed and EM_DISC_MAX_MISSED misses in a row declare the neighbour lost.
+ *
+ * Time is passed in by the caller, in monotonic ms.
+ */
+class em_disc_sched_t {
+	typedef struct {
+		mac_address_t	al;
+		unsigned long long	due = 0;
+		unsigned int	interval = EM_DISC_MIN_INTERVAL_MS;
+		unsigned long long	resp_hash = 0;
+		unsigned int	missed = 0;
+		unsigned int	gen = 0;
+		bool	has_resp = false;
+		bool	outstanding = false;
+		bool	lost = false;
+	} neighbour_t;
+
+	std::mutex	m_lock;
+	std::unordered_map<unsigned long long, neighbour_t>	m_neighbours;
+	unsigned int	m_gen;
+	em_disc_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+
+	neighbour_t& get(const unsigned char *al, unsigned long long now);
+
+public:
+
+	/**!
+	 * @brief Monotonic ms, the time base of the scheduler.
+	 */
+	static unsigned long long now_ms();
+
+	/**!
+	 * @brief Hashes a topology response, FNV-1a over its TLVs up to the End of Message TLV.
+	 *
+	 * @p buff is the frame as received. The Ethernet and CMDU headers, whose message id differs from one
+	 * response to the next, and any padding after the End of Message TLV are left out.
+	 */
+	static unsigned long long hash(const unsigned char *buff, unsigned int len);
+
+	/**!
+	 * @brief Tracks a neighbour, the first probe of a new one is due after one to two EM_DISC_MIN_INTERVAL_MS.
+	 */
+	void observe(const unsigned char *al, unsigned long long now);
+
+	/**!
+	 * @brief Stops tracking the neighbours not observed since the previous sweep.
+	 *
+	 * @returns Number of neighbours removed.
+	 */
+	unsigned int sweep();
+
+	/**!
+	 * @brief Collects the neighbours to probe at @p now and the ones declared lost.
+	 *
+	 * Every neighbour returned in @p probe is expected to be sent a Topology Query.
+	 *
+	 * @returns Number of neighbours to probe.
+	 */
+	unsigned int run(unsigned long long now, std::vector<em_disc_probe_t> *probe, std::vector<em_disc_probe_t> *lost);
+
+	/**!
+	 * @brief Records the topology response of a neighbour.
+	 *
+	 * @param[in] al AL MAC of the neighbour.
+	 * @param[in] hash Hash of the response.
+	 * @param[in] now Monotonic ms.
+	 *
+	 * @returns true if the response differs from the previous one, or the neighbour was lost.
+	 */
+	bool heard(const unsigned char *al, unsigned long long hash, unsigned long long now);
+
+	/**!
+	 * @brief Records a topology notification of a neighbour, it is probed on the next run.
+	 */
+	void notify(const unsigned char *al, unsigned long long now);
+
+	const em_disc_stats_t *get_stats();
+
+	em_disc_sched_t();
+	~em_disc_sched_t();
+};
+
+#endif
@@ -20,8 +20,10 @@
 #define EM_DISCOVERY_H
 
 #include "em_base.h"
+#include "em_disc_sched.h"
 
 class em_cmd_t;
+class em_mgr_t;
 class em_discovery_t {
 
     
@@ -170,8 +172,40 @@ class em_discovery_t {
 	 * @note This is a pure virtual function and must be implemented by derived classes.
 	 */
 	virtual em_cmd_t *get_current_cmd() = 0;
+
+	/**!
+	 * @brief Retrieves the manager instance.
+	 *
+	 * @returns A pointer to the manager instance of type em_mgr_t.
+	 */
+	virtual em_mgr_t *get_mgr() = 0;
+
+	/**!
+	 * @brief Retrieves the service type of the entity.
+	 *
+	 * @returns The service type as an em_service_type_t value.
+	 */
+	virtual em_service_type_t get_service_type() = 0;
     
 public:
+
+	/**!
+	 * @brief Reports a topology response to the discovery scheduler of the controller.
+	 *
+	 * @param[in] buff Pointer to the buffer containing the response.
+	 * @param[in] len Length of the buffer.
+	 *
+	 * @returns true if the topology must be rebuilt from the response, false if it is the same as the last one.
+	 */
+	bool handle_topo_probe_resp(unsigned char *buff, unsigned int len);
+
+	/**!
+	 * @brief Reports a topology notification to the discovery scheduler of the controller, the agent is probed again.
+	 *
+	 * @param[in] buff Pointer to the buffer containing the notification.
+	 * @param[in] len Length of the buffer.
+	 */
+	void handle_topo_probe_notif(unsigned char *buff, unsigned int len);
     
 	/**!
 	 * @brief Processes a message with the given data and length.
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_DM_SNAPSHOT_H
+#define EM_DM_SNAPSHOT_H
+
+#include <atomic>
+#include "em_base.h"
+
+#define EM_DM_SNAPSHOT_NAME		"/onewifi_mesh_dm"	// POSIX shared memory object of the controller
+#define EM_DM_SNAPSHOT_MAGIC		0x454d4453	// "EMDS"
+#define EM_DM_SNAPSHOT_VERSION		1	// bumped on any change of the layout below
+#define EM_DM_SNAPSHOT_MAX_SLOTS	16	// subdocs published at a time
+#define EM_DM_SNAPSHOT_SLOT_SZ		EM_MAX_EVENT_DATA_LEN	// largest subdoc, same bound as the socket reply
+#define EM_DM_SNAPSHOT_STALE_MS		5000	// readers fall back to the controller socket past this heartbeat age
+#define EM_DM_SNAPSHOT_MAX_RETRIES	64	// reads overlapping a publish before the reader gives up
+
+// one subdoc, written under its own sequence count: odd while the writer is in it
+typedef struct {
+	std::atomic<unsigned int>	seq;
+	unsigned int	len;		// data bytes, NUL included, 0 if the slot is free
+	unsigned long long	epoch;	// snapshot epoch the data was published in
+	unsigned long long	hash;
+	em_subdoc_name_space_t	name;
+	em_long_string_t	key;
+	char	data[EM_DM_SNAPSHOT_SLOT_SZ];
+} em_dm_snapshot_slot_t;
+
+typedef struct {
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	num_slots;
+	unsigned int	slot_sz;
+	std::atomic<unsigned long long>	epoch;		// bumped by every publish that changed at least one slot
+	std::atomic<unsigned long long>	heartbeat_ms;	// monotonic ms of the last publish pass
+	em_dm_snapshot_slot_t	slots[EM_DM_SNAPSHOT_MAX_SLOTS];
+} em_dm_snapshot_hdr_t;
+
+typedef struct {
+	unsigned int	num_slots;
+	unsigned long long	epoch;
+	unsigned long long	published;	// slots rewritten
+	unsigned long long	unchanged;	// subdocs rendered identical to the published slot
+	unsigned long long	oversized;	// subdocs larger than EM_DM_SNAPSHOT_SLOT_SZ, left to the socket
+	unsigned long long	unread;		// checks that found no reader, the pass was left out
+} em_dm_snapshot_stats_t;
+
+// a subdoc the controller publishes and the tables it is rendered from
+typedef struct {
+	const char	*name;
+	unsigned int	cfg;	// db_cfg_type_t bits, a change to any of them renders the subdoc again
+} em_dm_snapshot_subdoc_t;
+
+/**
+ * @brief Read-only copy of the controller data model subdocs in shared memory.
+ *
+ * The controller is the only writer. It renders a subdoc the way a get command would and rewrites its
+ * slot only if the rendering differs from the published one, so an unchanged data model costs a hash per
+ * subdoc and no write. Each slot is a seqlock: readers copy the slot and retry if its sequence count was
+ * odd or moved meanwhile, they never block the writer nor each other and never reach the controller queues.
+ *
+ * A reader instance is meant for one thread. It holds a shared lock on the segment while it maps it, so
+ * the writer can tell whether anyone reads and skip the whole pass, heartbeat included, while nobody does.
+ * A reader that finds the heartbeat older than EM_DM_SNAPSHOT_STALE_MS maps the segment again once, the
+ * controller may have restarted or not published yet, and reports the snapshot unavailable if it is still stale.
+ */
+class em_dm_snapshot_t {
+	em_long_string_t	m_name;
+	em_dm_snapshot_hdr_t	*m_hdr;
+	int	m_fd;
+	bool	m_writer;
+	em_dm_snapshot_stats_t	m_stats;
+
+	static unsigned long long now_ms();
+	static unsigned long long hash(const char *data, unsigned int len);
+
+	em_dm_snapshot_slot_t *find_slot(const char *name, const char *key);
+	int map(bool writer);
+
+public:
+
+	/**!
+	 * @brief Creates the segment and maps it for writing, any previous one is replaced.
+	 *
+	 * @returns 0 on success, -1 otherwise.
+	 */
+	int create();
+
+	/**!
+	 * @brief Maps the segment of the controller for reading.
+	 *
+	 * @returns 0 on success, -1 if there is no segment or its layout differs.
+	 */
+	int open();
+
+	/**!
+	 * @brief Unmaps the segment, the writer also removes it.
+	 */
+	void close();
+
+	bool is_open() { return m_hdr != NULL; }
+
+	/**!
+	 * @brief Checks whether a reader has the segment mapped, for the writer to skip publishing otherwise.
+	 *
+	 * @returns true if a reader holds the segment, or if that cannot be told.
+	 */
+	bool has_readers();
+
+	/**!
+	 * @brief Publishes a subdoc.
+	 *
+	 * @param[in] name Subdoc name, as in the get command.
+	 * @param[in] key Key of the get command, the network id.
+	 * @param[in] data Subdoc, NUL terminated.
+	 *
+	 * @returns 1 if the slot was rewritten, 0 if it already held @p data, -1 if it does not fit.
+	 */
+	int publish(const char *name, const char *key, const char *data);
+
+	/**!
+	 * @brief Ends a publish pass, the epoch moves if a slot was rewritten and the heartbeat is renewed.
+	 */
+	void commit(bool changed);
+
+	/**!
+	 * @brief Reads a subdoc.
+	 *
+	 * @param[in] name Subdoc name.
+	 * @param[in] key Key of the get command.
+	 * @param[out] buff Copy of the subdoc, NUL terminated.
+	 * @param[in] len Size of @p buff.
+	 * @param[out] epoch Epoch the subdoc was published in, may be NULL.
+	 *
+	 * @returns Bytes copied, NUL included, -1 if the subdoc is not published, is stale or kept changing.
+	 */
+	int read(const char *name, const char *key, char *buff, unsigned int len, unsigned long long *epoch = NULL);
+
+	const em_dm_snapshot_stats_t *get_stats();
+
+	/**!
+	 * @brief Gets a subdoc the controller publishes.
+	 *
+	 * @param[in] index Index of the subdoc, from 0.
+	 *
+	 * @returns The subdoc, NULL past the last one.
+	 */
+	static const em_dm_snapshot_subdoc_t *get_subdoc(unsigned int index);
+
+	/**!
+	 * @brief Checks whether a subdoc must be rendered again.
+	 *
+	 * @param[in] subdoc Subdoc, as returned by get_subdoc().
+	 * @param[in] changed_cfg db_cfg_type_t bits changed since the last publish pass, ~0 for all of them.
+	 *
+	 * @returns true if the subdoc depends on a changed table.
+	 */
+	static bool is_changed(const em_dm_snapshot_subdoc_t *subdoc, unsigned int changed_cfg);
+
+	/**!
+	 * @param[in] name Shared memory object of the segment, the controller and its readers use EM_DM_SNAPSHOT_NAME.
+	 */
+	em_dm_snapshot_t(const char *name = EM_DM_SNAPSHOT_NAME);
+	~em_dm_snapshot_t();
+};
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_FANOUT_H
+#define EM_FANOUT_H
+
+#include <time.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "em_base.h"
+
+#define EM_FANOUT_WINDOW		8	// targets of a job in orchestration at a time
+#define EM_FANOUT_TARGET_TIMEOUT_S	(EM_MAX_CMD_GEN_TTL + 5)	// the orchestration cancels first, this catches targets whose command got lost
+#define EM_FANOUT_MAX_RESULTS		8	// finished jobs kept for get_result() and get_targets()
+
+// bus event of the controller-wide command, held once per job and never modified once the job starts
+typedef std::shared_ptr<std::vector<unsigned char>> em_fanout_payload_t;
+
+typedef enum {
+	em_fanout_target_queued,
+	em_fanout_target_dispatched,
+	em_fanout_target_succeeded,
+	em_fanout_target_failed,
+	em_fanout_target_timed_out,
+} em_fanout_target_state_t;
+
+typedef struct {
+	mac_address_t	mac;
+	em_fanout_target_state_t	state;
+} em_fanout_target_t;
+
+typedef struct {
+	unsigned int	job = 0;
+	unsigned int	index = 0;	// target index, the per target command is built from the payload for it
+	em_cmd_type_t	type = em_cmd_type_none;
+	mac_address_t	mac = {0};
+	em_fanout_payload_t	payload = nullptr;
+} em_fanout_dispatch_t;
+
+typedef struct {
+	unsigned int	job;
+	em_cmd_type_t	type;
+	unsigned int	num_targets;
+	unsigned int	queued;
+	unsigned int	in_flight;
+	unsigned int	succeeded;
+	unsigned int	failed;
+	unsigned int	timed_out;
+	unsigned int	elapsed_s;
+	bool	done;
+} em_fanout_result_t;
+
+typedef struct {
+	unsigned int	num_jobs;
+	unsigned int	in_flight;
+	unsigned long long	jobs;
+	unsigned long long	dispatched;
+	unsigned long long	succeeded;
+	unsigned long long	failed;
+	unsigned long long	timed_out;
+} em_fanout_stats_t;
+
+/**
+ * @brief Controller fan-out of the commands that target every agent.
+ *
+ * A job holds the command payload once and a small state per target. At most its window of targets
+ * is dispatched at a time: the caller builds the command of a target from the shared payload only
+ * when next() hands the target out, and reports its outcome with complete(). A job of a command type
+ * runs alone, the next one of the same type is refused until it finishes.
+ *
+ * Jobs are started, dispatched and expired on the manager thread, outcomes come from the orchestration.
+ */
+class em_fanout_t {
+	typedef struct {
+		unsigned int	id = 0;
+		em_cmd_type_t	type = em_cmd_type_none;
+		em_fanout_payload_t	payload = nullptr;
+		unsigned int	window = 0;
+		std::vector<em_fanout_target_t>	targets = {};
+		std::vector<time_t>	dispatch_time = {};
+		unsigned int	next = 0;	// first queued target
+		unsigned int	in_flight = 0;
+		time_t	start = 0;
+	} job_t;
+
+	typedef struct {
+		em_fanout_result_t	result;
+		std::vector<em_fanout_target_t>	targets;
+	} finished_t;
+
+	std::mutex	m_lock;
+	std::deque<job_t>	m_jobs;
+	std::deque<finished_t>	m_results;
+	unsigned int	m_next_id;
+	em_fanout_stats_t	m_stats;
+
+	static time_t now_s();
+	static void fill_result(const job_t& job, time_t now, em_fanout_result_t *result);
+
+	job_t *find_job(unsigned int id);
+
+public:
+
+	/**!
+	 * @brief Starts a job.
+	 *
+	 * @param[in] type Command type, one job per type at a time.
+	 * @param[in] targets Targets, in dispatch order.
+	 * @param[in] payload Payload shared by the commands of every target.
+	 * @param[in] window Targets dispatched at a time, EM_FANOUT_WINDOW if 0.
+	 *
+	 * @returns Job id, 0 if there are no targets or a job of @p type is running.
+	 */
+	unsigned int start(em_cmd_type_t type, const std::vector<em_fanout_target_t>& targets, em_fanout_payload_t payload,
+		unsigned int window = EM_FANOUT_WINDOW);
+
+	/**!
+	 * @brief Tells if a job of @p type is running.
+	 */
+	bool is_in_progress(em_cmd_type_t type);
+
+	/**!
+	 * @brief Hands the next target out for dispatch, if a job has room in its window.
+	 *
+	 * @returns false if no target can be dispatched now.
+	 */
+	bool next(em_fanout_dispatch_t *dispatch);
+
+	/**!
+	 * @brief Reports the outcome of a dispatched target.
+	 *
+	 * @returns false if the target is not dispatched, its outcome is already known.
+	 */
+	bool complete(unsigned int job, unsigned int index, em_fanout_target_state_t state);
+
+	/**!
+	 * @brief Times out the targets dispatched for more than EM_FANOUT_TARGET_TIMEOUT_S and ends the finished jobs.
+	 *
+	 * @param[out] done Composite results of the jobs that finished.
+	 *
+	 * @returns Number of jobs that finished.
+	 */
+	unsigned int expire(std::vector<em_fanout_result_t> *done);
+
+	/**!
+	 * @brief Composite result of a running job or of one of the last EM_FANOUT_MAX_RESULTS finished ones.
+	 *
+	 * @returns false if the job is unknown.
+	 */
+	bool get_result(unsigned int job, em_fanout_result_t *result);
+
+	/**!
+	 * @brief Targets of a running job or of one of the last EM_FANOUT_MAX_RESULTS finished ones, with their outcome.
+	 *
+	 * @returns false if the job is unknown.
+	 */
+	bool get_targets(unsigned int job, std::vector<em_fanout_target_t> *targets);
+
+	/**!
+	 * @brief Retrieves a copy of the job counts, taken under the lock the em threads complete targets under.
+	 */
+	em_fanout_stats_t get_stats();
+
+	em_fanout_t();
+	~em_fanout_t();
+};
+
+#endif
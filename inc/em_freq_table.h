@@ -0,0 +1,192 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_FREQ_TABLE_H
+#define EM_FREQ_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+/**
+ * @brief Region of the operating class tables behind util::em_chan_to_freq() and util::em_freq_to_chan()
+ */
+typedef enum {
+    em_freq_region_global,      // "": global operating classes only
+    em_freq_region_us,
+    em_freq_region_eu,
+    em_freq_region_jp,
+    em_freq_region_cn,
+    em_freq_region_other,       // Any other region: global operating classes only
+    em_freq_region_max
+} em_freq_region_t;
+
+typedef struct {
+    uint8_t op_class;
+    uint8_t min_chan;
+    uint8_t max_chan;
+    uint16_t base_freq;
+    uint16_t spacing;
+    em_freq_region_t region;    // em_freq_region_global for global operating classes
+} em_freq_range_t;
+
+// Channels/Op-classes/Frequencies adapted from `hostapd/src/common/ieee80211_common.c:ieee80211_chan_to_freq`
+inline constexpr em_freq_range_t em_freq_ranges[] = {
+    // Global frequency ranges
+    // 2.4 GHz band
+    {81, 1, 13, 2407, 5, em_freq_region_global},      // channels 1-13
+    {82, 14, 14, 2414, 5, em_freq_region_global},     // channel 14
+    {83, 1, 13, 2407, 5, em_freq_region_global},      // channels 1-9; 40 MHz
+    {84, 5, 13, 2407, 5, em_freq_region_global},      // channels 5-13; 40 MHz
+
+    // 5 GHz band
+    {115, 36, 48, 5000, 5, em_freq_region_global},    // channels 36-48; indoor only
+    {116, 36, 44, 5000, 5, em_freq_region_global},    // channels 36,44; 40 MHz
+    {117, 40, 48, 5000, 5, em_freq_region_global},    // channels 40,48; 40 MHz
+    {118, 52, 64, 5000, 5, em_freq_region_global},    // channels 52-64; dfs
+    {119, 52, 60, 5000, 5, em_freq_region_global},    // channels 52,60; 40 MHz
+    {120, 56, 64, 5000, 5, em_freq_region_global},    // channels 56,64; 40 MHz
+    {121, 100, 140, 5000, 5, em_freq_region_global},  // channels 100-140
+    {122, 100, 142, 5000, 5, em_freq_region_global},  // channels 100-142; 40 MHz
+    {123, 104, 136, 5000, 5, em_freq_region_global},  // channels 104-136; 40 MHz
+    {124, 149, 161, 5000, 5, em_freq_region_global},  // channels 149-161
+    {125, 149, 177, 5000, 5, em_freq_region_global},  // channels 149-177
+    {126, 149, 173, 5000, 5, em_freq_region_global},  // channels 149-173; 40 MHz
+    {127, 153, 177, 5000, 5, em_freq_region_global},  // channels 153-177; 40 MHz
+    {128, 36, 177, 5000, 5, em_freq_region_global},   // 80 MHz centered on 42,58,106,122,138,155,171
+    {129, 36, 177, 5000, 5, em_freq_region_global},   // 160 MHz centered on 50,114,163
+    {130, 36, 177, 5000, 5, em_freq_region_global},   // As class 128
+
+    // 6 GHz band (UHB channels)
+    {131, 1, 233, 5950, 5, em_freq_region_global},    // 20 MHz
+    {132, 3, 233, 5950, 5, em_freq_region_global},    // 40 MHz
+    {133, 7, 233, 5950, 5, em_freq_region_global},    // 80 MHz
+    {134, 15, 233, 5950, 5, em_freq_region_global},   // 160 MHz
+    {135, 7, 233, 5950, 5, em_freq_region_global},    // 80+80 MHz
+    {136, 2, 2, 5935, 1, em_freq_region_global},      // Special case channel 2
+
+    // 60 GHz band
+    {180, 1, 8, 56160, 2160, em_freq_region_global},    // channels 1-8
+    {181, 9, 15, 56160, 2160, em_freq_region_global},   // EDMG CB2
+    {182, 17, 22, 56160, 2160, em_freq_region_global},  // EDMG CB3
+    {183, 25, 29, 56160, 2160, em_freq_region_global},  // EDMG CB4
+
+    // US region specific
+    {12, 1, 11, 2407, 5, em_freq_region_us},      // 2.4 GHz channels 1-11
+    {32, 1, 7, 2407, 5, em_freq_region_us},       // 2.4 GHz 40MHz channels 1-7
+    {33, 5, 11, 2407, 5, em_freq_region_us},      // 2.4 GHz 40MHz channels 5-11
+    {1, 36, 48, 5000, 5, em_freq_region_us},      // 5 GHz channels 36-48
+    {2, 52, 64, 5000, 5, em_freq_region_us},      // 5 GHz channels 52-64
+    {4, 100, 144, 5000, 5, em_freq_region_us},    // 5 GHz channels 100-144
+    {5, 149, 165, 5000, 5, em_freq_region_us},    // 5 GHz channels 149-165
+    {34, 1, 8, 56160, 2160, em_freq_region_us},   // 60 GHz channels 1-8
+    {37, 9, 15, 56160, 2160, em_freq_region_us},  // 60 GHz EDMG CB2
+    {38, 17, 22, 56160, 2160, em_freq_region_us}, // 60 GHz EDMG CB3
+    {39, 25, 29, 56160, 2160, em_freq_region_us}, // 60 GHz EDMG CB4
+
+    // EU region specific
+    {4, 1, 13, 2407, 5, em_freq_region_eu},       // 2.4 GHz channels 1-13
+    {11, 1, 9, 2407, 5, em_freq_region_eu},       // 2.4 GHz 40MHz channels 1-9
+    {12, 5, 13, 2407, 5, em_freq_region_eu},      // 2.4 GHz 40MHz channels 5-13
+    {1, 36, 48, 5000, 5, em_freq_region_eu},      // 5 GHz channels 36-48
+    {2, 52, 64, 5000, 5, em_freq_region_eu},      // 5 GHz channels 52-64
+    {3, 100, 140, 5000, 5, em_freq_region_eu},    // 5 GHz channels 100-140
+    {17, 149, 169, 5000, 5, em_freq_region_eu},   // 5 GHz channels 149-169
+    {18, 1, 6, 56160, 2160, em_freq_region_eu},   // 60 GHz channels 1-6
+    {21, 9, 11, 56160, 2160, em_freq_region_eu},  // 60 GHz EDMG CB2
+    {22, 17, 18, 56160, 2160, em_freq_region_eu}, // 60 GHz EDMG CB3
+    {23, 25, 25, 56160, 2160, em_freq_region_eu}, // 60 GHz EDMG CB4
+
+    // JP region specific
+    {30, 1, 13, 2407, 5, em_freq_region_jp},      // 2.4 GHz channels 1-13
+    {31, 14, 14, 2414, 5, em_freq_region_jp},     // 2.4 GHz channel 14
+    {1, 34, 64, 5000, 5, em_freq_region_jp},      // 5 GHz channels 34-64
+    {32, 52, 64, 5000, 5, em_freq_region_jp},     // 5 GHz channels 52-64
+    {34, 100, 140, 5000, 5, em_freq_region_jp},   // 5 GHz channels 100-140
+    {59, 1, 6, 56160, 2160, em_freq_region_jp},   // 60 GHz channels 1-6
+    {62, 9, 11, 56160, 2160, em_freq_region_jp},  // 60 GHz EDMG CB2
+    {63, 17, 18, 56160, 2160, em_freq_region_jp}, // 60 GHz EDMG CB3
+    {64, 25, 25, 56160, 2160, em_freq_region_jp}, // 60 GHz EDMG CB4
+
+    // CN region specific
+    {7, 1, 13, 2407, 5, em_freq_region_cn},       // 2.4 GHz channels 1-13
+    {8, 1, 9, 2407, 5, em_freq_region_cn},        // 2.4 GHz 40MHz channels 1-9
+    {9, 5, 13, 2407, 5, em_freq_region_cn},       // 2.4 GHz 40MHz channels 5-13
+    {1, 36, 48, 5000, 5, em_freq_region_cn},      // 5 GHz channels 36-48
+    {2, 52, 64, 5000, 5, em_freq_region_cn},      // 5 GHz channels 52-64
+    {3, 149, 165, 5000, 5, em_freq_region_cn},    // 5 GHz channels 149-165
+    {6, 149, 157, 5000, 5, em_freq_region_cn}     // 5 GHz 40MHz channels 149,157
+};
+
+inline constexpr size_t em_freq_ranges_count = sizeof(em_freq_ranges) / sizeof(em_freq_ranges[0]);
+
+namespace em_freq_table {
+
+/**
+ * @brief Reference lookup: scan of em_freq_ranges, first range of the operating class in the region
+ * (or global) holding the channel. Used to build the lookup tables at compile time and to test them.
+ *
+ * @return Frequency in MHz, -1 if unknown
+ */
+constexpr int scan_chan_to_freq(uint8_t op_class, uint8_t channel, em_freq_region_t region)
+{
+    for (size_t i = 0; i < em_freq_ranges_count; i++) {
+        const em_freq_range_t& range = em_freq_ranges[i];
+        if ((range.region == em_freq_region_global || range.region == region) &&
+            range.op_class == op_class &&
+            channel >= range.min_chan &&
+            channel <= range.max_chan) {
+            return range.base_freq + (channel * range.spacing);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Reference lookup: scan of em_freq_ranges for a frequency. The first range of the region wins;
+ * otherwise the last matching global range, as util::em_freq_to_chan() always did.
+ *
+ * @return {operating class, channel}, {0, 0} if unknown
+ */
+constexpr std::pair<uint8_t, uint8_t> scan_freq_to_chan(unsigned int frequency, em_freq_region_t region)
+{
+    uint8_t global_op_class = 0, global_channel = 0;
+
+    for (size_t i = 0; i < em_freq_ranges_count; i++) {
+        const em_freq_range_t& range = em_freq_ranges[i];
+        unsigned int min_freq = static_cast<unsigned int>(range.base_freq + (range.min_chan * range.spacing));
+        unsigned int max_freq = static_cast<unsigned int>(range.base_freq + (range.max_chan * range.spacing));
+
+        if (frequency < min_freq || frequency > max_freq) continue;
+        if ((frequency - range.base_freq) % range.spacing != 0) continue;
+
+        unsigned int channel_calc = (frequency - range.base_freq) / range.spacing;
+        if (channel_calc < range.min_chan || channel_calc > range.max_chan) continue;
+
+        if (range.region == region) return {range.op_class, static_cast<uint8_t>(channel_calc)};
+        if (range.region == em_freq_region_global) {
+            global_op_class = range.op_class;
+            global_channel = static_cast<uint8_t>(channel_calc);
+        }
+    }
+    return {global_op_class, global_channel};
+}
+
+} // namespace em_freq_table
+
+#endif // EM_FREQ_TABLE_H
@@ -21,6 +21,8 @@
 
 #include "em_base.h"
 #include "dm_easy_mesh.h"
+#include "em_metrics_store.h"
+#include "em_steer_engine.h"
 
 class em_metrics_t {
 
@@ -95,6 +97,20 @@ class em_metrics_t {
 	 * @note This is a pure virtual function and must be implemented by derived classes.
 	 */
 	virtual em_cmd_t *get_current_cmd() = 0;
+
+	/**!
+	 * @brief Retrieves the metrics time series store of the service, if it keeps one.
+	 *
+	 * @returns The store, or NULL when reports should only update the data model.
+	 */
+	virtual em_metrics_store_t *get_metrics_store() = 0;
+
+	/**!
+	 * @brief Retrieves the client steering engine of the service, if it runs one.
+	 *
+	 * @returns The engine, or NULL when reports should only update the data model.
+	 */
+	virtual em_steer_engine_t *get_steer_engine() = 0;
     
 	/**!
 	 * @brief Sends link metrics message to all associated stations.
@@ -525,6 +541,15 @@ class em_metrics_t {
 
 public:
     
+	/**!
+	 * @brief Sends an Associated STA Link Metrics Query for one STA, used by the controller poll scheduler.
+	 *
+	 * @param[in] sta_mac MAC address of the associated STA.
+	 *
+	 * @returns Length of the frame sent, -1 on failure.
+	 */
+	int send_sta_link_metrics_query(mac_address_t sta_mac) { return send_associated_sta_link_metrics_msg(sta_mac); }
+    
 	/**!
 	 * @brief Processes a message.
 	 *
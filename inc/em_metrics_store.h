@@ -0,0 +1,189 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_METRICS_STORE_H
+#define EM_METRICS_STORE_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <cjson/cJSON.h>
+#include "em_base.h"
+
+#define EM_METRICS_RAW_BYTES		256	// compressed raw samples kept per series
+#define EM_METRICS_RESERVOIR		32	// samples kept per open bucket for the p95
+#define EM_METRICS_MAX_LEVELS		4
+#define EM_METRICS_SERIES_MAX_IDLE	3600	// seconds without a sample before a series is dropped
+#define EM_METRICS_MAX_SERIES		16384
+
+typedef enum {
+	em_metrics_id_sta_rcpi,
+	em_metrics_id_sta_dl_rate,
+	em_metrics_id_sta_ul_rate,
+	em_metrics_id_sta_tx_bytes,	// delta since the previous report
+	em_metrics_id_sta_rx_bytes,
+	em_metrics_id_bss_num_sta,
+	em_metrics_id_bss_util,
+	em_metrics_id_radio_noise,
+	em_metrics_id_radio_util,
+
+	em_metrics_id_max
+} em_metrics_id_t;
+
+typedef struct {
+	unsigned int	resolution;	// seconds
+	unsigned int	num_buckets;	// closed buckets kept in memory
+	bool	persist;		// hand closed buckets to the persist callback
+} em_metrics_level_cfg_t;
+
+typedef struct {
+	unsigned int	start;		// seconds since the epoch, aligned to the resolution
+	unsigned int	count;
+	long long	min;
+	long long	max;
+	long long	sum;
+	long long	p95;
+} em_metrics_bucket_t;
+
+typedef struct {
+	unsigned int	num_series;
+	unsigned long long	num_samples;	// raw samples currently held
+	unsigned long long	raw_bytes;	// bytes used by the encoded samples
+	unsigned long long	total_samples;	// samples recorded since start
+	unsigned long long	persisted;	// buckets handed to the persist callback
+	unsigned long long	dropped;	// samples refused because the store was full
+} em_metrics_store_stats_t;
+
+using em_metrics_persist_func = std::function<void(const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, const em_metrics_bucket_t *bucket)>;
+
+/**
+ * @brief In-memory time series of STA, BSS and radio metrics with rollups.
+ *
+ * Each series (entity MAC, metric) keeps its most recent raw samples in a fixed size byte ring,
+ * every sample stored as the zigzag varint delta of its timestamp and value from the previous
+ * one, so a typical sample costs 2 to 4 bytes. The oldest sample is kept in absolute form and
+ * moved forward when the ring evicts. Samples are also folded into one open bucket per rollup
+ * level; when a bucket closes its min/max/avg/p95 is kept in a ring of closed buckets and, for
+ * levels marked persist, handed to the persist callback. The p95 comes from a reservoir sample
+ * of the bucket, exact up to EM_METRICS_RESERVOIR samples.
+ *
+ * The store is not locked, it is owned by the manager thread.
+ */
+class em_metrics_store_t {
+	typedef struct {
+		unsigned int	start = 0;
+		unsigned int	count = 0;
+		long long	min = 0;
+		long long	max = 0;
+		long long	sum = 0;
+		long long	reservoir[EM_METRICS_RESERVOIR] = {};
+	} open_bucket_t;
+
+	typedef struct {
+		open_bucket_t	open = {};
+		std::vector<em_metrics_bucket_t>	closed = {};
+		unsigned int	head = 0;	// next slot to overwrite in closed
+		unsigned int	num = 0;
+	} level_t;
+
+	typedef struct {
+		mac_address_t	mac = {};
+		em_metrics_id_t	id = em_metrics_id_max;
+		unsigned char	raw[EM_METRICS_RAW_BYTES] = {};
+		unsigned int	raw_head = 0;	// first byte of the oldest delta
+		unsigned int	raw_len = 0;
+		unsigned int	num_samples = 0;
+		long long	base_ts = 0;	// oldest sample, ms
+		long long	base_val = 0;
+		long long	last_ts = 0;	// newest sample, ms
+		long long	last_val = 0;
+		level_t	levels[EM_METRICS_MAX_LEVELS] = {};
+	} series_t;
+
+	std::unordered_map<unsigned long long, series_t *>	m_series;
+	em_metrics_level_cfg_t	m_levels[EM_METRICS_MAX_LEVELS];
+	unsigned int	m_num_levels;
+	em_metrics_persist_func	m_persist;
+	unsigned int	m_rand;
+	em_metrics_store_stats_t	m_stats;
+
+	static unsigned long long series_key(const unsigned char *mac, em_metrics_id_t id);
+	static unsigned int encode_varint(unsigned char *buff, unsigned long long val);
+	unsigned int decode_varint(const series_t *series, unsigned int pos, unsigned long long *val);
+	void evict_oldest(series_t *series);
+	void append_raw(series_t *series, long long ts, long long val);
+	void add_to_bucket(series_t *series, unsigned int level, unsigned int sec, long long val);
+	void close_bucket(series_t *series, unsigned int level);
+	static long long percentile_95(const open_bucket_t *open);
+	static void to_bucket(const open_bucket_t *open, em_metrics_bucket_t *bucket);
+
+public:
+
+	/**!
+	 * @brief Adds a sample to the series of @p mac and @p id, creating the series if needed.
+	 *
+	 * @param[in] ts_ms Sample time in ms since the epoch, 0 for now.
+	 *
+	 * @returns 0 on success, -1 if the store is full.
+	 */
+	int record(const unsigned char *mac, em_metrics_id_t id, long long val, long long ts_ms = 0);
+
+	/**!
+	 * @brief Closes buckets whose period has ended and drops series idle for EM_METRICS_SERIES_MAX_IDLE.
+	 *
+	 * Call periodically so that rollups of entities that stopped reporting are still persisted.
+	 */
+	void flush(long long now_ms = 0);
+
+	/**!
+	 * @brief Drops every series of an entity, e.g. when a STA leaves.
+	 */
+	void remove(const unsigned char *mac);
+
+	/**!
+	 * @brief Copies the buckets of one rollup level, oldest first, the open bucket last.
+	 *
+	 * @returns Number of buckets copied, -1 if the series or the resolution is unknown.
+	 */
+	int get_rollups(const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, em_metrics_bucket_t *buckets, unsigned int max);
+
+	/**!
+	 * @brief Decodes the raw samples of a series, oldest first.
+	 *
+	 * @returns Number of samples copied, -1 if the series is unknown.
+	 */
+	int get_samples(const unsigned char *mac, em_metrics_id_t id, long long *ts_ms, long long *vals, unsigned int max);
+
+	/**!
+	 * @brief Encodes the rollups of every metric of @p mac at @p resolution, or a store summary if @p mac is NULL.
+	 */
+	void encode(cJSON *parent, const unsigned char *mac, unsigned int resolution);
+
+	const em_metrics_store_stats_t *get_stats() { return &m_stats; }
+
+	static const char *get_metric_str(em_metrics_id_t id);
+
+	static long long now_ms();
+
+	em_metrics_store_t(em_metrics_persist_func persist, const em_metrics_level_cfg_t *levels = NULL, unsigned int num_levels = 0);
+	em_metrics_store_t(const em_metrics_store_t&) = delete;
+	em_metrics_store_t& operator = (const em_metrics_store_t&) = delete;
+	~em_metrics_store_t();
+};
+
+#endif
@@ -21,6 +21,8 @@
 
 #include "em.h"
 #include "em_orch.h"
+#include "em_fanout.h"
+#include "em_timer.h"
 #include "ieee80211.h"
 
 class em_mgr_t {
@@ -29,12 +31,14 @@ class em_mgr_t {
     bool m_exit;
     em_queue_t  m_queue;
 	unsigned int m_tick_demultiplex;
+	em_timer_wheel_t	m_timers;
 
 public:
 	pthread_mutex_t m_mutex;
     hash_map_t      *m_em_map;
     unsigned int m_timeout;
     fd_set  m_rset;
+	bool	m_sap_down;	// the AL SAP peer went away, its descriptor stays out of the select set until reconnected
     
     
 	/**!
@@ -105,6 +109,27 @@ public:
 	 */
 	em_event_t *pop_from_queue();
 
+	/**!
+	 * @brief Arms a timer serviced by the manager thread between event batches.
+	 *
+	 * Timers fire on time regardless of how busy the event queue is. The callback runs on the
+	 * manager thread, the same thread that dispatches events to em_t and em_orch_t.
+	 *
+	 * @param[in] ms Delay in milliseconds, rounded up to EM_TIMER_TICK_MS.
+	 * @param[in] periodic Re-arm the timer every @p ms.
+	 * @param[in] cb Callback.
+	 *
+	 * @returns Timer id for cancel_timer().
+	 */
+	unsigned int add_timer(unsigned int ms, bool periodic, em_timer_cb_t cb);
+
+	/**!
+	 * @brief Cancels a timer armed with add_timer().
+	 *
+	 * @returns 0 on success, -1 if the timer already expired or does not exist.
+	 */
+	int cancel_timer(unsigned int id) { return m_timers.cancel(id); }
+
     
 	/**!
 	 * @brief Listens to the nodes for incoming data or signals.
@@ -372,6 +397,55 @@ public:
         return true;
     }
 
+	/**
+	 * @brief Metrics time series store fed by the metrics handlers. Optional to implement.
+	 *
+	 * @return The store, or NULL if the service keeps no metrics history.
+	 */
+	virtual em_metrics_store_t *get_metrics_store() { return NULL; }
+
+	/**
+	 * @brief Channel planner fed by the channel scan reports. Optional to implement.
+	 *
+	 * @return The planner, or NULL if the service does not plan channels.
+	 */
+	virtual em_channel_planner_t *get_channel_planner() { return NULL; }
+
+	/**
+	 * @brief Client steering engine fed by the metrics and steering reports. Optional to implement.
+	 *
+	 * @return The engine, or NULL if the service does not steer clients.
+	 */
+	virtual em_steer_engine_t *get_steer_engine() { return NULL; }
+
+	/**
+	 * @brief Client capability cache fed by the Client Capability Reports. Optional to implement.
+	 *
+	 * @return The cache, or NULL if the service does not query client capabilities.
+	 */
+	virtual em_client_cap_cache_t *get_client_cap_cache() { return NULL; }
+
+	/**
+	 * @brief Record of the policy TLVs acknowledged by every agent. Optional to implement.
+	 *
+	 * @return The record, or NULL if every policy request carries the complete policy.
+	 */
+	virtual em_policy_sync_t *get_policy_sync() { return NULL; }
+
+	/**
+	 * @brief Per neighbour scheduler of the topology probes. Optional to implement.
+	 *
+	 * @return The scheduler, or NULL if topology responses are not tracked.
+	 */
+	virtual em_disc_sched_t *get_disc_sched() { return NULL; }
+
+	/**
+	 * @brief Window of the controller-wide commands fanned out to every agent. Optional to implement.
+	 *
+	 * @return The fan-out, or NULL if commands are not fanned out.
+	 */
+	virtual em_fanout_t *get_fanout() { return NULL; }
+
     
 	/**!
 	 * @brief Finds the EM for a given message type.
@@ -21,8 +21,20 @@
 
 #include "em_base.h"
 
+typedef struct {
+    char    *buff;
+    size_t  len;
+    size_t  size;
+} em_net_node_render_t;
+
 class em_net_node_t {
 
+	static void render_append(em_net_node_render_t *out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+	static void render_network_tree_node(em_net_node_render_t *out, em_network_node_t *node, unsigned int ident);
+	static unsigned int count_network_tree_nodes(em_network_node_t *node);
+	static unsigned int merge_network_tree_node(em_network_node_t *prev, em_network_node_t *next);
+	static void renumber_network_tree(em_network_node_t *node, unsigned int *node_display_ctr);
+
 public:
     
 	/**!
@@ -67,6 +79,22 @@ public:
 	 * before calling this function.
 	 */
 	static em_network_node_t *clone_network_tree(em_network_node_t *node);
+
+	/**!
+	 * @brief Merges a freshly fetched network tree into the current one.
+	 *
+	 * Nodes are matched by their path, the key under objects and the position under arrays. Matched
+	 * nodes are updated in place so that unchanged subtrees keep their memory, unmatched subtrees of
+	 * @p next are moved into @p prev and the nodes missing from @p next are freed. Every node that
+	 * changed, or has a changed descendant, is flagged in display_info.modified and the display
+	 * counters are renumbered when anything changed.
+	 *
+	 * @param[in,out] prev Current tree.
+	 * @param[in] next New tree, still to be freed by the caller with free_network_tree().
+	 *
+	 * @returns Number of nodes added, removed, moved or changed, 0 when the trees are identical.
+	 */
+	static unsigned int merge_network_tree(em_network_node_t *prev, em_network_node_t *next);
     
 	/**!
 	 * @brief Clones a network tree for display purposes.
@@ -282,7 +310,8 @@ public:
 	/**!
 	 * @brief Retrieves the network tree as a string.
 	 *
-	 * This function takes a network node tree and converts it into a string representation.
+	 * This function takes a network node tree and converts it into a string representation,
+	 * rendered in a single pass into a buffer that grows as needed.
 	 *
 	 * @param[in] tree Pointer to the network node tree to be converted.
 	 *
@@ -316,7 +345,8 @@ public:
 	 * @param[in] node Pointer to the network node structure containing the node data.
 	 * @param[in] pident Pointer to an unsigned integer representing the node identifier.
 	 *
-	 * @note Ensure that the `str` buffer is large enough to hold the resulting string.
+	 * @note Ensure that the `str` buffer is large enough to hold the resulting string, which is
+	 * appended to its current contents.
 	 */
 	static void get_network_tree_node_string(char *str, em_network_node_t *node, unsigned int *pident);
 
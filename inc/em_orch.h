@@ -54,6 +54,7 @@ public:
 	 */
 	void handle_timeout();
 
+
     
 	/**!
 	 * @brief Submits a list of commands for execution.
@@ -166,6 +167,13 @@ public:
 	 * @note This is a pure virtual function and must be implemented by derived classes.
 	 */
 	virtual void orch_transient(em_cmd_t *pcmd, em_t *em) = 0;
+
+	/**!
+	 * @brief Called when a command leaves the active queue, finished or canceled.
+	 *
+	 * @param[in] pcmd Pointer to the command, destroyed right after.
+	 */
+	virtual void orch_fini(em_cmd_t *pcmd) { }
     
 	/**!
 	 * @brief Submits a command for processing.
@@ -260,6 +268,15 @@ public:
 	 */
 	bool is_cmd_type_in_progress(em_bus_event_t *evt);
 
+	/**!
+	 * @brief Checks if a command of a type is pending or active, for commands the manager submits on its own.
+	 *
+	 * @param[in] type Command type.
+	 *
+	 * @returns True if a command of the type is in progress, false otherwise.
+	 */
+	bool is_cmd_type_in_progress(em_cmd_type_t type);
+
 	/**!
 	 * @brief Checks if a command type is currently in progress.
 	 *
@@ -107,6 +107,13 @@ public:
 	 */
 	void orch_transient(em_cmd_t *pcmd, em_t *em);
 
+	/**!
+	 * @brief Reports the outcome of a fan-out command to its job.
+	 *
+	 * @param[in] pcmd Pointer to the command leaving the active queue.
+	 */
+	void orch_fini(em_cmd_t *pcmd);
+
 public:
     
 	/**!
@@ -20,10 +20,15 @@
 #define EM_POLICY_CFG_H
 
 #include "em_base.h"
+#include "em_policy_sync.h"
+
+#define EM_POLICY_CFG_NUM_TLVS	3	// steering, metric reporting and vendor policy
 
 class em_cmd_t;
 class em_policy_cfg_t {
 
+	em_policy_cfg_params_t	m_policy_cfg;	// agent: policy merged from the requests received
+
     
 	/**!
 	 * @brief Sends a frame of data.
@@ -183,16 +188,33 @@ public:
 	/**!
 	 * @brief Sends a policy configuration request message.
 	 *
-	 * This function is responsible for initiating a request to configure policy settings.
+	 * This function is responsible for initiating a request to configure policy settings. On the controller
+	 * the request carries only the policy TLVs the agent has not acknowledged.
 	 *
 	 * @returns int
-	 * @retval 0 on success
+	 * @retval length of the request sent, 0 when the agent is up to date
 	 * @retval -1 on failure
 	 *
 	 * @note Ensure that the system is initialized before calling this function.
 	 */
 	int send_policy_cfg_request_msg();
 
+	/**!
+	 * @brief Acknowledges a Multi-AP Policy Config Request with a 1905 Ack.
+	 *
+	 * @param[in] msg_id CMDU message id of the request, the policy version the controller waits for.
+	 *
+	 * @returns Length of the Ack, -1 on failure.
+	 */
+	int send_policy_cfg_ack_msg(unsigned short msg_id);
+
+	/**!
+	 * @brief Hands a 1905 Ack to the policy sync of the controller.
+	 *
+	 * @returns 1 if the Ack answers a policy request, 0 if it answers another request and is left to its handler.
+	 */
+	int handle_policy_cfg_ack(unsigned char *buff, unsigned int len);
+
     
 	/**!
 	 * @brief Handles the policy configuration request.
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_POLICY_SYNC_H
+#define EM_POLICY_SYNC_H
+
+#include <time.h>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "em_base.h"
+
+#define EM_POLICY_SYNC_ACK_TIMEOUT_S	5	// seconds a request waits for its 1905 Ack before it is retried
+#define EM_POLICY_SYNC_MAX_RETRIES	3	// retries of an unacknowledged TLV before it waits for the next push
+#define EM_POLICY_SYNC_MID_BASE	0x4000	// policy requests take their message ids from 0x4000 to 0x7fff, requests
+#define EM_POLICY_SYNC_MID_SPAN	0x4000	// acknowledged by a 1905 Ack use their message type, below 0x0020 or from 0x8000
+
+typedef struct {
+	unsigned int	num_agents;
+	unsigned int	in_flight;	// TLVs sent and not acknowledged
+	unsigned long long	requests;
+	unsigned long long	sent;		// TLVs sent, retries included
+	unsigned long long	suppressed;	// TLVs left out, acknowledged or in flight with the same content
+	unsigned long long	acked;
+	unsigned long long	retries;
+	unsigned long long	dropped;	// TLVs given up after EM_POLICY_SYNC_MAX_RETRIES
+} em_policy_sync_stats_t;
+
+/**
+ * @brief Controller record of the policy TLVs each agent has acknowledged.
+ *
+ * Every agent radio keeps, per policy TLV type, the hash of the TLV value the agent acknowledged and of
+ * the one in flight. A Multi-AP Policy Config Request carries only the TLVs whose value differs from both.
+ * Its CMDU message id comes from a range no other request uses and is recorded with the TLVs it carried
+ * until the agent echoes it in a 1905 Ack, or for as long as a request may still be retried. Only an Ack
+ * of a recorded message id is claimed, it moves the TLVs sent with it to acknowledged unless their value
+ * changed since. TLVs still unacknowledged after EM_POLICY_SYNC_ACK_TIMEOUT_S are reported overdue and
+ * sent again, up to EM_POLICY_SYNC_MAX_RETRIES times.
+ *
+ * Requests and Acks are handled on the em threads, the overdue checks from the manager thread.
+ */
+class em_policy_sync_t {
+	typedef struct {
+		unsigned long long	acked_hash = 0;
+		unsigned long long	sent_hash = 0;
+		time_t	sent_time = 0;
+		unsigned int	retries = 0;
+		bool	acked = false;
+		bool	in_flight = false;
+	} slot_t;
+
+	typedef struct {
+		time_t	sent_time = 0;
+		std::vector<std::pair<unsigned long long, unsigned long long>>	tlvs = {};	// slot key, hash of the value sent
+	} request_t;
+
+	typedef struct {
+		unsigned short	next_mid = 0;
+		std::unordered_map<unsigned long long, slot_t>	slots = {};	// ruid << 16 | TLV type
+		std::unordered_map<unsigned short, request_t>	requests = {};	// by message id, not acknowledged yet
+	} agent_t;
+
+	std::mutex	m_lock;
+	std::unordered_map<unsigned long long, agent_t>	m_agents;
+	em_policy_sync_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static unsigned long long slot_key(const unsigned char *ruid, unsigned int type);
+	static time_t now_s();
+
+public:
+
+	/**!
+	 * @brief Hashes a TLV value, FNV-1a.
+	 */
+	static unsigned long long hash(const unsigned char *value, unsigned int len);
+
+	/**!
+	 * @brief Tells if a policy TLV must be part of the next request to an agent.
+	 *
+	 * @param[in] agent AL MAC of the agent.
+	 * @param[in] ruid Radio the TLV was built for.
+	 * @param[in] type TLV type.
+	 * @param[in] hash Hash of the TLV value.
+	 *
+	 * @returns false if the agent acknowledged this value, or it is in flight and not yet overdue.
+	 */
+	bool is_stale(const unsigned char *agent, const unsigned char *ruid, unsigned int type, unsigned long long hash);
+
+	/**!
+	 * @brief Allocates the message id of the next request to an agent.
+	 *
+	 * The id is within EM_POLICY_SYNC_MID_BASE and EM_POLICY_SYNC_MID_BASE + EM_POLICY_SYNC_MID_SPAN - 1 and
+	 * not one of a request still waiting for its Ack. Requests too old to be acknowledged are forgotten.
+	 */
+	unsigned short next_mid(const unsigned char *agent);
+
+	/**!
+	 * @brief Records a TLV sent in the request @p mid.
+	 */
+	void set_sent(const unsigned char *agent, const unsigned char *ruid, unsigned int type, unsigned long long hash,
+		unsigned short mid);
+
+	/**!
+	 * @brief Acknowledges the TLVs sent in the request @p mid.
+	 *
+	 * @returns true if @p mid is a policy request to the agent waiting for its Ack, false if the Ack answers another request.
+	 */
+	bool ack(const unsigned char *agent, unsigned short mid);
+
+	/**!
+	 * @brief Forgets what a radio acknowledged, its next request carries every policy TLV.
+	 */
+	void forget(const unsigned char *agent, const unsigned char *ruid);
+
+	/**!
+	 * @brief Tells if a radio has TLVs to retry, TLVs out of retries are dropped.
+	 */
+	bool is_overdue(const unsigned char *agent, const unsigned char *ruid);
+
+	const em_policy_sync_stats_t *get_stats();
+
+	em_policy_sync_t();
+	~em_policy_sync_t();
+};
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_SIM_LOAD_H
+#define EM_SIM_LOAD_H
+
+#include <time.h>
+#include <map>
+#include <vector>
+#include "em_base.h"
+#include "em_simulator.h"
+
+#define EM_SIM_MAX_RADIOS           EM_MAX_BANDS
+#define EM_SIM_MAX_BSS_PER_RADIO    4
+#define EM_SIM_LATENCY_BUCKETS      32
+#define EM_SIM_TICK_MS              10
+#define EM_SIM_FRAME_SZ             1500
+#define EM_SIM_PENDING_TOUT_MS      5000
+
+typedef enum {
+	em_sim_churn_assoc,
+	em_sim_churn_roam,
+	em_sim_churn_metrics,
+	em_sim_churn_scan,
+	em_sim_churn_backhaul,
+
+	em_sim_churn_max
+} em_sim_churn_type_t;
+
+typedef enum {
+	em_sim_lat_autoconf,	// autoconfig search -> autoconfig response
+	em_sim_lat_wsc,		// WSC M1 -> WSC M2
+	em_sim_lat_topo,	// last M2 -> first topology query
+	em_sim_lat_ack,		// report -> 1905 ack, when the controller acks
+
+	em_sim_lat_max
+} em_sim_lat_type_t;
+
+typedef enum {
+	em_sim_agent_state_idle,
+	em_sim_agent_state_search_sent,
+	em_sim_agent_state_m1_sent,
+	em_sim_agent_state_onboarded,
+} em_sim_agent_state_t;
+
+typedef struct {
+	em_interface_name_t	ifname;
+	mac_address_t	ctrl_al_mac;
+	bool	ctrl_al_mac_known;
+	unsigned int	num_agents;
+	unsigned int	radios_per_agent;
+	unsigned int	bss_per_radio;
+	unsigned int	sta_per_agent;
+	unsigned int	duration;		// seconds of churn after the ramp
+	unsigned int	ramp_rate;		// agents started per second
+	unsigned int	rate[em_sim_churn_max];	// events per second across the whole mesh
+	int	ctrl_pid;			// sampled for memory growth when > 0
+	unsigned int	seed;
+	char	json_path[128];
+} em_sim_load_params_t;
+
+typedef struct {
+	unsigned long long	count;
+	unsigned long long	sum_us;
+	unsigned long long	max_us;
+	unsigned long long	timeouts;
+	unsigned long long	bucket[EM_SIM_LATENCY_BUCKETS];	// bucket i counts latencies below 2^i us
+} em_sim_latency_t;
+
+typedef struct {
+	unsigned long long	tx_cmdu;
+	unsigned long long	rx_cmdu;
+	unsigned long long	tx_bytes;
+	unsigned long long	rx_bytes;
+	unsigned long long	tx_errors;
+	unsigned long long	rx_unhandled;
+	unsigned long long	churn[em_sim_churn_max];
+	unsigned int	agents_onboarded;
+
+	em_sim_latency_t	lat[em_sim_lat_max];
+
+	unsigned long	ctrl_rss_start_kb;
+	unsigned long	ctrl_rss_peak_kb;
+	unsigned long	ctrl_rss_end_kb;
+	unsigned long	self_rss_kb;
+	double	elapsed_sec;
+} em_sim_load_stats_t;
+
+typedef struct {
+	mac_address_t	mac;
+	unsigned int	bss;
+	bool	associated;
+} em_sim_sta_t;
+
+typedef struct {
+	struct timespec	sent;
+	em_sim_lat_type_t	kind;
+} em_sim_pending_t;
+
+typedef struct {
+	mac_address_t	ruid;
+	em_freq_band_t	band;
+	unsigned char	op_class;
+	unsigned char	channel;
+} em_sim_radio_t;
+
+typedef struct {
+	bssid_t	bssid;
+	unsigned int	radio;
+} em_sim_bss_t;
+
+/**
+ * @brief One simulated agent. Holds just enough state to build the CMDUs an agent emits.
+ */
+class em_sim_agent_t {
+public:
+	unsigned int	m_index;
+	mac_address_t	m_al_mac;
+	em_sim_agent_state_t	m_state;
+	unsigned short	m_msg_id;
+	unsigned int	m_num_radios;
+	em_sim_radio_t	m_radio[EM_SIM_MAX_RADIOS];
+	unsigned int	m_num_bss;
+	em_sim_bss_t	m_bss[EM_SIM_MAX_RADIOS * EM_SIM_MAX_BSS_PER_RADIO];
+	std::vector<em_sim_sta_t>	m_sta;
+	unsigned int	m_num_m2;
+	mac_address_t	m_nbr_mac_base;
+
+	// expected controller message type -> when and why it is expected
+	std::map<unsigned short, em_sim_pending_t>	m_pending;
+
+	/**!
+	 * @brief Builds the 1905 header, assigning the next message id of this agent.
+	 *
+	 * @param[out] buff Frame buffer.
+	 * @param[in,out] len Running frame length.
+	 * @param[in] dst Destination MAC.
+	 * @param[in] type CMDU type.
+	 * @param[in] relay Relay indicator, set for multicast search messages.
+	 *
+	 * @returns Pointer past the CMDU header.
+	 */
+	unsigned char *add_header(unsigned char *buff, unsigned int *len, mac_address_t dst, em_msg_type_t type, bool relay = false);
+
+	/**!
+	 * @brief AP-Autoconfiguration Search for one radio band.
+	 */
+	unsigned int create_autoconfig_search(unsigned char *buff, unsigned int radio);
+
+	/**!
+	 * @brief AP-Autoconfiguration WSC carrying M1 for one radio.
+	 *
+	 * The public key attribute is filled with random octets, the load generator never
+	 * decrypts M2 so no DH exchange is needed on this side.
+	 */
+	unsigned int create_autoconfig_wsc_m1(unsigned char *buff, mac_address_t dst, unsigned int radio);
+
+	/**!
+	 * @brief Topology Response for one radio, the controller routes it by the first radio id.
+	 */
+	unsigned int create_topo_resp(unsigned char *buff, mac_address_t dst, unsigned int radio);
+
+	/**!
+	 * @brief Topology Notification, with a Client Association Event TLV when @p sta is set.
+	 */
+	unsigned int create_topo_notif(unsigned char *buff, mac_address_t dst, const em_sim_sta_t *sta, bool assoc);
+
+	/**!
+	 * @brief AP Metrics Response with one AP Metrics TLV per BSS and link metrics per associated STA.
+	 */
+	unsigned int create_ap_metrics_rsp(unsigned char *buff, unsigned int max_len, mac_address_t dst);
+
+	/**!
+	 * @brief Channel Scan Report for one radio, neighbours fabricated by em_simulator_t.
+	 */
+	unsigned int create_channel_scan_rprt(unsigned char *buff, mac_address_t dst, unsigned int radio);
+
+	/**!
+	 * @brief Backhaul Steering Response reporting a move to a new parent BSS.
+	 */
+	unsigned int create_bh_steering_rsp(unsigned char *buff, mac_address_t dst, bssid_t parent);
+
+	/**!
+	 * @brief 1905 Ack for controller messages that do not need a richer answer.
+	 */
+	unsigned int create_1905_ack(unsigned char *buff, mac_address_t dst, unsigned short msg_id);
+
+	/**!
+	 * @brief Number of currently associated STAs.
+	 */
+	unsigned int num_associated();
+
+	em_sim_agent_t(unsigned int index, const em_sim_load_params_t& params);
+	~em_sim_agent_t();
+};
+
+/**
+ * @brief Headless load generator driving an em_ctrl_t with many simulated agents.
+ *
+ * All agents share one raw 1905 socket on a veth peer or loopback interface that the
+ * controller also listens on. Agents onboard at the configured ramp rate, answer the
+ * controller queries and then generate scripted churn. Throughput, end to end latency of
+ * request/response pairs and controller memory growth are reported at the end.
+ */
+class em_sim_load_t {
+	em_sim_load_params_t	m_params;
+	em_sim_load_stats_t	m_stats;
+	std::vector<em_sim_agent_t *>	m_agents;
+	std::map<unsigned long long, em_sim_agent_t *>	m_agent_map;
+	int	m_fd;
+	int	m_ifindex;
+	unsigned int	m_rand;
+	unsigned int	m_started;
+	double	m_credit[em_sim_churn_max];
+	double	m_ramp_credit;
+	bool	m_exit;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static long long elapsed_us(const struct timespec *from, const struct timespec *to);
+	static unsigned long read_rss_kb(int pid);
+
+	unsigned int next_rand();
+	int open_socket();
+	int send(em_sim_agent_t *agent, unsigned char *buff, unsigned int len);
+	void expect_reply(em_sim_agent_t *agent, em_msg_type_t type, em_sim_lat_type_t kind);
+	void record_latency(em_sim_lat_type_t kind, long long us);
+	void receive();
+	void handle_frame(unsigned char *buff, unsigned int len);
+	void start_agent(em_sim_agent_t *agent);
+	void agent_onboarded(em_sim_agent_t *agent);
+	em_sim_agent_t *pick_agent();
+	void churn(em_sim_churn_type_t type);
+	void tick(double dt);
+	void expire_pending(const struct timespec *now);
+	void write_json();
+
+public:
+
+	/**!
+	 * @brief Creates the simulated agents and opens the transport.
+	 *
+	 * @param[in] params Load shape and churn rates.
+	 *
+	 * @returns 0 on success, -1 if the interface could not be opened.
+	 */
+	int init(const em_sim_load_params_t *params);
+
+	/**!
+	 * @brief Runs the ramp and churn phases, returns after the configured duration.
+	 */
+	int run();
+
+	/**!
+	 * @brief Stops run() from the signal handler.
+	 */
+	void stop() { m_exit = true; }
+
+	/**!
+	 * @brief Prints the summary and writes the JSON report if a path was given.
+	 */
+	void report();
+
+	/**!
+	 * @brief Returns the collected statistics.
+	 */
+	em_sim_load_stats_t *get_stats() { return &m_stats; }
+
+	em_sim_load_t();
+	~em_sim_load_t();
+};
+
+#endif
@@ -67,6 +67,18 @@ public:
 	 */
 	void configure(dm_easy_mesh_agent_t& dm, em_scan_params_t *params);
 
+	/**!
+	 * @brief Fills the measurement part of a scan result with fabricated neighbours.
+	 *
+	 * Shared by run() and the load generator (em_sim_load_t) so that both report the
+	 * same kind of neighbourhood. The result id is left untouched.
+	 *
+	 * @param[out] res Scan result to fill.
+	 * @param[in] num_neighbors Number of neighbours to fabricate, capped to EM_MAX_NEIGHBORS.
+	 * @param[in,out] nbr_mac_base Base BSSID of the neighbours, the last octet is advanced per neighbour.
+	 */
+	static void fabricate(em_scan_result_t *res, unsigned short num_neighbors, mac_address_t nbr_mac_base);
+
 public:
     
 	/**!
@@ -19,39 +19,80 @@
 #ifndef EM_SM_H
 #define EM_SM_H
 
+#include <pthread.h>
 #include "em_base.h"
 
+#define EM_SM_MAX_STATES	32	// states per service type, indexed by the low byte of em_state_t
+#define EM_SM_STATE_INDEX(s)	(static_cast<unsigned int> (s) & 0xff)
+#define EM_SM_BIT(s)	(1ULL << EM_SM_STATE_INDEX(s))
+#define EM_SM_NUM_DWELL_BUCKETS	6	// <100ms, <1s, <10s, <1m, <10m, longer
+#define EM_SM_REPORT_DEADLINE	(2 * EM_MAX_CMD_EXT_TTL)	// seconds, request/report exchanges
+#define EM_SM_CONFIG_DEADLINE	(4 * EM_MAX_CMD_EXT_TTL)	// seconds, onboarding and channel configuration
+
+typedef enum {
+	em_sm_recovery_none,
+	em_sm_recovery_abandon,			// back to the state the exchange started from, the command waiting on it is canceled
+	em_sm_recovery_restart_autoconfig,	// back to the start of autoconfiguration, agent search or controller renew
+} em_sm_recovery_t;
+
+/**
+ * @brief One row of the transition table of a service type, rows are in em_state_t order.
+ */
+typedef struct {
+	em_state_t	state;
+	unsigned long long	from;		// EM_SM_BIT() of the states the state may be entered from
+	unsigned int	deadline;	// seconds the state may be held, 0 when it is stable
+	em_sm_recovery_t	recovery;
+	em_state_t	recover_to;
+} em_sm_state_desc_t;
+
+typedef struct {
+	unsigned int	entered;
+	unsigned int	timeouts;
+	unsigned int	dwell[EM_SM_NUM_DWELL_BUCKETS];	// completed stays, by duration
+} em_sm_state_stats_t;
+
+typedef struct {
+	unsigned long long	transitions;
+	unsigned long long	rejected;
+	unsigned long long	timeouts;
+	em_sm_state_stats_t	states[EM_SM_MAX_STATES];
+} em_sm_stats_t;
+
 class em_sm_t {
 	
 	em_state_t	m_state;
+	em_service_type_t	m_service;
+	unsigned long long	m_enter_ms;
+	unsigned long long	m_logged[EM_SM_MAX_STATES];	// rejected transitions already logged, per from state
+	em_sm_stats_t	m_stats;
+	pthread_mutex_t	m_lock;		// the em thread and the manager thread, which recovers, both change the state
+
+	int enter(em_state_t state);
+	em_sm_recovery_t find_recovery(unsigned long long now, em_state_t *next);
 
 public:
 	
 	/**!
 	 * @brief Sets the state of the entity.
 	 *
-	 * This function updates the current state of the entity to the specified state.
+	 * This function updates the current state of the entity to the specified state if the transition
+	 * table of the service type allows it, and accounts the time spent in the state left.
 	 *
 	 * @param[in] state The new state to be set for the entity.
 	 *
 	 * @returns int Status code indicating success or failure.
 	 * @retval 0 Success.
-	 * @retval -1 Failure due to invalid state.
-	 *
-	 * @note Ensure the state is valid before calling this function.
+	 * @retval -1 Failure due to an illegal transition.
 	 */
 	int set_state(em_state_t state);
 	
 	/**!
-	 * @brief Validates the state machine.
-	 *
-	 * This function checks if the given state is valid within the state machine.
+	 * @brief Validates a transition from the current state.
 	 *
-	 * @param[in] state The state to be validated.
+	 * @param[in] state The state to be entered.
 	 *
-	 * @returns True if the state is valid, false otherwise.
-	 *
-	 * @note Ensure that the state is defined within the state machine before calling this function.
+	 * @returns True if the transition table allows entering @p state from the current state, false otherwise.
 	 */
 	bool validate_sm(em_state_t state);
 	
@@ -74,6 +115,63 @@ public:
 	 * @note Ensure that the service type is valid and supported before calling this function.
 	 */
 	void init_sm(em_service_type_t service);
+
+	/**!
+	 * @brief Checks the deadline of the current state.
+	 *
+	 * @param[in] now Current time, from now_ms().
+	 * @param[out] next State to recover to when the deadline has passed.
+	 *
+	 * @returns The recovery to run, em_sm_recovery_none while the deadline has not passed or the state has none.
+	 *
+	 * @note The caller recovers by setting @p next, until then the deadline keeps firing.
+	 */
+	em_sm_recovery_t check_deadline(unsigned long long now, em_state_t *next);
+
+	/**!
+	 * @brief Enters the recovery state of the current state if its deadline has passed.
+	 *
+	 * The deadline is checked and the recovery state entered at once, so a transition made meanwhile by
+	 * another thread restarts the deadline instead of being overwritten.
+	 *
+	 * @param[in] now Current time, from now_ms().
+	 * @param[out] from State that timed out.
+	 * @param[out] next State entered.
+	 *
+	 * @returns The recovery that ran, em_sm_recovery_none if the deadline has not passed.
+	 */
+	em_sm_recovery_t recover(unsigned long long now, em_state_t *from, em_state_t *next);
+
+	/**!
+	 * @brief Retrieves a copy of the transition counts, timeouts and dwell time histograms of the node.
+	 */
+	em_sm_stats_t get_stats();
+
+	/**!
+	 * @brief Checks a transition against the transition table.
+	 *
+	 * Staying in the same state is always legal, changing the service type never is.
+	 *
+	 * @param[in] from Current state.
+	 * @param[in] to State to be entered.
+	 *
+	 * @returns True if the transition is legal, false otherwise.
+	 */
+	static bool is_legal_transition(em_state_t from, em_state_t to);
+
+	/**!
+	 * @brief Retrieves a row of the transition table.
+	 *
+	 * @param[in] service Agent or controller.
+	 * @param[in] index Row, EM_SM_STATE_INDEX() of its state.
+	 *
+	 * @returns The row, or NULL past the last state of the service type.
+	 */
+	static const em_sm_state_desc_t *get_state_desc(em_service_type_t service, unsigned int index);
+
+	static const char *get_recovery_str(em_sm_recovery_t recovery);
+
+	static unsigned long long now_ms();
 	
     
 	/**!
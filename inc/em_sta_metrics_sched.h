@@ -0,0 +1,147 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_STA_METRICS_SCHED_H
+#define EM_STA_METRICS_SCHED_H
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "em_base.h"
+
+#define EM_STA_METRICS_TICK_MS		100	// scheduler pass period
+#define EM_STA_METRICS_MIN_INTERVAL_MS	2000	// STAs that move or carry traffic
+#define EM_STA_METRICS_DEF_INTERVAL_MS	10000
+#define EM_STA_METRICS_MAX_INTERVAL_MS	60000	// idle STAs with a stable link
+#define EM_STA_METRICS_JITTER_PCT	10
+#define EM_STA_METRICS_MAX_QPS		50	// queries per second across the network
+#define EM_STA_METRICS_BURST		10
+#define EM_STA_METRICS_BATCH		8	// STAs of one radio queried in one pass
+#define EM_STA_METRICS_RCPI_DELTA	10	// 5 dB, treated as movement
+#define EM_STA_METRICS_ACTIVE_BYTES	(64 * 1024)
+#define EM_STA_METRICS_RATE_WINDOW_MS	10000
+
+typedef struct {
+	mac_address_t	sta;
+	mac_address_t	bssid;
+	mac_address_t	ruid;
+	unsigned char	rcpi;
+	unsigned int	bytes;		// bytes_tx + bytes_rx, compared across polls
+	unsigned int	util;		// util_tx + util_rx
+} em_sta_metrics_sample_t;
+
+typedef struct {
+	unsigned int	num_stas;
+	unsigned int	num_covered;	// polled within twice their own interval
+	double	coverage;		// num_covered / num_stas
+	double	rate;			// queries per second over the last window
+	unsigned long long	total_queries;
+	unsigned long long	total_batches;
+	unsigned long long	deferred;	// due but held back by the token bucket
+	unsigned long long	send_errors;
+	unsigned int	min_interval_ms;
+	unsigned int	max_interval_ms;
+} em_sta_metrics_stats_t;
+
+// sends Associated STA Link Metrics Queries for @p num STAs through the radio @p ruid
+using em_sta_metrics_send_func = std::function<int(const unsigned char *ruid, mac_address_t *stas, unsigned int num)>;
+
+/**
+ * @brief Spreads Associated STA Link Metrics Queries over time instead of querying every STA at once.
+ *
+ * Each associated STA gets its own polling interval and a random phase. Queries are issued from
+ * a token bucket so the network wide rate stays bounded, and due STAs of the same radio are
+ * sent together in one pass. After each poll the interval is adapted: an RCPI change of
+ * EM_STA_METRICS_RCPI_DELTA or more drops it to the minimum, traffic halves it and an idle,
+ * stable STA backs off towards EM_STA_METRICS_MAX_INTERVAL_MS.
+ *
+ * The 1905 query carries a single STA MAC Address TLV, so a batch is a group of back to back
+ * CMDUs to the same agent rather than a single CMDU.
+ */
+class em_sta_metrics_sched_t {
+	typedef struct {
+		em_sta_metrics_sample_t	last;
+		unsigned long long	due;		// monotonic ms
+		unsigned long long	last_poll;
+		unsigned int	interval;
+		unsigned int	generation;
+		bool	polled;			// a poll is outstanding, adapt on the next observe()
+	} entry_t;
+
+	typedef std::pair<unsigned long long, unsigned long long>	due_t;	// due ms, STA key
+
+	std::unordered_map<unsigned long long, entry_t>	m_stas;
+	std::priority_queue<due_t, std::vector<due_t>, std::greater<due_t> >	m_due;
+	em_sta_metrics_send_func	m_send;
+	unsigned int	m_generation;
+	unsigned int	m_rand;
+	double	m_tokens;
+	double	m_qps;
+	unsigned long long	m_last_refill;
+	std::queue<unsigned long long>	m_sent_times;	// query timestamps inside the rate window
+	em_sta_metrics_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static unsigned long long now_ms();
+	unsigned int jitter(unsigned int interval);
+	void schedule(unsigned long long key, entry_t& entry, unsigned long long now, unsigned int delay);
+	void adapt(entry_t& entry, const em_sta_metrics_sample_t *sample);
+
+public:
+
+	/**!
+	 * @brief Starts a sync pass, STAs not observed until end_sync() are dropped.
+	 */
+	void begin_sync() { m_generation++; }
+
+	/**!
+	 * @brief Reports an associated STA and its latest metrics from the data model.
+	 *
+	 * A new STA is scheduled at a random point within the default interval. For a known STA the
+	 * interval is adapted if a poll was sent since the previous observation.
+	 */
+	void observe(const em_sta_metrics_sample_t *sample);
+
+	/**!
+	 * @brief Drops STAs that were not observed since begin_sync().
+	 */
+	void end_sync();
+
+	/**!
+	 * @brief Sends the queries that are due and allowed by the token bucket.
+	 *
+	 * @returns Number of queries sent.
+	 */
+	unsigned int run();
+
+	/**!
+	 * @brief Sets the network wide query budget.
+	 */
+	void set_rate(double qps) { m_qps = qps; }
+
+	/**!
+	 * @brief Returns the achieved polling rate and coverage.
+	 */
+	const em_sta_metrics_stats_t *get_stats();
+
+	em_sta_metrics_sched_t(em_sta_metrics_send_func send);
+	~em_sta_metrics_sched_t();
+};
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_STEER_ENGINE_H
+#define EM_STEER_ENGINE_H
+
+#include <time.h>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "em_base.h"
+
+#define EM_STEER_MAX_CANDS		6	// candidate BSSes kept per STA, the strongest measured
+#define EM_STEER_CAND_MAX_AGE		30	// seconds a beacon measurement stays usable
+#define EM_STEER_LINK_MAX_AGE		10	// seconds an associated link RCPI stays usable
+#define EM_STEER_RCPI_HYSTERESIS	10	// RCPI units (0.5 dB) a candidate must beat the current BSS by
+#define EM_STEER_UTIL_PENALTY_DIV	4	// channel utilisation above the policy threshold per RCPI unit of penalty
+#define EM_STEER_PENDING_TIMEOUT	10	// seconds without BTM report or roam before an attempt counts as failed
+#define EM_STEER_BACKOFF_S		30	// after an attempt, doubled per consecutive failure
+#define EM_STEER_BACKOFF_MAX_S		600
+#define EM_STEER_MAX_FAILURES		3	// consecutive failures before the STA is left alone until it roams
+#define EM_STEER_MAX_IN_FLIGHT		8	// attempts waiting for an outcome, network wide
+
+typedef enum {
+	em_steer_sta_state_idle,
+	em_steer_sta_state_pending,	// request sent, waiting for the BTM report or the roam
+	em_steer_sta_state_backoff,
+	em_steer_sta_state_excluded,	// disallowed or given up, until the STA roams
+} em_steer_sta_state_t;
+
+typedef struct {
+	mac_address_t	sta;
+	bssid_t	source;
+	bssid_t	target;
+	unsigned char	target_op_class;
+	unsigned char	target_channel;
+	int	gain;		// score improvement, RCPI units
+} em_steer_req_params_t;
+
+typedef struct {
+	unsigned int	num_stas;
+	unsigned int	num_bss;
+	unsigned int	in_flight;
+	unsigned long long	evaluated;	// STA evaluations, one per STA touched by a report
+	unsigned long long	requested;
+	unsigned long long	succeeded;
+	unsigned long long	failed;
+	unsigned long long	deferred;	// decisions waiting for an in flight slot
+} em_steer_stats_t;
+
+// sends the steering request of @p req, returns -1 if it could not be sent
+using em_steer_apply_func = std::function<int(const em_steer_req_params_t *req)>;
+
+/**
+ * @brief Controller client steering decision engine.
+ *
+ * Each associated STA keeps the RCPI of its link and up to EM_STEER_MAX_CANDS candidate BSSes from
+ * its beacon reports. A report re-evaluates only the STAs it touches: a link metrics or beacon report
+ * its STA, an AP metrics report the STAs associated to the BSS or holding it as a candidate, found
+ * through a per BSS reverse index that is compacted lazily while it is walked.
+ *
+ * A candidate scores its RCPI less a penalty for channel utilisation above the threshold of its radio.
+ * The steering policy of the serving radio decides when to steer: never when disallowed, below the RCPI
+ * threshold when RCPI mandated, and also above the utilisation threshold when RCPI allowed. STAs on the
+ * BTM steering disallowed list are never steered.
+ *
+ * Decisions are queued and sent from run() on the manager thread, at most EM_STEER_MAX_IN_FLIGHT at a
+ * time. Every STA runs a small state machine: idle, pending until the BTM report or the roam, then backoff,
+ * doubling on consecutive failures, and excluded after EM_STEER_MAX_FAILURES until the STA roams.
+ *
+ * Reports come from the em threads, the sync and run() from the manager thread.
+ */
+class em_steer_engine_t {
+	typedef struct {
+		unsigned long long	bssid = 0;
+		unsigned char	rcpi = 0;
+		time_t	time = 0;
+	} cand_t;
+
+	typedef struct {
+		unsigned long long	bssid = 0;	// 0 while not associated
+		unsigned char	rcpi = 0;
+		time_t	rcpi_time = 0;
+		cand_t	cands[EM_STEER_MAX_CANDS] = {};
+		unsigned int	num_cands = 0;
+		em_steer_sta_state_t	state = em_steer_sta_state_idle;
+		time_t	until = 0;		// end of pending or backoff
+		unsigned long long	target = 0;
+		int	gain = 0;
+		unsigned int	failures = 0;
+		unsigned int	generation = 0;
+		bool	queued = false;
+		bool	active = false;		// in m_active
+	} sta_t;
+
+	typedef struct {
+		unsigned long long	ruid = 0;
+		unsigned char	op_class = 0;
+		unsigned char	channel = 0;
+		unsigned char	util = 0;
+		unsigned int	generation = 0;
+		std::vector<unsigned long long>	stas = {};	// associated or holding the BSS as a candidate
+	} bss_t;
+
+	typedef struct {
+		em_steering_policy_type_t	type = em_steering_policy_type_unknown;
+		unsigned char	util_threshold = 0;
+		unsigned char	rcpi_threshold = 0;
+		unsigned int	generation = 0;
+	} policy_t;
+
+	std::mutex	m_lock;
+	std::unordered_map<unsigned long long, sta_t>	m_stas;
+	std::unordered_map<unsigned long long, bss_t>	m_bss;
+	std::unordered_map<unsigned long long, policy_t>	m_policies;	// per ruid, 0 for the default
+	std::unordered_map<unsigned long long, unsigned int>	m_disallowed;	// BTM steering disallowed STA to generation
+	std::vector<unsigned long long>	m_queue;	// STAs with a decision to send
+	std::vector<unsigned long long>	m_active;	// STAs pending or in backoff
+	em_steer_apply_func	m_apply;
+	unsigned int	m_generation;
+	unsigned int	m_in_flight;
+	em_steer_stats_t	m_stats;
+
+	static unsigned long long mac_key(const unsigned char *mac);
+	static void key_to_mac(unsigned long long key, unsigned char *mac);
+	static time_t now_s();
+
+	const policy_t *get_policy(unsigned long long ruid);
+	void link_bss(unsigned long long bssid, unsigned long long sta);
+	void set_bssid(unsigned long long key, sta_t& sta, unsigned long long bssid, time_t now);
+	void add_cand(unsigned long long key, sta_t& sta, unsigned long long bssid, unsigned char rcpi, time_t now);
+	int score(unsigned char rcpi, unsigned long long bssid);
+	void evaluate(unsigned long long key, sta_t& sta, time_t now);
+	void finish(sta_t& sta, bool success, time_t now);
+
+public:
+
+	/**!
+	 * @brief Starts a sync pass, BSSes, policies and STAs not observed until end_sync() are dropped.
+	 */
+	void begin_sync();
+
+	/**!
+	 * @brief Reports a BSS of a configured radio and the operating class and channel of the radio.
+	 */
+	void observe_bss(const unsigned char *bssid, const unsigned char *ruid, unsigned int op_class, unsigned int channel);
+
+	/**!
+	 * @brief Reports a steering policy.
+	 *
+	 * @param[in] policy Steering parameter policy of a radio, broadcast radio for the default, or BTM steering
+	 * disallowed STA list. Other policies are ignored.
+	 */
+	void observe_policy(const em_policy_t *policy);
+
+	/**!
+	 * @brief Reports an associated STA, a change of BSS resolves a pending attempt.
+	 */
+	void observe_sta(const unsigned char *sta, const unsigned char *bssid);
+
+	void end_sync();
+
+	/**!
+	 * @brief Updates the link RCPI of an associated STA from its link metrics.
+	 */
+	void update_sta_link(const unsigned char *sta, const unsigned char *bssid, unsigned char rcpi);
+
+	/**!
+	 * @brief Updates the candidate BSSes of a STA from the measurement report elements of a Beacon Metrics Response.
+	 *
+	 * @param[in] sta STA.
+	 * @param[in] elems Measurement report elements.
+	 * @param[in] len Length of @p elems.
+	 */
+	void update_beacon_report(const unsigned char *sta, const unsigned char *elems, unsigned int len);
+
+	/**!
+	 * @brief Updates the channel utilisation of a BSS from its AP metrics.
+	 */
+	void update_bss_metrics(const unsigned char *bssid, unsigned char util);
+
+	/**!
+	 * @brief Resolves the pending attempt of a STA from its Client Steering BTM Report.
+	 *
+	 * @param[in] sta STA.
+	 * @param[in] status BTM status code, 0 when the STA accepted.
+	 */
+	void update_steer_report(const unsigned char *sta, unsigned char status);
+
+	/**!
+	 * @brief Times out pending attempts, ends backoffs and sends the queued decisions.
+	 *
+	 * @returns Number of steering requests sent.
+	 */
+	unsigned int run();
+
+	const em_steer_stats_t *get_stats();
+
+	em_steer_engine_t(em_steer_apply_func apply);
+	~em_steer_engine_t();
+};
+
+#endif
@@ -20,6 +20,7 @@
 #define EM_STEERING_H
 
 #include "em_base.h"
+#include "em_steer_engine.h"
 
 class em_steering_t {
 
@@ -276,6 +277,13 @@ public:
 	 */
 	virtual em_cmd_t *get_current_cmd() = 0;
 
+	/**!
+	 * @brief Retrieves the client steering engine of the service, if it runs one.
+	 *
+	 * @returns The engine, or NULL when BTM reports are only logged.
+	 */
+	virtual em_steer_engine_t *get_steer_engine() = 0;
+
 public:
 
     
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EM_TIMER_H
+#define EM_TIMER_H
+
+#include <pthread.h>
+#include <time.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#define EM_TIMER_TICK_MS	10
+#define EM_TIMER_LEVELS		4
+#define EM_TIMER_SLOT_BITS	6
+#define EM_TIMER_SLOTS		(1 << EM_TIMER_SLOT_BITS)
+#define EM_TIMER_SLOT_MASK	(EM_TIMER_SLOTS - 1)
+
+#define EM_TIMER_INVALID_ID	0
+
+using em_timer_cb_t = std::function<void()>;
+
+typedef struct em_timer_s {
+	unsigned int	id = EM_TIMER_INVALID_ID;
+	unsigned long long	expires = 0;	// in ticks since the wheel was created
+	unsigned long long	period = 0;	// in ticks, 0 for one-shot timers
+	em_timer_cb_t	cb = nullptr;
+	unsigned int	level = 0;
+	unsigned int	slot = 0;
+	bool	cancelled = false;
+	bool	firing = false;
+	struct em_timer_s	*prev = NULL;
+	struct em_timer_s	*next = NULL;
+} em_timer_t;
+
+/**
+ * @brief Hierarchical timer wheel driven by the monotonic clock.
+ *
+ * Level 0 holds timers due within the next EM_TIMER_SLOTS ticks, each further level covers
+ * EM_TIMER_SLOTS times the range of the one below and is cascaded down when the lower level
+ * wraps. Add and cancel are O(1). Periodic timers are re-armed from their deadline rather than
+ * from the time they ran, so they do not drift; if the owner falls behind by more than a
+ * period the missed expiries are coalesced into one call.
+ *
+ * Timers may be added and cancelled from any thread, callbacks run on the thread calling run()
+ * without the wheel lock held, so a callback may add or cancel timers including itself.
+ */
+class em_timer_wheel_t {
+	pthread_mutex_t	m_lock;
+	struct timespec	m_base;
+	unsigned long long	m_now;		// last tick processed
+	unsigned int	m_next_id;
+	unsigned int	m_pending_upper;	// timers sitting above level 0
+	em_timer_t	*m_slot[EM_TIMER_LEVELS][EM_TIMER_SLOTS];
+	std::unordered_map<unsigned int, em_timer_t *>	m_timers;
+	std::vector<em_timer_t *>	m_expired;
+
+	unsigned long long current_tick();
+	void link(em_timer_t *timer);
+	void unlink(em_timer_t *timer);
+	void cascade(unsigned int level);
+	void advance(unsigned long long to);
+
+public:
+
+	/**!
+	 * @brief Arms a timer.
+	 *
+	 * @param[in] ms Delay before the first expiry, rounded up to EM_TIMER_TICK_MS.
+	 * @param[in] periodic Re-arm the timer every @p ms after each expiry.
+	 * @param[in] cb Callback, run from run().
+	 *
+	 * @returns Timer id to be passed to cancel(), never EM_TIMER_INVALID_ID.
+	 */
+	unsigned int add(unsigned int ms, bool periodic, em_timer_cb_t cb);
+
+	/**!
+	 * @brief Cancels a timer. A timer cancelled from its own callback is not re-armed.
+	 *
+	 * A callback already running on the thread calling run() is not waited for, it completes
+	 * after cancel() has returned.
+	 *
+	 * @returns 0 if the timer was armed, -1 if the id is unknown or already expired.
+	 */
+	int cancel(unsigned int id);
+
+	/**!
+	 * @brief Runs the callbacks of every timer that is due.
+	 *
+	 * Must only be called from one thread, the owner of the wheel.
+	 *
+	 * @returns Number of callbacks run.
+	 */
+	unsigned int run();
+
+	/**!
+	 * @brief Time until the next timer is due, bounded by @p max_ms.
+	 *
+	 * May return early when an upper level is about to cascade, the caller just waits again.
+	 */
+	unsigned int get_wait_ms(unsigned int max_ms);
+
+	/**!
+	 * @brief Number of armed timers.
+	 */
+	unsigned int count();
+
+	em_timer_wheel_t();
+	em_timer_wheel_t(const em_timer_wheel_t&) = delete;
+	em_timer_wheel_t& operator = (const em_timer_wheel_t&) = delete;
+	~em_timer_wheel_t();
+};
+
+#endif
@@ -33,6 +33,8 @@
 #include <memory>
 #include <vector>
 
+#include "em_freq_table.h"
+
 #ifndef LOG_PATH_PREFIX
 #define LOG_PATH_PREFIX "/nvram/"
 #endif // LOG_PATH_PREFIX
@@ -219,6 +221,22 @@ namespace util {
 	 */
 	int em_chan_to_freq(uint8_t op_class, uint8_t chan, const std::string& country="");
 
+	/**
+	 * @brief Resolve a region code ("US", "EU", "JP", "CN") for em_chan_to_freq() / em_freq_to_chan().
+	 *
+	 * @param[in] region The region code, "" for global operating classes only.
+	 *
+	 * @return em_freq_region_t The region, em_freq_region_other if it has no operating classes of its own.
+	 */
+	em_freq_region_t em_freq_region(const std::string& region);
+
+	/**
+	 * @brief Convert channel info to frequency, with the region already resolved by em_freq_region().
+	 *
+	 * A table lookup per (region, operating class), no scan of the operating class table.
+	 */
+	int em_chan_to_freq(uint8_t op_class, uint8_t chan, em_freq_region_t region);
+
 
 	/**
 	 * @brief Converts a frequency to its corresponding operating class and channel number.
@@ -234,6 +252,13 @@ namespace util {
 	 */
 	std::pair<uint8_t, uint8_t> em_freq_to_chan(unsigned int frequency, const std::string& region="");
 
+	/**
+	 * @brief Converts a frequency to its operating class and channel, with the region already resolved by em_freq_region().
+	 *
+	 * A table lookup per (region, frequency), no scan of the operating class table.
+	 */
+	std::pair<uint8_t, uint8_t> em_freq_to_chan(unsigned int frequency, em_freq_region_t region);
+
 
 	/**
 	 * @brief Translate an AKM literal to its OUI representation case-insensitively.
@@ -1370,7 +1370,8 @@ em_t *em_agent_t::find_em_for_msg_type(unsigned char *data, unsigned int len, em
             }
 
             dm_easy_mesh_t::macbytes_to_string(ruid, mac_str1);
-            if (((em = (em_t *)hash_map_get(m_em_map, mac_str1)) != NULL)  && (em->get_state() == em_state_agent_onewifi_bssconfig_ind)) {
+            if (((em = (em_t *)hash_map_get(m_em_map, mac_str1)) != NULL)  && ((em->get_state() == em_state_agent_onewifi_bssconfig_ind) ||
+                    (em->get_state() == em_state_agent_configured))) {
                 printf("%s:%d: Received topo query, found existing radio:%s\n", __func__, __LINE__, mac_str1);
             } else {
                 printf("%s:%d: Could not find em for em_msg_type_topo_query\n", __func__, __LINE__);
@@ -37,12 +37,9 @@
 
 bool em_simulator_t::run(dm_easy_mesh_agent_t& dm)
 {
-	char time_date[EM_DATE_TIME_BUFF_SZ];
-	unsigned int i, j, k;
+	unsigned int i, j;
 	em_scan_result_t	scan_result;
 	dm_scan_result_t *res;
-	em_long_string_t key;
-	mac_addr_str_t dev_mac_str, scanner_mac_str;
 	mac_address_t nbr_mac_base = {0x00, 0x01, 0x03, 0x04, 0x05, 0x06};
 
 	if (m_can_run_scan_res == false) {
@@ -54,55 +51,51 @@ bool em_simulator_t::run(dm_easy_mesh_agent_t& dm)
         for (j = 0; j < m_param.u.scan_params.op_class[i].num_channels; j++) {
 
 			strncpy(scan_result.id.net_id, dm.m_network.m_net_info.id, strlen(dm.m_network.m_net_info.id) + 1);
-			memcpy(scan_result.id.dev_mac, dm.m_device.m_device_info.id.dev_mac, sizeof(mac_address_t));
+			memcpy(scan_result.id.dev_mac, dm.m_device.m_device_info.intf.mac, sizeof(mac_address_t));
 			memcpy(scan_result.id.scanner_mac, m_param.u.scan_params.ruid, sizeof(mac_address_t));
 			scan_result.id.op_class = m_param.u.scan_params.op_class[i].op_class;
 			scan_result.id.channel = m_param.u.scan_params.op_class[i].channels[j];
 			scan_result.id.scanner_type = em_scanner_type_radio;
 
-			dm_easy_mesh_t::macbytes_to_string(dm.m_device.m_device_info.id.dev_mac, dev_mac_str);
-			dm_easy_mesh_t::macbytes_to_string(m_param.u.scan_params.ruid, scanner_mac_str);
-
-			snprintf(key, sizeof(em_long_string_t), "%s@%s@%s@%d@%d@%d", scan_result.id.net_id, dev_mac_str, scanner_mac_str,
-				scan_result.id.op_class, scan_result.id.channel, scan_result.id.scanner_type);
-
-			if ((res = (dm_scan_result_t *)hash_map_get(dm.m_scan_result_map, key)) == NULL) {
-				res = new dm_scan_result_t(&scan_result);
-				hash_map_put(dm.m_scan_result_map, strdup(key), res);
-			}
-			
-			strncpy(res->m_scan_result.id.net_id, dm.m_network.m_net_info.id, strlen(dm.m_network.m_net_info.id) + 1);
-			memcpy(res->m_scan_result.id.dev_mac, dm.m_device.m_device_info.intf.mac, sizeof(mac_address_t));
-			memcpy(res->m_scan_result.id.scanner_mac, m_param.u.scan_params.ruid, sizeof(mac_address_t));
-			res->m_scan_result.id.op_class = m_param.u.scan_params.op_class[i].op_class;
-			res->m_scan_result.id.channel = m_param.u.scan_params.op_class[i].channels[j];
-			res->m_scan_result.scan_status = 0;
-
-			util::get_date_time_rfc3399(time_date, sizeof(time_date));
-
-			strncpy(res->m_scan_result.timestamp, time_date, strlen(time_date) + 1);
-			res->m_scan_result.util = 20;
-			res->m_scan_result.noise = 10;
-
-			res->m_scan_result.num_neighbors = 2;
-
-			for (k = 0; k < res->m_scan_result.num_neighbors; k++) {
-				nbr_mac_base[5]++;
-				memcpy(res->m_scan_result.neighbor[k].bssid, nbr_mac_base, sizeof(mac_address_t));
-				strncpy(res->m_scan_result.neighbor[k].ssid, "test", strlen("test") + 1);
-				res->m_scan_result.neighbor[k].signal_strength = 30;
-				res->m_scan_result.neighbor[k].bandwidth = WIFI_CHANNELBANDWIDTH_40MHZ;
-				res->m_scan_result.neighbor[k].bss_color = 0x8f;
-				res->m_scan_result.neighbor[k].channel_util =70;
-				res->m_scan_result.neighbor[k].sta_count = 5;
-			}
+			// the id is keyed as reported, with the AL interface as the device
+			res = dm.create_new_scan_result(&scan_result.id);
 
+			fabricate(&res->m_scan_result, 2, nbr_mac_base);
+			res->reindex_neighbors();
+			res->touch();
         }
     }
 
 	return true;
 }
 
+void em_simulator_t::fabricate(em_scan_result_t *res, unsigned short num_neighbors, mac_address_t nbr_mac_base)
+{
+	char time_date[EM_DATE_TIME_BUFF_SZ];
+	unsigned int k;
+
+	res->scan_status = 0;
+
+	util::get_date_time_rfc3399(time_date, sizeof(time_date));
+
+	strncpy(res->timestamp, time_date, strlen(time_date) + 1);
+	res->util = 20;
+	res->noise = 10;
+
+	res->num_neighbors = (num_neighbors > EM_MAX_NEIGHBORS) ? EM_MAX_NEIGHBORS:num_neighbors;
+
+	for (k = 0; k < res->num_neighbors; k++) {
+		nbr_mac_base[5]++;
+		memcpy(res->neighbor[k].bssid, nbr_mac_base, sizeof(mac_address_t));
+		strncpy(res->neighbor[k].ssid, "test", strlen("test") + 1);
+		res->neighbor[k].signal_strength = 30;
+		res->neighbor[k].bandwidth = WIFI_CHANNELBANDWIDTH_40MHZ;
+		res->neighbor[k].bss_color = 0x8f;
+		res->neighbor[k].channel_util =70;
+		res->neighbor[k].sta_count = 5;
+	}
+}
+
 void em_simulator_t::configure(dm_easy_mesh_agent_t& dm, em_scan_params_t *params)
 {
 	mac_addr_str_t  radio_mac_str;
@@ -1,5 +1,8 @@
 #include "al_service_access_point.h"
 #include "al_service_utils.h"
+#include <sys/uio.h>
+#include <cerrno>
+#include <algorithm>
 
 // Constructor: Connects to the Unix domain socket using the provided path --> moved from hardcoded to check in the unit test for socket creation
 AlServiceAccessPoint::AlServiceAccessPoint(const std::string &dataSocketPath, const std::string &controlSocketPath) : alDataSocketpath(dataSocketPath),
@@ -69,9 +72,69 @@ void AlServiceAccessPoint::setControlSocketDescriptor(int descriptor)
     alControlSocketDescriptor = descriptor;
 }
 
+// Opens a new stream connection to a socket path, -1 on failure
+static int connectUnixSocket(const std::string &path)
+{
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor == -1) {
+        return -1;
+    }
+    struct sockaddr_un addr = createUnixSocketAddress(path);
+    if (connect(descriptor, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+
+// Connects both sockets again, the new connections take over the existing descriptor numbers
+PrimitiveError AlServiceAccessPoint::reconnect() {
+    int dataDescriptor = connectUnixSocket(alDataSocketpath);
+    if (dataDescriptor == -1) {
+        return PrimitiveError::ConnectionFailed;
+    }
+    int controlDescriptor = connectUnixSocket(alControlSocketpath);
+    if (controlDescriptor == -1) {
+        close(dataDescriptor);
+        return PrimitiveError::ConnectionFailed;
+    }
+
+    // dup2() swaps the connection behind the descriptor atomically, senders and select() users keep their fd
+    bool replaced = (dup2(dataDescriptor, alDataSocketDescriptor) != -1) &&
+                    (dup2(controlDescriptor, alControlSocketDescriptor) != -1);
+    close(dataDescriptor);
+    close(controlDescriptor);
+    if (!replaced) {
+        return PrimitiveError::SocketCreationFailed;
+    }
+
+    // Fragments of the old connection can never be completed
+    reassembly.clear();
+    pendingFrame = PendingFrame();
+
+    // The IEEE1905 application forgets the registration along with the connection
+    if (registrationSent) {
+        try {
+            serviceAccessPointRegistrationRequest(registrationRequest);
+            if (serviceAccessPointRegistrationResponse().getResult() != RegistrationResult::SUCCESS) {
+                return PrimitiveError::RegistrationError;
+            }
+        } catch (const AlServiceException& e) {
+            return e.getPrimitiveError();
+        }
+    }
+    #ifdef DEBUG_MODE
+    std::cout << "Reconnected to Unix sockets: " << alDataSocketpath << ", " << alControlSocketpath << std::endl;
+    #endif
+    return PrimitiveError::Success;
+}
+
 // Executes service registration request (send a registration message)
 void AlServiceAccessPoint::serviceAccessPointRegistrationRequest(AlServiceRegistrationRequest& message) {
     
+    // Kept so that reconnect() can register again
+    registrationRequest = message;
+    registrationSent = true;
     std::vector<unsigned char> serializedData = message.serializeRegistrationRequest();
     ssize_t bytesSent = send(alControlSocketDescriptor, serializedData.data(), serializedData.size(), 0);
     if (bytesSent == -1) {
@@ -102,66 +165,12 @@ AlServiceRegistrationResponse AlServiceAccessPoint::serviceAccessPointRegistrati
     return registrationResponse;
 }
 
-// Message to send a SDU message to the IEEE1905 application
-void AlServiceAccessPoint::serviceAccessPointDataRequest(AlServiceDataUnit& message) {
-    const size_t fragmentSize = 1485;
-    
-    const std::vector<unsigned char>& payload = message.getPayload();
-
-    size_t totalSize = payload.size();
-
+// Registration check done before every data request
+void AlServiceAccessPoint::checkRegistration() const {
     //first condition to check if the service has been correctly registered enable
     if (registrationRequest.getServiceOperation() == ServiceOperation::SOP_ENABLE || registrationResponse.getResult() == RegistrationResult::SUCCESS) {
-         
-        // If payload size is less than or equal to 1500, send directly without fragmentation
-        if (totalSize <= fragmentSize) {
-            message.setIsFragment(0);
-            message.setIsLastFragment(1);
-
-            // Serialize and send the data
-            std::vector<unsigned char> serializedData = message.serialize();
-            ssize_t bytesSent = send(alDataSocketDescriptor, serializedData.data(), serializedData.size(), 0);
-            if (bytesSent == -1) {
-                throw AlServiceException("Failed to send message through Unix socket", PrimitiveError::RequestFailed);
-            }
-            #ifdef DEBUG_MODE
-            std::cout << "Sent single message with size " << std::dec << bytesSent << " bytes (no fragmentation)." << std::endl;
-            #endif
-            return; // Exit the function after sending
-        }
-        // For payloads larger than 1500 bytes, handle fragmentation
-        size_t numFragments = (totalSize + fragmentSize - 1) / fragmentSize;
-        for (size_t i = 0; i < numFragments; ++i) {
-            size_t start = i * fragmentSize;
-            size_t end = std::min(start + fragmentSize, totalSize);
-            std::vector<unsigned char> fragmentData(payload.begin() + start, payload.begin() + end);
-
-            message.setPayload(fragmentData);
-            message.setFragmentId(static_cast<uint8_t>(i));
-            message.setIsFragment(1); // Mark as a fragment
-
-            // Mark as last fragment if this is the last iteration
-            message.setIsLastFragment((i == numFragments - 1) ? 1 : 0);
-
-            // Debugging Output for Fragmentation
-            #ifdef DEBUG_MODE
-            std::cout << "Sending fragment " << i << " of " << numFragments
-                    << " - Size: " << fragmentData.size() << " bytes, "
-                    << "isFragment: " << static_cast<int>(message.getIsFragment()) << ", "
-                    << "FragmentId: " << static_cast<int>(message.getFragmentId()) << ", "
-                    << "isLastFragment: " << static_cast<int>(message.getIsLastFragment()) << std::endl;
-            #endif
-            // Serialize and send the current fragment
-            std::vector<unsigned char> serializedData = message.serialize();
-            ssize_t bytesSent = send(alDataSocketDescriptor, serializedData.data(), serializedData.size(), 0);
-            if (bytesSent == -1) {
-                throw AlServiceException("Failed to send message fragment through Unix socket", PrimitiveError::RequestFailed);
-            }
-            #ifdef DEBUG_MODE
-            std::cout << "Fragment " << i << " sent successfully with size " << bytesSent << " bytes." << std::endl;
-            #endif
-        }
-    }else if (registrationResponse.getResult() != RegistrationResult::SUCCESS) {
+        return;
+    } else if (registrationResponse.getResult() != RegistrationResult::SUCCESS) {
     #ifdef DEBUG_MODE
     // If registration was unsuccessful
     #endif
@@ -173,42 +182,160 @@ void AlServiceAccessPoint::serviceAccessPointDataRequest(AlServiceDataUnit& mess
         std::cout << "Cannot send data: Service operation not enabled." << std::endl;
         #endif
         throw AlServiceException("Service operation not enabled", PrimitiveError::ServiceNotRegistered);
-        }else{
-                std::cout << "Cannot send data: Unknown problem." << std::endl;
-                throw AlServiceException("Cannot send data: Unknown problem", PrimitiveError::UnknownError);
+    } else {
+        std::cout << "Cannot send data: Unknown problem." << std::endl;
+        throw AlServiceException("Cannot send data: Unknown problem", PrimitiveError::UnknownError);
+    }
+}
+
+// Gathers the header and the payload slice into one write, the payload is never copied
+ssize_t AlServiceAccessPoint::sendFragment(const unsigned char *header, const unsigned char *data, size_t length) {
+    struct iovec iov[2];
+    struct msghdr msg = {};
+    size_t total = AlServiceDataUnit::headerSize + length;
+    size_t sent = 0;
 
+    iov[0].iov_base = const_cast<unsigned char *>(header);
+    iov[0].iov_len = AlServiceDataUnit::headerSize;
+    iov[1].iov_base = const_cast<unsigned char *>(data);
+    iov[1].iov_len = length;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = (length > 0) ? 2 : 1;
+
+    while (sent < total) {
+        ssize_t bytesSent = sendmsg(alDataSocketDescriptor, &msg, MSG_NOSIGNAL);
+        if (bytesSent == -1) {
+            if (errno == EINTR) {
+                continue;
             }
+            return -1;
+        }
+        sent += static_cast<size_t>(bytesSent);
+
+        // Short write on the stream socket, advance the iovec past what was written
+        size_t skip = static_cast<size_t>(bytesSent);
+        while (msg.msg_iovlen > 0 && skip >= msg.msg_iov[0].iov_len) {
+            skip -= msg.msg_iov[0].iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov[0].iov_base = static_cast<unsigned char *>(msg.msg_iov[0].iov_base) + skip;
+            msg.msg_iov[0].iov_len -= skip;
+        }
+    }
 
+    return static_cast<ssize_t>(sent);
 }
+
+// Message to send a SDU message to the IEEE1905 application
+void AlServiceAccessPoint::serviceAccessPointDataRequest(AlServiceDataUnit& message) {
+    const std::vector<unsigned char>& payload = message.getPayload();
+
+    serviceAccessPointDataRequest(message.getSourceAlMacAddress(), message.getDestinationAlMacAddress(),
+                                  payload.data(), payload.size());
+}
+
+// Sends the frame from the caller's buffer, fragmenting it into header + slice writes
+void AlServiceAccessPoint::serviceAccessPointDataRequest(const MacAddress& source, const MacAddress& destination,
+                                                         const unsigned char *payload, size_t length) {
+    unsigned char header[AlServiceDataUnit::headerSize];
+    AlServiceDataUnit fragment;
+
+    checkRegistration();
+
+    fragment.setSourceAlMacAddress(source);
+    fragment.setDestinationAlMacAddress(destination);
+
+    // If payload size is less than or equal to the fragment size, send directly without fragmentation
+    if (length <= fragmentSize) {
+        fragment.setIsFragment(0);
+        fragment.setIsLastFragment(1);
+        fragment.setFragmentId(0);
+        fragment.serializeHeader(header);
+
+        ssize_t bytesSent = sendFragment(header, payload, length);
+        if (bytesSent == -1) {
+            throw AlServiceException("Failed to send message through Unix socket", PrimitiveError::RequestFailed);
+        }
+        #ifdef DEBUG_MODE
+        std::cout << "Sent single message with size " << std::dec << bytesSent << " bytes (no fragmentation)." << std::endl;
+        #endif
+        return; // Exit the function after sending
+    }
+
+    // For larger payloads, handle fragmentation
+    size_t numFragments = (length + fragmentSize - 1) / fragmentSize;
+    for (size_t i = 0; i < numFragments; ++i) {
+        size_t start = i * fragmentSize;
+        size_t end = std::min(start + fragmentSize, length);
+
+        fragment.setFragmentId(static_cast<uint8_t>(i));
+        fragment.setIsFragment(1); // Mark as a fragment
+
+        // Mark as last fragment if this is the last iteration
+        fragment.setIsLastFragment((i == numFragments - 1) ? 1 : 0);
+        fragment.serializeHeader(header);
+
+        // Debugging Output for Fragmentation
+        #ifdef DEBUG_MODE
+        std::cout << "Sending fragment " << i << " of " << numFragments
+                << " - Size: " << (end - start) << " bytes, "
+                << "isFragment: " << static_cast<int>(fragment.getIsFragment()) << ", "
+                << "FragmentId: " << static_cast<int>(fragment.getFragmentId()) << ", "
+                << "isLastFragment: " << static_cast<int>(fragment.getIsLastFragment()) << std::endl;
+        #endif
+        // Send the header and the slice of the caller's buffer
+        ssize_t bytesSent = sendFragment(header, payload + start, end - start);
+        if (bytesSent == -1) {
+            throw AlServiceException("Failed to send message fragment through Unix socket", PrimitiveError::RequestFailed);
+        }
+        #ifdef DEBUG_MODE
+        std::cout << "Fragment " << i << " sent successfully with size " << bytesSent << " bytes." << std::endl;
+        #endif
+    }
+}
+
 // Executes service indication primitive (receive a message through the socket)
 AlServiceDataUnit AlServiceAccessPoint::serviceAccessPointDataIndication() {
-    std::vector<unsigned char> payload;
+    AlServiceDataUnit message;
+
+    serviceAccessPointDataIndication(message);
+    return message;
+}
+
+// Fragments are received straight into the caller's payload, whose capacity is reused from one message to the next
+void AlServiceAccessPoint::serviceAccessPointDataIndication(AlServiceDataUnit& message) {
+    unsigned char header[AlServiceDataUnit::headerSize];
+    AlServiceDataUnit fragment;
+    std::vector<unsigned char>& payload = message.getPayload();
+    size_t received = 0;
     int fragmentId = 0;
     bool receivingFragments = true;
-    AlServiceDataUnit message;
 
     while (receivingFragments) {
-        std::vector<unsigned char> buffer(1500, 0x00);
+        // The header has a fixed size, read it whole
+        ssize_t bytesRead = recv(alDataSocketDescriptor, header, sizeof(header), MSG_WAITALL);
+        if (bytesRead == static_cast<ssize_t>(sizeof(header))) {
+            fragment.deserializeHeader(header);
 
-        // Receive data from the socket
-        ssize_t bytesRead = recv(alDataSocketDescriptor, buffer.data(), buffer.size(), 0);
+            // Make room for one more fragment at the tail of the payload, a non-last one always fills it
+            payload.resize(received + fragmentSize);
+            ssize_t payloadRead = recv(alDataSocketDescriptor, payload.data() + received, fragmentSize,
+                                       (fragment.getIsLastFragment() == 0) ? MSG_WAITALL : 0);
+            bytesRead = (payloadRead <= 0) ? payloadRead : bytesRead + payloadRead;
+        }
         if (bytesRead <= 0) {
-            if (errno == EBADF || errno == ECONNRESET) {
+            if (bytesRead == 0 || errno == EBADF || errno == ECONNRESET) {
                 throw AlServiceException("Socket closed or connection reset", PrimitiveError::SocketClosed);
             }
             throw AlServiceException("Failed to receive message through Unix socket", PrimitiveError::IndicationFailed);
         }
-        buffer.resize(bytesRead);
-        
-        std::cout << std::endl;
-
-        // Deserialize the received fragment
-        AlServiceDataUnit fragment;
-        try {
-            fragment.deserialize(buffer);
-        } catch (const std::exception& e) {
+        if (static_cast<size_t>(bytesRead) < AlServiceDataUnit::headerSize ||
+            (fragment.getIsLastFragment() == 0 && static_cast<size_t>(bytesRead) < AlServiceDataUnit::headerSize + fragmentSize)) {
             throw AlServiceException("Failed to deserialize AlServiceDataUnit fragment", PrimitiveError::InvalidMessage);
         }
+        size_t fragmentLength = static_cast<size_t>(bytesRead) - AlServiceDataUnit::headerSize;
         #ifdef DEBUG_MODE
         std::cout << "Received fragment " << static_cast<int>(fragment.getFragmentId())
                   << " - Size: " << bytesRead << " bytes, "
@@ -221,7 +348,9 @@ AlServiceDataUnit AlServiceAccessPoint::serviceAccessPointDataIndication() {
             #ifdef DEBUG_MODE
             std::cout << "Received a non-fragmented message of size: " << bytesRead << " bytes." << std::endl;
             #endif
-            return fragment; // Return immediately, as no reassembly is needed
+            message.deserializeHeader(header);
+            payload.resize(fragmentLength);
+            return; // Return immediately, as no reassembly is needed
         }
         #ifdef DEBUG_MODE
         // Fragmented message handling
@@ -232,8 +361,8 @@ AlServiceDataUnit AlServiceAccessPoint::serviceAccessPointDataIndication() {
             throw AlServiceException("Fragment out of order", PrimitiveError::FragmentOutOfOrder);
         }
 
-        // Append fragment payload to full payload
-        payload.insert(payload.end(), fragment.getPayload().begin(), fragment.getPayload().end());
+        // The fragment payload already sits at its final place
+        received += fragmentLength;
 
         // Store source and destination MAC addresses from the first fragment
         if (fragmentId == 0) {
@@ -246,12 +375,168 @@ AlServiceDataUnit AlServiceAccessPoint::serviceAccessPointDataIndication() {
         fragmentId++;
     }
 
-    // Set the assembled payload on the AlServiceDataUnit object
-    message.setPayload(payload);
+    // Trim the assembled payload to what was received
+    payload.resize(received);
     #ifdef DEBUG_MODE
-    std::cout << "Reassembled message received with total payload size: " << payload.size() << " bytes." << std::endl;
+    std::cout << "Reassembled message received with total payload size: " << received << " bytes." << std::endl;
     #endif
-    return message;
 }
 
+// Drops partial SDUs whose remaining fragments never arrived, and the buffers of streams that went quiet
+void AlServiceAccessPoint::expireReassembly(std::chrono::steady_clock::time_point now) {
+    for (auto it = reassembly.begin(); it != reassembly.end(); ) {
+        // The stream of a fragment half read off the socket is kept until the fragment is complete
+        bool reading = pendingFrame.payloadRead > 0 &&
+                       std::equal(it->first.begin(), it->first.end(), pendingFrame.header);
+        if (!reading && now - it->second.started > reassemblyTimeout) {
+            #ifdef DEBUG_MODE
+            if (it->second.received > 0) {
+                std::cout << "Dropping incomplete message after " << it->second.received << " bytes." << std::endl;
+            }
+            #endif
+            it = reassembly.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 
+// Status of a non-blocking read that returned no data
+static PrimitiveError receiveStatus(ssize_t bytesRead) {
+    if (bytesRead == 0) {
+        return PrimitiveError::SocketClosed;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        return PrimitiveError::Success;
+    }
+    return (errno == EBADF || errno == ECONNRESET) ? PrimitiveError::SocketClosed : PrimitiveError::IndicationFailed;
+}
+
+// Non-blocking service indication primitive, reassembles concurrently per stream and returns status codes
+PrimitiveError AlServiceAccessPoint::serviceAccessPointDataIndication(std::vector<AlServiceDataUnit>& sdus, size_t maxSdus, size_t& count) {
+    unsigned char discarded[fragmentSize];
+    AlServiceDataUnit fragment;
+    PrimitiveError status = PrimitiveError::Success;
+    auto now = std::chrono::steady_clock::now();
+
+    count = 0;
+    expireReassembly(now);
+
+    while (count < maxSdus) {
+        PendingFrame& frame = pendingFrame;
+        ssize_t bytesRead;
+
+        // The header has a fixed size, a frame is not looked at before all of it is read
+        if (frame.headerRead < AlServiceDataUnit::headerSize) {
+            bytesRead = recv(alDataSocketDescriptor, frame.header + frame.headerRead,
+                             AlServiceDataUnit::headerSize - frame.headerRead, MSG_DONTWAIT);
+            if (bytesRead <= 0) {
+                status = receiveStatus(bytesRead);
+                break;
+            }
+            frame.headerRead += static_cast<size_t>(bytesRead);
+            continue;
+        }
+
+        fragment.deserializeHeader(frame.header);
+        StreamKey key;
+        std::copy(frame.header, frame.header + key.size(), key.begin());
+        bool single = (fragment.getIsFragment() == 0 && fragment.getIsLastFragment() == 1);
+        unsigned char *dest = discarded;
+        Reassembly *entry = NULL;
+
+        // Slots past the ones returned so far keep their payload buffers for the next calls
+        if (count == sdus.size()) {
+            sdus.emplace_back();
+        }
+
+        if (single) {
+            // Single message, received straight into the next slot
+            std::vector<unsigned char>& payload = sdus[count].getPayload();
+            payload.resize(fragmentSize);
+            dest = payload.data();
+        } else {
+            // Fragment, received in place at the tail of its stream's payload
+            auto it = reassembly.find(key);
+            if (it == reassembly.end()) {
+                Reassembly created;
+                created.sdu.getPayload().clear();
+                created.received = 0;
+                created.nextFragmentId = 0;
+                it = reassembly.emplace(key, std::move(created)).first;
+            }
+            entry = &it->second;
+
+            if (frame.payloadRead == 0 && fragment.getFragmentId() != entry->nextFragmentId) {
+                // Out of order, the partial SDU of this stream cannot be completed, the fragment is read and dropped
+                #ifdef DEBUG_MODE
+                std::cout << "Fragment " << static_cast<int>(fragment.getFragmentId()) << " out of order, expected "
+                          << static_cast<int>(entry->nextFragmentId) << ". Dropping message." << std::endl;
+                #endif
+                entry->received = 0;
+                entry->nextFragmentId = 0;
+                frame.discard = true;
+            }
+            if (frame.discard == false) {
+                std::vector<unsigned char>& payload = entry->sdu.getPayload();
+                if (entry->nextFragmentId == 0 && frame.payloadRead == 0) {
+                    entry->sdu.setSourceAlMacAddress(fragment.getSourceAlMacAddress());
+                    entry->sdu.setDestinationAlMacAddress(fragment.getDestinationAlMacAddress());
+                    entry->started = now;
+                }
+                payload.resize(entry->received + fragmentSize);
+                dest = payload.data() + entry->received;
+            }
+        }
+
+        // A non-last fragment always carries fragmentSize bytes and may arrive over several reads,
+        // the last one ends with the write of its sender
+        bytesRead = recv(alDataSocketDescriptor, dest + frame.payloadRead, fragmentSize - frame.payloadRead, MSG_DONTWAIT);
+        if (bytesRead <= 0) {
+            status = receiveStatus(bytesRead);
+            break;
+        }
+        frame.payloadRead += static_cast<size_t>(bytesRead);
+        if (fragment.getIsLastFragment() == 0 && frame.payloadRead < fragmentSize) {
+            continue;
+        }
+
+        // The frame is complete, the next read starts a new header
+        size_t length = frame.payloadRead;
+        bool discard = frame.discard;
+        if (single && !discard) {
+            sdus[count].deserializeHeader(frame.header);
+        }
+        frame = PendingFrame();
+        if (discard) {
+            continue;
+        }
+
+        if (single) {
+            sdus[count].getPayload().resize(length);
+            count++;
+            continue;
+        }
+
+        entry->received += length;
+        entry->nextFragmentId++;
+
+        if (fragment.getIsLastFragment() == 1) {
+            // The slot takes the reassembled payload and leaves its own buffer to the stream's next message
+            AlServiceDataUnit& sdu = sdus[count];
+            std::vector<unsigned char>& payload = entry->sdu.getPayload();
+            payload.resize(entry->received);
+            sdu.setSourceAlMacAddress(entry->sdu.getSourceAlMacAddress());
+            sdu.setDestinationAlMacAddress(entry->sdu.getDestinationAlMacAddress());
+            sdu.setIsFragment(1);
+            sdu.setIsLastFragment(1);
+            sdu.setFragmentId(fragment.getFragmentId());
+            sdu.getPayload().swap(payload);
+            entry->received = 0;
+            entry->nextFragmentId = 0;
+            count++;
+        }
+    }
+
+    return status;
+}
@@ -1,5 +1,6 @@
 #include "al_service_data_unit.h"
 #include "al_service_exception.h"
+#include <algorithm>
 
 AlServiceDataUnit::AlServiceDataUnit() {
     sourceAlMacAddress.fill(0);
@@ -35,21 +36,36 @@ void AlServiceDataUnit::appendToPayload(const unsigned char* data, size_t length
     payload.insert(payload.end(), data, data + length);
 }
 
+// Header serialization, shared by serialize() and the scatter/gather send path
+void AlServiceDataUnit::serializeHeader(unsigned char *buffer) const {
+    std::copy(sourceAlMacAddress.begin(), sourceAlMacAddress.end(), buffer);
+    std::copy(destinationAlMacAddress.begin(), destinationAlMacAddress.end(), buffer + 6);
+
+    // Ensure the fragment information is stored as single bytes
+    buffer[12] = static_cast<uint8_t>(isFragment);
+    buffer[13] = static_cast<uint8_t>(isLastFragment);
+    buffer[14] = static_cast<uint8_t>(fragmentId);
+}
+
+// Header deserialization, shared by deserialize() and the in-place receive path
+void AlServiceDataUnit::deserializeHeader(const unsigned char *buffer) {
+    std::copy(buffer, buffer + 6, sourceAlMacAddress.begin());
+    std::copy(buffer + 6, buffer + 12, destinationAlMacAddress.begin());
+
+    isFragment = static_cast<uint8_t>(buffer[12]);
+    isLastFragment = static_cast<uint8_t>(buffer[13]);
+    fragmentId = static_cast<uint8_t>(buffer[14]);
+}
+
 // Serialization method
 std::vector<unsigned char> AlServiceDataUnit::serialize() const {
-    std::vector<unsigned char> serializedData;
+    std::vector<unsigned char> serializedData(headerSize + payload.size());
 
-    // Add MAC addresses
-    serializedData.insert(serializedData.end(), sourceAlMacAddress.begin(), sourceAlMacAddress.end());
-    serializedData.insert(serializedData.end(), destinationAlMacAddress.begin(), destinationAlMacAddress.end());
-
-    // Add fragment information
-    serializedData.push_back(static_cast<uint8_t>(isFragment));      // Ensure isFragment is stored as a single byte
-    serializedData.push_back(static_cast<uint8_t>(isLastFragment));  // Ensure isLastFragment is stored as a single byte
-    serializedData.push_back(static_cast<uint8_t>(fragmentId));
+    // Add MAC addresses and fragment information
+    serializeHeader(serializedData.data());
 
     // Add Payload
-    serializedData.insert(serializedData.end(), payload.begin(), payload.end());
+    std::copy(payload.begin(), payload.end(), serializedData.begin() + headerSize);
     #ifdef DEBUG_MODE
     // Debugging output to confirm correct interpretation of flags
     std::cout << "Serialized Fragment Information - isFragment: " << static_cast<int>(isFragment)
@@ -63,18 +79,12 @@ std::vector<unsigned char> AlServiceDataUnit::serialize() const {
 // Deserialization method
 void AlServiceDataUnit::deserialize(const std::vector<unsigned char>& data) {
     // Check minimum size (6 bytes each for source and destination MAC, plus 3 bytes for flags and fragment ID)
-    if (data.size() < 15) {
+    if (data.size() < headerSize) {
         throw AlServiceException("Insufficient data to deserialize AlServiceDataUnit", PrimitiveError::DeserializationError);
     }
 
-    // Extract MAC addresses
-    std::copy(data.begin(), data.begin() + 6, sourceAlMacAddress.begin());
-    std::copy(data.begin() + 6, data.begin() + 12, destinationAlMacAddress.begin());
-
-    // Extract fragment information, ensuring correct byte interpretation
-    isFragment = static_cast<uint8_t>(data[12]);
-    isLastFragment = static_cast<uint8_t>(data[13]);
-    fragmentId = static_cast<uint8_t>(data[14]);
+    // Extract MAC addresses and fragment information
+    deserializeHeader(data.data());
     #ifdef DEBUG_MODE
     // Debugging output to confirm correct interpretation of flags
     std::cout << "Deserialized Fragment Information - isFragment: " << static_cast<int>(isFragment)
@@ -82,5 +92,5 @@ void AlServiceDataUnit::deserialize(const std::vector<unsigned char>& data) {
               << ", fragmentId: " << static_cast<int>(fragmentId) << std::endl;
     #endif
     // Extract Payload
-    payload.assign(data.begin() + 15, data.end());
+    payload.assign(data.begin() + headerSize, data.end());
 }
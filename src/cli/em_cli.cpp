@@ -200,6 +200,17 @@ em_cmd_t& em_cli_t::get_command(char *in, size_t in_len, em_network_node_t *node
 			strncat(cmd->m_param.u.args.fixed_args, "DevTest", strlen("DevTest"));
 		}
 		break;
+
+                case em_cmd_type_get_metrics:
+                    // optional rollup resolution in seconds, e.g. Metrics@900
+                    if ((tmp = strchr(cmd->m_param.u.args.fixed_args, '@')) != NULL) {
+                        *tmp = 0;
+                    }
+                    strncat(cmd->m_param.u.args.fixed_args, "@", strlen("@"));
+                    strncat(cmd->m_param.u.args.fixed_args, args[num_args - 1], 
+                            sizeof(em_long_string_t) - strlen(cmd->m_param.u.args.fixed_args) - 1);
+                    break;
+
                 default:
                     break;
             }
@@ -210,6 +221,9 @@ em_cmd_t& em_cli_t::get_command(char *in, size_t in_len, em_network_node_t *node
         if ((tmp = strstr(cmd->m_param.u.args.fixed_args, "Summary")) != NULL) {
             *tmp = 0;
         }
+        if ((cmd->get_type() == em_cmd_type_get_metrics) && ((tmp = strchr(cmd->m_param.u.args.fixed_args, '@')) != NULL)) {
+            *tmp = 0;
+        }
     }
 
     for (i = 0; i < num_args; i++) {
@@ -74,6 +74,7 @@ em_cmd_params_t spec_params[] = {
     {.u = {.args = {2, {"", "", "", "", ""}, "MLDConfig"}}},
     {.u = {.args = {2, {"", "", "", "", ""}, "MLDReconfig"}}},
 	{.u = {.args = {2, {"", "", "", "", ""}, "DevTest.json"}}},
+	{.u = {.args = {3, {"", "", "", "", ""}, "Metrics"}}},
 	{.u = {.args = {0, {"", "", "", "", ""}, "max"}}},
 };
 
@@ -108,7 +109,9 @@ em_cmd_t em_cmd_cli_t::m_client_cmd_spec[] = {
     em_cmd_t(em_cmd_type_get_mld_config, spec_params[26]),
     em_cmd_t(em_cmd_type_mld_reconfig, spec_params[27]),
     em_cmd_t(em_cmd_type_set_dev_test, spec_params[28]),
-    em_cmd_t(em_cmd_type_max, spec_params[29]),
+    // arguments are network id, entity MAC or all, optional resolution
+    em_cmd_t(em_cmd_type_get_metrics, spec_params[29]),
+    em_cmd_t(em_cmd_type_max, spec_params[30]),
 };
 
 int em_cmd_cli_t::get_edited_node(em_network_node_t *node, const char *header, char *buff)
@@ -168,6 +171,36 @@ int em_cmd_cli_t::get_edited_node(em_network_node_t *node, const char *header, c
 	return strlen(formatted) + 1;
 }
 
+int em_cmd_cli_t::read_dm_snapshot(char *result)
+{
+    em_bus_event_t *bevt = &get_event()->u.bevt;
+    em_subdoc_info_t *info = &bevt->u.subdoc;
+
+    switch (bevt->type) {
+        case em_bus_event_type_get_network:
+        case em_bus_event_type_get_device:
+        case em_bus_event_type_get_radio:
+        case em_bus_event_type_get_ssid:
+        case em_bus_event_type_get_channel:
+        case em_bus_event_type_get_bss:
+        case em_bus_event_type_get_sta:
+        case em_bus_event_type_get_policy:
+        case em_bus_event_type_get_mld_config:
+            break;
+
+        default:
+            return -1;
+    }
+
+    if (m_cli.get_dm_snapshot()->read(info->name, m_cmd.m_param.u.args.args[1], info->buff, EM_MAX_EVENT_DATA_LEN) < 0) {
+        return -1;
+    }
+
+    m_cmd.status_to_string(em_cmd_out_status_success, result);
+
+    return 0;
+}
+
 int em_cmd_cli_t::execute(char *result)
 {
     struct sockaddr_un addr;
@@ -469,12 +502,23 @@ int em_cmd_cli_t::execute(char *result)
             snprintf(info->name, sizeof(info->name), "%s", param->u.args.fixed_args);
             break;
 
+        case em_cmd_type_get_metrics:
+            bevt->type = em_bus_event_type_get_metrics;
+            info = &bevt->u.subdoc;
+            snprintf(info->name, sizeof(info->name), "%s", param->u.args.fixed_args);
+            break;
+
         default:
             break;
     }
 
 	//printf("%s:%d: Length: %d Event len: %d\n", __func__, __LINE__, bevt->data_len, get_event_length());
 
+    // data model reads skip the controller queues while its snapshot is current
+    if ((get_svc() == em_service_type_ctrl) && (read_dm_snapshot(result) == 0)) {
+        return 0;
+    }
+
     get_cmd()->init(&dm);
   
     if ((dsock = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
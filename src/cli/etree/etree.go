@@ -331,6 +331,13 @@ func (m Model) View() string {
 func (m *Model) renderTree(remainingNodes []Node, indent int, count *int) string {
     var b strings.Builder
 
+    m.renderTreeInto(&b, remainingNodes, indent, count)
+
+    return b.String()
+}
+
+// renderTreeInto writes every level into the same builder, so the output is copied once whatever the depth
+func (m *Model) renderTreeInto(b *strings.Builder, remainingNodes []Node, indent int, count *int) {
     for _, node := range remainingNodes {
 
         var str string
@@ -375,12 +382,9 @@ func (m *Model) renderTree(remainingNodes []Node, indent int, count *int) string
         b.WriteString(str)
 
         if node.Children != nil {
-            childStr := m.renderTree(node.Children, indent+1, count)
-            b.WriteString(childStr)
+            m.renderTreeInto(b, node.Children, indent+1, count)
         }
     }
-
-    return b.String()
 }
 
 func (m Model) helpView() string {
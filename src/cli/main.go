@@ -221,7 +221,7 @@ func CreateEasyMeshCommands() map[string]EasyMeshCmd {
 		NetworkMetricsCmd: {
 			Title:                NetworkMetricsCmd,
 			LoadOrder:            10,
-			GetCommand:           "",
+			GetCommand:           "get_metrics OneWifiMesh all",
 			GetCommandEx:         "",
 			SetCommand:           "",
 			Help:                 "",
@@ -285,6 +285,7 @@ type model struct {
 	rightSpace                   int
 	tree                         etree.Model
 	currentNetNode               *C.em_network_node_t
+	currentGetCommand            string
 	displayedNetNode             *C.em_network_node_t
 	quit                         chan bool
 	ticker                       *time.Ticker
@@ -763,9 +764,36 @@ func (m model) treeToNodes(treeNode *etree.Node) *C.em_network_node_t {
 	return netNode
 }
 
-func (m model) nodesToTree(netNode *C.em_network_node_t, treeNode *etree.Node) {
+func hasCollapsedNode(treeNode *etree.Node) bool {
+	if treeNode.Collapsed {
+		return true
+	}
+	for i := range treeNode.Children {
+		if hasCollapsedNode(&treeNode.Children[i]) {
+			return true
+		}
+	}
+	return false
+}
+
+func childTreeNode(treeNode *etree.Node, i int) *etree.Node {
+	if treeNode == nil || i >= len(treeNode.Children) {
+		return nil
+	}
+	return &treeNode.Children[i]
+}
+
+// nodesToTree converts a display tree, prevTreeNode is the conversion of the same path before the
+// last merge_network_tree(), its subtrees are reused where the display tree did not change
+func (m model) nodesToTree(netNode *C.em_network_node_t, treeNode *etree.Node, prevTreeNode *etree.Node) {
 	var str *C.char
 
+	if prevTreeNode != nil && !bool(netNode.display_info.modified) && !hasCollapsedNode(prevTreeNode) &&
+		prevTreeNode.Key == C.GoString(&netNode.key[0]) {
+		*treeNode = *prevTreeNode
+		return
+	}
+
 	//treeNode.Value = C.GoString(&netNode.key[0]) + "." + fmt.Sprintf("%d", uint(netNode.display_info.node_ctr)) + "." + fmt.Sprintf("%d", uint(netNode.display_info.orig_node_ctr))
 	treeNode.Key = C.GoString(&netNode.key[0])
 	nodeType := C.get_node_type(netNode)
@@ -790,7 +818,7 @@ func (m model) nodesToTree(netNode *C.em_network_node_t, treeNode *etree.Node) {
 				}
 				for i := 0; i < int(netNode.num_children); i++ {
 					childNetNode := C.get_child_node_at_index(netNode, C.uint(i))
-					m.nodesToTree(childNetNode, &treeNode.Children[i])
+					m.nodesToTree(childNetNode, &treeNode.Children[i], childTreeNode(prevTreeNode, i))
 				}
 			}
 		} else {
@@ -813,7 +841,7 @@ func (m model) nodesToTree(netNode *C.em_network_node_t, treeNode *etree.Node) {
 		}
 		for i := 0; i < int(netNode.num_children); i++ {
 			childNetNode := C.get_child_node_at_index(netNode, C.uint(i))
-			m.nodesToTree(childNetNode, &treeNode.Children[i])
+			m.nodesToTree(childNetNode, &treeNode.Children[i], childTreeNode(prevTreeNode, i))
 		}
 	}
 }
@@ -844,30 +872,51 @@ func (m *model) execSelectedCommand(cmdStr string, cmdType int) {
 				}
 			}
 			m.tree.SetNodes(nodes)
+			m.currentGetCommand = ""
 			return
 		}
 		if value.GetCommand == "" {
 			m.tree.SetNodes([]etree.Node{})
+			m.currentGetCommand = ""
 			return
 		}
-		m.currentNetNode = C.exec(C.CString(value.GetCommand), C.strlen(C.CString(value.GetCommand)), nil)
-		if m.currentNetNode == nil {
+		netNode := C.exec(C.CString(value.GetCommand), C.strlen(C.CString(value.GetCommand)), nil)
+		if netNode == nil {
 			return
 		}
+
+		// refreshing the same command merges the new tree into the current one, nothing is redrawn
+		// when it did not change and the unchanged subtrees of the displayed tree are reused otherwise
+		var prevTreeNode *etree.Node
+		if m.currentNetNode != nil && m.currentGetCommand == value.GetCommand {
+			changed := C.merge_network_tree(m.currentNetNode, netNode)
+			C.free_network_tree(netNode)
+			if changed == 0 {
+				return
+			}
+			if nodes := m.tree.Nodes(); len(nodes) > 0 {
+				prevTreeNode = &nodes[0]
+			}
+		} else {
+			m.currentNetNode = netNode
+			m.currentGetCommand = value.GetCommand
+		}
+
 		treeNode := make([]etree.Node, 1)
 		m.displayedNetNode = C.clone_network_tree_for_display(m.currentNetNode, nil, 0xffff, false)
-		m.nodesToTree(m.displayedNetNode, &treeNode[0])
+		m.nodesToTree(m.displayedNetNode, &treeNode[0], prevTreeNode)
 		m.tree.SetNodes(treeNode)
 		//str := C.get_network_tree_string(m.displayedNetNode)
 		//C.dump_lib_dbg(str)
 
 	case GETX:
+		m.currentGetCommand = ""
 		if value.GetCommandEx != "" {
 			m.currentNetNode = C.exec(C.CString(value.GetCommandEx), C.strlen(C.CString(value.GetCommandEx)), nil)
 			spew.Fdump(m.dump, value.GetCommandEx)
 			treeNode := make([]etree.Node, 1)
 			m.displayedNetNode = C.clone_network_tree_for_display(m.currentNetNode, nil, 0xffff, false)
-			m.nodesToTree(m.displayedNetNode, &treeNode[0])
+			m.nodesToTree(m.displayedNetNode, &treeNode[0], nil)
 			m.tree.SetNodes(treeNode)
 		} else {
 			switch value.Title {
@@ -875,7 +924,7 @@ func (m *model) execSelectedCommand(cmdStr string, cmdType int) {
 				m.currentNetNode = C.get_reset_tree(C.CString(m.platform))
 				treeNode := make([]etree.Node, 1)
 				m.displayedNetNode = C.clone_network_tree_for_display(m.currentNetNode, nil, 0xffff, false)
-				m.nodesToTree(m.displayedNetNode, &treeNode[0])
+				m.nodesToTree(m.displayedNetNode, &treeNode[0], nil)
 				m.tree.SetNodes(treeNode)
 
 			default:
@@ -994,7 +1043,7 @@ func (m model) Update(msg tea.Msg) (tea.Model, tea.Cmd) {
 				//C.dump_lib_dbg(str)
 
 				treeNode := make([]etree.Node, 1)
-				m.nodesToTree(m.displayedNetNode, &treeNode[0])
+				m.nodesToTree(m.displayedNetNode, &treeNode[0], nil)
 				m.tree.SetNodes(treeNode)
 			}
 
@@ -1014,7 +1063,7 @@ func (m model) Update(msg tea.Msg) (tea.Model, tea.Cmd) {
 				//C.dump_lib_dbg(str)
 
 				treeNode := make([]etree.Node, 1)
-				m.nodesToTree(m.displayedNetNode, &treeNode[0])
+				m.nodesToTree(m.displayedNetNode, &treeNode[0], nil)
 				m.tree.SetNodes(treeNode)
 			}
 
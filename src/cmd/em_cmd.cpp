@@ -115,57 +115,66 @@ void em_cmd_t::copy_frame_event(em_frame_event_t *evt)
 	memcpy(fevt->frame, evt->frame, evt->frame_len);			
 }	
 
-char *em_cmd_t::status_to_string(em_cmd_out_status_t status, char *str)
+const char *em_cmd_t::get_out_status_str(em_cmd_out_status_t status)
 {
-    cJSON *obj, *res = NULL;
-    em_long_string_t status_str;
-    em_subdoc_info_t *info;
-    em_event_t *evt;
-    char *tmp;
-
-    evt = get_event();
-    info = &evt->u.bevt.u.subdoc;
-
-    obj = cJSON_CreateObject();
+    const char *str = "Error_Other";
 
     switch (status) {
         case em_cmd_out_status_success:
-            snprintf(status_str, sizeof(status_str), "%s", "Success");
+            str = "Success";
             break;
 
         case em_cmd_out_status_not_ready:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Not_Ready");
+            str = "Error_Not_Ready";
             break;
 
         case em_cmd_out_status_invalid_input:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Invalid_Input");
+            str = "Error_Invalid_Input";
             break;
 
         case em_cmd_out_status_timeout:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Timeout");
+            str = "Error_Timeout";
             break;
 
         case em_cmd_out_status_invalid_mac:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Invalid_Mac");
+            str = "Error_Invalid_Mac";
             break;
 
         case em_cmd_out_status_interface_down:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Interface_Down");
+            str = "Error_Interface_Down";
             break;
 
         case em_cmd_out_status_other:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Other");
+            str = "Error_Other";
             break;
 
         case em_cmd_out_status_prev_cmd_in_progress:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_Prev_Cmd_In_Progress");
+            str = "Error_Prev_Cmd_In_Progress";
             break;
 
         case em_cmd_out_status_no_change:
-            snprintf(status_str, sizeof(status_str), "%s", "Error_No_Config_Change_Detected");
+            str = "Error_No_Config_Change_Detected";
             break;
     }
 
+    return str;
+}
+
+char *em_cmd_t::status_to_string(em_cmd_out_status_t status, char *str)
+{
+    cJSON *obj, *res = NULL;
+    em_long_string_t status_str;
+    em_subdoc_info_t *info;
+    em_event_t *evt;
+    char *tmp;
+
+    evt = get_event();
+    info = &evt->u.bevt.u.subdoc;
+
+    obj = cJSON_CreateObject();
+
+    snprintf(status_str, sizeof(status_str), "%s", get_out_status_str(status));
+
     cJSON_AddStringToObject(obj, "Status", status_str);
     if (status == em_cmd_out_status_success) {
         res = cJSON_Parse(info->buff);
@@ -457,6 +466,11 @@ void em_cmd_t::init()
             m_svc = em_service_type_ctrl;
             break;
 
+        case em_cmd_type_get_metrics:
+            snprintf(m_name, sizeof(m_name), "%s", "get_metrics");
+            m_svc = em_service_type_ctrl;
+            break;
+
         default:
             break;
 
@@ -499,6 +513,7 @@ const char *em_cmd_t::get_bus_event_type_str(em_bus_event_type_t type)
         BUS_EVENT_TYPE_2S(em_bus_event_type_set_policy)
         BUS_EVENT_TYPE_2S(em_bus_event_type_get_mld_config)
         BUS_EVENT_TYPE_2S(em_bus_event_type_mld_reconfig)
+        BUS_EVENT_TYPE_2S(em_bus_event_type_get_metrics)
        
         default:
            break;
@@ -627,6 +642,7 @@ const char *em_cmd_t::get_cmd_type_str(em_cmd_type_t type)
         CMD_TYPE_2S(em_cmd_type_mld_reconfig)
         CMD_TYPE_2S(em_cmd_type_beacon_report)
         CMD_TYPE_2S(em_cmd_type_ap_metrics_report)
+        CMD_TYPE_2S(em_cmd_type_get_metrics)
 
         default:
            break;
@@ -764,6 +780,10 @@ em_cmd_type_t em_cmd_t::bus_2_cmd_type(em_bus_event_type_t etype)
             type = em_cmd_type_ap_metrics_report;
             break;
 
+        case em_bus_event_type_get_metrics:
+            type = em_cmd_type_get_metrics;
+            break;
+
         default:
             break;
     }
@@ -812,6 +832,10 @@ em_bus_event_type_t em_cmd_t::cmd_2_bus_event_type(em_cmd_type_t ctype)
             type = em_bus_event_type_mld_reconfig;
             break;
 
+        case em_cmd_type_get_metrics:
+            type = em_bus_event_type_get_metrics;
+            break;
+
         default:
             break;
     }
@@ -841,6 +865,7 @@ int em_cmd_t::dump_bus_event(em_bus_event_t *evt)
         case em_bus_event_type_get_bss:
         case em_bus_event_type_get_sta:
         case em_bus_event_type_get_mld_config:
+        case em_bus_event_type_get_metrics:
             info = &evt->u.subdoc;
             printf("Name: %s\n", info->name);
             break;
@@ -855,7 +880,7 @@ int em_cmd_t::dump_bus_event(em_bus_event_t *evt)
 	return 0;
 }   
 
-em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param, dm_easy_mesh_t& dm) : m_evt(NULL)
+em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param, dm_easy_mesh_t& dm) : m_evt(NULL), m_fanout_job(0), m_fanout_index(0)
 {
     m_type = type;
     m_db_cfg_type = db_cfg_type_none;
@@ -864,7 +889,7 @@ em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param, dm_easy_mesh_t& dm
     init();
 }
 
-em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param) : m_evt(NULL)
+em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param) : m_evt(NULL), m_fanout_job(0), m_fanout_index(0)
 {
     m_type = type;
     m_db_cfg_type = db_cfg_type_none;
@@ -872,7 +897,7 @@ em_cmd_t::em_cmd_t(em_cmd_type_t type, em_cmd_params_t param) : m_evt(NULL)
     init();
 }
 
-em_cmd_t::em_cmd_t() : m_evt(NULL)
+em_cmd_t::em_cmd_t() : m_evt(NULL), m_fanout_job(0), m_fanout_index(0)
 {
 	m_evt = static_cast<em_event_t *> (malloc(sizeof(em_event_t) + EM_MAX_EVENT_DATA_LEN));
 }
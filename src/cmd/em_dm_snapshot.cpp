@@ -0,0 +1,354 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "em_dm_snapshot.h"
+
+static_assert(std::atomic<unsigned int>::is_always_lock_free, "slot sequence count must be lock free to be shared");
+static_assert(std::atomic<unsigned long long>::is_always_lock_free, "snapshot epoch must be lock free to be shared");
+
+unsigned long long em_dm_snapshot_t::now_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return static_cast<unsigned long long> (ts.tv_sec) * 1000 + static_cast<unsigned long long> (ts.tv_nsec / 1000000);
+}
+
+unsigned long long em_dm_snapshot_t::hash(const char *data, unsigned int len)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	unsigned int i;
+
+	for (i = 0; i < len; i++) {
+		h = (h ^ static_cast<unsigned char> (data[i])) * 1099511628211ULL;
+	}
+
+	return h;
+}
+
+int em_dm_snapshot_t::map(bool writer)
+{
+	em_dm_snapshot_hdr_t *hdr;
+	struct stat st;
+	int fd;
+
+	if (writer == true) {
+		shm_unlink(m_name);
+		fd = shm_open(m_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+	} else {
+		fd = shm_open(m_name, O_RDONLY, 0);
+	}
+	if (fd < 0) {
+		return -1;
+	}
+
+	if ((writer == true) && (ftruncate(fd, sizeof(em_dm_snapshot_hdr_t)) != 0)) {
+		printf("%s:%d: Could not size the data model snapshot, err:%d\n", __func__, __LINE__, errno);
+		::close(fd);
+		shm_unlink(m_name);
+		return -1;
+	}
+
+	if ((fstat(fd, &st) != 0) || (static_cast<size_t> (st.st_size) < sizeof(em_dm_snapshot_hdr_t))) {
+		::close(fd);
+		return -1;
+	}
+
+	hdr = static_cast<em_dm_snapshot_hdr_t *> (mmap(NULL, sizeof(em_dm_snapshot_hdr_t),
+		(writer == true) ? (PROT_READ | PROT_WRITE):PROT_READ, MAP_SHARED, fd, 0));
+	if (hdr == MAP_FAILED) {
+		::close(fd);
+		return -1;
+	}
+
+	if (writer == true) {
+		// a fresh segment reads as zeros, the header goes last so readers never see it half built
+		hdr->num_slots = EM_DM_SNAPSHOT_MAX_SLOTS;
+		hdr->slot_sz = EM_DM_SNAPSHOT_SLOT_SZ;
+		hdr->version = EM_DM_SNAPSHOT_VERSION;
+		hdr->heartbeat_ms.store(now_ms(), std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		hdr->magic = EM_DM_SNAPSHOT_MAGIC;
+	} else if ((hdr->magic != EM_DM_SNAPSHOT_MAGIC) || (hdr->version != EM_DM_SNAPSHOT_VERSION) ||
+			(hdr->num_slots != EM_DM_SNAPSHOT_MAX_SLOTS) || (hdr->slot_sz != EM_DM_SNAPSHOT_SLOT_SZ)) {
+		munmap(hdr, sizeof(em_dm_snapshot_hdr_t));
+		::close(fd);
+		return -1;
+	}
+
+	// held until close, the writer only probes it, so this waits for a probe at most
+	if ((writer == false) && (flock(fd, LOCK_SH) != 0)) {
+		munmap(hdr, sizeof(em_dm_snapshot_hdr_t));
+		::close(fd);
+		return -1;
+	}
+
+	m_hdr = hdr;
+	m_fd = fd;
+	m_writer = writer;
+
+	return 0;
+}
+
+int em_dm_snapshot_t::create()
+{
+	close();
+
+	if (map(true) != 0) {
+		printf("%s:%d: Could not create the data model snapshot %s, err:%d\n", __func__, __LINE__, m_name, errno);
+		return -1;
+	}
+
+	return 0;
+}
+
+int em_dm_snapshot_t::open()
+{
+	close();
+
+	return map(false);
+}
+
+void em_dm_snapshot_t::close()
+{
+	if (m_hdr == NULL) {
+		return;
+	}
+
+	if (m_writer == true) {
+		// readers still mapping it find it stale right away
+		m_hdr->heartbeat_ms.store(0, std::memory_order_release);
+		shm_unlink(m_name);
+		m_writer = false;
+	}
+	munmap(m_hdr, sizeof(em_dm_snapshot_hdr_t));
+	m_hdr = NULL;
+	::close(m_fd);
+	m_fd = -1;
+}
+
+bool em_dm_snapshot_t::has_readers()
+{
+	if ((m_hdr == NULL) || (m_writer == false)) {
+		return false;
+	}
+
+	// every reader holds a shared lock, the exclusive one is only granted while there is none
+	if (flock(m_fd, LOCK_EX | LOCK_NB) == 0) {
+		flock(m_fd, LOCK_UN);
+		m_stats.unread++;
+		return false;
+	}
+
+	return true;
+}
+
+em_dm_snapshot_slot_t *em_dm_snapshot_t::find_slot(const char *name, const char *key)
+{
+	em_dm_snapshot_slot_t *free_slot = NULL, *slot;
+	unsigned int i;
+
+	for (i = 0; i < EM_DM_SNAPSHOT_MAX_SLOTS; i++) {
+		slot = &m_hdr->slots[i];
+		if (slot->len == 0) {
+			free_slot = (free_slot == NULL) ? slot:free_slot;
+			continue;
+		}
+		if ((strncmp(slot->name, name, sizeof(em_subdoc_name_space_t)) == 0) &&
+				(strncmp(slot->key, key, sizeof(em_long_string_t)) == 0)) {
+			return slot;
+		}
+	}
+
+	return free_slot;
+}
+
+int em_dm_snapshot_t::publish(const char *name, const char *key, const char *data)
+{
+	em_dm_snapshot_slot_t *slot;
+	unsigned long long h;
+	unsigned int len, seq;
+
+	if ((m_hdr == NULL) || (m_writer == false)) {
+		return -1;
+	}
+
+	len = static_cast<unsigned int> (strlen(data)) + 1;
+	if (len > EM_DM_SNAPSHOT_SLOT_SZ) {
+		m_stats.oversized++;
+		return -1;
+	}
+
+	if ((slot = find_slot(name, key)) == NULL) {
+		return -1;
+	}
+
+	h = hash(data, len);
+	if ((slot->len == len) && (slot->hash == h)) {
+		m_stats.unchanged++;
+		return 0;
+	}
+
+	seq = slot->seq.load(std::memory_order_relaxed);
+	slot->seq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	snprintf(slot->name, sizeof(em_subdoc_name_space_t), "%s", name);
+	snprintf(slot->key, sizeof(em_long_string_t), "%s", key);
+	memcpy(slot->data, data, len);
+	slot->len = len;
+	slot->hash = h;
+	slot->epoch = m_hdr->epoch.load(std::memory_order_relaxed) + 1;
+
+	slot->seq.store(seq + 2, std::memory_order_release);
+	m_stats.published++;
+
+	return 1;
+}
+
+void em_dm_snapshot_t::commit(bool changed)
+{
+	if ((m_hdr == NULL) || (m_writer == false)) {
+		return;
+	}
+
+	if (changed == true) {
+		m_hdr->epoch.fetch_add(1, std::memory_order_release);
+	}
+	m_hdr->heartbeat_ms.store(now_ms(), std::memory_order_release);
+}
+
+int em_dm_snapshot_t::read(const char *name, const char *key, char *buff, unsigned int len, unsigned long long *epoch)
+{
+	em_dm_snapshot_slot_t *slot;
+	unsigned int i, retry, seq, slot_len;
+	bool match;
+
+	if (((m_hdr == NULL) || ((now_ms() - m_hdr->heartbeat_ms.load(std::memory_order_acquire)) > EM_DM_SNAPSHOT_STALE_MS)) &&
+			((open() != 0) || ((now_ms() - m_hdr->heartbeat_ms.load(std::memory_order_acquire)) > EM_DM_SNAPSHOT_STALE_MS))) {
+		return -1;
+	}
+
+	for (i = 0; i < EM_DM_SNAPSHOT_MAX_SLOTS; i++) {
+		slot = &m_hdr->slots[i];
+
+		for (retry = 0; retry < EM_DM_SNAPSHOT_MAX_RETRIES; retry++) {
+			if (((seq = slot->seq.load(std::memory_order_acquire)) & 1) != 0) {
+				sched_yield();
+				continue;
+			}
+
+			slot_len = slot->len;
+			match = (slot_len != 0) && (slot_len <= EM_DM_SNAPSHOT_SLOT_SZ) &&
+				(strncmp(slot->name, name, sizeof(em_subdoc_name_space_t)) == 0) &&
+				(strncmp(slot->key, key, sizeof(em_long_string_t)) == 0);
+			if ((match == true) && (slot_len <= len)) {
+				memcpy(buff, slot->data, slot_len);
+				if (epoch != NULL) {
+					*epoch = slot->epoch;
+				}
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot->seq.load(std::memory_order_relaxed) != seq) {
+				continue;
+			}
+
+			if (match == false) {
+				break;
+			}
+			if (slot_len > len) {
+				return -1;
+			}
+			buff[slot_len - 1] = 0;
+
+			return static_cast<int> (slot_len);
+		}
+
+		if (retry == EM_DM_SNAPSHOT_MAX_RETRIES) {
+			return -1;
+		}
+	}
+
+	return -1;
+}
+
+const em_dm_snapshot_stats_t *em_dm_snapshot_t::get_stats()
+{
+	unsigned int i, num = 0;
+
+	if (m_hdr != NULL) {
+		for (i = 0; i < EM_DM_SNAPSHOT_MAX_SLOTS; i++) {
+			num += (m_hdr->slots[i].len != 0) ? 1:0;
+		}
+		m_stats.epoch = m_hdr->epoch.load(std::memory_order_relaxed);
+	}
+	m_stats.num_slots = num;
+
+	return &m_stats;
+}
+
+const em_dm_snapshot_subdoc_t *em_dm_snapshot_t::get_subdoc(unsigned int index)
+{
+	static const unsigned int net = db_cfg_type_network_list_update | db_cfg_type_network_list_delete;
+	static const unsigned int dev = net | db_cfg_type_device_list_update | db_cfg_type_device_list_delete;
+	static const unsigned int radio = dev | db_cfg_type_radio_list_update | db_cfg_type_radio_list_delete;
+	static const unsigned int op_class = db_cfg_type_op_class_list_update | db_cfg_type_op_class_list_delete;
+	static const unsigned int bss = radio | db_cfg_type_bss_list_update | db_cfg_type_bss_list_delete;
+	// the topology tree holds all of the tables
+	static const em_dm_snapshot_subdoc_t subdocs[] = {
+		{"Network", ~0u},
+		{"DeviceList", dev},
+		{"RadioList", bss | op_class | db_cfg_type_radio_cap_list_update | db_cfg_type_radio_cap_list_delete},
+		{"NetworkSSIDList", db_cfg_type_network_ssid_list_update | db_cfg_type_network_ssid_list_delete},
+		{"ChannelList", radio | op_class},
+		{"BSSList", bss},
+		{"STAList", bss | db_cfg_type_sta_list_update | db_cfg_type_sta_list_delete | db_cfg_type_sta_metrics_update},
+		{"Policy", dev | db_cfg_type_policy_list_update | db_cfg_type_policy_list_delete},
+		{"MLDConfig", 0},
+	};
+
+	return (index < sizeof(subdocs)/sizeof(subdocs[0])) ? &subdocs[index]:NULL;
+}
+
+bool em_dm_snapshot_t::is_changed(const em_dm_snapshot_subdoc_t *subdoc, unsigned int changed_cfg)
+{
+	return ((subdoc->cfg & changed_cfg) != 0) || (changed_cfg == ~0u);
+}
+
+em_dm_snapshot_t::em_dm_snapshot_t(const char *name) : m_hdr(NULL), m_fd(-1), m_writer(false), m_stats()
+{
+	snprintf(m_name, sizeof(em_long_string_t), "%s", name);
+	memset(&m_stats, 0, sizeof(em_dm_snapshot_stats_t));
+}
+
+em_dm_snapshot_t::~em_dm_snapshot_t()
+{
+	close();
+}
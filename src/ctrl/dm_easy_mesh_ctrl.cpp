@@ -125,7 +125,9 @@ int dm_easy_mesh_ctrl_t::analyze_sta_assoc_event(em_bus_event_t *evt, em_cmd_t *
     bool radio_matched = false, found;
     em_sta_info_t sta_info;
     em_orch_desc_t desc;
-    em_2xlong_string_t	key;
+    em_sta_key_t	key;
+    em_long_string_t	key_str;
+    em_client_cap_body_t	cap_body;
 
     if (evt == NULL) {
         printf("%s:%d: NULL event\n", __func__, __LINE__);
@@ -181,16 +183,43 @@ int dm_easy_mesh_ctrl_t::analyze_sta_assoc_event(em_bus_event_t *evt, em_cmd_t *
         return -1;
     }
 
+    memset(&sta_info, 0, sizeof(em_sta_info_t));
     memcpy(sta_info.id, params->assoc.cli_mac_address, sizeof(mac_address_t));
     memcpy(sta_info.bssid, params->assoc.bssid, sizeof(mac_address_t));
     memcpy(sta_info.radiomac, pbss->m_bss_info.ruid.mac, sizeof(mac_address_t));
 
+    memcpy(key.sta, sta_info.id, sizeof(mac_address_t));
+    memcpy(key.bssid, sta_info.bssid, sizeof(bssid_t));
+    memcpy(key.ruid, sta_info.radiomac, sizeof(mac_address_t));
+
+    // a roaming STA is answered from its cached capabilities, or waits for the query already sent to the agent
+    if (params->assoc.assoc_event == 1) {
+        switch (m_client_cap_cache.lookup(sta_info.id, params->dev, sta_info.bssid, sta_info.radiomac, &cap_body)) {
+            case em_client_cap_lookup_hit:
+                dm_sta_t::key_to_string(&key, key_str);
+                if ((get_sta(&key) == NULL) && (hash_map_get(pdm->m_sta_assoc_map, key_str) == NULL)) {
+                    sta_info.associated = true;
+                    sta_info.frame_body_len = static_cast<unsigned int> (cap_body->size());
+                    memcpy(sta_info.frame_body, cap_body->data(), cap_body->size());
+                    hash_map_put(pdm->m_sta_assoc_map, strdup(key_str), new dm_sta_t(&sta_info));
+                    pdm->set_db_cfg_param(db_cfg_type_sta_list_update, "");
+                    update_tables(pdm);
+                }
+                return 0;
+
+            case em_client_cap_lookup_pending:
+                return 0;
+
+            default:
+                break;
+        }
+    }
+
     pcmd[num] = new em_cmd_sta_assoc_t(evt->params, dm);
     tmp = pcmd[num];
     num++;
 
-    snprintf(key, sizeof(em_long_string_t), "%s@%s@%s", sta_mac_str, bss_mac_str, radio_mac_str);
-    if ((get_sta(key) != NULL) && (params->assoc.assoc_event == false)){
+    if ((get_sta(&key) != NULL) && (params->assoc.assoc_event == false)){
         desc.op = dm_orch_type_sta_update;
         desc.submit = false;
         pcmd[num - 1]->override_op(0, &desc);
@@ -597,51 +626,93 @@ int dm_easy_mesh_ctrl_t::analyze_dpp_start(em_bus_event_t *evt, em_cmd_t *cmd[])
     return num;
 }
 
-int dm_easy_mesh_ctrl_t::analyze_set_policy(em_bus_event_t *evt, em_cmd_t *pcmd[])
+int dm_easy_mesh_ctrl_t::analyze_set_policy_devices(em_bus_event_t *evt, std::vector<em_fanout_target_t>& devices)
 {
 	int ret;
-	unsigned int num = 0, num_devices = 0;
+	unsigned int num_devices = 0;
 	em_subdoc_info_t *subdoc;
 	dm_easy_mesh_t dm;
+	em_fanout_target_t target;
 	unsigned int i = 0;
-    em_cmd_t *tmp;
-	dm_radio_t *radio;
-	mac_addr_str_t mac_str;
-	
+
 	subdoc = &evt->u.subdoc;
+	devices.clear();
 
 	do {
 		dm.reset();
 
 		if ((ret = dm.decode_config(subdoc, "SetPolicy", i, &num_devices)) < 0) {
-        	return ret;
-    	}
-			
-		dm_easy_mesh_t::macbytes_to_string(dm.m_device.m_device_info.intf.mac, mac_str);
-		//printf("%s:%d: Network: %s\tDevice MAC: %s\n", __func__, __LINE__, dm.m_network.m_net_info.id, mac_str);
-
-		radio = m_data_model_list.get_first_radio(dm.m_network.m_net_info.id, dm.m_device.m_device_info.intf.mac);
-		while (radio != NULL) {
-			memcpy(dm.m_radio[dm.m_num_radios].m_radio_info.intf.mac, radio->m_radio_info.intf.mac, sizeof(mac_address_t));
-			dm.m_num_radios++;
-			radio = m_data_model_list.get_next_radio(dm.m_network.m_net_info.id, dm.m_device.m_device_info.intf.mac, radio);
+			return ret;
 		}
 
-   		pcmd[num] = new em_cmd_set_policy_t(evt->params, dm);
-   		tmp = pcmd[num];
-   		num++;
-
-   		while ((pcmd[num] = tmp->clone_for_next()) != NULL) {
-       		tmp = pcmd[num];
-       		num++;
-   		}
+		memcpy(target.mac, dm.m_device.m_device_info.intf.mac, sizeof(mac_address_t));
+		target.state = em_fanout_target_queued;
+		devices.push_back(target);
 
 		i++;
 	} while (i < num_devices);
 
+	return static_cast<int> (devices.size());
+}
+
+int dm_easy_mesh_ctrl_t::analyze_set_policy(em_bus_event_t *evt, unsigned int index, em_cmd_t *pcmd[])
+{
+	int ret;
+	unsigned int num = 0, num_devices = 0;
+	em_subdoc_info_t *subdoc;
+	dm_easy_mesh_t dm;
+    em_cmd_t *tmp;
+	dm_radio_t *radio;
+	mac_addr_str_t mac_str;
+	
+	subdoc = &evt->u.subdoc;
+
+	if ((ret = dm.decode_config(subdoc, "SetPolicy", index, &num_devices)) < 0) {
+       	return ret;
+   	}
+			
+	dm_easy_mesh_t::macbytes_to_string(dm.m_device.m_device_info.intf.mac, mac_str);
+	//printf("%s:%d: Network: %s\tDevice MAC: %s\n", __func__, __LINE__, dm.m_network.m_net_info.id, mac_str);
+
+	radio = m_data_model_list.get_first_radio(dm.m_network.m_net_info.id, dm.m_device.m_device_info.intf.mac);
+	while (radio != NULL) {
+		memcpy(dm.m_radio[dm.m_num_radios].m_radio_info.intf.mac, radio->m_radio_info.intf.mac, sizeof(mac_address_t));
+		dm.m_num_radios++;
+		radio = m_data_model_list.get_next_radio(dm.m_network.m_net_info.id, dm.m_device.m_device_info.intf.mac, radio);
+	}
+
+   	pcmd[num] = new em_cmd_set_policy_t(evt->params, dm);
+   	tmp = pcmd[num];
+   	num++;
+
+   	while ((pcmd[num] = tmp->clone_for_next()) != NULL) {
+       	tmp = pcmd[num];
+       	num++;
+   	}
+
 	return static_cast<int> (num);
 }
 
+int dm_easy_mesh_ctrl_t::analyze_policy_retry(dm_easy_mesh_t *dm, em_cmd_t *pcmd[])
+{
+    em_cmd_params_t param;
+    int num = 0;
+    em_cmd_t *tmp;
+
+    memset(&param, 0, sizeof(em_cmd_params_t));
+
+    pcmd[num] = new em_cmd_set_policy_t(param, *dm);
+    tmp = pcmd[num];
+    num++;
+
+    while ((pcmd[num] = tmp->clone_for_next()) != NULL) {
+        tmp = pcmd[num];
+        num++;
+    }
+
+    return num;
+}
+
 int dm_easy_mesh_ctrl_t::analyze_scan_channel(em_bus_event_t *evt, em_cmd_t *pcmd[])
 {
     int ret;
@@ -754,6 +825,78 @@ int dm_easy_mesh_ctrl_t::analyze_set_channel(em_bus_event_t *evt, em_cmd_t *pcmd
 	return static_cast<int> (num);
 }
 
+int dm_easy_mesh_ctrl_t::analyze_channel_plan(const em_chan_plan_move_t *moves, unsigned int num_moves, em_cmd_t *pcmd[])
+{
+	em_cmd_params_t params;
+	dm_easy_mesh_t dm, *pdm;
+	em_op_class_info_t *info;
+	em_cmd_t *tmp;
+	mac_addr_str_t ruid_str;
+	unsigned int num = 0, i, j;
+
+	memset(&params, 0, sizeof(em_cmd_params_t));
+
+	for (i = 0; (i < num_moves) && (params.u.args.num_args < EM_CLI_MAX_ARGS); i++) {
+		pdm = m_data_model_list.get_first_dm();
+		while ((pdm != NULL) && (memcmp(pdm->get_device_info()->intf.mac, moves[i].al_mac, sizeof(mac_address_t)) != 0)) {
+			pdm = m_data_model_list.get_next_dm(pdm);
+		}
+		if (pdm == NULL) {
+			continue;
+		}
+
+		// one anticipated entry per band, the Channel Selection Request carries the ones of every band
+		for (j = 0; j < pdm->get_num_op_class(); j++) {
+			info = &pdm->m_op_class[j].m_op_class_info;
+			if ((info->id.type == em_op_class_type_anticipated) &&
+					(memcmp(info->id.ruid, moves[i].al_mac, sizeof(mac_address_t)) == 0) &&
+					(em_channel_planner_t::get_op_class_grid(info->op_class) == em_channel_planner_t::get_op_class_grid(moves[i].op_class))) {
+				break;
+			}
+		}
+		if (j == pdm->get_num_op_class()) {
+			if (j >= EM_MAX_OPCLASS) {
+				continue;
+			}
+			memset(&pdm->m_op_class[j].m_op_class_info, 0, sizeof(em_op_class_info_t));
+			pdm->set_num_op_class(j + 1);
+		}
+
+		info = &pdm->m_op_class[j].m_op_class_info;
+		info->id.type = em_op_class_type_anticipated;
+		memcpy(info->id.ruid, moves[i].al_mac, sizeof(mac_address_t));
+		info->id.op_class = moves[i].op_class;
+		info->op_class = moves[i].op_class;
+		info->channel = moves[i].channel;
+		info->num_channels = 1;
+		info->channels[0] = moves[i].channel;
+		dm.set_channels_list(&pdm->m_op_class[j], 1);
+		pdm->set_db_cfg_param(db_cfg_type_op_class_list_update, "");
+
+		dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *> (moves[i].ruid), ruid_str);
+		snprintf(params.u.args.args[params.u.args.num_args], sizeof(em_long_string_t), "%s", ruid_str);
+		params.u.args.num_args++;
+
+		printf("%s:%d: Channel plan: radio %s op class %u channel %u -> op class %u channel %u gain %lld\n", __func__, __LINE__,
+			ruid_str, moves[i].prev_op_class, moves[i].prev_channel, moves[i].op_class, moves[i].channel, moves[i].gain);
+	}
+
+	if (params.u.args.num_args == 0) {
+		return 0;
+	}
+
+	pcmd[num] = new em_cmd_set_channel_t(params, dm);
+	tmp = pcmd[num];
+	num++;
+
+	while ((pcmd[num] = tmp->clone_for_next()) != NULL) {
+		tmp = pcmd[num];
+		num++;
+	}
+
+	return static_cast<int> (num);
+}
+
 int dm_easy_mesh_ctrl_t::analyze_set_radio(em_bus_event_t *evt, em_cmd_t *pcmd[])
 {
     int ret;
@@ -1484,12 +1627,18 @@ dm_easy_mesh_t *dm_easy_mesh_ctrl_t::create_data_model(const char *net_id, const
 void dm_easy_mesh_ctrl_t::handle_dirty_dm()
 {
     dm_easy_mesh_t *dm;
+    unsigned int unsaved;
 
     dm = m_data_model_list.get_first_dm();
     while (dm != NULL) {
 		if (dm->db_cfg_type_is_set()) {
 	    	set_config(dm);		
 		}
+		// changes that only live in memory still move the generation
+		if ((unsaved = dm->take_unsaved_cfg_type()) != 0) {
+			m_changed_cfg |= unsaved;
+			m_update_gen++;
+		}
 		dm = m_data_model_list.get_next_dm(dm);
     }
 }
@@ -1516,6 +1665,7 @@ void dm_easy_mesh_ctrl_t::init_tables()
     dm_sta_list_t::init();
     dm_policy_list_t::init();
     dm_scan_result_list_t::init();
+    m_metrics_rollup.init();
 }
 
 int dm_easy_mesh_ctrl_t::load_net_ssid_table()
@@ -1547,6 +1697,9 @@ int dm_easy_mesh_ctrl_t::load_tables()
 		type = db_cfg_type_scan_result_list_update;
     }
 
+	// rollup history is not part of the configuration, a failure here does not mark anything dirty
+	m_metrics_rollup.load_table(m_db_client);
+
 	if (type != db_cfg_type_none) {
 		return type;
 	}
@@ -1582,6 +1735,9 @@ int dm_easy_mesh_ctrl_t::update_tables(dm_easy_mesh_t *dm)
 
     //printf("%s:%d: Database Config Bitmask: 0x%08x\n", __func__, __LINE__, dm->get_db_cfg_type());
 
+    m_changed_cfg |= dm->m_db_cfg_param.db_cfg_type;
+    m_update_gen++;
+
     if (dm->db_cfg_type_is_set(db_cfg_type_network_list_update)) {
 		criteria = dm->db_cfg_type_get_criteria(db_cfg_type_network_list_update);
         if (dm_network_list_t::set_config(m_db_client, dm->get_network_by_ref(), global_netid) == 0) {
@@ -1901,6 +2057,8 @@ void dm_easy_mesh_ctrl_t::update_network_topology()
         if (dm->get_colocated() == false) {
             if (m_topology->find_topology(dm) == NULL) {
                 m_topology->add(dm);
+                m_changed_cfg |= db_cfg_type_network_list_update;
+                m_update_gen++;
             }
         }
         dm = get_next_dm(dm);
@@ -1961,6 +2119,8 @@ int dm_easy_mesh_ctrl_t::init(const char *data_model_path, em_mgr_t *mgr)
 dm_easy_mesh_ctrl_t::dm_easy_mesh_ctrl_t()
 {
     m_initialized = false;
+    m_update_gen = 0;
+    m_changed_cfg = 0;
 }
 
 dm_easy_mesh_ctrl_t::~dm_easy_mesh_ctrl_t()
@@ -152,6 +152,44 @@ int em_cmd_ctrl_t::send_result(em_cmd_out_status_t status)
     return 0;
 }
 
+int em_cmd_ctrl_t::hold_result()
+{
+    int sock = m_dsock;
+
+    m_dsock = -1;
+
+    return sock;
+}
+
+int em_cmd_ctrl_t::send_result(int sock, em_cmd_out_status_t status, const char *result)
+{
+    cJSON *obj, *res;
+    char *str;
+    int ret = 0;
+
+    if (sock < 0) {
+        return -1;
+    }
+
+    obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(obj, "Status", em_cmd_t::get_out_status_str(status));
+    if ((result != NULL) && ((res = cJSON_Parse(result)) != NULL)) {
+        cJSON_AddItemToObject(obj, "Result", res);
+    }
+
+    str = cJSON_Print(obj);
+    if (send(sock, str, strlen(str) + 1, 0) <= 0) {
+        printf("%s:%d: write error on socket, err:%d\n", __func__, __LINE__, errno);
+        ret = -1;
+    }
+
+    close(sock);
+    cJSON_free(str);
+    cJSON_Delete(obj);
+
+    return ret;
+}
+
 
 em_cmd_ctrl_t::em_cmd_ctrl_t()
 {
@@ -36,6 +36,9 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <algorithm>
+#include <map>
+#include <vector>
 #include <cjson/cJSON.h>
 #include "em.h"
 #include "em_msg.h"
@@ -178,17 +181,31 @@ void em_ctrl_t::handle_scan_channel_list(em_bus_event_t *evt)
 
 void em_ctrl_t::handle_set_policy(em_bus_event_t *evt)
 {
-    em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
+    std::vector<em_fanout_target_t> targets;
+    em_fanout_payload_t payload;
+    unsigned int off, len, job;
     int num;
 
-    if (m_orch->is_cmd_type_in_progress(evt) == true) {
+    if ((m_fanout.is_in_progress(em_cmd_type_set_policy) == true) || (m_orch->is_cmd_type_in_progress(evt) == true)) {
         m_ctrl_cmd->send_result(em_cmd_out_status_prev_cmd_in_progress);
-    } else if ((num = m_data_model.analyze_set_policy(evt, pcmd)) == 0) {
+    } else if ((num = m_data_model.analyze_set_policy_devices(evt, targets)) < 0) {
+        m_ctrl_cmd->send_result(em_cmd_out_status_invalid_input);
+    } else if (num == 0) {
         m_ctrl_cmd->send_result(em_cmd_out_status_no_change);
-    } else if (m_orch->submit_commands(pcmd, static_cast<unsigned int> (num)) > 0) {
-        m_ctrl_cmd->send_result(em_cmd_out_status_success);
     } else {
-        m_ctrl_cmd->send_result(em_cmd_out_status_not_ready);
+        // the per device commands are built from one copy of the event as the job dispatches them
+        off = static_cast<unsigned int> (reinterpret_cast<unsigned char *> (evt->u.subdoc.buff) - reinterpret_cast<unsigned char *> (evt));
+        len = off + static_cast<unsigned int> (strnlen(evt->u.subdoc.buff, EM_MAX_EVENT_DATA_LEN - 1)) + 1;
+        payload = std::make_shared<std::vector<unsigned char>>((len > sizeof(em_bus_event_t)) ? len:sizeof(em_bus_event_t), 0);
+        memcpy(payload->data(), evt, len);
+
+        if ((job = m_fanout.start(em_cmd_type_set_policy, targets, payload)) != 0) {
+            // the reply waits for the outcome of every device
+            m_fanout_replies[job] = m_ctrl_cmd->hold_result();
+            dispatch_fanout();
+        } else {
+            m_ctrl_cmd->send_result(em_cmd_out_status_not_ready);
+        }
     } 
 
 }
@@ -331,6 +348,54 @@ void em_ctrl_t::handle_get_dm_data(em_bus_event_t *evt)
     m_ctrl_cmd->send_result(em_cmd_out_status_success);
 }        
 
+void em_ctrl_t::handle_get_metrics(em_bus_event_t *evt)
+{
+    em_cmd_params_t *params = &evt->params;
+    mac_address_t mac;
+    unsigned int resolution = 60;
+    bool all;
+    char *pos, *tmp;
+    cJSON *parent;
+    int len;
+
+    if (params->u.args.num_args < 3) {
+        m_ctrl_cmd->send_result(em_cmd_out_status_invalid_input);
+        return;
+    }
+
+    if ((pos = strchr(evt->u.subdoc.name, '@')) != NULL) {
+        resolution = static_cast<unsigned int> (atoi(pos + 1));
+    }
+
+    all = (strncmp(params->u.args.args[2], "all", strlen("all")) == 0);
+    if ((all == false) && (strlen(params->u.args.args[2]) != (sizeof(mac_addr_str_t) - 1))) {
+        m_ctrl_cmd->send_result(em_cmd_out_status_invalid_input);
+        return;
+    }
+
+    if (all == false) {
+        dm_easy_mesh_t::string_to_macbytes(params->u.args.args[2], mac);
+    }
+
+    parent = cJSON_CreateObject();
+    m_metrics_store.encode(parent, (all == true) ? NULL:mac, resolution);
+    tmp = cJSON_Print(parent);
+    len = snprintf(evt->u.subdoc.buff, EM_MAX_EVENT_DATA_LEN, "%s", tmp);
+    cJSON_free(tmp);
+    cJSON_Delete(parent);
+
+    // a truncated document would not parse, the caller asks for one station or a coarser resolution instead
+    if (len >= EM_MAX_EVENT_DATA_LEN) {
+        printf("%s:%d: metrics of %s do not fit in a reply\n", __func__, __LINE__, params->u.args.args[2]);
+        m_ctrl_cmd->send_result(em_cmd_out_status_other);
+        return;
+    }
+
+	evt->data_len = static_cast<unsigned int> (strlen(evt->u.subdoc.buff)) + 1;
+    m_ctrl_cmd->copy_bus_event(evt);
+    m_ctrl_cmd->send_result(em_cmd_out_status_success);
+}
+
 void em_ctrl_t::handle_reset(em_bus_event_t *evt)
 {
     em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
@@ -389,9 +454,439 @@ void em_ctrl_t::handle_dirty_dm()
 	m_data_model.handle_dirty_dm();
 }
 
+void em_ctrl_t::sync_sta_metrics()
+{
+	em_t *em;
+	dm_easy_mesh_t *dm;
+	dm_sta_t *sta;
+	em_sta_metrics_sample_t sample;
+	std::map<dm_easy_mesh_t *, std::vector<const unsigned char *> > radios;
+	unsigned int i;
+
+	m_sta_metrics.begin_sync();
+
+	// the radio ems of an agent share its data model, collect the configured radios per data model
+	em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+	while (em != NULL) {
+		if ((em->is_al_interface_em() == false) && (em->get_state() == em_state_ctrl_configured)) {
+			radios[em->get_data_model()].push_back(em->get_radio_interface_mac());
+		}
+		em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+	}
+
+	// one pass over the STAs of each data model, each STA goes to the radio it is associated on
+	for (auto& it : radios) {
+		dm = it.first;
+		sta = static_cast<dm_sta_t *> (hash_map_get_first(dm->m_sta_map));
+		while (sta != NULL) {
+			if (sta->m_sta_info.associated == true) {
+				for (i = 0; i < it.second.size(); i++) {
+					if (memcmp(sta->m_sta_info.radiomac, it.second[i], sizeof(mac_address_t)) == 0) {
+						break;
+					}
+				}
+				if (i < it.second.size()) {
+					memcpy(sample.sta, sta->m_sta_info.id, sizeof(mac_address_t));
+					memcpy(sample.bssid, sta->m_sta_info.bssid, sizeof(mac_address_t));
+					memcpy(sample.ruid, sta->m_sta_info.radiomac, sizeof(mac_address_t));
+					sample.rcpi = sta->m_sta_info.rcpi;
+					sample.bytes = sta->m_sta_info.bytes_tx + sta->m_sta_info.bytes_rx;
+					sample.util = sta->m_sta_info.util_tx + sta->m_sta_info.util_rx;
+					m_sta_metrics.observe(&sample);
+				}
+			}
+			sta = static_cast<dm_sta_t *> (hash_map_get_next(dm->m_sta_map, sta));
+		}
+	}
+
+	m_sta_metrics.end_sync();
+}
+
+int em_ctrl_t::send_sta_metrics_queries(const unsigned char *ruid, mac_address_t *stas, unsigned int num)
+{
+	mac_addr_str_t mac_str;
+	em_t *em;
+	unsigned int i;
+	int ret = 0;
+
+	dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *> (ruid), mac_str);
+	if (((em = static_cast<em_t *> (hash_map_get(m_em_map, mac_str))) == NULL) ||
+			(em->get_state() != em_state_ctrl_configured)) {
+		return -1;
+	}
+
+	for (i = 0; i < num; i++) {
+		if (em->send_sta_link_metrics_query(stas[i]) < 0) {
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+void em_ctrl_t::sync_channel_planner()
+{
+	em_t *em;
+	dm_easy_mesh_t *dm;
+	em_op_class_info_t *info;
+	const em_op_class_info_t *op_classes[EM_MAX_OPCLASS];
+	unsigned char *ruid, *al_mac;
+	unsigned int i, num;
+
+	m_channel_planner.begin_sync();
+
+	em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+	while (em != NULL) {
+		if ((em->is_al_interface_em() == true) || (em->get_state() != em_state_ctrl_configured)) {
+			em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+			continue;
+		}
+
+		dm = em->get_data_model();
+		ruid = em->get_radio_interface_mac();
+		al_mac = dm->get_agent_al_interface_mac();
+
+		// capability and current entries are per radio, the preference ones per agent
+		num = 0;
+		for (i = 0; (i < dm->get_num_op_class()) && (i < EM_MAX_OPCLASS); i++) {
+			info = dm->get_op_class_info(i);
+			if ((((info->id.type == em_op_class_type_capability) || (info->id.type == em_op_class_type_current)) &&
+					(memcmp(info->id.ruid, ruid, sizeof(mac_address_t)) == 0)) ||
+					((info->id.type == em_op_class_type_preference) && (memcmp(info->id.ruid, al_mac, sizeof(mac_address_t)) == 0))) {
+				op_classes[num++] = info;
+			}
+		}
+		m_channel_planner.observe_radio(ruid, al_mac, op_classes, num);
+
+		for (i = 0; i < dm->get_num_bss(); i++) {
+			if (memcmp(dm->get_bss(i)->m_bss_info.ruid.mac, ruid, sizeof(mac_address_t)) == 0) {
+				m_channel_planner.observe_bss(dm->get_bss(i)->m_bss_info.bssid.mac, ruid);
+			}
+		}
+
+		em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+	}
+
+	m_channel_planner.end_sync();
+}
+
+int em_ctrl_t::apply_channel_plan(const em_chan_plan_move_t *moves, unsigned int num)
+{
+	em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
+	int num_cmds;
+
+	if ((num_cmds = m_data_model.analyze_channel_plan(moves, num, pcmd)) <= 0) {
+		return -1;
+	}
+
+	return (m_orch->submit_commands(pcmd, static_cast<unsigned int> (num_cmds)) > 0) ? 0:-1;
+}
+
+void em_ctrl_t::sync_steer_engine()
+{
+	em_t *em;
+	dm_easy_mesh_t *dm;
+	dm_sta_t *sta;
+	em_op_class_info_t *info;
+	unsigned char *ruid;
+	unsigned int i, op_class, channel;
+
+	m_steer_engine.begin_sync();
+
+	em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+	while (em != NULL) {
+		if ((em->is_al_interface_em() == true) || (em->get_state() != em_state_ctrl_configured)) {
+			em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+			continue;
+		}
+
+		dm = em->get_data_model();
+		ruid = em->get_radio_interface_mac();
+
+		op_class = channel = 0;
+		for (i = 0; i < dm->get_num_op_class(); i++) {
+			info = dm->get_op_class_info(i);
+			if ((info->id.type == em_op_class_type_current) && (memcmp(info->id.ruid, ruid, sizeof(mac_address_t)) == 0)) {
+				op_class = info->op_class;
+				channel = info->channel;
+				break;
+			}
+		}
+
+		for (i = 0; i < dm->get_num_bss(); i++) {
+			if (memcmp(dm->get_bss(i)->m_bss_info.ruid.mac, ruid, sizeof(mac_address_t)) == 0) {
+				m_steer_engine.observe_bss(dm->get_bss(i)->m_bss_info.bssid.mac, ruid, op_class, channel);
+			}
+		}
+
+		for (i = 0; i < dm->get_num_policy(); i++) {
+			m_steer_engine.observe_policy(&dm->get_policy(i)->m_policy);
+		}
+
+		sta = static_cast<dm_sta_t *> (hash_map_get_first(dm->m_sta_map));
+		while (sta != NULL) {
+			if ((sta->m_sta_info.associated == true) &&
+					(memcmp(sta->m_sta_info.radiomac, ruid, sizeof(mac_address_t)) == 0)) {
+				m_steer_engine.observe_sta(sta->m_sta_info.id, sta->m_sta_info.bssid);
+			}
+			sta = static_cast<dm_sta_t *> (hash_map_get_next(dm->m_sta_map, sta));
+		}
+
+		em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+	}
+
+	m_steer_engine.end_sync();
+}
+
+int em_ctrl_t::apply_steer_request(const em_steer_req_params_t *req)
+{
+	em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
+	em_cmd_steer_params_t params;
+	mac_addr_str_t sta_str, target_str;
+	int num;
+
+	memset(&params, 0, sizeof(em_cmd_steer_params_t));
+	memcpy(params.sta_mac, req->sta, sizeof(mac_address_t));
+	memcpy(params.source, req->source, sizeof(bssid_t));
+	memcpy(params.target, req->target, sizeof(bssid_t));
+	params.request_mode = 1;	// steering mandate
+	params.btm_abridged = true;
+	params.target_op_class = req->target_op_class;
+	params.target_channel = req->target_channel;
+
+	if ((num = m_data_model.analyze_sta_steer(params, pcmd)) <= 0) {
+		return -1;
+	}
+
+	dm_easy_mesh_t::macbytes_to_string(params.sta_mac, sta_str);
+	dm_easy_mesh_t::macbytes_to_string(params.target, target_str);
+	printf("%s:%d: Steering sta %s to %s gain %d\n", __func__, __LINE__, sta_str, target_str, req->gain);
+
+	return (m_orch->submit_commands(pcmd, static_cast<unsigned int> (num)) > 0) ? 0:-1;
+}
+
+void em_ctrl_t::retry_policy_requests()
+{
+	em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
+	std::vector<dm_easy_mesh_t *> agents;
+	em_t *em;
+	dm_easy_mesh_t *dm;
+	int num;
+
+	// a policy push on its way sends the overdue TLVs as well
+	if ((m_fanout.is_in_progress(em_cmd_type_set_policy) == true) || (m_orch->is_cmd_type_in_progress(em_cmd_type_set_policy) == true)) {
+		return;
+	}
+
+	em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+	while (em != NULL) {
+		if ((em->is_al_interface_em() == false) && (em->get_state() == em_state_ctrl_configured) &&
+				((dm = em->get_data_model()) != NULL) && (std::find(agents.begin(), agents.end(), dm) == agents.end()) &&
+				(m_policy_sync.is_overdue(dm->get_agent_al_interface_mac(), em->get_radio_interface_mac()) == true)) {
+			agents.push_back(dm);
+		}
+		em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+	}
+
+	for (auto agent : agents) {
+		if ((num = m_data_model.analyze_policy_retry(agent, pcmd)) > 0) {
+			m_orch->submit_commands(pcmd, static_cast<unsigned int> (num));
+		}
+	}
+}
+
+void em_ctrl_t::dispatch_fanout()
+{
+	em_fanout_dispatch_t dispatch;
+	em_cmd_t *pcmd[EM_MAX_CMD] = {NULL};
+	em_bus_event_t *evt;
+	mac_addr_str_t mac_str;
+	int num, i;
+
+	while (m_fanout.next(&dispatch) == true) {
+		evt = reinterpret_cast<em_bus_event_t *> (dispatch.payload->data());
+
+		switch (dispatch.type) {
+			case em_cmd_type_set_policy:
+				num = m_data_model.analyze_set_policy(evt, dispatch.index, pcmd);
+				break;
+
+			default:
+				num = 0;
+				break;
+		}
+
+		for (i = 0; i < num; i++) {
+			pcmd[i]->m_fanout_job = dispatch.job;
+			pcmd[i]->m_fanout_index = dispatch.index;
+		}
+
+		if ((num <= 0) || (m_orch->submit_commands(pcmd, static_cast<unsigned int> (num)) == 0)) {
+			dm_easy_mesh_t::macbytes_to_string(dispatch.mac, mac_str);
+			printf("%s:%d: Fan-out %u: %s for %s not submitted\n", __func__, __LINE__, dispatch.job,
+				em_cmd_t::get_cmd_type_str(dispatch.type), mac_str);
+			m_fanout.complete(dispatch.job, dispatch.index, em_fanout_target_failed);
+		}
+	}
+}
+
+void em_ctrl_t::expire_fanout()
+{
+	std::vector<em_fanout_result_t> done;
+	std::vector<em_fanout_target_t> targets;
+	std::map<unsigned int, int>::iterator reply;
+	cJSON *obj, *list, *dev;
+	mac_addr_str_t mac_str;
+	char *str;
+
+	if (m_fanout.expire(&done) == 0) {
+		return;
+	}
+
+	for (auto& result : done) {
+		printf("%s:%d: Fan-out %u: %s targets: %u succeeded: %u failed: %u timed out: %u in %u s\n", __func__, __LINE__,
+			result.job, em_cmd_t::get_cmd_type_str(result.type), result.num_targets, result.succeeded, result.failed,
+			result.timed_out, result.elapsed_s);
+
+		if ((reply = m_fanout_replies.find(result.job)) == m_fanout_replies.end()) {
+			continue;
+		}
+
+		obj = cJSON_CreateObject();
+		cJSON_AddNumberToObject(obj, "Targets", result.num_targets);
+		cJSON_AddNumberToObject(obj, "Succeeded", result.succeeded);
+		cJSON_AddNumberToObject(obj, "Failed", result.failed);
+		cJSON_AddNumberToObject(obj, "TimedOut", result.timed_out);
+		cJSON_AddNumberToObject(obj, "Elapsed", result.elapsed_s);
+		list = cJSON_CreateArray();
+		cJSON_AddItemToObject(obj, "DeviceList", list);
+
+		targets.clear();
+		m_fanout.get_targets(result.job, &targets);
+		for (auto& t : targets) {
+			dm_easy_mesh_t::macbytes_to_string(t.mac, mac_str);
+			dev = cJSON_CreateObject();
+			cJSON_AddStringToObject(dev, "ID", mac_str);
+			cJSON_AddStringToObject(dev, "Status", em_cmd_t::get_out_status_str((t.state == em_fanout_target_succeeded) ?
+				em_cmd_out_status_success:(t.state == em_fanout_target_timed_out) ? em_cmd_out_status_timeout:em_cmd_out_status_other));
+			cJSON_AddItemToArray(list, dev);
+		}
+
+		str = cJSON_PrintUnformatted(obj);
+		em_cmd_ctrl_t::send_result(reply->second, (result.succeeded == result.num_targets) ? em_cmd_out_status_success:
+			(result.timed_out > 0) ? em_cmd_out_status_timeout:em_cmd_out_status_other, str);
+		cJSON_free(str);
+		cJSON_Delete(obj);
+		m_fanout_replies.erase(reply);
+	}
+}
+
+void em_ctrl_t::probe_topology()
+{
+	std::vector<em_disc_probe_t> probe, lost;
+	mac_addr_str_t mac_str;
+	em_t *em;
+	dm_easy_mesh_t *dm;
+	unsigned long long now = em_disc_sched_t::now_ms();
+
+	em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+	while (em != NULL) {
+		if ((em->is_al_interface_em() == false) && (em->get_state() == em_state_ctrl_configured) &&
+				((dm = em->get_data_model()) != NULL)) {
+			m_disc_sched.observe(dm->get_agent_al_interface_mac(), now);
+		}
+		em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+	}
+	m_disc_sched.sweep();
+
+	if (m_disc_sched.run(now, &probe, &lost) == 0) {
+		return;
+	}
+
+	// one radio of the agent carries the query, the response describes the whole device
+	for (auto& p : probe) {
+		em = static_cast<em_t *> (hash_map_get_first(m_em_map));
+		while (em != NULL) {
+			if ((em->is_al_interface_em() == false) && (em->get_state() == em_state_ctrl_configured) &&
+					((dm = em->get_data_model()) != NULL) &&
+					(memcmp(dm->get_agent_al_interface_mac(), p.al, sizeof(mac_address_t)) == 0)) {
+				em->send_topology_query_msg();
+				break;
+			}
+			em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
+		}
+	}
+
+	for (auto& l : lost) {
+		dm_easy_mesh_t::macbytes_to_string(l.al, mac_str);
+		printf("%s:%d: Topology: agent %s lost, %u probes unanswered\n", __func__, __LINE__, mac_str, l.missed);
+	}
+}
+
+void em_ctrl_t::publish_dm_snapshot()
+{
+	const em_dm_snapshot_subdoc_t *desc;
+	em_subdoc_info_t *subdoc;
+	em_long_string_t net_id;
+	unsigned int i;
+	bool changed = false;
+
+	if ((m_dm_snapshot.is_open() == false) || (is_data_model_initialized() == false) ||
+			(is_network_topology_initialized() == false)) {
+		return;
+	}
+
+	// changes made while nobody reads are kept, the first reader falls back to the socket until the next pass
+	m_dm_snapshot_pending |= m_data_model.take_changed_cfg();
+	if (m_dm_snapshot.has_readers() == false) {
+		return;
+	}
+
+	if (m_dm_snapshot_pending == 0) {
+		m_dm_snapshot.commit(false);
+		return;
+	}
+
+	if ((subdoc = static_cast<em_subdoc_info_t *> (malloc(sizeof(em_subdoc_info_t) + EM_MAX_EVENT_DATA_LEN))) == NULL) {
+		return;
+	}
+
+	snprintf(net_id, sizeof(em_long_string_t), "%s", global_netid);
+	for (i = 0; (desc = em_dm_snapshot_t::get_subdoc(i)) != NULL; i++) {
+		if (em_dm_snapshot_t::is_changed(desc, m_dm_snapshot_pending) == false) {
+			continue;
+		}
+		snprintf(subdoc->name, sizeof(em_subdoc_name_space_t), "%s", desc->name);
+		subdoc->buff[0] = 0;
+		m_data_model.get_config(net_id, subdoc);
+		if (m_dm_snapshot.publish(desc->name, net_id, subdoc->buff) > 0) {
+			changed = true;
+		}
+	}
+	free(subdoc);
+	m_dm_snapshot_pending = 0;
+
+	m_dm_snapshot.commit(changed);
+}
+
 void em_ctrl_t::handle_5s_tick()
 {
-	//handle_client_metrics_req();
+	const em_chan_plan_stats_t *stats;
+
+	sync_channel_planner();
+	m_channel_planner.run();
+
+	if (++m_channel_plan_log_ticks < 60) {
+		return;
+	}
+	m_channel_plan_log_ticks = 0;
+
+	stats = m_channel_planner.get_stats();
+	if (stats->num_radios > 0) {
+		printf("%s:%d: Channel plan: radios: %u planned: %u edges: %u scans: %u scored: %llu moves: %llu held: %llu\n",
+			__func__, __LINE__, stats->num_radios, stats->num_planned, stats->num_edges, stats->num_scans,
+			stats->scored, stats->moves, stats->held);
+	}
 }
 
 void em_ctrl_t::handle_2s_tick()
@@ -401,12 +896,75 @@ void em_ctrl_t::handle_2s_tick()
 
 void em_ctrl_t::handle_1s_tick()
 {
+	const em_sta_metrics_stats_t *stats;
+	const em_steer_stats_t *steer_stats;
+	const em_client_cap_stats_t *cap_stats;
+	const em_policy_sync_stats_t *policy_stats;
+	const em_disc_stats_t *disc_stats;
+	const em_dm_snapshot_stats_t *snapshot_stats;
+
+	sync_sta_metrics();
+	m_metrics_store.flush();
+	sync_steer_engine();
+	m_steer_engine.run();
+	retry_policy_requests();
+	expire_fanout();
+	probe_topology();
+
+	if (++m_sta_metrics_log_ticks < 60) {
+		return;
+	}
+	m_sta_metrics_log_ticks = 0;
+
+	stats = m_sta_metrics.get_stats();
+	if (stats->num_stas > 0) {
+		printf("%s:%d: STA link metrics: stas: %u coverage: %.2f rate: %.1f/s interval: %u-%u ms deferred: %llu errors: %llu\n",
+			__func__, __LINE__, stats->num_stas, stats->coverage, stats->rate, stats->min_interval_ms,
+			stats->max_interval_ms, stats->deferred, stats->send_errors);
+	}
+
+	steer_stats = m_steer_engine.get_stats();
+	if (steer_stats->requested > 0) {
+		printf("%s:%d: Client steering: stas: %u evaluated: %llu requested: %llu succeeded: %llu failed: %llu in flight: %u deferred: %llu\n",
+			__func__, __LINE__, steer_stats->num_stas, steer_stats->evaluated, steer_stats->requested, steer_stats->succeeded,
+			steer_stats->failed, steer_stats->in_flight, steer_stats->deferred);
+	}
+
+	m_data_model.get_client_cap_cache()->expire();
+	cap_stats = m_data_model.get_client_cap_cache()->get_stats();
+	if ((cap_stats->hits + cap_stats->misses) > 0) {
+		printf("%s:%d: Client capabilities: stas: %u pending: %u hits: %llu queries: %llu coalesced: %llu changed: %llu unchanged: %llu expired: %llu\n",
+			__func__, __LINE__, cap_stats->num_stas, cap_stats->num_pending, cap_stats->hits, cap_stats->misses,
+			cap_stats->coalesced, cap_stats->changed, cap_stats->unchanged, cap_stats->expired);
+	}
+
+	policy_stats = m_policy_sync.get_stats();
+	if (policy_stats->requests > 0) {
+		printf("%s:%d: Policy sync: agents: %u in flight: %u requests: %llu tlvs: %llu suppressed: %llu acked: %llu retries: %llu dropped: %llu\n",
+			__func__, __LINE__, policy_stats->num_agents, policy_stats->in_flight, policy_stats->requests, policy_stats->sent,
+			policy_stats->suppressed, policy_stats->acked, policy_stats->retries, policy_stats->dropped);
+	}
 
+	disc_stats = m_disc_sched.get_stats();
+	if (disc_stats->probes > 0) {
+		printf("%s:%d: Topology probes: agents: %u lost: %u probes: %llu changed: %llu unchanged: %llu notified: %llu missed: %llu losses: %llu recoveries: %llu\n",
+			__func__, __LINE__, disc_stats->num_neighbours, disc_stats->num_lost, disc_stats->probes, disc_stats->changed,
+			disc_stats->unchanged, disc_stats->notified, disc_stats->missed, disc_stats->losses, disc_stats->recoveries);
+	}
+
+	snapshot_stats = m_dm_snapshot.get_stats();
+	if (snapshot_stats->published > 0) {
+		printf("%s:%d: DM snapshot: subdocs: %u epoch: %llu published: %llu unchanged: %llu oversized: %llu unread: %llu\n",
+			__func__, __LINE__, snapshot_stats->num_slots, snapshot_stats->epoch, snapshot_stats->published,
+			snapshot_stats->unchanged, snapshot_stats->oversized, snapshot_stats->unread);
+	}
 }
 
 void em_ctrl_t::handle_500ms_tick()
 {
     handle_dirty_dm();
+    publish_dm_snapshot();
+    dispatch_fanout();
     m_orch->handle_timeout();
 }
 
@@ -446,6 +1004,10 @@ void em_ctrl_t::handle_bus_event(em_bus_event_t *evt)
             handle_get_dm_data(evt);
             break;
 
+        case em_bus_event_type_get_metrics:
+            handle_get_metrics(evt);
+            break;
+
         case em_bus_event_type_set_radio:
             handle_set_radio(evt);  
             break;
@@ -534,6 +1096,9 @@ int em_ctrl_t::data_model_init(const char *data_model_path)
 
     m_ctrl_cmd = new em_cmd_ctrl_t();
     m_ctrl_cmd->init();
+
+    // get commands are answered from the socket alone if the snapshot can not be created
+    m_dm_snapshot.create();
     
     if (m_data_model.init(data_model_path, this) != 0) {
         printf("%s:%d: data model init failed\n", __func__, __LINE__);
@@ -864,6 +1429,9 @@ void em_ctrl_t::start_complete()
     }
 	memcpy(&ac_config_raw.radio, &null_mac, sizeof(mac_address_t));
 	io_process(em_bus_event_type_cfg_renew, reinterpret_cast<unsigned char *> (&ac_config_raw), sizeof(em_bus_event_type_cfg_renew_params_t));
+
+	m_sta_metrics_timer = add_timer(EM_STA_METRICS_TICK_MS, true, [this]() { m_sta_metrics.run(); });
+
 	//Initialze cli devtest
 	for (i = 0; i < em_dev_test_type_max; i++) {
 		dev_test.dev_test_info.num_iteration[i] = 50;
@@ -878,14 +1446,26 @@ void em_ctrl_t::start_complete()
 }
 
 
-em_ctrl_t::em_ctrl_t()
+em_ctrl_t::em_ctrl_t() : m_sta_metrics([this](const unsigned char *ruid, mac_address_t *stas, unsigned int num) {
+		return send_sta_metrics_queries(ruid, stas, num); }),
+	m_metrics_store([this](const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, const em_metrics_bucket_t *bucket) {
+		m_data_model.persist_metrics_rollup(mac, id, resolution, bucket); }),
+	m_channel_planner([this](const em_chan_plan_move_t *moves, unsigned int num) {
+		return apply_channel_plan(moves, num); }),
+	m_steer_engine([this](const em_steer_req_params_t *req) {
+		return apply_steer_request(req); })
 {
-
+	m_sta_metrics_timer = EM_TIMER_INVALID_ID;
+	m_sta_metrics_log_ticks = 0;
+	m_channel_plan_log_ticks = 0;
+	m_dm_snapshot_pending = ~0u;
 }
 
 em_ctrl_t::~em_ctrl_t()
 {
-
+	if (m_sta_metrics_timer != EM_TIMER_INVALID_ID) {
+		cancel_timer(m_sta_metrics_timer);
+	}
 }
 
 #ifdef AL_SAP
@@ -29,9 +29,12 @@
 
 void em_dev_test_t::encode(em_subdoc_info_t *subdoc, hash_map_t *m_em_map, bool update, bool testinprogress)
 {
-	cJSON *parent, *em_jlist, *em_data, *dev_test, *dev_test_param;
+	cJSON *parent, *em_jlist, *em_data, *dev_test, *dev_test_param, *sm_states, *sm_state;
 	char *tmp;
 	em_t *em = NULL;
+	em_sm_stats_t sm_stats;
+	const em_sm_state_desc_t *desc;
+	unsigned int j;
 	int i = 0;
 	em_small_string_t enable;
 	em_short_string_t haul_type_str;
@@ -62,6 +65,23 @@ void em_dev_test_t::encode(em_subdoc_info_t *subdoc, hash_map_t *m_em_map, bool
 					cJSON_AddStringToObject(em_data, "Debug/Test_Enabled", "Offline");
 				}
 
+				sm_stats = em->get_sm_stats();
+				cJSON_AddNumberToObject(em_data, "SM_Transitions", static_cast<double> (sm_stats.transitions));
+				cJSON_AddNumberToObject(em_data, "SM_Rejected", static_cast<double> (sm_stats.rejected));
+				cJSON_AddNumberToObject(em_data, "SM_Timeouts", static_cast<double> (sm_stats.timeouts));
+				sm_states = cJSON_AddArrayToObject(em_data, "SM_States");
+				for (j = 0; (desc = em_sm_t::get_state_desc(em->get_service_type(), j)) != NULL; j++) {
+					if (sm_stats.states[j].entered == 0) {
+						continue;
+					}
+					sm_state = cJSON_CreateObject();
+					cJSON_AddStringToObject(sm_state, "State", em_t::state_2_str(desc->state));
+					cJSON_AddNumberToObject(sm_state, "Entered", sm_stats.states[j].entered);
+					cJSON_AddNumberToObject(sm_state, "Timeouts", sm_stats.states[j].timeouts);
+					cJSON_AddItemToObject(sm_state, "Dwell:[<100ms,<1s,<10s,<1m,<10m,longer]",
+						cJSON_CreateIntArray(reinterpret_cast<const int *> (sm_stats.states[j].dwell), EM_SM_NUM_DWELL_BUCKETS));
+					cJSON_AddItemToArray(sm_states, sm_state);
+				}
 			}
 			em = static_cast<em_t *> (hash_map_get_next(m_em_map, em));
 		}
@@ -0,0 +1,291 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "em_fanout.h"
+
+time_t em_fanout_t::now_s()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec;
+}
+
+void em_fanout_t::fill_result(const job_t& job, time_t now, em_fanout_result_t *result)
+{
+	memset(result, 0, sizeof(em_fanout_result_t));
+	result->job = job.id;
+	result->type = job.type;
+	result->num_targets = static_cast<unsigned int> (job.targets.size());
+	result->elapsed_s = static_cast<unsigned int> (now - job.start);
+
+	for (auto& t : job.targets) {
+		switch (t.state) {
+			case em_fanout_target_queued:
+				result->queued++;
+				break;
+
+			case em_fanout_target_dispatched:
+				result->in_flight++;
+				break;
+
+			case em_fanout_target_succeeded:
+				result->succeeded++;
+				break;
+
+			case em_fanout_target_failed:
+				result->failed++;
+				break;
+
+			case em_fanout_target_timed_out:
+				result->timed_out++;
+				break;
+		}
+	}
+	result->done = (result->queued == 0) && (result->in_flight == 0);
+}
+
+em_fanout_t::job_t *em_fanout_t::find_job(unsigned int id)
+{
+	for (auto& job : m_jobs) {
+		if (job.id == id) {
+			return &job;
+		}
+	}
+
+	return NULL;
+}
+
+unsigned int em_fanout_t::start(em_cmd_type_t type, const std::vector<em_fanout_target_t>& targets, em_fanout_payload_t payload,
+	unsigned int window)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int i;
+
+	if (targets.empty() == true) {
+		return 0;
+	}
+
+	for (auto& job : m_jobs) {
+		if (job.type == type) {
+			return 0;
+		}
+	}
+
+	if (++m_next_id == 0) {
+		m_next_id = 1;
+	}
+
+	m_jobs.push_back(job_t());
+	job_t& job = m_jobs.back();
+	job.id = m_next_id;
+	job.type = type;
+	job.payload = payload;
+	job.window = (window == 0) ? EM_FANOUT_WINDOW:window;
+	job.targets = targets;
+	job.dispatch_time.assign(targets.size(), 0);
+	job.start = now_s();
+	for (i = 0; i < job.targets.size(); i++) {
+		job.targets[i].state = em_fanout_target_queued;
+	}
+	m_stats.jobs++;
+
+	return job.id;
+}
+
+bool em_fanout_t::is_in_progress(em_cmd_type_t type)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (auto& job : m_jobs) {
+		if (job.type == type) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool em_fanout_t::next(em_fanout_dispatch_t *dispatch)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (auto& job : m_jobs) {
+		if ((job.in_flight >= job.window) || (job.next >= job.targets.size())) {
+			continue;
+		}
+
+		job.targets[job.next].state = em_fanout_target_dispatched;
+		job.dispatch_time[job.next] = now_s();
+		job.in_flight++;
+		m_stats.dispatched++;
+
+		dispatch->job = job.id;
+		dispatch->index = job.next;
+		dispatch->type = job.type;
+		memcpy(dispatch->mac, job.targets[job.next].mac, sizeof(mac_address_t));
+		dispatch->payload = job.payload;
+		job.next++;
+
+		return true;
+	}
+
+	return false;
+}
+
+bool em_fanout_t::complete(unsigned int id, unsigned int index, em_fanout_target_state_t state)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	job_t *job;
+
+	if (((job = find_job(id)) == NULL) || (index >= job->targets.size()) ||
+			(job->targets[index].state != em_fanout_target_dispatched)) {
+		return false;
+	}
+
+	switch (state) {
+		case em_fanout_target_succeeded:
+			m_stats.succeeded++;
+			break;
+
+		case em_fanout_target_failed:
+			m_stats.failed++;
+			break;
+
+		case em_fanout_target_timed_out:
+			m_stats.timed_out++;
+			break;
+
+		default:
+			return false;
+	}
+
+	job->targets[index].state = state;
+	job->in_flight--;
+
+	return true;
+}
+
+unsigned int em_fanout_t::expire(std::vector<em_fanout_result_t> *done)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	em_fanout_result_t result;
+	time_t now = now_s();
+	unsigned int i, num = 0;
+
+	for (auto it = m_jobs.begin(); it != m_jobs.end(); ) {
+		job_t& job = *it;
+
+		for (i = 0; i < job.targets.size(); i++) {
+			if ((job.targets[i].state == em_fanout_target_dispatched) && ((now - job.dispatch_time[i]) > EM_FANOUT_TARGET_TIMEOUT_S)) {
+				job.targets[i].state = em_fanout_target_timed_out;
+				job.in_flight--;
+				m_stats.timed_out++;
+			}
+		}
+
+		fill_result(job, now, &result);
+		if (result.done == false) {
+			++it;
+			continue;
+		}
+
+		// the payload goes with the job, only the outcomes are kept
+		m_results.push_back(finished_t());
+		m_results.back().result = result;
+		m_results.back().targets = job.targets;
+		if (m_results.size() > EM_FANOUT_MAX_RESULTS) {
+			m_results.pop_front();
+		}
+		if (done != NULL) {
+			done->push_back(result);
+		}
+		it = m_jobs.erase(it);
+		num++;
+	}
+
+	return num;
+}
+
+bool em_fanout_t::get_result(unsigned int id, em_fanout_result_t *result)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	job_t *job;
+
+	if ((job = find_job(id)) != NULL) {
+		fill_result(*job, now_s(), result);
+		return true;
+	}
+
+	for (auto& r : m_results) {
+		if (r.result.job == id) {
+			*result = r.result;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool em_fanout_t::get_targets(unsigned int id, std::vector<em_fanout_target_t> *targets)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	job_t *job;
+
+	if ((job = find_job(id)) != NULL) {
+		*targets = job->targets;
+		return true;
+	}
+
+	for (auto& r : m_results) {
+		if (r.result.job == id) {
+			*targets = r.targets;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+em_fanout_stats_t em_fanout_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int in_flight = 0;
+
+	for (auto& job : m_jobs) {
+		in_flight += job.in_flight;
+	}
+	m_stats.num_jobs = static_cast<unsigned int> (m_jobs.size());
+	m_stats.in_flight = in_flight;
+
+	return m_stats;
+}
+
+em_fanout_t::em_fanout_t() : m_lock(), m_jobs(), m_results(), m_next_id(0), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_fanout_stats_t));
+}
+
+em_fanout_t::~em_fanout_t()
+{
+
+}
@@ -0,0 +1,257 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "em_sta_metrics_sched.h"
+
+unsigned long long em_sta_metrics_sched_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+unsigned long long em_sta_metrics_sched_t::now_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (static_cast<unsigned long long> (ts.tv_sec) * 1000) + static_cast<unsigned long long> (ts.tv_nsec / 1000000);
+}
+
+unsigned int em_sta_metrics_sched_t::jitter(unsigned int interval)
+{
+	unsigned int span = (interval * EM_STA_METRICS_JITTER_PCT) / 100;
+
+	if (span == 0) {
+		return interval;
+	}
+
+	// +/- span around the interval
+	return interval - span + (static_cast<unsigned int> (rand_r(&m_rand)) % (2 * span + 1));
+}
+
+void em_sta_metrics_sched_t::schedule(unsigned long long key, entry_t& entry, unsigned long long now, unsigned int delay)
+{
+	entry.due = now + delay;
+	// older heap entries of this STA no longer match entry.due and are dropped when popped
+	m_due.push(due_t(entry.due, key));
+}
+
+void em_sta_metrics_sched_t::adapt(entry_t& entry, const em_sta_metrics_sample_t *sample)
+{
+	int rcpi_delta = static_cast<int> (sample->rcpi) - static_cast<int> (entry.last.rcpi);
+	unsigned int bytes_delta = sample->bytes - entry.last.bytes;	// counters wrap
+	unsigned int interval = entry.interval;
+
+	if ((rcpi_delta >= EM_STA_METRICS_RCPI_DELTA) || (rcpi_delta <= -EM_STA_METRICS_RCPI_DELTA)) {
+		interval = EM_STA_METRICS_MIN_INTERVAL_MS;
+	} else if ((bytes_delta >= EM_STA_METRICS_ACTIVE_BYTES) || (sample->util > 0)) {
+		interval /= 2;
+	} else {
+		interval += interval / 2;
+	}
+
+	if (interval < EM_STA_METRICS_MIN_INTERVAL_MS) {
+		interval = EM_STA_METRICS_MIN_INTERVAL_MS;
+	} else if (interval > EM_STA_METRICS_MAX_INTERVAL_MS) {
+		interval = EM_STA_METRICS_MAX_INTERVAL_MS;
+	}
+
+	entry.interval = interval;
+}
+
+void em_sta_metrics_sched_t::observe(const em_sta_metrics_sample_t *sample)
+{
+	unsigned long long key = mac_key(sample->sta), now = now_ms();
+	entry_t entry;
+
+	auto it = m_stas.find(key);
+	if (it == m_stas.end()) {
+		memset(&entry, 0, sizeof(entry_t));
+		memcpy(&entry.last, sample, sizeof(em_sta_metrics_sample_t));
+		entry.interval = EM_STA_METRICS_DEF_INTERVAL_MS;
+		entry.generation = m_generation;
+		entry.last_poll = now;
+		// random phase so STAs that show up together are not polled together
+		schedule(key, entry, now, static_cast<unsigned int> (rand_r(&m_rand)) % EM_STA_METRICS_DEF_INTERVAL_MS);
+		m_stas[key] = entry;
+		return;
+	}
+
+	entry_t& cur = it->second;
+	cur.generation = m_generation;
+
+	// roamed, the next query goes through the new radio
+	memcpy(cur.last.ruid, sample->ruid, sizeof(mac_address_t));
+	memcpy(cur.last.bssid, sample->bssid, sizeof(mac_address_t));
+
+	// give the response a tick to land in the data model before judging it
+	if ((cur.polled == false) || ((now - cur.last_poll) < 1000)) {
+		return;
+	}
+
+	cur.polled = false;
+	adapt(cur, sample);
+	cur.last.rcpi = sample->rcpi;
+	cur.last.bytes = sample->bytes;
+	cur.last.util = sample->util;
+
+	if ((cur.last_poll + cur.interval) < cur.due) {
+		schedule(key, cur, cur.last_poll, jitter(cur.interval));
+	}
+}
+
+void em_sta_metrics_sched_t::end_sync()
+{
+	for (auto it = m_stas.begin(); it != m_stas.end(); ) {
+		if (it->second.generation != m_generation) {
+			it = m_stas.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+unsigned int em_sta_metrics_sched_t::run()
+{
+	std::vector<std::pair<const unsigned char *, unsigned long long> > due;
+	mac_address_t stas[EM_STA_METRICS_BATCH];
+	unsigned long long now = now_ms();
+	unsigned int i, j, num, sent = 0;
+	double burst = EM_STA_METRICS_BURST;
+
+	if (m_last_refill != 0) {
+		m_tokens += (m_qps * static_cast<double> (now - m_last_refill)) / 1000.0;
+	}
+	if (m_tokens > burst) {
+		m_tokens = burst;
+	}
+	m_last_refill = now;
+
+	while ((m_due.empty() == false) && (m_due.top().first <= now)) {
+		if (m_tokens < (static_cast<double> (due.size()) + 1)) {
+			m_stats.deferred++;
+			break;
+		}
+
+		due_t top = m_due.top();
+		m_due.pop();
+
+		auto it = m_stas.find(top.second);
+		if ((it == m_stas.end()) || (it->second.due != top.first)) {
+			continue;
+		}
+
+		due.push_back(std::make_pair(it->second.last.ruid, top.second));
+	}
+
+	// group due STAs by radio so each agent gets its queries back to back, past EM_STA_METRICS_BATCH the
+	// remaining STAs of a radio start the next batch when the outer loop reaches them
+	for (i = 0; i < due.size(); i++) {
+		if (due[i].first == NULL) {
+			continue;
+		}
+
+		num = 0;
+		for (j = i; (j < due.size()) && (num < EM_STA_METRICS_BATCH); j++) {
+			if ((due[j].first == NULL) || (memcmp(due[j].first, due[i].first, sizeof(mac_address_t)) != 0)) {
+				continue;
+			}
+
+			entry_t& entry = m_stas[due[j].second];
+			memcpy(stas[num], entry.last.sta, sizeof(mac_address_t));
+			num++;
+
+			entry.polled = true;
+			entry.last_poll = now;
+			schedule(due[j].second, entry, now, jitter(entry.interval));
+			if (j != i) {
+				due[j].first = NULL;
+			}
+		}
+
+		if (m_send(due[i].first, stas, num) != 0) {
+			m_stats.send_errors++;
+		}
+		due[i].first = NULL;
+
+		m_tokens -= num;
+		m_stats.total_queries += num;
+		m_stats.total_batches++;
+		sent += num;
+		for (j = 0; j < num; j++) {
+			m_sent_times.push(now);
+		}
+	}
+
+	return sent;
+}
+
+const em_sta_metrics_stats_t *em_sta_metrics_sched_t::get_stats()
+{
+	unsigned long long now = now_ms();
+	unsigned int min = 0, max = 0;
+
+	while ((m_sent_times.empty() == false) && ((now - m_sent_times.front()) > EM_STA_METRICS_RATE_WINDOW_MS)) {
+		m_sent_times.pop();
+	}
+
+	m_stats.num_stas = static_cast<unsigned int> (m_stas.size());
+	m_stats.num_covered = 0;
+	for (auto& it : m_stas) {
+		if ((now - it.second.last_poll) <= (2ULL * it.second.interval)) {
+			m_stats.num_covered++;
+		}
+		if ((min == 0) || (it.second.interval < min)) {
+			min = it.second.interval;
+		}
+		if (it.second.interval > max) {
+			max = it.second.interval;
+		}
+	}
+
+	m_stats.coverage = (m_stats.num_stas == 0) ? 1.0:static_cast<double> (m_stats.num_covered) / m_stats.num_stas;
+	m_stats.rate = static_cast<double> (m_sent_times.size()) * 1000.0 / EM_STA_METRICS_RATE_WINDOW_MS;
+	m_stats.min_interval_ms = min;
+	m_stats.max_interval_ms = max;
+
+	return &m_stats;
+}
+
+em_sta_metrics_sched_t::em_sta_metrics_sched_t(em_sta_metrics_send_func send) : m_stas(), m_due(), m_send(send),
+	m_generation(0), m_rand(0), m_tokens(EM_STA_METRICS_BURST), m_qps(EM_STA_METRICS_MAX_QPS), m_last_refill(0),
+	m_sent_times(), m_stats()
+{
+	m_rand = static_cast<unsigned int> (now_ms());
+	memset(&m_stats, 0, sizeof(em_sta_metrics_stats_t));
+}
+
+em_sta_metrics_sched_t::~em_sta_metrics_sched_t()
+{
+
+}
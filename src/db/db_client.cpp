@@ -50,8 +50,12 @@
      return 0;
  }
 
- void *db_client_t::execute(const char *query)
+ void *db_client_t::execute(const char *query, int *status)
  {
+     if (status != NULL) {
+         *status = -1;
+     }
+
      if (!m_con) {
          printf("%s:%d: Query: %s m_con is NULL, exiting\n", __func__, __LINE__, query);
          return NULL;
@@ -66,6 +70,9 @@
      if (!result) {
          // This might not be an error - could be a query that doesn't return results (INSERT, UPDATE, etc.)
          if (mysql_field_count(m_con) == 0) {
+             if (status != NULL) {
+                 *status = 0;
+             }
              return NULL;  // Query was successful but didn't return data
          } else {
              printf("%s:%d: Error storing result: %s\n", __func__, __LINE__, mysql_error(m_con));
@@ -78,6 +85,10 @@
      ctx->result = result;
      ctx->row = NULL;
 
+     if (status != NULL) {
+         *status = 0;
+     }
+
      return ctx;
  }
 
@@ -100,6 +111,20 @@
      return true;
  }
 
+ bool db_client_t::next_row(void *ctx, db_row_t& row)
+ {
+     if (next_result(ctx) == false) {
+         row.set(NULL, NULL, 0);
+         return false;
+     }
+
+     result_context_t *res_ctx = static_cast<result_context_t *>(ctx);
+
+     // Lengths are fetched once per row here rather than once per column by get_string()
+     row.set(res_ctx->row, mysql_fetch_lengths(res_ctx->result), mysql_num_fields(res_ctx->result));
+     return true;
+ }
+
  char *db_client_t::get_string(void *ctx, char *str, unsigned int col)
  {
      if (ctx == NULL) {
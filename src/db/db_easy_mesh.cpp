@@ -112,6 +112,7 @@ int db_easy_mesh_t::insert_row(db_client_t& db_client, ...)
     db_query_t format, query;
     db_fmt_t	col_fmt;
     void *ctx;
+    int ret;
 
     snprintf(format, sizeof(db_query_t), "insert into %s (", m_table_name);
     for (i = 0; i < m_num_cols; i++) {
@@ -136,10 +137,10 @@ int db_easy_mesh_t::insert_row(db_client_t& db_client, ...)
 
     //printf("%s:%d: Query: %s\n", __func__, __LINE__, query);
 
-    ctx = db_client.execute(query);
+    ctx = db_client.execute(query, &ret);
     while (db_client.next_result(ctx) == true);
 
-    return 0;
+    return ret;
 }
 
 int db_easy_mesh_t::update_row(db_client_t& db_client, ...)
@@ -149,6 +150,7 @@ int db_easy_mesh_t::update_row(db_client_t& db_client, ...)
     va_list list;
     db_fmt_t	col_fmt;
     void *ctx;
+    int ret;
 
     snprintf(format, sizeof(db_query_t), "update %s set ", m_table_name);
 
@@ -172,10 +174,10 @@ int db_easy_mesh_t::update_row(db_client_t& db_client, ...)
 
     //printf("%s:%d: Query: %s\n", __func__, __LINE__, query);
 
-    ctx = db_client.execute(query);
+    ctx = db_client.execute(query, &ret);
     while (db_client.next_result(ctx) == true);
 
-    return 0;
+    return ret;
 }
 
 int db_easy_mesh_t::compare_row(db_client_t& db_client, ...)
@@ -215,6 +217,7 @@ int db_easy_mesh_t::delete_row(db_client_t& db_client, ...)
     va_list list;
     db_fmt_t	col_fmt;
     void *ctx;
+    int ret;
 
     snprintf(format, sizeof(db_query_t), "delete from %s", m_table_name);
     snprintf(tmp, sizeof(db_query_t), " where %s =  ", m_columns[0].m_name);
@@ -229,10 +232,10 @@ int db_easy_mesh_t::delete_row(db_client_t& db_client, ...)
 
     //printf("%s:%d: Query: %s\n", __func__, __LINE__, query);
 
-    ctx = db_client.execute(query);
+    ctx = db_client.execute(query, &ret);
     while (db_client.next_result(ctx) == true);
 
-    return 0;
+    return ret;
 }
 
 
@@ -246,6 +249,7 @@ int db_easy_mesh_t::sync_table(db_client_t& db_client)
 
     ctx = db_client.execute(query);
 
+    m_persisted.clear();
     return sync_db(db_client, ctx);
 
 }
@@ -263,6 +267,50 @@ bool db_easy_mesh_t::entry_exists_in_table(db_client_t& db_client, void *key)
     return search_db(db_client, ctx, key);
 }
 
+unsigned long long db_easy_mesh_t::content_hash(const void *data, size_t len)
+{
+    const unsigned char *p = static_cast<const unsigned char *> (data);
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    size_t i;
+
+    // FNV-1a
+    for (i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+void db_easy_mesh_t::set_persisted(const char *key, dm_orch_type_t op, const void *data, size_t len)
+{
+    switch (op) {
+        case dm_orch_type_db_insert:
+        case dm_orch_type_db_update:
+            m_persisted[key] = content_hash(data, len);
+            break;
+
+        case dm_orch_type_db_delete:
+            m_persisted.erase(key);
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool db_easy_mesh_t::is_persisted(const char *key)
+{
+    return m_persisted.find(key) != m_persisted.end();
+}
+
+bool db_easy_mesh_t::is_persisted_unchanged(const char *key, const void *data, size_t len)
+{
+    std::unordered_map<std::string, unsigned long long>::const_iterator it = m_persisted.find(key);
+
+    return (it != m_persisted.end()) && (it->second == content_hash(data, len));
+}
+
 void db_easy_mesh_t::delete_table(db_client_t& db_client)
 {
     db_query_t    query;
@@ -270,6 +318,7 @@ void db_easy_mesh_t::delete_table(db_client_t& db_client)
     memset(query, 0, sizeof(db_query_t));
     snprintf(query, sizeof(db_query_t), "drop table %s", m_table_name);
     db_client.execute(query);
+    m_persisted.clear();
 }
 
 int db_easy_mesh_t::create_table(db_client_t& db_client)
@@ -341,6 +390,7 @@ int db_easy_mesh_t::create_table(db_client_t& db_client)
     query[strlen(query) - 2] = ')';
     query[strlen(query) - 1] = 0;
     db_client.execute(query);
+    m_persisted.clear();
     //printf("%s:%d: Query: %s\n", __func__, __LINE__, query);
 
     return 0;
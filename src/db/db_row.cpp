@@ -0,0 +1,174 @@
+/**
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+ #include <string.h>
+ #include "db_client.h"
+
+ static inline int hex_nibble(char c)
+ {
+     if ((c >= '0') && (c <= '9')) {
+         return c - '0';
+     } else if ((c >= 'a') && (c <= 'f')) {
+         return c - 'a' + 10;
+     } else if ((c >= 'A') && (c <= 'F')) {
+         return c - 'A' + 10;
+     }
+
+     return -1;
+ }
+
+ void db_row_t::set(const char *const *row, const unsigned long *lengths, unsigned int num_cols)
+ {
+     m_row = row;
+     m_lengths = lengths;
+     m_num_cols = num_cols;
+ }
+
+ const char *db_row_t::get_value(unsigned int col, size_t *len)
+ {
+     if ((m_row == NULL) || (col == 0) || (col > m_num_cols) || (m_row[col - 1] == NULL)) {
+         if (len != NULL) {
+             *len = 0;
+         }
+         return NULL;
+     }
+
+     if (len != NULL) {
+         *len = (m_lengths != NULL) ? m_lengths[col - 1]:strlen(m_row[col - 1]);
+     }
+
+     return m_row[col - 1];
+ }
+
+ int db_row_t::get_number(unsigned int col)
+ {
+     const char *val;
+     size_t len, i = 0;
+     bool neg = false;
+     long num = 0;
+
+     if ((val = get_value(col, &len)) == NULL) {
+         return 0;
+     }
+
+     // integer columns come as plain decimal text, parse them without the locale machinery of atoi()
+     while ((i < len) && (val[i] == ' ')) {
+         i++;
+     }
+     if ((i < len) && ((val[i] == '-') || (val[i] == '+'))) {
+         neg = (val[i] == '-');
+         i++;
+     }
+     for (; (i < len) && (val[i] >= '0') && (val[i] <= '9'); i++) {
+         num = num * 10 + (val[i] - '0');
+         if (num > 0x7fffffffL) {
+             break;
+         }
+     }
+
+     return static_cast<int> (neg ? -num:num);
+ }
+
+ char *db_row_t::get_string(unsigned int col, char *str, size_t size)
+ {
+     const char *val;
+     size_t len;
+
+     if (size == 0) {
+         return str;
+     }
+
+     if ((val = get_value(col, &len)) == NULL) {
+         str[0] = 0;
+         return str;
+     }
+
+     if (len >= size) {
+         len = size - 1;
+     }
+     memcpy(str, val, len);
+     str[len] = 0;
+
+     return str;
+ }
+
+ int db_row_t::get_mac(unsigned int col, unsigned char *mac)
+ {
+     const char *val;
+     size_t len, pos = 0;
+     unsigned int i;
+     int hi, lo;
+
+     memset(mac, 0, 6);
+     if ((val = get_value(col, &len)) == NULL) {
+         return -1;
+     }
+
+     for (i = 0; i < 6; i++) {
+         if ((i > 0) && (len == 17)) {
+             if (val[pos] != ':') {
+                 break;
+             }
+             pos++;
+         }
+         if ((pos + 2) > len) {
+             break;
+         }
+         hi = hex_nibble(val[pos]);
+         lo = hex_nibble(val[pos + 1]);
+         if ((hi < 0) || (lo < 0)) {
+             break;
+         }
+         mac[i] = static_cast<unsigned char> ((hi << 4) | lo);
+         pos += 2;
+     }
+
+     if ((i < 6) || (pos != len)) {
+         memset(mac, 0, 6);
+         return -1;
+     }
+
+     return 0;
+ }
+
+ unsigned int db_row_t::get_hex(unsigned int col, unsigned char *buff, unsigned int size)
+ {
+     const char *val;
+     size_t len, i;
+     unsigned int num = 0;
+     int hi, lo;
+
+     if ((val = get_value(col, &len)) == NULL) {
+         return 0;
+     }
+
+     for (i = 0; ((i + 1) < len) && (num < size); i += 2) {
+         hi = hex_nibble(val[i]);
+         lo = hex_nibble(val[i + 1]);
+         if ((hi < 0) || (lo < 0)) {
+             break;
+         }
+         buff[num++] = static_cast<unsigned char> ((hi << 4) | lo);
+     }
+
+     return num;
+ }
+
+ db_row_t::db_row_t() : m_row(NULL), m_lengths(NULL), m_num_cols(0)
+ {
+ }
@@ -120,7 +120,7 @@ dm_orch_type_t dm_bss_list_t::get_dm_orch_type(db_client_t& db_client, const dm_
     pbss = get_bss(key);
 
     if (pbss != NULL) {
-        if (entry_exists_in_table(db_client, key) == false) {
+        if (is_persisted(key) == false) {
             return dm_orch_type_db_insert;
         }
 
@@ -257,6 +257,10 @@ int dm_bss_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void *da
 			break;
 	}
 
+    if (ret == 0) {
+        set_persisted(key, op, info, sizeof(em_bss_info_t));
+    }
+
     return ret;
 }
 
@@ -278,55 +282,54 @@ bool dm_bss_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
 int dm_bss_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_bss_info_t info;
-    mac_addr_str_t	mac;
-    em_long_string_t   str;
+    db_row_t row;
+    em_long_string_t   str, key;
     unsigned int i;
     char   *token_parts[EM_MAX_AKMS];
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
         memset(&info, 0, sizeof(em_bss_info_t));
 
-        db_client.get_string(ctx, str, 1);
-		dm_bss_t::parse_bss_id_from_key(str, &info.id);
+        row.get_string(1, key, sizeof(key));
+		dm_bss_t::parse_bss_id_from_key(key, &info.id);
 
-        db_client.get_string(ctx, mac, 2);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.bssid.mac);
+        row.get_mac(2, info.bssid.mac);
 
-        db_client.get_string(ctx, mac, 3);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.ruid.mac);
+        row.get_mac(3, info.ruid.mac);
 
-        db_client.get_string(ctx, info.ssid, 4);
-        info.enabled = db_client.get_number(ctx, 5);
+        row.get_string(4, info.ssid, sizeof(info.ssid));
+        info.enabled = row.get_number(5);
 
-        db_client.get_string(ctx, info.est_svc_params_be, 6);
-        db_client.get_string(ctx, info.est_svc_params_bk, 7);
-        db_client.get_string(ctx, info.est_svc_params_vi, 8);
-        db_client.get_string(ctx, info.est_svc_params_vo, 9);
+        row.get_string(6, info.est_svc_params_be, sizeof(info.est_svc_params_be));
+        row.get_string(7, info.est_svc_params_bk, sizeof(info.est_svc_params_bk));
+        row.get_string(8, info.est_svc_params_vi, sizeof(info.est_svc_params_vi));
+        row.get_string(9, info.est_svc_params_vo, sizeof(info.est_svc_params_vo));
 
-        db_client.get_string(ctx, str, 10);
+        row.get_string(10, str, sizeof(str));
         for (i = 0; i < EM_MAX_AKMS; i++) {
             token_parts[i] = info.fronthaul_akm[i];
         }
         info.num_fronthaul_akms = static_cast<unsigned char> (get_strings_by_token(str, ',', EM_MAX_AKMS, token_parts));
 
-        db_client.get_string(ctx, str, 11);
+        row.get_string(11, str, sizeof(str));
 
         for (i = 0; i < EM_MAX_AKMS; i++) {
             token_parts[i] = info.backhaul_akm[i];
         }
         info.num_backhaul_akms = static_cast<unsigned char> (get_strings_by_token(str, ',', EM_MAX_AKMS, token_parts));
 
-        info.profile_1b_sta_allowed = db_client.get_number(ctx, 12);
-        info.profile_2b_sta_allowed = db_client.get_number(ctx, 13);
-        info.assoc_allowed_status = static_cast<unsigned int> (db_client.get_number(ctx, 14));
-        info.backhaul_use = db_client.get_number(ctx, 15);
-        info.fronthaul_use = db_client.get_number(ctx, 16);
-        info.r1_disallowed = db_client.get_number(ctx, 17);
-        info.r2_disallowed = db_client.get_number(ctx, 18);
-        info.multi_bssid = db_client.get_number(ctx, 19);
-        info.transmitted_bssid = db_client.get_number(ctx, 20);
-
+        info.profile_1b_sta_allowed = row.get_number(12);
+        info.profile_2b_sta_allowed = row.get_number(13);
+        info.assoc_allowed_status = static_cast<unsigned int> (row.get_number(14));
+        info.backhaul_use = row.get_number(15);
+        info.fronthaul_use = row.get_number(16);
+        info.r1_disallowed = row.get_number(17);
+        info.r2_disallowed = row.get_number(18);
+        info.multi_bssid = row.get_number(19);
+        info.transmitted_bssid = row.get_number(20);
+
+        set_persisted(key, dm_orch_type_db_insert, &info, sizeof(em_bss_info_t));
         update_list(dm_bss_t(&info), dm_orch_type_db_insert);
     }
 
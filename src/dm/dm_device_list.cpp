@@ -107,7 +107,7 @@ dm_orch_type_t dm_device_list_t::get_dm_orch_type(db_client_t& db_client, const
     
     if (pdev != NULL) {
         
-        if (entry_exists_in_table(db_client, key) == false) {
+        if (is_persisted(key) == false) {
             //printf("%s:%d: Device: %s does not exist in db\n", __func__, __LINE__, 
                          //dm_easy_mesh_t::macbytes_to_string(pdev->m_device_info.id.mac, mac_str));
             return dm_orch_type_db_insert;
@@ -221,6 +221,10 @@ int dm_device_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void
 			break;
 	}
 
+    if (ret == 0) {
+        set_persisted(key, op, info, sizeof(em_device_info_t));
+    }
+
     return ret;
 }
 
@@ -242,50 +246,48 @@ bool dm_device_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
 int dm_device_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_device_info_t info;
-    mac_addr_str_t	mac;
-    em_long_string_t   str;
+    db_row_t row;
+    em_long_string_t   str, key;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
         memset(&info, 0, sizeof(em_device_info_t));
 
-        db_client.get_string(ctx, str, 1);
-        dm_device_t::parse_device_id_from_key(str, &info.id);
+        row.get_string(1, key, sizeof(key));
+        dm_device_t::parse_device_id_from_key(key, &info.id);
         
-		db_client.get_string(ctx, mac, 2);
-		dm_easy_mesh_t::string_to_macbytes(mac, info.intf.mac);
-
-        info.profile = static_cast<em_profile_type_t> (db_client.get_number(ctx, 3));
-        db_client.get_string(ctx, info.multi_ap_cap, 4);
-        info.coll_interval = static_cast<unsigned int> (db_client.get_number(ctx, 5));
-        info.report_unsuccess_assocs = static_cast<unsigned int> (db_client.get_number(ctx, 6));
-        info.max_reporting_rate = static_cast<short unsigned int> (db_client.get_number(ctx, 7));
-        info.ap_metrics_reporting_interval = static_cast<short unsigned int> (db_client.get_number(ctx, 8));
-        db_client.get_string(ctx, info.manufacturer, 9);
-        db_client.get_string(ctx, info.serial_number, 10);
-        db_client.get_string(ctx, info.manufacturer_model, 11);
-        db_client.get_string(ctx, info.software_ver, 12);
-        db_client.get_string(ctx, info.exec_env, 13);
-        db_client.get_string(ctx, info.country_code, 14);
-        info.traffic_sep_allowed = db_client.get_number(ctx, 15);
-        info.svc_prio_allowed = db_client.get_number(ctx, 16);
-        info.dfs_enable = db_client.get_number(ctx, 17);
-        info.max_unsuccessful_assoc_report_rate = static_cast<short unsigned int> (db_client.get_number(ctx, 18));
-        info.sta_steer_state = db_client.get_number(ctx, 19);
-        info.coord_cac_allowed = db_client.get_number(ctx, 20);
-
-        db_client.get_string(ctx, mac, 21);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.backhaul_mac.mac);
-
-        db_client.get_string(ctx, str, 22);
+		row.get_mac(2, info.intf.mac);
+
+        info.profile = static_cast<em_profile_type_t> (row.get_number(3));
+        row.get_string(4, info.multi_ap_cap, sizeof(info.multi_ap_cap));
+        info.coll_interval = static_cast<unsigned int> (row.get_number(5));
+        info.report_unsuccess_assocs = static_cast<unsigned int> (row.get_number(6));
+        info.max_reporting_rate = static_cast<short unsigned int> (row.get_number(7));
+        info.ap_metrics_reporting_interval = static_cast<short unsigned int> (row.get_number(8));
+        row.get_string(9, info.manufacturer, sizeof(info.manufacturer));
+        row.get_string(10, info.serial_number, sizeof(info.serial_number));
+        row.get_string(11, info.manufacturer_model, sizeof(info.manufacturer_model));
+        row.get_string(12, info.software_ver, sizeof(info.software_ver));
+        row.get_string(13, info.exec_env, sizeof(info.exec_env));
+        row.get_string(14, info.country_code, sizeof(info.country_code));
+        info.traffic_sep_allowed = row.get_number(15);
+        info.svc_prio_allowed = row.get_number(16);
+        info.dfs_enable = row.get_number(17);
+        info.max_unsuccessful_assoc_report_rate = static_cast<short unsigned int> (row.get_number(18));
+        info.sta_steer_state = row.get_number(19);
+        info.coord_cac_allowed = row.get_number(20);
+
+        row.get_mac(21, info.backhaul_mac.mac);
+
+        row.get_string(22, str, sizeof(str));
     
-        db_client.get_string(ctx, mac, 23);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.backhaul_alid.mac);
+        row.get_mac(23, info.backhaul_alid.mac);
 
-        info.traffic_sep_cap = db_client.get_number(ctx, 24);
-        info.easy_conn_cap = db_client.get_number(ctx, 25);
-        info.test_cap = static_cast<unsigned char> (db_client.get_number(ctx, 26));
+        info.traffic_sep_cap = row.get_number(24);
+        info.easy_conn_cap = row.get_number(25);
+        info.test_cap = static_cast<unsigned char> (row.get_number(26));
 
+        set_persisted(key, dm_orch_type_db_insert, &info, sizeof(em_device_info_t));
         update_list(dm_device_t(&info), dm_orch_type_db_insert);
     }
 
@@ -2380,27 +2380,15 @@ void dm_easy_mesh_t::deinit()
 {
     dm_sta_t *sta = NULL;
     dm_sta_t *tmp_sta = NULL;
-	dm_scan_result_t	*res = NULL;
-	dm_scan_result_t	*tmp_res = NULL;
     em_2xlong_string_t key;
-    mac_addr_str_t dev_mac_str, radio_mac_str, bss_mac_str, sta_mac_str, scanner_mac_str;
+    mac_addr_str_t dev_mac_str, radio_mac_str, bss_mac_str, sta_mac_str;
 
-    //destroy elements of m_scan_result_map
-	res = static_cast<dm_scan_result_t *> (hash_map_get_first(m_scan_result_map));
-	while (res != NULL) {
-		tmp_res = res;
-        res = static_cast<dm_scan_result_t *> (hash_map_get_next(m_scan_result_map, res));
-	
-		dm_easy_mesh_t::macbytes_to_string(tmp_res->m_scan_result.id.dev_mac, dev_mac_str);
-		dm_easy_mesh_t::macbytes_to_string(tmp_res->m_scan_result.id.scanner_mac, scanner_mac_str);
-
-		snprintf(key, sizeof(em_2xlong_string_t), "%s@%s@%s@%d@%d@%d", res->m_scan_result.id.net_id, dev_mac_str, scanner_mac_str, 
-					tmp_res->m_scan_result.id.op_class, tmp_res->m_scan_result.id.channel, tmp_res->m_scan_result.id.scanner_type);
-		hash_map_remove(m_scan_result_map, key);
+    //destroy elements of m_scan_result_store
+	if (m_scan_result_store != NULL) {
+		delete m_scan_result_store;
+		m_scan_result_store = NULL;
 	}
 
-	hash_map_destroy(m_scan_result_map);	
-
     //destroy elements of m_sta_map
     sta = static_cast<dm_sta_t *> (hash_map_get_first(m_sta_map));
     while (sta != NULL) {
@@ -2568,61 +2556,22 @@ dm_bss_t *dm_easy_mesh_t::find_matching_bss(em_bss_id_t *id)
 
 dm_scan_result_t *dm_easy_mesh_t::create_new_scan_result(em_scan_result_id_t *id)
 {
-	dm_scan_result_t *res, scan_result;
-	em_2xlong_string_t key;
-	mac_addr_str_t  dev_mac_str, scanner_mac_str;
-
-	memcpy(&scan_result.m_scan_result.id, id, sizeof(em_scan_result_id_t));
-
-	res = new dm_scan_result_t(scan_result);
-
-    dm_easy_mesh_t::macbytes_to_string(id->dev_mac, dev_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(id->scanner_mac, scanner_mac_str);
-
-	snprintf(key, sizeof(em_2xlong_string_t), "%s@%s@%s@%d@%d@%d", res->m_scan_result.id.net_id, dev_mac_str, scanner_mac_str,
-                    res->m_scan_result.id.op_class, res->m_scan_result.id.channel, res->m_scan_result.id.scanner_type);
-
-	hash_map_put(m_scan_result_map, strdup(key), res);
-
-	return res;
+	return m_scan_result_store->create(id);
 }
 
 dm_scan_result_t *dm_easy_mesh_t::get_scan_result(unsigned int index)
 {
-	dm_scan_result_t *res;
-	unsigned int i = 0;
-
-	res = static_cast<dm_scan_result_t *> (hash_map_get_first(m_scan_result_map));
-	while (res != NULL) {
-		if (i == index) {
-			return res;
-		}
-		i++;
-		res = static_cast<dm_scan_result_t *> (hash_map_get_next(m_scan_result_map, res));
-	}
-
-	return NULL;
+	return m_scan_result_store->get(index);
 }
 
 dm_scan_result_t *dm_easy_mesh_t::find_matching_scan_result(em_scan_result_id_t *id)
 {
-    dm_scan_result_t *res;
-
-	res = static_cast<dm_scan_result_t *> (hash_map_get_first(m_scan_result_map));
-	while (res != NULL) {
-        if ((strncmp(res->m_scan_result.id.net_id, id->net_id, strlen(id->net_id)) == 0) &&
-                (memcmp(res->m_scan_result.id.dev_mac, id->dev_mac, sizeof(mac_address_t)) == 0) &&
-                (memcmp(res->m_scan_result.id.scanner_mac, id->scanner_mac, sizeof(mac_address_t)) == 0) &&
-                (res->m_scan_result.id.op_class == id->op_class) &&
-                (res->m_scan_result.id.channel == id->channel) &&
-                (res->m_scan_result.id.scanner_type == id->scanner_type)) {
-            return res;
-        }
-
-		res = static_cast<dm_scan_result_t *> (hash_map_get_next(m_scan_result_map, res));
-	}    
+	return m_scan_result_store->find(id);
+}
 
-    return NULL;
+unsigned int dm_easy_mesh_t::expire_scan_results(unsigned int max_age)
+{
+	return m_scan_result_store->expire(max_age);
 }
 
 void dm_easy_mesh_t::update_scan_results(em_scan_result_t *scan_result)
@@ -2644,6 +2593,8 @@ void dm_easy_mesh_t::update_scan_results(em_scan_result_t *scan_result)
         res = create_new_scan_result(id);
         *res->get_scan_result() = *scan_result;
     }
+    res->reindex_neighbors();
+    res->touch();
 }
 
 void dm_easy_mesh_t::reset_db_cfg_type(db_cfg_type_t type) 
@@ -2709,7 +2660,7 @@ int dm_easy_mesh_t::init()
 	    m_network_ssid[i].init();
     }
 
-    m_scan_result_map = hash_map_create();
+    m_scan_result_store = new dm_scan_result_store_t();
     m_sta_map = hash_map_create();
     m_sta_assoc_map = hash_map_create();
     m_sta_dassoc_map = hash_map_create();
@@ -207,6 +207,7 @@ void dm_easy_mesh_list_t::remove_device(const char *key)
     dm_easy_mesh_t *dm;
     dm = static_cast<dm_easy_mesh_t *> (hash_map_remove(m_list, key));
 	if (dm != NULL) {
+		unindex_data_model(dm);
 		delete dm;
 	}
 }
@@ -464,9 +465,9 @@ dm_bss_t *dm_easy_mesh_list_t::get_bss(const char *key)
 	dm_easy_mesh_t *dm;
 
 	dm_bss_t::parse_bss_id_from_key(key, &id);
-	dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);	
-	
+
 	if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+		dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
 		printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
 		return NULL;
 	}
@@ -479,13 +480,12 @@ void dm_easy_mesh_list_t::remove_bss(const char *key)
 	em_bss_id_t id;
 	dm_easy_mesh_t *dm;
 	unsigned int i;
-	mac_addr_str_t  radio_mac_str, dev_mac_str;
+	mac_addr_str_t  dev_mac_str;
 	
 	dm_bss_t::parse_bss_id_from_key(key, &id);
-	dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);	
-	dm_easy_mesh_t::macbytes_to_string(id.ruid, radio_mac_str);	
 
 	if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+		dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
 		printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
 		return;
 	}
@@ -500,16 +500,14 @@ void dm_easy_mesh_list_t::remove_bss(const char *key)
 void dm_easy_mesh_list_t::put_bss(const char *key, const dm_bss_t *bss)
 {
 	em_bss_id_t id;
-	mac_addr_str_t	dev_mac_str, radio_mac_str, bssid_str;
+	mac_addr_str_t	dev_mac_str;
 	dm_easy_mesh_t *dm;
 	dm_bss_t *pbss;
 
 	dm_bss_t::parse_bss_id_from_key(key, &id);
-	dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
-	dm_easy_mesh_t::macbytes_to_string(id.ruid, radio_mac_str);
-	dm_easy_mesh_t::macbytes_to_string(id.bssid, bssid_str);
 
 	if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+		dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
 		printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
 		return;
 	}
@@ -563,48 +561,82 @@ dm_sta_t *dm_easy_mesh_list_t::get_next_sta(dm_sta_t *psta)
     return NULL;
 }   
     
-dm_sta_t *dm_easy_mesh_list_t::get_sta(const char *key)
-{   
-    dm_sta_t *sta;
+unsigned long long dm_easy_mesh_list_t::mac_key(const unsigned char *mac)
+{
+    unsigned long long key = 0;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(mac_address_t); i++) {
+        key = (key << 8) | mac[i];
+    }
+
+    return key;
+}
+
+dm_easy_mesh_t *dm_easy_mesh_list_t::find_dm_by_radio(const unsigned char *ruid)
+{
     dm_easy_mesh_t *dm;
-    mac_address_t sta_mac, ruid;
-    mac_addr_str_t	sta_mac_str, radio_mac_str, bssid_str;
-    bssid_t	bssid;
-    bool found = false;
+    unsigned long long key = mac_key(ruid);
     unsigned int i;
 
-    dm_sta_t::parse_sta_bss_radio_from_key(key, sta_mac, bssid, ruid);
+    auto it = m_radio_dm.find(key);
+    if (it != m_radio_dm.end()) {
+        dm = it->second;
+        for (i = 0; i < dm->m_num_radios; i++) {
+            if (memcmp(dm->m_radio[i].m_radio_info.intf.mac, ruid, sizeof(mac_address_t)) == 0) {
+                return dm;
+            }
+        }
+        m_radio_dm.erase(it);
+    }
 
+    // radios are added by the data model decoders as well as put_radio(), learn them on first use
     dm = static_cast<dm_easy_mesh_t *> (hash_map_get_first(m_list));
     while (dm != NULL) {
         for (i = 0; i < dm->m_num_radios; i++) {
             if (memcmp(dm->m_radio[i].m_radio_info.intf.mac, ruid, sizeof(mac_address_t)) == 0) {
-                found = true;
-                break;
+                m_radio_dm[key] = dm;
+                return dm;
             }
         }
-
-        if (found == true) {
-            break;
-        }
         dm = static_cast<dm_easy_mesh_t *> (hash_map_get_next(m_list, dm));
     }
 
-    if (found == false) {
-        return NULL;
+    return NULL;
+}
+
+void dm_easy_mesh_list_t::unindex_data_model(dm_easy_mesh_t *dm)
+{
+    auto it = m_radio_dm.begin();
+
+    while (it != m_radio_dm.end()) {
+        if (it->second == dm) {
+            it = m_radio_dm.erase(it);
+        } else {
+            it++;
+        }
     }
+}
 
-    dm_easy_mesh_t::macbytes_to_string(sta_mac, sta_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(bssid, bssid_str);
-    dm_easy_mesh_t::macbytes_to_string(ruid, radio_mac_str);
+dm_sta_t *dm_easy_mesh_list_t::get_sta(const char *key)
+{
+    em_sta_key_t sta_key;
 
-    if ((sta = static_cast<dm_sta_t *> (hash_map_get(dm->m_sta_map, key))) != NULL) {
-        //printf("%s:%d: STA:%s found on BSS:%s of radio:%s\n", __func__, __LINE__,
-        //sta_mac_str, bssid_str, radio_mac_str);
-        return sta;
+    dm_sta_t::parse_key(key, &sta_key);
+    return get_sta(&sta_key);
+}
+
+dm_sta_t *dm_easy_mesh_list_t::get_sta(const em_sta_key_t *key)
+{
+    dm_easy_mesh_t *dm;
+    em_long_string_t str;
+
+    if ((dm = find_dm_by_radio(key->ruid)) == NULL) {
+        return NULL;
     }
 
-    return NULL;
+    // the STA map of the data model is a hash_map_t, keyed by the string form
+    return static_cast<dm_sta_t *> (hash_map_get(dm->m_sta_map, dm_sta_t::key_to_string(key, str)));
 }
 
 void dm_easy_mesh_list_t::remove_sta(const char *key)
@@ -614,51 +646,33 @@ void dm_easy_mesh_list_t::remove_sta(const char *key)
 
 void dm_easy_mesh_list_t::put_sta(const char *key, const dm_sta_t *sta)
 {
-    dm_sta_t *psta;
-    dm_easy_mesh_t *dm;
-    mac_address_t sta_mac, ruid;
-    mac_addr_str_t	sta_mac_str, radio_mac_str, bssid_str;
-    bssid_t	bssid;
-    bool found = false;
-    unsigned int i;
+    em_sta_key_t sta_key;
 
-    dm_sta_t::parse_sta_bss_radio_from_key(key, sta_mac, bssid, ruid);
-    dm_easy_mesh_t::macbytes_to_string(sta_mac, sta_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(bssid, bssid_str);
-    dm_easy_mesh_t::macbytes_to_string(ruid, radio_mac_str);
-
-    dm = static_cast<dm_easy_mesh_t *> (hash_map_get_first(m_list));
-    while (dm != NULL) {
-        for (i = 0; i < dm->m_num_radios; i++) {
-            if (memcmp(dm->m_radio[i].m_radio_info.intf.mac, ruid, sizeof(mac_address_t)) == 0) {
-                found = true;
-                break;
-            }
-        }
+    dm_sta_t::parse_key(key, &sta_key);
+    put_sta(&sta_key, sta);
+}
 
-        if (found == true) {
-            break;
-        }
-        dm = static_cast<dm_easy_mesh_t *> (hash_map_get_next(m_list, dm));
-    }
+void dm_easy_mesh_list_t::put_sta(const em_sta_key_t *key, const dm_sta_t *sta)
+{
+    dm_sta_t *psta;
+    dm_easy_mesh_t *dm;
+    mac_addr_str_t	radio_mac_str;
+    em_long_string_t str;
 
-    if (found == false) {
-        printf("%s:%d: Could not find dm with radio:%s\n", __func__, __LINE__, radio_mac_str);
+    if ((dm = find_dm_by_radio(key->ruid)) == NULL) {
+        printf("%s:%d: Could not find dm with radio:%s\n", __func__, __LINE__,
+                dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *> (key->ruid), radio_mac_str));
         return;
     }
 
-    if ((psta = static_cast<dm_sta_t *> (hash_map_get(dm->m_sta_map, key))) != NULL) {
-        //printf("%s:%d: STA:%s already present on BSS:%s of radio:%s\n", __func__, __LINE__,
-        //		sta_mac_str, bssid_str, radio_mac_str);
+    dm_sta_t::key_to_string(key, str);
+    if ((psta = static_cast<dm_sta_t *> (hash_map_get(dm->m_sta_map, str))) != NULL) {
         memcpy(&psta->m_sta_info, &sta->m_sta_info, sizeof(em_sta_info_t));
         return;
     }
 
     psta = new dm_sta_t(*sta);
-    hash_map_put(dm->m_sta_map, strdup(key), psta);
-
-    //printf("%s:%d: STA:%s added to BSS:%s of radio:%s\n", __func__, __LINE__,
-            //sta_mac_str, bssid_str, radio_mac_str);
+    hash_map_put(dm->m_sta_map, strdup(str), psta);
 }
 
 dm_network_ssid_t *dm_easy_mesh_list_t::get_first_network_ssid()
@@ -1184,8 +1198,7 @@ dm_scan_result_t *dm_easy_mesh_list_t::get_first_scan_result()
 
     dm = static_cast<dm_easy_mesh_t *> (hash_map_get_first(m_list));
     while (dm != NULL) {
-		res = static_cast<dm_scan_result_t *> (hash_map_get_first(dm->m_scan_result_map));
-		if (res != NULL) {
+		if ((res = dm->m_scan_result_store->get_first()) != NULL) {
 			return res;
 		}
 		
@@ -1201,17 +1214,18 @@ dm_scan_result_t *dm_easy_mesh_list_t::get_next_scan_result(dm_scan_result_t *sc
 	dm_scan_result_t *res;
     bool return_next = false;
 
+	// the owning store continues from the result's own position, only data models are walked
     dm = static_cast<dm_easy_mesh_t *> (hash_map_get_first(m_list));
     while (dm != NULL) {
-		res = static_cast<dm_scan_result_t *> (hash_map_get_first(dm->m_scan_result_map));
-		while (res != NULL) {
-			if (return_next == true) {
+		if (return_next == true) {
+			if ((res = dm->m_scan_result_store->get_first()) != NULL) {
 				return res;
 			}
-			if (res == scan_result) {
-				return_next = true;
+		} else if (dm->m_scan_result_store->contains(scan_result) == true) {
+			if ((res = dm->m_scan_result_store->get_next(scan_result)) != NULL) {
+				return res;
 			}
-			res = static_cast<dm_scan_result_t *> (hash_map_get_next(dm->m_scan_result_map, res));
+			return_next = true;
 		}
 
         dm = static_cast<dm_easy_mesh_t *> (hash_map_get_next(m_list, dm));
@@ -1224,74 +1238,66 @@ dm_scan_result_t *dm_easy_mesh_list_t::get_scan_result(const char *key)
 {
 	em_scan_result_id_t	id;
 	dm_easy_mesh_t	*dm;
-	mac_addr_str_t	dev_mac_str, scanner_mac_str;
-	dm_scan_result_t *res;
-	em_2xlong_string_t list_key;
+	mac_addr_str_t	dev_mac_str;
 	
 	dm_scan_result_t::parse_scan_result_id_from_key(key, &id);
-	dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
-	dm_easy_mesh_t::macbytes_to_string(id.scanner_mac, scanner_mac_str);	
 	
 	if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+		dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
 		printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
 		return NULL;
 	} 
 
-	snprintf(list_key, sizeof(em_2xlong_string_t), "%s@%s@%s@%d@%d@%d", id.net_id, dev_mac_str, scanner_mac_str,
-		id.op_class, id.channel, id.scanner_type);	
+	return dm->m_scan_result_store->find(&id);
+}
+
+dm_sta_t *dm_easy_mesh_list_t::find_scanner_sta(dm_easy_mesh_t *dm, mac_address_t sta_mac)
+{
+	em_sta_key_t sta_key;
+	em_long_string_t key;
+	dm_sta_t *sta;
+	unsigned int i;
 
-	res = static_cast<dm_scan_result_t *> (hash_map_get(dm->m_scan_result_map, list_key));
+	// STAs are keyed by sta@bssid@ruid, probe the BSSs of the device before walking every STA
+	memcpy(sta_key.sta, sta_mac, sizeof(mac_address_t));
+	for (i = 0; i < dm->m_num_bss; i++) {
+		memcpy(sta_key.bssid, dm->m_bss[i].m_bss_info.bssid.mac, sizeof(bssid_t));
+		memcpy(sta_key.ruid, dm->m_bss[i].m_bss_info.ruid.mac, sizeof(mac_address_t));
+		if ((sta = static_cast<dm_sta_t *> (hash_map_get(dm->m_sta_map, dm_sta_t::key_to_string(&sta_key, key)))) != NULL) {
+			return sta;
+		}
+	}
 
-	return res;
+	return dm->get_first_sta(sta_mac);
 }
 
 void dm_easy_mesh_list_t::remove_scan_result(const char *key)
 {
     em_scan_result_id_t id;
-    mac_addr_str_t	dev_mac_str, scanner_mac_str, bssid_str;
+    mac_addr_str_t	dev_mac_str;
     bssid_t bssid;
     dm_easy_mesh_t *dm;
-    dm_scan_result_t *res;
     dm_sta_t *sta;
     int i;
     int index_to_remove = -1;
-    em_2xlong_string_t list_key;
-    bool found_sta = false;
     wifi_BeaconReport_t *rprt;
 
     dm_scan_result_t::parse_scan_result_id_from_key(key, &id, bssid);
 
-    dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(id.scanner_mac, scanner_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(bssid, bssid_str);
-
     if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+        dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
         printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
         return;
     }
 
-    snprintf(list_key, sizeof(em_2xlong_string_t), "%s@%s@%s@%d@%d@%d", id.net_id, dev_mac_str, scanner_mac_str,
-        id.op_class, id.channel, id.scanner_type);
-
-    if ((res = static_cast<dm_scan_result_t *> (hash_map_remove(dm->m_scan_result_map, list_key))) != NULL) {
-        delete res;
-    }
+    dm->m_scan_result_store->remove(&id);
 
     // now if the result is from sta beacon report, find the sta and populate the structure
     if (id.scanner_type == em_scanner_type_radio) {
         return;
     }
 
-    sta = static_cast<dm_sta_t *> (hash_map_get_first(dm->m_sta_map));
-        while (sta != NULL) {
-            if (memcmp(sta->m_sta_info.id, id.scanner_mac, sizeof(mac_address_t)) == 0) {
-                found_sta = true;
-                break;
-            }
-        sta = static_cast<dm_sta_t *> (hash_map_get_next(dm->m_sta_map, sta));
-    }
-
-    if (found_sta == false) {
+    if ((sta = find_scanner_sta(dm, id.scanner_mac)) == NULL) {
         return;
     }
 
@@ -1320,79 +1326,46 @@ void dm_easy_mesh_list_t::put_scan_result(const char *key, const dm_scan_result_
 {
 	em_scan_result_id_t	id;
 	dm_easy_mesh_t	*dm;
-	mac_addr_str_t	dev_mac_str, scanner_mac_str;
+	mac_addr_str_t	dev_mac_str;
 	dm_scan_result_t *res;
 	dm_sta_t *sta;
 	bssid_t bssid;
-	bool found_neighbor = false, found_sta = false;
-	unsigned int i;
-	em_neighbor_t *nbr;
-	em_2xlong_string_t list_key;
+	em_neighbor_t nbr;
 	wifi_BeaconReport_t *rprt;
 	
 	dm_scan_result_t::parse_scan_result_id_from_key(key, &id, bssid);
 
-	dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
-	dm_easy_mesh_t::macbytes_to_string(id.scanner_mac, scanner_mac_str);
-
 	if ((dm = get_data_model(id.net_id, id.dev_mac)) == NULL) {
+		dm_easy_mesh_t::macbytes_to_string(id.dev_mac, dev_mac_str);
 		printf("%s:%d: Could not find data model for Network: %s and dev: %s\n", __func__, __LINE__, id.net_id, dev_mac_str);
 		return;
 	}
 		
-	snprintf(list_key, sizeof(em_2xlong_string_t), "%s@%s@%s@%d@%d@%d", id.net_id, dev_mac_str, scanner_mac_str, 
-    							id.op_class, id.channel, id.scanner_type);
-
-	if ((res = static_cast<dm_scan_result_t *> (hash_map_get(dm->m_scan_result_map, list_key))) == NULL) {
-		//printf("%s:%d: New Scan Result\tnetwork: %s\tdevice: %s\tradio: %s\topclass: %d\tchannel: %d\tScanner Type: %d\n", 
-				//__func__, __LINE__, id.net_id, dev_mac_str, scanner_mac_str, id.op_class, id.channel, id.scanner_type);	
-		res = new dm_scan_result_t();
-		
-		hash_map_put(dm->m_scan_result_map, strdup(list_key), res);
-
+	if ((res = dm->m_scan_result_store->find(&id)) == NULL) {
+		res = dm->m_scan_result_store->create(&id);
 		memcpy(&res->m_scan_result, &scan_result->m_scan_result, sizeof(em_scan_result_t));
 		
 		// increase the neighbors by 1
-		res->m_scan_result.num_neighbors++;		
-	} else {
-		//printf("%s:%d: Existing Scan Result\tnetwork: %s\tdevice: %s\tradio: %s\topclass: %d\tchannel: %d\tScanner Type: %d\n", 
-				//__func__, __LINE__, id.net_id, dev_mac_str, scanner_mac_str, id.op_class, id.channel, id.scanner_type);	
-		for (i = 0; i < res->m_scan_result.num_neighbors; i++) {
-			nbr = &res->m_scan_result.neighbor[i];
-
-			if (memcmp(nbr->bssid, bssid, sizeof(mac_address_t)) == 0) {
-				found_neighbor = true;
-				memcpy(nbr, &scan_result->m_scan_result.neighbor[index], sizeof(em_neighbor_t));
-				break;
-			}
-		}
-
-		if (found_neighbor == false) {
-			if (res->m_scan_result.num_neighbors >= EM_MAX_NEIGHBORS) {
-				return;
-			}
-			nbr = &res->m_scan_result.neighbor[res->m_scan_result.num_neighbors];
-			memcpy(nbr, &scan_result->m_scan_result.neighbor[index], sizeof(em_neighbor_t));
+		if (res->m_scan_result.num_neighbors < EM_MAX_NEIGHBORS) {
 			res->m_scan_result.num_neighbors++;
 		}
+		res->reindex_neighbors();
+	} else {
+		// the row key carries the bssid, the neighbor is looked up through the per result index
+		memcpy(&nbr, &scan_result->m_scan_result.neighbor[index], sizeof(em_neighbor_t));
+		memcpy(nbr.bssid, bssid, sizeof(bssid_t));
+		if (res->upsert_neighbor(&nbr) < 0) {
+			return;
+		}
 	}
+	res->touch();
 
 	// now if the result is from sta beacon report, find the sta and populate the structure
 	if (id.scanner_type == em_scanner_type_radio) {
 		return;
 	} 
 
-	sta = static_cast<dm_sta_t *> (hash_map_get_first(dm->m_sta_map));
-	while (sta != NULL) {
-
-		if (memcmp(sta->m_sta_info.id, id.scanner_mac, sizeof(mac_address_t)) == 0) {
-			found_sta = true;
-			break;
-		}
-		sta = static_cast<dm_sta_t *> (hash_map_get_next(dm->m_sta_map, sta));
-	}		
-
-	if (found_sta == false) {
+	if ((sta = find_scanner_sta(dm, id.scanner_mac)) == NULL) {
 		return;
 	}
 
@@ -1426,6 +1399,7 @@ void dm_easy_mesh_list_t::delete_all_data_models()
 		snprintf(key, sizeof(em_2xlong_string_t), "%s@%s", dev->m_device_info.id.net_id, mac_str);
 
 		hash_map_remove(m_list, key);
+		unindex_data_model(tmp);
 		delete tmp;
     }   
 
@@ -1444,6 +1418,7 @@ void dm_easy_mesh_list_t::delete_data_model(const char *net_id, const unsigned c
     dm = static_cast<dm_easy_mesh_t *> (hash_map_remove(m_list, key));
 
     //printf("%s:%d: deleteing data model at key: %s, dm:%p, colocated:%d\n", __func__, __LINE__, key, dm, dm->get_colocated());
+    unindex_data_model(dm);
     dm->deinit();
     delete dm;
 }
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "dm_metrics_rollup_list.h"
+#include "dm_easy_mesh.h"
+
+static inline int dm_metrics_rollup_clamp(long long val)
+{
+	if (val > INT_MAX) {
+		return INT_MAX;
+	} else if (val < INT_MIN) {
+		return INT_MIN;
+	}
+
+	return static_cast<int> (val);
+}
+
+int dm_metrics_rollup_list_t::persist(db_client_t& db_client, const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, const em_metrics_bucket_t *bucket)
+{
+	em_metrics_rollup_info_t info;
+
+	if (bucket->count == 0) {
+		return 0;
+	}
+
+	memset(&info, 0, sizeof(em_metrics_rollup_info_t));
+	dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *> (mac), info.entity);
+	snprintf(info.metric, sizeof(info.metric), "%s", em_metrics_store_t::get_metric_str(id));
+	snprintf(info.id, sizeof(em_long_string_t), "%s@%s@%u@%u", info.entity, info.metric, resolution, bucket->start);
+	info.resolution = resolution;
+	info.start = bucket->start;
+	info.count = bucket->count;
+	info.min = dm_metrics_rollup_clamp(bucket->min);
+	info.max = dm_metrics_rollup_clamp(bucket->max);
+	info.avg = dm_metrics_rollup_clamp(bucket->sum / bucket->count);
+	info.p95 = dm_metrics_rollup_clamp(bucket->p95);
+
+	return update_db(db_client, dm_orch_type_db_insert, &info);
+}
+
+int dm_metrics_rollup_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void *data)
+{
+	em_metrics_rollup_info_t *info = static_cast<em_metrics_rollup_info_t *> (data);
+	int ret = 0;
+
+	switch (op) {
+		case dm_orch_type_db_insert:
+			ret = insert_row(db_client, info->id, info->entity, info->metric, info->resolution, info->start,
+				info->count, info->min, info->max, info->avg, info->p95);
+			break;
+
+		case dm_orch_type_db_delete:
+			ret = delete_row(db_client, info->id);
+			break;
+
+		default:
+			break;
+	}
+
+	return ret;
+}
+
+int dm_metrics_rollup_list_t::sync_db(db_client_t& db_client, void *ctx)
+{
+	// history is only read by external tools, drain the result set
+	while (db_client.next_result(ctx));
+
+	return 0;
+}
+
+bool dm_metrics_rollup_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
+{
+	return false;
+}
+
+bool dm_metrics_rollup_list_t::operator == (const db_easy_mesh_t& obj)
+{
+	return false;
+}
+
+int dm_metrics_rollup_list_t::set_config(db_client_t& db_client, const cJSON *obj, void *parent_id)
+{
+	return 0;
+}
+
+int dm_metrics_rollup_list_t::get_config(cJSON *obj, void *parent_id, bool summary)
+{
+	return 0;
+}
+
+void dm_metrics_rollup_list_t::init_table()
+{
+	snprintf(m_table_name, sizeof(m_table_name), "%s", "MetricsRollup");
+}
+
+void dm_metrics_rollup_list_t::init_columns()
+{
+	m_num_cols = 0;
+
+	m_columns[m_num_cols++] = db_column_t("ID", db_data_type_char, 64);
+	m_columns[m_num_cols++] = db_column_t("Entity", db_data_type_char, 17);
+	m_columns[m_num_cols++] = db_column_t("Metric", db_data_type_char, 16);
+	m_columns[m_num_cols++] = db_column_t("Resolution", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("StartTime", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("Samples", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("MinValue", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("MaxValue", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("AvgValue", db_data_type_int, 0);
+	m_columns[m_num_cols++] = db_column_t("P95Value", db_data_type_int, 0);
+}
+
+int dm_metrics_rollup_list_t::init()
+{
+	init_table();
+	init_columns();
+	return 0;
+}
+
+dm_metrics_rollup_list_t::dm_metrics_rollup_list_t()
+{
+
+}
+
+dm_metrics_rollup_list_t::~dm_metrics_rollup_list_t()
+{
+
+}
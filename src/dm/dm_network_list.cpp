@@ -98,7 +98,7 @@ dm_orch_type_t dm_network_list_t::get_dm_orch_type(db_client_t& db_client, const
     pnet = get_network(net.m_net_info.id);
 
     if (pnet != NULL) {
-        if (entry_exists_in_table(db_client, const_cast<char *> (net.m_net_info.id)) == false) {
+        if (is_persisted(net.m_net_info.id) == false) {
             return dm_orch_type_db_insert;
         }
         if (*pnet == net) {
@@ -187,6 +187,10 @@ int dm_network_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void
 
 	}
 
+    if (ret == 0) {
+        set_persisted((info == NULL) ? m_net_info.id:info->id, op, info, sizeof(em_network_info_t));
+    }
+
     return ret;
 }
 
@@ -207,7 +211,7 @@ bool dm_network_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
 
 int dm_network_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
-    mac_addr_str_t	mac;
+    db_row_t row;
     em_network_info_t info;
     int rc = 0;
 	char date_time[EM_DATE_TIME_BUFF_SZ];
@@ -217,19 +221,18 @@ int dm_network_list_t::sync_db(db_client_t& db_client, void *ctx)
 	strncpy(info.timestamp, date_time, sizeof(em_long_string_t));
 
     // there is only one row in network
-    while (db_client.next_result(ctx)) {
-		db_client.get_string(ctx, info.id, 1);
-		db_client.get_string(ctx, mac, 2);
-		dm_easy_mesh_t::string_to_macbytes(mac, info.ctrl_id.mac);
+    while (db_client.next_row(ctx, row)) {
+		row.get_string(1, info.id, sizeof(info.id));
+		row.get_mac(2, info.ctrl_id.mac);
 
-		db_client.get_string(ctx, mac, 3);
-		dm_easy_mesh_t::string_to_macbytes(mac, info.colocated_agent_id.mac);
+		row.get_mac(3, info.colocated_agent_id.mac);
 
-		info.media = static_cast<em_media_type_t> (db_client.get_number(ctx, 4));
+		info.media = static_cast<em_media_type_t> (row.get_number(4));
 
 		info.ctrl_id.media = info.media;
 		info.colocated_agent_id.media = info.media;
 
+		set_persisted(info.id, dm_orch_type_db_insert, &info, sizeof(em_network_info_t));
 		update_list(dm_network_t(&info), dm_orch_type_db_insert);
     }
     return rc;
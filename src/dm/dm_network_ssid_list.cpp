@@ -382,20 +382,20 @@ bool dm_network_ssid_list_t::search_db(db_client_t& db_client, void *ctx, void *
 int dm_network_ssid_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
 	em_network_ssid_info_t info;
-	mac_addr_str_t	mac;
+	db_row_t row;
     em_long_string_t   str;
     char   *token_parts[10];
     em_string_t haul_type[10];
 	unsigned int i;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
 		memset(&info, 0, sizeof(em_network_ssid_info_t));
 
-		db_client.get_string(ctx, info.id, 1);
-		db_client.get_string(ctx, info.ssid, 2);
-        db_client.get_string(ctx, info.pass_phrase, 3);
-		db_client.get_string(ctx, str, 4);
+		row.get_string(1, info.id, sizeof(info.id));
+		row.get_string(2, info.ssid, sizeof(info.ssid));
+        row.get_string(3, info.pass_phrase, sizeof(info.pass_phrase));
+		row.get_string(4, str, sizeof(str));
 		for (i = 0; i < EM_MAX_BANDS; i++) {
 			token_parts[i] = info.band[i];
 		}
@@ -404,9 +404,9 @@ int dm_network_ssid_list_t::sync_db(db_client_t& db_client, void *ctx)
 			//printf("%s:%d: Band[%d]: %s\n", __func__, __LINE__, i, info.band[i]);
 		}
 
-        info.enable = db_client.get_number(ctx, 5);
+        info.enable = row.get_number(5);
 
-		db_client.get_string(ctx, str, 6);
+		row.get_string(6, str, sizeof(str));
 		for (i = 0; i < EM_MAX_AKMS; i++) {
 			token_parts[i] = info.akm[i];
 		}
@@ -416,14 +416,13 @@ int dm_network_ssid_list_t::sync_db(db_client_t& db_client, void *ctx)
 		}
 
 
-		db_client.get_string(ctx, info.suite_select, 7);
-		info.advertisement = db_client.get_number(ctx, 8);
-		db_client.get_string(ctx, info.mfp, 9);
+		row.get_string(7, info.suite_select, sizeof(info.suite_select));
+		info.advertisement = row.get_number(8);
+		row.get_string(9, info.mfp, sizeof(info.mfp));
 
-		db_client.get_string(ctx, mac, 10);
-		dm_easy_mesh_t::string_to_macbytes(mac, info.mobility_domain);
+		row.get_mac(10, info.mobility_domain);
 
-		db_client.get_string(ctx, str, 11);
+		row.get_string(11, str, sizeof(str));
 		for (i = 0; i < EM_MAX_HAUL_TYPES; i++) {
 			token_parts[i] = haul_type[i];
 		}
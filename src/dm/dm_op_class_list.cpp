@@ -161,7 +161,7 @@ dm_orch_type_t dm_op_class_list_t::get_dm_orch_type(db_client_t& db_client, cons
     pop_class = get_op_class(key);
     if (pop_class != NULL) {
 
-        if (entry_exists_in_table(db_client, key) == false) {
+        if (is_persisted(key) == false) {
             //printf("%s:%d: Op Class: %s does not exist in db\n", __func__, __LINE__, key);
             return dm_orch_type_db_insert;
         }
@@ -268,6 +268,10 @@ int dm_op_class_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, voi
 	        break;
 	}
 
+    if (ret == 0) {
+        set_persisted(id, op, info, sizeof(em_op_class_info_t));
+    }
+
     return ret;
 }
 
@@ -289,21 +293,22 @@ bool dm_op_class_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
 int dm_op_class_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_op_class_info_t info;
+    db_row_t row;
     em_long_string_t   str, id;
     em_short_string_t	ch_str[EM_MAX_CHANNELS_IN_LIST];
     char   *token_parts[EM_MAX_CHANNELS_IN_LIST];
     unsigned int i = 0;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
         memset(&info, 0, sizeof(em_op_class_info_t));
 
-        db_client.get_string(ctx, id, 1);
+        row.get_string(1, id, sizeof(id));
         dm_op_class_t::parse_op_class_id_from_key(id, &info.id);
-        info.op_class = static_cast<short unsigned int>(db_client.get_number(ctx, 2));
-        info.channel = static_cast<short unsigned int>(db_client.get_number(ctx, 3));
+        info.op_class = static_cast<short unsigned int>(row.get_number(2));
+        info.channel = static_cast<short unsigned int>(row.get_number(3));
         
-		db_client.get_string(ctx, str, 4);
+		row.get_string(4, str, sizeof(str));
 		for (i = 0; i < EM_MAX_CHANNELS_IN_LIST; i++) {
             token_parts[i] = ch_str[i];
         }
@@ -315,13 +320,14 @@ int dm_op_class_list_t::sync_db(db_client_t& db_client, void *ctx)
 			}
 		}
 
-        info.tx_power = db_client.get_number(ctx, 5);
-        info.max_tx_power = db_client.get_number(ctx, 6);
+        info.tx_power = row.get_number(5);
+        info.max_tx_power = row.get_number(6);
 
-        info.mins_since_cac_comp = static_cast<short unsigned int>(db_client.get_number(ctx, 7));
-        info.sec_remain_non_occ_dur = static_cast<short unsigned int>(db_client.get_number(ctx, 8));
-        info.countdown_cac_comp = static_cast<unsigned int>(db_client.get_number(ctx, 9));
+        info.mins_since_cac_comp = static_cast<short unsigned int>(row.get_number(7));
+        info.sec_remain_non_occ_dur = static_cast<short unsigned int>(row.get_number(8));
+        info.countdown_cac_comp = static_cast<unsigned int>(row.get_number(9));
 
+        set_persisted(id, dm_orch_type_db_insert, &info, sizeof(em_op_class_info_t));
         update_list(dm_op_class_t(&info), dm_orch_type_db_insert);
     }
 
@@ -165,7 +165,7 @@ dm_orch_type_t dm_policy_list_t::get_dm_orch_type(db_client_t& db_client, const
     ppolicy = get_policy(key);
     if (ppolicy != NULL) {
 
-        if (entry_exists_in_table(db_client, key) == false) {
+        if (is_persisted(key) == false) {
             return dm_orch_type_db_insert;
         }
 
@@ -285,6 +285,10 @@ int dm_policy_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void
 	        break;
 	}
 
+    if (ret == 0) {
+        set_persisted(key, op, policy, sizeof(em_policy_t));
+    }
+
     return ret;
 }
 
@@ -306,24 +310,25 @@ bool dm_policy_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
 int dm_policy_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_policy_t policy;
+    db_row_t row;
 	em_policy_id_t	id;
-    em_long_string_t   str;
+    em_long_string_t   key;
 	char sta_mac_list_str[1024] = {0};
 	char   *token_parts[EM_MAX_STA_PER_STEER_POLICY];
 	em_short_string_t	sta_mac_str[EM_MAX_STA_PER_STEER_POLICY];	
 	unsigned int i;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
         memset(&policy, 0, sizeof(em_policy_t));
 
-        db_client.get_string(ctx, str, 1);
-		dm_policy_t::parse_dev_radio_mac_from_key(str, &id);
+        row.get_string(1, key, sizeof(key));
+		dm_policy_t::parse_dev_radio_mac_from_key(key, &id);
 		memcpy(policy.id.dev_mac, id.dev_mac, sizeof(mac_address_t));
 		memcpy(policy.id.radio_mac, id.radio_mac, sizeof(mac_address_t));
 		policy.id.type = id.type;
 
-		db_client.get_string(ctx, sta_mac_list_str, 2);
+		row.get_string(2, sta_mac_list_str, sizeof(sta_mac_list_str));
 		for (i = 0; i < EM_MAX_STA_PER_STEER_POLICY; i++) {
             token_parts[i] = sta_mac_str[i];
         }
@@ -333,19 +338,20 @@ int dm_policy_list_t::sync_db(db_client_t& db_client, void *ctx)
 			dm_easy_mesh_t::string_to_macbytes(sta_mac_str[i], policy.sta_mac[i]);
 		}		
 
-		policy.policy = static_cast<em_steering_policy_type_t>(db_client.get_number(ctx, 3));
-		policy.interval = static_cast<short unsigned int>(db_client.get_number(ctx, 4));
-		policy.rcpi_threshold = static_cast<short unsigned int>(db_client.get_number(ctx, 5));
-		policy.rcpi_hysteresis = static_cast<short unsigned int>(db_client.get_number(ctx, 6));
-		policy.util_threshold = static_cast<short unsigned int>(db_client.get_number(ctx, 7));
-		policy.sta_traffic_stats = db_client.get_number(ctx, 8);
-		policy.sta_link_metric = db_client.get_number(ctx, 9);
-		policy.sta_status = db_client.get_number(ctx, 10);
-		db_client.get_string(ctx, policy.managed_sta_marker, 11);
-		policy.independent_scan_report = db_client.get_number(ctx, 12);
-		policy.profile_1_sta_disallowed = db_client.get_number(ctx, 13);
-		policy.profile_2_sta_disallowed = db_client.get_number(ctx, 14);
+		policy.policy = static_cast<em_steering_policy_type_t>(row.get_number(3));
+		policy.interval = static_cast<short unsigned int>(row.get_number(4));
+		policy.rcpi_threshold = static_cast<short unsigned int>(row.get_number(5));
+		policy.rcpi_hysteresis = static_cast<short unsigned int>(row.get_number(6));
+		policy.util_threshold = static_cast<short unsigned int>(row.get_number(7));
+		policy.sta_traffic_stats = row.get_number(8);
+		policy.sta_link_metric = row.get_number(9);
+		policy.sta_status = row.get_number(10);
+		row.get_string(11, policy.managed_sta_marker, sizeof(policy.managed_sta_marker));
+		policy.independent_scan_report = row.get_number(12);
+		policy.profile_1_sta_disallowed = row.get_number(13);
+		policy.profile_2_sta_disallowed = row.get_number(14);
         
+		set_persisted(key, dm_orch_type_db_insert, &policy, sizeof(em_policy_t));
 		update_list(dm_policy_t(&policy), dm_orch_type_db_insert);
     }
 
@@ -194,14 +194,13 @@ bool dm_radio_cap_list_t::search_db(db_client_t& db_client, void *ctx, void *key
 int dm_radio_cap_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_radio_cap_info_t info;
-    mac_addr_str_t	mac_str;
+    db_row_t row;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
 	memset(&info, 0, sizeof(em_radio_cap_info_t));
 
-	db_client.get_string(ctx, mac_str, 1);
-	dm_easy_mesh_t::string_to_macbytes(mac_str, info.ruid.mac);
+	row.get_mac(1, info.ruid.mac);
 
 	//db_client.get_string(ctx, info.ht_cap, 2);
 	//db_client.get_string(ctx, info.vht_cap, 3);
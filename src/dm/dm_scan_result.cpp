@@ -161,6 +161,7 @@ void dm_scan_result_t::operator = (const dm_scan_result_t& obj)
 {
 	if (this == &obj) { return; }
 	memcpy(&m_scan_result, &obj.m_scan_result, sizeof(em_scan_result_t));
+	reindex_neighbors();
 }
 
 int dm_scan_result_t::parse_scan_result_id_from_key(const char *key, em_scan_result_id_t *id, unsigned char *bssid)
@@ -241,27 +242,258 @@ bool dm_scan_result_t::has_same_id(em_scan_result_id_t *id)
 	return true;
 }
 
-dm_scan_result_t::dm_scan_result_t(em_scan_result_t *scan_result)
+void dm_scan_result_t::make_key(const em_scan_result_id_t *id, dm_scan_result_key_t *key)
+{
+	memcpy(key->dev_mac, id->dev_mac, sizeof(mac_address_t));
+	memcpy(key->scanner_mac, id->scanner_mac, sizeof(mac_address_t));
+	key->op_class = id->op_class;
+	key->channel = id->channel;
+	key->scanner_type = static_cast<unsigned char> (id->scanner_type);
+}
+
+static inline unsigned int dm_scan_result_bssid_slot(const unsigned char *bssid)
+{
+	// the NIC specific octets carry the entropy
+	return static_cast<unsigned int> ((bssid[3] * 31u + bssid[4]) * 31u + bssid[5]) % EM_SCAN_RESULT_NBR_SLOTS;
+}
+
+int dm_scan_result_t::find_neighbor(const unsigned char *bssid)
+{
+	unsigned int slot = dm_scan_result_bssid_slot(bssid), i;
+	unsigned char idx;
+
+	for (i = 0; i < EM_SCAN_RESULT_NBR_SLOTS; i++) {
+		if ((idx = m_nbr_slot[slot]) == 0) {
+			return -1;
+		}
+		if (memcmp(m_scan_result.neighbor[idx - 1].bssid, bssid, sizeof(bssid_t)) == 0) {
+			return idx - 1;
+		}
+		slot = (slot + 1) % EM_SCAN_RESULT_NBR_SLOTS;
+	}
+
+	return -1;
+}
+
+int dm_scan_result_t::upsert_neighbor(const em_neighbor_t *nbr)
+{
+	unsigned int slot, i;
+	int idx;
+
+	if (m_scan_result.num_neighbors > EM_MAX_NEIGHBORS) {
+		m_scan_result.num_neighbors = EM_MAX_NEIGHBORS;
+		reindex_neighbors();
+	}
+
+	if ((idx = find_neighbor(nbr->bssid)) >= 0) {
+		memcpy(&m_scan_result.neighbor[idx], nbr, sizeof(em_neighbor_t));
+		return idx;
+	}
+
+	if (m_scan_result.num_neighbors >= EM_MAX_NEIGHBORS) {
+		return -1;
+	}
+
+	idx = static_cast<int> (m_scan_result.num_neighbors);
+	memcpy(&m_scan_result.neighbor[idx], nbr, sizeof(em_neighbor_t));
+	m_scan_result.num_neighbors++;
+
+	slot = dm_scan_result_bssid_slot(nbr->bssid);
+	for (i = 0; i < EM_SCAN_RESULT_NBR_SLOTS; i++) {
+		if (m_nbr_slot[slot] == 0) {
+			m_nbr_slot[slot] = static_cast<unsigned char> (idx + 1);
+			break;
+		}
+		slot = (slot + 1) % EM_SCAN_RESULT_NBR_SLOTS;
+	}
+
+	return idx;
+}
+
+void dm_scan_result_t::reindex_neighbors()
+{
+	unsigned int i, j, slot, num = m_scan_result.num_neighbors;
+
+	memset(m_nbr_slot, 0, sizeof(m_nbr_slot));
+	if (num > EM_MAX_NEIGHBORS) {
+		num = EM_MAX_NEIGHBORS;
+	}
+
+	for (i = 0; i < num; i++) {
+		// duplicates written directly into neighbor[] resolve to the first entry
+		if (find_neighbor(m_scan_result.neighbor[i].bssid) >= 0) {
+			continue;
+		}
+		slot = dm_scan_result_bssid_slot(m_scan_result.neighbor[i].bssid);
+		for (j = 0; j < EM_SCAN_RESULT_NBR_SLOTS; j++) {
+			if (m_nbr_slot[slot] == 0) {
+				m_nbr_slot[slot] = static_cast<unsigned char> (i + 1);
+				break;
+			}
+			slot = (slot + 1) % EM_SCAN_RESULT_NBR_SLOTS;
+		}
+	}
+}
+
+void dm_scan_result_t::touch()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	m_last_update = ts.tv_sec;
+}
+
+dm_scan_result_t::dm_scan_result_t(em_scan_result_t *scan_result) : m_store_index(0), m_last_update(0), m_nbr_slot()
 {
     memcpy(&m_scan_result, scan_result, sizeof(em_scan_result_t));
+	reindex_neighbors();
 }
 
-dm_scan_result_t::dm_scan_result_t(const dm_scan_result_t& scan_result)
+dm_scan_result_t::dm_scan_result_t(const dm_scan_result_t& scan_result) : m_store_index(0), m_last_update(scan_result.m_last_update), m_nbr_slot()
 {
     memcpy(&m_scan_result, &scan_result.m_scan_result, sizeof(em_scan_result_t));
+	reindex_neighbors();
 }
 
-dm_scan_result_t::dm_scan_result_t(const em_scan_result_t& scan_result)
+dm_scan_result_t::dm_scan_result_t(const em_scan_result_t& scan_result) : m_store_index(0), m_last_update(0), m_nbr_slot()
 {
     memcpy(&m_scan_result, &scan_result, sizeof(em_scan_result_t));
+	reindex_neighbors();
 }
 
-dm_scan_result_t::dm_scan_result_t()
+dm_scan_result_t::dm_scan_result_t() : m_store_index(0), m_last_update(0), m_nbr_slot()
 {
 	memset(&m_scan_result, 0, sizeof(em_scan_result_t));
+	memset(m_nbr_slot, 0, sizeof(m_nbr_slot));
 }
 
 dm_scan_result_t::~dm_scan_result_t()
 {
 
 }
+
+size_t dm_scan_result_key_hash_t::operator()(const dm_scan_result_key_t& key) const
+{
+	const unsigned char *p = reinterpret_cast<const unsigned char *> (&key);
+	size_t h = 14695981039346656037ULL, i;
+
+	for (i = 0; i < sizeof(dm_scan_result_key_t); i++) {
+		h ^= p[i];
+		h *= 1099511628211ULL;
+	}
+
+	return h;
+}
+
+void dm_scan_result_store_t::erase_at(unsigned int index)
+{
+	dm_scan_result_key_t key;
+	dm_scan_result_t *res = m_list[index];
+	unsigned int i;
+
+	dm_scan_result_t::make_key(&res->m_scan_result.id, &key);
+	m_map.erase(key);
+	m_list.erase(m_list.begin() + index);
+	for (i = index; i < m_list.size(); i++) {
+		m_list[i]->m_store_index = i;
+	}
+
+	delete res;
+}
+
+dm_scan_result_t *dm_scan_result_store_t::find(const em_scan_result_id_t *id)
+{
+	dm_scan_result_key_t key;
+
+	dm_scan_result_t::make_key(id, &key);
+	auto it = m_map.find(key);
+
+	return (it == m_map.end()) ? NULL:it->second;
+}
+
+dm_scan_result_t *dm_scan_result_store_t::create(const em_scan_result_id_t *id)
+{
+	dm_scan_result_key_t key;
+	dm_scan_result_t *res;
+
+	dm_scan_result_t::make_key(id, &key);
+	auto it = m_map.find(key);
+	if (it != m_map.end()) {
+		return it->second;
+	}
+
+	if (m_list.size() >= EM_MAX_SCAN_RESULTS) {
+		erase_at(0);
+	}
+
+	res = new dm_scan_result_t();
+	memcpy(&res->m_scan_result.id, id, sizeof(em_scan_result_id_t));
+	res->m_store_index = static_cast<unsigned int> (m_list.size());
+	res->touch();
+
+	m_list.push_back(res);
+	m_map[key] = res;
+
+	return res;
+}
+
+int dm_scan_result_store_t::remove(const em_scan_result_id_t *id)
+{
+	dm_scan_result_t *res;
+
+	if ((res = find(id)) == NULL) {
+		return -1;
+	}
+
+	erase_at(res->m_store_index);
+
+	return 0;
+}
+
+unsigned int dm_scan_result_store_t::expire(unsigned int max_age)
+{
+	dm_scan_result_key_t key;
+	struct timespec ts;
+	unsigned int i, kept = 0, removed = 0;
+	dm_scan_result_t *res;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	// compact in one pass so that aging a large store stays linear
+	for (i = 0; i < m_list.size(); i++) {
+		res = m_list[i];
+		if ((ts.tv_sec - res->m_last_update) > static_cast<time_t> (max_age)) {
+			dm_scan_result_t::make_key(&res->m_scan_result.id, &key);
+			m_map.erase(key);
+			delete res;
+			removed++;
+			continue;
+		}
+		res->m_store_index = kept;
+		m_list[kept++] = res;
+	}
+	m_list.resize(kept);
+
+	return removed;
+}
+
+void dm_scan_result_store_t::clear()
+{
+	unsigned int i;
+
+	for (i = 0; i < m_list.size(); i++) {
+		delete m_list[i];
+	}
+	m_list.clear();
+	m_map.clear();
+}
+
+dm_scan_result_store_t::dm_scan_result_store_t() : m_map(), m_list()
+{
+
+}
+
+dm_scan_result_store_t::~dm_scan_result_store_t()
+{
+	clear();
+}
@@ -142,7 +142,7 @@ dm_orch_type_t dm_scan_result_list_t::get_dm_orch_type(db_client_t& db_client, c
     pscan_result = get_scan_result(key);
     if (pscan_result != NULL) {
 
-        if (entry_exists_in_table(db_client, key) == false) {
+        if (is_persisted(key) == false) {
             return dm_orch_type_db_insert;
         }
 
@@ -185,8 +185,10 @@ void dm_scan_result_list_t::update_list(const dm_scan_result_t& scan_result, uns
             break;
 
         case dm_orch_type_db_update:
-            pscan_result = get_scan_result(key);
-            memcpy(&pscan_result->m_scan_result, &scan_result.m_scan_result, sizeof(em_scan_result_t));
+            if ((pscan_result = get_scan_result(key)) != NULL) {
+                *pscan_result = scan_result;
+                pscan_result->touch();
+            }
             break;
 
         case dm_orch_type_db_delete:
@@ -272,6 +274,10 @@ int dm_scan_result_list_t::update_db(db_client_t& db_client, dm_orch_type_t op,
 	        break;
 	}
 
+    if (ret == 0) {
+        set_persisted(key, op, nbr, sizeof(em_neighbor_t));
+    }
+
     return ret;
 }
 
@@ -293,16 +299,17 @@ bool dm_scan_result_list_t::search_db(db_client_t& db_client, void *ctx, void *k
 int dm_scan_result_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_scan_result_t scan_result;
+    db_row_t row;
 	em_scan_result_id_t	id;
-    em_long_string_t   str;
+    em_long_string_t   str, key;
 	int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
         memset(&scan_result, 0, sizeof(em_scan_result_t));
 
-        db_client.get_string(ctx, str, 1);
+        row.get_string(1, key, sizeof(key));
 		
-		dm_scan_result_t::parse_scan_result_id_from_key(str, &id);
+		dm_scan_result_t::parse_scan_result_id_from_key(key, &id);
 		memcpy(scan_result.id.net_id, id.net_id, sizeof(em_long_string_t));
 		memcpy(scan_result.id.dev_mac, id.dev_mac, sizeof(mac_address_t));
 		memcpy(scan_result.id.scanner_mac, id.scanner_mac, sizeof(mac_address_t));
@@ -311,27 +318,27 @@ int dm_scan_result_list_t::sync_db(db_client_t& db_client, void *ctx)
 		scan_result.id.channel = id.channel;
 		scan_result.id.scanner_type = id.scanner_type;
 
-		scan_result.scan_status = static_cast<unsigned char>(db_client.get_number(ctx, 2));
+		scan_result.scan_status = static_cast<unsigned char>(row.get_number(2));
 		
-		db_client.get_string(ctx, str, 3);
+		row.get_string(3, str, sizeof(str));
 		strncpy(scan_result.timestamp, str, sizeof(em_long_string_t));
 
-		scan_result.util = static_cast<unsigned char>(db_client.get_number(ctx, 4));
-		scan_result.noise = static_cast<unsigned char>(db_client.get_number(ctx, 5));
+		scan_result.util = static_cast<unsigned char>(row.get_number(4));
+		scan_result.noise = static_cast<unsigned char>(row.get_number(5));
 
-        db_client.get_string(ctx, str, 6);
-		dm_easy_mesh_t::string_to_macbytes(str, scan_result.neighbor[scan_result.num_neighbors].bssid);
+        row.get_mac(6, scan_result.neighbor[scan_result.num_neighbors].bssid);
 
-        db_client.get_string(ctx, str, 7);
+        row.get_string(7, str, sizeof(str));
 		snprintf(scan_result.neighbor[scan_result.num_neighbors].ssid, sizeof(ssid_t), "%.*s", static_cast<int>(sizeof(ssid_t) - 1), str);
-		scan_result.neighbor[scan_result.num_neighbors].signal_strength = static_cast<signed char>(db_client.get_number(ctx, 8));
-		scan_result.neighbor[scan_result.num_neighbors].bandwidth = static_cast<wifi_channelBandwidth_t>(db_client.get_number(ctx, 9));
-		scan_result.neighbor[scan_result.num_neighbors].bss_color = static_cast<unsigned char>(db_client.get_number(ctx, 10));
-		scan_result.neighbor[scan_result.num_neighbors].channel_util = static_cast<unsigned char>(db_client.get_number(ctx, 11));
-		scan_result.neighbor[scan_result.num_neighbors].sta_count = static_cast<short unsigned int>(db_client.get_number(ctx, 12));
-		scan_result.aggr_scan_duration = static_cast<unsigned int>(db_client.get_number(ctx, 13));
-		scan_result.scan_type = static_cast<unsigned char>(db_client.get_number(ctx, 14));
+		scan_result.neighbor[scan_result.num_neighbors].signal_strength = static_cast<signed char>(row.get_number(8));
+		scan_result.neighbor[scan_result.num_neighbors].bandwidth = static_cast<wifi_channelBandwidth_t>(row.get_number(9));
+		scan_result.neighbor[scan_result.num_neighbors].bss_color = static_cast<unsigned char>(row.get_number(10));
+		scan_result.neighbor[scan_result.num_neighbors].channel_util = static_cast<unsigned char>(row.get_number(11));
+		scan_result.neighbor[scan_result.num_neighbors].sta_count = static_cast<short unsigned int>(row.get_number(12));
+		scan_result.aggr_scan_duration = static_cast<unsigned int>(row.get_number(13));
+		scan_result.scan_type = static_cast<unsigned char>(row.get_number(14));
         
+		set_persisted(key, dm_orch_type_db_insert, &scan_result.neighbor[scan_result.num_neighbors], sizeof(em_neighbor_t));
 		update_list(dm_scan_result_t(&scan_result), scan_result.num_neighbors, dm_orch_type_db_insert);
 		scan_result.num_neighbors++;
     }
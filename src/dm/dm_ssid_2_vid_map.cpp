@@ -179,14 +179,15 @@ bool dm_ssid_2_vid_map_t::search_db(db_client_t& db_client, void *ctx, void *key
 int dm_ssid_2_vid_map_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_ssid_2_vid_map_info_t info;
+    db_row_t row;
     int rc = 0;
 
-    while (db_client.next_result(ctx)) {
+    while (db_client.next_row(ctx, row)) {
 	memset(&info, 0, sizeof(em_ssid_2_vid_map_info_t));
 
-	db_client.get_string(ctx, info.id, 1);
-	db_client.get_string(ctx, info.ssid, 2);
-        info.vid = static_cast<short unsigned int>(db_client.get_number(ctx, 3));
+	row.get_string(1, info.id, sizeof(info.id));
+	row.get_string(2, info.ssid, sizeof(info.ssid));
+        info.vid = static_cast<short unsigned int>(row.get_number(3));
         
 	update_list(dm_ssid_2_vid_map_t(&info));
     }
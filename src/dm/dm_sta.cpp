@@ -358,6 +358,80 @@ void dm_sta_t::parse_sta_bss_radio_from_key(const char *key, mac_address_t sta,
 
 }
 
+static inline int sta_key_nibble(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    } else if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+void dm_sta_t::parse_key(const char *key, em_sta_key_t *out)
+{
+    unsigned char *macs[] = {out->sta, out->bssid, out->ruid};
+    unsigned int m, i;
+    int hi, lo;
+    const char *p = key;
+
+    // canonical keys are three xx:xx:xx:xx:xx:xx joined by '@', anything else takes the generic parser
+    for (m = 0; m < 3; m++) {
+        for (i = 0; i < sizeof(mac_address_t); i++) {
+            if (((hi = sta_key_nibble(p[0])) < 0) || ((lo = sta_key_nibble(p[1])) < 0)) {
+                break;
+            }
+            macs[m][i] = static_cast<unsigned char> ((hi << 4) | lo);
+            p += 2;
+            if ((i + 1) < sizeof(mac_address_t)) {
+                if (*p != ':') {
+                    break;
+                }
+                p++;
+            }
+        }
+        if ((i < sizeof(mac_address_t)) || (*p != ((m < 2) ? '@':0))) {
+            break;
+        }
+        p++;
+    }
+
+    if (m < 3) {
+        memset(out, 0, sizeof(em_sta_key_t));
+        parse_sta_bss_radio_from_key(key, out->sta, out->bssid, out->ruid);
+    }
+}
+
+char *dm_sta_t::key_to_string(const em_sta_key_t *key, em_long_string_t str)
+{
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *macs[] = {key->sta, key->bssid, key->ruid};
+    unsigned int m, i;
+    char *p = str;
+
+    for (m = 0; m < 3; m++) {
+        for (i = 0; i < sizeof(mac_address_t); i++) {
+            *p++ = hex[macs[m][i] >> 4];
+            *p++ = hex[macs[m][i] & 0xf];
+            *p++ = ':';
+        }
+        p[-1] = '@';
+    }
+    p[-1] = 0;
+
+    return str;
+}
+
+void dm_sta_t::get_key(em_sta_key_t *key) const
+{
+    memcpy(key->sta, m_sta_info.id, sizeof(mac_address_t));
+    memcpy(key->bssid, m_sta_info.bssid, sizeof(bssid_t));
+    memcpy(key->ruid, m_sta_info.radiomac, sizeof(mac_address_t));
+}
+
 void dm_sta_t::decode_sta_capability(dm_sta_t *sta)
 {
     unsigned int offset = 0;
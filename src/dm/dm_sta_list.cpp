@@ -109,24 +109,22 @@ int dm_sta_list_t::set_config(db_client_t& db_client, dm_sta_t& sta, void *paren
 dm_orch_type_t dm_sta_list_t::get_dm_orch_type(db_client_t& db_client, const dm_sta_t& sta)
 {
     dm_sta_t *psta;
-    mac_addr_str_t  sta_mac_str, bssid_mac_str, radio_mac_str;
-    em_long_string_t key;
+    mac_addr_str_t  sta_mac_str;
+    em_sta_key_t key;
 
+    sta.get_key(&key);
     dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.id), sta_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.bssid), bssid_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.radiomac), radio_mac_str);
-    snprintf(key, sizeof (em_long_string_t), "%s@%s@%s", sta_mac_str, bssid_mac_str, radio_mac_str);
 
-    psta = get_sta(key);
+    psta = get_sta(&key);
     if (psta != NULL) {
-        if (entry_exists_in_table(db_client, sta_mac_str) == false) {
+        if (is_persisted(sta_mac_str) == false) {
             //printf("%s:%d: STA: %s does not exist in db\n", __func__, __LINE__, key);
             return dm_orch_type_db_insert;
         }
 
         if (*psta == sta) {
             //printf("%s:%d: STA: %s BSS: %s already in list\n", __func__, __LINE__, sta_mac_str, bssid_mac_str);
-            if (compare_db(db_client, sta) != true) {
+            if (is_persisted_unchanged(sta_mac_str, &sta.m_sta_info, sizeof(em_sta_info_t)) != true) {
                 //printf("%s:%d: sta_map and DB mismatch, needs update\n", __func__, __LINE__);
                 return dm_orch_type_db_update;
             }
@@ -144,26 +142,23 @@ dm_orch_type_t dm_sta_list_t::get_dm_orch_type(db_client_t& db_client, const dm_
 void dm_sta_list_t::update_list(const dm_sta_t& sta, dm_orch_type_t op)
 {
     dm_sta_t *psta;
-    mac_addr_str_t	sta_mac_str, bssid_mac_str, radio_mac_str;
-    em_long_string_t key;
+    em_sta_key_t key;
+    em_long_string_t str;
 
-    dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.id), sta_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.bssid), bssid_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(const_cast<unsigned char *>(sta.m_sta_info.radiomac), radio_mac_str);
-    snprintf(key, sizeof (em_long_string_t), "%s@%s@%s", sta_mac_str, bssid_mac_str, radio_mac_str);
+    sta.get_key(&key);
 
     switch (op) {
         case dm_orch_type_db_insert:
-			put_sta(key, &sta);	
+			put_sta(&key, &sta);	
             break;
 
         case dm_orch_type_db_update:
-			psta = get_sta(key);
+			psta = get_sta(&key);
             memcpy(&psta->m_sta_info, &sta.m_sta_info, sizeof(em_sta_info_t));
             break;
 
         case dm_orch_type_db_delete:
-            remove_sta(key);            
+            remove_sta(dm_sta_t::key_to_string(&key, str));            
             break;
 
         default:
@@ -238,6 +233,10 @@ int dm_sta_list_t::update_db(db_client_t& db_client, dm_orch_type_t op, void *da
 			break;
 	}
 
+    if (ret == 0) {
+        set_persisted(dm_easy_mesh_t::macbytes_to_string(info->id, sta_mac_str), op, info, sizeof(em_sta_info_t));
+    }
+
     return ret;
 }
 
@@ -256,103 +255,43 @@ bool dm_sta_list_t::search_db(db_client_t& db_client, void *ctx, void *key)
     return false;
 }
 
-bool dm_sta_list_t::compare_db(db_client_t& db_client, const dm_sta_t& sta)
-{
-    em_sta_info_t info;
-    mac_addr_str_t mac;
-    char frame_body[EM_MAX_FRAME_BODY_LEN*2];
-
-    db_query_t    query;
-    void *ctx;
-
-    memset(query, 0, sizeof(db_query_t));
-    snprintf(query, sizeof(db_query_t), "select * from %s", m_table_name);
-
-    ctx = db_client.execute(query);
-
-    while (db_client.next_result(ctx)) {
-        memset(&info, 0, sizeof(em_sta_info_t));
-
-        db_client.get_string(ctx, mac, 1);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.id);
-
-        db_client.get_string(ctx, mac, 2);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.bssid);
-
-        db_client.get_string(ctx, mac, 3);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.radiomac);
-
-        info.associated = db_client.get_number(ctx, 4);
-        info.last_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 5));
-        info.last_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 6));
-        info.est_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 7));
-        info.est_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 8));
-        info.last_conn_time = static_cast<unsigned int>(db_client.get_number(ctx, 9));
-        info.retrans_count = static_cast<unsigned int>(db_client.get_number(ctx, 10));
-        info.signal_strength = (db_client.get_number(ctx, 11));
-        info.rcpi = static_cast<unsigned char> (db_client.get_number(ctx, 12));
-        info.util_tx = static_cast<unsigned char> (db_client.get_number(ctx, 13));
-        info.util_rx = static_cast<unsigned char> (db_client.get_number(ctx, 14));
-        info.pkts_tx = static_cast<unsigned char> (db_client.get_number(ctx, 15));
-        info.pkts_rx = static_cast<unsigned char> (db_client.get_number(ctx, 16));
-        info.bytes_tx = static_cast<unsigned char> (db_client.get_number(ctx, 17));
-        info.bytes_rx = static_cast<unsigned char> (db_client.get_number(ctx, 18));
-        info.errors_tx = static_cast<unsigned char> (db_client.get_number(ctx, 19));
-        info.errors_rx = static_cast<unsigned char> (db_client.get_number(ctx, 20));
-        info.frame_body_len = static_cast<unsigned char> (db_client.get_number(ctx, 21));
-
-        db_client.get_string(ctx, frame_body, 22);
-        dm_easy_mesh_t::unhex(static_cast<unsigned int>(strlen(frame_body)), frame_body, EM_MAX_FRAME_BODY_LEN, info.frame_body);
-
-        if (memcmp(static_cast<const void*>(&sta.m_sta_info), static_cast<const void*>(&info), sizeof(em_sta_info_t)) == 0) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 int dm_sta_list_t::sync_db(db_client_t& db_client, void *ctx)
 {
     em_sta_info_t info;
-    mac_addr_str_t	mac;
+    db_row_t row;
+    mac_addr_str_t	sta_mac_str;
     int rc = 0;
-    char frame_body[EM_MAX_FRAME_BODY_LEN*2];
 
-    while (db_client.next_result(ctx)) {
+    // every STA of the network is loaded here at start up, decode each row in a single pass
+    while (db_client.next_row(ctx, row)) {
         memset(&info, 0, sizeof(em_sta_info_t));
 
-        db_client.get_string(ctx, mac, 1);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.id);
-
-        db_client.get_string(ctx, mac, 2);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.bssid);
-
-        db_client.get_string(ctx, mac, 3);
-        dm_easy_mesh_t::string_to_macbytes(mac, info.radiomac);
-
-        info.associated = db_client.get_number(ctx, 4);
-        info.last_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 5));
-        info.last_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 6));
-        info.est_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 7));
-        info.est_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 8));
-        info.last_conn_time = static_cast<unsigned int>(db_client.get_number(ctx, 9));
-        info.retrans_count = static_cast<unsigned int>(db_client.get_number(ctx, 10));
-        info.signal_strength = static_cast<signed int> (db_client.get_number(ctx, 11));
-        info.rcpi = static_cast<unsigned char> (db_client.get_number(ctx, 12));
-        info.util_tx = static_cast<unsigned int> (db_client.get_number(ctx, 13));
-        info.util_rx = static_cast<unsigned int> (db_client.get_number(ctx, 14));
-        info.pkts_tx = static_cast<unsigned int> (db_client.get_number(ctx, 15));
-        info.pkts_rx = static_cast<unsigned int> (db_client.get_number(ctx, 16));
-        info.bytes_tx = static_cast<unsigned int> (db_client.get_number(ctx, 17));
-        info.bytes_rx = static_cast<unsigned int> (db_client.get_number(ctx, 18));
-        info.errors_tx = static_cast<unsigned int> (db_client.get_number(ctx, 19));
-        info.errors_rx = static_cast<unsigned int> (db_client.get_number(ctx, 20));
-        info.frame_body_len = static_cast<unsigned int> (db_client.get_number(ctx, 21));
-
-        db_client.get_string(ctx, frame_body, 22);
-        dm_easy_mesh_t::unhex(static_cast<unsigned int>(strlen(frame_body)), frame_body, EM_MAX_FRAME_BODY_LEN, info.frame_body);
-
+        row.get_mac(1, info.id);
+        row.get_mac(2, info.bssid);
+        row.get_mac(3, info.radiomac);
+
+        info.associated = row.get_number(4);
+        info.last_ul_rate = static_cast<unsigned int>(row.get_number(5));
+        info.last_dl_rate = static_cast<unsigned int>(row.get_number(6));
+        info.est_ul_rate = static_cast<unsigned int>(row.get_number(7));
+        info.est_dl_rate = static_cast<unsigned int>(row.get_number(8));
+        info.last_conn_time = static_cast<unsigned int>(row.get_number(9));
+        info.retrans_count = static_cast<unsigned int>(row.get_number(10));
+        info.signal_strength = static_cast<signed int> (row.get_number(11));
+        info.rcpi = static_cast<unsigned char> (row.get_number(12));
+        info.util_tx = static_cast<unsigned int> (row.get_number(13));
+        info.util_rx = static_cast<unsigned int> (row.get_number(14));
+        info.pkts_tx = static_cast<unsigned int> (row.get_number(15));
+        info.pkts_rx = static_cast<unsigned int> (row.get_number(16));
+        info.bytes_tx = static_cast<unsigned int> (row.get_number(17));
+        info.bytes_rx = static_cast<unsigned int> (row.get_number(18));
+        info.errors_tx = static_cast<unsigned int> (row.get_number(19));
+        info.errors_rx = static_cast<unsigned int> (row.get_number(20));
+        info.frame_body_len = static_cast<unsigned int> (row.get_number(21));
+
+        row.get_hex(22, info.frame_body, EM_MAX_FRAME_BODY_LEN);
+
+        set_persisted(dm_easy_mesh_t::macbytes_to_string(info.id, sta_mac_str), dm_orch_type_db_insert, &info, sizeof(em_sta_info_t));
         update_list(dm_sta_t(&info), dm_orch_type_db_insert);
     }
     return rc;
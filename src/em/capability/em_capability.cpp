@@ -37,6 +37,7 @@
 #include <unistd.h>
 #include <pthread.h>
 #include <openssl/rand.h>
+#include <algorithm>
 #include "em.h"
 #include "em_capability.h"
 #include "em_cmd.h"
@@ -460,11 +461,15 @@ int em_capability_t::handle_client_cap_report(unsigned char *buff, unsigned int
     unsigned int tmp_len;
     em_tlv_t *tlv;
     em_sta_info_t sta_info;
-    mac_addr_str_t sta_mac_str, bssid_str, radio_mac_str;
-    em_long_string_t	key;
     dm_easy_mesh_t  *dm;
+    em_client_cap_cache_t *cache;
+    em_client_cap_body_t body;
+    std::vector<em_client_cap_waiter_t> waiters;
+    unsigned char *frame_body = NULL;
+    unsigned int frame_body_len = 0;
     bool found_client_info = false;
     bool found_cap_report = false;
+    bool changed = true;
     char *errors[EM_MAX_TLV_MEMBERS] = {0};
 
     dm = get_data_model();
@@ -504,8 +509,8 @@ int em_capability_t::handle_client_cap_report(unsigned char *buff, unsigned int
                 return -1;
             }
             sta_info.associated = true;
-            sta_info.frame_body_len = htons(tlv->len) - 1;
-            memcpy(sta_info.frame_body, &tlv->value[1], htons(tlv->len) - 1);
+            frame_body = &tlv->value[1];
+            frame_body_len = std::min<unsigned int> (static_cast<unsigned int> (htons(tlv->len) - 1), EM_MAX_FRAME_BODY_LEN);
 
             found_cap_report = true;
             break;
@@ -522,19 +527,49 @@ int em_capability_t::handle_client_cap_report(unsigned char *buff, unsigned int
 
     set_state(em_state_ctrl_sta_cap_confirmed);
 
-    dm_easy_mesh_t::macbytes_to_string(sta_info.id, sta_mac_str);
-    dm_easy_mesh_t::macbytes_to_string(sta_info.bssid, bssid_str);
-    dm_easy_mesh_t::macbytes_to_string(get_radio_interface_mac(), radio_mac_str);
-    snprintf(key, sizeof(em_long_string_t), "%s@%s@%s", sta_mac_str, bssid_str, radio_mac_str);
+    if ((cache = get_client_cap_cache()) != NULL) {
+        changed = cache->update(sta_info.id, get_peer_mac(), frame_body, frame_body_len, &body, &waiters);
+        frame_body = const_cast<unsigned char *> (body->data());
+    }
+    sta_info.frame_body_len = frame_body_len;
+    memcpy(sta_info.frame_body, frame_body, frame_body_len);
 
-    if (hash_map_get(dm->m_sta_assoc_map, key) == NULL) {
-        hash_map_put(dm->m_sta_assoc_map, strdup(key), new dm_sta_t(&sta_info));
-        dm->set_db_cfg_param(db_cfg_type_sta_list_update, "");
+    store_client_cap(dm, &sta_info, changed);
+
+    // associations of the STA to other BSSes of this agent waited for the same report
+    for (auto& waiter : waiters) {
+        if (memcmp(waiter.bssid, sta_info.bssid, sizeof(bssid_t)) == 0) {
+            continue;
+        }
+        memcpy(sta_info.bssid, waiter.bssid, sizeof(bssid_t));
+        memcpy(sta_info.radiomac, waiter.ruid, sizeof(mac_address_t));
+        store_client_cap(dm, &sta_info, changed);
     }
 
     return 0;
 }
 
+void em_capability_t::store_client_cap(dm_easy_mesh_t *dm, em_sta_info_t *sta_info, bool changed)
+{
+    em_sta_key_t sta_key;
+    em_long_string_t key;
+
+    memcpy(sta_key.sta, sta_info->id, sizeof(mac_address_t));
+    memcpy(sta_key.bssid, sta_info->bssid, sizeof(bssid_t));
+    memcpy(sta_key.ruid, sta_info->radiomac, sizeof(mac_address_t));
+    dm_sta_t::key_to_string(&sta_key, key);
+
+    // the STA is already stored on this BSS with these capabilities
+    if ((changed == false) && (hash_map_get(dm->m_sta_map, key) != NULL)) {
+        return;
+    }
+
+    if (hash_map_get(dm->m_sta_assoc_map, key) == NULL) {
+        hash_map_put(dm->m_sta_assoc_map, strdup(key), new dm_sta_t(sta_info));
+        dm->set_db_cfg_param(db_cfg_type_sta_list_update, "");
+    }
+}
+
 void em_capability_t::handle_client_cap_query(unsigned char *buff, unsigned int len)
 {
     mac_address_t sta;
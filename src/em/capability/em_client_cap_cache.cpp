@@ -0,0 +1,187 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "em_client_cap_cache.h"
+
+unsigned long long em_client_cap_cache_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+time_t em_client_cap_cache_t::now_s()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec;
+}
+
+unsigned long long em_client_cap_cache_t::hash(const unsigned char *body, unsigned int len)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	unsigned int i;
+
+	for (i = 0; i < len; i++) {
+		h = (h ^ body[i]) * 1099511628211ULL;
+	}
+
+	return h;
+}
+
+em_client_cap_lookup_t em_client_cap_cache_t::lookup(const unsigned char *sta, const unsigned char *agent,
+	const unsigned char *bssid, const unsigned char *ruid, em_client_cap_body_t *body)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	entry_t& entry = m_entries[mac_key(sta)];
+	unsigned long long agent_key = mac_key(agent);
+	em_client_cap_waiter_t waiter;
+	time_t now = now_s();
+	pending_t *pending = NULL;
+
+	if ((entry.body != nullptr) && ((now - entry.time) <= EM_CLIENT_CAP_TTL_S)) {
+		*body = entry.body;
+		m_stats.hits++;
+		return em_client_cap_lookup_hit;
+	}
+
+	// a query whose report never came no longer holds the associations back
+	for (auto it = entry.pending.begin(); it != entry.pending.end(); ) {
+		it = ((now - it->time) > EM_CLIENT_CAP_QUERY_TIMEOUT_S) ? entry.pending.erase(it):(it + 1);
+	}
+	for (auto& p : entry.pending) {
+		if (p.agent == agent_key) {
+			pending = &p;
+			break;
+		}
+	}
+
+	memcpy(waiter.bssid, bssid, sizeof(bssid_t));
+	memcpy(waiter.ruid, ruid, sizeof(mac_address_t));
+
+	if (pending != NULL) {
+		for (auto& w : pending->waiters) {
+			if (memcmp(w.bssid, bssid, sizeof(bssid_t)) == 0) {
+				m_stats.coalesced++;
+				return em_client_cap_lookup_pending;
+			}
+		}
+		pending->waiters.push_back(waiter);
+		m_stats.coalesced++;
+		return em_client_cap_lookup_pending;
+	}
+
+	entry.pending.push_back(pending_t());
+	entry.pending.back().agent = agent_key;
+	entry.pending.back().time = now;
+	entry.pending.back().waiters.push_back(waiter);
+	m_stats.misses++;
+
+	return em_client_cap_lookup_miss;
+}
+
+bool em_client_cap_cache_t::update(const unsigned char *sta, const unsigned char *agent, const unsigned char *body, unsigned int len,
+	em_client_cap_body_t *shared, std::vector<em_client_cap_waiter_t> *waiters)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	entry_t& entry = m_entries[mac_key(sta)];
+	unsigned long long agent_key = mac_key(agent), h = hash(body, len);
+	bool changed;
+
+	changed = (entry.body == nullptr) || (entry.hash != h) || (entry.body->size() != len) ||
+		(memcmp(entry.body->data(), body, len) != 0);
+	if (changed == true) {
+		entry.body = std::make_shared<const std::vector<unsigned char>>(body, body + len);
+		entry.hash = h;
+		m_stats.changed++;
+	} else {
+		m_stats.unchanged++;
+	}
+	entry.time = now_s();
+	*shared = entry.body;
+
+	waiters->clear();
+	for (auto it = entry.pending.begin(); it != entry.pending.end(); ++it) {
+		if (it->agent == agent_key) {
+			waiters->swap(it->waiters);
+			entry.pending.erase(it);
+			break;
+		}
+	}
+
+	return changed;
+}
+
+unsigned int em_client_cap_cache_t::expire()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	time_t now = now_s();
+	unsigned int num = 0;
+
+	for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+		entry_t& entry = it->second;
+
+		for (auto p = entry.pending.begin(); p != entry.pending.end(); ) {
+			p = ((now - p->time) > EM_CLIENT_CAP_QUERY_TIMEOUT_S) ? entry.pending.erase(p):(p + 1);
+		}
+
+		if (entry.pending.empty() && ((entry.body == nullptr) || ((now - entry.time) > EM_CLIENT_CAP_TTL_S))) {
+			it = m_entries.erase(it);
+			num++;
+			continue;
+		}
+		++it;
+	}
+	m_stats.expired += num;
+
+	return num;
+}
+
+const em_client_cap_stats_t *em_client_cap_cache_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int num_pending = 0;
+
+	for (auto& it : m_entries) {
+		num_pending += static_cast<unsigned int> (it.second.pending.size());
+	}
+	m_stats.num_stas = static_cast<unsigned int> (m_entries.size());
+	m_stats.num_pending = num_pending;
+
+	return &m_stats;
+}
+
+em_client_cap_cache_t::em_client_cap_cache_t() : m_lock(), m_entries(), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_client_cap_stats_t));
+}
+
+em_client_cap_cache_t::~em_client_cap_cache_t()
+{
+
+}
@@ -1893,6 +1893,8 @@ void em_channel_t::fill_scan_result(dm_scan_result_t *scan_res, em_channel_scan_
     memcpy(&scan_res->m_scan_result.scan_type, tmp, sizeof(unsigned char));
     tmp += sizeof(unsigned char);
 
+	scan_res->reindex_neighbors();
+	scan_res->touch();
 }
 
 int em_channel_t::handle_channel_scan_rprt(unsigned char *buff, unsigned int len)
@@ -1903,8 +1905,10 @@ int em_channel_t::handle_channel_scan_rprt(unsigned char *buff, unsigned int len
 	dm_easy_mesh_t *dm;
 	em_scan_result_id_t id;
 	dm_scan_result_t *scan_res;
+	em_channel_planner_t *planner = get_channel_planner();
 
 	dm = get_data_model();
+	dm->expire_scan_results(EM_SCAN_RESULT_MAX_AGE);
 
     tlv = reinterpret_cast<em_tlv_t *> (buff + sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
     tlv_len = static_cast<int> (len - (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t)));
@@ -1925,6 +1929,9 @@ int em_channel_t::handle_channel_scan_rprt(unsigned char *buff, unsigned int len
 			}
 
 			fill_scan_result(scan_res, res);
+			if (planner != NULL) {
+				planner->update_scan_result(&scan_res->m_scan_result);
+			}
 		}
 
         if (tlv->type == em_tlv_type_timestamp) {
@@ -0,0 +1,786 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include "em_channel_planner.h"
+
+#define EM_CHAN_PLAN_BINS_20MHZ	(20 / EM_CHAN_PLAN_BIN_MHZ)
+
+typedef struct {
+	unsigned int	chan_base;	// frequency of channel number 0, MHz
+	unsigned int	lo;		// lower edge of the grid, MHz
+	unsigned int	bins;
+} em_chan_plan_grid_t;
+
+static const em_chan_plan_grid_t plan_grids[] = {
+	{2407, 2400, 20},		// 2.4 GHz, 2400-2500 MHz
+	{5000, 5150, 150},		// 5 GHz, 5150-5900 MHz
+	{5950, 5925, 240},		// 6 GHz, 5925-7125 MHz
+};
+
+#define EM_CHAN_PLAN_GRID_24	0
+#define EM_CHAN_PLAN_GRID_5	1
+#define EM_CHAN_PLAN_GRID_6	2
+
+// 5 GHz channels 52-144 need a CAC before use
+#define EM_CHAN_PLAN_DFS_LO	5250
+#define EM_CHAN_PLAN_DFS_HI	5730
+
+typedef struct {
+	unsigned char	op_class;
+	unsigned char	grid;
+	unsigned short	width;		// MHz
+	short	offset;			// centre frequency minus the frequency of the channel number, MHz
+	unsigned char	first;		// channel numbers the planner picks from, none if count is 0
+	unsigned char	step;
+	unsigned char	count;
+} em_chan_plan_op_class_t;
+
+// Global operating classes (IEEE 802.11 Annex E-4). 40 MHz in 2.4 GHz is only known so radios already
+// using it are accounted for, and 20 MHz in 2.4 GHz is limited to the non overlapping 1, 6 and 11.
+static const em_chan_plan_op_class_t plan_op_classes[] = {
+	{81, EM_CHAN_PLAN_GRID_24, 20, 0, 1, 5, 3},
+	{83, EM_CHAN_PLAN_GRID_24, 40, 10, 1, 1, 0},
+	{84, EM_CHAN_PLAN_GRID_24, 40, -10, 5, 1, 0},
+	{115, EM_CHAN_PLAN_GRID_5, 20, 0, 36, 4, 4},
+	{116, EM_CHAN_PLAN_GRID_5, 40, 10, 36, 8, 2},
+	{117, EM_CHAN_PLAN_GRID_5, 40, -10, 40, 8, 2},
+	{118, EM_CHAN_PLAN_GRID_5, 20, 0, 52, 4, 4},
+	{119, EM_CHAN_PLAN_GRID_5, 40, 10, 52, 8, 2},
+	{120, EM_CHAN_PLAN_GRID_5, 40, -10, 56, 8, 2},
+	{121, EM_CHAN_PLAN_GRID_5, 20, 0, 100, 4, 12},
+	{122, EM_CHAN_PLAN_GRID_5, 40, 10, 100, 8, 6},
+	{123, EM_CHAN_PLAN_GRID_5, 40, -10, 104, 8, 6},
+	{124, EM_CHAN_PLAN_GRID_5, 20, 0, 149, 4, 4},
+	{125, EM_CHAN_PLAN_GRID_5, 20, 0, 149, 4, 5},
+	{126, EM_CHAN_PLAN_GRID_5, 40, 10, 149, 8, 2},
+	{127, EM_CHAN_PLAN_GRID_5, 40, -10, 153, 8, 2},
+	{128, EM_CHAN_PLAN_GRID_5, 80, 0, 42, 16, 2},		// channel numbers are centre channels from here
+	{128, EM_CHAN_PLAN_GRID_5, 80, 0, 106, 16, 3},
+	{128, EM_CHAN_PLAN_GRID_5, 80, 0, 155, 16, 1},
+	{129, EM_CHAN_PLAN_GRID_5, 160, 0, 50, 64, 2},
+	{129, EM_CHAN_PLAN_GRID_5, 160, 0, 163, 1, 1},
+	{131, EM_CHAN_PLAN_GRID_6, 20, 0, 1, 4, 59},
+	{132, EM_CHAN_PLAN_GRID_6, 40, 0, 3, 8, 29},
+	{133, EM_CHAN_PLAN_GRID_6, 80, 0, 7, 16, 14},
+	{134, EM_CHAN_PLAN_GRID_6, 160, 0, 15, 32, 7},
+};
+
+unsigned long long em_channel_planner_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+void em_channel_planner_t::key_to_mac(unsigned long long key, unsigned char *mac)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		mac[sizeof(mac_address_t) - 1 - i] = static_cast<unsigned char> (key & 0xff);
+		key >>= 8;
+	}
+}
+
+time_t em_channel_planner_t::now_s()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec;
+}
+
+int em_channel_planner_t::get_op_class_grid(unsigned int op_class)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(plan_op_classes) / sizeof(plan_op_classes[0]); i++) {
+		if (plan_op_classes[i].op_class == op_class) {
+			return plan_op_classes[i].grid;
+		}
+	}
+
+	return -1;
+}
+
+bool em_channel_planner_t::make_span(int grid, unsigned int centre, unsigned int width, unsigned short *lo, unsigned short *hi)
+{
+	const em_chan_plan_grid_t *g = &plan_grids[grid];
+	unsigned int lower = centre - width / 2, upper = centre + width / 2;
+	unsigned int top = g->lo + g->bins * EM_CHAN_PLAN_BIN_MHZ;
+
+	if ((centre < (width / 2)) || (upper <= g->lo) || (lower >= top)) {
+		return false;
+	}
+
+	lower = std::max(lower, g->lo);
+	upper = std::min(upper, top);
+	*lo = static_cast<unsigned short> ((lower - g->lo) / EM_CHAN_PLAN_BIN_MHZ);
+	*hi = static_cast<unsigned short> ((upper - g->lo + EM_CHAN_PLAN_BIN_MHZ - 1) / EM_CHAN_PLAN_BIN_MHZ);
+
+	return *hi > *lo;
+}
+
+bool em_channel_planner_t::make_cand(int grid, unsigned int op_class, unsigned int channel, cand_t *cand)
+{
+	const em_chan_plan_op_class_t *row = NULL;
+	unsigned int i, centre, width, doublings = 0;
+
+	for (i = 0; i < sizeof(plan_op_classes) / sizeof(plan_op_classes[0]); i++) {
+		if ((plan_op_classes[i].op_class == op_class) && (plan_op_classes[i].grid == grid)) {
+			row = &plan_op_classes[i];
+			break;
+		}
+	}
+	if ((row == NULL) || (channel == 0) || (channel > 0xff)) {
+		return false;
+	}
+
+	centre = static_cast<unsigned int> (static_cast<int> (plan_grids[grid].chan_base + channel * 5) + row->offset);
+	if (make_span(grid, centre, row->width, &cand->lo, &cand->hi) == false) {
+		return false;
+	}
+
+	cand->op_class = static_cast<unsigned char> (op_class);
+	cand->channel = static_cast<unsigned char> (channel);
+	cand->bias = 0;
+
+	for (width = row->width; width > 20; width /= 2) {
+		doublings++;
+	}
+	cand->bias -= static_cast<int> (doublings) * EM_CHAN_PLAN_BW_BONUS;
+
+	if ((grid == EM_CHAN_PLAN_GRID_5) && ((centre + row->width / 2) > EM_CHAN_PLAN_DFS_LO) &&
+			((centre - row->width / 2) < EM_CHAN_PLAN_DFS_HI)) {
+		cand->bias += EM_CHAN_PLAN_DFS_PENALTY;
+	}
+
+	return true;
+}
+
+int em_channel_planner_t::nbr_weight(const em_neighbor_t *nbr)
+{
+	int dbm, weight;
+
+	// agents report either dBm or an RCPI
+	if (nbr->signal_strength < 0) {
+		dbm = nbr->signal_strength;
+	} else if (nbr->signal_strength == 0) {
+		return 0;
+	} else {
+		dbm = (nbr->signal_strength / 2) - 110;
+	}
+
+	if (dbm <= EM_CHAN_PLAN_MIN_RSSI) {
+		return 0;
+	} else if (dbm >= EM_CHAN_PLAN_MAX_RSSI) {
+		weight = EM_CHAN_PLAN_UNIT;
+	} else {
+		weight = (EM_CHAN_PLAN_UNIT * (dbm - EM_CHAN_PLAN_MIN_RSSI)) / (EM_CHAN_PLAN_MAX_RSSI - EM_CHAN_PLAN_MIN_RSSI);
+	}
+
+	// half weight for an idle neighbour, full weight for a saturated one
+	weight = (weight * (256 + nbr->channel_util)) / 512;
+
+	// a neighbour with a BSS color allows OBSS PD spatial reuse
+	if (nbr->bss_color != 0) {
+		weight = (weight * 3) / 4;
+	}
+
+	return weight;
+}
+
+bool em_channel_planner_t::nbr_span(unsigned int channel, const em_neighbor_t *nbr, int grid, span_t *span)
+{
+	unsigned int primary = plan_grids[grid].chan_base + channel * 5;
+	unsigned int width, base, lower, centre;
+
+	switch ((nbr != NULL) ? nbr->bandwidth:WIFI_CHANNELBANDWIDTH_20MHZ) {
+		case WIFI_CHANNELBANDWIDTH_40MHZ:	width = 40; break;
+		case WIFI_CHANNELBANDWIDTH_80MHZ:	width = 80; break;
+		case WIFI_CHANNELBANDWIDTH_160MHZ:	width = 160; break;
+		case WIFI_CHANNELBANDWIDTH_320MHZ:	width = 320; break;
+		default:				width = 20; break;
+	}
+
+	if (grid == EM_CHAN_PLAN_GRID_24) {
+		// secondary channel above for the lower channels, below for the upper ones
+		width = std::min(width, 40U);
+		centre = (width == 20) ? primary:((channel <= 7) ? (primary + 10):(primary - 10));
+	} else {
+		// wider channels are aligned blocks of the band
+		base = (grid == EM_CHAN_PLAN_GRID_6) ? 5945:((primary < 5735) ? 5170:5735);
+		if ((primary < (base + 10)) || ((grid == EM_CHAN_PLAN_GRID_5) && (width > 160))) {
+			width = 20;
+			centre = primary;
+		} else {
+			lower = base + ((primary - 10 - base) / width) * width;
+			centre = lower + width / 2;
+		}
+	}
+
+	return make_span(grid, centre, width, &span->lo, &span->hi);
+}
+
+em_channel_planner_t::radio_t& em_channel_planner_t::get_radio(unsigned long long key)
+{
+	return m_radios[key];
+}
+
+void em_channel_planner_t::add_span(radio_t& radio, const span_t& span, int sign)
+{
+	int weight = sign * span.weight;
+	unsigned int i, hi = std::min(static_cast<unsigned int> (span.hi), static_cast<unsigned int> (radio.load.size()));
+
+	for (i = span.lo; i < hi; i++) {
+		radio.load[i] += weight;
+	}
+	radio.dirty = true;
+}
+
+void em_channel_planner_t::add_heard(unsigned long long from, unsigned long long to, int weight)
+{
+	radio_t& a = get_radio(from);
+	radio_t& b = get_radio(to);
+	span_t span;
+
+	if ((from == to) || (weight == 0)) {
+		return;
+	}
+
+	if ((a.edges[to] += weight) == 0) {
+		a.edges.erase(to);
+	}
+	if ((b.edges[from] += weight) == 0) {
+		b.edges.erase(from);
+	}
+
+	if (a.grid != b.grid) {
+		return;
+	}
+
+	span.weight = weight;
+	if (b.has_cur == true) {
+		span.lo = b.cur.lo;
+		span.hi = b.cur.hi;
+		add_span(a, span, 1);
+	}
+	if (a.has_cur == true) {
+		span.lo = a.cur.lo;
+		span.hi = a.cur.hi;
+		add_span(b, span, 1);
+	}
+}
+
+void em_channel_planner_t::set_current(unsigned long long key, radio_t& radio, const cand_t *cand)
+{
+	span_t span;
+
+	for (auto& edge : radio.edges) {
+		radio_t& nbr = m_radios[edge.first];
+		if (nbr.grid != radio.grid) {
+			continue;
+		}
+
+		span.weight = edge.second;
+		if (radio.has_cur == true) {
+			span.lo = radio.cur.lo;
+			span.hi = radio.cur.hi;
+			add_span(nbr, span, -1);
+		}
+		if (cand != NULL) {
+			span.lo = cand->lo;
+			span.hi = cand->hi;
+			add_span(nbr, span, 1);
+		}
+	}
+
+	radio.has_cur = (cand != NULL);
+	if (cand != NULL) {
+		radio.cur = *cand;
+	}
+	radio.dirty = true;
+}
+
+void em_channel_planner_t::drop_scan(unsigned long long key)
+{
+	auto it = m_scans.find(key);
+
+	if (it == m_scans.end()) {
+		return;
+	}
+
+	scan_t& scan = it->second;
+	radio_t& radio = get_radio(scan.ruid);
+
+	for (auto& span : scan.spans) {
+		add_span(radio, span, -1);
+	}
+	for (auto& heard : scan.heard) {
+		add_heard(scan.ruid, heard.first, -heard.second);
+	}
+	radio.num_scans--;
+
+	m_scans.erase(it);
+}
+
+void em_channel_planner_t::rebuild_load(unsigned long long key, radio_t& radio)
+{
+	span_t span;
+
+	if (radio.grid < 0) {
+		radio.load.clear();
+		return;
+	}
+	radio.load.assign(plan_grids[radio.grid].bins, 0);
+
+	for (auto& it : m_scans) {
+		if (it.second.ruid != key) {
+			continue;
+		}
+		for (auto& s : it.second.spans) {
+			add_span(radio, s, 1);
+		}
+	}
+
+	for (auto& edge : radio.edges) {
+		radio_t& nbr = m_radios[edge.first];
+		if ((nbr.grid != radio.grid) || (nbr.has_cur == false)) {
+			continue;
+		}
+		span.lo = nbr.cur.lo;
+		span.hi = nbr.cur.hi;
+		span.weight = edge.second;
+		add_span(radio, span, 1);
+	}
+	radio.dirty = true;
+}
+
+long long em_channel_planner_t::cost(const cand_t& cand)
+{
+	// m_prefix holds the prefix sums of the load of the radio being scored
+	return ((m_prefix[cand.hi] - m_prefix[cand.lo]) / EM_CHAN_PLAN_BINS_20MHZ) + cand.bias;
+}
+
+void em_channel_planner_t::build_candidates(radio_t& radio, const em_op_class_info_t *op_classes[], unsigned int num, const unsigned char *ruid)
+{
+	const em_op_class_info_t *cap, *pref;
+	const em_chan_plan_op_class_t *row;
+	unsigned int i, j, k, l, channel;
+	bool skip;
+	cand_t cand;
+
+	radio.cands.clear();
+	if (radio.grid < 0) {
+		return;
+	}
+
+	for (i = 0; i < num; i++) {
+		cap = op_classes[i];
+		if ((cap->id.type != em_op_class_type_capability) || (memcmp(cap->id.ruid, ruid, sizeof(mac_address_t)) != 0)) {
+			continue;
+		}
+
+		for (j = 0; j < sizeof(plan_op_classes) / sizeof(plan_op_classes[0]); j++) {
+			row = &plan_op_classes[j];
+			if ((row->op_class != cap->op_class) || (row->grid != radio.grid)) {
+				continue;
+			}
+
+			for (k = 0; k < row->count; k++) {
+				channel = row->first + k * row->step;
+
+				// the capability lists the statically non operable channels
+				skip = false;
+				for (l = 0; (l < cap->num_channels) && (l < EM_MAX_CHANNELS_IN_LIST); l++) {
+					if (cap->channels[l] == channel) {
+						skip = true;
+						break;
+					}
+				}
+				if ((skip == true) || (make_cand(radio.grid, row->op_class, channel, &cand) == false)) {
+					continue;
+				}
+
+				// the preference report lists the channels the agent prefers less than the others
+				for (l = 0; l < num; l++) {
+					pref = op_classes[l];
+					if ((pref->id.type != em_op_class_type_preference) || (pref->op_class != row->op_class)) {
+						continue;
+					}
+					if (std::find(pref->channels, pref->channels + std::min(pref->num_channels, static_cast<unsigned int> (EM_MAX_CHANNELS_IN_LIST)),
+							channel) != (pref->channels + std::min(pref->num_channels, static_cast<unsigned int> (EM_MAX_CHANNELS_IN_LIST)))) {
+						cand.bias += EM_CHAN_PLAN_PREF_PENALTY;
+						break;
+					}
+				}
+
+				radio.cands.push_back(cand);
+			}
+		}
+	}
+}
+
+void em_channel_planner_t::begin_sync()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_generation++;
+}
+
+void em_channel_planner_t::observe_radio(const unsigned char *ruid, const unsigned char *al_mac, const em_op_class_info_t *op_classes[], unsigned int num)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long key = mac_key(ruid), sig = 14695981039346656037ULL;
+	const em_op_class_info_t *info, *current = NULL;
+	const unsigned char *bytes;
+	unsigned int i, j, len;
+	int grid = -1;
+	cand_t cand;
+	bool has_cand = false;
+
+	radio_t& radio = get_radio(key);
+	radio.generation = m_generation;
+	radio.observed = true;
+	memcpy(radio.al_mac, al_mac, sizeof(mac_address_t));
+
+	for (i = 0; i < num; i++) {
+		info = op_classes[i];
+		if ((info->id.type == em_op_class_type_current) && (memcmp(info->id.ruid, ruid, sizeof(mac_address_t)) == 0)) {
+			current = info;
+			continue;
+		}
+		if ((info->id.type != em_op_class_type_capability) && (info->id.type != em_op_class_type_preference)) {
+			continue;
+		}
+		if ((grid < 0) && (info->id.type == em_op_class_type_capability)) {
+			grid = get_op_class_grid(info->op_class);
+		}
+
+		// FNV-1a over what the candidates depend on
+		len = std::min(info->num_channels, static_cast<unsigned int> (EM_MAX_CHANNELS_IN_LIST));
+		bytes = reinterpret_cast<const unsigned char *> (&info->id.type);
+		for (j = 0; j < sizeof(info->id.type); j++) {
+			sig = (sig ^ bytes[j]) * 1099511628211ULL;
+		}
+		sig = (sig ^ info->op_class) * 1099511628211ULL;
+		for (j = 0; j < len; j++) {
+			sig = (sig ^ info->channels[j]) * 1099511628211ULL;
+		}
+	}
+
+	if ((current != NULL) && (get_op_class_grid(current->op_class) >= 0)) {
+		grid = get_op_class_grid(current->op_class);
+	}
+
+	if (grid != radio.grid) {
+		set_current(key, radio, NULL);
+		radio.grid = grid;
+		rebuild_load(key, radio);
+		radio.sig = ~sig;
+	}
+
+	if (sig != radio.sig) {
+		radio.sig = sig;
+		build_candidates(radio, op_classes, num, ruid);
+		radio.dirty = true;
+	}
+
+	// after a move the data model lags behind until the agent reports the new channel
+	if ((radio.last_move != 0) && ((now_s() - radio.last_move) < EM_CHAN_PLAN_SETTLE_S)) {
+		return;
+	}
+
+	if ((current != NULL) && (grid >= 0)) {
+		has_cand = make_cand(grid, current->op_class, current->channel, &cand);
+		for (auto& c : radio.cands) {
+			if ((c.op_class == cand.op_class) && (c.channel == cand.channel)) {
+				cand.bias = c.bias;
+				break;
+			}
+		}
+	}
+
+	if (has_cand == false) {
+		if (radio.has_cur == true) {
+			set_current(key, radio, NULL);
+		}
+	} else if ((radio.has_cur == false) || (radio.cur.op_class != cand.op_class) || (radio.cur.channel != cand.channel) ||
+			(radio.cur.bias != cand.bias)) {
+		set_current(key, radio, &cand);
+	}
+}
+
+void em_channel_planner_t::observe_bss(const unsigned char *bssid, const unsigned char *ruid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_bss[mac_key(bssid)] = std::make_pair(mac_key(ruid), m_generation);
+}
+
+void em_channel_planner_t::end_sync()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (auto it = m_bss.begin(); it != m_bss.end(); ) {
+		if (it->second.second != m_generation) {
+			it = m_bss.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	// a radio that went away may still be on the air, it keeps its place in the graph until its scans age out
+	for (auto it = m_radios.begin(); it != m_radios.end(); ) {
+		radio_t& radio = it->second;
+		if (radio.generation != m_generation) {
+			radio.observed = false;
+		}
+		if ((radio.observed == false) && (radio.num_scans == 0) && radio.edges.empty()) {
+			it = m_radios.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void em_channel_planner_t::update_scan_result(const em_scan_result_t *res)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long ruid = mac_key(res->id.scanner_mac);
+	unsigned long long key = (ruid << 16) | (static_cast<unsigned long long> (res->id.op_class) << 8) | res->id.channel;
+	const em_neighbor_t *nbr;
+	unsigned int i, num;
+	int grid, weight;
+	scan_t scan;
+	span_t span;
+
+	drop_scan(key);
+
+	if ((grid = get_op_class_grid(res->id.op_class)) < 0) {
+		return;
+	}
+
+	radio_t& radio = get_radio(ruid);
+	if (radio.grid < 0) {
+		radio.grid = grid;
+		rebuild_load(ruid, radio);
+	} else if (radio.grid != grid) {
+		return;
+	}
+
+	scan.ruid = ruid;
+	scan.last_update = now_s();
+
+	// whatever else keeps the scanned channel busy
+	if ((res->util > 0) && (nbr_span(res->id.channel, NULL, grid, &span) == true)) {
+		span.weight = (EM_CHAN_PLAN_UTIL_WEIGHT * res->util) / 255;
+		scan.spans.push_back(span);
+	}
+
+	num = std::min(static_cast<unsigned int> (res->num_neighbors), static_cast<unsigned int> (EM_MAX_NEIGHBORS));
+	for (i = 0; i < num; i++) {
+		nbr = &res->neighbor[i];
+		if ((weight = nbr_weight(nbr)) == 0) {
+			continue;
+		}
+
+		auto bss = m_bss.find(mac_key(nbr->bssid));
+		if (bss != m_bss.end()) {
+			if (bss->second.first != ruid) {
+				scan.heard.push_back(std::make_pair(bss->second.first, weight));
+			}
+			continue;
+		}
+
+		if (nbr_span(res->id.channel, nbr, grid, &span) == true) {
+			span.weight = weight;
+			scan.spans.push_back(span);
+		}
+	}
+
+	for (auto& s : scan.spans) {
+		add_span(radio, s, 1);
+	}
+	for (auto& heard : scan.heard) {
+		add_heard(ruid, heard.first, heard.second);
+	}
+	radio.num_scans++;
+	radio.dirty = true;
+
+	m_scans[key] = std::move(scan);
+}
+
+unsigned int em_channel_planner_t::run()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	std::vector<std::pair<long long, std::pair<unsigned long long, unsigned int> > > proposals;
+	std::vector<unsigned long long> aged;
+	std::vector<em_chan_plan_move_t> moves;
+	std::vector<cand_t> prev;
+	em_chan_plan_move_t move;
+	time_t now = now_s();
+	long long cur_cost, best_cost, c;
+	unsigned int i, n, best;
+	int ret;
+
+	m_stats.passes++;
+
+	for (auto& it : m_scans) {
+		if ((now - it.second.last_update) > EM_CHAN_PLAN_SCAN_MAX_AGE) {
+			aged.push_back(it.first);
+		}
+	}
+	for (auto key : aged) {
+		drop_scan(key);
+	}
+
+	for (auto& it : m_radios) {
+		radio_t& radio = it.second;
+		if (radio.dirty == false) {
+			continue;
+		}
+		radio.dirty = false;
+		if ((radio.observed == false) || (radio.has_cur == false) || radio.cands.empty() || radio.load.empty()) {
+			continue;
+		}
+		m_stats.scored++;
+
+		n = static_cast<unsigned int> (radio.load.size());
+		m_prefix.resize(n + 1);
+		m_prefix[0] = 0;
+		for (i = 0; i < n; i++) {
+			m_prefix[i + 1] = m_prefix[i] + radio.load[i];
+		}
+
+		cur_cost = best_cost = cost(radio.cur);
+		best = static_cast<unsigned int> (radio.cands.size());
+		for (i = 0; i < radio.cands.size(); i++) {
+			if ((c = cost(radio.cands[i])) < best_cost) {
+				best_cost = c;
+				best = i;
+			}
+		}
+		if (best == radio.cands.size()) {
+			continue;
+		}
+
+		if (((cur_cost - best_cost) < EM_CHAN_PLAN_HYSTERESIS) ||
+				(((cur_cost - best_cost) * 100) < (std::max(cur_cost, 0LL) * EM_CHAN_PLAN_HYSTERESIS_PCT))) {
+			m_stats.held++;
+			continue;
+		}
+		if ((radio.last_move != 0) && ((now - radio.last_move) < EM_CHAN_PLAN_HOLD_S)) {
+			// nothing else may touch the radio until the hold expires, look again on the next pass
+			m_stats.held++;
+			radio.dirty = true;
+			continue;
+		}
+
+		proposals.push_back(std::make_pair(cur_cost - best_cost, std::make_pair(it.first, best)));
+	}
+
+	std::sort(proposals.begin(), proposals.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+	for (auto& p : proposals) {
+		radio_t& radio = m_radios[p.second.first];
+
+		if (moves.size() >= EM_CHAN_PLAN_MAX_MOVES) {
+			radio.dirty = true;
+			continue;
+		}
+		// a neighbour moved in this pass, the proposal is stale
+		if (radio.dirty == true) {
+			continue;
+		}
+
+		const cand_t& cand = radio.cands[p.second.second];
+		memset(&move, 0, sizeof(em_chan_plan_move_t));
+		memcpy(move.al_mac, radio.al_mac, sizeof(mac_address_t));
+		key_to_mac(p.second.first, move.ruid);
+		move.op_class = cand.op_class;
+		move.channel = cand.channel;
+		move.prev_op_class = radio.cur.op_class;
+		move.prev_channel = radio.cur.channel;
+		move.gain = p.first;
+		moves.push_back(move);
+		prev.push_back(radio.cur);
+
+		set_current(p.second.first, radio, &cand);
+		radio.last_move = now;
+	}
+
+	if (moves.empty()) {
+		return 0;
+	}
+
+	// called with the lock held, the callback must not come back into the planner
+	if ((ret = m_apply(moves.data(), static_cast<unsigned int> (moves.size()))) < 0) {
+		for (i = 0; i < moves.size(); i++) {
+			unsigned long long key = mac_key(moves[i].ruid);
+			radio_t& radio = m_radios[key];
+			set_current(key, radio, &prev[i]);
+			radio.last_move = 0;
+		}
+		return 0;
+	}
+
+	m_stats.moves += moves.size();
+
+	return static_cast<unsigned int> (moves.size());
+}
+
+const em_chan_plan_stats_t *em_channel_planner_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int edges = 0;
+
+	m_stats.num_radios = static_cast<unsigned int> (m_radios.size());
+	m_stats.num_planned = 0;
+	for (auto& it : m_radios) {
+		if ((it.second.observed == true) && (it.second.has_cur == true) && !it.second.cands.empty()) {
+			m_stats.num_planned++;
+		}
+		edges += static_cast<unsigned int> (it.second.edges.size());
+	}
+	m_stats.num_edges = edges / 2;
+	m_stats.num_scans = static_cast<unsigned int> (m_scans.size());
+
+	return &m_stats;
+}
+
+em_channel_planner_t::em_channel_planner_t(em_chan_plan_apply_func apply) : m_lock(), m_radios(), m_scans(), m_bss(),
+	m_apply(apply), m_generation(0), m_prefix(), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_chan_plan_stats_t));
+}
+
+em_channel_planner_t::~em_channel_planner_t()
+{
+
+}
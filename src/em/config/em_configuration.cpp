@@ -1050,8 +1050,11 @@ int em_configuration_t::send_topology_response_msg(unsigned char *dst)
         printf("%s:%d: Topology Response send failed, error:%d\n", __func__, __LINE__, errno);
         return -1;
     }
-    printf("setting state to em_state_agent_topo_synchronized\n");
-    set_state(em_state_agent_topo_synchronized);
+    // a configured agent only answers the periodic probes of the controller
+    if (get_state() == em_state_agent_onewifi_bssconfig_ind) {
+        printf("setting state to em_state_agent_topo_synchronized\n");
+        set_state(em_state_agent_topo_synchronized);
+    }
     return static_cast<int> (len);
 }
 
@@ -3652,7 +3655,8 @@ void em_configuration_t::process_msg(unsigned char *data, unsigned int len)
             break;
 
         case em_msg_type_topo_query:
-            if ((get_service_type() == em_service_type_agent) && (get_state() == em_state_agent_onewifi_bssconfig_ind)) {
+            if ((get_service_type() == em_service_type_agent) && ((get_state() == em_state_agent_onewifi_bssconfig_ind) ||
+                    (get_state() == em_state_agent_configured))) {
                 send_topology_response_msg(data);
             }
 			break;
@@ -3665,7 +3669,10 @@ void em_configuration_t::process_msg(unsigned char *data, unsigned int len)
 					printf("%s:%d em_msg_type_topo_resp handle failed \n", __func__, __LINE__);
 				}
 				
-            }			
+            } else if ((get_service_type() == em_service_type_ctrl) && (get_state() == em_state_ctrl_configured)) {
+                // answer to a scheduled topology probe, only the ones that differ from the last response get here
+                handle_topology_response(data, len);
+            }
             break;
 
         case em_msg_type_topo_notif:
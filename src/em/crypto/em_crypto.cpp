@@ -1211,6 +1211,12 @@ void em_crypto_t::free_key(SSL_KEY *key)
     if (!key) return;
     EVP_PKEY_free(key);
 }
+
+SSL_KEY *em_crypto_t::ref_key(SSL_KEY *key)
+{
+    if (!key || EVP_PKEY_up_ref(key) != 1) return NULL;
+    return key;
+}
 bool em_crypto_t::write_keypair_to_pem(const SSL_KEY *key, const std::string &file_path) { 
     
     FILE *fp = NULL;
@@ -1336,6 +1342,12 @@ void em_crypto_t::free_key(SSL_KEY *key)
     EC_KEY_free(key);
 }
 
+SSL_KEY *em_crypto_t::ref_key(SSL_KEY *key)
+{
+    if (!key || EC_KEY_up_ref(key) != 1) return NULL;
+    return key;
+}
+
 bool em_crypto_t::write_keypair_to_pem(const SSL_KEY *key, const std::string &file_path) { 
     
     FILE *fp = NULL;
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include "em_disc_sched.h"
+
+unsigned long long em_disc_sched_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+unsigned long long em_disc_sched_t::now_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return static_cast<unsigned long long> (ts.tv_sec) * 1000 + static_cast<unsigned long long> (ts.tv_nsec / 1000000);
+}
+
+unsigned long long em_disc_sched_t::hash(const unsigned char *buff, unsigned int len)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	const em_tlv_t *tlv;
+	unsigned int i, off, end;
+
+	// TLV by TLV up to the End of Message, the frame padding after it is left out as well
+	for (off = sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t); (off + sizeof(em_tlv_t)) <= len; off = end) {
+		tlv = reinterpret_cast<const em_tlv_t *> (buff + off);
+		end = off + static_cast<unsigned int> (sizeof(em_tlv_t)) + ntohs(tlv->len);
+		if (end > len) {
+			end = len;
+		}
+
+		for (i = off; i < end; i++) {
+			h = (h ^ buff[i]) * 1099511628211ULL;
+		}
+
+		if (tlv->type == em_tlv_type_eom) {
+			break;
+		}
+	}
+
+	return h;
+}
+
+em_disc_sched_t::neighbour_t& em_disc_sched_t::get(const unsigned char *al, unsigned long long now)
+{
+	unsigned long long key = mac_key(al);
+	auto it = m_neighbours.find(key);
+
+	if (it != m_neighbours.end()) {
+		return it->second;
+	}
+
+	// the phase comes from the MAC so the first probes of neighbours found together are spread out
+	neighbour_t& n = m_neighbours[key];
+	memcpy(n.al, al, sizeof(mac_address_t));
+	n.due = now + EM_DISC_MIN_INTERVAL_MS + (key % EM_DISC_MIN_INTERVAL_MS);
+	n.gen = m_gen;
+
+	return n;
+}
+
+void em_disc_sched_t::observe(const unsigned char *al, unsigned long long now)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	get(al, now).gen = m_gen;
+}
+
+unsigned int em_disc_sched_t::sweep()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int num = 0;
+
+	for (auto it = m_neighbours.begin(); it != m_neighbours.end(); ) {
+		if (it->second.gen != m_gen) {
+			it = m_neighbours.erase(it);
+			num++;
+		} else {
+			++it;
+		}
+	}
+	m_gen++;
+
+	return num;
+}
+
+unsigned int em_disc_sched_t::run(unsigned long long now, std::vector<em_disc_probe_t> *probe, std::vector<em_disc_probe_t> *lost)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	em_disc_probe_t p;
+	unsigned int num = 0;
+
+	for (auto& it : m_neighbours) {
+		neighbour_t& n = it.second;
+
+		if (n.due > now) {
+			continue;
+		}
+
+		if (n.outstanding == true) {
+			n.missed++;
+			m_stats.missed++;
+			if (n.lost == true) {
+				// a lost neighbour is still probed to find out when it is back, just less often
+				n.interval = (n.interval * 2 > EM_DISC_MAX_INTERVAL_MS) ? EM_DISC_MAX_INTERVAL_MS:n.interval * 2;
+			} else {
+				n.interval = EM_DISC_MIN_INTERVAL_MS;
+			}
+			if ((n.lost == false) && (n.missed >= EM_DISC_MAX_MISSED)) {
+				n.lost = true;
+				m_stats.losses++;
+				if (lost != NULL) {
+					memcpy(p.al, n.al, sizeof(mac_address_t));
+					p.missed = n.missed;
+					lost->push_back(p);
+				}
+			}
+		}
+
+		n.outstanding = true;
+		n.due = now + n.interval;
+		m_stats.probes++;
+		memcpy(p.al, n.al, sizeof(mac_address_t));
+		p.missed = n.missed;
+		probe->push_back(p);
+		num++;
+	}
+
+	return num;
+}
+
+bool em_disc_sched_t::heard(const unsigned char *al, unsigned long long hash, unsigned long long now)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	neighbour_t& n = get(al, now);
+	bool changed;
+
+	changed = (n.has_resp == false) || (n.resp_hash != hash) || (n.lost == true);
+	m_stats.responses++;
+	if (n.lost == true) {
+		n.lost = false;
+		m_stats.recoveries++;
+	}
+
+	if (changed == true) {
+		n.interval = EM_DISC_MIN_INTERVAL_MS;
+		m_stats.changed++;
+	} else {
+		n.interval = (n.interval * 2 > EM_DISC_MAX_INTERVAL_MS) ? EM_DISC_MAX_INTERVAL_MS:n.interval * 2;
+		m_stats.unchanged++;
+	}
+
+	n.resp_hash = hash;
+	n.has_resp = true;
+	n.outstanding = false;
+	n.missed = 0;
+	n.due = now + n.interval;
+
+	return changed;
+}
+
+void em_disc_sched_t::notify(const unsigned char *al, unsigned long long now)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	neighbour_t& n = get(al, now);
+
+	n.interval = EM_DISC_MIN_INTERVAL_MS;
+	n.due = now;
+	m_stats.notified++;
+}
+
+const em_disc_stats_t *em_disc_sched_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int num_lost = 0;
+
+	for (auto& it : m_neighbours) {
+		num_lost += (it.second.lost == true) ? 1:0;
+	}
+	m_stats.num_neighbours = static_cast<unsigned int> (m_neighbours.size());
+	m_stats.num_lost = num_lost;
+
+	return &m_stats;
+}
+
+em_disc_sched_t::em_disc_sched_t() : m_lock(), m_neighbours(), m_gen(0), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_disc_stats_t));
+}
+
+em_disc_sched_t::~em_disc_sched_t()
+{
+
+}
@@ -39,6 +39,7 @@
 #include <openssl/rand.h>
 #include "em.h"
 #include "em_cmd.h"
+#include "em_mgr.h"
 
 unsigned int em_discovery_t::create_topo_query_msg(unsigned char *buff)
 {
@@ -159,6 +160,32 @@ unsigned int em_discovery_t::create_topo_discovery_msg(unsigned char *buff)
     return len;
 }
 
+bool em_discovery_t::handle_topo_probe_resp(unsigned char *buff, unsigned int len)
+{
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *> (buff);
+    em_disc_sched_t *sched;
+
+    if ((get_service_type() != em_service_type_ctrl) || ((sched = get_mgr()->get_disc_sched()) == NULL) ||
+            (len < (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t)))) {
+        return true;
+    }
+
+    return sched->heard(hdr->src, em_disc_sched_t::hash(buff, len), em_disc_sched_t::now_ms());
+}
+
+void em_discovery_t::handle_topo_probe_notif(unsigned char *buff, unsigned int len)
+{
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *> (buff);
+    em_disc_sched_t *sched;
+
+    if ((get_service_type() != em_service_type_ctrl) || ((sched = get_mgr()->get_disc_sched()) == NULL) ||
+            (len < sizeof(em_raw_hdr_t))) {
+        return;
+    }
+
+    sched->notify(hdr->src, em_disc_sched_t::now_ms());
+}
+
 void em_discovery_t::process_msg(unsigned char *data, unsigned int len)
 {
 
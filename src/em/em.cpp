@@ -250,7 +250,28 @@ void em_t::set_orch_state(em_orch_state_t state)
 
 void em_t::handle_timeout()
 {
-    //printf("%s:%d: em timeout\n", __func__, __LINE__);
+    em_sm_recovery_t recovery;
+    em_state_t from, next;
+
+    if (m_is_al_em == true) {
+        return;
+    }
+
+    // runs on the manager thread, the state is only recovered if the em thread did not move it meanwhile
+    if ((recovery = m_sm.recover(em_sm_t::now_ms(), &from, &next)) == em_sm_recovery_none) {
+        return;
+    }
+
+    printf("%s:%d: state %s timed out, %s to %s\n", __func__, __LINE__, em_t::state_2_str(from),
+        em_sm_t::get_recovery_str(recovery), em_t::state_2_str(next));
+
+    // the reply is not coming, the command finishes now rather than at its TTL and the next one queries again
+    if ((recovery == em_sm_recovery_abandon) && (m_cmd != NULL) && (m_orch_state == em_orch_state_progress)) {
+        if ((m_cmd->m_fanout_job != 0) && (get_mgr()->get_fanout() != NULL)) {
+            get_mgr()->get_fanout()->complete(m_cmd->m_fanout_job, m_cmd->m_fanout_index, em_fanout_target_timed_out);
+        }
+        set_orch_state(em_orch_state_cancel);
+    }
 }
 
 void em_t::proto_process(unsigned char *data, unsigned int len)
@@ -285,14 +306,24 @@ void em_t::proto_process(unsigned char *data, unsigned int len)
         case em_msg_type_autoconf_resp:
         case em_msg_type_autoconf_wsc:
         case em_msg_type_autoconf_renew:
-        case em_msg_type_topo_resp:
         case em_msg_type_topo_query:
-        case em_msg_type_topo_notif:
         case em_msg_type_ap_mld_config_req:
         case em_msg_type_ap_mld_config_resp:
             em_configuration_t::process_msg(data, len);
             break;
 
+        case em_msg_type_topo_resp:
+            // once configured, the topology is rebuilt only from responses that differ from the last one
+            if ((em_discovery_t::handle_topo_probe_resp(data, len) == true) || (m_sm.get_state() != em_state_ctrl_configured)) {
+                em_configuration_t::process_msg(data, len);
+            }
+            break;
+
+        case em_msg_type_topo_notif:
+            em_discovery_t::handle_topo_probe_notif(data, len);
+            em_configuration_t::process_msg(data, len);
+            break;
+
         case em_msg_type_ap_cap_query:
         case em_msg_type_client_cap_query:
         case em_msg_type_client_cap_rprt:
@@ -332,7 +363,9 @@ void em_t::proto_process(unsigned char *data, unsigned int len)
         case em_msg_type_client_steering_req:
         case em_msg_type_client_steering_btm_rprt:
         case em_msg_type_1905_ack:
-            if (m_sm.get_state() == em_state_ctrl_ap_mld_configured) {
+            if ((htons(cmdu->type) == em_msg_type_1905_ack) && (em_policy_cfg_t::handle_policy_cfg_ack(data, len) > 0)) {
+                // the message id is one of a pending policy request, any other Ack goes to its exchange
+            } else if (m_sm.get_state() == em_state_ctrl_ap_mld_configured) {
                 em_configuration_t::process_msg(data, len);
             } else {
                 em_steering_t::process_msg(data, len);
@@ -571,7 +604,17 @@ void *em_t::em_func(void *arg)
 
 void em_t::deinit()
 {
+    std::set<unsigned int>::iterator it;
+
     m_exit = true;
+
+    pthread_mutex_lock(&m_timer_lock);
+    for (it = m_timer_ids.begin(); it != m_timer_ids.end(); it++) {
+        m_mgr->cancel_timer(*it);
+    }
+    m_timer_ids.clear();
+    pthread_mutex_unlock(&m_timer_lock);
+
     pthread_cond_destroy(&m_iq.cond);
     pthread_mutex_destroy(&m_iq.lock);
     close(m_fd);
@@ -668,27 +711,18 @@ int em_t::send_frame(unsigned char *buff, unsigned int len, bool multicast)
     }
 #ifdef AL_SAP
 
-    AlServiceDataUnit sdu;
-    sdu.setSourceAlMacAddress(g_al_mac_sap);
+    MacAddress dst_al_mac = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
     if (is_loopback_frame) {
-        sdu.setDestinationAlMacAddress(g_al_mac_sap);
+        dst_al_mac = g_al_mac_sap;
     } else {
         // Set the destination AL MAC address based on the service type
         if (m_service_type == em_service_type_ctrl) {
-            sdu.setDestinationAlMacAddress({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+            dst_al_mac = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
         }
-        if (m_service_type == em_service_type_agent) {
-            sdu.setDestinationAlMacAddress({0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
-        }
-    }
-
-    std::vector<unsigned char> payload;
-    for (unsigned int i = 0; i < len; i++) {
-        payload.push_back(buff[i]);
     }
-    sdu.setPayload(payload);
 
-    g_sap->serviceAccessPointDataRequest(sdu);
+    // the frame is sent from buff as is, no intermediate SDU copy
+    g_sap->serviceAccessPointDataRequest(g_al_mac_sap, dst_al_mac, buff, len);
 #else
     em_short_string_t   ifname;
     struct sockaddr_ll sadr_ll;
@@ -1295,6 +1329,7 @@ const char *em_t::state_2_str(em_state_t state)
         EM_STATE_2S(em_state_agent_sta_link_metrics_pending)
         EM_STATE_2S(em_state_max)
         EM_STATE_2S(em_state_agent_beacon_report_pending)
+        EM_STATE_2S(em_state_agent_ap_metrics_pending)
         EM_STATE_2S(em_state_agent_channel_select_configuration_pending)
         default: break;
     }
@@ -1315,8 +1350,9 @@ const char *em_t::get_band_type_str(em_freq_band_t band)
     return "band_type_unknown";
 }
 
-em_t::em_t(em_interface_t *ruid, em_freq_band_t band, dm_easy_mesh_t *dm, em_mgr_t *mgr, em_profile_type_t profile, em_service_type_t type, bool is_al_em): m_data_model(), m_mgr(mgr), m_orch_state(), m_cmd(), m_sm(), m_service_type(), m_fd(0), m_ruid(*ruid), m_band(band), m_profile_type(profile), m_iq(), m_tid(), m_exit(), m_is_al_em(is_al_em)
+em_t::em_t(em_interface_t *ruid, em_freq_band_t band, dm_easy_mesh_t *dm, em_mgr_t *mgr, em_profile_type_t profile, em_service_type_t type, bool is_al_em): m_data_model(), m_mgr(mgr), m_orch_state(), m_cmd(), m_sm(), m_service_type(), m_fd(0), m_ruid(*ruid), m_band(band), m_profile_type(profile), m_iq(), m_tid(), m_exit(), m_is_al_em(is_al_em), m_timer_ids(), m_timer_lock()
 {
+    pthread_mutex_init(&m_timer_lock, NULL);
     memcpy(&m_ruid, ruid, sizeof(em_interface_t));
     m_band = band;  
     m_service_type = type;
@@ -1354,10 +1390,61 @@ em_t::em_t(em_interface_t *ruid, em_freq_band_t band, dm_easy_mesh_t *dm, em_mgr
             std::bind(&em_t::bsta_connect_bss, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
             service_type == em_service_type_ctrl
         ));
+        m_ec_manager->set_timer_fns(
+            std::bind(&em_t::add_timer, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+            std::bind(&em_t::cancel_timer, this, std::placeholders::_1));
     }
 }
 
-em_t::~em_t()
+unsigned int em_t::add_timer(unsigned int ms, bool periodic, em_timer_cb_t cb)
 {
+    std::shared_ptr<unsigned int> id = std::make_shared<unsigned int>(EM_TIMER_INVALID_ID);
+
+    pthread_mutex_lock(&m_timer_lock);
+    *id = m_mgr->add_timer(ms, periodic, [this, id, periodic, cb]() {
+        if (periodic == false) {
+            pthread_mutex_lock(&m_timer_lock);
+            m_timer_ids.erase(*id);
+            pthread_mutex_unlock(&m_timer_lock);
+        }
+        cb();
+    });
+    m_timer_ids.insert(*id);
+    pthread_mutex_unlock(&m_timer_lock);
+
+    return *id;
+}
 
+int em_t::cancel_timer(unsigned int id)
+{
+    pthread_mutex_lock(&m_timer_lock);
+    m_timer_ids.erase(id);
+    pthread_mutex_unlock(&m_timer_lock);
+
+    return m_mgr->cancel_timer(id);
+}
+
+em_metrics_store_t *em_t::get_metrics_store()
+{
+    return (m_mgr != NULL) ? m_mgr->get_metrics_store():NULL;
+}
+
+em_channel_planner_t *em_t::get_channel_planner()
+{
+    return (m_mgr != NULL) ? m_mgr->get_channel_planner():NULL;
+}
+
+em_steer_engine_t *em_t::get_steer_engine()
+{
+    return (m_mgr != NULL) ? m_mgr->get_steer_engine():NULL;
+}
+
+em_client_cap_cache_t *em_t::get_client_cap_cache()
+{
+    return (m_mgr != NULL) ? m_mgr->get_client_cap_cache():NULL;
+}
+
+em_t::~em_t()
+{
+    pthread_mutex_destroy(&m_timer_lock);
 }
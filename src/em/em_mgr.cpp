@@ -336,7 +336,7 @@ int em_mgr_t::reset_listeners()
 	pthread_mutex_lock(&m_mutex);
     em = static_cast<em_t *>(hash_map_get_first(m_em_map));
     while (em != NULL) {
-        if (em->is_al_interface_em() == true) {
+        if ((em->is_al_interface_em() == true) && (m_sap_down == false)) {
             FD_SET(em->get_fd(), &m_rset);
             num++;
             highest_fd = (em->get_fd() > highest_fd) ? em->get_fd():highest_fd;
@@ -355,12 +355,35 @@ void em_mgr_t::nodes_listener()
     int rc, highest_fd = 0, ret = 0;
     ssize_t len;
     unsigned char buff[MAX_EM_BUFF_SZ];
+#ifdef AL_SAP
+    std::vector<AlServiceDataUnit> sdus;
+    PrimitiveError err;
+    size_t i, num_sdus;
+    struct timespec now, sap_retry = {0, 0};
+
+    sdus.reserve(EM_MAX_SAP_BATCH);
+#endif
 
     tm.tv_sec = 0;
     tm.tv_usec = m_timeout * 1000;
     highest_fd = reset_listeners();
 
     while ((rc = select(highest_fd + 1, &m_rset, NULL, NULL, &tm)) >= 0) {
+#ifdef AL_SAP
+        // one attempt per wakeup at most, the other descriptors are served meanwhile
+        if (m_sap_down == true) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (now.tv_sec >= sap_retry.tv_sec) {
+                if ((err = g_sap->reconnect()) == PrimitiveError::Success) {
+                    em_printfout("AL SAP reconnected");
+                    m_sap_down = false;
+                } else {
+                    em_printfout("AL SAP reconnection failed, err:%d, retrying in %d s", static_cast<int>(err), EM_SAP_RECONNECT_INTERVAL);
+                    sap_retry.tv_sec = now.tv_sec + EM_SAP_RECONNECT_INTERVAL;
+                }
+            }
+        }
+#endif
         if (rc == 0) {
             tm.tv_sec = 0;
             tm.tv_usec = m_timeout * 1000;
@@ -373,16 +396,23 @@ void em_mgr_t::nodes_listener()
         while (em != NULL) {
             if (em->is_al_interface_em() == true) {
 #ifdef AL_SAP
-                try{
-                    AlServiceDataUnit sdu = g_sap->serviceAccessPointDataIndication();
-                    std::vector<unsigned char> payload = sdu.getPayload();
-                    proto_process(payload.data(), payload.size(), em);
-                } catch (const AlServiceException& e) {
-                    if (e.getPrimitiveError() == PrimitiveError::InvalidMessage) {
-                        em_printfout("%s. Dropping packet", e.what());
-                    } else {
-                        em_printfout("%s", e.what());
-                        throw e; // rethrow the exception if it's not an indication failure
+				pthread_mutex_lock(&m_mutex);
+				ret = FD_ISSET(em->get_fd(), &m_rset);
+				pthread_mutex_unlock(&m_mutex);
+				if (ret) {
+                    // drain whatever the SAP has ready, the sdus slots and their buffers are reused on every wakeup
+                    err = g_sap->serviceAccessPointDataIndication(sdus, EM_MAX_SAP_BATCH, num_sdus);
+                    for (i = 0; i < num_sdus; i++) {
+                        std::vector<unsigned char>& payload = sdus[i].getPayload();
+                        proto_process(payload.data(), static_cast<unsigned int>(payload.size()), em);
+                    }
+                    if (err == PrimitiveError::SocketClosed) {
+                        // the descriptor is kept across the reconnection, reconnected from the next wakeups
+                        em_printfout("AL SAP data socket closed, reconnecting");
+                        m_sap_down = true;
+                        sap_retry.tv_sec = 0;
+                    } else if (err != PrimitiveError::Success) {
+                        em_printfout("AL SAP receive failed");
                     }
                 }
 #else
@@ -460,11 +490,19 @@ int em_mgr_t::nodes_listen()
 
 void em_mgr_t::handle_timeout()
 {
+	em_t *em;
+
 	m_tick_demultiplex++;
 
 	handle_500ms_tick();
 	
 	if ((m_tick_demultiplex % EM_1_TOUT_MULT) == 0) {
+		// state deadlines
+		em = static_cast<em_t *>(hash_map_get_first(m_em_map));
+		while (em != NULL) {
+			em->handle_timeout();
+			em = static_cast<em_t *>(hash_map_get_next(m_em_map, em));
+		}
 		handle_1s_tick();
 	} 
 
@@ -482,64 +520,87 @@ void em_mgr_t::handle_timeout()
 int em_mgr_t::start()
 {
     int rc;
-    em_event_t *evt;;
+    em_event_t *evt;
     struct timespec time_to_wait;
-    struct timeval tm;
+    unsigned int num;
 	bool started = false;
+	unsigned int tick_id;
 
     input_listen();
     nodes_listen();
 
+	// the 500ms tick is a periodic timer, it runs between event batches even when the queue never drains
+	tick_id = add_timer(m_queue.timeout, true, [this, &started]() {
+		if (is_data_model_initialized() == false) {
+			return;
+		}
+		if (started == false) {
+			start_complete();
+			started = true;
+		}
+		handle_timeout();
+	});
+
     pthread_mutex_lock(&m_queue.lock);
     while (m_exit == false) {
         rc = 0;
 
-        gettimeofday(&tm, NULL);
-        time_to_wait.tv_sec = tm.tv_sec;
-       	time_to_wait.tv_nsec = tm.tv_usec * 1000;
-		util::add_milliseconds(&time_to_wait, m_queue.timeout);		
-
         if (queue_count(m_queue.queue) == 0) {
+			// the queue condition uses the monotonic clock, see init()
+            clock_gettime(CLOCK_MONOTONIC, &time_to_wait);
+			util::add_milliseconds(&time_to_wait, m_timers.get_wait_ms(m_queue.timeout));
             rc = pthread_cond_timedwait(&m_queue.cond, &m_queue.lock, &time_to_wait);
         }
-        if ((rc == 0) || (queue_count(m_queue.queue) != 0)) {
-            // dequeue data
-            while (queue_count(m_queue.queue)) {
-                evt = static_cast<em_event_t *>(queue_pop(m_queue.queue));
-                if (evt == NULL) {
-                    continue;
-                }
-                pthread_mutex_unlock(&m_queue.lock);
-                if (((evt->type == em_event_type_bus) && (evt->u.bevt.type == em_bus_event_type_reset)) || 
-						(is_data_model_initialized() == true)) {
-		
-                    handle_event(evt);
-                }
-                free(evt);
-                pthread_mutex_lock(&m_queue.lock);
+
+        if ((rc != 0) && (rc != ETIMEDOUT)) {
+            printf("%s:%d em exited with rc - %d\n",__func__,__LINE__, rc);
+            pthread_mutex_unlock(&m_queue.lock);
+            cancel_timer(tick_id);
+            return -1;
+        }
+
+        // dequeue a bounded batch so that due timers are not starved by a busy queue
+        num = 0;
+        while ((queue_count(m_queue.queue) != 0) && (num < EM_MGR_MAX_EVENT_BATCH)) {
+            evt = static_cast<em_event_t *>(queue_pop(m_queue.queue));
+            num++;
+            if (evt == NULL) {
+                continue;
             }
-        } else if (rc == ETIMEDOUT) {
             pthread_mutex_unlock(&m_queue.lock);
-            //printf("%s:%d: Timeout secs: %d\n", __func__, __LINE__, time_to_wait.tv_sec);
-            if (is_data_model_initialized() == true) {  
-				if (started == false) {
-					start_complete();	
-					started = true;
-				}          
-                handle_timeout();
+            if (((evt->type == em_event_type_bus) && (evt->u.bevt.type == em_bus_event_type_reset)) || 
+					(is_data_model_initialized() == true)) {
+	
+                handle_event(evt);
             }
+            free(evt);
             pthread_mutex_lock(&m_queue.lock);
-        } else {
-            printf("%s:%d em exited with rc - %d\n",__func__,__LINE__, rc);
-            pthread_mutex_unlock(&m_queue.lock);
-            return -1;
         }
+
+        pthread_mutex_unlock(&m_queue.lock);
+        m_timers.run();
+        pthread_mutex_lock(&m_queue.lock);
     }
     pthread_mutex_unlock(&m_queue.lock);
+    cancel_timer(tick_id);
 
     return 0;	
 }
 
+unsigned int em_mgr_t::add_timer(unsigned int ms, bool periodic, em_timer_cb_t cb)
+{
+    unsigned int id;
+
+    id = m_timers.add(ms, periodic, cb);
+
+    // the manager thread may be sleeping past the new deadline
+    pthread_mutex_lock(&m_queue.lock);
+    pthread_cond_signal(&m_queue.cond);
+    pthread_mutex_unlock(&m_queue.lock);
+
+    return id;
+}
+
 void em_mgr_t::push_to_queue(em_event_t *evt)
 {
     pthread_mutex_lock(&m_queue.lock);
@@ -555,6 +616,8 @@ em_event_t *em_mgr_t::pop_from_queue()
 
 int em_mgr_t::init(const char *data_model_path)
 {
+    pthread_condattr_t cond_attr;
+
     SSL_load_error_strings(); 
     SSL_library_init(); 
 
@@ -563,7 +626,10 @@ int em_mgr_t::init(const char *data_model_path)
     // initialize the egress queue
     m_queue.queue = queue_create();
     pthread_mutex_init(&m_queue.lock, NULL);
-    pthread_cond_init(&m_queue.cond, NULL);
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_queue.cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
 
     m_queue.timeout = EM_MGR_TOUT;
 
@@ -576,6 +642,7 @@ em_mgr_t::em_mgr_t()
     m_exit = false;
     m_timeout = EM_MGR_TOUT;
 	m_tick_demultiplex = 0;
+	m_sap_down = false;
 }
 
 em_mgr_t::~em_mgr_t()
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <errno.h>
 #include <assert.h>
 #include <signal.h>
@@ -226,145 +227,147 @@ void em_net_node_t::set_node_scalar_value(em_network_node_t *node, char *fmt)
 	}
 }
 
-void em_net_node_t::get_network_tree_node_string(char *str, em_network_node_t *node, unsigned int *pident)
+void em_net_node_t::render_append(em_net_node_render_t *out, const char *fmt, ...)
 {
-    unsigned int i, ident = 0;
-    em_long_string_t fmt = {0};
-    em_3xlong_string_t string = {0};
-    em_2xlong_string_t value_str = {0};
-    em_2xlong_string_t tmp_str;
+    va_list args;
+    size_t size;
+    int len;
 
-    ident = *pident;
-    ident++;
-    *pident = ident;
+    va_start(args, fmt);
+    len = vsnprintf(out->buff + out->len, out->size - out->len, fmt, args);
+    va_end(args);
 
-    for (i = 0; i < ident; i++) {
-        strncat(fmt, "   ", (sizeof(fmt) - strlen(fmt) - 1));
+    if (len < 0) {
+        return;
     }
 
-    switch (node->type) {
-        case em_network_node_data_type_invalid:
-            break;
+    if ((out->len + static_cast<size_t> (len)) >= out->size) {
+        for (size = out->size * 2; size <= (out->len + static_cast<size_t> (len)); size *= 2);
+        out->buff = static_cast<char *> (realloc(out->buff, size));
+        out->size = size;
+
+        va_start(args, fmt);
+        vsnprintf(out->buff + out->len, out->size - out->len, fmt, args);
+        va_end(args);
+    }
+
+    out->len += static_cast<size_t> (len);
+}
 
+void em_net_node_t::render_network_tree_node(em_net_node_render_t *out, em_network_node_t *node, unsigned int ident)
+{
+    static const char spaces[] = "                                                                ";
+    unsigned int i;
+    int width;
+
+    ident++;
+    width = static_cast<int> (((3 * ident) < sizeof(spaces)) ? (3 * ident):(sizeof(spaces) - 1));
+
+    switch (node->type) {
         case em_network_node_data_type_false:
-            snprintf(string, sizeof(em_3xlong_string_t), "%s%s:\tfalse\n", fmt, node->key);
+            render_append(out, "%.*s%s:\tfalse\n", width, spaces, node->key);
             break;
 
         case em_network_node_data_type_true:
-            snprintf(string, sizeof(em_3xlong_string_t), "%s%s:\ttrue\n", fmt, node->key);
-            break;
-
-        case em_network_node_data_type_null:
+            render_append(out, "%.*s%s:\ttrue\n", width, spaces, node->key);
             break;
 
         case em_network_node_data_type_number:
-            snprintf(string, sizeof(em_3xlong_string_t), "%s%s:\t%d\n", fmt, node->key, node->value_int);
+            render_append(out, "%.*s%s:\t%d\n", width, spaces, node->key, static_cast<int> (node->value_int));
             break;
 
         case em_network_node_data_type_string:
-            snprintf(string, sizeof(em_3xlong_string_t), "%s%s:\t%s\n", fmt, node->key, node->value_str);
+            render_append(out, "%.*s%s:\t%s\n", width, spaces, node->key, node->value_str);
             break;
 
         case em_network_node_data_type_array_obj:
-            snprintf(string, sizeof(em_3xlong_string_t), "%s%s:", fmt, node->key);
-            if ((node->num_children > 0) && ((node->child[0]->type == em_network_node_data_type_array_obj) ||
-                        (node->child[0]->type == em_network_node_data_type_obj))) {
-                printf("\n");
-            } else if (node->num_children == 0) {
-                //printf("\n");
-            }
+            render_append(out, "%.*s%s:", width, spaces, node->key);
             break;
 
         case em_network_node_data_type_obj:
             if (node->key[0] != 0) {
-                snprintf(string, sizeof(em_3xlong_string_t), "%s%s\t\n", fmt, node->key);
+                render_append(out, "%.*s%s\t\n", width, spaces, node->key);
             }
             break;
 
-        case em_network_node_data_type_raw:
-            break;
-
         default:
             break;
-
     }
 
-    strncat(str, string, strlen(string));
-
     if ((node->type == em_network_node_data_type_array_obj) && (node->num_children > 0) &&
             ((node->child[0]->type == em_network_node_data_type_number) ||
              (node->child[0]->type == em_network_node_data_type_string))) {
-
-        snprintf(value_str, sizeof(em_2xlong_string_t), "[");
         for (i = 0; i < node->num_children; i++) {
             if (node->child[0]->type == em_network_node_data_type_string) {
-                snprintf(tmp_str, sizeof(em_2xlong_string_t), "%s, ", node->child[i]->value_str);
+                render_append(out, "%s%s", (i == 0) ? "[":", ", node->child[i]->value_str);
             } else {
-                snprintf(tmp_str, sizeof(em_2xlong_string_t), "%d, ", node->child[i]->value_int);
+                render_append(out, "%s%d", (i == 0) ? "[":", ", static_cast<int> (node->child[i]->value_int));
             }
-            size_t available_len = std::min(strlen(tmp_str), (sizeof(value_str) - strlen(value_str) - 1));
-            strncat(value_str, tmp_str, available_len);
         }
+        render_append(out, "] \n");
+        return;
+    }
 
-        value_str[strlen(value_str) - 2] = ']';
-        strncat(value_str, "\n", (sizeof(value_str) - strlen(value_str) - 1));
-        strncat(str, value_str, strlen(value_str));
-    } else {
-
-        if (node->type == em_network_node_data_type_array_obj) {
-            if (node->num_children == 0) {
-                strncat(str, "[", (sizeof(str) - strlen(str) - 1));
-            } else {
-                snprintf(value_str, sizeof(value_str), "%s[\n", fmt);
-                strncat(str, value_str, strlen(value_str));
-            }
-        } else if (node->type == em_network_node_data_type_obj) {
-            if (node->num_children == 0) {
-                strncat(str, "{", (sizeof(str) - strlen(str) - 1));
-            } else {
-                snprintf(value_str, sizeof(value_str), "%s{\n", fmt);
-                strncat(str, value_str, strlen(value_str));
-            }
+    if (node->type == em_network_node_data_type_array_obj) {
+        if (node->num_children == 0) {
+            render_append(out, "[");
+        } else {
+            render_append(out, "%.*s[\n", width, spaces);
         }
-
-        for (i = 0; i < node->num_children; i++) {
-            get_network_tree_node_string(str, node->child[i], pident);
+    } else if (node->type == em_network_node_data_type_obj) {
+        if (node->num_children == 0) {
+            render_append(out, "{");
+        } else {
+            render_append(out, "%.*s{\n", width, spaces);
         }
-        if (node->type == em_network_node_data_type_array_obj) {
-            if (node->num_children == 0) {
-                strncat(str, "]\n", (sizeof(str) - strlen(str) - 1));
-            } else {
-                snprintf(value_str, sizeof(value_str), "%s]\n", fmt);
-                strncat(str, value_str, strlen(value_str));
-            }
-        } else if (node->type == em_network_node_data_type_obj) {
-            if (node->num_children == 0) {
-                strncat(str, "}\n", (sizeof(str) - strlen(str) - 1));
-            } else {
-                snprintf(value_str, sizeof(value_str), "%s}\n", fmt);
-                strncat(str, value_str, strlen(value_str));
-            }
+    }
 
+    for (i = 0; i < node->num_children; i++) {
+        render_network_tree_node(out, node->child[i], ident);
+    }
+
+    if (node->type == em_network_node_data_type_array_obj) {
+        if (node->num_children == 0) {
+            render_append(out, "]\n");
+        } else {
+            render_append(out, "%.*s]\n", width, spaces);
+        }
+    } else if (node->type == em_network_node_data_type_obj) {
+        if (node->num_children == 0) {
+            render_append(out, "}\n");
+        } else {
+            render_append(out, "%.*s}\n", width, spaces);
         }
     }
+}
+
+void em_net_node_t::get_network_tree_node_string(char *str, em_network_node_t *node, unsigned int *pident)
+{
+    em_net_node_render_t out;
+
+    out.size = EM_IO_BUFF_SZ;
+    out.len = 0;
+    out.buff = static_cast<char *> (malloc(out.size));
+    out.buff[0] = 0;
 
-    ident = *pident;
-    ident--;
-    *pident = ident;
+    render_network_tree_node(&out, node, *pident);
+
+    memcpy(str + strlen(str), out.buff, out.len + 1);
+    free(out.buff);
 }
 
 char *em_net_node_t::get_network_tree_string(em_network_node_t *node)
 {
-    unsigned int ident = 0;
-    unsigned int size = EM_LONG_IO_BUFF_SZ;
-    char *str;
+    em_net_node_render_t out;
 
-    str = static_cast<char *> (malloc(size));
-    memset(str, 0, size);
+    out.size = EM_LONG_IO_BUFF_SZ;
+    out.len = 0;
+    out.buff = static_cast<char *> (malloc(out.size));
+    out.buff[0] = 0;
 
-    get_network_tree_node_string(str, node, &ident);	
+    render_network_tree_node(&out, node, 0);
 
-    return str;
+    return out.buff;
 }
 
 cJSON *em_net_node_t::network_tree_node_to_json(em_network_node_t *node, cJSON *parent)
@@ -584,6 +587,103 @@ em_network_node_t *em_net_node_t::clone_network_tree(em_network_node_t *node)
 	return cloned;
 }
 
+unsigned int em_net_node_t::count_network_tree_nodes(em_network_node_t *node)
+{
+    unsigned int i, count = 1;
+
+    node->display_info.modified = true;
+    for (i = 0; i < node->num_children; i++) {
+        count += count_network_tree_nodes(node->child[i]);
+    }
+
+    return count;
+}
+
+unsigned int em_net_node_t::merge_network_tree_node(em_network_node_t *prev, em_network_node_t *next)
+{
+    em_network_node_t *children[EM_MAX_DM_CHILDREN];
+    bool used[EM_MAX_DM_CHILDREN] = {false};
+    unsigned int i, j, changed = 0;
+
+    if ((prev->type != next->type) || (prev->value_int != next->value_int) ||
+            (strncmp(prev->value_str, next->value_str, sizeof(em_long_string_t)) != 0)) {
+        prev->type = next->type;
+        prev->value_int = next->value_int;
+        strncpy(prev->value_str, next->value_str, sizeof(em_long_string_t));
+        changed++;
+    }
+
+    // children are matched by key, array elements have none and are matched by position
+    for (i = 0; i < next->num_children; i++) {
+        j = i;
+        if ((j >= prev->num_children) || (used[j] == true) ||
+                (strncmp(prev->child[j]->key, next->child[i]->key, sizeof(em_long_string_t)) != 0)) {
+            for (j = 0; j < prev->num_children; j++) {
+                if ((used[j] == false) && (strncmp(prev->child[j]->key, next->child[i]->key, sizeof(em_long_string_t)) == 0)) {
+                    break;
+                }
+            }
+        }
+
+        if (j < prev->num_children) {
+            used[j] = true;
+            changed += merge_network_tree_node(prev->child[j], next->child[i]);
+            children[i] = prev->child[j];
+            changed += (i != j) ? 1:0;
+        } else {
+            children[i] = next->child[i];
+            next->child[i] = NULL;
+            changed += count_network_tree_nodes(children[i]);
+        }
+    }
+
+    for (j = 0; j < prev->num_children; j++) {
+        if (used[j] == false) {
+            free_network_tree_node(prev->child[j]);
+            changed++;
+        }
+    }
+
+    memcpy(prev->child, children, next->num_children * sizeof(em_network_node_t *));
+    prev->num_children = next->num_children;
+    prev->display_info.modified = (changed > 0);
+
+    return changed;
+}
+
+void em_net_node_t::renumber_network_tree(em_network_node_t *node, unsigned int *node_display_ctr)
+{
+    em_network_node_t *child;
+    unsigned int i;
+
+    for (i = 0; i < node->num_children; i++) {
+        child = node->child[i];
+        if ((node->type != em_network_node_data_type_array_obj) || (child->type == em_network_node_data_type_obj) ||
+                (child->type == em_network_node_data_type_array_obj)) {
+            (*node_display_ctr)++;
+        }
+        child->display_info.node_ctr = *node_display_ctr;
+        child->display_info.orig_node_ctr = *node_display_ctr;
+        child->display_info.node_pos = node->display_info.node_pos + 1;
+        renumber_network_tree(child, node_display_ctr);
+    }
+}
+
+unsigned int em_net_node_t::merge_network_tree(em_network_node_t *prev, em_network_node_t *next)
+{
+    unsigned int changed, node_display_ctr = 0;
+
+    if ((prev == NULL) || (next == NULL)) {
+        return 0;
+    }
+
+    if ((changed = merge_network_tree_node(prev, next)) > 0) {
+        renumber_network_tree(prev, &node_display_ctr);
+    }
+
+    return changed;
+}
+
 em_network_node_t *em_net_node_t::clone_network_tree_for_display(em_network_node_t *orig_node, em_network_node_t *dis_node, unsigned int index, bool collapse, unsigned int *node_display_ctr)
 {
     em_network_node_t *cloned = NULL, *tree_to_add = NULL;
@@ -694,6 +794,10 @@ void em_net_node_t::free_network_tree_node(em_network_node_t *node)
 {
     unsigned int i;
 
+    if (node == NULL) {
+        return;
+    }
+
     for (i = 0; i < node->num_children; i++) {
         free_network_tree_node(node->child[i]);
     }
@@ -815,3 +919,8 @@ extern "C" em_network_node_t *clone_network_tree(em_network_node_t *node)
 {
     return em_net_node_t::clone_network_tree(node);
 }
+
+extern "C" unsigned int merge_network_tree(em_network_node_t *prev, em_network_node_t *next)
+{
+    return em_net_node_t::merge_network_tree(prev, next);
+}
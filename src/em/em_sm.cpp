@@ -22,35 +22,302 @@
 #include <ctype.h>
 #include <errno.h>
 #include <assert.h>
+#include <time.h>
 #include "em_sm.h"
 
+#define EM_SM_AGENT_ANY		((1ULL << (EM_SM_STATE_INDEX(em_state_agent_ap_metrics_pending) + 1)) - 1)
+#define EM_SM_CTRL_ANY		((1ULL << (EM_SM_STATE_INDEX(em_state_ctrl_avail_spectrum_inquiry_pending) + 1)) - 1)
+
+// agent states once the topology is synchronized with the controller
+#define EM_SM_AGENT_SYNCED	(EM_SM_AGENT_ANY & ~(EM_SM_BIT(em_state_agent_unconfigured) | \
+				EM_SM_BIT(em_state_agent_autoconfig_rsp_pending) | EM_SM_BIT(em_state_agent_wsc_m2_pending) | \
+				EM_SM_BIT(em_state_agent_owconfig_pending) | EM_SM_BIT(em_state_agent_onewifi_bssconfig_ind) | \
+				EM_SM_BIT(em_state_agent_autoconfig_renew_pending)))
+
+// controller states once the topology of the agent is synchronized
+#define EM_SM_CTRL_SYNCED	(EM_SM_CTRL_ANY & ~(EM_SM_BIT(em_state_ctrl_unconfigured) | \
+				EM_SM_BIT(em_state_ctrl_wsc_m1_pending) | EM_SM_BIT(em_state_ctrl_wsc_m2_sent) | \
+				EM_SM_BIT(em_state_ctrl_topo_sync_pending)))
+
+#define EM_SM_AGENT_REPORT(s)	{ s, EM_SM_BIT(em_state_agent_configured), EM_SM_REPORT_DEADLINE, \
+				em_sm_recovery_abandon, em_state_agent_configured }
+#define EM_SM_CTRL_REQUEST(s)	{ s, EM_SM_BIT(em_state_ctrl_configured), EM_SM_REPORT_DEADLINE, \
+				em_sm_recovery_abandon, em_state_ctrl_configured }
+
+static const em_sm_state_desc_t em_sm_agent_table[] = {
+	{ em_state_agent_unconfigured, EM_SM_AGENT_ANY, 0, em_sm_recovery_none, em_state_agent_unconfigured },
+	{ em_state_agent_autoconfig_rsp_pending, EM_SM_BIT(em_state_agent_unconfigured),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_agent_unconfigured },
+	{ em_state_agent_wsc_m2_pending, EM_SM_BIT(em_state_agent_autoconfig_rsp_pending) | EM_SM_BIT(em_state_agent_autoconfig_renew_pending),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_agent_unconfigured },
+	{ em_state_agent_owconfig_pending, EM_SM_BIT(em_state_agent_wsc_m2_pending),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_agent_unconfigured },
+	{ em_state_agent_onewifi_bssconfig_ind, EM_SM_AGENT_ANY,
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_agent_unconfigured },
+	{ em_state_agent_autoconfig_renew_pending, EM_SM_AGENT_ANY,
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_agent_unconfigured },
+	{ em_state_agent_topo_synchronized, EM_SM_BIT(em_state_agent_onewifi_bssconfig_ind) | EM_SM_AGENT_SYNCED,
+		0, em_sm_recovery_none, em_state_agent_topo_synchronized },
+	{ em_state_agent_channel_pref_query, EM_SM_BIT(em_state_agent_topo_synchronized),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_agent_topo_synchronized },
+	{ em_state_agent_channel_selection_pending, EM_SM_BIT(em_state_agent_channel_pref_query),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	{ em_state_agent_channel_select_configuration_pending, EM_SM_AGENT_SYNCED,
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	{ em_state_agent_channel_report_pending, EM_SM_AGENT_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	EM_SM_AGENT_REPORT(em_state_agent_channel_scan_result_pending),
+	{ em_state_agent_configured, EM_SM_AGENT_SYNCED, 0, em_sm_recovery_none, em_state_agent_configured },
+	{ em_state_agent_topology_notify, EM_SM_AGENT_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	{ em_state_agent_ap_cap_report, EM_SM_AGENT_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	{ em_state_agent_client_cap_report, EM_SM_AGENT_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_agent_configured },
+	EM_SM_AGENT_REPORT(em_state_agent_sta_link_metrics_pending),
+	EM_SM_AGENT_REPORT(em_state_agent_steer_btm_res_pending),
+	EM_SM_AGENT_REPORT(em_state_agent_beacon_report_pending),
+	EM_SM_AGENT_REPORT(em_state_agent_ap_metrics_pending),
+};
+
+static const em_sm_state_desc_t em_sm_ctrl_table[] = {
+	{ em_state_ctrl_unconfigured, 0, 0, em_sm_recovery_none, em_state_ctrl_unconfigured },
+	{ em_state_ctrl_wsc_m1_pending, EM_SM_CTRL_ANY,
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_wsc_m2_sent, EM_SM_BIT(em_state_ctrl_wsc_m1_pending),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_topo_sync_pending, EM_SM_BIT(em_state_ctrl_wsc_m2_sent),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_topo_synchronized, EM_SM_BIT(em_state_ctrl_topo_sync_pending),
+		0, em_sm_recovery_none, em_state_ctrl_topo_synchronized },
+	{ em_state_ctrl_channel_query_pending, EM_SM_BIT(em_state_ctrl_topo_synchronized) | EM_SM_BIT(em_state_ctrl_configured),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_channel_pref_report_pending, EM_SM_BIT(em_state_ctrl_channel_query_pending),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_channel_queried, EM_SM_BIT(em_state_ctrl_channel_query_pending) | EM_SM_BIT(em_state_ctrl_channel_pref_report_pending),
+		EM_SM_CONFIG_DEADLINE, em_sm_recovery_restart_autoconfig, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_channel_select_pending, EM_SM_BIT(em_state_ctrl_channel_queried) | EM_SM_BIT(em_state_ctrl_channel_selected) |
+		EM_SM_BIT(em_state_ctrl_configured) | EM_SM_BIT(em_state_ctrl_misconfigured),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_channel_selected, EM_SM_BIT(em_state_ctrl_channel_select_pending) | EM_SM_BIT(em_state_ctrl_avail_spectrum_inquiry_pending),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_channel_cnf_pending, EM_SM_BIT(em_state_ctrl_channel_selected),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_channel_report_pending, 0, 0, em_sm_recovery_none, em_state_ctrl_channel_report_pending },
+	EM_SM_CTRL_REQUEST(em_state_ctrl_channel_scan_pending),
+	{ em_state_ctrl_configured, EM_SM_CTRL_SYNCED, 0, em_sm_recovery_none, em_state_ctrl_configured },
+	{ em_state_ctrl_misconfigured, EM_SM_CTRL_ANY, 0, em_sm_recovery_none, em_state_ctrl_misconfigured },
+	{ em_state_ctrl_sta_cap_pending, EM_SM_CTRL_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_sta_cap_confirmed, EM_SM_BIT(em_state_ctrl_sta_cap_pending),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	EM_SM_CTRL_REQUEST(em_state_ctrl_sta_link_metrics_pending),
+	EM_SM_CTRL_REQUEST(em_state_ctrl_sta_steer_pending),
+	{ em_state_ctrl_steer_btm_req_ack_rcvd, EM_SM_BIT(em_state_ctrl_sta_steer_pending),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	EM_SM_CTRL_REQUEST(em_state_ctrl_sta_disassoc_pending),
+	EM_SM_CTRL_REQUEST(em_state_ctrl_set_policy_pending),
+	{ em_state_ctrl_ap_mld_config_pending, EM_SM_CTRL_SYNCED,
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_ap_mld_configured, EM_SM_BIT(em_state_ctrl_ap_mld_config_pending),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	{ em_state_ctrl_bsta_mld_config_pending, 0, 0, em_sm_recovery_none, em_state_ctrl_bsta_mld_config_pending },
+	{ em_state_ctrl_ap_mld_req_ack_rcvd, EM_SM_BIT(em_state_ctrl_ap_mld_config_pending) | EM_SM_BIT(em_state_ctrl_ap_mld_configured),
+		EM_SM_REPORT_DEADLINE, em_sm_recovery_abandon, em_state_ctrl_configured },
+	EM_SM_CTRL_REQUEST(em_state_ctrl_avail_spectrum_inquiry_pending),
+};
+
+static const em_sm_state_desc_t *em_sm_find_desc(em_state_t state)
+{
+	unsigned int index = EM_SM_STATE_INDEX(state);
+
+	if (state < em_state_ctrl_unconfigured) {
+		return (index < sizeof(em_sm_agent_table)/sizeof(em_sm_agent_table[0])) ? &em_sm_agent_table[index]:NULL;
+	}
+	if (state < em_state_max) {
+		return (index < sizeof(em_sm_ctrl_table)/sizeof(em_sm_ctrl_table[0])) ? &em_sm_ctrl_table[index]:NULL;
+	}
+
+	return NULL;
+}
+
+const em_sm_state_desc_t *em_sm_t::get_state_desc(em_service_type_t service, unsigned int index)
+{
+	if (service == em_service_type_agent) {
+		return (index < sizeof(em_sm_agent_table)/sizeof(em_sm_agent_table[0])) ? &em_sm_agent_table[index]:NULL;
+	}
+
+	return (index < sizeof(em_sm_ctrl_table)/sizeof(em_sm_ctrl_table[0])) ? &em_sm_ctrl_table[index]:NULL;
+}
+
+bool em_sm_t::is_legal_transition(em_state_t from, em_state_t to)
+{
+	const em_sm_state_desc_t *desc;
+
+	if ((desc = em_sm_find_desc(to)) == NULL) {
+		return false;
+	}
+	if ((from < em_state_ctrl_unconfigured) != (to < em_state_ctrl_unconfigured)) {
+		return false;
+	}
+	if (from == to) {
+		return true;
+	}
+
+	return (desc->from & EM_SM_BIT(from)) != 0;
+}
+
+const char *em_sm_t::get_recovery_str(em_sm_recovery_t recovery)
+{
+#define EM_SM_RECOVERY_2S(x) case x: return #x;
+	switch (recovery) {
+		EM_SM_RECOVERY_2S(em_sm_recovery_none)
+		EM_SM_RECOVERY_2S(em_sm_recovery_abandon)
+		EM_SM_RECOVERY_2S(em_sm_recovery_restart_autoconfig)
+	}
+
+	return "em_sm_recovery_unknown";
+}
+
+unsigned long long em_sm_t::now_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<unsigned long long> (ts.tv_sec) * 1000 + static_cast<unsigned long long> (ts.tv_nsec) / 1000000;
+}
 
 bool em_sm_t::validate_sm(em_state_t state)
 {
-	return true;
+	bool legal;
+
+	pthread_mutex_lock(&m_lock);
+	legal = is_legal_transition(m_state, state);
+	pthread_mutex_unlock(&m_lock);
+
+	return legal;
 }
 
 int em_sm_t::set_state(em_state_t state)
 {
-	if (validate_sm(state) == true) {
-		m_state = state;
+	int ret;
+
+	pthread_mutex_lock(&m_lock);
+	ret = enter(state);
+	pthread_mutex_unlock(&m_lock);
+
+	return ret;
+}
+
+int em_sm_t::enter(em_state_t state)
+{
+	unsigned long long now, dwell;
+	unsigned int from, bucket;
+
+	from = EM_SM_STATE_INDEX(m_state);
+
+	if (is_legal_transition(m_state, state) == false) {
+		m_stats.rejected++;
+		if ((m_logged[from] & EM_SM_BIT(state)) == 0) {
+			m_logged[from] |= EM_SM_BIT(state);
+			printf("%s:%d: illegal transition 0x%04x -> 0x%04x rejected\n", __func__, __LINE__, m_state, state);
+		}
+		return -1;
+	}
+
+	if (state == m_state) {
 		return 0;
 	}
 
-	return -1;
+	now = now_ms();
+	dwell = now - m_enter_ms;
+	for (bucket = 0; (bucket < (EM_SM_NUM_DWELL_BUCKETS - 1)) && (dwell >= 100); bucket++) {
+		dwell /= (bucket == 2) ? 6:10;
+	}
+	m_stats.states[from].dwell[bucket]++;
+
+	m_state = state;
+	m_enter_ms = now;
+	m_stats.transitions++;
+	m_stats.states[EM_SM_STATE_INDEX(state)].entered++;
+
+	return 0;
+}
+
+em_sm_recovery_t em_sm_t::check_deadline(unsigned long long now, em_state_t *next)
+{
+	em_sm_recovery_t recovery;
+
+	pthread_mutex_lock(&m_lock);
+	recovery = find_recovery(now, next);
+	pthread_mutex_unlock(&m_lock);
+
+	return recovery;
+}
+
+em_sm_recovery_t em_sm_t::recover(unsigned long long now, em_state_t *from, em_state_t *next)
+{
+	em_sm_recovery_t recovery;
+
+	pthread_mutex_lock(&m_lock);
+	*from = m_state;
+	if ((recovery = find_recovery(now, next)) != em_sm_recovery_none) {
+		enter(*next);
+	}
+	pthread_mutex_unlock(&m_lock);
+
+	return recovery;
+}
+
+em_sm_recovery_t em_sm_t::find_recovery(unsigned long long now, em_state_t *next)
+{
+	const em_sm_state_desc_t *desc;
+
+	desc = em_sm_find_desc(m_state);
+	if ((desc == NULL) || (desc->deadline == 0) || (desc->recovery == em_sm_recovery_none)) {
+		return em_sm_recovery_none;
+	}
+
+	if ((now < m_enter_ms) || ((now - m_enter_ms) < (static_cast<unsigned long long> (desc->deadline) * 1000))) {
+		return em_sm_recovery_none;
+	}
+
+	m_stats.timeouts++;
+	m_stats.states[EM_SM_STATE_INDEX(m_state)].timeouts++;
+	*next = desc->recover_to;
+
+	return desc->recovery;
+}
+
+em_sm_stats_t em_sm_t::get_stats()
+{
+	em_sm_stats_t stats;
+
+	pthread_mutex_lock(&m_lock);
+	stats = m_stats;
+	pthread_mutex_unlock(&m_lock);
+
+	return stats;
 }
 
 void em_sm_t::init_sm(em_service_type_t service)
 {
+	pthread_mutex_lock(&m_lock);
+	m_service = service;
 	m_state = (service == em_service_type_agent) ? em_state_agent_unconfigured:em_state_ctrl_unconfigured;	
+	m_enter_ms = now_ms();
+	memset(m_logged, 0, sizeof(m_logged));
+	memset(&m_stats, 0, sizeof(em_sm_stats_t));
+	m_stats.states[EM_SM_STATE_INDEX(m_state)].entered = 1;
+	pthread_mutex_unlock(&m_lock);
 }
 
-em_sm_t::em_sm_t()
+em_sm_t::em_sm_t() : m_state(em_state_ctrl_unconfigured), m_service(em_service_type_ctrl), m_enter_ms(0), m_logged(), m_stats()
 {
-
+	pthread_mutex_init(&m_lock, NULL);
 }
 
 em_sm_t::~em_sm_t()
 {
-
+	pthread_mutex_destroy(&m_lock);
 }
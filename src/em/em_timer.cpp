@@ -0,0 +1,314 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "em_timer.h"
+
+static inline long long em_timer_elapsed_ms(const struct timespec *base)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (static_cast<long long> (now.tv_sec - base->tv_sec) * 1000) + ((now.tv_nsec - base->tv_nsec) / 1000000);
+}
+
+unsigned long long em_timer_wheel_t::current_tick()
+{
+	return static_cast<unsigned long long> (em_timer_elapsed_ms(&m_base) / EM_TIMER_TICK_MS);
+}
+
+void em_timer_wheel_t::link(em_timer_t *timer)
+{
+	unsigned long long delta, range = EM_TIMER_SLOTS;
+	unsigned long long expires = timer->expires;
+	unsigned int level = 0;
+
+	if (expires <= m_now) {
+		expires = timer->expires = m_now + 1;
+	}
+	delta = expires - m_now;
+
+	while ((delta >= range) && (level < (EM_TIMER_LEVELS - 1))) {
+		range <<= EM_TIMER_SLOT_BITS;
+		level++;
+	}
+
+	// beyond the top level, park at its furthest slot and let the cascade re-link it
+	if (delta >= range) {
+		expires = m_now + range - 1;
+	}
+
+	timer->level = level;
+	timer->slot = static_cast<unsigned int> ((expires >> (level * EM_TIMER_SLOT_BITS)) & EM_TIMER_SLOT_MASK);
+	timer->prev = NULL;
+	timer->next = m_slot[level][timer->slot];
+	if (timer->next != NULL) {
+		timer->next->prev = timer;
+	}
+	m_slot[level][timer->slot] = timer;
+
+	if (level > 0) {
+		m_pending_upper++;
+	}
+}
+
+void em_timer_wheel_t::unlink(em_timer_t *timer)
+{
+	if (timer->prev != NULL) {
+		timer->prev->next = timer->next;
+	} else {
+		m_slot[timer->level][timer->slot] = timer->next;
+	}
+	if (timer->next != NULL) {
+		timer->next->prev = timer->prev;
+	}
+	timer->prev = timer->next = NULL;
+
+	if (timer->level > 0) {
+		m_pending_upper--;
+	}
+}
+
+void em_timer_wheel_t::cascade(unsigned int level)
+{
+	unsigned int index = static_cast<unsigned int> ((m_now >> (level * EM_TIMER_SLOT_BITS)) & EM_TIMER_SLOT_MASK);
+	em_timer_t *timer, *next;
+
+	timer = m_slot[level][index];
+	m_slot[level][index] = NULL;
+
+	while (timer != NULL) {
+		next = timer->next;
+		m_pending_upper--;
+		link(timer);
+		timer = next;
+	}
+}
+
+void em_timer_wheel_t::advance(unsigned long long to)
+{
+	em_timer_t *timer, *next;
+	unsigned int level, index;
+
+	while (m_now < to) {
+		m_now++;
+
+		// when a level wraps pull the next slot of the level above down
+		for (level = 1; level < EM_TIMER_LEVELS; level++) {
+			if (((m_now >> ((level - 1) * EM_TIMER_SLOT_BITS)) & EM_TIMER_SLOT_MASK) != 0) {
+				break;
+			}
+			cascade(level);
+		}
+
+		index = static_cast<unsigned int> (m_now & EM_TIMER_SLOT_MASK);
+		timer = m_slot[0][index];
+		m_slot[0][index] = NULL;
+
+		while (timer != NULL) {
+			next = timer->next;
+			timer->prev = timer->next = NULL;
+			timer->firing = true;
+			m_expired.push_back(timer);
+			timer = next;
+		}
+
+		// nothing armed, skip the idle ticks
+		if ((m_pending_upper == 0) && (m_timers.size() == m_expired.size())) {
+			m_now = to;
+		}
+	}
+}
+
+unsigned int em_timer_wheel_t::add(unsigned int ms, bool periodic, em_timer_cb_t cb)
+{
+	em_timer_t *timer;
+	unsigned long long ticks;
+
+	ticks = (ms + EM_TIMER_TICK_MS - 1) / EM_TIMER_TICK_MS;
+	if (ticks == 0) {
+		ticks = 1;
+	}
+
+	timer = new em_timer_t();
+	timer->cb = cb;
+	timer->period = (periodic == true) ? ticks:0;
+
+	pthread_mutex_lock(&m_lock);
+
+	do {
+		timer->id = ++m_next_id;
+	} while ((timer->id == EM_TIMER_INVALID_ID) || (m_timers.find(timer->id) != m_timers.end()));
+
+	// deadline from the current time, m_now only moves when run() is called
+	timer->expires = current_tick() + ticks;
+	link(timer);
+	m_timers[timer->id] = timer;
+
+	pthread_mutex_unlock(&m_lock);
+
+	return timer->id;
+}
+
+int em_timer_wheel_t::cancel(unsigned int id)
+{
+	em_timer_t *timer;
+
+	pthread_mutex_lock(&m_lock);
+
+	auto it = m_timers.find(id);
+	if (it == m_timers.end()) {
+		pthread_mutex_unlock(&m_lock);
+		return -1;
+	}
+
+	timer = it->second;
+	if (timer->firing == true) {
+		// run() owns it until the callback returns
+		timer->cancelled = true;
+		pthread_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	unlink(timer);
+	m_timers.erase(it);
+	pthread_mutex_unlock(&m_lock);
+
+	delete timer;
+
+	return 0;
+}
+
+unsigned int em_timer_wheel_t::run()
+{
+	em_timer_t *timer;
+	em_timer_cb_t cb;
+	unsigned long long missed;
+	unsigned int i, num = 0;
+
+	pthread_mutex_lock(&m_lock);
+	advance(current_tick());
+	pthread_mutex_unlock(&m_lock);
+
+	// only run() fills m_expired, so it can be walked without the lock
+	for (i = 0; i < m_expired.size(); i++) {
+		timer = m_expired[i];
+
+		pthread_mutex_lock(&m_lock);
+		if (timer->cancelled == false) {
+			cb = timer->cb;
+			pthread_mutex_unlock(&m_lock);
+
+			cb();
+			num++;
+
+			pthread_mutex_lock(&m_lock);
+		}
+
+		if ((timer->cancelled == true) || (timer->period == 0)) {
+			m_timers.erase(timer->id);
+			pthread_mutex_unlock(&m_lock);
+			delete timer;
+			continue;
+		}
+
+		timer->firing = false;
+		timer->expires += timer->period;
+		if (timer->expires <= m_now) {
+			missed = (m_now - timer->expires) / timer->period + 1;
+			timer->expires += missed * timer->period;
+		}
+		link(timer);
+		pthread_mutex_unlock(&m_lock);
+	}
+	m_expired.clear();
+
+	return num;
+}
+
+unsigned int em_timer_wheel_t::get_wait_ms(unsigned int max_ms)
+{
+	unsigned long long deadline = 0, tick;
+	long long wait;
+	unsigned int i;
+
+	pthread_mutex_lock(&m_lock);
+
+	if (m_timers.empty() == true) {
+		pthread_mutex_unlock(&m_lock);
+		return max_ms;
+	}
+
+	for (i = 1; i <= EM_TIMER_SLOTS; i++) {
+		tick = m_now + i;
+		if (m_slot[0][tick & EM_TIMER_SLOT_MASK] != NULL) {
+			deadline = tick;
+			break;
+		}
+	}
+
+	if (m_pending_upper > 0) {
+		tick = (m_now | EM_TIMER_SLOT_MASK) + 1;
+		if ((deadline == 0) || (tick < deadline)) {
+			deadline = tick;
+		}
+	}
+
+	pthread_mutex_unlock(&m_lock);
+
+	if (deadline == 0) {
+		return max_ms;
+	}
+
+	wait = static_cast<long long> (deadline * EM_TIMER_TICK_MS) - em_timer_elapsed_ms(&m_base);
+	if (wait <= 0) {
+		return 0;
+	}
+
+	return (wait < static_cast<long long> (max_ms)) ? static_cast<unsigned int> (wait):max_ms;
+}
+
+unsigned int em_timer_wheel_t::count()
+{
+	unsigned int num;
+
+	pthread_mutex_lock(&m_lock);
+	num = static_cast<unsigned int> (m_timers.size());
+	pthread_mutex_unlock(&m_lock);
+
+	return num;
+}
+
+em_timer_wheel_t::em_timer_wheel_t() : m_lock(), m_base(), m_now(0), m_next_id(0), m_pending_upper(0), m_slot(), m_timers(), m_expired()
+{
+	pthread_mutex_init(&m_lock, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &m_base);
+}
+
+em_timer_wheel_t::~em_timer_wheel_t()
+{
+	for (auto& it : m_timers) {
+		delete it.second;
+	}
+	m_timers.clear();
+
+	pthread_mutex_destroy(&m_lock);
+}
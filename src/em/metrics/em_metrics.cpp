@@ -52,6 +52,8 @@ int em_metrics_t::handle_assoc_sta_link_metrics_tlv(unsigned char *buff)
     dm_sta_t *sta;
     unsigned int i;
     dm_easy_mesh_t  *dm;
+    em_metrics_store_t *store = get_metrics_store();
+    em_steer_engine_t *steer = get_steer_engine();
 
     dm = get_data_model();
 
@@ -67,6 +69,15 @@ int em_metrics_t::handle_assoc_sta_link_metrics_tlv(unsigned char *buff)
         sta->m_sta_info.est_dl_rate = metrics->est_mac_data_rate_dl;
         sta->m_sta_info.est_ul_rate = metrics->est_mac_data_rate_ul;
         sta->m_sta_info.rcpi = metrics->rcpi;
+
+        if (store != NULL) {
+            store->record(sta_metrics->sta_mac, em_metrics_id_sta_rcpi, metrics->rcpi);
+            store->record(sta_metrics->sta_mac, em_metrics_id_sta_dl_rate, metrics->est_mac_data_rate_dl);
+            store->record(sta_metrics->sta_mac, em_metrics_id_sta_ul_rate, metrics->est_mac_data_rate_ul);
+        }
+        if (steer != NULL) {
+            steer->update_sta_link(sta_metrics->sta_mac, metrics->bssid, metrics->rcpi);
+        }
     }
 
     return 0;
@@ -222,7 +233,13 @@ int em_metrics_t::handle_associated_sta_link_metrics_resp(unsigned char *buff, u
         tmp_len -= (sizeof(em_tlv_t) + static_cast<size_t> (htons(tlv->len)));
         tlv = reinterpret_cast<em_tlv_t *> (reinterpret_cast<unsigned char *> (tlv) + sizeof(em_tlv_t) + htons(tlv->len));
     }
-    dm->set_db_cfg_param(db_cfg_type_sta_metrics_update, "");
+
+    // with a metrics store the history lives there and only its rollups reach the database
+    if (get_metrics_store() == NULL) {
+        dm->set_db_cfg_param(db_cfg_type_sta_metrics_update, "");
+    } else {
+        dm->set_unsaved_cfg_type(db_cfg_type_sta_metrics_update);
+    }
     set_state(em_state_ctrl_configured);
 
     return 0;
@@ -307,6 +324,10 @@ int em_metrics_t::handle_beacon_metrics_response(unsigned char *buff, unsigned i
     sta->m_sta_info.beacon_report_len = report_len;
     memcpy(sta->m_sta_info.beacon_report_elem, response->meas_reports, static_cast<size_t> (report_len));
 
+    if (get_steer_engine() != NULL) {
+        get_steer_engine()->update_beacon_report(response->sta_mac_addr, response->meas_reports, report_len);
+    }
+
     printf("%s:%d Beacon Metrics Response rcvd\n", __func__, __LINE__);
     printf("%s:%d No of reports %d\n", __func__, __LINE__, sta->m_sta_info.num_beacon_meas_report);
     printf("%s:%d Report len %d\n", __func__, __LINE__, sta->m_sta_info.beacon_report_len);
@@ -322,6 +343,7 @@ int em_metrics_t::handle_ap_metrics_tlv(unsigned char *buff, bssid_t get_bssid)
 {
     em_ap_metric_t *ap_metrics = reinterpret_cast<em_ap_metric_t *> (buff);
     em_bss_info_t *bss = get_data_model()->get_bss_info_with_mac(ap_metrics->bssid);
+    em_metrics_store_t *store = get_metrics_store();
     mac_addr_str_t bss_str;
 
     memcpy(get_bssid, ap_metrics->bssid, sizeof(mac_addr_t));
@@ -329,6 +351,13 @@ int em_metrics_t::handle_ap_metrics_tlv(unsigned char *buff, bssid_t get_bssid)
         bss->numberofsta = htons(ap_metrics->num_sta);
         dm_easy_mesh_t::macbytes_to_string(ap_metrics->bssid, bss_str);
         printf("%s:%d Num of stas associated to BSS[%s] is: %d\n", __func__, __LINE__, bss_str, bss->numberofsta);
+        if (store != NULL) {
+            store->record(ap_metrics->bssid, em_metrics_id_bss_num_sta, bss->numberofsta);
+            store->record(ap_metrics->bssid, em_metrics_id_bss_util, ap_metrics->channel_util);
+        }
+        if (get_steer_engine() != NULL) {
+            get_steer_engine()->update_bss_metrics(ap_metrics->bssid, ap_metrics->channel_util);
+        }
     } else {
         dm_easy_mesh_t::macbytes_to_string(ap_metrics->bssid, bss_str);
         printf("%s:%d BSS not found: %s\n", __func__, __LINE__, bss_str);
@@ -343,6 +372,8 @@ int em_metrics_t::handle_assoc_sta_traffic_stats(unsigned char *buff, bssid_t bs
     dm_sta_t *sta;
     dm_easy_mesh_t  *dm;
     mac_addr_str_t sta_str;
+    em_metrics_store_t *store = get_metrics_store();
+    long long tx_delta, rx_delta;
 
     dm = get_data_model();
     sta_metrics = reinterpret_cast<em_assoc_sta_traffic_stats_t *> (buff);
@@ -354,6 +385,19 @@ int em_metrics_t::handle_assoc_sta_traffic_stats(unsigned char *buff, bssid_t bs
         return -1;
     }
 
+    // the report carries counters, the series keep what was transferred since the previous one
+    // a counter that went backwards wrapped or was reset by a reassociation, what was transferred is unknown
+    if ((store != NULL) && ((sta->m_sta_info.bytes_tx != 0) || (sta->m_sta_info.bytes_rx != 0))) {
+        tx_delta = static_cast<long long> (sta_metrics->tx_bytes) - static_cast<long long> (sta->m_sta_info.bytes_tx);
+        rx_delta = static_cast<long long> (sta_metrics->rx_bytes) - static_cast<long long> (sta->m_sta_info.bytes_rx);
+        if (tx_delta >= 0) {
+            store->record(sta_metrics->sta_mac, em_metrics_id_sta_tx_bytes, tx_delta);
+        }
+        if (rx_delta >= 0) {
+            store->record(sta_metrics->sta_mac, em_metrics_id_sta_rx_bytes, rx_delta);
+        }
+    }
+
     sta->m_sta_info.bytes_tx        = sta_metrics->tx_bytes;
     sta->m_sta_info.bytes_rx        = sta_metrics->rx_bytes;
     sta->m_sta_info.pkts_tx         = sta_metrics->tx_pkts;
@@ -373,6 +417,8 @@ int em_metrics_t::handle_ap_metrics_response(unsigned char *buff, unsigned int l
     dm_easy_mesh_t  *dm;
     char *errors[EM_MAX_TLV_MEMBERS] = {0};
     bssid_t bssid;
+    em_radio_metric_t *radio_metric;
+    em_metrics_store_t *store = get_metrics_store();
 
     dm = get_data_model();
 
@@ -409,7 +455,11 @@ int em_metrics_t::handle_ap_metrics_response(unsigned char *buff, unsigned int l
     tmp_len = base_len;
 
     while ((tlv->type != em_tlv_type_eom) && (tmp_len > 0)) {
-        if (tlv->type == em_tlv_type_radio_metric) {
+        if ((tlv->type == em_tlv_type_radio_metric) && (store != NULL)) {
+            radio_metric = reinterpret_cast<em_radio_metric_t *> (tlv->value);
+            store->record(radio_metric->ruid, em_metrics_id_radio_noise, radio_metric->noise);
+            store->record(radio_metric->ruid, em_metrics_id_radio_util,
+                radio_metric->transmit + radio_metric->rece_self + radio_metric->rece_other);
         }
         tmp_len -= (sizeof(em_tlv_t) + static_cast<size_t> (htons(tlv->len)));
         tlv = reinterpret_cast<em_tlv_t *> (reinterpret_cast<unsigned char *> (tlv) + sizeof(em_tlv_t) + htons(tlv->len));
@@ -469,7 +519,11 @@ int em_metrics_t::handle_ap_metrics_response(unsigned char *buff, unsigned int l
         tlv = reinterpret_cast<em_tlv_t *> (reinterpret_cast<unsigned char *> (tlv) + sizeof(em_tlv_t) + htons(tlv->len));
     }
 
-    dm->set_db_cfg_param(db_cfg_type_sta_metrics_update, "");
+    if (get_metrics_store() == NULL) {
+        dm->set_db_cfg_param(db_cfg_type_sta_metrics_update, "");
+    } else {
+        dm->set_unsaved_cfg_type(db_cfg_type_sta_metrics_update);
+    }
     set_state(em_state_ctrl_configured);
 
     return 0;
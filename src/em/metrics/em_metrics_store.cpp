@@ -0,0 +1,503 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include "em_metrics_store.h"
+
+static const em_metrics_level_cfg_t em_metrics_default_levels[] = {
+	{1, 30, false},
+	{60, 60, false},
+	{900, 16, true},
+};
+
+static inline unsigned long long em_metrics_zigzag(long long val)
+{
+	return (static_cast<unsigned long long> (val) << 1) ^ static_cast<unsigned long long> (val >> 63);
+}
+
+static inline long long em_metrics_unzigzag(unsigned long long val)
+{
+	return static_cast<long long> (val >> 1) ^ -static_cast<long long> (val & 1);
+}
+
+long long em_metrics_store_t::now_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	return (static_cast<long long> (ts.tv_sec) * 1000) + (ts.tv_nsec / 1000000);
+}
+
+const char *em_metrics_store_t::get_metric_str(em_metrics_id_t id)
+{
+	switch (id) {
+		case em_metrics_id_sta_rcpi: return "RCPI";
+		case em_metrics_id_sta_dl_rate: return "EstDLRate";
+		case em_metrics_id_sta_ul_rate: return "EstULRate";
+		case em_metrics_id_sta_tx_bytes: return "TxBytes";
+		case em_metrics_id_sta_rx_bytes: return "RxBytes";
+		case em_metrics_id_bss_num_sta: return "NumSTA";
+		case em_metrics_id_bss_util: return "ChannelUtil";
+		case em_metrics_id_radio_noise: return "Noise";
+		case em_metrics_id_radio_util: return "Utilization";
+		default: break;
+	}
+
+	return "Unknown";
+}
+
+unsigned long long em_metrics_store_t::series_key(const unsigned char *mac, em_metrics_id_t id)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return (key << 8) | static_cast<unsigned long long> (id);
+}
+
+unsigned int em_metrics_store_t::encode_varint(unsigned char *buff, unsigned long long val)
+{
+	unsigned int len = 0;
+
+	while (val >= 0x80) {
+		buff[len++] = static_cast<unsigned char> (val | 0x80);
+		val >>= 7;
+	}
+	buff[len++] = static_cast<unsigned char> (val);
+
+	return len;
+}
+
+unsigned int em_metrics_store_t::decode_varint(const series_t *series, unsigned int pos, unsigned long long *val)
+{
+	unsigned int len = 0, shift = 0;
+	unsigned char byte;
+
+	*val = 0;
+	do {
+		byte = series->raw[(pos + len) % EM_METRICS_RAW_BYTES];
+		*val |= static_cast<unsigned long long> (byte & 0x7f) << shift;
+		shift += 7;
+		len++;
+	} while ((byte & 0x80) != 0);
+
+	return len;
+}
+
+void em_metrics_store_t::evict_oldest(series_t *series)
+{
+	unsigned long long dt, dv;
+	unsigned int len;
+
+	// the second oldest becomes the new base
+	len = decode_varint(series, series->raw_head, &dt);
+	len += decode_varint(series, series->raw_head + len, &dv);
+
+	series->base_ts += em_metrics_unzigzag(dt);
+	series->base_val += em_metrics_unzigzag(dv);
+	series->raw_head = (series->raw_head + len) % EM_METRICS_RAW_BYTES;
+	series->raw_len -= len;
+	series->num_samples--;
+
+	m_stats.num_samples--;
+	m_stats.raw_bytes -= len;
+}
+
+void em_metrics_store_t::append_raw(series_t *series, long long ts, long long val)
+{
+	unsigned char buff[20];
+	unsigned int len, i, tail;
+
+	if (series->num_samples == 0) {
+		series->base_ts = series->last_ts = ts;
+		series->base_val = series->last_val = val;
+		series->num_samples = 1;
+		m_stats.num_samples++;
+		return;
+	}
+
+	len = encode_varint(buff, em_metrics_zigzag(ts - series->last_ts));
+	len += encode_varint(buff + len, em_metrics_zigzag(val - series->last_val));
+
+	while ((series->raw_len + len) > EM_METRICS_RAW_BYTES) {
+		evict_oldest(series);
+	}
+
+	tail = (series->raw_head + series->raw_len) % EM_METRICS_RAW_BYTES;
+	for (i = 0; i < len; i++) {
+		series->raw[(tail + i) % EM_METRICS_RAW_BYTES] = buff[i];
+	}
+
+	series->raw_len += len;
+	series->num_samples++;
+	series->last_ts = ts;
+	series->last_val = val;
+
+	m_stats.num_samples++;
+	m_stats.raw_bytes += len;
+}
+
+long long em_metrics_store_t::percentile_95(const open_bucket_t *open)
+{
+	long long vals[EM_METRICS_RESERVOIR];
+	unsigned int num, idx;
+
+	num = (open->count < EM_METRICS_RESERVOIR) ? open->count:EM_METRICS_RESERVOIR;
+	if (num == 0) {
+		return 0;
+	}
+
+	memcpy(vals, open->reservoir, num * sizeof(long long));
+	// nearest rank
+	idx = (num * 95 + 99) / 100 - 1;
+	std::nth_element(vals, vals + idx, vals + num);
+
+	return vals[idx];
+}
+
+void em_metrics_store_t::to_bucket(const open_bucket_t *open, em_metrics_bucket_t *bucket)
+{
+	bucket->start = open->start;
+	bucket->count = open->count;
+	bucket->min = open->min;
+	bucket->max = open->max;
+	bucket->sum = open->sum;
+	bucket->p95 = percentile_95(open);
+}
+
+void em_metrics_store_t::close_bucket(series_t *series, unsigned int level)
+{
+	level_t *lvl = &series->levels[level];
+	em_metrics_bucket_t bucket;
+
+	if (lvl->open.count == 0) {
+		return;
+	}
+
+	to_bucket(&lvl->open, &bucket);
+
+	if (lvl->closed.size() < m_levels[level].num_buckets) {
+		lvl->closed.push_back(bucket);
+	} else {
+		lvl->closed[lvl->head] = bucket;
+	}
+	lvl->head = (lvl->head + 1) % m_levels[level].num_buckets;
+	if (lvl->num < m_levels[level].num_buckets) {
+		lvl->num++;
+	}
+
+	lvl->open.count = 0;
+
+	if ((m_levels[level].persist == true) && (m_persist != nullptr)) {
+		m_persist(series->mac, series->id, m_levels[level].resolution, &bucket);
+		m_stats.persisted++;
+	}
+}
+
+void em_metrics_store_t::add_to_bucket(series_t *series, unsigned int level, unsigned int sec, long long val)
+{
+	open_bucket_t *open = &series->levels[level].open;
+	unsigned int start = sec - (sec % m_levels[level].resolution);
+	unsigned int slot;
+
+	if ((open->count > 0) && (open->start != start)) {
+		close_bucket(series, level);
+	}
+
+	if (open->count == 0) {
+		open->start = start;
+		open->min = open->max = val;
+		open->sum = 0;
+	}
+
+	open->count++;
+	open->sum += val;
+	if (val < open->min) {
+		open->min = val;
+	}
+	if (val > open->max) {
+		open->max = val;
+	}
+
+	// reservoir sampling keeps a uniform subset once the bucket outgrows it
+	if (open->count <= EM_METRICS_RESERVOIR) {
+		open->reservoir[open->count - 1] = val;
+	} else {
+		slot = static_cast<unsigned int> (rand_r(&m_rand)) % open->count;
+		if (slot < EM_METRICS_RESERVOIR) {
+			open->reservoir[slot] = val;
+		}
+	}
+}
+
+int em_metrics_store_t::record(const unsigned char *mac, em_metrics_id_t id, long long val, long long ts_ms)
+{
+	unsigned long long key = series_key(mac, id);
+	series_t *series;
+	unsigned int i, sec;
+
+	if (ts_ms == 0) {
+		ts_ms = now_ms();
+	}
+
+	auto it = m_series.find(key);
+	if (it == m_series.end()) {
+		if (m_series.size() >= EM_METRICS_MAX_SERIES) {
+			m_stats.dropped++;
+			return -1;
+		}
+
+		series = new series_t();
+		memcpy(series->mac, mac, sizeof(mac_address_t));
+		series->id = id;
+		m_series[key] = series;
+		m_stats.num_series++;
+	} else {
+		series = it->second;
+	}
+
+	append_raw(series, ts_ms, val);
+
+	sec = static_cast<unsigned int> (ts_ms / 1000);
+	for (i = 0; i < m_num_levels; i++) {
+		add_to_bucket(series, i, sec, val);
+	}
+
+	m_stats.total_samples++;
+
+	return 0;
+}
+
+void em_metrics_store_t::flush(long long now_ms_val)
+{
+	series_t *series;
+	unsigned int i, sec;
+	open_bucket_t *open;
+
+	if (now_ms_val == 0) {
+		now_ms_val = now_ms();
+	}
+	sec = static_cast<unsigned int> (now_ms_val / 1000);
+
+	for (auto it = m_series.begin(); it != m_series.end(); ) {
+		series = it->second;
+
+		for (i = 0; i < m_num_levels; i++) {
+			open = &series->levels[i].open;
+			if ((open->count > 0) && (sec >= (open->start + m_levels[i].resolution))) {
+				close_bucket(series, i);
+			}
+		}
+
+		if ((now_ms_val - series->last_ts) > (EM_METRICS_SERIES_MAX_IDLE * 1000LL)) {
+			m_stats.num_samples -= series->num_samples;
+			m_stats.raw_bytes -= series->raw_len;
+			m_stats.num_series--;
+			delete series;
+			it = m_series.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void em_metrics_store_t::remove(const unsigned char *mac)
+{
+	series_t *series;
+	unsigned int i;
+
+	for (i = 0; i < em_metrics_id_max; i++) {
+		auto it = m_series.find(series_key(mac, static_cast<em_metrics_id_t> (i)));
+		if (it == m_series.end()) {
+			continue;
+		}
+
+		series = it->second;
+		m_stats.num_samples -= series->num_samples;
+		m_stats.raw_bytes -= series->raw_len;
+		m_stats.num_series--;
+		delete series;
+		m_series.erase(it);
+	}
+}
+
+int em_metrics_store_t::get_rollups(const unsigned char *mac, em_metrics_id_t id, unsigned int resolution, em_metrics_bucket_t *buckets, unsigned int max)
+{
+	level_t *lvl;
+	unsigned int i, level, num = 0, first, open;
+
+	auto it = m_series.find(series_key(mac, id));
+	if (it == m_series.end()) {
+		return -1;
+	}
+
+	for (level = 0; level < m_num_levels; level++) {
+		if (m_levels[level].resolution == resolution) {
+			break;
+		}
+	}
+	if (level == m_num_levels) {
+		return -1;
+	}
+
+	lvl = &it->second->levels[level];
+	first = (lvl->num < m_levels[level].num_buckets) ? 0:lvl->head;
+	open = (lvl->open.count > 0) ? 1:0;
+
+	// keep the newest when the caller has less room than we have buckets, the open one only takes a slot if it holds samples
+	i = (lvl->num + open > max) ? (lvl->num + open - max):0;
+	for (; (i < lvl->num) && (num < max); i++) {
+		buckets[num++] = lvl->closed[(first + i) % m_levels[level].num_buckets];
+	}
+
+	if ((open == 1) && (num < max)) {
+		to_bucket(&lvl->open, &buckets[num++]);
+	}
+
+	return static_cast<int> (num);
+}
+
+int em_metrics_store_t::get_samples(const unsigned char *mac, em_metrics_id_t id, long long *ts_ms, long long *vals, unsigned int max)
+{
+	series_t *series;
+	unsigned long long dt, dv;
+	unsigned int pos, num = 0;
+	long long ts, val;
+
+	auto it = m_series.find(series_key(mac, id));
+	if (it == m_series.end()) {
+		return -1;
+	}
+
+	series = it->second;
+	if ((series->num_samples == 0) || (max == 0)) {
+		return 0;
+	}
+
+	ts = series->base_ts;
+	val = series->base_val;
+	ts_ms[num] = ts;
+	vals[num] = val;
+	num++;
+
+	pos = series->raw_head;
+	while ((num < series->num_samples) && (num < max)) {
+		pos += decode_varint(series, pos, &dt);
+		pos += decode_varint(series, pos, &dv);
+		ts += em_metrics_unzigzag(dt);
+		val += em_metrics_unzigzag(dv);
+		ts_ms[num] = ts;
+		vals[num] = val;
+		num++;
+	}
+
+	return static_cast<int> (num);
+}
+
+void em_metrics_store_t::encode(cJSON *parent, const unsigned char *mac, unsigned int resolution)
+{
+	em_metrics_bucket_t buckets[128];
+	mac_addr_str_t mac_str;
+	cJSON *metrics_arr, *metric_obj, *arr, *obj;
+	int num, i;
+	unsigned int id;
+
+	if (mac == NULL) {
+		cJSON_AddNumberToObject(parent, "NumSeries", m_stats.num_series);
+		cJSON_AddNumberToObject(parent, "NumSamples", static_cast<double> (m_stats.num_samples));
+		cJSON_AddNumberToObject(parent, "RawBytes", static_cast<double> (m_stats.raw_bytes));
+		cJSON_AddNumberToObject(parent, "BytesPerSample", (m_stats.num_samples == 0) ? 0:
+			static_cast<double> (m_stats.raw_bytes) / static_cast<double> (m_stats.num_samples));
+		cJSON_AddNumberToObject(parent, "TotalSamples", static_cast<double> (m_stats.total_samples));
+		cJSON_AddNumberToObject(parent, "PersistedRollups", static_cast<double> (m_stats.persisted));
+		cJSON_AddNumberToObject(parent, "Dropped", static_cast<double> (m_stats.dropped));
+
+		arr = cJSON_CreateArray();
+		for (id = 0; id < m_num_levels; id++) {
+			cJSON_AddItemToArray(arr, cJSON_CreateNumber(m_levels[id].resolution));
+		}
+		cJSON_AddItemToObject(parent, "Resolutions", arr);
+		return;
+	}
+
+	snprintf(mac_str, sizeof(mac_addr_str_t), "%02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+	cJSON_AddStringToObject(parent, "ID", mac_str);
+	cJSON_AddNumberToObject(parent, "Resolution", resolution);
+	metrics_arr = cJSON_CreateArray();
+
+	for (id = 0; id < em_metrics_id_max; id++) {
+		num = get_rollups(mac, static_cast<em_metrics_id_t> (id), resolution, buckets, sizeof(buckets)/sizeof(em_metrics_bucket_t));
+		if (num <= 0) {
+			continue;
+		}
+
+		metric_obj = cJSON_CreateObject();
+		cJSON_AddStringToObject(metric_obj, "Metric", get_metric_str(static_cast<em_metrics_id_t> (id)));
+		arr = cJSON_CreateArray();
+		for (i = 0; i < num; i++) {
+			obj = cJSON_CreateObject();
+			cJSON_AddNumberToObject(obj, "Start", buckets[i].start);
+			cJSON_AddNumberToObject(obj, "Count", buckets[i].count);
+			cJSON_AddNumberToObject(obj, "Min", static_cast<double> (buckets[i].min));
+			cJSON_AddNumberToObject(obj, "Max", static_cast<double> (buckets[i].max));
+			cJSON_AddNumberToObject(obj, "Avg", static_cast<double> (buckets[i].sum) / buckets[i].count);
+			cJSON_AddNumberToObject(obj, "P95", static_cast<double> (buckets[i].p95));
+			cJSON_AddItemToArray(arr, obj);
+		}
+		cJSON_AddItemToObject(metric_obj, "Rollups", arr);
+		cJSON_AddItemToArray(metrics_arr, metric_obj);
+	}
+	cJSON_AddItemToObject(parent, "MetricsList", metrics_arr);
+}
+
+em_metrics_store_t::em_metrics_store_t(em_metrics_persist_func persist, const em_metrics_level_cfg_t *levels, unsigned int num_levels) :
+	m_series(), m_levels(), m_num_levels(0), m_persist(persist), m_rand(0), m_stats()
+{
+	unsigned int i;
+
+	if ((levels == NULL) || (num_levels == 0)) {
+		levels = em_metrics_default_levels;
+		num_levels = sizeof(em_metrics_default_levels)/sizeof(em_metrics_level_cfg_t);
+	}
+
+	for (i = 0; (i < num_levels) && (m_num_levels < EM_METRICS_MAX_LEVELS); i++) {
+		if ((levels[i].resolution == 0) || (levels[i].num_buckets == 0)) {
+			continue;
+		}
+		m_levels[m_num_levels++] = levels[i];
+	}
+
+	m_rand = static_cast<unsigned int> (now_ms());
+	memset(&m_stats, 0, sizeof(em_metrics_store_stats_t));
+}
+
+em_metrics_store_t::~em_metrics_store_t()
+{
+	for (auto& it : m_series) {
+		delete it.second;
+	}
+	m_series.clear();
+}
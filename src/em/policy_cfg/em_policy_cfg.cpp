@@ -262,8 +262,28 @@ int em_policy_cfg_t::send_policy_cfg_request_msg()
     unsigned char *tmp = buff;
     unsigned short type = htons(ETH_P_1905);
     dm_easy_mesh_t *dm;
+    em_policy_sync_t *sync;
+    unsigned long long hashes[EM_POLICY_CFG_NUM_TLVS];
+    unsigned char types[EM_POLICY_CFG_NUM_TLVS];
+    unsigned int i, num = 0;
+    const struct {
+        unsigned char type;
+        short (em_policy_cfg_t::*create)(unsigned char *buff);
+    } policy_tlvs[EM_POLICY_CFG_NUM_TLVS] = {
+        // Zero or one Steering Policy TLV (see section 17.2.11).
+        {em_tlv_type_steering_policy, &em_policy_cfg_t::create_steering_policy_tlv},
+        // Zero or one Metric Reporting Policy TLV (see section 17.2.12).
+        {em_tlv_type_metric_reporting_policy, &em_policy_cfg_t::create_metrics_rep_policy_tlv},
+        {em_tlv_vendor_plolicy_cfg, &em_policy_cfg_t::create_vendor_policy_cfg_tlv},
+    };
 
     dm = get_data_model();
+    sync = get_mgr()->get_policy_sync();
+
+    // an onboarding agent gets the complete policy
+    if ((sync != NULL) && (get_current_cmd()->get_type() == em_cmd_type_em_config)) {
+        sync->forget(dm->get_agent_al_interface_mac(), get_radio_interface_mac());
+    }
 
     memcpy(tmp, dm->get_agent_al_interface_mac(), sizeof(mac_address_t));
     tmp += sizeof(mac_address_t);
@@ -288,32 +308,28 @@ int em_policy_cfg_t::send_policy_cfg_request_msg()
     tmp += sizeof(em_cmdu_t);
     len += sizeof(em_cmdu_t);
 
-    // Zero or one Steering Policy TLV (see section 17.2.11).
-    tlv = reinterpret_cast<em_tlv_t *> (tmp);
-    tlv->type = em_tlv_type_steering_policy;
-	sz = create_steering_policy_tlv(tlv->value);
-	tlv->len = htons(static_cast<short unsigned int> (sz));
-
-	tmp += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
-    len += (sizeof(em_tlv_t) + static_cast<size_t> (sz));    
-
-	// Zero or one Metric Reporting Policy TLV (see section 17.2.12).
-    tlv = reinterpret_cast<em_tlv_t *> (tmp);
-    tlv->type = em_tlv_type_metric_reporting_policy;
-    sz = create_metrics_rep_policy_tlv(tlv->value);
-    tlv->len = htons(static_cast<short unsigned int> (sz));
-
-    tmp += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
-    len += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
+    for (i = 0; i < EM_POLICY_CFG_NUM_TLVS; i++) {
+        tlv = reinterpret_cast<em_tlv_t *> (tmp);
+        tlv->type = policy_tlvs[i].type;
+        sz = (this->*policy_tlvs[i].create)(tlv->value);
+        tlv->len = htons(static_cast<short unsigned int> (sz));
+
+        // only what the agent has not acknowledged yet
+        if (sync != NULL) {
+            hashes[num] = em_policy_sync_t::hash(tlv->value, static_cast<unsigned int> (sz));
+            if ((sz <= 0) || (sync->is_stale(dm->get_agent_al_interface_mac(), get_radio_interface_mac(), tlv->type, hashes[num]) == false)) {
+                continue;
+            }
+            types[num++] = tlv->type;
+        }
 
-    //em_tlv_vendor_plolicy_cfg
-    tlv = reinterpret_cast<em_tlv_t *> (tmp);
-    tlv->type = em_tlv_vendor_plolicy_cfg;
-    sz = create_vendor_policy_cfg_tlv(tlv->value);
-    tlv->len = htons(static_cast<short unsigned int> (sz));
+        tmp += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
+        len += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
+    }
 
-    tmp += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
-    len += (sizeof(em_tlv_t) + static_cast<size_t> (sz));
+    if ((sync != NULL) && (num == 0)) {
+        return 0;
+    }
 
     // End of message
     tlv = reinterpret_cast<em_tlv_t *> (tmp);
@@ -327,15 +343,115 @@ int em_policy_cfg_t::send_policy_cfg_request_msg()
         return -1;
     }
 
+    // the agent echoes the message id in its 1905 Ack
+    if (sync != NULL) {
+        msg_id = sync->next_mid(dm->get_agent_al_interface_mac());
+        cmdu->id = htons(msg_id);
+    }
+
     if (send_frame(buff, static_cast<unsigned int> (len))  < 0) {
         printf("%s:%d: Policy Cfg Request msg send failed, error:%d\n", __func__, __LINE__, errno);
         return -1;
     }
 
-	printf("%s:%d: Policy Cfg Request Msg Send Success\n", __func__, __LINE__);
+    for (i = 0; i < num; i++) {
+        sync->set_sent(dm->get_agent_al_interface_mac(), get_radio_interface_mac(), types[i], hashes[i], msg_id);
+    }
+
+	printf("%s:%d: Policy Cfg Request Msg Send Success, id: %d TLVs: %d\n", __func__, __LINE__, msg_id,
+		(sync != NULL) ? num:EM_POLICY_CFG_NUM_TLVS);
+
+    return static_cast<int> (len);
+
+}
+
+int em_policy_cfg_t::send_policy_cfg_ack_msg(unsigned short msg_id)
+{
+    unsigned char buff[MAX_EM_BUFF_SZ];
+    char *errors[EM_MAX_TLV_MEMBERS] = {0};
+    unsigned int len = 0;
+    em_cmdu_t *cmdu;
+    em_tlv_t *tlv;
+    unsigned char *tmp = buff;
+    unsigned short type = htons(ETH_P_1905);
+    dm_easy_mesh_t *dm = get_data_model();
+
+    memcpy(tmp, dm->get_ctrl_al_interface_mac(), sizeof(mac_address_t));
+    tmp += sizeof(mac_address_t);
+    len += static_cast<unsigned int> (sizeof(mac_address_t));
+
+    memcpy(tmp, dm->get_agent_al_interface_mac(), sizeof(mac_address_t));
+    tmp += sizeof(mac_address_t);
+    len += static_cast<unsigned int> (sizeof(mac_address_t));
+
+    memcpy(tmp, reinterpret_cast<unsigned char *> (&type), sizeof(unsigned short));
+    tmp += sizeof(unsigned short);
+    len += static_cast<unsigned int> (sizeof(unsigned short));
+
+    cmdu = reinterpret_cast<em_cmdu_t *> (tmp);
+
+    memset(tmp, 0, sizeof(em_cmdu_t));
+    cmdu->type = htons(em_msg_type_1905_ack);
+    cmdu->id = htons(msg_id);
+    cmdu->last_frag_ind = 1;
+
+    tmp += sizeof(em_cmdu_t);
+    len += static_cast<unsigned int> (sizeof(em_cmdu_t));
+
+    // End of message
+    tlv = reinterpret_cast<em_tlv_t *> (tmp);
+    tlv->type = em_tlv_type_eom;
+    tlv->len = 0;
+
+    tmp += (sizeof (em_tlv_t));
+    len += static_cast<unsigned int> (sizeof (em_tlv_t));
+
+    if (em_msg_t(em_msg_type_1905_ack, em_profile_type_3, buff, len).validate(errors) == 0) {
+        printf("%s:%d: Policy Cfg 1905 ACK validation failed\n", __func__, __LINE__);
+        return -1;
+    }
+
+    if (send_frame(buff, len)  < 0) {
+        printf("%s:%d: Policy Cfg 1905 ACK send failed, error:%d\n", __func__, __LINE__, errno);
+        return -1;
+    }
 
     return static_cast<int> (len);
+}
 
+int em_policy_cfg_t::handle_policy_cfg_ack(unsigned char *buff, unsigned int len)
+{
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *> (buff);
+    em_cmdu_t *cmdu = reinterpret_cast<em_cmdu_t *> (buff + sizeof(em_raw_hdr_t));
+    em_policy_sync_t *sync;
+
+    if ((get_service_type() != em_service_type_ctrl) || ((sync = get_mgr()->get_policy_sync()) == NULL) ||
+            (len < (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t)))) {
+        return 0;
+    }
+
+    return (sync->ack(hdr->src, htons(cmdu->id)) == true) ? 1:0;
+}
+
+template <typename radio_t>
+static void merge_policy_radios(radio_t *radios, unsigned char *num, const radio_t *update, unsigned char num_update)
+{
+    unsigned int i, j;
+
+    for (i = 0; (i < num_update) && (i < EM_MAX_RADIO_PER_AGENT); i++) {
+        for (j = 0; j < *num; j++) {
+            if (memcmp(radios[j].ruid, update[i].ruid, sizeof(mac_address_t)) == 0) {
+                break;
+            }
+        }
+        if (j == *num) {
+            if (*num >= EM_MAX_RADIO_PER_AGENT) {
+                continue;
+            }
+            (*num)++;
+        }
+        memcpy(&radios[j], &update[i], sizeof(radio_t));
+    }
 }
 
 int em_policy_cfg_t::handle_policy_cfg_req(unsigned char *buff, unsigned int len)
@@ -346,8 +462,10 @@ int em_policy_cfg_t::handle_policy_cfg_req(unsigned char *buff, unsigned int len
     size_t data_len = 0;
     unsigned int i = 0;
     mac_addr_str_t mac_str;
+    em_cmdu_t *cmdu = reinterpret_cast<em_cmdu_t *> (buff + sizeof(em_raw_hdr_t));
+    bool found_steering = false, found_metrics = false, found_vendor = false;
 
-    memset(&policy, 0, sizeof(em_policy_cfg_t));
+    memset(&policy, 0, sizeof(em_policy_cfg_params_t));
 
     tlv = reinterpret_cast<em_tlv_t *> (buff + sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
     tlv_len = len - static_cast<unsigned int> (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
@@ -377,6 +495,7 @@ int em_policy_cfg_t::handle_policy_cfg_req(unsigned char *buff, unsigned int len
                 radio_steer_pol = reinterpret_cast<em_steering_policy_radio_t *> (tlv->value + data_len);
             }
             data_len += policy.steering_policy.radio_num * sizeof(em_steering_policy_radio_t);
+            found_steering = true;
         } else if (tlv->type == em_tlv_type_metric_reporting_policy) {
             em_metric_rprt_policy_t *metrics = reinterpret_cast<em_metric_rprt_policy_t *> (tlv->value);
             policy.metrics_policy.interval = metrics->interval;
@@ -391,6 +510,7 @@ int em_policy_cfg_t::handle_policy_cfg_req(unsigned char *buff, unsigned int len
                 printf("%s:%d Recvd policy for radio %s\n", __func__, __LINE__, mac_str);
             }
             data_len += (metrics->radios_num * sizeof(em_metric_rprt_policy_radio_t));
+            found_metrics = true;
         } else if (tlv->type == em_tlv_type_dflt_8021q_settings) {
         } else if (tlv->type == em_tlv_type_traffic_separation_policy) {
         } else if (tlv->type == em_tlv_type_channel_scan_rprt_policy) {
@@ -401,13 +521,31 @@ int em_policy_cfg_t::handle_policy_cfg_req(unsigned char *buff, unsigned int len
             em_vendor_policy_t *vendor = reinterpret_cast<em_vendor_policy_t *> (tlv->value);
             snprintf(policy.vendor_policy.managed_client_marker, sizeof(em_string_t), "%s", vendor->managed_client_marker);
             data_len += sizeof(em_vendor_policy_t);
+            found_vendor = true;
         }
 
         tlv_len -= static_cast<unsigned int> (sizeof(em_tlv_t) + static_cast<size_t> (htons(tlv->len)));
         tlv = reinterpret_cast<em_tlv_t *> (reinterpret_cast<unsigned char *> (tlv) + sizeof(em_tlv_t) + htons(tlv->len));
     }
 
-    get_mgr()->io_process(em_bus_event_type_set_policy, reinterpret_cast<unsigned char *> (&policy), sizeof(policy));
+    // the request carries only what changed, per radio, the rest stays as last received
+    if (found_steering == true) {
+        memcpy(&m_policy_cfg.steering_policy.local_steer_policy, &policy.steering_policy.local_steer_policy, sizeof(em_steering_policy_sta_t));
+        memcpy(&m_policy_cfg.steering_policy.btm_steer_policy, &policy.steering_policy.btm_steer_policy, sizeof(em_steering_policy_sta_t));
+        merge_policy_radios(m_policy_cfg.steering_policy.radio_steer_policy, &m_policy_cfg.steering_policy.radio_num,
+            policy.steering_policy.radio_steer_policy, policy.steering_policy.radio_num);
+    }
+    if (found_metrics == true) {
+        m_policy_cfg.metrics_policy.interval = policy.metrics_policy.interval;
+        merge_policy_radios(m_policy_cfg.metrics_policy.radios, &m_policy_cfg.metrics_policy.radios_num,
+            policy.metrics_policy.radios, policy.metrics_policy.radios_num);
+    }
+    if (found_vendor == true) {
+        memcpy(&m_policy_cfg.vendor_policy, &policy.vendor_policy, sizeof(em_vendor_policy_t));
+    }
+
+    get_mgr()->io_process(em_bus_event_type_set_policy, reinterpret_cast<unsigned char *> (&m_policy_cfg), sizeof(m_policy_cfg));
+    send_policy_cfg_ack_msg(htons(cmdu->id));
     //send_associated_link_metrics_response(sta);
     //set_state(em_state_agent_configured);
 
@@ -452,7 +590,7 @@ void em_policy_cfg_t::process_ctrl_state()
 
 em_policy_cfg_t::em_policy_cfg_t()
 {
-
+    memset(&m_policy_cfg, 0, sizeof(em_policy_cfg_params_t));
 }
 
 em_policy_cfg_t::~em_policy_cfg_t()
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <iterator>
+#include "em_policy_sync.h"
+
+unsigned long long em_policy_sync_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+unsigned long long em_policy_sync_t::slot_key(const unsigned char *ruid, unsigned int type)
+{
+	return (mac_key(ruid) << 16) | (type & 0xffff);
+}
+
+time_t em_policy_sync_t::now_s()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec;
+}
+
+unsigned long long em_policy_sync_t::hash(const unsigned char *value, unsigned int len)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	unsigned int i;
+
+	for (i = 0; i < len; i++) {
+		h = (h ^ value[i]) * 1099511628211ULL;
+	}
+
+	return h;
+}
+
+bool em_policy_sync_t::is_stale(const unsigned char *agent, const unsigned char *ruid, unsigned int type, unsigned long long hash)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	agent_t& a = m_agents[mac_key(agent)];
+	auto it = a.slots.find(slot_key(ruid, type));
+
+	if (it != a.slots.end()) {
+		slot_t& slot = it->second;
+
+		if (((slot.acked == true) && (slot.acked_hash == hash) && (slot.in_flight == false)) ||
+				((slot.in_flight == true) && (slot.sent_hash == hash) && ((now_s() - slot.sent_time) <= EM_POLICY_SYNC_ACK_TIMEOUT_S))) {
+			m_stats.suppressed++;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+unsigned short em_policy_sync_t::next_mid(const unsigned char *agent)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	agent_t& a = m_agents[mac_key(agent)];
+	time_t now = now_s();
+	unsigned short mid = EM_POLICY_SYNC_MID_BASE;
+	unsigned int i;
+
+	// past its last retry nothing waits for the Ack of a request
+	for (auto r = a.requests.begin(); r != a.requests.end(); ) {
+		r = ((now - r->second.sent_time) > (EM_POLICY_SYNC_ACK_TIMEOUT_S * (EM_POLICY_SYNC_MAX_RETRIES + 1))) ? a.requests.erase(r):std::next(r);
+	}
+
+	for (i = 0; i < EM_POLICY_SYNC_MID_SPAN; i++) {
+		mid = static_cast<unsigned short> (EM_POLICY_SYNC_MID_BASE + (a.next_mid++ % EM_POLICY_SYNC_MID_SPAN));
+		if (a.requests.find(mid) == a.requests.end()) {
+			break;
+		}
+	}
+
+	a.requests[mid] = request_t();
+	a.requests[mid].sent_time = now;
+	m_stats.requests++;
+
+	return mid;
+}
+
+void em_policy_sync_t::set_sent(const unsigned char *agent, const unsigned char *ruid, unsigned int type, unsigned long long hash,
+	unsigned short mid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	agent_t& a = m_agents[mac_key(agent)];
+	slot_t& slot = a.slots[slot_key(ruid, type)];
+	request_t& req = a.requests[mid];
+
+	if ((slot.in_flight == true) && (slot.sent_hash == hash)) {
+		slot.retries++;
+		m_stats.retries++;
+	} else {
+		slot.retries = 0;
+	}
+
+	slot.sent_hash = hash;
+	slot.sent_time = now_s();
+	slot.in_flight = true;
+	m_stats.sent++;
+
+	if (req.sent_time == 0) {
+		req.sent_time = slot.sent_time;
+	}
+	req.tlvs.push_back(std::make_pair(slot_key(ruid, type), hash));
+}
+
+bool em_policy_sync_t::ack(const unsigned char *agent, unsigned short mid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_agents.find(mac_key(agent));
+	std::unordered_map<unsigned short, request_t>::iterator req;
+
+	if ((it == m_agents.end()) || ((req = it->second.requests.find(mid)) == it->second.requests.end())) {
+		return false;
+	}
+
+	// the Ack of an earlier try acknowledges a retry of the same value as well
+	for (auto& tlv : req->second.tlvs) {
+		auto s = it->second.slots.find(tlv.first);
+
+		if ((s != it->second.slots.end()) && (s->second.in_flight == true) && (s->second.sent_hash == tlv.second)) {
+			s->second.acked_hash = tlv.second;
+			s->second.acked = true;
+			s->second.in_flight = false;
+			s->second.retries = 0;
+			m_stats.acked++;
+		}
+	}
+	it->second.requests.erase(req);
+
+	return true;
+}
+
+void em_policy_sync_t::forget(const unsigned char *agent, const unsigned char *ruid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_agents.find(mac_key(agent));
+	unsigned long long radio = mac_key(ruid);
+
+	if (it == m_agents.end()) {
+		return;
+	}
+
+	for (auto s = it->second.slots.begin(); s != it->second.slots.end(); ) {
+		s = ((s->first >> 16) == radio) ? it->second.slots.erase(s):std::next(s);
+	}
+
+	// a late Ack of what was sent before does not count for the radio anymore
+	for (auto& r : it->second.requests) {
+		for (auto t = r.second.tlvs.begin(); t != r.second.tlvs.end(); ) {
+			t = ((t->first >> 16) == radio) ? r.second.tlvs.erase(t):std::next(t);
+		}
+	}
+}
+
+bool em_policy_sync_t::is_overdue(const unsigned char *agent, const unsigned char *ruid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto it = m_agents.find(mac_key(agent));
+	unsigned long long radio = mac_key(ruid);
+	time_t now = now_s();
+	bool overdue = false;
+
+	if (it == m_agents.end()) {
+		return false;
+	}
+
+	for (auto& s : it->second.slots) {
+		slot_t& slot = s.second;
+
+		if (((s.first >> 16) != radio) || (slot.in_flight == false) || ((now - slot.sent_time) <= EM_POLICY_SYNC_ACK_TIMEOUT_S)) {
+			continue;
+		}
+		if (slot.retries >= EM_POLICY_SYNC_MAX_RETRIES) {
+			// the next push sends it again
+			slot.in_flight = false;
+			slot.acked = false;
+			m_stats.dropped++;
+			continue;
+		}
+		overdue = true;
+	}
+
+	return overdue;
+}
+
+const em_policy_sync_stats_t *em_policy_sync_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned int in_flight = 0;
+
+	for (auto& a : m_agents) {
+		for (auto& s : a.second.slots) {
+			in_flight += (s.second.in_flight == true) ? 1:0;
+		}
+	}
+	m_stats.num_agents = static_cast<unsigned int> (m_agents.size());
+	m_stats.in_flight = in_flight;
+
+	return &m_stats;
+}
+
+em_policy_sync_t::em_policy_sync_t() : m_lock(), m_agents(), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_policy_sync_stats_t));
+}
+
+em_policy_sync_t::~em_policy_sync_t()
+{
+
+}
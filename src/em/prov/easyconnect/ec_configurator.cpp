@@ -24,8 +24,5 @@ ec_configurator_t::ec_configurator_t(
 
 ec_configurator_t::~ec_configurator_t()
 {
-
-    for (auto& [_, c_ctx] : m_connections) {
-        ec_crypto::free_connection_ctx(&c_ctx);
-    }
+    // m_connections releases the remaining connection contexts when destroyed
 }
@@ -5,6 +5,7 @@
 
 #include "cjson/cJSON.h"
 #include <numeric>
+#include <mutex>
 
 #if OPENSSL_VERSION_NUMBER >= 0x30000000L
 #include <openssl/kdf.h>
@@ -508,8 +509,81 @@ uint8_t* ec_crypto::compute_hash(ec_connection_context_t& c_ctx, const easyconne
     return hash;
 }
 
+namespace {
+
+// Named curve groups shared by every connection context, see ec_crypto::get_shared_group()
+std::mutex s_shared_groups_lock;
+std::unordered_map<int, EC_GROUP *> s_shared_groups;
+
+}
+
+const EC_GROUP *ec_crypto::get_shared_group(int nid)
+{
+    if (nid == NID_undef) {
+        return NULL;
+    }
+
+    std::lock_guard<std::mutex> lock(s_shared_groups_lock);
+    auto it = s_shared_groups.find(nid);
+    if (it != s_shared_groups.end()) {
+        return it->second;
+    }
+
+    EC_GROUP *group = EC_GROUP_new_by_curve_name(nid);
+    if (group == NULL) {
+        em_printfout("Unable to create EC group for nid:%d", nid);
+        return NULL;
+    }
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    // Generator multiples used by every key generation and signature on this curve. OpenSSL 3 deprecates
+    // this and ships precomputed tables for the curves that benefit (P-256).
+    if (EC_GROUP_precompute_mult(group, NULL) == 0) {
+        em_printfout("Unable to precompute generator multiples for nid:%d", nid);
+    }
+#endif
+    s_shared_groups[nid] = group;
+    return group;
+}
+
+bool ec_crypto::is_shared_group(const EC_GROUP *group)
+{
+    if (group == NULL) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_shared_groups_lock);
+    auto it = s_shared_groups.find(EC_GROUP_get_curve_name(group));
+    return it != s_shared_groups.end() && it->second == group;
+}
+
+int ec_crypto::get_key_nid(const SSL_KEY *key)
+{
+    if (key == NULL) {
+        return NID_undef;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    char group_name[64];
+    size_t group_name_len = 0;
+    if (EVP_PKEY_get_group_name(key, group_name, sizeof(group_name), &group_name_len) <= 0) {
+        return NID_undef;
+    }
+    return OBJ_txt2nid(group_name);
+#else
+    const EC_GROUP *group = EC_KEY_get0_group(key);
+    return (group == NULL) ? NID_undef : EC_GROUP_get_curve_name(group);
+#endif
+}
+
 bool ec_crypto::init_connection_ctx(ec_connection_context_t& c_ctx, const SSL_KEY *boot_key){
-    c_ctx.group = em_crypto_t::get_key_group(boot_key); 
+    c_ctx.group = get_shared_group(get_key_nid(boot_key));
+    if (c_ctx.group == NULL) {
+        // Not a named curve, the context gets a group of its own
+        c_ctx.group = em_crypto_t::get_key_group(boot_key);
+    }
+    if (c_ctx.group == NULL) {
+        em_printfout("Unable to get EC group of the bootstrapping key");
+        return false;
+    }
 
     c_ctx.prime = BN_new();
     c_ctx.bn_ctx = BN_CTX_new();
@@ -807,20 +881,32 @@ std::optional<std::string> ec_crypto::generate_connector(const cJSON * jws_heade
     }
 
     char* jws_header_cstr = cJSON_PrintUnformatted(jws_header);
-    char* jws_payload_cstr = cJSON_PrintUnformatted(jws_payload);
-    if (jws_header_cstr == NULL || jws_payload_cstr == NULL) {
+    if (jws_header_cstr == NULL) {
         em_printfout("Failed to convert cJSON to string");
-        if (jws_header_cstr) free(jws_header_cstr);
-        if (jws_payload_cstr) free(jws_payload_cstr);
         return std::nullopt;
     }
     std::string jws_header_str(jws_header_cstr);
-    std::string jws_payload_str(jws_payload_cstr);
     free(jws_header_cstr);
-    free(jws_payload_cstr);
 
     // NOTE: Currently assuming it's always UTF-8 already.
-    std::string base64_jws_header = em_crypto_t::base64url_encode(jws_header_str);
+    return generate_connector(em_crypto_t::base64url_encode(jws_header_str), jws_payload, sign_key);
+}
+
+std::optional<std::string> ec_crypto::generate_connector(const std::string& base64_jws_header, const cJSON * jws_payload, SSL_KEY* sign_key)
+{
+    if (base64_jws_header.empty() || jws_payload == NULL || sign_key == NULL) {
+        em_printfout("Invalid input");
+        return std::nullopt;
+    }
+
+    char* jws_payload_cstr = cJSON_PrintUnformatted(jws_payload);
+    if (jws_payload_cstr == NULL) {
+        em_printfout("Failed to convert cJSON to string");
+        return std::nullopt;
+    }
+    std::string jws_payload_str(jws_payload_cstr);
+    free(jws_payload_cstr);
+
     std::string base64_jws_payload = em_crypto_t::base64url_encode(jws_payload_str);
 
     std::string sig_data = base64_jws_header + "." + base64_jws_payload;
@@ -867,6 +953,16 @@ cJSON* ec_crypto::create_jws_header(const std::string& type, const SSL_KEY *c_si
     return jwsHeaderObj;
 }
 
+cJSON* ec_crypto::create_jws_header(const std::string& type, const ec_key_artifacts_t& c_sign_key)
+{
+    if (c_sign_key.kid.empty()) return nullptr;
+    cJSON *jwsHeaderObj = cJSON_CreateObject();
+    cJSON_AddStringToObject(jwsHeaderObj, "typ", type.c_str());
+    cJSON_AddStringToObject(jwsHeaderObj, "kid", c_sign_key.kid.c_str());
+    cJSON_AddStringToObject(jwsHeaderObj, "alg", "ES256");
+    return jwsHeaderObj;
+}
+
 cJSON* ec_crypto::create_jws_payload(ec_connection_context_t& c_ctx, const std::vector<std::unordered_map<std::string, std::string>>& groups, SSL_KEY* net_access_key, std::optional<std::string> expiry, std::optional<uint8_t> version)
 {
     if (net_access_key == nullptr) return nullptr;
@@ -950,4 +1046,78 @@ cJSON *ec_crypto::create_ppkey_object(ec_connection_context_t& c_ctx)
     BN_free(x);
     BN_free(y);
     return ppKeyObj;
-}
\ No newline at end of file
+}
+
+cJSON *ec_crypto::create_ppkey_object(const ec_key_artifacts_t& pp_key)
+{
+    if (pp_key.x.empty() || pp_key.y.empty()) return nullptr;
+    cJSON *ppKeyObj = cJSON_CreateObject();
+    cJSON_AddStringToObject(ppKeyObj, "kty", "EC");
+    cJSON_AddStringToObject(ppKeyObj, "crv", "P-256");
+    cJSON_AddStringToObject(ppKeyObj, "x", pp_key.x.c_str());
+    cJSON_AddStringToObject(ppKeyObj, "y", pp_key.y.c_str());
+    return ppKeyObj;
+}
+
+cJSON *ec_crypto::create_csign_object(const ec_key_artifacts_t& c_sign_key)
+{
+    if (c_sign_key.kid.empty() || c_sign_key.x.empty() || c_sign_key.y.empty()) return nullptr;
+    cJSON *cSignObj = cJSON_CreateObject();
+    cJSON_AddStringToObject(cSignObj, "kty", "EC");
+    cJSON_AddStringToObject(cSignObj, "crv", "P-256");
+    cJSON_AddStringToObject(cSignObj, "kid", c_sign_key.kid.c_str());
+    cJSON_AddStringToObject(cSignObj, "x", c_sign_key.x.c_str());
+    cJSON_AddStringToObject(cSignObj, "y", c_sign_key.y.c_str());
+    return cSignObj;
+}
+
+bool ec_crypto::init_key_artifacts(ec_connection_context_t& c_ctx, const SSL_KEY *key, const EC_POINT *point, ec_key_artifacts_t& art)
+{
+    art = {};
+
+    scoped_ec_point key_point(nullptr);
+    if (point == NULL) {
+        if (key == NULL) return false;
+        key_point.reset(em_crypto_t::get_pub_key_point(key, const_cast<EC_GROUP*>(c_ctx.group)));
+        point = key_point.get();
+    }
+    if (point == NULL) {
+        em_printfout("Unable to get public key point");
+        return false;
+    }
+
+    auto [x, y] = get_ec_x_y(c_ctx, point);
+    if (x == NULL || y == NULL) {
+        BN_free(x);
+        BN_free(y);
+        return false;
+    }
+    art.x = em_crypto_t::base64_encode(ec_crypto::BN_to_vec(x));
+    art.y = em_crypto_t::base64_encode(ec_crypto::BN_to_vec(y));
+    BN_free(x);
+    BN_free(y);
+
+    if (key == NULL) {
+        return true;
+    }
+
+    uint8_t *key_hash = compute_key_hash(key);
+    if (key_hash == NULL) {
+        em_printfout("Unable to compute key hash");
+        return false;
+    }
+    memcpy(art.key_hash, key_hash, SHA256_DIGEST_LENGTH);
+    free(key_hash);
+    art.kid = em_crypto_t::base64_encode(art.key_hash, SHA256_DIGEST_LENGTH);
+
+    cJSON *jws_header = create_jws_header("dppCon", art);
+    char *jws_header_cstr = (jws_header == NULL) ? NULL : cJSON_PrintUnformatted(jws_header);
+    cJSON_Delete(jws_header);
+    if (jws_header_cstr == NULL) {
+        em_printfout("Failed to encode JWS Protected Header");
+        return false;
+    }
+    art.jws_header = em_crypto_t::base64url_encode(std::string(jws_header_cstr));
+    free(jws_header_cstr);
+    return true;
+}
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ec_crypto_pool.h"
+
+ec_crypto_pool_t::ec_crypto_pool_t(unsigned int num_workers, ec_crypto_post_func post) :
+    m_state(std::make_shared<state_t>()), m_post(post)
+{
+    if (num_workers == 0) {
+        num_workers = std::thread::hardware_concurrency();
+        if (num_workers > EC_CRYPTO_POOL_MAX_WORKERS) {
+            num_workers = EC_CRYPTO_POOL_MAX_WORKERS;
+        }
+    }
+    if (num_workers == 0) {
+        num_workers = 1;
+    }
+
+    for (unsigned int i = 0; i < num_workers; i++) {
+        m_workers.emplace_back(&ec_crypto_pool_t::worker, this);
+    }
+}
+
+ec_crypto_pool_t::~ec_crypto_pool_t()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+        m_state->exit = true;
+    }
+    m_state->cond.notify_all();
+
+    for (auto& t : m_workers) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void ec_crypto_pool_t::enqueue(uint64_t key, job_t job, bool front)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->lock);
+        strand_t& strand = m_state->strands[key];
+        // A strand is in the ready queue whenever it has jobs and none running
+        bool idle = (strand.running == false) && strand.jobs.empty();
+
+        if (front) {
+            strand.jobs.push_front(std::move(job));
+        } else {
+            strand.jobs.push_back(std::move(job));
+        }
+        m_state->stats.submitted++;
+        if (m_state->strands.size() > m_state->stats.max_in_flight) {
+            m_state->stats.max_in_flight = m_state->strands.size();
+        }
+        if (idle == false) {
+            return;
+        }
+        m_state->ready.push_back(key);
+    }
+    m_state->cond.notify_one();
+}
+
+void ec_crypto_pool_t::submit(uint64_t key, work_func work, done_func done)
+{
+    enqueue(key, job_t{work, done}, false);
+}
+
+void ec_crypto_pool_t::submit_next(uint64_t key, work_func work, done_func done)
+{
+    enqueue(key, job_t{work, done}, true);
+}
+
+bool ec_crypto_pool_t::is_busy(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(m_state->lock);
+    return m_state->strands.find(key) != m_state->strands.end();
+}
+
+ec_crypto_pool_stats_t ec_crypto_pool_t::get_stats()
+{
+    std::lock_guard<std::mutex> lock(m_state->lock);
+    ec_crypto_pool_stats_t stats = m_state->stats;
+    stats.in_flight = m_state->strands.size();
+    return stats;
+}
+
+void ec_crypto_pool_t::complete(const std::shared_ptr<state_t>& state, uint64_t key)
+{
+    {
+        std::lock_guard<std::mutex> lock(state->lock);
+        auto it = state->strands.find(key);
+        if (it == state->strands.end()) {
+            return;
+        }
+        state->stats.completed++;
+        it->second.running = false;
+        if (it->second.jobs.empty()) {
+            state->strands.erase(it);
+            return;
+        }
+        state->ready.push_back(key);
+    }
+    state->cond.notify_one();
+}
+
+void ec_crypto_pool_t::worker()
+{
+    std::shared_ptr<state_t> state = m_state;
+    std::unique_lock<std::mutex> lock(state->lock);
+
+    while (true) {
+        state->cond.wait(lock, [&state]() { return state->exit || !state->ready.empty(); });
+        if (state->exit) {
+            break;
+        }
+
+        uint64_t key = state->ready.front();
+        state->ready.pop_front();
+        strand_t& strand = state->strands[key];
+        job_t job = std::move(strand.jobs.front());
+        strand.jobs.pop_front();
+        strand.running = true;
+        lock.unlock();
+
+        if (job.work) {
+            job.work();
+        }
+
+        // The strand stays blocked until the completion ran on the owner thread
+        std::weak_ptr<state_t> weak = state;
+        done_func done = std::move(job.done);
+        m_post([weak, key, done]() {
+            std::shared_ptr<state_t> st = weak.lock();
+            if (st == nullptr) {
+                return;
+            }
+            if (done) {
+                done();
+            }
+            complete(st, key);
+        });
+
+        lock.lock();
+    }
+}
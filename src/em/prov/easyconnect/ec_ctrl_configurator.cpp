@@ -2,12 +2,52 @@
 
 #include "ec_base.h"
 #include "ec_util.h"
+#include "ec_frame_builder.h"
 #include "util.h"
 #include "cjson/cJSON.h"
 #include "cjson_util.h"
 #include "em_crypto.h"
 #include <netinet/in.h>
 
+namespace {
+
+// A proxied DPP frame handled on the crypto pool, see dispatch_to_crypto_pool()
+struct ec_ctrl_crypto_job_t {
+    ec_frame_type_t frame_type = ec_frame_type_auth_req;
+    uint8_t *frame = NULL;
+    uint16_t frame_len = 0;
+    mac_addr_t mac = {0};
+    bool result = false;
+
+    // Data model lookups made on the owner thread before the job runs
+    bool can_onboard = false;
+    cJSON *base_objs[dpp_config_obj_fbss + 1] = {};
+
+    // Proxied Encap DPP messages to send from the owner thread once the job completes
+    struct msg_t {
+        std::vector<uint8_t> encap = {};
+        std::vector<uint8_t> chirp = {};
+        size_t chirp_len = 0;
+    };
+    std::vector<msg_t> outbox = {};
+
+    ec_ctrl_crypto_job_t() = default;
+    ec_ctrl_crypto_job_t(const ec_ctrl_crypto_job_t&) = delete;
+    ec_ctrl_crypto_job_t& operator=(const ec_ctrl_crypto_job_t&) = delete;
+
+    ~ec_ctrl_crypto_job_t() {
+        free(frame);
+        for (cJSON *obj : base_objs) {
+            if (obj != NULL) cJSON_Delete(obj);
+        }
+    }
+};
+
+// The job the calling crypto pool worker is running, NULL on the owner thread
+thread_local ec_ctrl_crypto_job_t *s_crypto_job = NULL;
+
+}
+
 bool ec_ctrl_configurator_t::onboard_enrollee(ec_data_t *bootstrapping_data)
 {
 
@@ -30,15 +70,15 @@ bool ec_ctrl_configurator_t::onboard_enrollee(ec_data_t *bootstrapping_data)
 
     // Check if the MAC address is already in use
     // TODO: Not sure what to do if the MAC address is already in use
-    std::string mac_str = util::mac_to_string(bootstrapping_data->mac_addr);
-    if (m_connections.find(mac_str) != m_connections.end()) {
+    if (get_conn_ctx(bootstrapping_data->mac_addr) != NULL) {
         em_printfout("Bootstrapping data MAC address already in use");
         return false;
     }
-    // Create a new connection context
-    ec_connection_context_t conn_ctx;
-    m_connections[mac_str] = conn_ctx;
-    auto& c_ctx = m_connections[mac_str];
+    // Create a new connection context, zeroed so that an early eviction releases nothing it does not own
+    ec_connection_context_t conn_ctx = {};
+    std::unique_lock<std::mutex> conn_lock(m_conn_lock);
+    auto& c_ctx = m_connections.insert(ec_session_cache::mac_key(bootstrapping_data->mac_addr), conn_ctx);
+    conn_lock.unlock();
     
 
     // Initialize bootstrapping data
@@ -75,7 +115,7 @@ bool ec_ctrl_configurator_t::process_chirp_notification(em_dpp_chirp_value_t *ch
     }
 
     std::string mac_str = util::mac_to_string(mac);
-    auto c_ctx = get_conn_ctx(mac_str);
+    auto c_ctx = get_conn_ctx(mac);
     ASSERT_NOT_NULL_FREE(c_ctx, false, hash, "%s:%d: Connection context not found for enrollee MAC %s. Has the DPP URI been given?\n", __func__, __LINE__, mac_str.c_str());
 
     // Validate hash
@@ -118,7 +158,7 @@ bool ec_ctrl_configurator_t::process_chirp_notification(em_dpp_chirp_value_t *ch
     free(hash);
 
     // Send the encapsulated DPP message (with Encap TLV and Chirp TLV)
-    this->m_send_prox_encap_dpp_msg(encap_dpp_tlv, encap_dpp_size, chirp, chirp_tlv_size);
+    send_encap_dpp(encap_dpp_tlv, encap_dpp_size, chirp, chirp_tlv_size);
 
     free(encap_dpp_tlv);
     free(chirp);
@@ -144,41 +184,169 @@ bool ec_ctrl_configurator_t::process_proxy_encap_dpp_msg(em_encap_dpp_t *encap_t
         return false;
     }
 
+    ec_frame_type_t ec_frame_type = static_cast<ec_frame_type_t>(frame_type);
+
+    if ((m_crypto_pool == nullptr) && (m_add_timer != nullptr)) {
+        // Completions run on the manager thread as 0 ms timers, the timer wheel may be armed from any thread
+        m_crypto_pool = std::make_unique<ec_crypto_pool_t>(EC_CTRL_CRYPTO_WORKERS, [this](std::function<void()> cb) {
+            m_add_timer(0, false, cb);
+        });
+        em_printfout("Handling proxied DPP exchanges on %u crypto workers", m_crypto_pool->get_num_workers());
+    }
+    if ((m_crypto_pool != nullptr) && dispatch_to_crypto_pool(ec_frame_type, encap_frame, encap_frame_len, dest_mac)) {
+        // The job owns the frame now
+        return true;
+    }
+
+    bool did_finish = handle_proxied_frame(ec_frame_type, encap_frame, encap_frame_len, dest_mac);
+    // Parse out dest STA mac address and hash value then validate against the hash in the 
+    // ec_session dpp uri info public key. 
+    // Then construct an Auth request frame and send back in an Encap message
+    free(encap_frame);
+    return did_finish;
+}
+
+bool ec_ctrl_configurator_t::handle_proxied_frame(ec_frame_type_t frame_type, uint8_t *encap_frame, uint16_t encap_frame_len, uint8_t src_mac[ETH_ALEN])
+{
     bool did_finish = false;
 
-    ec_frame_type_t ec_frame_type = static_cast<ec_frame_type_t>(frame_type);
-    switch (ec_frame_type) {
+    switch (frame_type) {
         case ec_frame_type_recfg_announcement: {
-            did_finish = handle_recfg_announcement(reinterpret_cast<ec_frame_t*>(encap_frame), encap_frame_len, dest_mac);
+            did_finish = handle_recfg_announcement(reinterpret_cast<ec_frame_t*>(encap_frame), encap_frame_len, src_mac);
             break;
         }
         case ec_frame_type_auth_rsp: {
-            did_finish = handle_auth_response(reinterpret_cast<ec_frame_t*>(encap_frame), encap_frame_len, dest_mac);
+            did_finish = handle_auth_response(reinterpret_cast<ec_frame_t*>(encap_frame), encap_frame_len, src_mac);
             break;
         }
         case ec_frame_type_easymesh: {
-            did_finish = handle_proxied_dpp_configuration_request(encap_frame, encap_frame_len, dest_mac);
+            did_finish = handle_proxied_dpp_configuration_request(encap_frame, encap_frame_len, src_mac);
             break;
         }
         case ec_frame_type_cfg_result: {
-            did_finish = handle_proxied_config_result_frame(encap_frame, encap_frame_len, dest_mac);
+            did_finish = handle_proxied_config_result_frame(encap_frame, encap_frame_len, src_mac);
             break;
         }
         case ec_frame_type_conn_status_result: {
-            did_finish = handle_proxied_conn_status_result_frame(encap_frame, encap_frame_len, dest_mac);
+            did_finish = handle_proxied_conn_status_result_frame(encap_frame, encap_frame_len, src_mac);
             break;
         }
         default:
-            em_printfout("Encap DPP frame type (%d) not handled", ec_frame_type);
+            em_printfout("Encap DPP frame type (%d) not handled", frame_type);
             break;
     }
-    // Parse out dest STA mac address and hash value then validate against the hash in the 
-    // ec_session dpp uri info public key. 
-    // Then construct an Auth request frame and send back in an Encap message
-    free(encap_frame);
     return did_finish;
 }
 
+
+bool ec_ctrl_configurator_t::dispatch_to_crypto_pool(ec_frame_type_t frame_type, uint8_t *encap_frame, uint16_t encap_frame_len, uint8_t src_mac[ETH_ALEN])
+{
+    uint64_t key = ec_session_cache::mac_key(src_mac);
+    bool offload = (frame_type == ec_frame_type_auth_rsp) || (frame_type == ec_frame_type_easymesh);
+
+    if ((offload == false) && (m_crypto_pool->is_busy(key) == false)) {
+        return false;
+    }
+    // Without a connection context the handler fails straight away, let it do so inline
+    if (pin_conn_ctx(key) == false) {
+        return false;
+    }
+
+    auto job = std::make_shared<ec_ctrl_crypto_job_t>();
+    job->frame_type = frame_type;
+    job->frame = encap_frame;
+    job->frame_len = encap_frame_len;
+    memcpy(job->mac, src_mac, ETH_ALEN);
+
+    if (frame_type == ec_frame_type_easymesh) {
+        // Whether the Enrollee is an AP or a STA is only known once the request is decrypted, fetch both
+        ec_connection_context_t *conn_ctx = get_conn_ctx(src_mac);
+        job->can_onboard = (m_can_onboard_additional_aps != nullptr) && m_can_onboard_additional_aps();
+        if (job->can_onboard) {
+            job->base_objs[dpp_config_obj_ieee1905] = (m_get_1905_info != nullptr) ? m_get_1905_info(conn_ctx) : NULL;
+            job->base_objs[dpp_config_obj_bsta] = (m_get_backhaul_sta_info != nullptr) ? m_get_backhaul_sta_info(conn_ctx) : NULL;
+            job->base_objs[dpp_config_obj_fbss] = (m_get_fbss_info != nullptr) ? m_get_fbss_info(conn_ctx) : NULL;
+        }
+    }
+
+    ec_crypto_pool_t::work_func work = nullptr;
+    if (offload) {
+        work = [this, job]() {
+            s_crypto_job = job.get();
+            job->result = handle_proxied_frame(job->frame_type, job->frame, job->frame_len, job->mac);
+            s_crypto_job = NULL;
+        };
+    }
+
+    m_crypto_pool->submit(key, work, [this, job, key, offload]() {
+        if (offload == false) {
+            job->result = handle_proxied_frame(job->frame_type, job->frame, job->frame_len, job->mac);
+        }
+        for (auto& msg : job->outbox) {
+            em_dpp_chirp_value_t *chirp = msg.chirp.empty() ? NULL : reinterpret_cast<em_dpp_chirp_value_t *>(msg.chirp.data());
+            if (!m_send_prox_encap_dpp_msg(reinterpret_cast<em_encap_dpp_t *>(msg.encap.data()), msg.encap.size(), chirp, msg.chirp_len)) {
+                em_printfout("Failed to send Proxied Encap DPP message to '" MACSTRFMT "'", MAC2STR(job->mac));
+                job->result = false;
+            }
+        }
+        unpin_conn_ctx(key);
+        if (job->result == false) {
+            em_printfout("Proxied DPP frame (type %d) from '" MACSTRFMT "' failed", job->frame_type, MAC2STR(job->mac));
+        }
+    });
+
+    return true;
+}
+
+bool ec_ctrl_configurator_t::send_encap_dpp(em_encap_dpp_t *encap_tlv, size_t encap_tlv_len, em_dpp_chirp_value_t *chirp_tlv, size_t chirp_tlv_len)
+{
+    if (s_crypto_job == NULL) {
+        return m_send_prox_encap_dpp_msg(encap_tlv, encap_tlv_len, chirp_tlv, chirp_tlv_len);
+    }
+
+    // On a worker, the caller frees its buffers once this returns
+    ec_ctrl_crypto_job_t::msg_t msg;
+    uint8_t *encap = reinterpret_cast<uint8_t *>(encap_tlv);
+    msg.encap.assign(encap, encap + encap_tlv_len);
+    if (chirp_tlv != NULL) {
+        uint8_t *chirp = reinterpret_cast<uint8_t *>(chirp_tlv);
+        msg.chirp.assign(chirp, chirp + chirp_tlv_len);
+    }
+    msg.chirp_len = chirp_tlv_len;
+    s_crypto_job->outbox.push_back(std::move(msg));
+    return true;
+}
+
+cJSON *ec_ctrl_configurator_t::get_config_obj_base(dpp_config_obj_type_e config_obj_type, ec_connection_context_t *conn_ctx)
+{
+    if (s_crypto_job != NULL) {
+        // Ownership moves to the caller, as with the callbacks
+        cJSON *obj = s_crypto_job->base_objs[config_obj_type];
+        s_crypto_job->base_objs[config_obj_type] = NULL;
+        return obj;
+    }
+
+    switch (config_obj_type) {
+        case dpp_config_obj_ieee1905:
+            return m_get_1905_info(conn_ctx);
+        case dpp_config_obj_bsta:
+            return m_get_backhaul_sta_info(conn_ctx);
+        case dpp_config_obj_fbss:
+            return m_get_fbss_info(conn_ctx);
+        default:
+            return NULL;
+    }
+}
+
+bool ec_ctrl_configurator_t::can_onboard_additional_aps()
+{
+    if (s_crypto_job != NULL) {
+        return s_crypto_job->can_onboard;
+    }
+    return (m_can_onboard_additional_aps != nullptr) && m_can_onboard_additional_aps();
+}
+
+
 bool ec_ctrl_configurator_t::handle_proxied_config_result_frame(uint8_t *encap_frame, uint16_t encap_frame_len, uint8_t src_mac[ETH_ALEN])
 {
     if (!encap_frame || encap_frame_len == 0) {
@@ -358,14 +526,14 @@ bool ec_ctrl_configurator_t::handle_proxied_dpp_configuration_request(uint8_t *e
     // Configurator shall respond with a DPP Configuration Response by adding the DPP Status field set to
     // STATUS_CONFIGURE_PENDING and wrapped data consisting of the Enrollee’s nonce wrapped in ke:
     // Configurator → Enrollee: DPP Status, { E-nonce }ke
-    bool cannot_onboard_more = (m_can_onboard_additional_aps == nullptr || !m_can_onboard_additional_aps());
+    bool cannot_onboard_more = !can_onboard_additional_aps();
     if (cannot_onboard_more) {
         em_printfout("DPP Configuration Request frame received, but we cannot onboard any more APs! Rejecting with status %s", ec_util::status_code_to_string(DPP_STATUS_CONFIGURATION_FAILURE).c_str());
         auto [config_response_frame, config_response_frame_len] = create_config_response_frame(src_mac, session_dialog_token, DPP_STATUS_CONFIGURATION_FAILURE);
         std::string status_code_str =  ec_util::status_code_to_string(DPP_STATUS_CONFIGURATION_FAILURE);
 
         em_printfout("Sending DPP Configuration Response frame for Enrollee '" MACSTRFMT "' over 1905 with DPP status code %s", MAC2STR(src_mac), status_code_str.c_str());
-        bool sent = m_send_prox_encap_dpp_msg(reinterpret_cast<em_encap_dpp_t*>(config_response_frame), config_response_frame_len, nullptr, config_response_frame_len);
+        bool sent = send_encap_dpp(reinterpret_cast<em_encap_dpp_t*>(config_response_frame), config_response_frame_len, nullptr, config_response_frame_len);
         if (!sent) {
             em_printfout("Failed to send DPP Configuration Response for Enrollee '" MACSTRFMT "'", MAC2STR(src_mac));
         }
@@ -377,7 +545,10 @@ bool ec_ctrl_configurator_t::handle_proxied_dpp_configuration_request(uint8_t *e
     EasyConnect 7.5
     When a device is set-up as a Configurator, it generates the key pair (c-sign-key, C-sign-key), to sign and verify Connectors, respectively.
     */
-    conn_ctx->C_signing_key = em_crypto_t::generate_ec_key(conn_ctx->nid);
+    auto keys = get_configurator_keys(*conn_ctx);
+    ASSERT_NOT_NULL(keys, false, "%s:%d: No Configurator signing key for Enrollee '" MACSTRFMT "'\n", __func__, __LINE__, MAC2STR(src_mac));
+    em_crypto_t::free_key(conn_ctx->C_signing_key);
+    conn_ctx->C_signing_key = em_crypto_t::ref_key(keys->c_signing_key);
 
 
     /*
@@ -453,7 +624,7 @@ bool ec_ctrl_configurator_t::handle_proxied_dpp_configuration_request(uint8_t *e
         em_printfout("Failed to create Configuration Respone frame");
         return false;
     }
-    bool sent = m_send_prox_encap_dpp_msg(reinterpret_cast<em_encap_dpp_t*>(config_response_frame), config_response_frame_len, nullptr, 0);
+    bool sent = send_encap_dpp(reinterpret_cast<em_encap_dpp_t*>(config_response_frame), config_response_frame_len, nullptr, 0);
     if (!sent) {
         em_printfout("Failed to send Proxied Encap DPP message containing DPP Configuration frame to '" MACSTRFMT "'", MAC2STR(src_mac));
         free(config_response_frame);
@@ -600,7 +771,7 @@ bool ec_ctrl_configurator_t::handle_auth_response(ec_frame_t *frame, size_t len,
         ASSERT_NOT_NULL(encap_dpp_tlv, false, "%s:%d: Failed to create Encap DPP TLV\n", __func__, __LINE__);
 
         // Send the encapsulated DPP message (with Encap TLV)
-        if (!this->m_send_prox_encap_dpp_msg(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
+        if (!send_encap_dpp(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
             em_printfout("Failed to send Encap DPP TLV");
         }
         free(encap_dpp_tlv);
@@ -729,7 +900,7 @@ bool ec_ctrl_configurator_t::handle_auth_response(ec_frame_t *frame, size_t len,
         ASSERT_NOT_NULL(encap_dpp_tlv, false, "%s:%d: Failed to create Encap DPP TLV\n", __func__, __LINE__);
 
         // Send the encapsulated DPP message (with Encap TLV)
-        if (!this->m_send_prox_encap_dpp_msg(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
+        if (!send_encap_dpp(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
             em_printfout("Failed to send encapsulated DPP message");
         }
 
@@ -767,7 +938,7 @@ bool ec_ctrl_configurator_t::handle_auth_response(ec_frame_t *frame, size_t len,
     ASSERT_NOT_NULL(encap_dpp_tlv, false, "%s:%d: Failed to create Encap DPP TLV\n", __func__, __LINE__);
 
     // Send the encapsulated DPP message (with Encap TLV)
-    if (!this->m_send_prox_encap_dpp_msg(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
+    if (!send_encap_dpp(encap_dpp_tlv, encap_dpp_size, NULL, 0)){
         em_printfout("Failed to send encapsulated DPP message");
         free(encap_dpp_tlv);
         return false;
@@ -806,14 +977,14 @@ bool ec_ctrl_configurator_t::handle_recfg_announcement(ec_frame_t *encap_frame,
     auto conn_ctx = get_conn_ctx(enrollee_mac);
     ASSERT_NOT_NULL(conn_ctx, false, "%s:%d: No known connection context for Enrollee '" MACSTRFMT "'\n", __func__, __LINE__, MAC2STR(sa));
 
-    uint8_t *configurator_c_sign_hash = ec_crypto::compute_key_hash(conn_ctx->C_signing_key);
-    if (memcmp(configurator_c_sign_hash, conf_c_sign_key_attr->data, conf_c_sign_key_attr->length) != 0) {
+    auto keys = get_configurator_keys(*conn_ctx, false);
+    if (keys == nullptr || keys->c_signing_key != conn_ctx->C_signing_key ||
+        conf_c_sign_key_attr->length != SHA256_DIGEST_LENGTH ||
+        memcmp(keys->c_sign.key_hash, conf_c_sign_key_attr->data, SHA256_DIGEST_LENGTH) != 0) {
         em_printfout("Mismatched C-sign-key hash, perhaps meant for another Configurator? Ignoring Reconfiguration Announcement from '" MACSTRFMT "'", MAC2STR(sa));
-        free(configurator_c_sign_hash);
         // Not an error.
         return true;
     }
-    free(configurator_c_sign_hash);
 
     // TODO
     // Derive E-id from E'-id, used to index if Reconfiguration is already under-way.
@@ -843,7 +1014,7 @@ bool ec_ctrl_configurator_t::handle_recfg_announcement(ec_frame_t *encap_frame,
     auto [encap_dpp_tlv, encap_dpp_tlv_len] = ec_util::create_encap_dpp_tlv(0, sa, ec_frame_type_recfg_auth_req, recfg_auth_req_frame, recfg_auth_req_frame_len);
     ASSERT_NOT_NULL_FREE(encap_dpp_tlv, false, recfg_auth_req_frame, "%s:%d: Failed to create Encap DPP TLV\n", __func__, __LINE__);
 
-    bool sent = m_send_prox_encap_dpp_msg(encap_dpp_tlv, encap_dpp_tlv_len, nullptr, 0);
+    bool sent = send_encap_dpp(encap_dpp_tlv, encap_dpp_tlv_len, nullptr, 0);
     free(encap_dpp_tlv);
     free(recfg_auth_req_frame);
     if (sent) {
@@ -862,15 +1033,14 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_auth_request(std::st
     auto e_ctx = get_eph_ctx(enrollee_mac);
     ASSERT_NOT_NULL(e_ctx, {}, "%s:%d: Ephemeral context not found for enrollee MAC %s\n", __func__, __LINE__, enrollee_mac.c_str());
 
-    ec_frame_t *frame =  ec_util::alloc_frame(ec_frame_type_auth_req);
-    ASSERT_NOT_NULL(frame, {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
+    ec_frame_builder_t builder;
+    ASSERT_MSG_TRUE(builder.begin(ec_frame_type_auth_req), {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
 
     // Start EasyConnect 6.3.2
 
     // Generate initiator nonce
     if (RAND_bytes(e_ctx->i_nonce, conn_ctx->nonce_len) != 1) {
         em_printfout("Failed to generate i-nonce!");
-        free(frame);
         return {};
     }
 
@@ -881,14 +1051,13 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_auth_request(std::st
     auto [priv_init_proto_key, pub_init_proto_key] = ec_crypto::generate_proto_keypair(*conn_ctx);
     if (priv_init_proto_key == NULL || pub_init_proto_key == NULL) {
         em_printfout("failed to generate initiator protocol key pair");
-        free(frame);
         return {};
     }
     e_ctx->priv_init_proto_key = const_cast<BIGNUM*>(priv_init_proto_key);
     e_ctx->public_init_proto_key = const_cast<EC_POINT*>(pub_init_proto_key);
 
     // Compute the M.x
-    ASSERT_NOT_NULL_FREE(conn_ctx->boot_data.resp_pub_boot_key, {}, frame, "%s:%d failed to get responder bootstrapping public key\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(conn_ctx->boot_data.resp_pub_boot_key, {}, "%s:%d failed to get responder bootstrapping public key\n", __func__, __LINE__);
 
     e_ctx->m = ec_crypto::compute_ec_ss_x(*conn_ctx, e_ctx->priv_init_proto_key, conn_ctx->boot_data.resp_pub_boot_key);
     const BIGNUM *bn_inputs[1] = { e_ctx->m };
@@ -896,39 +1065,35 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_auth_request(std::st
     e_ctx->k1 = static_cast<uint8_t *>(calloc(conn_ctx->digest_len, 1));
     if (ec_crypto::compute_hkdf_key(*conn_ctx, e_ctx->k1, conn_ctx->digest_len, "first intermediate key", bn_inputs, 1, NULL, 0) == 0) {
         em_printfout("Failed to compute k1");
-        free(frame);
         return {};
     }
 
     printf("Key K_1:\n");
     util::print_hex_dump(static_cast<unsigned int> (conn_ctx->digest_len), e_ctx->k1);
     
-    uint8_t* attribs = NULL;
-    size_t attribs_len = 0;
-
     // Responder Bootstrapping Key Hash: SHA-256(B_R)
     uint8_t* responder_keyhash = ec_crypto::compute_key_hash(conn_ctx->boot_data.responder_boot_key);
-    ASSERT_NOT_NULL_FREE2(responder_keyhash, {}, frame, attribs, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(responder_keyhash, {}, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
+    builder.add_attrib(ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
     free(responder_keyhash);
 
     // Initiator Bootstrapping Key Hash: SHA-256(B_I)
     if (conn_ctx->boot_data.initiator_boot_key != NULL){
         // If != NULL, mutual authentication can be performed.
         uint8_t* initiator_keyhash = ec_crypto::compute_key_hash(conn_ctx->boot_data.initiator_boot_key);
-        ASSERT_NOT_NULL_FREE2(initiator_keyhash, {}, frame, attribs, "%s:%d failed to compute initiator bootstrapping key hash\n", __func__, __LINE__); 
+        ASSERT_NOT_NULL(initiator_keyhash, {}, "%s:%d failed to compute initiator bootstrapping key hash\n", __func__, __LINE__); 
     
-        attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
+        builder.add_attrib(ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
         free(initiator_keyhash);
     }
 
 
     // Public Initiator Protocol Key: P_I
     auto protocol_key_buff = ec_crypto::encode_ec_point(*conn_ctx, e_ctx->public_init_proto_key);
-    ASSERT_NOT_NULL_FREE2(protocol_key_buff, {}, frame, attribs, "%s:%d failed to encode public initiator protocol key\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(protocol_key_buff, {}, "%s:%d failed to encode public initiator protocol key\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_proto_key, static_cast<uint16_t>(2*BN_num_bytes(conn_ctx->prime)), protocol_key_buff);
+    builder.add_attrib(ec_attrib_id_init_proto_key, static_cast<uint16_t>(2*BN_num_bytes(conn_ctx->prime)), protocol_key_buff.get());
 
     // Protocol Version
     // if (m_cfgrtr_ver > 1) {
@@ -940,31 +1105,21 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_auth_request(std::st
     if (conn_ctx->boot_data.ec_freqs[0] != 0){
         unsigned int base_freq = conn_ctx->boot_data.ec_freqs[0]; 
         uint16_t chann_attr = ec_util::freq_to_channel_attr(base_freq);
-        attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_channel, sizeof(uint16_t), reinterpret_cast<uint8_t*>(&chann_attr));
+        builder.add_attrib(ec_attrib_id_channel, sizeof(uint16_t), reinterpret_cast<uint8_t*>(&chann_attr));
     }
 
 
     // Wrapped Data (with Initiator Nonce and Initiator Capabilities)
     // EasyMesh 8.2.2 Table 36
-    attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, e_ctx->k1, [&](){
-        uint8_t* wrap_attribs = NULL;
-        size_t wrapped_len = 0;
-        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_nonce, static_cast<uint16_t>(conn_ctx->nonce_len), e_ctx->i_nonce);
-        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_caps, m_dpp_caps.byte);
-        return std::make_pair(wrap_attribs, wrapped_len);
-    });
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_init_nonce, static_cast<uint16_t>(conn_ctx->nonce_len), e_ctx->i_nonce);
+    builder.add_attrib(ec_attrib_id_init_caps, m_dpp_caps.byte);
+    builder.end_wrapped(true, e_ctx->k1);
 
-    // Add attributes to the frame
-    if (!(frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len))) {
-        em_printfout("unable to copy attributes to frame");
-        free(frame);
-        free(attribs);
-        return {};
-    }
-
-    free(attribs);
+    auto [frame, frame_len] = builder.finish();
+    ASSERT_NOT_NULL(frame, {}, "%s:%d unable to build Authentication Request frame\n", __func__, __LINE__);
 
-    return std::make_pair(reinterpret_cast<uint8_t*>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+    return std::make_pair(frame, frame_len);
 
 }
 
@@ -991,54 +1146,43 @@ STATUS_OK:
         return {};
     }
 
-    ec_frame_t *frame =  ec_util::alloc_frame(ec_frame_type_auth_cnf);
-    ASSERT_NOT_NULL(frame, {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
+    ec_frame_builder_t builder;
+    ASSERT_MSG_TRUE(builder.begin(ec_frame_type_auth_cnf), {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
 
-    uint8_t* attribs = NULL;
-    size_t attribs_len = 0;
-    
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_dpp_status, static_cast<uint8_t>(dpp_status));
+    builder.add_attrib(ec_attrib_id_dpp_status, static_cast<uint8_t>(dpp_status));
 
     // Add Responder Bootstrapping Key Hash (SHA-256(B_R))
     uint8_t* responder_keyhash = ec_crypto::compute_key_hash(conn_ctx->boot_data.responder_boot_key);
-    ASSERT_NOT_NULL_FREE2(responder_keyhash, {}, frame, attribs, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(responder_keyhash, {}, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
+    builder.add_attrib(ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
     free(responder_keyhash);
     // Conditional (Only included for mutual authentication) (SHA-256(B_I))
     if (e_ctx->is_mutual_auth) {
         uint8_t* initiator_keyhash = ec_crypto::compute_key_hash(conn_ctx->boot_data.initiator_boot_key);
         if (initiator_keyhash != NULL) {
-            attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
+            builder.add_attrib(ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
             free(initiator_keyhash);
         }
 
     }
 
     uint8_t* key = (dpp_status == DPP_STATUS_OK) ? e_ctx->ke : e_ctx->k2;
-    ASSERT_NOT_NULL_FREE2(key, {}, frame, attribs, "%s:%d: k_e or k_2 was not created!\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(key, {}, "%s:%d: k_e or k_2 was not created!\n", __func__, __LINE__);
 
     // If DPP Status is OK, wrap the I-auth with the KE key, otherwise wrap the Responder Nonce with the K2 key
-    attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, key, [&](){
-        uint8_t* wrap_attribs = NULL;
-        size_t wrapped_len = 0;
-        if (dpp_status == DPP_STATUS_OK) {
-            wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_auth_tag, conn_ctx->digest_len, i_auth_tag);
-        } else {
-            wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_resp_nonce, conn_ctx->nonce_len, e_ctx->r_nonce);
-        }
-        return std::make_pair(wrap_attribs, wrapped_len);
-    });
-
-    if (!(frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len))) {
-        em_printfout("unable to copy attributes to frame");
-        free(frame);
-        free(attribs);
-        return {};
+    builder.begin_wrapped();
+    if (dpp_status == DPP_STATUS_OK) {
+        builder.add_attrib(ec_attrib_id_init_auth_tag, conn_ctx->digest_len, i_auth_tag);
+    } else {
+        builder.add_attrib(ec_attrib_id_resp_nonce, conn_ctx->nonce_len, e_ctx->r_nonce);
     }
-    free(attribs);
+    builder.end_wrapped(true, key);
 
-    return std::make_pair(reinterpret_cast<uint8_t*>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+    auto [frame, frame_len] = builder.finish();
+    ASSERT_NOT_NULL(frame, {}, "%s:%d unable to build Authentication Confirm frame\n", __func__, __LINE__);
+
+    return std::make_pair(frame, frame_len);
 }
 
 std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_recfg_auth_request(const std::string& enrollee_mac)
@@ -1076,7 +1220,13 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_recfg_auth_request(c
     // same number as the version member in the C-Connector, the generated C-Connector and the generated C-nonce to
     // generated the DPP Reconfiguration Authentication Request frame and send this frame to the Enrollee.
 
-    cJSON *jwsHeaderObj = ec_crypto::create_jws_header("dppCon", conn_ctx->C_signing_key);
+    auto keys = get_configurator_keys(*conn_ctx, false);
+    if (keys == nullptr || keys->c_signing_key != conn_ctx->C_signing_key) {
+        em_printfout("Enrollee was not configured with our C-sign-key");
+        free(frame);
+        free(attribs);
+        return {};
+    }
 
     std::vector<std::unordered_map<std::string, std::string>> groups = {
         {{"groupID", "mapNW"}, {"netRole", "configurator"}},
@@ -1085,7 +1235,8 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_recfg_auth_request(c
     std::optional<std::string> null_expiry = std::nullopt;
     cJSON *jwsPayloadObj = ec_crypto::create_jws_payload(*conn_ctx, groups, conn_ctx->net_access_key, null_expiry, DPP_VERSION);
 
-    auto connector = ec_crypto::generate_connector(jwsHeaderObj, jwsPayloadObj, conn_ctx->C_signing_key);
+    auto connector = ec_crypto::generate_connector(keys->c_sign.jws_header, jwsPayloadObj, keys->c_signing_key);
+    cJSON_Delete(jwsPayloadObj);
     ASSERT_OPT_HAS_VALUE(connector, {}, "%s:%d: Failed to generate C-Connector\n", __func__, __LINE__);
     e_ctx->connector = strdup(connector->c_str());
 
@@ -1149,6 +1300,42 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_recfg_auth_confirm(s
     return std::make_pair(reinterpret_cast<uint8_t*>(frame), EC_FRAME_BASE_SIZE + attribs_len);
 }
 
+std::shared_ptr<const ec_configurator_keys_t> ec_ctrl_configurator_t::get_configurator_keys(ec_connection_context_t& c_ctx, bool create)
+{
+    std::lock_guard<std::mutex> lock(m_keys_lock);
+
+    auto it = m_keys.find(c_ctx.nid);
+    if (it != m_keys.end()) {
+        return it->second;
+    }
+    if (!create) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ec_configurator_keys_t> keys(new ec_configurator_keys_t, [](ec_configurator_keys_t *k) {
+        em_crypto_t::free_key(k->c_signing_key);
+        if (k->ppk != nullptr) {
+            EC_POINT_free(k->ppk);
+        }
+        delete k;
+    });
+
+    keys->c_signing_key = em_crypto_t::generate_ec_key(c_ctx.nid);
+    ASSERT_NOT_NULL(keys->c_signing_key, nullptr, "%s:%d: Failed to generate C-sign-key\n", __func__, __LINE__);
+    keys->ppk = ec_crypto::create_ppkey_public(keys->c_signing_key);
+    ASSERT_NOT_NULL(keys->ppk, nullptr, "%s:%d: Failed to generate ppKey\n", __func__, __LINE__);
+
+    if (!ec_crypto::init_key_artifacts(c_ctx, keys->c_signing_key, nullptr, keys->c_sign) ||
+        !ec_crypto::init_key_artifacts(c_ctx, nullptr, keys->ppk, keys->pp_key)) {
+        em_printfout("Failed to encode Configurator keys");
+        return nullptr;
+    }
+
+    em_printfout("Generated Configurator C-sign-key (kid %s) for nid:%d", keys->c_sign.kid.c_str(), c_ctx.nid);
+    m_keys[c_ctx.nid] = keys;
+    return keys;
+}
+
 cJSON *ec_ctrl_configurator_t::finalize_config_obj(cJSON *base, ec_connection_context_t& conn_ctx, dpp_config_obj_type_e config_obj_type)
 {
     if (base == nullptr) {
@@ -1187,21 +1374,23 @@ cJSON *ec_ctrl_configurator_t::finalize_config_obj(cJSON *base, ec_connection_co
     ASSERT_NOT_NULL_FREE(cred, nullptr, base, "%s:%d: Could not get \"cred\" from IEEE1905 DPP Configuration Object\n", __func__, __LINE__);
     // Create / add Connector.
 
-    // Header
-    cJSON *jwsHeaderObj = ec_crypto::create_jws_header("dppCon", conn_ctx.C_signing_key);
+    // The JWS Protected Header, csign and ppKey only depend on the Configurator keys and are encoded once
+    auto keys = get_configurator_keys(conn_ctx, false);
+    ASSERT_NOT_NULL_FREE(keys, nullptr, base, "%s:%d: No Configurator keys\n", __func__, __LINE__);
 
     cJSON *jwsPayloadObj = ec_crypto::create_jws_payload(conn_ctx, groups, conn_ctx.net_access_key);
     // Create / add connector
-    std::optional<std::string> connector = ec_crypto::generate_connector(jwsHeaderObj, jwsPayloadObj, conn_ctx.C_signing_key);
+    std::optional<std::string> connector = ec_crypto::generate_connector(keys->c_sign.jws_header, jwsPayloadObj, keys->c_signing_key);
+    cJSON_Delete(jwsPayloadObj);
     ASSERT_OPT_HAS_VALUE(connector, nullptr, "%s:%d: Failed to generate connector\n", __func__, __LINE__);
     cJSON_AddStringToObject(cred, "signedConnector", connector->c_str());
 
     // Add csign
-    cJSON *cSignObj = ec_crypto::create_csign_object(conn_ctx, conn_ctx.C_signing_key);
+    cJSON *cSignObj = ec_crypto::create_csign_object(keys->c_sign);
     cJSON_AddItemToObject(cred, "csign", cSignObj);
 
     // Add ppKey
-    cJSON *ppKeyObj = ec_crypto::create_ppkey_object(conn_ctx);
+    cJSON *ppKeyObj = ec_crypto::create_ppkey_object(keys->pp_key);
     cJSON_AddItemToObject(cred, "ppKey", ppKeyObj);
     return base;
 }
@@ -1252,11 +1441,16 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_config_response_fram
 
     // DPP_STATUS_OK case.
     // 1905 Config Obj Always required
-    conn_ctx->ppk = ec_crypto::create_ppkey_public(conn_ctx->C_signing_key);
-    ASSERT_NOT_NULL(conn_ctx->ppk, {}, "%s:%d: Failed to generate ppK!\n", __func__, __LINE__);
+    auto keys = get_configurator_keys(*conn_ctx, false);
+    ASSERT_NOT_NULL(keys, {}, "%s:%d: No Configurator keys!\n", __func__, __LINE__);
+    if (conn_ctx->ppk != nullptr) {
+        EC_POINT_free(conn_ctx->ppk);
+    }
+    conn_ctx->ppk = EC_POINT_dup(keys->ppk, conn_ctx->group);
+    ASSERT_NOT_NULL(conn_ctx->ppk, {}, "%s:%d: Failed to copy ppK!\n", __func__, __LINE__);
     ASSERT_NOT_NULL(m_get_1905_info, {}, "%s:%d: Cannot generate 1905 Configuration Object, no callback!\n", __func__, __LINE__);
 
-    cJSON *ieee1905_config_obj = m_get_1905_info(conn_ctx);
+    cJSON *ieee1905_config_obj = get_config_obj_base(dpp_config_obj_ieee1905, conn_ctx);
     if (ieee1905_config_obj == nullptr) {
         em_printfout("Failed to create IEEE1905 Configuration object");
         return {};
@@ -1274,7 +1468,7 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_config_response_fram
     // If not STA onboarding (i.e. onboarding an AP Enrollee), create backhaul STA configuration object
     if (!is_sta) {
         ASSERT_NOT_NULL(m_get_backhaul_sta_info, {}, "%s:%d: Enrollee '" MACSTRFMT "' requests bSTA config, but bSTA config callback is nullptr!\n", __func__, __LINE__, MAC2STR(dest_mac));
-        cJSON *bsta_config_obj = m_get_backhaul_sta_info(conn_ctx);
+        cJSON *bsta_config_obj = get_config_obj_base(dpp_config_obj_bsta, conn_ctx);
         if (bsta_config_obj == nullptr) {
             em_printfout("Failed to create bSTA Configuration object");
             return {};
@@ -1290,7 +1484,7 @@ std::pair<uint8_t *, size_t> ec_ctrl_configurator_t::create_config_response_fram
     } else {
         // If STA onboarding, send fBSS credentials
         ASSERT_NOT_NULL(m_get_fbss_info, {}, "%s:%d: Enrollee '" MACSTRFMT "' requests STA onboarding (fBSS credentials) but fBSS config callback is nullptr!\n", __func__, __LINE__, MAC2STR(dest_mac));
-        cJSON *fbss_config_obj = m_get_fbss_info(conn_ctx);
+        cJSON *fbss_config_obj = get_config_obj_base(dpp_config_obj_fbss, conn_ctx);
         if (fbss_config_obj == nullptr) {
             em_printfout("Failed to create fBSS Configuration object");
             return {};
@@ -1,4 +1,5 @@
 #include "ec_enrollee.h"
+#include "ec_frame_builder.h"
 
 #include "ec_crypto.h"
 #include "em_crypto.h"
@@ -914,25 +915,22 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
         Responder → Initiator: DPP Status, SHA-256(BR), [ SHA-256(BI), ] PR, [Protocol Version], { R-nonce, I-nonce, R-capabilities, { R-auth }ke }k2
     */
 
-    ec_frame_t *frame =  ec_util::alloc_frame(ec_frame_type_auth_rsp);
-    ASSERT_NOT_NULL(frame, {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
-
-    uint8_t* attribs = NULL;
-    size_t attribs_len = 0;
+    ec_frame_builder_t builder;
+    ASSERT_MSG_TRUE(builder.begin(ec_frame_type_auth_rsp), {}, "%s:%d failed to allocate memory for frame\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_dpp_status, static_cast<uint8_t>(dpp_status));
+    builder.add_attrib(ec_attrib_id_dpp_status, static_cast<uint8_t>(dpp_status));
 
     // Add Responder Bootstrapping Key Hash (SHA-256(B_R))
     uint8_t* responder_keyhash = ec_crypto::compute_key_hash(m_boot_data().responder_boot_key);
-    ASSERT_NOT_NULL_FREE2(responder_keyhash, {}, frame, attribs, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(responder_keyhash, {}, "%s:%d failed to compute responder bootstrapping key hash\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
+    builder.add_attrib(ec_attrib_id_resp_bootstrap_key_hash, SHA256_DIGEST_LENGTH, responder_keyhash);
     free(responder_keyhash);
     // Conditional (Only included for mutual authentication) (SHA-256(B_I))
     if (m_eph_ctx().is_mutual_auth) {
         uint8_t* initiator_keyhash = ec_crypto::compute_key_hash(m_boot_data().initiator_boot_key);
         if (initiator_keyhash != NULL) {
-            attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
+            builder.add_attrib(ec_attrib_id_init_bootstrap_key_hash, SHA256_DIGEST_LENGTH, initiator_keyhash);
             free(initiator_keyhash);
         }
 
@@ -943,23 +941,16 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     if (dpp_status != DPP_STATUS_OK) {
         if (init_proto_version >= 2) {
             // Add Protocol Version (TOOD: Add variable for responder protocol version)
-            attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_proto_version, static_cast<uint8_t>(1));
+            builder.add_attrib(ec_attrib_id_proto_version, static_cast<uint8_t>(1));
         }
-        attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, m_eph_ctx().k1, [&](){
-            size_t wrapped_len = 0;
-            uint8_t* wrap_attribs = ec_util::add_attrib(NULL, &wrapped_len, ec_attrib_id_init_nonce, m_c_ctx.nonce_len, m_eph_ctx().i_nonce);
-            wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_resp_caps, m_dpp_caps.byte);
-            return std::make_pair(wrap_attribs, wrapped_len);
-        });
-        
-        if (!(frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len))) {
-            em_printfout("unable to copy attributes to frame");
-            free(frame);
-            free(attribs);
-            return {};
-        }
-        free(attribs);
-        return std::make_pair(reinterpret_cast<uint8_t*>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+        builder.begin_wrapped();
+        builder.add_attrib(ec_attrib_id_init_nonce, m_c_ctx.nonce_len, m_eph_ctx().i_nonce);
+        builder.add_attrib(ec_attrib_id_resp_caps, m_dpp_caps.byte);
+        builder.end_wrapped(true, m_eph_ctx().k1);
+
+        auto [frame, frame_len] = builder.finish();
+        ASSERT_NOT_NULL(frame, {}, "%s:%d unable to build Authentication Response frame\n", __func__, __LINE__);
+        return std::make_pair(frame, frame_len);
     }
     
     // STATUS_OK
@@ -967,8 +958,6 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     // Generate R-nonce
     if (!RAND_bytes(m_eph_ctx().r_nonce, m_c_ctx.nonce_len)) {
         em_printfout("failed to generate R-nonce");
-        free(attribs);
-        free(frame);
         return {};
     }
 
@@ -976,8 +965,6 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     auto [priv_resp_proto_key, pub_resp_proto_key] = ec_crypto::generate_proto_keypair(m_c_ctx);
     if (priv_resp_proto_key == NULL || pub_resp_proto_key == NULL) {
         em_printfout("failed to generate responder protocol keypair");
-        free(attribs);
-        free(frame);
         return {};
     }
     
@@ -985,22 +972,20 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     m_eph_ctx().public_resp_proto_key = const_cast<EC_POINT*>(pub_resp_proto_key);
     m_eph_ctx().priv_resp_proto_key = const_cast<BIGNUM*>(priv_resp_proto_key);
 
-    ASSERT_NOT_NULL_FREE2(m_eph_ctx().public_init_proto_key, {}, frame, attribs, "%s:%d initiator protocol keypair was never generated!\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(m_eph_ctx().public_init_proto_key, {}, "%s:%d initiator protocol keypair was never generated!\n", __func__, __LINE__);
     m_eph_ctx().n = ec_crypto::compute_ec_ss_x(m_c_ctx, m_eph_ctx().priv_resp_proto_key, m_eph_ctx().public_init_proto_key);
     const BIGNUM *bn_inputs[1] = { m_eph_ctx().n };
     // Compute the "second intermediate key" (k2)
     m_eph_ctx().k2 = static_cast<uint8_t *>(calloc(m_c_ctx.digest_len, 1));
     if (ec_crypto::compute_hkdf_key(m_c_ctx, m_eph_ctx().k2, m_c_ctx.digest_len, "second intermediate key", bn_inputs, 1, NULL, 0) == 0) {
         em_printfout("Failed to compute k2"); 
-        free(attribs);
-        free(frame);
         return {};
     }
 
     printf("Key K_2:\n");
     util::print_hex_dump(m_c_ctx.digest_len, m_eph_ctx().k2);
 
-    ASSERT_NOT_NULL_FREE2(m_boot_data().resp_priv_boot_key, {}, frame, attribs, "%s:%d failed to get responder bootstrapping private key\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(m_boot_data().resp_priv_boot_key, {}, "%s:%d failed to get responder bootstrapping private key\n", __func__, __LINE__);
 
     // Compute L.x
     if (m_eph_ctx().is_mutual_auth){
@@ -1011,8 +996,6 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
 
     if (m_eph_ctx().is_mutual_auth && m_eph_ctx().l == NULL) {
         em_printfout("failed to compute L.x");
-        free(attribs);
-        free(frame);
         return {};
     }
     
@@ -1021,8 +1004,6 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     m_eph_ctx().ke = static_cast<uint8_t *>(calloc(m_c_ctx.digest_len, 1));
     if (ec_crypto::compute_ke(m_c_ctx, &m_eph_ctx(), m_eph_ctx().ke) == 0){
         em_printfout("Failed to compute ke");
-        free(attribs);
-        free(frame);
         return {};
     }
 
@@ -1064,47 +1045,38 @@ std::pair<uint8_t *, size_t> ec_enrollee_t::create_auth_response(ec_status_code_
     if (P_R_x) BN_free(P_R_x);
     if (B_R_x) BN_free(B_R_x);
     if (B_I_x) BN_free(B_I_x);
-    ASSERT_NOT_NULL_FREE2(r_auth, {}, frame, attribs, "%s:%d: Failed to compute R-auth\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(r_auth, {}, "%s:%d: Failed to compute R-auth\n", __func__, __LINE__);
 
     // Add P_R
     auto encoded_P_R = ec_crypto::encode_ec_point(m_c_ctx, m_eph_ctx().public_resp_proto_key);
-    ASSERT_NOT_NULL_FREE2(encoded_P_R, {}, frame, attribs, "%s:%d failed to encode responder protocol key\n", __func__, __LINE__);
+    ASSERT_NOT_NULL(encoded_P_R, {}, "%s:%d failed to encode responder protocol key\n", __func__, __LINE__);
 
-    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_proto_key, static_cast<uint16_t>(BN_num_bytes(m_c_ctx.prime) * 2), encoded_P_R);
+    builder.add_attrib(ec_attrib_id_resp_proto_key, static_cast<uint16_t>(BN_num_bytes(m_c_ctx.prime) * 2), encoded_P_R.get());
 
     // Add Protocol Version
     if (init_proto_version >= 2) {
         // Add Protocol Version (TOOD: Add variable for responder protocol version)
-        attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_proto_version, static_cast<uint8_t>(1));
+        builder.add_attrib(ec_attrib_id_proto_version, static_cast<uint8_t>(1));
     }
 
     // Add `{ R-nonce, I-nonce, R-capabilities, { R-auth }k_e }k_2`
-    attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, m_eph_ctx().k2, [&](){
-        size_t wrapped_len = 0;
-        uint8_t* wrap_attribs = ec_util::add_attrib(NULL, &wrapped_len, ec_attrib_id_resp_nonce, m_c_ctx.nonce_len, m_eph_ctx().r_nonce);
-        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_nonce, m_c_ctx.nonce_len, m_eph_ctx().i_nonce);
-        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_resp_caps, m_dpp_caps.byte);
-
-        // R-auth is wrapped in an additional wrapped data attribute (k_e) inside the main wrapped data attribute (k_2)
-        wrap_attribs = ec_util::add_wrapped_data_attr(frame, wrap_attribs, &wrapped_len, false, m_eph_ctx().ke, [&](){
-            size_t int_wrapped_len = 0;
-            uint8_t* int_wrapped_attrs = ec_util::add_attrib(NULL, &int_wrapped_len, ec_attrib_id_resp_auth_tag, m_c_ctx.digest_len, r_auth);
-            return std::make_pair(int_wrapped_attrs, int_wrapped_len);
-        });
-        return std::make_pair(wrap_attribs, wrapped_len);
-    });
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_resp_nonce, m_c_ctx.nonce_len, m_eph_ctx().r_nonce);
+    builder.add_attrib(ec_attrib_id_init_nonce, m_c_ctx.nonce_len, m_eph_ctx().i_nonce);
+    builder.add_attrib(ec_attrib_id_resp_caps, m_dpp_caps.byte);
+
+    // R-auth is wrapped in an additional wrapped data attribute (k_e) inside the main wrapped data attribute (k_2)
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_resp_auth_tag, m_c_ctx.digest_len, r_auth);
+    builder.end_wrapped(false, m_eph_ctx().ke);
+    builder.end_wrapped(true, m_eph_ctx().k2);
 
     free(r_auth);
 
-    if (!(frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len))) {
-        em_printfout("unable to copy attributes to frame");
-        free(frame);
-        free(attribs);
-        return {};
-    }
-    free(attribs);
+    auto [frame, frame_len] = builder.finish();
+    ASSERT_NOT_NULL(frame, {}, "%s:%d unable to build Authentication Response frame\n", __func__, __LINE__);
 
-    return std::make_pair(reinterpret_cast<uint8_t*>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+    return std::make_pair(frame, frame_len);
 
 }
 
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ec_frame_builder.h"
+#include "util.h"
+#include "aes_siv.h"
+
+ec_frame_builder_t::ec_frame_builder_t(size_t capacity) : m_init_cap((capacity == 0) ? EC_FRAME_BUILDER_DEFAULT_CAPACITY : capacity)
+{
+}
+
+ec_frame_builder_t::~ec_frame_builder_t()
+{
+    free(m_buff);
+}
+
+bool ec_frame_builder_t::reserve(size_t extra)
+{
+    if (m_failed) {
+        return false;
+    }
+    if (m_len + extra <= m_cap) {
+        return true;
+    }
+
+    size_t new_cap = (m_cap == 0) ? m_init_cap : m_cap;
+    while (new_cap < m_len + extra) {
+        new_cap *= 2;
+    }
+
+    uint8_t *new_buff = static_cast<uint8_t *>(realloc(m_buff, new_cap));
+    if (new_buff == NULL) {
+        em_printfout("Failed to grow frame buffer to %zu bytes", new_cap);
+        m_failed = true;
+        return false;
+    }
+    m_buff = new_buff;
+    m_cap = new_cap;
+    return true;
+}
+
+void ec_frame_builder_t::reset()
+{
+    m_len = 0;
+    m_base_len = 0;
+    m_wrap_depth = 0;
+    m_failed = false;
+}
+
+bool ec_frame_builder_t::begin(size_t base_len)
+{
+    reset();
+    if (!reserve(base_len)) {
+        return false;
+    }
+    if (base_len != 0) {
+        memset(m_buff, 0, base_len);
+    }
+    m_len = m_base_len = base_len;
+    return true;
+}
+
+bool ec_frame_builder_t::begin(ec_frame_type_t type)
+{
+    if (!begin(EC_FRAME_BASE_SIZE)) {
+        return false;
+    }
+    ec_util::init_frame(frame());
+    frame()->frame_type = type;
+    return true;
+}
+
+uint8_t *ec_frame_builder_t::add_attrib(ec_attrib_id_t id, uint16_t len, const uint8_t *data)
+{
+    size_t attr_size = ec_util::get_ec_attr_size(len);
+    if (!reserve(attr_size)) {
+        return NULL;
+    }
+
+    ec_net_attribute_t *attr = reinterpret_cast<ec_net_attribute_t *>(m_buff + m_len);
+    // EC attribute id and length are little endian according to the spec (8.1)
+    attr->attr_id = SWAP_LITTLE_ENDIAN(id);
+    attr->length = SWAP_LITTLE_ENDIAN(len);
+    if (data != NULL && len != 0) {
+        memcpy(attr->data, data, len);
+    } else if (len != 0) {
+        memset(attr->data, 0, len);
+    }
+    m_len += attr_size;
+
+    return attr->data;
+}
+
+bool ec_frame_builder_t::begin_wrapped()
+{
+    if (m_failed) {
+        return false;
+    }
+    if (m_wrap_depth >= EC_FRAME_BUILDER_MAX_WRAP_DEPTH) {
+        em_printfout("Wrapped data nested deeper than %d", EC_FRAME_BUILDER_MAX_WRAP_DEPTH);
+        m_failed = true;
+        return false;
+    }
+
+    size_t off = m_len;
+    // Header plus the synthetic IV/tag, the plaintext follows; the length is set once it is known
+    if (add_attrib(ec_attrib_id_wrapped_data, AES_BLOCK_SIZE, NULL) == NULL) {
+        return false;
+    }
+    m_wrap_off[m_wrap_depth++] = off;
+    return true;
+}
+
+bool ec_frame_builder_t::end_wrapped(bool use_aad, const uint8_t *key)
+{
+    if (m_failed) {
+        return false;
+    }
+    if (m_wrap_depth == 0) {
+        em_printfout("No wrapped data attribute to close");
+        m_failed = true;
+        return false;
+    }
+
+    size_t off = m_wrap_off[--m_wrap_depth];
+    ec_net_attribute_t *attr = reinterpret_cast<ec_net_attribute_t *>(m_buff + off);
+    uint8_t *tag = attr->data;
+    uint8_t *plain = attr->data + AES_BLOCK_SIZE;
+    size_t wrapped_len = m_len - static_cast<size_t>(plain - m_buff);
+    if (wrapped_len + AES_BLOCK_SIZE > UINT16_MAX) {
+        em_printfout("Wrapped data too long (%zu bytes)", wrapped_len);
+        m_failed = true;
+        return false;
+    }
+    attr->length = SWAP_LITTLE_ENDIAN(static_cast<uint16_t>(wrapped_len + AES_BLOCK_SIZE));
+
+    // The attributes in front of this one at the same level: the frame's own, or the enclosing wrap's plaintext
+    size_t aad_off = (m_wrap_depth == 0) ? m_base_len : m_wrap_off[m_wrap_depth - 1] + ec_util::get_ec_attr_size(AES_BLOCK_SIZE);
+    size_t aad_len = off - aad_off;
+
+    siv_ctx ctx;
+    siv_init(&ctx, key, SIV_256);
+
+    int siv_result = 0;
+    if (use_aad) {
+        if (aad_len == 0) {
+            em_printfout("Frame attributes cannot be empty for AAD encryption");
+            siv_free(&ctx);
+            m_failed = true;
+            return false;
+        }
+        // siv_aes_ctr() handles plaintext and ciphertext sharing the buffer, s2v reads the plaintext first
+        if (m_base_len == 0) {
+            siv_result = siv_encrypt(&ctx, plain, plain, static_cast<int>(wrapped_len), tag, 1,
+                m_buff + aad_off, static_cast<int>(aad_len));
+        } else {
+            siv_result = siv_encrypt(&ctx, plain, plain, static_cast<int>(wrapped_len), tag, 2,
+                m_buff, static_cast<int>(m_base_len),
+                m_buff + aad_off, static_cast<int>(aad_len));
+        }
+    } else {
+        siv_result = siv_encrypt(&ctx, plain, plain, static_cast<int>(wrapped_len), tag, 0);
+    }
+    siv_free(&ctx);
+
+    if (siv_result < 0) {
+        em_printfout("Failed to encrypt and authenticate wrapped data");
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
+
+std::pair<uint8_t *, size_t> ec_frame_builder_t::finish()
+{
+    if (m_failed || m_buff == NULL || m_wrap_depth != 0) {
+        if (m_wrap_depth != 0) {
+            em_printfout("Frame finished with %u wrapped data attribute(s) still open", m_wrap_depth);
+        }
+        reset();
+        return {NULL, 0};
+    }
+
+    std::pair<uint8_t *, size_t> ret = {m_buff, m_len};
+    m_buff = NULL;
+    m_cap = 0;
+    reset();
+    return ret;
+}
@@ -161,6 +161,7 @@ bool ec_manager_t::upgrade_to_onboarded_proxy_agent()
     
     // Create a new proxy agent configurator
     m_configurator = std::unique_ptr<ec_pa_configurator_t>(new ec_pa_configurator_t(enrollee_mac, m_stored_chirp_fn, m_stored_encap_dpp_fn, m_stored_action_frame_fn, m_get_bsta_info_fn, m_get_1905_info_fn, m_get_fbss_info_fn, m_toggle_cce_fn));
+    m_configurator->set_timer_fns(m_add_timer_fn, m_cancel_timer_fn);
     em_printfout("Upgraded enrollee agent to proxy agent");
     return true;
 }
@@ -192,3 +193,16 @@ bool ec_manager_t::handle_bss_info_event(const wifi_bss_info_t &bss_info)
     }
     return m_enrollee->handle_bss_info_event(bss_info);
 }
+
+void ec_manager_t::set_timer_fns(add_timer_func add_timer_fn, cancel_timer_func cancel_timer_fn)
+{
+    m_add_timer_fn = add_timer_fn;
+    m_cancel_timer_fn = cancel_timer_fn;
+
+    if (m_configurator) {
+        m_configurator->set_timer_fns(add_timer_fn, cancel_timer_fn);
+    }
+    if (m_enrollee) {
+        m_enrollee->set_timer_fns(add_timer_fn, cancel_timer_fn);
+    }
+}
@@ -17,8 +17,8 @@ bool ec_pa_configurator_t::handle_presence_announcement(ec_frame_t *frame, size_
     // key hash in the DPP Presence Announcement frame matches any values of bootstrapping key hash of a stored DPP 
     // Authentication Request frame received from the Multi-AP Controller. 
     bool sent = false;
-    auto hash_frame_iter = m_chirp_hash_frame_map.find(B_r_hash_str);
-    if (hash_frame_iter == m_chirp_hash_frame_map.end()) {
+    auto hash_frame = m_chirp_hash_frame_map.find(B_r_hash_str);
+    if (hash_frame == nullptr) {
         // If no matching hash value is found, the Proxy Agent shall send a Chirp Notification message to the 
         // Controller with a DPP Chirp Value TLV
         em_printfout("No matching hash value found for '%s' in the DPP Presence Announcement frame", B_r_hash_str.c_str());
@@ -34,8 +34,7 @@ bool ec_pa_configurator_t::handle_presence_announcement(ec_frame_t *frame, size_
         // 1 second of receiving the Presence Announcement frame from that Enrollee, using a DPP Public Action frame to
         // the MAC address from where the Presence Announcement frame was received.
         em_printfout("Found matching hash value for '%s' in the DPP Presence Announcement frame", B_r_hash_str.c_str());
-        std::vector<uint8_t> encap_frame_vec  = hash_frame_iter->second;
-        sent = m_send_action_frame(src_mac, encap_frame_vec.data(), encap_frame_vec.size(), 0, 0);
+        sent = m_send_action_frame(src_mac, hash_frame->data(), hash_frame->size(), 0, 0);
     }
 
     return sent;	
@@ -52,11 +51,10 @@ bool ec_pa_configurator_t::handle_recfg_announcement(ec_frame_t *frame, size_t l
 
     std::string c_sign_key_hash_str = em_crypto_t::hash_to_hex_string(c_sign_key_hash_attr->data, c_sign_key_hash_attr->length);
     bool sent = false;
-    bool hash_known = (m_stored_recfg_auth_frames_map.find(c_sign_key_hash_str) != m_stored_recfg_auth_frames_map.end());
-    if (hash_known) {
+    auto recfg_frame = m_stored_recfg_auth_frames_map.find(c_sign_key_hash_str);
+    if (recfg_frame != nullptr) {
         em_printfout("Found matching C-sign key hash in DPP Reconfiguration Announcement frame, sending Reconfiguration Authentication Request frame");
-        std::vector<uint8_t> encap_frame_vec = m_stored_recfg_auth_frames_map[c_sign_key_hash_str];
-        sent = m_send_action_frame(sa, encap_frame_vec.data(), encap_frame_vec.size(), 0, 0);
+        sent = m_send_action_frame(sa, recfg_frame->data(), recfg_frame->size(), 0, 0);
     } else {
         em_printfout("No matching C-sign key hash found in DPP Reconfiguration Announcement frame, sending Reconfiguration Announcement frame to controller");
         auto [encap_frame, encap_frame_len] = ec_util::create_encap_dpp_tlv(false, sa, ec_frame_type_recfg_announcement, reinterpret_cast<uint8_t*>(frame), len);
@@ -84,7 +82,7 @@ bool ec_pa_configurator_t::handle_cfg_request(uint8_t *buff, unsigned int len, u
 {
     em_printfout("Rx'd a DPP Configuration Request from " MACSTRFMT "", MAC2STR(sa));
     ec_gas_initial_request_frame_t *req_frame = reinterpret_cast<ec_gas_initial_request_frame_t *>(buff);
-    m_gas_session_dialog_tokens[util::mac_to_string(sa)] = req_frame->base.dialog_token;
+    m_gas_session_dialog_tokens.insert(ec_session_cache::mac_key(sa), req_frame->base.dialog_token);
 
     // EasyMesh R6 5.3.4
     // If a Proxy Agent receives a DPP Configuration Request frame in a GAS frame from an Enrollee Multi-AP Agent, it shall
@@ -169,21 +167,19 @@ bool ec_pa_configurator_t::process_proxy_encap_dpp_msg(em_encap_dpp_t *encap_tlv
 
     bool did_finish = false;
 
-    std::string dest_mac_str = util::mac_to_string(dest_mac);
-
     bool needs_fragmentation = (encap_frame_len > WIFI_MTU_SIZE);
     if (needs_fragmentation) {
-        auto it = m_gas_session_dialog_tokens.find(dest_mac_str);
-        if (it == m_gas_session_dialog_tokens.end()) {
+        auto dialog_token_ptr = m_gas_session_dialog_tokens.find(ec_session_cache::mac_key(dest_mac));
+        if (dialog_token_ptr == nullptr) {
             em_printfout("No GAS session dialog token found for '" MACSTRFMT "', not sending 802.11 frame.", MAC2STR(dest_mac));
             return false;
         }
-        uint8_t dialog_token = it->second;
+        uint8_t dialog_token = *dialog_token_ptr;
         // If peer is not ready to receive GAS Comeback Frames, we must first send a "dummy" GAS Initial Response frame inidicating to the 
         // peer that GAS Comeback Response frames will be coming.
         // Fragment the frame and store the fragments and wait for a GAS Comeback Request prior to sending.
         em_printfout("Sending fragmentation prepare GAS Initial Response frame to '" MACSTRFMT "'", MAC2STR(dest_mac));
-        m_gas_frames_to_be_sent[dest_mac_str] = fragment_large_frame(encap_frame, encap_frame_len, dialog_token);
+        m_gas_frames_to_be_sent.insert(ec_session_cache::mac_key(dest_mac), fragment_large_frame(encap_frame, encap_frame_len, dialog_token));
         return send_prepare_for_fragmented_frames_frame(dest_mac);
     }
 
@@ -287,7 +283,7 @@ bool ec_pa_configurator_t::process_proxy_encap_dpp_msg(em_encap_dpp_t *encap_tlv
             
             // Store the encap frame keyed by the chirp hash in the map
             std::vector<uint8_t> encap_frame_vec(encap_frame, encap_frame + encap_frame_len);
-            m_chirp_hash_frame_map[chirp_hash_str] = encap_frame_vec;
+            m_chirp_hash_frame_map.insert(chirp_hash_str, std::move(encap_frame_vec));
             did_finish = true;
             break;
         }
@@ -301,7 +297,7 @@ bool ec_pa_configurator_t::process_proxy_encap_dpp_msg(em_encap_dpp_t *encap_tlv
             }
             std::vector<uint8_t> encap_frame_vec(encap_frame, encap_frame + encap_frame_len);
             const std::string c_sign_key_hash_str = em_crypto_t::hash_to_hex_string(c_sign_key_hash_attr->data, c_sign_key_hash_attr->length);
-            m_stored_recfg_auth_frames_map[c_sign_key_hash_str] = encap_frame_vec;
+            m_stored_recfg_auth_frames_map.insert(c_sign_key_hash_str, std::move(encap_frame_vec));
             did_finish = true;
             break;
         }
@@ -320,22 +316,22 @@ bool ec_pa_configurator_t::process_proxy_encap_dpp_msg(em_encap_dpp_t *encap_tlv
 bool ec_pa_configurator_t::handle_gas_comeback_request([[maybe_unused]] uint8_t *buff, [[maybe_unused]] unsigned int len, uint8_t sa[ETH_ALEN])
 {
     em_printfout("Received a GAS Comeback Request frame from '" MACSTRFMT "'", MAC2STR(sa));
-    auto frame_it = m_gas_frames_to_be_sent.find(util::mac_to_string(sa));
-    if (frame_it == m_gas_frames_to_be_sent.end()) {
+    uint64_t peer_key = ec_session_cache::mac_key(sa);
+    auto pending = m_gas_frames_to_be_sent.find(peer_key);
+    if (pending == nullptr) {
         // Nothing to do
         em_printfout("Received potentially spurious GAS Comeback Request frame from '" MACSTRFMT "', not doing anything with it", MAC2STR(sa));
         return true;
     }
 
     // Ensure we already have a GAS session with this peer
-    auto dialog_it = m_gas_session_dialog_tokens.find(util::mac_to_string(sa));
-    if (dialog_it == m_gas_session_dialog_tokens.end()) {
+    if (m_gas_session_dialog_tokens.find(peer_key) == nullptr) {
         em_printfout("Received GAS Comeback Request from '" MACSTRFMT "', we have a frame waiting for them, but no dialog token known!", MAC2STR(sa));
         return false;
     }
 
     // Get the fragments to send
-    std::vector<ec_gas_comeback_response_frame_t*>& fragments = frame_it->second;
+    std::vector<ec_gas_comeback_response_frame_t*>& fragments = *pending;
 
     if (fragments.empty()) {
         em_printfout("Received GAS Comeback Request, but we have no more fragments to send to '" MACSTRFMT "'", MAC2STR(sa));
@@ -357,17 +353,20 @@ bool ec_pa_configurator_t::handle_gas_comeback_request([[maybe_unused]] uint8_t
 
     em_printfout("Sent fragment #%d (more frags = %d) to '" MACSTRFMT "'", fragment->fragment_id, fragment->more_fragments, MAC2STR(sa));
     free(fragment);
+    if (fragments.empty()) {
+        m_gas_frames_to_be_sent.erase(peer_key);
+    }
     return sent;
 }
 
 bool ec_pa_configurator_t::send_prepare_for_fragmented_frames_frame(uint8_t dest_mac[ETH_ALEN])
 {
-    auto it = m_gas_session_dialog_tokens.find(util::mac_to_string(dest_mac));
-    if (it == m_gas_session_dialog_tokens.end()) {
+    auto dialog_token_ptr = m_gas_session_dialog_tokens.find(ec_session_cache::mac_key(dest_mac));
+    if (dialog_token_ptr == nullptr) {
         em_printfout("No GAS session dialog token found for '" MACSTRFMT "', cannot send fragmentation indication message to peer!",  MAC2STR(dest_mac));
         return false;
     }
-    uint8_t dialog_token = it->second;
+    uint8_t dialog_token = *dialog_token_ptr;
 
     // Inform GAS peer that we're going to be sending them a fragmented frame via the 
     // GAS Comeback mechanism by first sending a GAS Initial Response with resp_len = 0  and / or delay > 0
@@ -428,3 +427,12 @@ std::vector<ec_gas_comeback_response_frame_t *> ec_pa_configurator_t::fragment_l
 
     return fragments;
 }
+
+void ec_pa_configurator_t::get_session_cache_stats(ec_session_cache_stats_t& stats)
+{
+    ec_configurator_t::get_session_cache_stats(stats);
+    ec_session_cache_stats_add(stats, m_chirp_hash_frame_map.get_stats());
+    ec_session_cache_stats_add(stats, m_stored_recfg_auth_frames_map.get_stats());
+    ec_session_cache_stats_add(stats, m_gas_session_dialog_tokens.get_stats());
+    ec_session_cache_stats_add(stats, m_gas_frames_to_be_sent.get_stats());
+}
@@ -711,10 +711,11 @@ bool ec_util::decode_bootstrap_data(std::map<dpp_uri_field, std::string> uri_map
             auto class_channel_pairs = ec_util::parse_dpp_uri_channel_list(value);
             ASSERT_MSG_FALSE(class_channel_pairs.empty(), false,
                              "%s:%d: Failed to parse channel list\n", __func__, __LINE__);
+            em_freq_region_t region = util::em_freq_region(country_code);
             for (size_t idx = 0; idx < class_channel_pairs.size(); idx++) {
                 auto [op_class, channel] = class_channel_pairs[idx];
                 int freq = util::em_chan_to_freq(static_cast<uint8_t>(op_class),
-                                                 static_cast<uint8_t>(channel), country_code);
+                                                 static_cast<uint8_t>(channel), region);
                 if (freq <= 0) {
                     printf("Failed to convert channel to frequency (op class: %d, channel: %d)\n",
                            op_class, channel);
@@ -0,0 +1,528 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include "em_steer_engine.h"
+
+// Measurement Report element (IEEE 802.11 9.4.2.21) carrying a Beacon report (9.4.2.21.7)
+#define EM_STEER_MEAS_RPRT_ELEM_ID	39
+#define EM_STEER_MEAS_TYPE_BEACON	5
+#define EM_STEER_BEACON_RPRT_HDR_LEN	3	// token, mode, type
+#define EM_STEER_BEACON_RPRT_MIN_LEN	26	// fixed fields of the beacon report
+#define EM_STEER_BEACON_RPRT_RCPI	13	// offsets in the beacon report
+#define EM_STEER_BEACON_RPRT_BSSID	15
+
+unsigned long long em_steer_engine_t::mac_key(const unsigned char *mac)
+{
+	unsigned long long key = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		key = (key << 8) | mac[i];
+	}
+
+	return key;
+}
+
+void em_steer_engine_t::key_to_mac(unsigned long long key, unsigned char *mac)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(mac_address_t); i++) {
+		mac[sizeof(mac_address_t) - 1 - i] = static_cast<unsigned char> (key & 0xff);
+		key >>= 8;
+	}
+}
+
+time_t em_steer_engine_t::now_s()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec;
+}
+
+const em_steer_engine_t::policy_t *em_steer_engine_t::get_policy(unsigned long long ruid)
+{
+	auto it = m_policies.find(ruid);
+
+	if ((it == m_policies.end()) && ((it = m_policies.find(0)) == m_policies.end())) {
+		return NULL;
+	}
+
+	return &it->second;
+}
+
+void em_steer_engine_t::link_bss(unsigned long long bssid, unsigned long long sta)
+{
+	auto it = m_bss.find(bssid);
+
+	if ((it != m_bss.end()) && (std::find(it->second.stas.begin(), it->second.stas.end(), sta) == it->second.stas.end())) {
+		it->second.stas.push_back(sta);
+	}
+}
+
+void em_steer_engine_t::set_bssid(unsigned long long key, sta_t& sta, unsigned long long bssid, time_t now)
+{
+	if (sta.bssid == bssid) {
+		return;
+	}
+
+	sta.bssid = bssid;
+	sta.rcpi_time = 0;
+	link_bss(bssid, key);
+
+	if (sta.state == em_steer_sta_state_pending) {
+		finish(sta, (bssid != 0) && (bssid == sta.target), now);
+	} else if (sta.state == em_steer_sta_state_excluded) {
+		// a roam gives the STA a fresh start
+		sta.state = em_steer_sta_state_idle;
+		sta.failures = 0;
+	}
+}
+
+void em_steer_engine_t::add_cand(unsigned long long key, sta_t& sta, unsigned long long bssid, unsigned char rcpi, time_t now)
+{
+	unsigned int i, slot = sta.num_cands;
+
+	// only BSSes of the mesh can be steered to
+	if (m_bss.find(bssid) == m_bss.end()) {
+		return;
+	}
+
+	for (i = 0; i < sta.num_cands; i++) {
+		if (sta.cands[i].bssid == bssid) {
+			slot = i;
+			break;
+		}
+	}
+
+	// full: replace a stale entry, else the weakest if the new one is stronger
+	if (slot == EM_STEER_MAX_CANDS) {
+		for (i = 0; i < sta.num_cands; i++) {
+			if ((now - sta.cands[i].time) > EM_STEER_CAND_MAX_AGE) {
+				slot = i;
+				break;
+			}
+			if ((slot == EM_STEER_MAX_CANDS) || (sta.cands[i].rcpi < sta.cands[slot].rcpi)) {
+				slot = i;
+			}
+		}
+		if (((now - sta.cands[slot].time) <= EM_STEER_CAND_MAX_AGE) && (sta.cands[slot].rcpi >= rcpi)) {
+			return;
+		}
+	} else if (slot == sta.num_cands) {
+		sta.num_cands++;
+	}
+
+	sta.cands[slot].bssid = bssid;
+	sta.cands[slot].rcpi = rcpi;
+	sta.cands[slot].time = now;
+	link_bss(bssid, key);
+}
+
+int em_steer_engine_t::score(unsigned char rcpi, unsigned long long bssid)
+{
+	const policy_t *policy;
+	int s = rcpi;
+
+	auto it = m_bss.find(bssid);
+	if (it == m_bss.end()) {
+		return s;
+	}
+
+	policy = get_policy(it->second.ruid);
+	if ((policy != NULL) && (policy->util_threshold != 0) && (it->second.util > policy->util_threshold)) {
+		s -= (it->second.util - policy->util_threshold) / EM_STEER_UTIL_PENALTY_DIV;
+	}
+
+	return s;
+}
+
+void em_steer_engine_t::evaluate(unsigned long long key, sta_t& sta, time_t now)
+{
+	const policy_t *policy, *target_policy;
+	unsigned long long best = 0;
+	int cur, s, best_score;
+	unsigned int i;
+	bool weak, busy;
+
+	if (sta.state != em_steer_sta_state_idle) {
+		return;
+	}
+	m_stats.evaluated++;
+	sta.target = 0;
+
+	if ((sta.bssid == 0) || (sta.rcpi_time == 0) || ((now - sta.rcpi_time) > EM_STEER_LINK_MAX_AGE) ||
+			(m_disallowed.find(key) != m_disallowed.end())) {
+		return;
+	}
+
+	auto bss = m_bss.find(sta.bssid);
+	if ((bss == m_bss.end()) || ((policy = get_policy(bss->second.ruid)) == NULL)) {
+		return;
+	}
+
+	switch (policy->type) {
+		case em_steering_policy_type_rcpi_mandated:
+		case em_steering_policy_type_rcpi_allowed:
+			break;
+		default:
+			return;
+	}
+
+	weak = (policy->rcpi_threshold != 0) && (sta.rcpi < policy->rcpi_threshold);
+	busy = (policy->type == em_steering_policy_type_rcpi_allowed) && (policy->util_threshold != 0) &&
+		(bss->second.util > policy->util_threshold);
+	if ((weak == false) && (busy == false)) {
+		return;
+	}
+
+	cur = score(sta.rcpi, sta.bssid);
+	best_score = cur + EM_STEER_RCPI_HYSTERESIS - 1;
+	for (i = 0; i < sta.num_cands; i++) {
+		const cand_t& cand = sta.cands[i];
+		if ((cand.bssid == sta.bssid) || ((now - cand.time) > EM_STEER_CAND_MAX_AGE)) {
+			continue;
+		}
+
+		auto target = m_bss.find(cand.bssid);
+		if ((target == m_bss.end()) || (target->second.ruid == bss->second.ruid)) {
+			continue;
+		}
+		target_policy = get_policy(target->second.ruid);
+		if ((target_policy != NULL) && (target_policy->type == em_steering_policy_type_disallowed)) {
+			continue;
+		}
+
+		if ((s = score(cand.rcpi, cand.bssid)) > best_score) {
+			best_score = s;
+			best = cand.bssid;
+		}
+	}
+
+	if (best == 0) {
+		return;
+	}
+
+	sta.target = best;
+	sta.gain = best_score - cur;
+	if (sta.queued == false) {
+		sta.queued = true;
+		m_queue.push_back(key);
+	}
+}
+
+void em_steer_engine_t::finish(sta_t& sta, bool success, time_t now)
+{
+	time_t backoff = EM_STEER_BACKOFF_S;
+
+	if (sta.state != em_steer_sta_state_pending) {
+		return;
+	}
+	m_in_flight--;
+	sta.target = 0;
+
+	if (success == true) {
+		m_stats.succeeded++;
+		sta.failures = 0;
+	} else {
+		m_stats.failed++;
+		if (++sta.failures >= EM_STEER_MAX_FAILURES) {
+			sta.state = em_steer_sta_state_excluded;
+			return;
+		}
+		backoff = std::min(static_cast<time_t> (EM_STEER_BACKOFF_S) << sta.failures, static_cast<time_t> (EM_STEER_BACKOFF_MAX_S));
+	}
+
+	sta.state = em_steer_sta_state_backoff;
+	sta.until = now + backoff;
+}
+
+void em_steer_engine_t::begin_sync()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_generation++;
+}
+
+void em_steer_engine_t::observe_bss(const unsigned char *bssid, const unsigned char *ruid, unsigned int op_class, unsigned int channel)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	bss_t& bss = m_bss[mac_key(bssid)];
+
+	bss.ruid = mac_key(ruid);
+	bss.op_class = static_cast<unsigned char> (op_class);
+	bss.channel = static_cast<unsigned char> (channel);
+	bss.generation = m_generation;
+}
+
+void em_steer_engine_t::observe_policy(const em_policy_t *policy)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	mac_address_t broadcast_mac = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	unsigned int i;
+
+	if (policy->id.type == em_policy_id_type_steering_param) {
+		policy_t& p = m_policies[(memcmp(policy->id.radio_mac, broadcast_mac, sizeof(mac_address_t)) == 0) ? 0:mac_key(policy->id.radio_mac)];
+		p.type = policy->policy;
+		p.util_threshold = static_cast<unsigned char> (std::min(policy->util_threshold, static_cast<unsigned short> (0xff)));
+		p.rcpi_threshold = static_cast<unsigned char> (std::min(policy->rcpi_threshold, static_cast<unsigned short> (0xff)));
+		p.generation = m_generation;
+	} else if (policy->id.type == em_policy_id_type_steering_btm) {
+		for (i = 0; (i < policy->num_sta) && (i < EM_MAX_STA_PER_STEER_POLICY); i++) {
+			m_disallowed[mac_key(policy->sta_mac[i])] = m_generation;
+		}
+	}
+}
+
+void em_steer_engine_t::observe_sta(const unsigned char *sta, const unsigned char *bssid)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long key = mac_key(sta);
+	sta_t& s = m_stas[key];
+
+	s.generation = m_generation;
+	set_bssid(key, s, mac_key(bssid), now_s());
+}
+
+void em_steer_engine_t::end_sync()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (auto it = m_bss.begin(); it != m_bss.end(); ) {
+		it = (it->second.generation != m_generation) ? m_bss.erase(it):std::next(it);
+	}
+	for (auto it = m_policies.begin(); it != m_policies.end(); ) {
+		it = (it->second.generation != m_generation) ? m_policies.erase(it):std::next(it);
+	}
+	for (auto it = m_disallowed.begin(); it != m_disallowed.end(); ) {
+		it = (it->second != m_generation) ? m_disallowed.erase(it):std::next(it);
+	}
+
+	// gone STAs leave their queue, active and reverse index entries behind, those are skipped when walked
+	for (auto it = m_stas.begin(); it != m_stas.end(); ) {
+		if (it->second.generation == m_generation) {
+			++it;
+			continue;
+		}
+		if (it->second.state == em_steer_sta_state_pending) {
+			m_in_flight--;
+		}
+		it = m_stas.erase(it);
+	}
+}
+
+void em_steer_engine_t::update_sta_link(const unsigned char *sta, const unsigned char *bssid, unsigned char rcpi)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long key = mac_key(sta);
+	time_t now = now_s();
+
+	auto it = m_stas.find(key);
+	if (it == m_stas.end()) {
+		return;
+	}
+
+	set_bssid(key, it->second, mac_key(bssid), now);
+	it->second.rcpi = rcpi;
+	it->second.rcpi_time = now;
+	evaluate(key, it->second, now);
+}
+
+void em_steer_engine_t::update_beacon_report(const unsigned char *sta, const unsigned char *elems, unsigned int len)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long key = mac_key(sta);
+	const unsigned char *rprt;
+	unsigned int off = 0, elem_len;
+	time_t now = now_s();
+
+	auto it = m_stas.find(key);
+	if (it == m_stas.end()) {
+		return;
+	}
+
+	while ((off + 2) <= len) {
+		elem_len = elems[off + 1];
+		if ((off + 2 + elem_len) > len) {
+			break;
+		}
+
+		rprt = &elems[off + 2];
+		if ((elems[off] == EM_STEER_MEAS_RPRT_ELEM_ID) && (elem_len >= (EM_STEER_BEACON_RPRT_HDR_LEN + EM_STEER_BEACON_RPRT_MIN_LEN)) &&
+				(rprt[2] == EM_STEER_MEAS_TYPE_BEACON)) {
+			rprt += EM_STEER_BEACON_RPRT_HDR_LEN;
+			add_cand(key, it->second, mac_key(&rprt[EM_STEER_BEACON_RPRT_BSSID]), rprt[EM_STEER_BEACON_RPRT_RCPI], now);
+		}
+
+		off += 2 + elem_len;
+	}
+
+	evaluate(key, it->second, now);
+}
+
+void em_steer_engine_t::update_bss_metrics(const unsigned char *bssid, unsigned char util)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	unsigned long long key = mac_key(bssid);
+	unsigned int i, j;
+	time_t now = now_s();
+	bool linked;
+
+	auto bss = m_bss.find(key);
+	if ((bss == m_bss.end()) || (bss->second.util == util)) {
+		return;
+	}
+	bss->second.util = util;
+
+	std::vector<unsigned long long>& stas = bss->second.stas;
+	for (i = 0; i < stas.size(); ) {
+		auto it = m_stas.find(stas[i]);
+		linked = false;
+		if (it != m_stas.end()) {
+			linked = (it->second.bssid == key);
+			for (j = 0; (j < it->second.num_cands) && (linked == false); j++) {
+				linked = (it->second.cands[j].bssid == key);
+			}
+		}
+
+		if (linked == false) {
+			stas[i] = stas.back();
+			stas.pop_back();
+			continue;
+		}
+
+		evaluate(stas[i], it->second, now);
+		i++;
+	}
+}
+
+void em_steer_engine_t::update_steer_report(const unsigned char *sta, unsigned char status)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	auto it = m_stas.find(mac_key(sta));
+	if (it != m_stas.end()) {
+		finish(it->second, status == 0, now_s());
+	}
+}
+
+unsigned int em_steer_engine_t::run()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	std::vector<unsigned long long> deferred;
+	em_steer_req_params_t req;
+	unsigned int i, sent = 0;
+	time_t now = now_s();
+
+	for (i = 0; i < m_active.size(); ) {
+		auto it = m_stas.find(m_active[i]);
+		if (it != m_stas.end()) {
+			sta_t& sta = it->second;
+			if ((sta.state == em_steer_sta_state_pending) && (now >= sta.until)) {
+				finish(sta, false, now);
+			}
+			if ((sta.state == em_steer_sta_state_backoff) && (now >= sta.until)) {
+				sta.state = em_steer_sta_state_idle;
+			}
+			if ((sta.state == em_steer_sta_state_pending) || (sta.state == em_steer_sta_state_backoff)) {
+				i++;
+				continue;
+			}
+			sta.active = false;
+			evaluate(m_active[i], sta, now);
+		}
+		m_active[i] = m_active.back();
+		m_active.pop_back();
+	}
+
+	for (auto key : m_queue) {
+		auto it = m_stas.find(key);
+		if ((it == m_stas.end()) || (it->second.queued == false)) {
+			continue;
+		}
+
+		sta_t& sta = it->second;
+		auto target = m_bss.find(sta.target);
+		if ((sta.state != em_steer_sta_state_idle) || (target == m_bss.end())) {
+			sta.queued = false;
+			continue;
+		}
+		if (m_in_flight >= EM_STEER_MAX_IN_FLIGHT) {
+			m_stats.deferred++;
+			deferred.push_back(key);
+			continue;
+		}
+		sta.queued = false;
+
+		memset(&req, 0, sizeof(em_steer_req_params_t));
+		key_to_mac(key, req.sta);
+		key_to_mac(sta.bssid, req.source);
+		key_to_mac(sta.target, req.target);
+		req.target_op_class = target->second.op_class;
+		req.target_channel = target->second.channel;
+		req.gain = sta.gain;
+
+		// called with the lock held, the callback must not come back into the engine
+		if (m_apply(&req) < 0) {
+			sta.state = em_steer_sta_state_backoff;
+			sta.until = now + EM_STEER_BACKOFF_S;
+		} else {
+			sta.state = em_steer_sta_state_pending;
+			sta.until = now + EM_STEER_PENDING_TIMEOUT;
+			m_in_flight++;
+			m_stats.requested++;
+			sent++;
+		}
+
+		if (sta.active == false) {
+			sta.active = true;
+			m_active.push_back(key);
+		}
+	}
+	m_queue.swap(deferred);
+
+	return sent;
+}
+
+const em_steer_stats_t *em_steer_engine_t::get_stats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_stats.num_stas = static_cast<unsigned int> (m_stas.size());
+	m_stats.num_bss = static_cast<unsigned int> (m_bss.size());
+	m_stats.in_flight = m_in_flight;
+
+	return &m_stats;
+}
+
+em_steer_engine_t::em_steer_engine_t(em_steer_apply_func apply) : m_lock(), m_stas(), m_bss(), m_policies(), m_disallowed(),
+	m_queue(), m_active(), m_apply(apply), m_generation(0), m_in_flight(0), m_stats()
+{
+	memset(&m_stats, 0, sizeof(em_steer_stats_t));
+}
+
+em_steer_engine_t::~em_steer_engine_t()
+{
+
+}
@@ -472,6 +472,10 @@ int em_steering_t::handle_client_steering_report(unsigned char *buff, unsigned i
     dm_easy_mesh_t::macbytes_to_string(btm_rprt->sta_mac_addr, mac_str);
     printf("%s:%d Client BTM Report for sta %s, status %d\n", __func__, __LINE__, mac_str, btm_rprt->btm_status_code);
 
+    if (get_steer_engine() != NULL) {
+        get_steer_engine()->update_steer_report(btm_rprt->sta_mac_addr, btm_rprt->btm_status_code);
+    }
+
     set_state(em_state_ctrl_configured);
 
     //send ack for report rcvd
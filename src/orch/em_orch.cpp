@@ -36,6 +36,7 @@
 #include "em_base.h"
 #include "em_cmd.h"
 #include "em_orch.h"
+#include "em_mgr.h"
 #include "util.h"
 #define MAX_CMD_DEV_TEST 2
 
@@ -344,42 +345,46 @@ bool em_orch_t::is_cmd_type_in_progress(em_bus_event_t *evt)
     return false;
 }
 
+bool em_orch_t::is_cmd_type_in_progress(em_cmd_type_t type)
+{
+    em_short_string_t key;
+
+    snprintf(key, sizeof(em_short_string_t), "%d", type);
+
+    return (hash_map_get(m_cmd_map, key) != NULL);
+}
+
 void em_orch_t::handle_timeout()
 {
     em_cmd_t *pcmd;
     em_t *em;
     signed int i, j; 
-    unsigned int cnt;
-    bool eligible_to_move = false;
-    bool ret = true;
+    bool ret = true, fanout;
 
-    // go through pending queue and check if the commands can be moved to active
+    // go through pending queue and check if the commands can be moved to active, fan-out commands
+    // are bounded by their job window and all move as soon as their ems are idle
     for (i = static_cast<int>(queue_count(m_pending)) - 1; i >= 0; i--) {
         pcmd = static_cast<em_cmd_t *>(queue_peek(m_pending, static_cast<unsigned int>(i)));
-        if (eligible_for_active(pcmd) == true) {
-            queue_remove(m_pending, static_cast<unsigned int>(i));
-            //printf("%s:%d: Cmd: %s Orch Type: %s eligible for active\n", __func__, __LINE__, 
-                    //pcmd->get_cmd_name(), em_cmd_t::get_orch_op_str(pcmd->get_orch_op()));
-            eligible_to_move = true;
-            break;			
+        if (eligible_for_active(pcmd) == false) {
+            continue;
         }
-    }	
 
-    if (eligible_to_move == true) {
-        for (i = static_cast<int>(queue_count(pcmd->m_em_candidates)) - 1; i >= 0; i--) {
-            em = static_cast<em_t *>(queue_peek(pcmd->m_em_candidates, static_cast<unsigned int>(i)));
+        queue_remove(m_pending, static_cast<unsigned int>(i));
+        //printf("%s:%d: Cmd: %s Orch Type: %s eligible for active\n", __func__, __LINE__, 
+                //pcmd->get_cmd_name(), em_cmd_t::get_orch_op_str(pcmd->get_orch_op()));
+        for (j = static_cast<int>(queue_count(pcmd->m_em_candidates)) - 1; j >= 0; j--) {
+            em = static_cast<em_t *>(queue_peek(pcmd->m_em_candidates, static_cast<unsigned int>(j)));
             em->set_orch_state(em_orch_state_pending);
         }
 
 		// as soon as command is pushed to active start timing
 		pcmd->set_start_time();
         queue_push(m_active, pcmd);
-    } else {
-        if ((cnt = queue_count(m_pending))) {
-            pcmd = static_cast<em_cmd_t *>(queue_peek(m_pending, cnt - 1));
-            //printf("%s:%d:%d Command in pending but not eligible for active\n", __func__, __LINE__, cnt);
+
+        if (pcmd->m_fanout_job == 0) {
+            break;
         }
-    }
+    }	
 
 
     // go through active queue and check command states
@@ -387,6 +392,10 @@ void em_orch_t::handle_timeout()
         pcmd = static_cast<em_cmd_t *>(queue_peek(m_active, static_cast<unsigned int>(i)));
 		//printf("%s:%d: Cmd: %s, em candidates: %d\n", __func__, __LINE__, 
 					//em_cmd_t::get_cmd_type_str(pcmd->m_type), queue_count(pcmd->m_em_candidates));
+        // fan-out commands finish on their own, the result of the command checked before does not hold them back
+        if (pcmd->m_fanout_job != 0) {
+            ret = true;
+        }
         for (j = static_cast<int>(queue_count(pcmd->m_em_candidates)) - 1; j >= 0; j--) {
             em = static_cast<em_t *>(queue_peek(pcmd->m_em_candidates, static_cast<unsigned int>(j)));
             ret &= orchestrate(pcmd, em);
@@ -402,9 +411,13 @@ void em_orch_t::handle_timeout()
                 em = static_cast<em_t *>(queue_peek(pcmd->m_em_candidates, static_cast<unsigned int>(j)));
                 em->set_orch_state(em_orch_state_idle);
             }
+            orch_fini(pcmd);
+            fanout = (pcmd->m_fanout_job != 0);
             destroy_command(pcmd);
             //em->set_state(em_state_agent_config_complete);
-            break;
+            if (fanout == false) {
+                break;
+            }
         }
 
     }
@@ -44,6 +44,8 @@ void em_orch_ctrl_t::orch_transient(em_cmd_t *pcmd, em_t *em)
 {
     em_cmd_stats_t *stats;
     em_short_string_t key;
+    struct timeval time_now;
+    em_ctrl_t *ctrl = static_cast<em_ctrl_t *>(m_mgr);
 
     snprintf(key, sizeof(em_short_string_t), "%d", pcmd->get_type());
 
@@ -53,6 +55,19 @@ void em_orch_ctrl_t::orch_transient(em_cmd_t *pcmd, em_t *em)
 	//printf("%s:%d: Orchestration:%s(%s) state:%s, time in transient:%d\n", __func__, __LINE__, 
 		//em_cmd_t::get_orch_op_str(pcmd->get_orch_op()), em_cmd_t::get_cmd_type_str(pcmd->m_type), 
 		//em_t::state_2_str(em->get_state()), stats->time);
+
+	// a fan-out target times out alone, the other targets of the job keep running
+	if (pcmd->m_fanout_job != 0) {
+		gettimeofday(&time_now, NULL);
+		if ((time_now.tv_sec - pcmd->m_start_time.tv_sec) > EM_MAX_CMD_GEN_TTL) {
+			printf("%s:%d: Canceling cmd: %s of fan-out %u target %u because time limit exceeded\n", __func__, __LINE__,
+				pcmd->get_cmd_name(), pcmd->m_fanout_job, pcmd->m_fanout_index);
+			ctrl->get_fanout()->complete(pcmd->m_fanout_job, pcmd->m_fanout_index, em_fanout_target_timed_out);
+			pre_process_cancel(pcmd, em);
+			em->set_orch_state(em_orch_state_cancel);
+		}
+		return;
+	}
 	
 	switch (pcmd->m_type) {
 		case em_cmd_type_em_config:
@@ -248,6 +263,11 @@ void em_orch_ctrl_t::pre_process_cancel(em_cmd_t *pcmd, em_t *em)
 	em_event_t  ev;
     em_bus_event_t *bev;
     em_bus_event_type_cfg_renew_params_t    *raw;
+    em_ctrl_t *ctrl = static_cast<em_ctrl_t *>(m_mgr);
+
+	if (pcmd->m_fanout_job != 0) {
+		ctrl->get_fanout()->complete(pcmd->m_fanout_job, pcmd->m_fanout_index, em_fanout_target_failed);
+	}
 
 	switch (pcmd->get_type()) {
 		case em_cmd_type_em_config:
@@ -273,6 +293,16 @@ void em_orch_ctrl_t::pre_process_cancel(em_cmd_t *pcmd, em_t *em)
 	}
 }
 
+void em_orch_ctrl_t::orch_fini(em_cmd_t *pcmd)
+{
+    em_ctrl_t *ctrl = static_cast<em_ctrl_t *>(m_mgr);
+
+    // no-op for a target already reported canceled or timed out
+    if (pcmd->m_fanout_job != 0) {
+        ctrl->get_fanout()->complete(pcmd->m_fanout_job, pcmd->m_fanout_index, em_fanout_target_succeeded);
+    }
+}
+
 bool em_orch_ctrl_t::pre_process_orch_op(em_cmd_t *pcmd)
 {
     em_t *em;
@@ -475,9 +505,12 @@ unsigned int em_orch_ctrl_t::build_candidates(em_cmd_t *pcmd)
             
             case em_cmd_type_set_channel:
 				if (em->is_al_interface_em() == false) {
+					dm_easy_mesh_t::macbytes_to_string(em->get_radio_interface_mac(), mac_str);
 					for(i = 0; i < pcmd->m_param.u.args.num_args; i++) {
-						if(atoi(pcmd->m_param.u.args.args[i]) == em->get_band()) {
-							dm_easy_mesh_t::macbytes_to_string(em->get_radio_interface_mac(), mac_str);
+						// the channel planner targets radios, the set channel subdoc bands
+						if ((strlen(pcmd->m_param.u.args.args[i]) == EM_MAC_STR_LEN) ?
+								(strncmp(pcmd->m_param.u.args.args[i], mac_str, EM_MAC_STR_LEN) == 0):
+								(atoi(pcmd->m_param.u.args.args[i]) == em->get_band())) {
 							printf("%s:%d Set Channel : %s push to queue \n", __func__, __LINE__,mac_str);
 							queue_push(pcmd->m_em_candidates, em);
 							count++;
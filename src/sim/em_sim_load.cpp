@@ -0,0 +1,1201 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netpacket/packet.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <openssl/rand.h>
+#include <cjson/cJSON.h>
+#include "em_sim_load.h"
+#include "em_msg.h"
+#include "dm_easy_mesh.h"
+#include "util.h"
+
+static const char *em_sim_churn_str[em_sim_churn_max] = {"assoc", "roam", "metrics", "scan", "backhaul"};
+static const char *em_sim_lat_str[em_sim_lat_max] = {"autoconf", "wsc", "topo", "ack"};
+
+static unsigned char *em_sim_add_attr(unsigned char *buff, unsigned short *len, data_elem_attr_id_t id,
+        const void *val, unsigned short size)
+{
+    data_elem_attr_t *attr = reinterpret_cast<data_elem_attr_t *> (buff);
+
+    attr->id = htons(id);
+    attr->len = htons(size);
+    memcpy(attr->val, val, size);
+
+    *len = static_cast<unsigned short> (*len + sizeof(data_elem_attr_t) + size);
+    return buff + sizeof(data_elem_attr_t) + size;
+}
+
+unsigned char *em_sim_agent_t::add_header(unsigned char *buff, unsigned int *len, mac_address_t dst, em_msg_type_t type, bool relay)
+{
+    em_cmdu_t *cmdu;
+    unsigned char *tmp;
+
+    tmp = em_msg_t::add_1905_header(buff, len, dst, m_al_mac, type);
+    cmdu = reinterpret_cast<em_cmdu_t *> (tmp - sizeof(em_cmdu_t));
+    cmdu->id = htons(m_msg_id);
+    cmdu->relay_ind = (relay == true) ? 1:0;
+    m_msg_id++;
+
+    return tmp;
+}
+
+unsigned int em_sim_agent_t::create_autoconfig_search(unsigned char *buff, unsigned int radio)
+{
+    mac_address_t multi_addr = {0x01, 0x80, 0xc2, 0x00, 0x00, 0x13};
+    unsigned char value[2];
+    unsigned char *tmp;
+    unsigned int len = 0;
+
+    tmp = add_header(buff, &len, multi_addr, em_msg_type_autoconf_search, true);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_al_mac_address, m_al_mac, sizeof(mac_address_t));
+
+    value[0] = 0;    // registrar
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_searched_role, value, 1);
+
+    value[0] = static_cast<unsigned char> (m_radio[radio].band);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_autoconf_freq_band, value, 1);
+
+    value[0] = 1; value[1] = em_service_type_agent;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_supported_service, value, 2);
+
+    value[0] = 1; value[1] = em_service_type_ctrl;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_searched_service, value, 2);
+
+    value[0] = em_profile_type_3;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_profile, value, 1);
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_autoconfig_wsc_m1(unsigned char *buff, mac_address_t dst, unsigned int radio)
+{
+    unsigned char value[EM_SIM_FRAME_SZ / 2];
+    unsigned char pub[192], nonce[sizeof(em_nonce_t)], uuid[16];
+    unsigned short flags, m1_len = 0;
+    em_ap_radio_basic_cap_t *basic_cap;
+    em_op_class_t *op_class;
+    em_profile_2_ap_cap_t p2_cap;
+    em_ap_radio_advanced_cap_t adv_cap;
+    em_short_string_t dev_type;
+    char name[32];
+    unsigned char *tmp, *attr;
+    unsigned int len = 0;
+    unsigned char byte;
+
+    tmp = add_header(buff, &len, dst, em_msg_type_autoconf_wsc);
+
+    // AP radio basic capabilities 17.2.7, one operating class
+    memset(value, 0, sizeof(value));
+    basic_cap = reinterpret_cast<em_ap_radio_basic_cap_t *> (value);
+    memcpy(basic_cap->ruid, m_radio[radio].ruid, sizeof(mac_address_t));
+    basic_cap->num_bss = static_cast<unsigned char> (m_num_bss / m_num_radios);
+    basic_cap->op_class_num = 1;
+    op_class = basic_cap->op_classes;
+    op_class->op_class = m_radio[radio].op_class;
+    op_class->max_tx_eirp = 20;
+    op_class->num = 0;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_ap_radio_basic_cap, value,
+            sizeof(em_ap_radio_basic_cap_t) + sizeof(em_op_class_t));
+
+    // WSC M1, the attribute order follows em_configuration_t::create_m1_msg()
+    RAND_bytes(pub, sizeof(pub));
+    RAND_bytes(nonce, sizeof(nonce));
+    memset(uuid, 0, sizeof(uuid));
+    memcpy(uuid, m_radio[radio].ruid, sizeof(mac_address_t));
+    memset(dev_type, 0, sizeof(dev_type));
+
+    attr = value;
+    byte = 0x11;
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_version, &byte, 1);
+    byte = em_wsc_msg_type_m1;
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_msg_type, &byte, 1);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_uuid_e, uuid, sizeof(uuid));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_mac_address, m_radio[radio].ruid, sizeof(mac_address_t));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_enrollee_nonce, nonce, sizeof(nonce));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_public_key, pub, sizeof(pub));
+    flags = htons(0x0020);  // WPA2-PSK
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_auth_type_flags, &flags, sizeof(flags));
+    flags = htons(0x0008);  // AES
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_encryption_type_flags, &flags, sizeof(flags));
+    flags = htons(0x0001);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_conn_type_flags, &flags, sizeof(flags));
+    flags = htons(0x0080);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_cfg_methods, &flags, sizeof(flags));
+    byte = 0;
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_wifi_wsc_state, &byte, 1);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_manufacturer, "simulator", static_cast<unsigned short> (strlen("simulator")));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_model_name, "em_sim_load", static_cast<unsigned short> (strlen("em_sim_load")));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_model_number, "1", 1);
+    snprintf(name, sizeof(name), "SIM%08u", m_index);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_serial_num, name, static_cast<unsigned short> (strlen(name)));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_primary_device_type, dev_type, sizeof(em_short_string_t));
+    snprintf(name, sizeof(name), "sim-agent-%u", m_index);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_device_name, name, static_cast<unsigned short> (strlen(name)));
+    byte = static_cast<unsigned char> (m_radio[radio].band);
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_rf_bands, &byte, 1);
+    flags = 0;
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_assoc_state, &flags, sizeof(flags));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_device_password_id, &flags, sizeof(flags));
+    attr = em_sim_add_attr(attr, &m1_len, attr_id_cfg_error, &flags, sizeof(flags));
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_wsc, value, m1_len);
+
+    memset(&p2_cap, 0, sizeof(em_profile_2_ap_cap_t));
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_profile_2_ap_cap, reinterpret_cast<unsigned char *> (&p2_cap),
+            sizeof(em_profile_2_ap_cap_t));
+
+    memset(&adv_cap, 0, sizeof(em_ap_radio_advanced_cap_t));
+    memcpy(adv_cap.ruid, m_radio[radio].ruid, sizeof(mac_address_t));
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_ap_radio_advanced_cap, reinterpret_cast<unsigned char *> (&adv_cap),
+            sizeof(em_ap_radio_advanced_cap_t));
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_topo_resp(unsigned char *buff, mac_address_t dst, unsigned int radio)
+{
+    unsigned char value[EM_SIM_FRAME_SZ / 2];
+    em_device_info_type_t *dev_info;
+    em_local_interface_t *local_intf;
+    em_ap_op_bss_t *ap;
+    em_ap_operational_bss_t *op_bss;
+    em_bss_config_rprt_t *rprt;
+    em_bss_rprt_t *bss_rprt;
+    char ssid[32];
+    unsigned char *tmp, *ptr;
+    unsigned int len = 0, i, sz;
+
+    tmp = add_header(buff, &len, dst, em_msg_type_topo_resp);
+
+    // device information, one local interface per BSS
+    memset(value, 0, sizeof(value));
+    dev_info = reinterpret_cast<em_device_info_type_t *> (value);
+    memcpy(dev_info->al_mac_addr, m_al_mac, sizeof(mac_address_t));
+    local_intf = dev_info->local_interface;
+    for (i = 0; i < m_num_bss; i++) {
+        memcpy(local_intf->mac_addr, m_bss[i].bssid, sizeof(mac_address_t));
+        memcpy(local_intf->media_data.network_memb, m_bss[i].bssid, sizeof(mac_address_t));
+        local_intf->media_data.band = static_cast<unsigned char> (m_radio[m_bss[i].radio].band);
+        local_intf++;
+        dev_info->local_interface_num++;
+    }
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_device_info, value,
+            static_cast<unsigned int> (sizeof(em_device_info_type_t) + m_num_bss * sizeof(em_local_interface_t)));
+
+    // operational BSS of the reported radio only, as em_configuration_t does for topology
+    memset(value, 0, sizeof(value));
+    ap = reinterpret_cast<em_ap_op_bss_t *> (value);
+    ap->radios_num = 1;
+    memcpy(ap->radios[0].ruid, m_radio[radio].ruid, sizeof(mac_address_t));
+    ptr = reinterpret_cast<unsigned char *> (ap->radios[0].bss);
+    sz = static_cast<unsigned int> (sizeof(em_ap_op_bss_t) + sizeof(em_ap_op_bss_radio_t));
+    for (i = 0; i < m_num_bss; i++) {
+        if (m_bss[i].radio != radio) {
+            continue;
+        }
+        op_bss = reinterpret_cast<em_ap_operational_bss_t *> (ptr);
+        memcpy(op_bss->bssid, m_bss[i].bssid, sizeof(bssid_t));
+        snprintf(ssid, sizeof(ssid), "sim_ssid_%u", i % EM_SIM_MAX_BSS_PER_RADIO);
+        op_bss->ssid_len = static_cast<unsigned char> (strlen(ssid) + 1);
+        memcpy(op_bss->ssid, ssid, op_bss->ssid_len);
+        ap->radios[0].bss_num++;
+        ptr += sizeof(em_ap_operational_bss_t) + op_bss->ssid_len;
+        sz += static_cast<unsigned int> (sizeof(em_ap_operational_bss_t) + op_bss->ssid_len);
+    }
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_operational_bss, value, sz);
+
+    value[0] = em_profile_type_3;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_profile, value, 1);
+
+    // BSS configuration report of the same radio
+    memset(value, 0, sizeof(value));
+    rprt = reinterpret_cast<em_bss_config_rprt_t *> (value);
+    rprt->num_radios = 1;
+    memcpy(rprt->radio_rprt[0].ruid, m_radio[radio].ruid, sizeof(mac_address_t));
+    ptr = reinterpret_cast<unsigned char *> (rprt->radio_rprt[0].bss_rprt);
+    sz = static_cast<unsigned int> (sizeof(em_bss_config_rprt_t) + sizeof(em_radio_rprt_t));
+    for (i = 0; i < m_num_bss; i++) {
+        if (m_bss[i].radio != radio) {
+            continue;
+        }
+        bss_rprt = reinterpret_cast<em_bss_rprt_t *> (ptr);
+        memcpy(bss_rprt->bssid, m_bss[i].bssid, sizeof(bssid_t));
+        snprintf(ssid, sizeof(ssid), "sim_ssid_%u", i % EM_SIM_MAX_BSS_PER_RADIO);
+        bss_rprt->ssid_len = static_cast<unsigned char> (strlen(ssid) + 1);
+        memcpy(bss_rprt->ssid, ssid, bss_rprt->ssid_len);
+        rprt->radio_rprt[0].num_bss++;
+        ptr += sizeof(em_bss_rprt_t) + bss_rprt->ssid_len;
+        sz += static_cast<unsigned int> (sizeof(em_bss_rprt_t) + bss_rprt->ssid_len);
+    }
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_bss_conf_rep, value, sz);
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_topo_notif(unsigned char *buff, mac_address_t dst, const em_sim_sta_t *sta, bool assoc)
+{
+    em_client_assoc_event_t evt;
+    unsigned char *tmp;
+    unsigned int len = 0;
+
+    tmp = add_header(buff, &len, dst, em_msg_type_topo_notif);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_al_mac_address, m_al_mac, sizeof(mac_address_t));
+
+    if (sta != NULL) {
+        memset(&evt, 0, sizeof(em_client_assoc_event_t));
+        memcpy(evt.cli_mac_address, sta->mac, sizeof(mac_address_t));
+        memcpy(evt.bssid, m_bss[sta->bss].bssid, sizeof(bssid_t));
+        evt.assoc_event = (assoc == true) ? 1:0;
+        tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_client_assoc_event, reinterpret_cast<unsigned char *> (&evt),
+                sizeof(em_client_assoc_event_t));
+    }
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_ap_metrics_rsp(unsigned char *buff, unsigned int max_len, mac_address_t dst)
+{
+    unsigned char value[sizeof(em_assoc_sta_link_metrics_t) + sizeof(em_assoc_link_metrics_t)];
+    em_ap_metric_t metric;
+    em_assoc_sta_link_metrics_t *sta_metrics;
+    unsigned int len = 0, i, num_sta;
+    unsigned char *tmp;
+    size_t sta_tlv_len = sizeof(em_tlv_t) + sizeof(value);
+
+    tmp = add_header(buff, &len, dst, em_msg_type_ap_metrics_rsp);
+
+    for (i = 0; i < m_num_bss; i++) {
+        num_sta = 0;
+        for (auto& sta : m_sta) {
+            if ((sta.bss == i) && (sta.associated == true)) {
+                num_sta++;
+            }
+        }
+        memset(&metric, 0, sizeof(em_ap_metric_t));
+        memcpy(metric.bssid, m_bss[i].bssid, sizeof(bssid_t));
+        metric.channel_util = static_cast<unsigned char> ((num_sta * 7) % 256);
+        metric.num_sta = htons(static_cast<unsigned short> (num_sta));
+        metric.est_service_params_BE_bit = 1;
+        // same 13 octet encoding as em_metrics_t::create_ap_metrics_tlv()
+        tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_ap_metrics, reinterpret_cast<unsigned char *> (&metric),
+                sizeof(bssid_t) + 1 + sizeof(unsigned short) + 1 + 3);
+    }
+
+    sta_metrics = reinterpret_cast<em_assoc_sta_link_metrics_t *> (value);
+    for (auto& sta : m_sta) {
+        if (sta.associated == false) {
+            continue;
+        }
+        if ((len + sta_tlv_len + sizeof(em_tlv_t)) > max_len) {
+            break;
+        }
+        memset(value, 0, sizeof(value));
+        memcpy(sta_metrics->sta_mac, sta.mac, sizeof(mac_address_t));
+        sta_metrics->num_bssids = 1;
+        memcpy(sta_metrics->assoc_link_metrics[0].bssid, m_bss[sta.bss].bssid, sizeof(bssid_t));
+        sta_metrics->assoc_link_metrics[0].time_delta_ms = 10;
+        sta_metrics->assoc_link_metrics[0].est_mac_data_rate_dl = 300000 + sta.mac[5];
+        sta_metrics->assoc_link_metrics[0].est_mac_data_rate_ul = 100000 + sta.mac[4];
+        sta_metrics->assoc_link_metrics[0].rcpi = static_cast<unsigned char> (120 + (sta.mac[5] % 80));
+        tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_assoc_sta_link_metric, value, sizeof(value));
+    }
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_channel_scan_rprt(unsigned char *buff, mac_address_t dst, unsigned int radio)
+{
+    unsigned char value[EM_SIM_FRAME_SZ / 2];
+    em_scan_result_t *res;
+    em_channel_scan_result_t *rslt;
+    em_neighbor_t *nbr;
+    unsigned char *tmp, *ptr;
+    unsigned int len = 0, sz, i;
+    unsigned char ssid_len, time_len;
+    unsigned short param;
+
+    res = static_cast<em_scan_result_t *> (malloc(sizeof(em_scan_result_t)));
+    if (res == NULL) {
+        return 0;
+    }
+    memset(res, 0, sizeof(em_scan_result_t));
+    memcpy(res->id.scanner_mac, m_radio[radio].ruid, sizeof(mac_address_t));
+    res->id.op_class = m_radio[radio].op_class;
+    res->id.channel = m_radio[radio].channel;
+    res->id.scanner_type = em_scanner_type_radio;
+    em_simulator_t::fabricate(res, 2, m_nbr_mac_base);
+
+    tmp = add_header(buff, &len, dst, em_msg_type_channel_scan_rprt);
+
+    // Timestamp TLV 17.2.41
+    time_len = static_cast<unsigned char> (strlen(res->timestamp));
+    value[0] = time_len;
+    memcpy(&value[1], res->timestamp, time_len);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_timestamp, value, static_cast<unsigned int> (time_len + 1));
+
+    // Channel Scan Result TLV 17.2.40, encoded like em_channel_t::create_channel_scan_res_tlv()
+    rslt = reinterpret_cast<em_channel_scan_result_t *> (value);
+    memcpy(rslt->ruid, res->id.scanner_mac, sizeof(mac_address_t));
+    rslt->op_class = res->id.op_class;
+    rslt->channel = res->id.channel;
+    rslt->scan_status = res->scan_status;
+    rslt->timestamp_len = time_len;
+    memcpy(rslt->timestamp, res->timestamp, time_len);
+    ptr = value + sizeof(em_channel_scan_result_t) + time_len;
+
+    *ptr++ = res->util;
+    *ptr++ = res->noise;
+    param = htons(res->num_neighbors);
+    memcpy(ptr, &param, sizeof(unsigned short));
+    ptr += sizeof(unsigned short);
+
+    for (i = 0; i < res->num_neighbors; i++) {
+        nbr = &res->neighbor[i];
+        memcpy(ptr, nbr->bssid, sizeof(bssid_t));
+        ptr += sizeof(bssid_t);
+        ssid_len = static_cast<unsigned char> (strlen(nbr->ssid));
+        *ptr++ = ssid_len;
+        memcpy(ptr, nbr->ssid, ssid_len);
+        ptr += ssid_len;
+        *ptr++ = static_cast<unsigned char> (nbr->signal_strength);
+        *ptr++ = 2;
+        memcpy(ptr, "40", 2);
+        ptr += 2;
+        *ptr++ = nbr->bss_color;
+        *ptr++ = nbr->channel_util;
+        param = htons(nbr->sta_count);
+        memcpy(ptr, &param, sizeof(unsigned short));
+        ptr += sizeof(unsigned short);
+    }
+    memcpy(ptr, &res->aggr_scan_duration, sizeof(unsigned int));
+    ptr += sizeof(unsigned int);
+    *ptr++ = res->scan_type;
+
+    sz = static_cast<unsigned int> (ptr - value);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_channel_scan_rslt, value, sz);
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+    free(res);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_bh_steering_rsp(unsigned char *buff, mac_address_t dst, bssid_t parent)
+{
+    em_bh_steering_resp_t rsp;
+    unsigned char *tmp;
+    unsigned int len = 0;
+
+    tmp = add_header(buff, &len, dst, em_msg_type_bh_steering_rsp);
+
+    // the backhaul STA shares the AL MAC, as on single radio extenders
+    memcpy(rsp.bh_sta_mac_addr, m_al_mac, sizeof(mac_address_t));
+    memcpy(rsp.target_bssid, parent, sizeof(bssid_t));
+    rsp.result_code = 0;
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_bh_steering_rsp, reinterpret_cast<unsigned char *> (&rsp),
+            sizeof(em_bh_steering_resp_t));
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::create_1905_ack(unsigned char *buff, mac_address_t dst, unsigned short msg_id)
+{
+    em_cmdu_t *cmdu;
+    unsigned char *tmp;
+    unsigned int len = 0;
+
+    tmp = add_header(buff, &len, dst, em_msg_type_1905_ack);
+    // an ack carries the message id of the CMDU it acknowledges
+    cmdu = reinterpret_cast<em_cmdu_t *> (tmp - sizeof(em_cmdu_t));
+    cmdu->id = htons(msg_id);
+    m_msg_id--;
+
+    em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+unsigned int em_sim_agent_t::num_associated()
+{
+    unsigned int num = 0;
+
+    for (auto& sta : m_sta) {
+        if (sta.associated == true) {
+            num++;
+        }
+    }
+
+    return num;
+}
+
+em_sim_agent_t::em_sim_agent_t(unsigned int index, const em_sim_load_params_t& params)
+{
+    static const unsigned char op_class[] = {81, 128, 128};
+    static const unsigned char channel[] = {6, 36, 149};
+    unsigned int r, b, s;
+    em_sim_sta_t sta;
+
+    m_index = index;
+    m_state = em_sim_agent_state_idle;
+    m_msg_id = static_cast<unsigned short> (index << 4);
+    m_num_m2 = 0;
+
+    // 02:5a:<index>:00 AL, 02:5b:<index>:r radio, 02:5c:<index>:b BSS, 02:5d:<index16>:<sta16> STA
+    m_al_mac[0] = 0x02; m_al_mac[1] = 0x5a;
+    m_al_mac[2] = static_cast<unsigned char> ((index >> 16) & 0xff);
+    m_al_mac[3] = static_cast<unsigned char> ((index >> 8) & 0xff);
+    m_al_mac[4] = static_cast<unsigned char> (index & 0xff);
+    m_al_mac[5] = 0;
+
+    memcpy(m_nbr_mac_base, m_al_mac, sizeof(mac_address_t));
+    m_nbr_mac_base[1] = 0x5e;
+
+    m_num_radios = (params.radios_per_agent > EM_SIM_MAX_RADIOS) ? EM_SIM_MAX_RADIOS:params.radios_per_agent;
+    if (m_num_radios == 0) {
+        m_num_radios = 1;
+    }
+    m_num_bss = 0;
+
+    for (r = 0; r < m_num_radios; r++) {
+        memcpy(m_radio[r].ruid, m_al_mac, sizeof(mac_address_t));
+        m_radio[r].ruid[1] = 0x5b;
+        m_radio[r].ruid[5] = static_cast<unsigned char> (r);
+        m_radio[r].band = (r == 0) ? em_freq_band_24:em_freq_band_5;
+        m_radio[r].op_class = op_class[r];
+        m_radio[r].channel = channel[r];
+
+        for (b = 0; (b < params.bss_per_radio) && (b < EM_SIM_MAX_BSS_PER_RADIO); b++) {
+            memcpy(m_bss[m_num_bss].bssid, m_al_mac, sizeof(mac_address_t));
+            m_bss[m_num_bss].bssid[1] = 0x5c;
+            m_bss[m_num_bss].bssid[5] = static_cast<unsigned char> (m_num_bss);
+            m_bss[m_num_bss].radio = r;
+            m_num_bss++;
+        }
+    }
+
+    if (m_num_bss == 0) {
+        memcpy(m_bss[0].bssid, m_al_mac, sizeof(mac_address_t));
+        m_bss[0].bssid[1] = 0x5c;
+        m_bss[0].radio = 0;
+        m_num_bss = 1;
+    }
+
+    m_sta.reserve(params.sta_per_agent);
+    for (s = 0; s < params.sta_per_agent; s++) {
+        sta.mac[0] = 0x02; sta.mac[1] = 0x5d;
+        sta.mac[2] = static_cast<unsigned char> ((index >> 8) & 0xff);
+        sta.mac[3] = static_cast<unsigned char> (index & 0xff);
+        sta.mac[4] = static_cast<unsigned char> ((s >> 8) & 0xff);
+        sta.mac[5] = static_cast<unsigned char> (s & 0xff);
+        sta.bss = s % m_num_bss;
+        sta.associated = false;
+        m_sta.push_back(sta);
+    }
+}
+
+em_sim_agent_t::~em_sim_agent_t()
+{
+
+}
+
+unsigned long long em_sim_load_t::mac_key(const unsigned char *mac)
+{
+    unsigned long long key = 0;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(mac_address_t); i++) {
+        key = (key << 8) | mac[i];
+    }
+
+    return key;
+}
+
+long long em_sim_load_t::elapsed_us(const struct timespec *from, const struct timespec *to)
+{
+    return (static_cast<long long> (to->tv_sec - from->tv_sec) * 1000000LL) +
+            ((to->tv_nsec - from->tv_nsec) / 1000);
+}
+
+unsigned long em_sim_load_t::read_rss_kb(int pid)
+{
+    char path[64], line[256];
+    unsigned long rss = 0;
+    FILE *fp;
+
+    if (pid > 0) {
+        snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    } else {
+        snprintf(path, sizeof(path), "/proc/self/status");
+    }
+
+    if ((fp = fopen(path, "r")) == NULL) {
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, "VmRSS:", strlen("VmRSS:")) == 0) {
+            rss = strtoul(line + strlen("VmRSS:"), NULL, 10);
+            break;
+        }
+    }
+    fclose(fp);
+
+    return rss;
+}
+
+unsigned int em_sim_load_t::next_rand()
+{
+    // xorshift32, deterministic for a given seed
+    m_rand ^= m_rand << 13;
+    m_rand ^= m_rand >> 17;
+    m_rand ^= m_rand << 5;
+
+    return m_rand;
+}
+
+int em_sim_load_t::open_socket()
+{
+    struct sockaddr_ll addr_ll;
+    struct packet_mreq mreq;
+    int fd;
+
+    if ((m_ifindex = static_cast<int> (if_nametoindex(m_params.ifname))) == 0) {
+        printf("%s:%d: Unknown interface: %s\n", __func__, __LINE__, m_params.ifname);
+        return -1;
+    }
+
+    if ((fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_1905))) < 0) {
+        printf("%s:%d: Error opening socket, err:%d\n", __func__, __LINE__, errno);
+        return -1;
+    }
+
+    memset(&addr_ll, 0, sizeof(struct sockaddr_ll));
+    addr_ll.sll_family = AF_PACKET;
+    addr_ll.sll_protocol = htons(ETH_P_1905);
+    addr_ll.sll_ifindex = m_ifindex;
+
+    if (bind(fd, reinterpret_cast<struct sockaddr *> (&addr_ll), sizeof(struct sockaddr_ll)) < 0) {
+        printf("%s:%d: Error binding to interface: %s, err:%d\n", __func__, __LINE__, m_params.ifname, errno);
+        close(fd);
+        return -1;
+    }
+
+    // frames are addressed to the simulated AL MACs, not to the interface
+    memset(&mreq, 0, sizeof(struct packet_mreq));
+    mreq.mr_ifindex = m_ifindex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    if (setsockopt(fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(struct packet_mreq)) < 0) {
+        printf("%s:%d: Could not set promiscuous mode, err:%d\n", __func__, __LINE__, errno);
+    }
+
+    m_fd = fd;
+
+    return 0;
+}
+
+int em_sim_load_t::send(em_sim_agent_t *agent, unsigned char *buff, unsigned int len)
+{
+    struct sockaddr_ll sadr_ll;
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *> (buff);
+    ssize_t ret;
+
+    if (len == 0) {
+        return -1;
+    }
+
+    memset(&sadr_ll, 0, sizeof(struct sockaddr_ll));
+    sadr_ll.sll_family = AF_PACKET;
+    sadr_ll.sll_ifindex = m_ifindex;
+    sadr_ll.sll_halen = ETH_ALEN;
+    sadr_ll.sll_protocol = htons(ETH_P_1905);
+    memcpy(sadr_ll.sll_addr, hdr->dst, sizeof(mac_address_t));
+
+    ret = sendto(m_fd, buff, len, 0, reinterpret_cast<const struct sockaddr *> (&sadr_ll), sizeof(struct sockaddr_ll));
+    if (ret < 0) {
+        m_stats.tx_errors++;
+        return -1;
+    }
+
+    m_stats.tx_cmdu++;
+    m_stats.tx_bytes += len;
+
+    return 0;
+}
+
+void em_sim_load_t::expect_reply(em_sim_agent_t *agent, em_msg_type_t type, em_sim_lat_type_t kind)
+{
+    em_sim_pending_t pending;
+
+    if (agent->m_pending.find(type) != agent->m_pending.end()) {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &pending.sent);
+    pending.kind = kind;
+    agent->m_pending[type] = pending;
+}
+
+void em_sim_load_t::record_latency(em_sim_lat_type_t kind, long long us)
+{
+    em_sim_latency_t *lat = &m_stats.lat[kind];
+    unsigned long long val = (us < 0) ? 0:static_cast<unsigned long long> (us);
+    unsigned int bucket = 0;
+
+    lat->count++;
+    lat->sum_us += val;
+    if (val > lat->max_us) {
+        lat->max_us = val;
+    }
+
+    while ((bucket < (EM_SIM_LATENCY_BUCKETS - 1)) && ((1ULL << bucket) <= val)) {
+        bucket++;
+    }
+    lat->bucket[bucket]++;
+}
+
+void em_sim_load_t::expire_pending(const struct timespec *now)
+{
+    for (auto agent : m_agents) {
+        for (auto it = agent->m_pending.begin(); it != agent->m_pending.end(); ) {
+            if (elapsed_us(&it->second.sent, now) > (EM_SIM_PENDING_TOUT_MS * 1000LL)) {
+                m_stats.lat[it->second.kind].timeouts++;
+                it = agent->m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void em_sim_load_t::start_agent(em_sim_agent_t *agent)
+{
+    unsigned char buff[EM_SIM_FRAME_SZ];
+    unsigned int r;
+
+    for (r = 0; r < agent->m_num_radios; r++) {
+        send(agent, buff, agent->create_autoconfig_search(buff, r));
+    }
+    expect_reply(agent, em_msg_type_autoconf_resp, em_sim_lat_autoconf);
+    agent->m_state = em_sim_agent_state_search_sent;
+}
+
+void em_sim_load_t::agent_onboarded(em_sim_agent_t *agent)
+{
+    unsigned char buff[EM_SIM_FRAME_SZ];
+
+    agent->m_state = em_sim_agent_state_onboarded;
+    m_stats.agents_onboarded++;
+    expect_reply(agent, em_msg_type_topo_query, em_sim_lat_topo);
+
+    // clients that were waiting for the fronthaul join right away
+    for (auto& sta : agent->m_sta) {
+        sta.associated = true;
+        send(agent, buff, agent->create_topo_notif(buff, m_params.ctrl_al_mac, &sta, true));
+        m_stats.churn[em_sim_churn_assoc]++;
+    }
+}
+
+em_sim_agent_t *em_sim_load_t::pick_agent()
+{
+    em_sim_agent_t *agent;
+    unsigned int i;
+
+    if (m_stats.agents_onboarded == 0) {
+        return NULL;
+    }
+
+    for (i = 0; i < 8; i++) {
+        agent = m_agents[next_rand() % m_agents.size()];
+        if (agent->m_state == em_sim_agent_state_onboarded) {
+            return agent;
+        }
+    }
+
+    return NULL;
+}
+
+void em_sim_load_t::churn(em_sim_churn_type_t type)
+{
+    unsigned char buff[EM_SIM_FRAME_SZ];
+    em_sim_agent_t *agent, *peer;
+    em_sim_sta_t sta;
+    size_t idx;
+
+    if ((agent = pick_agent()) == NULL) {
+        return;
+    }
+
+    switch (type) {
+        case em_sim_churn_assoc:
+            if (agent->m_sta.empty() == true) {
+                return;
+            }
+            idx = next_rand() % agent->m_sta.size();
+            agent->m_sta[idx].associated = !agent->m_sta[idx].associated;
+            send(agent, buff, agent->create_topo_notif(buff, m_params.ctrl_al_mac, &agent->m_sta[idx],
+                    agent->m_sta[idx].associated));
+            break;
+
+        case em_sim_churn_roam:
+            if ((agent->m_sta.empty() == true) || ((peer = pick_agent()) == NULL) || (peer == agent)) {
+                return;
+            }
+            idx = next_rand() % agent->m_sta.size();
+            sta = agent->m_sta[idx];
+            if (sta.associated == true) {
+                send(agent, buff, agent->create_topo_notif(buff, m_params.ctrl_al_mac, &sta, false));
+            }
+            agent->m_sta.erase(agent->m_sta.begin() + static_cast<long> (idx));
+
+            sta.bss = next_rand() % peer->m_num_bss;
+            sta.associated = true;
+            peer->m_sta.push_back(sta);
+            send(peer, buff, peer->create_topo_notif(buff, m_params.ctrl_al_mac, &peer->m_sta.back(), true));
+            break;
+
+        case em_sim_churn_metrics:
+            send(agent, buff, agent->create_ap_metrics_rsp(buff, sizeof(buff), m_params.ctrl_al_mac));
+            break;
+
+        case em_sim_churn_scan:
+            send(agent, buff, agent->create_channel_scan_rprt(buff, m_params.ctrl_al_mac,
+                    next_rand() % agent->m_num_radios));
+            expect_reply(agent, em_msg_type_1905_ack, em_sim_lat_ack);
+            break;
+
+        case em_sim_churn_backhaul:
+            if (((peer = pick_agent()) == NULL) || (peer == agent)) {
+                return;
+            }
+            send(agent, buff, agent->create_bh_steering_rsp(buff, m_params.ctrl_al_mac,
+                    peer->m_bss[next_rand() % peer->m_num_bss].bssid));
+            send(agent, buff, agent->create_topo_notif(buff, m_params.ctrl_al_mac, NULL, false));
+            expect_reply(agent, em_msg_type_1905_ack, em_sim_lat_ack);
+            break;
+
+        default:
+            return;
+    }
+
+    m_stats.churn[type]++;
+}
+
+void em_sim_load_t::handle_frame(unsigned char *buff, unsigned int len)
+{
+    unsigned char out[EM_SIM_FRAME_SZ];
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *> (buff);
+    em_cmdu_t *cmdu;
+    em_sim_agent_t *agent;
+    unsigned short type, id;
+    struct timespec now;
+    unsigned int r;
+
+    if ((len < (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t))) || (hdr->type != htons(ETH_P_1905))) {
+        return;
+    }
+
+    // our own frames looped back on lo
+    if (m_agent_map.find(mac_key(hdr->src)) != m_agent_map.end()) {
+        return;
+    }
+
+    m_stats.rx_cmdu++;
+    m_stats.rx_bytes += len;
+
+    cmdu = reinterpret_cast<em_cmdu_t *> (buff + sizeof(em_raw_hdr_t));
+    type = ntohs(cmdu->type);
+    id = ntohs(cmdu->id);
+
+    if ((type == em_msg_type_autoconf_resp) && (m_params.ctrl_al_mac_known == false)) {
+        memcpy(m_params.ctrl_al_mac, hdr->src, sizeof(mac_address_t));
+        m_params.ctrl_al_mac_known = true;
+    }
+
+    auto it = m_agent_map.find(mac_key(hdr->dst));
+    if (it == m_agent_map.end()) {
+        // multicast discovery and renew are not simulated
+        m_stats.rx_unhandled++;
+        return;
+    }
+    agent = it->second;
+
+    auto pending = agent->m_pending.find(type);
+    if (pending != agent->m_pending.end()) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        record_latency(pending->second.kind, elapsed_us(&pending->second.sent, &now));
+        agent->m_pending.erase(pending);
+    }
+
+    switch (type) {
+        case em_msg_type_autoconf_resp:
+            if (agent->m_state != em_sim_agent_state_search_sent) {
+                break;
+            }
+            for (r = 0; r < agent->m_num_radios; r++) {
+                send(agent, out, agent->create_autoconfig_wsc_m1(out, hdr->src, r));
+            }
+            expect_reply(agent, em_msg_type_autoconf_wsc, em_sim_lat_wsc);
+            agent->m_state = em_sim_agent_state_m1_sent;
+            break;
+
+        case em_msg_type_autoconf_wsc:
+            if (agent->m_state != em_sim_agent_state_m1_sent) {
+                break;
+            }
+            agent->m_num_m2++;
+            if (agent->m_num_m2 < agent->m_num_radios) {
+                expect_reply(agent, em_msg_type_autoconf_wsc, em_sim_lat_wsc);
+            } else {
+                agent_onboarded(agent);
+            }
+            break;
+
+        case em_msg_type_topo_query:
+            for (r = 0; r < agent->m_num_radios; r++) {
+                send(agent, out, agent->create_topo_resp(out, hdr->src, r));
+            }
+            break;
+
+        case em_msg_type_ap_metrics_query:
+            send(agent, out, agent->create_ap_metrics_rsp(out, sizeof(out), hdr->src));
+            break;
+
+        case em_msg_type_channel_scan_req:
+            send(agent, out, agent->create_1905_ack(out, hdr->src, id));
+            for (r = 0; r < agent->m_num_radios; r++) {
+                send(agent, out, agent->create_channel_scan_rprt(out, hdr->src, r));
+            }
+            break;
+
+        case em_msg_type_map_policy_config_req:
+        case em_msg_type_bh_steering_req:
+        case em_msg_type_client_steering_req:
+        case em_msg_type_client_assoc_ctrl_req:
+            send(agent, out, agent->create_1905_ack(out, hdr->src, id));
+            break;
+
+        case em_msg_type_1905_ack:
+            break;
+
+        default:
+            m_stats.rx_unhandled++;
+            break;
+    }
+}
+
+void em_sim_load_t::receive()
+{
+    unsigned char buff[EM_SIM_FRAME_SZ + 64];
+    struct sockaddr_ll from;
+    socklen_t from_len;
+    ssize_t ret;
+
+    while (true) {
+        from_len = sizeof(struct sockaddr_ll);
+        ret = recvfrom(m_fd, buff, sizeof(buff), MSG_DONTWAIT, reinterpret_cast<struct sockaddr *> (&from), &from_len);
+        if (ret <= 0) {
+            break;
+        }
+        if (from.sll_pkttype == PACKET_OUTGOING) {
+            continue;
+        }
+        handle_frame(buff, static_cast<unsigned int> (ret));
+    }
+}
+
+void em_sim_load_t::tick(double dt)
+{
+    unsigned int i;
+
+    m_ramp_credit += m_params.ramp_rate * dt;
+    while ((m_ramp_credit >= 1.0) && (m_started < m_agents.size())) {
+        start_agent(m_agents[m_started]);
+        m_started++;
+        m_ramp_credit -= 1.0;
+    }
+
+    if (m_stats.agents_onboarded == 0) {
+        return;
+    }
+
+    for (i = 0; i < em_sim_churn_max; i++) {
+        m_credit[i] += m_params.rate[i] * dt;
+        while (m_credit[i] >= 1.0) {
+            churn(static_cast<em_sim_churn_type_t> (i));
+            m_credit[i] -= 1.0;
+        }
+    }
+}
+
+int em_sim_load_t::run()
+{
+    struct timespec start, last, now, ramp_done, last_sample;
+    struct timeval tv;
+    fd_set rset;
+    bool ramped = false;
+    unsigned long rss;
+    int rc;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    last = last_sample = ramp_done = start;
+
+    if (m_params.ctrl_pid > 0) {
+        m_stats.ctrl_rss_start_kb = m_stats.ctrl_rss_peak_kb = read_rss_kb(m_params.ctrl_pid);
+    }
+
+    while (m_exit == false) {
+        FD_ZERO(&rset);
+        FD_SET(m_fd, &rset);
+        tv.tv_sec = 0;
+        tv.tv_usec = EM_SIM_TICK_MS * 1000;
+
+        if ((rc = select(m_fd + 1, &rset, NULL, NULL, &tv)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("%s:%d: select failed, err:%d\n", __func__, __LINE__, errno);
+            break;
+        }
+
+        if ((rc > 0) && FD_ISSET(m_fd, &rset)) {
+            receive();
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (elapsed_us(&last, &now) >= (EM_SIM_TICK_MS * 1000)) {
+            tick(static_cast<double> (elapsed_us(&last, &now)) / 1000000.0);
+            last = now;
+        }
+
+        if (elapsed_us(&last_sample, &now) >= 1000000) {
+            expire_pending(&now);
+            if ((m_params.ctrl_pid > 0) && ((rss = read_rss_kb(m_params.ctrl_pid)) > m_stats.ctrl_rss_peak_kb)) {
+                m_stats.ctrl_rss_peak_kb = rss;
+            }
+            printf("%s:%d: t=%llds started:%u onboarded:%u tx:%llu rx:%llu\n", __func__, __LINE__,
+                    elapsed_us(&start, &now) / 1000000, m_started, m_stats.agents_onboarded,
+                    m_stats.tx_cmdu, m_stats.rx_cmdu);
+            last_sample = now;
+        }
+
+        if ((ramped == false) && (m_started == m_agents.size())) {
+            ramped = true;
+            ramp_done = now;
+        }
+
+        if ((ramped == true) && (elapsed_us(&ramp_done, &now) >= (static_cast<long long> (m_params.duration) * 1000000LL))) {
+            break;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    m_stats.elapsed_sec = static_cast<double> (elapsed_us(&start, &now)) / 1000000.0;
+    if (m_params.ctrl_pid > 0) {
+        m_stats.ctrl_rss_end_kb = read_rss_kb(m_params.ctrl_pid);
+    }
+    m_stats.self_rss_kb = read_rss_kb(0);
+
+    return 0;
+}
+
+static unsigned long long em_sim_percentile_us(const em_sim_latency_t *lat, double pct)
+{
+    unsigned long long target, seen = 0;
+    unsigned int i;
+
+    if (lat->count == 0) {
+        return 0;
+    }
+
+    target = static_cast<unsigned long long> (static_cast<double> (lat->count) * pct);
+    for (i = 0; i < EM_SIM_LATENCY_BUCKETS; i++) {
+        seen += lat->bucket[i];
+        if (seen > target) {
+            return 1ULL << i;
+        }
+    }
+
+    return lat->max_us;
+}
+
+void em_sim_load_t::write_json()
+{
+    cJSON *root, *obj, *lat_obj;
+    char *str;
+    FILE *fp;
+    unsigned int i;
+    em_sim_latency_t *lat;
+
+    root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "Agents", m_agents.size());
+    cJSON_AddNumberToObject(root, "AgentsOnboarded", m_stats.agents_onboarded);
+    cJSON_AddNumberToObject(root, "ElapsedSec", m_stats.elapsed_sec);
+    cJSON_AddNumberToObject(root, "TxCmdu", static_cast<double> (m_stats.tx_cmdu));
+    cJSON_AddNumberToObject(root, "RxCmdu", static_cast<double> (m_stats.rx_cmdu));
+    cJSON_AddNumberToObject(root, "TxBytes", static_cast<double> (m_stats.tx_bytes));
+    cJSON_AddNumberToObject(root, "RxBytes", static_cast<double> (m_stats.rx_bytes));
+    cJSON_AddNumberToObject(root, "TxErrors", static_cast<double> (m_stats.tx_errors));
+    cJSON_AddNumberToObject(root, "RxUnhandled", static_cast<double> (m_stats.rx_unhandled));
+    cJSON_AddNumberToObject(root, "TxCmduPerSec", static_cast<double> (m_stats.tx_cmdu) / m_stats.elapsed_sec);
+    cJSON_AddNumberToObject(root, "RxCmduPerSec", static_cast<double> (m_stats.rx_cmdu) / m_stats.elapsed_sec);
+
+    obj = cJSON_AddObjectToObject(root, "Churn");
+    for (i = 0; i < em_sim_churn_max; i++) {
+        cJSON_AddNumberToObject(obj, em_sim_churn_str[i], static_cast<double> (m_stats.churn[i]));
+    }
+
+    obj = cJSON_AddObjectToObject(root, "LatencyUs");
+    for (i = 0; i < em_sim_lat_max; i++) {
+        lat = &m_stats.lat[i];
+        lat_obj = cJSON_AddObjectToObject(obj, em_sim_lat_str[i]);
+        cJSON_AddNumberToObject(lat_obj, "Count", static_cast<double> (lat->count));
+        cJSON_AddNumberToObject(lat_obj, "Avg", (lat->count == 0) ? 0:static_cast<double> (lat->sum_us / lat->count));
+        cJSON_AddNumberToObject(lat_obj, "P50", static_cast<double> (em_sim_percentile_us(lat, 0.50)));
+        cJSON_AddNumberToObject(lat_obj, "P99", static_cast<double> (em_sim_percentile_us(lat, 0.99)));
+        cJSON_AddNumberToObject(lat_obj, "Max", static_cast<double> (lat->max_us));
+        cJSON_AddNumberToObject(lat_obj, "Timeouts", static_cast<double> (lat->timeouts));
+    }
+
+    obj = cJSON_AddObjectToObject(root, "MemoryKb");
+    cJSON_AddNumberToObject(obj, "CtrlStart", m_stats.ctrl_rss_start_kb);
+    cJSON_AddNumberToObject(obj, "CtrlPeak", m_stats.ctrl_rss_peak_kb);
+    cJSON_AddNumberToObject(obj, "CtrlEnd", m_stats.ctrl_rss_end_kb);
+    cJSON_AddNumberToObject(obj, "Generator", m_stats.self_rss_kb);
+
+    str = cJSON_Print(root);
+    if ((fp = fopen(m_params.json_path, "w")) != NULL) {
+        fputs(str, fp);
+        fclose(fp);
+    } else {
+        printf("%s:%d: Could not open %s, err:%d\n", __func__, __LINE__, m_params.json_path, errno);
+    }
+
+    cJSON_free(str);
+    cJSON_Delete(root);
+}
+
+void em_sim_load_t::report()
+{
+    unsigned int i, num_sta = 0;
+    em_sim_latency_t *lat;
+
+    for (auto agent : m_agents) {
+        num_sta += agent->num_associated();
+    }
+
+    printf("Agents: %u started, %u onboarded, %u STAs associated, %.1f s\n",
+            m_started, m_stats.agents_onboarded, num_sta, m_stats.elapsed_sec);
+    printf("CMDUs: tx %llu (%.1f/s) rx %llu (%.1f/s) tx errors %llu rx unhandled %llu\n",
+            m_stats.tx_cmdu, static_cast<double> (m_stats.tx_cmdu) / m_stats.elapsed_sec,
+            m_stats.rx_cmdu, static_cast<double> (m_stats.rx_cmdu) / m_stats.elapsed_sec,
+            m_stats.tx_errors, m_stats.rx_unhandled);
+
+    printf("Churn:");
+    for (i = 0; i < em_sim_churn_max; i++) {
+        printf(" %s %llu", em_sim_churn_str[i], m_stats.churn[i]);
+    }
+    printf("\n");
+
+    for (i = 0; i < em_sim_lat_max; i++) {
+        lat = &m_stats.lat[i];
+        printf("Latency %-8s count %llu avg %llu us p50 <%llu us p99 <%llu us max %llu us timeouts %llu\n",
+                em_sim_lat_str[i], lat->count, (lat->count == 0) ? 0:(lat->sum_us / lat->count),
+                em_sim_percentile_us(lat, 0.50), em_sim_percentile_us(lat, 0.99), lat->max_us, lat->timeouts);
+    }
+
+    if (m_params.ctrl_pid > 0) {
+        printf("Controller RSS: start %lu kB peak %lu kB end %lu kB growth %ld kB\n",
+                m_stats.ctrl_rss_start_kb, m_stats.ctrl_rss_peak_kb, m_stats.ctrl_rss_end_kb,
+                static_cast<long> (m_stats.ctrl_rss_end_kb) - static_cast<long> (m_stats.ctrl_rss_start_kb));
+    }
+    printf("Generator RSS: %lu kB\n", m_stats.self_rss_kb);
+
+    if (m_params.json_path[0] != 0) {
+        write_json();
+    }
+}
+
+int em_sim_load_t::init(const em_sim_load_params_t *params)
+{
+    em_sim_agent_t *agent;
+    unsigned int i;
+
+    memcpy(&m_params, params, sizeof(em_sim_load_params_t));
+    m_rand = (m_params.seed == 0) ? 0x2545f491:m_params.seed;
+
+    if (open_socket() != 0) {
+        return -1;
+    }
+
+    m_agents.reserve(m_params.num_agents);
+    for (i = 0; i < m_params.num_agents; i++) {
+        agent = new em_sim_agent_t(i, m_params);
+        m_agents.push_back(agent);
+        m_agent_map[mac_key(agent->m_al_mac)] = agent;
+    }
+
+    printf("%s:%d: %u agents, %u radios, %u BSS per radio, %u STAs per agent on %s\n", __func__, __LINE__,
+            m_params.num_agents, m_params.radios_per_agent, m_params.bss_per_radio, m_params.sta_per_agent,
+            m_params.ifname);
+
+    return 0;
+}
+
+em_sim_load_t::em_sim_load_t()
+{
+    memset(&m_params, 0, sizeof(em_sim_load_params_t));
+    memset(&m_stats, 0, sizeof(em_sim_load_stats_t));
+    memset(m_credit, 0, sizeof(m_credit));
+    m_fd = -1;
+    m_ifindex = 0;
+    m_rand = 0;
+    m_started = 0;
+    m_ramp_credit = 0;
+    m_exit = false;
+}
+
+em_sim_load_t::~em_sim_load_t()
+{
+    for (auto agent : m_agents) {
+        delete agent;
+    }
+
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
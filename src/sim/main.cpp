@@ -0,0 +1,157 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <getopt.h>
+#include "em_sim_load.h"
+#include "dm_easy_mesh.h"
+
+#ifdef AL_SAP
+#include "al_service_access_point.h"
+
+// em_t and em_mgr_t reference these, the load generator does not use the SAP
+AlServiceAccessPoint* g_sap;
+MacAddress g_al_mac_sap;
+#endif
+
+static em_sim_load_t g_load;
+
+static void em_sim_sig_handler(int sig)
+{
+    g_load.stop();
+}
+
+static void em_sim_usage(const char *prog)
+{
+    printf("Usage: %s -i <ifname> [options]\n", prog);
+    printf("  -i, --interface <name>   veth peer or lo shared with the controller\n");
+    printf("  -c, --ctrl-mac <mac>     controller AL MAC, learnt from the first autoconfig response if not set\n");
+    printf("  -a, --agents <n>         number of simulated agents (default 100)\n");
+    printf("  -r, --radios <n>         radios per agent, up to %d (default 2)\n", EM_SIM_MAX_RADIOS);
+    printf("  -b, --bss <n>            BSS per radio, up to %d (default 2)\n", EM_SIM_MAX_BSS_PER_RADIO);
+    printf("  -s, --stas <n>           STAs per agent (default 8)\n");
+    printf("  -d, --duration <sec>     churn phase length after the ramp (default 60)\n");
+    printf("  -R, --ramp <n>           agents started per second (default 50)\n");
+    printf("      --assoc-rate <n>     association/disassociation events per second (default 20)\n");
+    printf("      --roam-rate <n>      STA roams per second (default 5)\n");
+    printf("      --metrics-rate <n>   unsolicited AP metrics reports per second (default 10)\n");
+    printf("      --scan-rate <n>      channel scan reports per second (default 2)\n");
+    printf("      --bh-rate <n>        backhaul changes per second (default 1)\n");
+    printf("  -p, --ctrl-pid <pid>     controller process sampled for RSS growth\n");
+    printf("  -S, --seed <n>           random seed\n");
+    printf("  -j, --json <path>        write the report as JSON\n");
+}
+
+int main(int argc, char *argv[])
+{
+    static struct option long_opts[] = {
+        {"interface", required_argument, NULL, 'i'},
+        {"ctrl-mac", required_argument, NULL, 'c'},
+        {"agents", required_argument, NULL, 'a'},
+        {"radios", required_argument, NULL, 'r'},
+        {"bss", required_argument, NULL, 'b'},
+        {"stas", required_argument, NULL, 's'},
+        {"duration", required_argument, NULL, 'd'},
+        {"ramp", required_argument, NULL, 'R'},
+        {"assoc-rate", required_argument, NULL, 0x100 + em_sim_churn_assoc},
+        {"roam-rate", required_argument, NULL, 0x100 + em_sim_churn_roam},
+        {"metrics-rate", required_argument, NULL, 0x100 + em_sim_churn_metrics},
+        {"scan-rate", required_argument, NULL, 0x100 + em_sim_churn_scan},
+        {"bh-rate", required_argument, NULL, 0x100 + em_sim_churn_backhaul},
+        {"ctrl-pid", required_argument, NULL, 'p'},
+        {"seed", required_argument, NULL, 'S'},
+        {"json", required_argument, NULL, 'j'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    em_sim_load_params_t params;
+    unsigned int val;
+    int opt;
+
+    memset(&params, 0, sizeof(em_sim_load_params_t));
+    params.num_agents = 100;
+    params.radios_per_agent = 2;
+    params.bss_per_radio = 2;
+    params.sta_per_agent = 8;
+    params.duration = 60;
+    params.ramp_rate = 50;
+    params.rate[em_sim_churn_assoc] = 20;
+    params.rate[em_sim_churn_roam] = 5;
+    params.rate[em_sim_churn_metrics] = 10;
+    params.rate[em_sim_churn_scan] = 2;
+    params.rate[em_sim_churn_backhaul] = 1;
+
+    while ((opt = getopt_long(argc, argv, "i:c:a:r:b:s:d:R:p:S:j:h", long_opts, NULL)) != -1) {
+        val = (optarg != NULL) ? static_cast<unsigned int> (strtoul(optarg, NULL, 0)):0;
+        switch (opt) {
+            case 'i':
+                snprintf(params.ifname, sizeof(em_interface_name_t), "%s", optarg);
+                break;
+
+            case 'c':
+                dm_easy_mesh_t::string_to_macbytes(optarg, params.ctrl_al_mac);
+                params.ctrl_al_mac_known = true;
+                break;
+
+            case 'a': params.num_agents = val; break;
+            case 'r': params.radios_per_agent = val; break;
+            case 'b': params.bss_per_radio = val; break;
+            case 's': params.sta_per_agent = val; break;
+            case 'd': params.duration = val; break;
+            case 'R': params.ramp_rate = val; break;
+            case 'p': params.ctrl_pid = static_cast<int> (val); break;
+            case 'S': params.seed = val; break;
+
+            case 'j':
+                snprintf(params.json_path, sizeof(params.json_path), "%s", optarg);
+                break;
+
+            case 0x100 + em_sim_churn_assoc:
+            case 0x100 + em_sim_churn_roam:
+            case 0x100 + em_sim_churn_metrics:
+            case 0x100 + em_sim_churn_scan:
+            case 0x100 + em_sim_churn_backhaul:
+                params.rate[opt - 0x100] = val;
+                break;
+
+            default:
+                em_sim_usage(argv[0]);
+                return (opt == 'h') ? 0:-1;
+        }
+    }
+
+    if ((params.ifname[0] == 0) || (params.num_agents == 0)) {
+        em_sim_usage(argv[0]);
+        return -1;
+    }
+
+    signal(SIGINT, em_sim_sig_handler);
+    signal(SIGTERM, em_sim_sig_handler);
+
+    if (g_load.init(&params) != 0) {
+        return -1;
+    }
+
+    g_load.run();
+    g_load.report();
+
+    return 0;
+}
@@ -269,143 +269,159 @@ void util::em_util_print(easymesh_log_level_t level, easymesh_dbg_type_t module,
 }
 
 
-struct freq_range {
-    uint8_t op_class;
-    uint8_t min_chan;
-    uint8_t max_chan;
-    uint16_t base_freq;
-    uint16_t spacing;
-    std::string region;  // "" for global
+namespace {
+
+/*
+ * Dense lookup tables generated at compile time from em_freq_ranges with the reference scans of
+ * em_freq_table.h, so the conversions cost an index computation instead of a scan of the table.
+ *
+ * Channel to frequency: the range of each (region, operating class); the channel is then checked against it.
+ * Frequency to channel: (operating class << 8 | channel) for each region and each frequency of the windows
+ * below, 0 if none. The windows are disjoint and every channel of every range falls into one of them.
+ */
+struct freq_window_t {
+    unsigned int min;
+    unsigned int step;
+    unsigned int count;
+    unsigned int offset;
 };
 
-const std::vector<freq_range> frequency_ranges = {
-    // Global frequency ranges
-    // 2.4 GHz band
-    {81, 1, 13, 2407, 5, ""},      // channels 1-13
-    {82, 14, 14, 2414, 5, ""},     // channel 14
-    {83, 1, 13, 2407, 5, ""},      // channels 1-9; 40 MHz
-    {84, 5, 13, 2407, 5, ""},      // channels 5-13; 40 MHz
-
-    // 5 GHz band
-    {115, 36, 48, 5000, 5, ""},    // channels 36-48; indoor only
-    {116, 36, 44, 5000, 5, ""},    // channels 36,44; 40 MHz
-    {117, 40, 48, 5000, 5, ""},    // channels 40,48; 40 MHz
-    {118, 52, 64, 5000, 5, ""},    // channels 52-64; dfs
-    {119, 52, 60, 5000, 5, ""},    // channels 52,60; 40 MHz
-    {120, 56, 64, 5000, 5, ""},    // channels 56,64; 40 MHz
-    {121, 100, 140, 5000, 5, ""},  // channels 100-140
-    {122, 100, 142, 5000, 5, ""},  // channels 100-142; 40 MHz
-    {123, 104, 136, 5000, 5, ""},  // channels 104-136; 40 MHz
-    {124, 149, 161, 5000, 5, ""},  // channels 149-161
-    {125, 149, 177, 5000, 5, ""},  // channels 149-177
-    {126, 149, 173, 5000, 5, ""},  // channels 149-173; 40 MHz
-    {127, 153, 177, 5000, 5, ""},  // channels 153-177; 40 MHz
-    {128, 36, 177, 5000, 5, ""},   // 80 MHz centered on 42,58,106,122,138,155,171
-    {129, 36, 177, 5000, 5, ""},   // 160 MHz centered on 50,114,163
-    {130, 36, 177, 5000, 5, ""},   // As class 128
-
-    // 6 GHz band (UHB channels)
-    {131, 1, 233, 5950, 5, ""},    // 20 MHz
-    {132, 3, 233, 5950, 5, ""},    // 40 MHz
-    {133, 7, 233, 5950, 5, ""},    // 80 MHz
-    {134, 15, 233, 5950, 5, ""},   // 160 MHz
-    {135, 7, 233, 5950, 5, ""},    // 80+80 MHz
-    {136, 2, 2, 5935, 1, ""},      // Special case channel 2
-
-    // 60 GHz band
-    {180, 1, 8, 56160, 2160, ""},    // channels 1-8
-    {181, 9, 15, 56160, 2160, ""},   // EDMG CB2
-    {182, 17, 22, 56160, 2160, ""},  // EDMG CB3
-    {183, 25, 29, 56160, 2160, ""},  // EDMG CB4
-
-    // US region specific
-    {12, 1, 11, 2407, 5, "US"},      // 2.4 GHz channels 1-11
-    {32, 1, 7, 2407, 5, "US"},       // 2.4 GHz 40MHz channels 1-7
-    {33, 5, 11, 2407, 5, "US"},      // 2.4 GHz 40MHz channels 5-11
-    {1, 36, 48, 5000, 5, "US"},      // 5 GHz channels 36-48
-    {2, 52, 64, 5000, 5, "US"},      // 5 GHz channels 52-64
-    {4, 100, 144, 5000, 5, "US"},    // 5 GHz channels 100-144
-    {5, 149, 165, 5000, 5, "US"},    // 5 GHz channels 149-165
-    {34, 1, 8, 56160, 2160, "US"},   // 60 GHz channels 1-8
-    {37, 9, 15, 56160, 2160, "US"},  // 60 GHz EDMG CB2
-    {38, 17, 22, 56160, 2160, "US"}, // 60 GHz EDMG CB3
-    {39, 25, 29, 56160, 2160, "US"}, // 60 GHz EDMG CB4
-
-    // EU region specific
-    {4, 1, 13, 2407, 5, "EU"},       // 2.4 GHz channels 1-13
-    {11, 1, 9, 2407, 5, "EU"},       // 2.4 GHz 40MHz channels 1-9
-    {12, 5, 13, 2407, 5, "EU"},      // 2.4 GHz 40MHz channels 5-13
-    {1, 36, 48, 5000, 5, "EU"},      // 5 GHz channels 36-48
-    {2, 52, 64, 5000, 5, "EU"},      // 5 GHz channels 52-64
-    {3, 100, 140, 5000, 5, "EU"},    // 5 GHz channels 100-140
-    {17, 149, 169, 5000, 5, "EU"},   // 5 GHz channels 149-169
-    {18, 1, 6, 56160, 2160, "EU"},   // 60 GHz channels 1-6
-    {21, 9, 11, 56160, 2160, "EU"},  // 60 GHz EDMG CB2
-    {22, 17, 18, 56160, 2160, "EU"}, // 60 GHz EDMG CB3
-    {23, 25, 25, 56160, 2160, "EU"}, // 60 GHz EDMG CB4
-
-    // JP region specific
-    {30, 1, 13, 2407, 5, "JP"},      // 2.4 GHz channels 1-13
-    {31, 14, 14, 2414, 5, "JP"},     // 2.4 GHz channel 14
-    {1, 34, 64, 5000, 5, "JP"},      // 5 GHz channels 34-64
-    {32, 52, 64, 5000, 5, "JP"},     // 5 GHz channels 52-64
-    {34, 100, 140, 5000, 5, "JP"},   // 5 GHz channels 100-140
-    {59, 1, 6, 56160, 2160, "JP"},   // 60 GHz channels 1-6
-    {62, 9, 11, 56160, 2160, "JP"},  // 60 GHz EDMG CB2
-    {63, 17, 18, 56160, 2160, "JP"}, // 60 GHz EDMG CB3
-    {64, 25, 25, 56160, 2160, "JP"}, // 60 GHz EDMG CB4
-
-    // CN region specific
-    {7, 1, 13, 2407, 5, "CN"},       // 2.4 GHz channels 1-13
-    {8, 1, 9, 2407, 5, "CN"},        // 2.4 GHz 40MHz channels 1-9
-    {9, 5, 13, 2407, 5, "CN"},       // 2.4 GHz 40MHz channels 5-13
-    {1, 36, 48, 5000, 5, "CN"},      // 5 GHz channels 36-48
-    {2, 52, 64, 5000, 5, "CN"},      // 5 GHz channels 52-64
-    {3, 149, 165, 5000, 5, "CN"},    // 5 GHz channels 149-165
-    {6, 149, 157, 5000, 5, "CN"}     // 5 GHz 40MHz channels 149,157
+constexpr freq_window_t freq_windows[] = {
+    {2407, 1, 78, 0},           // 2.4 GHz, 1 MHz steps for channel 14 (2484 MHz)
+    {5000, 5, 424, 78},         // 5 GHz and 6 GHz
+    {5936, 1, 4, 502},          // Operating class 136 (base 5935, 1 MHz spacing)
+    {56160, 2160, 30, 506},     // 60 GHz
 };
+constexpr unsigned int freq_window_entries = 536;
 
-int util::em_chan_to_freq(uint8_t op_class, uint8_t channel, const std::string& region) {
-    for (const auto& range : frequency_ranges) {
-        if ((range.region.empty() || range.region == region) && 
-            range.op_class == op_class &&
-            channel >= range.min_chan && 
-            channel <= range.max_chan) {
-            return range.base_freq + (channel * range.spacing);
+struct freq_tables_t {
+    uint8_t range_of_class[em_freq_region_max][256];    // index + 1 into em_freq_ranges, 0 if none
+    uint16_t op_chan[em_freq_region_max][freq_window_entries];
+};
+
+constexpr bool range_in_region(const em_freq_range_t& range, size_t region)
+{
+    return range.region == em_freq_region_global || range.region == static_cast<em_freq_region_t>(region);
+}
+
+constexpr freq_tables_t build_freq_tables()
+{
+    freq_tables_t t = {};
+
+    for (size_t region = 0; region < em_freq_region_max; region++) {
+        for (size_t i = em_freq_ranges_count; i > 0; i--) {
+            // Walk backwards so the first range of an operating class wins, as in scan_chan_to_freq()
+            if (range_in_region(em_freq_ranges[i - 1], region)) {
+                t.range_of_class[region][em_freq_ranges[i - 1].op_class] = static_cast<uint8_t>(i);
+            }
+        }
+
+        for (const freq_window_t& w : freq_windows) {
+            for (unsigned int i = 0; i < w.count; i++) {
+                auto op_chan = em_freq_table::scan_freq_to_chan(w.min + i * w.step, static_cast<em_freq_region_t>(region));
+                t.op_chan[region][w.offset + i] = static_cast<uint16_t>((op_chan.first << 8) | op_chan.second);
+            }
+        }
+    }
+    return t;
+}
+
+constexpr int freq_window_index(unsigned int freq)
+{
+    for (const freq_window_t& w : freq_windows) {
+        if (freq >= w.min && (freq - w.min) % w.step == 0 && (freq - w.min) / w.step < w.count) {
+            return static_cast<int>(w.offset + (freq - w.min) / w.step);
         }
     }
     return -1;
 }
 
-std::pair<uint8_t, uint8_t> util::em_freq_to_chan(unsigned int frequency, const std::string& region) {
-    std::pair<uint8_t, uint8_t> global_result;
-    
-    for (const auto& range : frequency_ranges) {
-        unsigned int min_freq = static_cast<unsigned int>(range.base_freq + (range.min_chan * range.spacing));
-        unsigned int max_freq = static_cast<unsigned int>(range.base_freq + (range.max_chan * range.spacing));
-        
-        if (frequency < min_freq || frequency > max_freq) continue;
-        
-        if ((frequency - range.base_freq) % range.spacing != 0) continue;
-        
-        // Calculate channel number and validate it's within uint8_t/channel range
-        unsigned int channel_calc = (frequency - range.base_freq) / range.spacing;
-        if (channel_calc < range.min_chan || channel_calc > range.max_chan) continue;
-        
-        uint8_t channel = static_cast<uint8_t>(channel_calc);
-        
-        // Frequency is within range, return op class and channel
-        auto result = std::make_pair(range.op_class, channel);
-        if (range.region == region) return result;
-        
-        // Save global result if no region-specific match
-        if (range.region.empty()) {
-            global_result = result;
+// An operating class must have a single range per region for range_of_class to be exact
+constexpr bool freq_classes_unique()
+{
+    for (size_t region = 0; region < em_freq_region_max; region++) {
+        for (size_t i = 0; i < em_freq_ranges_count; i++) {
+            for (size_t j = i + 1; j < em_freq_ranges_count; j++) {
+                if (range_in_region(em_freq_ranges[i], region) && range_in_region(em_freq_ranges[j], region) &&
+                    em_freq_ranges[i].op_class == em_freq_ranges[j].op_class) {
+                    return false;
+                }
+            }
         }
     }
-    
-    // No region-specific match was found, return global result if available
-    return global_result;
+    return true;
+}
+
+constexpr bool freq_windows_cover_ranges()
+{
+    for (size_t i = 0; i < em_freq_ranges_count; i++) {
+        for (unsigned int chan = em_freq_ranges[i].min_chan; chan <= em_freq_ranges[i].max_chan; chan++) {
+            if (freq_window_index(em_freq_ranges[i].base_freq + chan * em_freq_ranges[i].spacing) < 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr bool freq_windows_packed()
+{
+    unsigned int offset = 0;
+    for (const freq_window_t& w : freq_windows) {
+        if (w.offset != offset) return false;
+        offset += w.count;
+    }
+    return offset == freq_window_entries;
+}
+
+static_assert(em_freq_ranges_count < 0xff, "range_of_class holds range indices in a uint8_t");
+static_assert(freq_classes_unique(), "an operating class has more than one range in a region");
+static_assert(freq_windows_packed(), "frequency windows overlap in the lookup table");
+static_assert(freq_windows_cover_ranges(), "a channel frequency falls outside the frequency lookup windows");
+
+constexpr freq_tables_t freq_tables = build_freq_tables();
+
+}
+
+em_freq_region_t util::em_freq_region(const std::string& region)
+{
+    if (region.empty()) return em_freq_region_global;
+    if (region == "US") return em_freq_region_us;
+    if (region == "EU") return em_freq_region_eu;
+    if (region == "JP") return em_freq_region_jp;
+    if (region == "CN") return em_freq_region_cn;
+    return em_freq_region_other;
+}
+
+int util::em_chan_to_freq(uint8_t op_class, uint8_t channel, em_freq_region_t region)
+{
+    if (region >= em_freq_region_max) return -1;
+
+    uint8_t idx = freq_tables.range_of_class[region][op_class];
+    if (idx == 0) return -1;
+
+    const em_freq_range_t& range = em_freq_ranges[idx - 1];
+    if (channel < range.min_chan || channel > range.max_chan) return -1;
+    return range.base_freq + (channel * range.spacing);
+}
+
+int util::em_chan_to_freq(uint8_t op_class, uint8_t channel, const std::string& region) {
+    return em_chan_to_freq(op_class, channel, em_freq_region(region));
+}
+
+std::pair<uint8_t, uint8_t> util::em_freq_to_chan(unsigned int frequency, em_freq_region_t region)
+{
+    if (region >= em_freq_region_max) return {0, 0};
+
+    int idx = freq_window_index(frequency);
+    if (idx < 0) return {0, 0};
+
+    uint16_t op_chan = freq_tables.op_chan[region][idx];
+    return std::make_pair(static_cast<uint8_t>(op_chan >> 8), static_cast<uint8_t>(op_chan & 0xff));
+}
+
+std::pair<uint8_t, uint8_t> util::em_freq_to_chan(unsigned int frequency, const std::string& region) {
+    return em_freq_to_chan(frequency, em_freq_region(region));
 }
 
 std::vector<std::string> util::split_by_delim(const std::string& s, char delimiter) {
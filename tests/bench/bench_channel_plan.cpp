@@ -0,0 +1,179 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+
+#include "em_channel_planner.h"
+#include "bench_common.h"
+
+namespace {
+
+/**
+ * A dense deployment: APs on a square grid with one 5 GHz radio each, all starting on channel 36.
+ * Every radio reports a scan of its channel hearing the APs up to two grid steps away and a few
+ * neighbours outside the mesh.
+ */
+struct bench_plan_env_t {
+    unsigned int side;
+    std::vector<em_op_class_info_t> op_classes;     // per AP: current, then the capabilities
+    std::vector<em_scan_result_t> scans;
+};
+
+const unsigned int bench_plan_caps[] = {115, 118, 121, 124, 116, 122, 128};
+const unsigned int bench_plan_num_ops = 1 + sizeof(bench_plan_caps) / sizeof(bench_plan_caps[0]);
+
+void env_init(bench_plan_env_t& env, unsigned int num_aps)
+{
+    unsigned int ap, i, n, x, y, nx, ny, dist;
+    em_op_class_info_t *info;
+    em_scan_result_t *res;
+    em_neighbor_t *nbr;
+    mac_address_t ruid;
+
+    for (env.side = 1; (env.side * env.side) < num_aps; env.side++);
+    env.op_classes.assign(num_aps * bench_plan_num_ops, em_op_class_info_t());
+    env.scans.assign(num_aps, em_scan_result_t());
+
+    for (ap = 0; ap < num_aps; ap++) {
+        bench_dm_gen_t::make_mac(ruid, bench_mac_kind_radio, ap);
+
+        info = &env.op_classes[ap * bench_plan_num_ops];
+        memset(info, 0, bench_plan_num_ops * sizeof(em_op_class_info_t));
+        for (i = 0; i < bench_plan_num_ops; i++) {
+            memcpy(info[i].id.ruid, ruid, sizeof(mac_address_t));
+            info[i].id.type = (i == 0) ? em_op_class_type_current:em_op_class_type_capability;
+            info[i].op_class = (i == 0) ? 115:bench_plan_caps[i - 1];
+            info[i].id.op_class = info[i].op_class;
+        }
+        info[0].channel = 36;
+
+        res = &env.scans[ap];
+        memset(res, 0, sizeof(em_scan_result_t));
+        memcpy(res->id.scanner_mac, ruid, sizeof(mac_address_t));
+        res->id.op_class = 115;
+        res->id.channel = 36;
+        res->util = 120;
+
+        x = ap % env.side;
+        y = ap / env.side;
+        n = 0;
+        for (i = 0; (i < num_aps) && (n < (EM_MAX_NEIGHBORS - 3)); i++) {
+            nx = i % env.side;
+            ny = i / env.side;
+            dist = ((nx > x) ? (nx - x):(x - nx)) + ((ny > y) ? (ny - y):(y - ny));
+            if ((i == ap) || (dist > 2)) {
+                continue;
+            }
+            nbr = &res->neighbor[n++];
+            bench_dm_gen_t::make_mac(nbr->bssid, bench_mac_kind_bss, i);
+            nbr->signal_strength = static_cast<signed char> (-50 - 12 * static_cast<int> (dist));
+            nbr->bandwidth = WIFI_CHANNELBANDWIDTH_20MHZ;
+            nbr->channel_util = 100;
+        }
+        for (i = 0; i < 3; i++) {
+            nbr = &res->neighbor[n++];
+            bench_dm_gen_t::make_mac(nbr->bssid, bench_mac_kind_sta, ap * 3 + i);
+            nbr->signal_strength = static_cast<signed char> (-60 - 10 * static_cast<int> (i));
+            nbr->bandwidth = WIFI_CHANNELBANDWIDTH_80MHZ;
+            nbr->channel_util = 200;
+        }
+        res->num_neighbors = static_cast<unsigned short> (n);
+    }
+}
+
+void sync(em_channel_planner_t& planner, bench_plan_env_t& env)
+{
+    const em_op_class_info_t *ops[bench_plan_num_ops];
+    mac_address_t al_mac, bssid;
+    unsigned int ap, i;
+
+    planner.begin_sync();
+    for (ap = 0; ap < env.scans.size(); ap++) {
+        for (i = 0; i < bench_plan_num_ops; i++) {
+            ops[i] = &env.op_classes[ap * bench_plan_num_ops + i];
+        }
+        bench_dm_gen_t::make_mac(al_mac, bench_mac_kind_agent, ap);
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, ap);
+        planner.observe_radio(env.scans[ap].id.scanner_mac, al_mac, ops, bench_plan_num_ops);
+        planner.observe_bss(bssid, env.scans[ap].id.scanner_mac);
+    }
+    planner.end_sync();
+}
+
+int apply_moves(const em_chan_plan_move_t *moves, unsigned int num)
+{
+    benchmark::DoNotOptimize(moves);
+    return 0;
+}
+
+} // namespace
+
+// One scan report changes, then a planning pass: the steady state cost per report
+static void BM_ChannelPlanIncremental(benchmark::State& state)
+{
+    bench_plan_env_t env;
+    unsigned int ap = 0, i;
+
+    env_init(env, static_cast<unsigned int> (state.range(0)));
+    em_channel_planner_t planner(apply_moves);
+
+    sync(planner, env);
+    for (i = 0; i < env.scans.size(); i++) {
+        planner.update_scan_result(&env.scans[i]);
+    }
+    for (i = 0; i < 8; i++) {
+        planner.run();
+    }
+
+    for (auto _ : state) {
+        em_scan_result_t *res = &env.scans[ap];
+        res->neighbor[res->num_neighbors - 1].channel_util ^= 0x40;
+        planner.update_scan_result(res);
+        benchmark::DoNotOptimize(planner.run());
+        ap = (ap + 1) % static_cast<unsigned int> (env.scans.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+    state.SetLabel(std::to_string(planner.get_stats()->num_edges) + " edges");
+}
+BENCHMARK(BM_ChannelPlanIncremental)->Arg(100)->Arg(300);
+
+// The same change handled by planning the whole network from scratch
+static void BM_ChannelPlanFullRebuild(benchmark::State& state)
+{
+    bench_plan_env_t env;
+    unsigned int ap = 0, i;
+
+    env_init(env, static_cast<unsigned int> (state.range(0)));
+
+    for (auto _ : state) {
+        em_channel_planner_t planner(apply_moves);
+        em_scan_result_t *res = &env.scans[ap];
+        res->neighbor[res->num_neighbors - 1].channel_util ^= 0x40;
+
+        sync(planner, env);
+        for (i = 0; i < env.scans.size(); i++) {
+            planner.update_scan_result(&env.scans[i]);
+        }
+        benchmark::DoNotOptimize(planner.run());
+        ap = (ap + 1) % static_cast<unsigned int> (env.scans.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_ChannelPlanFullRebuild)->Arg(100)->Arg(300);
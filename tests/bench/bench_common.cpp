@@ -0,0 +1,104 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench_common.h"
+
+void bench_dm_gen_t::make_mac(mac_address_t mac, bench_mac_kind_t kind, unsigned int index)
+{
+    mac[0] = 0x02;
+    mac[1] = static_cast<unsigned char> (kind);
+    mac[2] = static_cast<unsigned char> ((index >> 24) & 0xff);
+    mac[3] = static_cast<unsigned char> ((index >> 16) & 0xff);
+    mac[4] = static_cast<unsigned char> ((index >> 8) & 0xff);
+    mac[5] = static_cast<unsigned char> (index & 0xff);
+}
+
+void bench_dm_gen_t::fill_agent(dm_easy_mesh_t *dm, const bench_topology_t& topo, unsigned int agent)
+{
+    unsigned int r, b, radios, bss_per_radio;
+    em_radio_info_t *radio;
+    em_bss_info_t *bss;
+    mac_address_t dev_mac;
+
+    radios = (topo.radios_per_agent > EM_MAX_BANDS) ? EM_MAX_BANDS : topo.radios_per_agent;
+    bss_per_radio = topo.bss_per_radio;
+    if ((radios * bss_per_radio) > EM_MAX_BSSS) {
+        bss_per_radio = EM_MAX_BSSS / radios;
+    }
+
+    memcpy(dev_mac, dm->m_device.m_device_info.intf.mac, sizeof(mac_address_t));
+    memcpy(dm->m_device.m_device_info.id.dev_mac, dev_mac, sizeof(mac_address_t));
+    snprintf(dm->m_device.m_device_info.manufacturer, sizeof(dm->m_device.m_device_info.manufacturer), "bench");
+
+    dm->m_num_radios = 0;
+    dm->m_num_bss = 0;
+
+    for (r = 0; r < radios; r++) {
+        radio = &dm->m_radio[r].m_radio_info;
+        memset(radio, 0, sizeof(em_radio_info_t));
+        snprintf(radio->id.net_id, sizeof(radio->id.net_id), "%s", BENCH_NET_ID);
+        memcpy(radio->id.dev_mac, dev_mac, sizeof(mac_address_t));
+        make_mac(radio->intf.mac, bench_mac_kind_radio, agent * EM_MAX_BANDS + r);
+        memcpy(radio->id.ruid, radio->intf.mac, sizeof(mac_address_t));
+        memcpy(dm->m_radio_cap[r].m_radio_cap_info.ruid.mac, radio->intf.mac, sizeof(mac_address_t));
+        snprintf(radio->intf.name, sizeof(radio->intf.name), "wlan%u", r);
+        radio->enabled = true;
+        radio->band = static_cast<em_freq_band_t> (r % em_freq_band_60);
+        radio->number_of_bss = bss_per_radio;
+        dm->m_num_radios++;
+
+        for (b = 0; b < bss_per_radio; b++) {
+            bss = &dm->m_bss[dm->m_num_bss].m_bss_info;
+            memset(bss, 0, sizeof(em_bss_info_t));
+            snprintf(bss->id.net_id, sizeof(bss->id.net_id), "%s", BENCH_NET_ID);
+            memcpy(bss->id.dev_mac, dev_mac, sizeof(mac_address_t));
+            memcpy(bss->id.ruid, radio->intf.mac, sizeof(mac_address_t));
+            make_mac(bss->bssid.mac, bench_mac_kind_bss, (agent * EM_MAX_BSSS) + dm->m_num_bss);
+            memcpy(bss->id.bssid, bss->bssid.mac, sizeof(mac_address_t));
+            memcpy(bss->ruid.mac, radio->intf.mac, sizeof(mac_address_t));
+            snprintf(bss->ssid, sizeof(bss->ssid), "bench_ssid_%u", b);
+            bss->enabled = true;
+            bss->id.haul_type = em_haul_type_fronthaul;
+            dm->m_num_bss++;
+        }
+    }
+}
+
+void bench_dm_gen_t::fill_sta(em_sta_info_t *info, bssid_t bssid, mac_address_t ruid, unsigned int seed)
+{
+    memset(info, 0, sizeof(em_sta_info_t));
+    make_mac(info->id, bench_mac_kind_sta, seed);
+    memcpy(info->bssid, bssid, sizeof(bssid_t));
+    memcpy(info->radiomac, ruid, sizeof(mac_address_t));
+    info->associated = true;
+    info->last_ul_rate = 100000 + (seed % 1000);
+    info->last_dl_rate = 200000 + (seed % 1000);
+    info->est_ul_rate = info->last_ul_rate;
+    info->est_dl_rate = info->last_dl_rate;
+    info->last_conn_time = seed % 3600;
+    info->signal_strength = -40 - static_cast<signed int> (seed % 50);
+    info->rcpi = static_cast<unsigned char> (220 - (seed % 100));
+    info->pkts_tx = seed * 3;
+    info->pkts_rx = seed * 2;
+    info->bytes_tx = seed * 1500;
+    info->bytes_rx = seed * 1000;
+    info->frame_body_len = 64;
+    memset(info->frame_body, static_cast<int> (seed & 0xff), info->frame_body_len);
+}
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "em_base.h"
+#include "em_mgr.h"
+#include "dm_easy_mesh.h"
+#include "dm_easy_mesh_ctrl.h"
+
+#define BENCH_NET_ID    "OneWifiMesh"
+
+/**
+ * @brief Shape of a synthetic network used by the benchmarks.
+ *
+ * Every agent gets @p radios_per_agent radios, every radio @p bss_per_radio BSSs and
+ * every BSS @p sta_per_bss associated STAs. All MAC addresses are locally administered
+ * and derived from the element index so repeated runs produce identical topologies.
+ */
+typedef struct {
+    unsigned int num_agents;
+    unsigned int radios_per_agent;
+    unsigned int bss_per_radio;
+    unsigned int sta_per_bss;
+} bench_topology_t;
+
+typedef enum {
+    bench_mac_kind_agent = 0xa0,
+    bench_mac_kind_radio,
+    bench_mac_kind_bss,
+    bench_mac_kind_sta,
+} bench_mac_kind_t;
+
+class bench_dm_gen_t {
+public:
+
+	/**!
+	 * @brief Derive a deterministic, locally administered MAC address.
+	 *
+	 * @param[out] mac Output MAC address.
+	 * @param[in] kind Element kind, stored in the second octet.
+	 * @param[in] index Element index, stored big-endian in the last four octets.
+	 */
+	static void make_mac(mac_address_t mac, bench_mac_kind_t kind, unsigned int index);
+
+	/**!
+	 * @brief Total number of STAs the topology expands to.
+	 */
+	static unsigned int num_stas(const bench_topology_t& topo) {
+		return topo.num_agents * topo.radios_per_agent * topo.bss_per_radio * topo.sta_per_bss;
+	}
+
+	/**!
+	 * @brief Fill one agent data model with radios and BSSs.
+	 *
+	 * @param[in,out] dm Data model created for the agent.
+	 * @param[in] topo Topology shape.
+	 * @param[in] agent Agent index.
+	 */
+	static void fill_agent(dm_easy_mesh_t *dm, const bench_topology_t& topo, unsigned int agent);
+
+	/**!
+	 * @brief Fill a STA info with values that look like a live association.
+	 */
+	static void fill_sta(em_sta_info_t *info, bssid_t bssid, mac_address_t ruid, unsigned int seed);
+
+	/**!
+	 * @brief Populate a list based data model (controller or plain list) with the topology.
+	 *
+	 * Works with dm_easy_mesh_list_t and dm_easy_mesh_ctrl_t, both of which expose
+	 * create_data_model() and put_sta().
+	 */
+	template <class T>
+	static void populate(T& list, const bench_topology_t& topo) {
+		em_interface_t al_intf;
+		dm_easy_mesh_t *dm;
+		dm_sta_t sta;
+		em_long_string_t key;
+		mac_addr_str_t sta_str, bss_str, radio_str;
+		unsigned int a, r, b, s, sta_index = 0;
+
+		for (a = 0; a < topo.num_agents; a++) {
+			memset(&al_intf, 0, sizeof(em_interface_t));
+			make_mac(al_intf.mac, bench_mac_kind_agent, a);
+			snprintf(al_intf.name, sizeof(al_intf.name), "bench%u", a);
+			if ((dm = list.create_data_model(BENCH_NET_ID, &al_intf, em_profile_type_3)) == NULL) {
+				continue;
+			}
+			fill_agent(dm, topo, a);
+
+			for (r = 0; r < dm->m_num_radios; r++) {
+				for (b = 0; b < dm->m_num_bss; b++) {
+					if (memcmp(dm->m_bss[b].m_bss_info.ruid.mac, dm->m_radio[r].m_radio_info.intf.mac, sizeof(mac_address_t)) != 0) {
+						continue;
+					}
+					for (s = 0; s < topo.sta_per_bss; s++) {
+						fill_sta(&sta.m_sta_info, dm->m_bss[b].m_bss_info.bssid.mac,
+								dm->m_radio[r].m_radio_info.intf.mac, sta_index);
+						snprintf(key, sizeof(em_long_string_t), "%s@%s@%s",
+								dm_easy_mesh_t::macbytes_to_string(sta.m_sta_info.id, sta_str),
+								dm_easy_mesh_t::macbytes_to_string(sta.m_sta_info.bssid, bss_str),
+								dm_easy_mesh_t::macbytes_to_string(sta.m_sta_info.radiomac, radio_str));
+						list.put_sta(key, &sta);
+						sta_index++;
+					}
+				}
+			}
+		}
+	}
+};
+
+/**
+ * @brief Minimal manager that only exposes the event queue.
+ *
+ * Every protocol/data model hook is a no-op so that the queue can be exercised
+ * without sockets, bus or database.
+ */
+class bench_mgr_t : public em_mgr_t {
+public:
+	unsigned int m_handled;
+
+	bool is_data_model_initialized() { return true; }
+	em_t *find_em_for_msg_type(unsigned char *data, unsigned int len, em_t *al_em) { return NULL; }
+	int data_model_init(const char *data_model_path) { return 0; }
+	int orch_init() { return 0; }
+	void input_listener() { }
+	void start_complete() { }
+	void handle_event(em_event_t *evt) { m_handled++; }
+	void handle_5s_tick() { }
+	void handle_2s_tick() { }
+	void handle_1s_tick() { }
+	void handle_500ms_tick() { }
+	void io(void *data, bool input = true) { }
+	void update_network_topology() { }
+	dm_easy_mesh_t *get_data_model(const char *net_id, const unsigned char *al_mac = NULL) { return NULL; }
+	dm_easy_mesh_t *create_data_model(const char *net_id, const em_interface_t *al_intf, em_profile_type_t profile = em_profile_type_3) { return NULL; }
+	void delete_data_model(const char *net_id, const unsigned char *al_mac) { }
+	void delete_all_data_models() { }
+	int update_tables(dm_easy_mesh_t *dm) { return 0; }
+	int load_net_ssid_table() { return 0; }
+	void debug_probe() { }
+	em_service_type_t get_service_type() { return em_service_type_ctrl; }
+
+	bench_mgr_t() : m_handled(0) { }
+	virtual ~bench_mgr_t() { }
+};
+
+/**
+ * @brief Counters kept by the in-memory db_client_t stand-in (bench_db_client_stub.cpp).
+ */
+typedef struct {
+    unsigned long long num_queries;
+    unsigned long long query_bytes;
+} bench_db_stats_t;
+
+extern bench_db_stats_t g_bench_db_stats;
+
+/**
+ * @brief Result set the db_client_t stand-in serves to every select while it is set.
+ *
+ * Rows of @p num_cols text values, as the MariaDB client returns them. The stand-in builds
+ * @p cells and @p lengths from @p values on first use.
+ */
+typedef struct {
+    unsigned int num_cols;
+    std::vector<std::string> values;    // row major
+    std::vector<const char *> cells;
+    std::vector<unsigned long> lengths;
+} bench_db_result_t;
+
+extern bench_db_result_t *g_bench_db_result;
+
+/**
+ * @brief Controller data model populated from the benchmark range arguments.
+ *
+ * range(0) is the number of agents, every agent has 3 radios with 2 BSSs each and
+ * range(1) STAs per BSS. The controller is initialized against the db_client_t stand-in.
+ */
+class bench_ctrl_fixture_t : public benchmark::Fixture {
+public:
+    bench_mgr_t m_mgr;
+    dm_easy_mesh_ctrl_t *m_ctrl = NULL;
+    db_client_t m_db;
+    bench_topology_t m_topo;
+
+    void SetUp(const benchmark::State& state) override {
+        m_topo.num_agents = static_cast<unsigned int> (state.range(0));
+        m_topo.radios_per_agent = 3;
+        m_topo.bss_per_radio = 2;
+        m_topo.sta_per_bss = static_cast<unsigned int> (state.range(1));
+
+        m_ctrl = new dm_easy_mesh_ctrl_t();
+        // an empty stand-in database makes load_tables() report a reset is needed, which is fine here
+        m_ctrl->init("bench@bench", &m_mgr);
+        bench_dm_gen_t::populate(*m_ctrl, m_topo);
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        m_ctrl->delete_all_data_models();
+        delete m_ctrl;
+        m_ctrl = NULL;
+    }
+};
+
+#define BENCH_TOPOLOGY_ARGS ->Args({4, 8})->Args({16, 8})->Args({64, 8})->Args({64, 32})
+
+#endif
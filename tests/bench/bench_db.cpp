@@ -0,0 +1,230 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <string>
+
+#include "dm_easy_mesh_ctrl.h"
+#include "bench_common.h"
+
+namespace {
+
+// STAList rows of every STA of the data model, formatted as dm_sta_list_t::update_db() writes them
+void dump_sta_rows(dm_easy_mesh_ctrl_t& ctrl, bench_db_result_t& res)
+{
+    dm_sta_t *sta;
+    em_sta_info_t *info;
+    mac_addr_str_t mac;
+    char frame_body[EM_MAX_FRAME_BODY_LEN*2];
+
+    res.num_cols = 22;
+    res.values.clear();
+    for (sta = ctrl.get_first_sta(); sta != NULL; sta = ctrl.get_next_sta(sta)) {
+        info = sta->get_sta_info();
+        res.values.push_back(dm_easy_mesh_t::macbytes_to_string(info->id, mac));
+        res.values.push_back(dm_easy_mesh_t::macbytes_to_string(info->bssid, mac));
+        res.values.push_back(dm_easy_mesh_t::macbytes_to_string(info->radiomac, mac));
+        res.values.push_back(std::to_string(info->associated));
+        res.values.push_back(std::to_string(info->last_ul_rate));
+        res.values.push_back(std::to_string(info->last_dl_rate));
+        res.values.push_back(std::to_string(info->est_ul_rate));
+        res.values.push_back(std::to_string(info->est_dl_rate));
+        res.values.push_back(std::to_string(info->last_conn_time));
+        res.values.push_back(std::to_string(info->retrans_count));
+        res.values.push_back(std::to_string(info->signal_strength));
+        res.values.push_back(std::to_string(info->rcpi));
+        res.values.push_back(std::to_string(info->util_tx));
+        res.values.push_back(std::to_string(info->util_rx));
+        res.values.push_back(std::to_string(info->pkts_tx));
+        res.values.push_back(std::to_string(info->pkts_rx));
+        res.values.push_back(std::to_string(info->bytes_tx));
+        res.values.push_back(std::to_string(info->bytes_rx));
+        res.values.push_back(std::to_string(info->errors_tx));
+        res.values.push_back(std::to_string(info->errors_rx));
+        res.values.push_back(std::to_string(info->frame_body_len));
+        dm_easy_mesh_t::hex(info->frame_body_len, info->frame_body, sizeof(frame_body), frame_body);
+        res.values.push_back(frame_body);
+    }
+}
+
+// The STAList loader as it was before db_row_t: a copy and a sscanf() or atoi() per column
+int sync_sta_per_column(dm_easy_mesh_ctrl_t& ctrl, db_client_t& db_client)
+{
+    em_sta_info_t info;
+    mac_addr_str_t mac;
+    char frame_body[EM_MAX_FRAME_BODY_LEN*2];
+    void *ctx = db_client.execute("select * from STAList");
+
+    while (db_client.next_result(ctx)) {
+        memset(&info, 0, sizeof(em_sta_info_t));
+
+        db_client.get_string(ctx, mac, 1);
+        dm_easy_mesh_t::string_to_macbytes(mac, info.id);
+        db_client.get_string(ctx, mac, 2);
+        dm_easy_mesh_t::string_to_macbytes(mac, info.bssid);
+        db_client.get_string(ctx, mac, 3);
+        dm_easy_mesh_t::string_to_macbytes(mac, info.radiomac);
+
+        info.associated = db_client.get_number(ctx, 4);
+        info.last_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 5));
+        info.last_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 6));
+        info.est_ul_rate = static_cast<unsigned int>(db_client.get_number(ctx, 7));
+        info.est_dl_rate = static_cast<unsigned int>(db_client.get_number(ctx, 8));
+        info.last_conn_time = static_cast<unsigned int>(db_client.get_number(ctx, 9));
+        info.retrans_count = static_cast<unsigned int>(db_client.get_number(ctx, 10));
+        info.signal_strength = static_cast<signed int> (db_client.get_number(ctx, 11));
+        info.rcpi = static_cast<unsigned char> (db_client.get_number(ctx, 12));
+        info.util_tx = static_cast<unsigned int> (db_client.get_number(ctx, 13));
+        info.util_rx = static_cast<unsigned int> (db_client.get_number(ctx, 14));
+        info.pkts_tx = static_cast<unsigned int> (db_client.get_number(ctx, 15));
+        info.pkts_rx = static_cast<unsigned int> (db_client.get_number(ctx, 16));
+        info.bytes_tx = static_cast<unsigned int> (db_client.get_number(ctx, 17));
+        info.bytes_rx = static_cast<unsigned int> (db_client.get_number(ctx, 18));
+        info.errors_tx = static_cast<unsigned int> (db_client.get_number(ctx, 19));
+        info.errors_rx = static_cast<unsigned int> (db_client.get_number(ctx, 20));
+        info.frame_body_len = static_cast<unsigned int> (db_client.get_number(ctx, 21));
+
+        db_client.get_string(ctx, frame_body, 22);
+        dm_easy_mesh_t::unhex(static_cast<unsigned int>(strlen(frame_body)), frame_body, EM_MAX_FRAME_BODY_LEN, info.frame_body);
+
+        ctrl.dm_sta_list_t::set_persisted(dm_easy_mesh_t::macbytes_to_string(info.id, mac), dm_orch_type_db_insert, &info, sizeof(em_sta_info_t));
+        ctrl.dm_sta_list_t::update_list(dm_sta_t(&info), dm_orch_type_db_insert);
+    }
+
+    return 0;
+}
+
+} // namespace
+
+// Query building cost of a single STA row, the database itself is the in-memory stand-in
+static void BM_DbStaRowWrite(benchmark::State& state)
+{
+    dm_easy_mesh_ctrl_t *ctrl = new dm_easy_mesh_ctrl_t();
+    db_client_t db;
+    em_sta_info_t info;
+    bssid_t bssid;
+    mac_address_t ruid;
+    unsigned int i = 0;
+    dm_orch_type_t op = static_cast<dm_orch_type_t> (state.range(0));
+
+    bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, 0);
+    bench_dm_gen_t::make_mac(ruid, bench_mac_kind_radio, 0);
+    g_bench_db_stats.num_queries = 0;
+    g_bench_db_stats.query_bytes = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        bench_dm_gen_t::fill_sta(&info, bssid, ruid, i++);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(ctrl->dm_sta_list_t::update_db(db, op, &info));
+    }
+
+    state.counters["query_bytes"] = benchmark::Counter(static_cast<double> (g_bench_db_stats.query_bytes),
+            benchmark::Counter::kAvgIterations);
+    delete ctrl;
+}
+BENCHMARK(BM_DbStaRowWrite)->Arg(dm_orch_type_db_insert)->Arg(dm_orch_type_db_update);
+
+// Full flush of every STA in the data model, as done after a topology or link metrics update
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_DbStaFlush)(benchmark::State& state)
+{
+    dm_sta_t *sta;
+    unsigned int rows = 0;
+
+    g_bench_db_stats.num_queries = 0;
+    g_bench_db_stats.query_bytes = 0;
+
+    for (auto _ : state) {
+        rows = 0;
+        sta = m_ctrl->get_first_sta();
+        while (sta != NULL) {
+            m_ctrl->dm_sta_list_t::update_db(m_db, dm_orch_type_db_update, sta->get_sta_info());
+            rows++;
+            sta = m_ctrl->get_next_sta(sta);
+        }
+    }
+
+    state.counters["rows"] = rows;
+    state.counters["queries"] = benchmark::Counter(static_cast<double> (g_bench_db_stats.num_queries),
+            benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * rows);
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_DbStaFlush) BENCH_TOPOLOGY_ARGS;
+
+// Change detection done before every write, see dm_sta_list_t::get_dm_orch_type()
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_DbStaOrchType)(benchmark::State& state)
+{
+    dm_sta_t *sta = m_ctrl->get_first_sta();
+
+    if (sta == NULL) {
+        state.SkipWithError("empty data model");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_ctrl->dm_sta_list_t::get_dm_orch_type(m_db, *sta));
+    }
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_DbStaOrchType) BENCH_TOPOLOGY_ARGS;
+
+// Cold start load of the STA table into a data model holding only the agents, radios and BSSs.
+// range(2) selects the loader: 0 for dm_sta_list_t::sync_db(), 1 for the per column decoding it replaced.
+static void BM_DbStaColdLoad(benchmark::State& state)
+{
+    bench_mgr_t mgr;
+    bench_topology_t topo = {static_cast<unsigned int> (state.range(0)), 3, 2, static_cast<unsigned int> (state.range(1))};
+    bench_topology_t empty = topo;
+    dm_easy_mesh_ctrl_t *ctrl = new dm_easy_mesh_ctrl_t();
+    bench_db_result_t res;
+    db_client_t db;
+    size_t rows;
+
+    ctrl->init("bench@bench", &mgr);
+    bench_dm_gen_t::populate(*ctrl, topo);
+    dump_sta_rows(*ctrl, res);
+    rows = res.values.size() / res.num_cols;
+    empty.sta_per_bss = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ctrl->delete_all_data_models();
+        delete ctrl;
+        ctrl = new dm_easy_mesh_ctrl_t();
+        ctrl->init("bench@bench", &mgr);
+        bench_dm_gen_t::populate(*ctrl, empty);
+        g_bench_db_result = &res;
+        state.ResumeTiming();
+
+        if (state.range(2) == 0) {
+            ctrl->dm_sta_list_t::sync_table(db);
+        } else {
+            sync_sta_per_column(*ctrl, db);
+        }
+
+        state.PauseTiming();
+        g_bench_db_result = NULL;
+        state.ResumeTiming();
+    }
+
+    state.counters["rows"] = static_cast<double> (rows);
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * static_cast<int64_t> (rows));
+    ctrl->delete_all_data_models();
+    delete ctrl;
+}
+BENCHMARK(BM_DbStaColdLoad)->Args({64, 256, 0})->Args({64, 256, 1})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * In-memory stand-in for db_client_t. The benchmark binary links this file instead of
+ * src/db/db_client.cpp so that the query building done by db_easy_mesh_t and the
+ * dm_*_list_t writers can be measured without a MariaDB server. Queries are counted
+ * and discarded; every select returns g_bench_db_result, or an empty result set when
+ * it is not set.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "db_client.h"
+#include "bench_common.h"
+
+bench_db_stats_t g_bench_db_stats = {0, 0};
+bench_db_result_t *g_bench_db_result = NULL;
+
+// Cursor over g_bench_db_result, the stand-in for the MariaDB result context
+struct bench_db_cursor_t {
+    bench_db_result_t *res;
+    size_t num_rows;
+    size_t row;     // 1-based, 0 before the first next_result()
+};
+
+int db_client_t::recreate_db()
+{
+    return 0;
+}
+
+void *db_client_t::execute(const char *query, int *status)
+{
+    bench_db_result_t *res = g_bench_db_result;
+    bench_db_cursor_t *cursor;
+    size_t i;
+
+    if (status != NULL) {
+        *status = 0;
+    }
+    g_bench_db_stats.num_queries++;
+    g_bench_db_stats.query_bytes += strlen(query);
+
+    if ((res == NULL) || (res->num_cols == 0) || (strncmp(query, "select", strlen("select")) != 0)) {
+        return NULL;
+    }
+
+    if (res->cells.size() != res->values.size()) {
+        res->cells.resize(res->values.size());
+        res->lengths.resize(res->values.size());
+        for (i = 0; i < res->values.size(); i++) {
+            res->cells[i] = res->values[i].c_str();
+            res->lengths[i] = res->values[i].size();
+        }
+    }
+
+    cursor = new bench_db_cursor_t;
+    cursor->res = res;
+    cursor->num_rows = res->values.size() / res->num_cols;
+    cursor->row = 0;
+
+    return cursor;
+}
+
+bool db_client_t::next_result(void *ctx)
+{
+    bench_db_cursor_t *cursor = static_cast<bench_db_cursor_t *> (ctx);
+
+    if (cursor == NULL) {
+        return false;
+    }
+
+    if (cursor->row++ >= cursor->num_rows) {
+        delete cursor;
+        return false;
+    }
+
+    return true;
+}
+
+bool db_client_t::next_row(void *ctx, db_row_t& row)
+{
+    bench_db_cursor_t *cursor = static_cast<bench_db_cursor_t *> (ctx);
+    size_t first;
+
+    if (next_result(ctx) == false) {
+        row.set(NULL, NULL, 0);
+        return false;
+    }
+
+    first = (cursor->row - 1) * cursor->res->num_cols;
+    row.set(&cursor->res->cells[first], &cursor->res->lengths[first], cursor->res->num_cols);
+    return true;
+}
+
+char *db_client_t::get_string(void *ctx, char *str, unsigned int col)
+{
+    bench_db_cursor_t *cursor = static_cast<bench_db_cursor_t *> (ctx);
+    size_t cell;
+
+    if ((cursor == NULL) || (cursor->row == 0) || (col == 0) || (col > cursor->res->num_cols)) {
+        return NULL;
+    }
+
+    // same copy as the MariaDB client implementation
+    cell = (cursor->row - 1) * cursor->res->num_cols + col - 1;
+    snprintf(str, cursor->res->lengths[cell] + 1, "%s", cursor->res->cells[cell]);
+    return str;
+}
+
+int db_client_t::get_number(void *ctx, unsigned int col)
+{
+    bench_db_cursor_t *cursor = static_cast<bench_db_cursor_t *> (ctx);
+
+    if ((cursor == NULL) || (cursor->row == 0) || (col == 0) || (col > cursor->res->num_cols)) {
+        return 0;
+    }
+
+    return atoi(cursor->res->cells[(cursor->row - 1) * cursor->res->num_cols + col - 1]);
+}
+
+int db_client_t::connect(const char *path)
+{
+    return 0;
+}
+
+int db_client_t::init(const char *path)
+{
+    return connect(path);
+}
+
+db_client_t::db_client_t()
+{
+    m_con = NULL;
+}
+
+db_client_t::~db_client_t()
+{
+
+}
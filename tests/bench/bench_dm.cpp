@@ -0,0 +1,158 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <cjson/cJSON.h>
+#include <string>
+#include <vector>
+
+#include "dm_easy_mesh_ctrl.h"
+#include "bench_common.h"
+
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_StaLookupByKey)(benchmark::State& state)
+{
+    std::vector<std::string> keys;
+    em_long_string_t key;
+    mac_addr_str_t sta_str, bss_str, radio_str;
+    dm_sta_t *sta;
+    size_t i = 0;
+
+    sta = m_ctrl->get_first_sta();
+    while (sta != NULL) {
+        snprintf(key, sizeof(em_long_string_t), "%s@%s@%s",
+                dm_easy_mesh_t::macbytes_to_string(sta->m_sta_info.id, sta_str),
+                dm_easy_mesh_t::macbytes_to_string(sta->m_sta_info.bssid, bss_str),
+                dm_easy_mesh_t::macbytes_to_string(sta->m_sta_info.radiomac, radio_str));
+        keys.push_back(key);
+        sta = m_ctrl->get_next_sta(sta);
+    }
+
+    if (keys.empty()) {
+        state.SkipWithError("empty data model");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_ctrl->get_sta(keys[i++ % keys.size()].c_str()));
+    }
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_StaLookupByKey) BENCH_TOPOLOGY_ARGS;
+
+// Same lookups through the binary sta/bssid/ruid key, no parsing and a direct radio to data model index
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_StaLookupByBinaryKey)(benchmark::State& state)
+{
+    std::vector<em_sta_key_t> keys;
+    em_sta_key_t key;
+    dm_sta_t *sta;
+    size_t i = 0;
+
+    sta = m_ctrl->get_first_sta();
+    while (sta != NULL) {
+        sta->get_key(&key);
+        keys.push_back(key);
+        sta = m_ctrl->get_next_sta(sta);
+    }
+
+    if (keys.empty()) {
+        state.SkipWithError("empty data model");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_ctrl->get_sta(&keys[i++ % keys.size()]));
+    }
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_StaLookupByBinaryKey) BENCH_TOPOLOGY_ARGS;
+
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_StaIterateAll)(benchmark::State& state)
+{
+    dm_sta_t *sta;
+    unsigned int count = 0;
+
+    for (auto _ : state) {
+        count = 0;
+        sta = m_ctrl->get_first_sta();
+        while (sta != NULL) {
+            count++;
+            sta = m_ctrl->get_next_sta(sta);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.counters["stas"] = count;
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * count);
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_StaIterateAll) BENCH_TOPOLOGY_ARGS;
+
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_DmFindSta)(benchmark::State& state)
+{
+    em_interface_t al_intf;
+    dm_easy_mesh_t *dm;
+    dm_sta_t *sta;
+
+    bench_dm_gen_t::make_mac(al_intf.mac, bench_mac_kind_agent, m_topo.num_agents - 1);
+    if (((dm = m_ctrl->get_data_model(BENCH_NET_ID, al_intf.mac)) == NULL) ||
+            ((sta = static_cast<dm_sta_t *> (hash_map_get_first(dm->m_sta_map))) == NULL)) {
+        state.SkipWithError("empty data model");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dm->find_sta(sta->m_sta_info.id, sta->m_sta_info.bssid));
+    }
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_DmFindSta) BENCH_TOPOLOGY_ARGS;
+
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_GetStaConfigJson)(benchmark::State& state)
+{
+    cJSON *parent;
+    char *str;
+    em_long_string_t net_id;
+    size_t len = 0;
+
+    snprintf(net_id, sizeof(em_long_string_t), "%s", BENCH_NET_ID);
+
+    for (auto _ : state) {
+        parent = cJSON_CreateObject();
+        m_ctrl->get_sta_config(parent, net_id);
+        str = cJSON_PrintUnformatted(parent);
+        len = strlen(str);
+        cJSON_free(str);
+        cJSON_Delete(parent);
+    }
+    state.SetBytesProcessed(static_cast<int64_t> (state.iterations() * len));
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_GetStaConfigJson) BENCH_TOPOLOGY_ARGS;
+
+BENCHMARK_DEFINE_F(bench_ctrl_fixture_t, BM_GetDeviceConfigJson)(benchmark::State& state)
+{
+    cJSON *parent;
+    char *str;
+    em_long_string_t net_id;
+
+    snprintf(net_id, sizeof(em_long_string_t), "%s", BENCH_NET_ID);
+
+    for (auto _ : state) {
+        parent = cJSON_CreateObject();
+        m_ctrl->get_device_config(parent, net_id);
+        str = cJSON_PrintUnformatted(parent);
+        cJSON_free(str);
+        cJSON_Delete(parent);
+    }
+}
+BENCHMARK_REGISTER_F(bench_ctrl_fixture_t, BM_GetDeviceConfigJson) BENCH_TOPOLOGY_ARGS;
@@ -0,0 +1,228 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ec_util.h"
+#include "ec_frame_builder.h"
+
+namespace {
+
+// P-256 sizes, as negotiated by every DPP exchange today
+const uint16_t bench_digest_len = SHA256_DIGEST_LENGTH;
+const uint16_t bench_nonce_len = 16;
+const uint16_t bench_proto_key_len = 64;
+
+struct bench_ec_material_t {
+    uint8_t k1[SHA256_DIGEST_LENGTH];
+    uint8_t k2[SHA256_DIGEST_LENGTH];
+    uint8_t ke[SHA256_DIGEST_LENGTH];
+    uint8_t resp_keyhash[SHA256_DIGEST_LENGTH];
+    uint8_t init_keyhash[SHA256_DIGEST_LENGTH];
+    uint8_t proto_key[64];
+    uint8_t i_nonce[16];
+    uint8_t r_nonce[16];
+    uint8_t r_auth[SHA256_DIGEST_LENGTH];
+    uint8_t caps;
+};
+
+const bench_ec_material_t& bench_material()
+{
+    static bench_ec_material_t mat;
+    static bool init = false;
+
+    if (!init) {
+        uint8_t *bytes = reinterpret_cast<uint8_t *>(&mat);
+        for (size_t i = 0; i < sizeof(mat); i++) {
+            bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+        init = true;
+    }
+    return mat;
+}
+
+// Authentication Request the way ec_ctrl_configurator_t::create_auth_request() built it before ec_frame_builder_t
+std::pair<uint8_t *, size_t> legacy_auth_request(const bench_ec_material_t& m)
+{
+    ec_frame_t *frame = ec_util::alloc_frame(ec_frame_type_auth_req);
+    uint8_t *attribs = NULL;
+    size_t attribs_len = 0;
+    uint16_t chann_attr = 0x0651;
+
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_bootstrap_key_hash, bench_digest_len, const_cast<uint8_t *>(m.resp_keyhash));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_bootstrap_key_hash, bench_digest_len, const_cast<uint8_t *>(m.init_keyhash));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_init_proto_key, bench_proto_key_len, const_cast<uint8_t *>(m.proto_key));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_channel, sizeof(uint16_t), reinterpret_cast<uint8_t *>(&chann_attr));
+    attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, const_cast<uint8_t *>(m.k1), [&](){
+        uint8_t *wrap_attribs = NULL;
+        size_t wrapped_len = 0;
+        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_nonce, bench_nonce_len, const_cast<uint8_t *>(m.i_nonce));
+        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_caps, m.caps);
+        return std::make_pair(wrap_attribs, static_cast<uint16_t>(wrapped_len));
+    });
+
+    frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len);
+    free(attribs);
+    return std::make_pair(reinterpret_cast<uint8_t *>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+}
+
+std::pair<uint8_t *, size_t> builder_auth_request(ec_frame_builder_t& builder, const bench_ec_material_t& m)
+{
+    uint16_t chann_attr = 0x0651;
+
+    builder.begin(ec_frame_type_auth_req);
+    builder.add_attrib(ec_attrib_id_resp_bootstrap_key_hash, bench_digest_len, m.resp_keyhash);
+    builder.add_attrib(ec_attrib_id_init_bootstrap_key_hash, bench_digest_len, m.init_keyhash);
+    builder.add_attrib(ec_attrib_id_init_proto_key, bench_proto_key_len, m.proto_key);
+    builder.add_attrib(ec_attrib_id_channel, sizeof(uint16_t), reinterpret_cast<uint8_t *>(&chann_attr));
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_init_nonce, bench_nonce_len, m.i_nonce);
+    builder.add_attrib(ec_attrib_id_init_caps, m.caps);
+    builder.end_wrapped(true, m.k1);
+    return builder.finish();
+}
+
+// Authentication Response (STATUS_OK), with { R-auth }ke nested in the k2 Wrapped Data
+std::pair<uint8_t *, size_t> legacy_auth_response(const bench_ec_material_t& m)
+{
+    ec_frame_t *frame = ec_util::alloc_frame(ec_frame_type_auth_rsp);
+    uint8_t *attribs = NULL;
+    size_t attribs_len = 0;
+
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_dpp_status, static_cast<uint8_t>(DPP_STATUS_OK));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_bootstrap_key_hash, bench_digest_len, const_cast<uint8_t *>(m.resp_keyhash));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_resp_proto_key, bench_proto_key_len, const_cast<uint8_t *>(m.proto_key));
+    attribs = ec_util::add_attrib(attribs, &attribs_len, ec_attrib_id_proto_version, static_cast<uint8_t>(1));
+    attribs = ec_util::add_wrapped_data_attr(frame, attribs, &attribs_len, true, const_cast<uint8_t *>(m.k2), [&](){
+        size_t wrapped_len = 0;
+        uint8_t *wrap_attribs = ec_util::add_attrib(NULL, &wrapped_len, ec_attrib_id_resp_nonce, bench_nonce_len, const_cast<uint8_t *>(m.r_nonce));
+        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_init_nonce, bench_nonce_len, const_cast<uint8_t *>(m.i_nonce));
+        wrap_attribs = ec_util::add_attrib(wrap_attribs, &wrapped_len, ec_attrib_id_resp_caps, m.caps);
+        wrap_attribs = ec_util::add_wrapped_data_attr(frame, wrap_attribs, &wrapped_len, false, const_cast<uint8_t *>(m.ke), [&](){
+            size_t int_wrapped_len = 0;
+            uint8_t *int_wrapped_attrs = ec_util::add_attrib(NULL, &int_wrapped_len, ec_attrib_id_resp_auth_tag, bench_digest_len, const_cast<uint8_t *>(m.r_auth));
+            return std::make_pair(int_wrapped_attrs, static_cast<uint16_t>(int_wrapped_len));
+        });
+        return std::make_pair(wrap_attribs, static_cast<uint16_t>(wrapped_len));
+    });
+
+    frame = ec_util::copy_attrs_to_frame(frame, attribs, attribs_len);
+    free(attribs);
+    return std::make_pair(reinterpret_cast<uint8_t *>(frame), EC_FRAME_BASE_SIZE + attribs_len);
+}
+
+std::pair<uint8_t *, size_t> builder_auth_response(ec_frame_builder_t& builder, const bench_ec_material_t& m)
+{
+    builder.begin(ec_frame_type_auth_rsp);
+    builder.add_attrib(ec_attrib_id_dpp_status, static_cast<uint8_t>(DPP_STATUS_OK));
+    builder.add_attrib(ec_attrib_id_resp_bootstrap_key_hash, bench_digest_len, m.resp_keyhash);
+    builder.add_attrib(ec_attrib_id_resp_proto_key, bench_proto_key_len, m.proto_key);
+    builder.add_attrib(ec_attrib_id_proto_version, static_cast<uint8_t>(1));
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_resp_nonce, bench_nonce_len, m.r_nonce);
+    builder.add_attrib(ec_attrib_id_init_nonce, bench_nonce_len, m.i_nonce);
+    builder.add_attrib(ec_attrib_id_resp_caps, m.caps);
+    builder.begin_wrapped();
+    builder.add_attrib(ec_attrib_id_resp_auth_tag, bench_digest_len, m.r_auth);
+    builder.end_wrapped(false, m.ke);
+    builder.end_wrapped(true, m.k2);
+    return builder.finish();
+}
+
+// Both paths must emit the same bytes, otherwise the comparison is meaningless
+bool same_frame(std::pair<uint8_t *, size_t> a, std::pair<uint8_t *, size_t> b)
+{
+    bool same = (a.first != NULL) && (b.first != NULL) && (a.second == b.second) && (memcmp(a.first, b.first, a.second) == 0);
+    free(a.first);
+    free(b.first);
+    return same;
+}
+
+} // namespace
+
+static void BM_EcAuthRequestLegacy(benchmark::State& state)
+{
+    const bench_ec_material_t& m = bench_material();
+
+    for (auto _ : state) {
+        auto [frame, len] = legacy_auth_request(m);
+        benchmark::DoNotOptimize(frame);
+        free(frame);
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_EcAuthRequestLegacy);
+
+static void BM_EcAuthRequestBuilder(benchmark::State& state)
+{
+    const bench_ec_material_t& m = bench_material();
+    ec_frame_builder_t builder;
+
+    {
+        ec_frame_builder_t check;
+        if (!same_frame(legacy_auth_request(m), builder_auth_request(check, m))) {
+            state.SkipWithError("builder output differs from ec_util::add_attrib()");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        auto [frame, len] = builder_auth_request(builder, m);
+        benchmark::DoNotOptimize(frame);
+        free(frame);
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_EcAuthRequestBuilder);
+
+static void BM_EcAuthResponseLegacy(benchmark::State& state)
+{
+    const bench_ec_material_t& m = bench_material();
+
+    for (auto _ : state) {
+        auto [frame, len] = legacy_auth_response(m);
+        benchmark::DoNotOptimize(frame);
+        free(frame);
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_EcAuthResponseLegacy);
+
+static void BM_EcAuthResponseBuilder(benchmark::State& state)
+{
+    const bench_ec_material_t& m = bench_material();
+    ec_frame_builder_t builder;
+
+    {
+        ec_frame_builder_t check;
+        if (!same_frame(legacy_auth_response(m), builder_auth_response(check, m))) {
+            state.SkipWithError("builder output differs from ec_util::add_wrapped_data_attr()");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        auto [frame, len] = builder_auth_response(builder, m);
+        benchmark::DoNotOptimize(frame);
+        free(frame);
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_EcAuthResponseBuilder);
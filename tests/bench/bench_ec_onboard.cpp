@@ -0,0 +1,226 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+
+#include "ec_crypto.h"
+#include "ec_crypto_pool.h"
+
+namespace {
+
+/**
+ * A simulated Enrollee, onboarded in the two crypto steps the configurator runs per Enrollee:
+ * the Authentication Response (ECDH with its protocol key, k2/ke derivation) and the
+ * Configuration Request (netAccessKey Connector signed with the c-sign-key).
+ */
+struct bench_enrollee_t {
+    ec_connection_context_t ctx;
+    SSL_KEY *boot_key;
+    SSL_KEY *proto_key;
+    std::string connector;
+    bool ok;
+};
+
+struct bench_onboard_env_t {
+    SSL_KEY *c_sign_key;
+    std::vector<bench_enrollee_t> enrollees;
+};
+
+bool enrollee_init(bench_enrollee_t& e)
+{
+    memset(&e.ctx, 0, sizeof(e.ctx));
+    e.boot_key = em_crypto_t::generate_ec_key(NID_X9_62_prime256v1);
+    e.proto_key = em_crypto_t::generate_ec_key(NID_X9_62_prime256v1);
+    e.ok = false;
+    if (e.boot_key == NULL || e.proto_key == NULL) {
+        return false;
+    }
+    return ec_crypto::init_connection_ctx(e.ctx, e.boot_key);
+}
+
+void enrollee_free(bench_enrollee_t& e)
+{
+    ec_crypto::free_connection_ctx(&e.ctx);
+    em_crypto_t::free_key(e.boot_key);
+    em_crypto_t::free_key(e.proto_key);
+}
+
+// Authentication: configurator protocol key pair, M = p_I * P_R, k1/k2/ke
+void step_auth(bench_enrollee_t& e)
+{
+    ec_connection_context_t& c = e.ctx;
+    auto [priv, pub] = ec_crypto::generate_proto_keypair(c);
+    EC_POINT *peer = em_crypto_t::get_pub_key_point(e.proto_key);
+    BIGNUM *m = NULL;
+    uint8_t k2[SHA512_DIGEST_LENGTH];
+    uint8_t ke[SHA512_DIGEST_LENGTH];
+
+    e.ok = false;
+    if (priv != NULL && pub != NULL && peer != NULL) {
+        m = ec_crypto::compute_ec_ss_x(c, priv, peer);
+    }
+    if (m != NULL) {
+        const BIGNUM *x_val[] = { m };
+        e.ok = ec_crypto::compute_hkdf_key(c, k2, c.digest_len, "second intermediate key", x_val, 1, NULL, 0) != 0 &&
+            ec_crypto::compute_hkdf_key(c, ke, c.digest_len, "DPP Key", x_val, 1, k2, c.digest_len) != 0;
+    }
+
+    BN_free(m);
+    BN_free(const_cast<BIGNUM *>(priv));
+    EC_POINT_free(const_cast<EC_POINT *>(pub));
+    EC_POINT_free(peer);
+}
+
+// Configuration: Connector for the Enrollee's netAccessKey, signed with the c-sign-key
+void step_config(bench_enrollee_t& e, SSL_KEY *c_sign_key)
+{
+    if (!e.ok) {
+        return;
+    }
+    e.ok = false;
+
+    cJSON *header = ec_crypto::create_jws_header("dppCon", c_sign_key);
+    cJSON *payload = ec_crypto::create_jws_payload(e.ctx, {{{"groupId", "mapNW"}, {"netRole", "mapAgent"}}}, e.proto_key);
+    if (header != NULL && payload != NULL) {
+        std::optional<std::string> connector = ec_crypto::generate_connector(header, payload, c_sign_key);
+        if (connector.has_value()) {
+            e.connector = std::move(*connector);
+            e.ok = true;
+        }
+    }
+    cJSON_Delete(header);
+    cJSON_Delete(payload);
+}
+
+bool env_init(bench_onboard_env_t& env, size_t count)
+{
+    env.c_sign_key = em_crypto_t::generate_ec_key(NID_X9_62_prime256v1);
+    env.enrollees.resize(count);
+    bool ok = env.c_sign_key != NULL;
+    for (auto& e : env.enrollees) {
+        ok = enrollee_init(e) && ok;
+    }
+    return ok;
+}
+
+void env_free(bench_onboard_env_t& env)
+{
+    for (auto& e : env.enrollees) {
+        enrollee_free(e);
+    }
+    em_crypto_t::free_key(env.c_sign_key);
+}
+
+// Stand-in for the manager timer wheel: completions are queued and run by the benchmark thread
+struct bench_owner_queue_t {
+    std::mutex lock;
+    std::condition_variable cond;
+    std::deque<std::function<void()>> cbs;
+
+    void post(std::function<void()> cb) {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            cbs.push_back(std::move(cb));
+        }
+        cond.notify_one();
+    }
+
+    void run_one() {
+        std::unique_lock<std::mutex> l(lock);
+        cond.wait(l, [this]() { return !cbs.empty(); });
+        std::function<void()> cb = std::move(cbs.front());
+        cbs.pop_front();
+        l.unlock();
+        cb();
+    }
+};
+
+} // namespace
+
+static void BM_EcOnboardSerial(benchmark::State& state)
+{
+    bench_onboard_env_t env;
+    if (!env_init(env, static_cast<size_t>(state.range(0)))) {
+        env_free(env);
+        state.SkipWithError("failed to create simulated enrollees");
+        return;
+    }
+
+    for (auto _ : state) {
+        for (auto& e : env.enrollees) {
+            step_auth(e);
+            step_config(e, env.c_sign_key);
+        }
+    }
+    for (auto& e : env.enrollees) {
+        if (!e.ok) {
+            state.SkipWithError("simulated onboarding failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * state.range(0));
+    state.SetLabel("onboardings");
+    env_free(env);
+}
+BENCHMARK(BM_EcOnboardSerial)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+
+static void BM_EcOnboardPool(benchmark::State& state)
+{
+    bench_onboard_env_t env;
+    if (!env_init(env, static_cast<size_t>(state.range(0)))) {
+        env_free(env);
+        state.SkipWithError("failed to create simulated enrollees");
+        return;
+    }
+
+    bench_owner_queue_t owner;
+    ec_crypto_pool_t pool(0, [&owner](std::function<void()> cb) { owner.post(std::move(cb)); });
+    SSL_KEY *c_sign_key = env.c_sign_key;
+
+    for (auto _ : state) {
+        size_t done = 0;
+        for (size_t i = 0; i < env.enrollees.size(); i++) {
+            bench_enrollee_t *e = &env.enrollees[i];
+            // The Configuration step is queued from the Authentication completion, as the frames arrive in that order
+            pool.submit(i, [e]() { step_auth(*e); }, [&pool, &done, e, i, c_sign_key]() {
+                pool.submit_next(i, [e, c_sign_key]() { step_config(*e, c_sign_key); }, [&done]() { done++; });
+            });
+        }
+        while (done < env.enrollees.size()) {
+            owner.run_one();
+        }
+    }
+    for (auto& e : env.enrollees) {
+        if (!e.ok) {
+            state.SkipWithError("simulated onboarding failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * state.range(0));
+    state.SetLabel("onboardings, " + std::to_string(pool.get_num_workers()) + " workers");
+    // Let the last completions release their strands before the pool goes away
+    while (pool.get_stats().in_flight != 0) {
+        owner.run_one();
+    }
+    env_free(env);
+}
+BENCHMARK(BM_EcOnboardPool)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
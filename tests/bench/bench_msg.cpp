@@ -0,0 +1,143 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+
+#include "em.h"
+#include "em_msg.h"
+#include "bench_common.h"
+
+namespace {
+
+// Builds a topology response CMDU carrying all mandatory TLVs plus `num_vendor` vendor TLVs
+// placed before the EOM, so validate()/get_tlv() have to walk past them.
+unsigned int build_topo_resp(unsigned char *buff, unsigned int num_vendor)
+{
+    unsigned char value[256];
+    unsigned char *tmp = buff;
+    unsigned int len = 0, i;
+    mac_address_t dst = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    mac_address_t src = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+
+    memset(value, 0xa5, sizeof(value));
+    tmp = em_msg_t::add_1905_header(tmp, &len, dst, src, em_msg_type_topo_resp);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_device_info, value, 64);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_operational_bss, value, 128);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_supported_service, value, 3);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_associated_clients, value, 200);
+    for (i = 0; i < num_vendor; i++) {
+        tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_vendor_specific, value, 32);
+    }
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_profile, value, 1);
+    tmp = em_msg_t::add_tlv(tmp, &len, em_tlv_type_bss_conf_rep, value, 64);
+    tmp = em_msg_t::add_eom_tlv(tmp, &len);
+
+    return len;
+}
+
+}
+
+static void BM_MsgValidateTopoResp(benchmark::State& state)
+{
+    std::vector<unsigned char> buff(MAX_EM_BUFF_SZ * EM_MAX_BANDS * 8);
+    unsigned int len = build_topo_resp(buff.data(), static_cast<unsigned int> (state.range(0)));
+    char *errors[EM_MAX_TLV_MEMBERS];
+
+    for (auto _ : state) {
+        em_msg_t msg(em_msg_type_topo_resp, em_profile_type_3, buff.data(), len);
+        benchmark::DoNotOptimize(msg.validate(errors));
+    }
+    state.SetBytesProcessed(static_cast<int64_t> (state.iterations()) * len);
+}
+BENCHMARK(BM_MsgValidateTopoResp)->Arg(0)->Arg(8)->Arg(32);
+
+static void BM_MsgGetTlv(benchmark::State& state)
+{
+    std::vector<unsigned char> buff(MAX_EM_BUFF_SZ * EM_MAX_BANDS * 8);
+    unsigned int len = build_topo_resp(buff.data(), static_cast<unsigned int> (state.range(0)));
+    unsigned int hdr_len = static_cast<unsigned int> (sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
+
+    for (auto _ : state) {
+        // the last TLV before EOM is the worst case for the linear walk
+        em_msg_t msg(buff.data() + hdr_len, len - hdr_len);
+        benchmark::DoNotOptimize(msg.get_tlv(em_tlv_type_bss_conf_rep));
+    }
+}
+BENCHMARK(BM_MsgGetTlv)->Arg(0)->Arg(8)->Arg(32);
+
+static void BM_MsgBuildTopoResp(benchmark::State& state)
+{
+    std::vector<unsigned char> buff(MAX_EM_BUFF_SZ * EM_MAX_BANDS * 8);
+    unsigned int len = 0;
+
+    for (auto _ : state) {
+        len = build_topo_resp(buff.data(), static_cast<unsigned int> (state.range(0)));
+        benchmark::DoNotOptimize(buff.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t> (state.iterations()) * len);
+}
+BENCHMARK(BM_MsgBuildTopoResp)->Arg(0)->Arg(8)->Arg(32);
+
+class BenchTlvBuilderFixture : public benchmark::Fixture {
+public:
+    bench_mgr_t m_mgr;
+    dm_easy_mesh_t m_dm;
+    em_t *m_em = NULL;
+    unsigned char m_buff[MAX_EM_BUFF_SZ * 4];
+
+    void SetUp(const benchmark::State& state) override {
+        const bench_topology_t topo = {1, EM_MAX_BANDS, 4, 0};
+        em_interface_t ruid;
+
+        m_dm.init();
+        bench_dm_gen_t::make_mac(m_dm.m_device.m_device_info.intf.mac, bench_mac_kind_agent, 0);
+        bench_dm_gen_t::fill_agent(&m_dm, topo, 0);
+
+        memcpy(&ruid, &m_dm.m_radio[0].m_radio_info.intf, sizeof(em_interface_t));
+        m_em = new em_t(&ruid, em_freq_band_24, &m_dm, &m_mgr, em_profile_type_3, em_service_type_agent);
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        delete m_em;
+        m_em = NULL;
+        m_dm.deinit();
+    }
+};
+
+BENCHMARK_F(BenchTlvBuilderFixture, BM_CreateApCapTlv)(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_em->create_ap_cap_tlv(m_buff));
+    }
+}
+
+BENCHMARK_F(BenchTlvBuilderFixture, BM_CreateHeTlv)(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_em->create_he_tlv(m_buff));
+    }
+}
+
+BENCHMARK_F(BenchTlvBuilderFixture, BM_CreateDeviceInventoryTlv)(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m_em->create_device_inventory_tlv(m_buff));
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <cjson/cJSON.h>
+
+#include "em_net_node.h"
+#include "bench_common.h"
+
+namespace {
+
+/**
+ * A Network Topology tree as the CLI fetches it: devices, each with three radios of four BSSs
+ * holding twelve STAs, every element carrying a handful of scalar properties. The variant changes
+ * the link metrics of a single STA, so two trees of different variants differ in one node.
+ */
+const bench_topology_t bench_tree_topo = { 0, 3, 4, 12 };
+
+em_network_node_t *add_node(em_network_node_t *parent, const char *key, em_network_node_data_type_t type)
+{
+    em_network_node_t *node;
+
+    node = static_cast<em_network_node_t *> (malloc(sizeof(em_network_node_t)));
+    memset(node, 0, sizeof(em_network_node_t));
+    snprintf(node->key, sizeof(em_long_string_t), "%s", key);
+    node->type = type;
+    if (parent != NULL) {
+        parent->child[parent->num_children++] = node;
+    }
+
+    return node;
+}
+
+void add_mac(em_network_node_t *parent, const char *key, bench_mac_kind_t kind, unsigned int index)
+{
+    em_network_node_t *node;
+    mac_address_t mac;
+
+    bench_dm_gen_t::make_mac(mac, kind, index);
+    node = add_node(parent, key, em_network_node_data_type_string);
+    snprintf(node->value_str, sizeof(em_long_string_t), "%02x:%02x:%02x:%02x:%02x:%02x",
+        mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+void add_num(em_network_node_t *parent, const char *key, unsigned int value)
+{
+    add_node(parent, key, em_network_node_data_type_number)->value_int = value;
+}
+
+em_network_node_t *make_tree(unsigned int num_agents, unsigned int variant, unsigned int *num_nodes)
+{
+    em_network_node_t *root, *net, *devs, *dev, *radios, *radio, *bsss, *bss, *stas, *sta;
+    unsigned int a, r, b, s, ri = 0, bi = 0, si = 0;
+
+    root = add_node(NULL, "", em_network_node_data_type_obj);
+    net = add_node(root, "Network", em_network_node_data_type_obj);
+    add_node(net, "ID", em_network_node_data_type_string);
+    snprintf(net->child[0]->value_str, sizeof(em_long_string_t), "%s", BENCH_NET_ID);
+    devs = add_node(net, "DeviceList", em_network_node_data_type_array_obj);
+
+    for (a = 0; a < num_agents; a++) {
+        dev = add_node(devs, "", em_network_node_data_type_obj);
+        add_mac(dev, "ID", bench_mac_kind_agent, a);
+        add_num(dev, "MultiAPProfile", 3);
+        add_node(dev, "Backhaul", em_network_node_data_type_true);
+        radios = add_node(dev, "RadioList", em_network_node_data_type_array_obj);
+        for (r = 0; r < bench_tree_topo.radios_per_agent; r++, ri++) {
+            radio = add_node(radios, "", em_network_node_data_type_obj);
+            add_mac(radio, "ID", bench_mac_kind_radio, ri);
+            add_num(radio, "OperatingClass", 115 + r);
+            add_num(radio, "Channel", 36 + 4 * r);
+            add_num(radio, "TransmitPower", 20);
+            add_num(radio, "Utilization", 40);
+            add_node(radio, "Enabled", em_network_node_data_type_true);
+            bsss = add_node(radio, "BSSList", em_network_node_data_type_array_obj);
+            for (b = 0; b < bench_tree_topo.bss_per_radio; b++, bi++) {
+                bss = add_node(bsss, "", em_network_node_data_type_obj);
+                add_mac(bss, "BSSID", bench_mac_kind_bss, bi);
+                add_node(bss, "SSID", em_network_node_data_type_string);
+                snprintf(bss->child[1]->value_str, sizeof(em_long_string_t), "%s_%u", BENCH_NET_ID, b);
+                add_num(bss, "HaulType", (b == 0) ? 1:0);
+                add_num(bss, "UnicastBytesSent", 1000 * bi);
+                add_node(bss, "Enabled", em_network_node_data_type_true);
+                stas = add_node(bss, "STAList", em_network_node_data_type_array_obj);
+                for (s = 0; s < bench_tree_topo.sta_per_bss; s++, si++) {
+                    sta = add_node(stas, "", em_network_node_data_type_obj);
+                    add_mac(sta, "MACAddress", bench_mac_kind_sta, si);
+                    add_num(sta, "SignalStrength", (si == 0) ? 120 + variant:120);
+                    add_num(sta, "LastDataDownlinkRate", 866);
+                    add_num(sta, "LastDataUplinkRate", 433);
+                    add_num(sta, "EstMACDataRateDownlink", 600);
+                    add_num(sta, "UtilizationReceive", 10);
+                }
+            }
+        }
+    }
+
+    *num_nodes = 4 + num_agents * (5 + bench_tree_topo.radios_per_agent * (8 + bench_tree_topo.bss_per_radio *
+        (7 + bench_tree_topo.sta_per_bss * 7)));
+
+    return root;
+}
+
+unsigned int agents_for(unsigned int num_nodes)
+{
+    unsigned int per_agent = 5 + bench_tree_topo.radios_per_agent * (8 + bench_tree_topo.bss_per_radio *
+        (7 + bench_tree_topo.sta_per_bss * 7));
+
+    return (num_nodes + per_agent - 1) / per_agent;
+}
+
+} // namespace
+
+// The refresh as the CLI did it on every tick: a fresh display clone of the fetched tree, then rendered
+static void BM_NetTreeRefreshRebuild(benchmark::State& state)
+{
+    em_network_node_t *fetched, *displayed;
+    unsigned int num_nodes;
+    char *str;
+
+    fetched = make_tree(agents_for(static_cast<unsigned int> (state.range(0))), 0, &num_nodes);
+
+    for (auto _ : state) {
+        displayed = em_net_node_t::clone_network_tree_for_display(fetched, NULL, 0xffff, false);
+        str = em_net_node_t::get_network_tree_string(displayed);
+        benchmark::DoNotOptimize(str);
+        em_net_node_t::free_network_tree_string(str);
+        em_net_node_t::free_network_tree(displayed);
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+    state.SetLabel(std::to_string(num_nodes) + " nodes");
+
+    em_net_node_t::free_network_tree(fetched);
+}
+BENCHMARK(BM_NetTreeRefreshRebuild)->Arg(10000);
+
+// The same refresh merged into the current tree, range(1) is 0 for an unchanged fetch, 1 for one changed STA
+static void BM_NetTreeRefreshMerge(benchmark::State& state)
+{
+    em_network_node_t *current, *fetched[2];
+    unsigned int num_nodes, num_agents, n = 0;
+
+    num_agents = agents_for(static_cast<unsigned int> (state.range(0)));
+    current = make_tree(num_agents, 0, &num_nodes);
+    fetched[0] = make_tree(num_agents, 0, &num_nodes);
+    fetched[1] = make_tree(num_agents, static_cast<unsigned int> (state.range(1)), &num_nodes);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(em_net_node_t::merge_network_tree(current, fetched[++n & 1]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+    state.SetLabel(std::to_string(num_nodes) + " nodes");
+
+    em_net_node_t::free_network_tree(fetched[1]);
+    em_net_node_t::free_network_tree(fetched[0]);
+    em_net_node_t::free_network_tree(current);
+}
+BENCHMARK(BM_NetTreeRefreshMerge)->Args({10000, 0})->Args({10000, 1});
+
+// Rendering alone, linear in the size of the output
+static void BM_NetTreeRender(benchmark::State& state)
+{
+    em_network_node_t *tree;
+    unsigned int num_nodes;
+    size_t bytes = 0;
+    char *str;
+
+    tree = make_tree(agents_for(static_cast<unsigned int> (state.range(0))), 0, &num_nodes);
+
+    for (auto _ : state) {
+        str = em_net_node_t::get_network_tree_string(tree);
+        bytes += strlen(str);
+        em_net_node_t::free_network_tree_string(str);
+    }
+    state.SetBytesProcessed(static_cast<int64_t> (bytes));
+    state.SetLabel(std::to_string(num_nodes) + " nodes");
+
+    em_net_node_t::free_network_tree(tree);
+}
+BENCHMARK(BM_NetTreeRender)->Arg(1000)->Arg(10000);
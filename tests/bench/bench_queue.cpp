@@ -0,0 +1,68 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "em_mgr.h"
+#include "bench_common.h"
+
+// Push/pop of pre-allocated events, the cost of the queue and its lock only
+static void BM_MgrQueuePushPop(benchmark::State& state)
+{
+    bench_mgr_t mgr;
+    std::vector<em_event_t> events(static_cast<size_t> (state.range(0)));
+    em_event_t *evt;
+    size_t i;
+
+    mgr.init("");
+
+    for (auto _ : state) {
+        for (i = 0; i < events.size(); i++) {
+            mgr.push_to_queue(&events[i]);
+        }
+        while ((evt = mgr.pop_from_queue()) != NULL) {
+            benchmark::DoNotOptimize(evt);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MgrQueuePushPop)->Arg(1)->Arg(64)->Arg(1024);
+
+// Same path the bus and protocol handlers take: allocate a full size event, queue, dispatch, free
+static void BM_MgrQueueIoProcess(benchmark::State& state)
+{
+    bench_mgr_t mgr;
+    unsigned char data[256];
+    em_event_t *evt;
+
+    mgr.init("");
+    memset(data, 0x5a, sizeof(data));
+
+    for (auto _ : state) {
+        mgr.io_process(em_bus_event_type_dev_test, data, sizeof(data));
+        while ((evt = mgr.pop_from_queue()) != NULL) {
+            mgr.handle_event(evt);
+            free(evt);
+        }
+    }
+    state.counters["handled"] = mgr.m_handled;
+}
+BENCHMARK(BM_MgrQueueIoProcess);
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "em_steer_engine.h"
+#include "bench_common.h"
+
+namespace {
+
+#define BENCH_STEER_STAS_PER_BSS    32
+
+/**
+ * A network of one BSS per radio, 32 STAs associated to each. Every STA has a beacon report
+ * holding its own BSS and the two next ones, and a link RCPI above the policy threshold, so the
+ * reports are evaluated in full without ever producing a decision.
+ */
+struct bench_steer_env_t {
+    unsigned int num_bss;
+    std::vector<unsigned char> elems;
+};
+
+void make_beacon_elem(unsigned char *elem, const unsigned char *bssid, unsigned char rcpi)
+{
+    memset(elem, 0, 31);
+    elem[0] = 39;           // Measurement Report
+    elem[1] = 29;
+    elem[4] = 5;            // Beacon
+    elem[5 + 13] = rcpi;
+    memcpy(&elem[5 + 15], bssid, sizeof(mac_address_t));
+}
+
+void env_init(em_steer_engine_t& engine, bench_steer_env_t& env, unsigned int num_stas)
+{
+    mac_address_t bssid, ruid, sta;
+    em_policy_t policy;
+    unsigned int i, b;
+
+    env.num_bss = (num_stas + BENCH_STEER_STAS_PER_BSS - 1) / BENCH_STEER_STAS_PER_BSS;
+
+    memset(&policy, 0, sizeof(em_policy_t));
+    policy.id.type = em_policy_id_type_steering_param;
+    memset(policy.id.radio_mac, 0xff, sizeof(mac_address_t));
+    policy.policy = em_steering_policy_type_rcpi_allowed;
+    policy.util_threshold = 200;
+    policy.rcpi_threshold = 100;
+
+    engine.begin_sync();
+    engine.observe_policy(&policy);
+    for (b = 0; b < env.num_bss; b++) {
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, b);
+        bench_dm_gen_t::make_mac(ruid, bench_mac_kind_radio, b);
+        engine.observe_bss(bssid, ruid, 115, 36);
+    }
+    for (i = 0; i < num_stas; i++) {
+        bench_dm_gen_t::make_mac(sta, bench_mac_kind_sta, i);
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, i / BENCH_STEER_STAS_PER_BSS);
+        engine.observe_sta(sta, bssid);
+    }
+    engine.end_sync();
+
+    env.elems.assign(3 * 31, 0);
+    for (i = 0; i < num_stas; i++) {
+        bench_dm_gen_t::make_mac(sta, bench_mac_kind_sta, i);
+        for (b = 0; b < 3; b++) {
+            bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, (i / BENCH_STEER_STAS_PER_BSS + b) % env.num_bss);
+            make_beacon_elem(&env.elems[b * 31], bssid, static_cast<unsigned char> (150 - 10 * b));
+        }
+        engine.update_beacon_report(sta, env.elems.data(), static_cast<unsigned int> (env.elems.size()));
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, i / BENCH_STEER_STAS_PER_BSS);
+        engine.update_sta_link(sta, bssid, 150);
+    }
+}
+
+int apply_steer(const em_steer_req_params_t *req)
+{
+    benchmark::DoNotOptimize(req);
+    return 0;
+}
+
+} // namespace
+
+// One Associated STA Link Metrics sample: re-evaluates its STA only
+static void BM_SteerLinkSample(benchmark::State& state)
+{
+    em_steer_engine_t engine(apply_steer);
+    bench_steer_env_t env;
+    mac_address_t sta, bssid;
+    unsigned int i = 0, num = static_cast<unsigned int> (state.range(0));
+
+    env_init(engine, env, num);
+
+    for (auto _ : state) {
+        bench_dm_gen_t::make_mac(sta, bench_mac_kind_sta, i);
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, i / BENCH_STEER_STAS_PER_BSS);
+        engine.update_sta_link(sta, bssid, static_cast<unsigned char> (140 + (i & 7)));
+        i = (i + 1) % num;
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+}
+BENCHMARK(BM_SteerLinkSample)->Arg(1000)->Arg(10000);
+
+// One AP Metrics report: re-evaluates the STAs associated to the BSS or holding it as a candidate
+static void BM_SteerApMetrics(benchmark::State& state)
+{
+    em_steer_engine_t engine(apply_steer);
+    bench_steer_env_t env;
+    mac_address_t bssid;
+    unsigned long long evaluated;
+    unsigned int b = 0, n = 0;
+
+    env_init(engine, env, static_cast<unsigned int> (state.range(0)));
+    evaluated = engine.get_stats()->evaluated;
+
+    for (auto _ : state) {
+        bench_dm_gen_t::make_mac(bssid, bench_mac_kind_bss, b);
+        engine.update_bss_metrics(bssid, static_cast<unsigned char> (50 + ((n++ / env.num_bss) & 1)));
+        b = (b + 1) % env.num_bss;
+    }
+    state.SetItemsProcessed(static_cast<int64_t> (state.iterations()));
+    state.SetLabel(std::to_string((engine.get_stats()->evaluated - evaluated) / std::max<unsigned int> (n, 1)) + " stas/report");
+}
+BENCHMARK(BM_SteerApMetrics)->Arg(1000)->Arg(10000);
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+
+#include "em_disc_sched.h"
+#include "bench_common.h"
+
+namespace {
+
+#define BENCH_TOPO_DISC_NODES       100
+#define BENCH_TOPO_DISC_MINUTES     60
+#define BENCH_TOPO_DISC_FLAP_PCT    10      // nodes whose backhaul link flaps
+#define BENCH_TOPO_DISC_FLAP_S      20      // seconds between two flaps
+#define BENCH_TOPO_DISC_DOWN        2       // nodes powered off for five minutes in the middle of the run
+
+/**
+ * A mesh of 100 agents simulated one virtual second at a time. A flapping node changes its topology,
+ * and sends a Topology Notification, every BENCH_TOPO_DISC_FLAP_S seconds; the other nodes never
+ * change. Every query answered costs two CMDUs and a response that differs from the last one of its
+ * node costs a topology rebuild.
+ */
+struct bench_topo_disc_load_t {
+    unsigned long long cmdus = 0;
+    unsigned long long rebuilds = 0;
+    unsigned long long losses = 0;
+};
+
+bool node_is_up(unsigned int node, unsigned int t)
+{
+    return (node >= BENCH_TOPO_DISC_DOWN) || (t < BENCH_TOPO_DISC_MINUTES * 30) ||
+        (t >= BENCH_TOPO_DISC_MINUTES * 30 + 300);
+}
+
+bool node_flaps(unsigned int node)
+{
+    return (node % (100 / BENCH_TOPO_DISC_FLAP_PCT)) == (100 / BENCH_TOPO_DISC_FLAP_PCT) - 1;
+}
+
+unsigned long long node_topology(unsigned int node, unsigned int t)
+{
+    return (static_cast<unsigned long long> (node) << 1) | ((node_flaps(node) == true) ? ((t / BENCH_TOPO_DISC_FLAP_S) & 1):0);
+}
+
+void add_notifications(unsigned int t, bench_topo_disc_load_t& load, em_disc_sched_t *sched)
+{
+    mac_address_t al;
+    unsigned int n;
+
+    if ((t == 0) || ((t % BENCH_TOPO_DISC_FLAP_S) != 0)) {
+        return;
+    }
+
+    for (n = 0; n < BENCH_TOPO_DISC_NODES; n++) {
+        if ((node_flaps(n) == true) && (node_is_up(n, t) == true)) {
+            load.cmdus++;
+            if (sched != NULL) {
+                bench_dm_gen_t::make_mac(al, bench_mac_kind_agent, n);
+                sched->notify(al, static_cast<unsigned long long> (t) * 1000);
+            }
+        }
+    }
+}
+
+// every node queried every EM_DISC_MIN_INTERVAL_MS and every response rebuilt
+void run_fixed(bench_topo_disc_load_t& load)
+{
+    unsigned int t, n;
+
+    for (t = 0; t < BENCH_TOPO_DISC_MINUTES * 60; t++) {
+        add_notifications(t, load, NULL);
+        for (n = 0; n < BENCH_TOPO_DISC_NODES; n++) {
+            if (((t * 1000 + n * 50) % EM_DISC_MIN_INTERVAL_MS) >= 1000) {
+                continue;
+            }
+            load.cmdus++;
+            if (node_is_up(n, t) == true) {
+                load.cmdus++;
+                load.rebuilds++;
+            }
+        }
+    }
+}
+
+void run_scheduled(bench_topo_disc_load_t& load)
+{
+    em_disc_sched_t sched;
+    std::vector<em_disc_probe_t> probe, lost;
+    unsigned long long now;
+    unsigned int t, n;
+
+    for (t = 0; t < BENCH_TOPO_DISC_MINUTES * 60; t++) {
+        now = static_cast<unsigned long long> (t) * 1000;
+        for (n = 0; n < BENCH_TOPO_DISC_NODES; n++) {
+            mac_address_t al;
+
+            bench_dm_gen_t::make_mac(al, bench_mac_kind_agent, n);
+            sched.observe(al, now);
+        }
+        sched.sweep();
+        add_notifications(t, load, &sched);
+
+        probe.clear();
+        lost.clear();
+        sched.run(now, &probe, &lost);
+        load.losses += lost.size();
+        for (auto& p : probe) {
+            n = (static_cast<unsigned int> (p.al[4]) << 8) | p.al[5];
+            load.cmdus++;
+            if (node_is_up(n, t) == false) {
+                continue;
+            }
+            load.cmdus++;
+            if (sched.heard(p.al, node_topology(n, t), now) == true) {
+                load.rebuilds++;
+            }
+        }
+    }
+}
+
+void set_counters(benchmark::State& state, const bench_topo_disc_load_t& load)
+{
+    double iterations = static_cast<double> (state.iterations());
+
+    state.counters["cmdus/min"] = static_cast<double> (load.cmdus) / iterations / BENCH_TOPO_DISC_MINUTES;
+    state.counters["rebuilds/min"] = static_cast<double> (load.rebuilds) / iterations / BENCH_TOPO_DISC_MINUTES;
+    state.counters["losses"] = static_cast<double> (load.losses) / iterations;
+}
+
+} // namespace
+
+// One virtual hour of a 100 node mesh probed at a fixed cadence, the baseline of BM_TopoDiscScheduled
+static void BM_TopoDiscFixed(benchmark::State& state)
+{
+    bench_topo_disc_load_t load;
+
+    for (auto _ : state) {
+        run_fixed(load);
+    }
+    set_counters(state, load);
+}
+BENCHMARK(BM_TopoDiscFixed)->Unit(benchmark::kMillisecond);
+
+// The same hour with per node backoff, notifications re-probe right away and unchanged responses are not rebuilt
+static void BM_TopoDiscScheduled(benchmark::State& state)
+{
+    bench_topo_disc_load_t load;
+
+    for (auto _ : state) {
+        run_scheduled(load);
+    }
+    set_counters(state, load);
+}
+BENCHMARK(BM_TopoDiscScheduled)->Unit(benchmark::kMillisecond);
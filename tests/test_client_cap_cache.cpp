@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include "em_client_cap_cache.h"
+
+TEST(EmClientCapCacheTest, TestCoalescesQueriesPerAgent) {
+    em_client_cap_cache_t cache;
+    const mac_address_t sta = {0x3c, 0x22, 0xfb, 0x10, 0x00, 0x07};
+    const mac_address_t agent = {0x00, 0x50, 0xf2, 0x00, 0x01, 0x00};
+    const mac_address_t other_agent = {0x00, 0x50, 0xf2, 0x00, 0x02, 0x00};
+    const mac_address_t ruid = {0x00, 0x50, 0xf2, 0x00, 0x01, 0x10};
+    const bssid_t bss_2g = {0x00, 0x50, 0xf2, 0x00, 0x01, 0x11};
+    const bssid_t bss_5g = {0x00, 0x50, 0xf2, 0x00, 0x01, 0x21};
+    const unsigned char report[] = {0x31, 0x04, 0x0a, 0x00, 0x00, 0x04, 'h', 'o', 'm', 'e'};
+    em_client_cap_body_t body;
+    std::vector<em_client_cap_waiter_t> waiters;
+
+    // The first association queries, the next ones on the same agent wait for its report
+    EXPECT_EQ(cache.lookup(sta, agent, bss_2g, ruid, &body), em_client_cap_lookup_miss);
+    EXPECT_EQ(cache.lookup(sta, agent, bss_2g, ruid, &body), em_client_cap_lookup_pending);
+    EXPECT_EQ(cache.lookup(sta, agent, bss_5g, ruid, &body), em_client_cap_lookup_pending);
+
+    // Another agent has its own query
+    EXPECT_EQ(cache.lookup(sta, other_agent, bss_2g, ruid, &body), em_client_cap_lookup_miss);
+    EXPECT_EQ(cache.get_stats()->num_pending, 2u);
+    EXPECT_EQ(cache.get_stats()->coalesced, 2u);
+
+    EXPECT_TRUE(cache.update(sta, agent, report, sizeof(report), &body, &waiters));
+    ASSERT_EQ(waiters.size(), 2u);
+    EXPECT_EQ(memcmp(waiters[0].bssid, bss_2g, sizeof(bssid_t)), 0);
+    EXPECT_EQ(memcmp(waiters[1].bssid, bss_5g, sizeof(bssid_t)), 0);
+    EXPECT_EQ(memcmp(waiters[1].ruid, ruid, sizeof(mac_address_t)), 0);
+    EXPECT_EQ(cache.get_stats()->num_pending, 1u);
+}
+
+TEST(EmClientCapCacheTest, TestAnswersFromFreshCapabilities) {
+    em_client_cap_cache_t cache;
+    const mac_address_t sta = {0xa4, 0x83, 0xe7, 0x5c, 0x19, 0x02};
+    const mac_address_t agent = {0x02, 0x10, 0x18, 0x00, 0x00, 0x01};
+    const mac_address_t roamed_to = {0x02, 0x10, 0x18, 0x00, 0x00, 0x02};
+    const mac_address_t ruid = {0x02, 0x10, 0x18, 0x00, 0x01, 0x00};
+    const bssid_t bss = {0x02, 0x10, 0x18, 0x00, 0x01, 0x01};
+    const unsigned char report[] = {0x11, 0x14, 0x0a, 0x00, 0x00, 0x03, 'l', 'a', 'b', 0x01, 0x02, 0x82, 0x84};
+    em_client_cap_body_t body, shared;
+    std::vector<em_client_cap_waiter_t> waiters;
+
+    EXPECT_EQ(cache.lookup(sta, agent, bss, ruid, &body), em_client_cap_lookup_miss);
+    EXPECT_TRUE(cache.update(sta, agent, report, sizeof(report), &shared, &waiters));
+    EXPECT_EQ(waiters.size(), 1u);
+
+    // Roaming to another agent within the TTL needs no query, the body is the one already held
+    EXPECT_EQ(cache.lookup(sta, roamed_to, bss, ruid, &body), em_client_cap_lookup_hit);
+    EXPECT_EQ(body, shared);
+    ASSERT_EQ(body->size(), sizeof(report));
+    EXPECT_EQ(memcmp(body->data(), report, sizeof(report)), 0);
+    EXPECT_EQ(cache.get_stats()->hits, 1u);
+    EXPECT_EQ(cache.get_stats()->misses, 1u);
+}
+
+TEST(EmClientCapCacheTest, TestKeepsTheBodyOfRepeatedReports) {
+    em_client_cap_cache_t cache;
+    const mac_address_t sta = {0x00, 0x1a, 0x11, 0x42, 0x00, 0x99};
+    const mac_address_t agent = {0x00, 0x1a, 0x11, 0x00, 0x00, 0x01};
+    const mac_address_t other_agent = {0x00, 0x1a, 0x11, 0x00, 0x00, 0x02};
+    unsigned char report[] = {0x31, 0x04, 0x0a, 0x00, 0x00, 0x02, 'a', 'p', 0x01, 0x01, 0x8c};
+    em_client_cap_body_t first, second;
+    std::vector<em_client_cap_waiter_t> waiters;
+
+    // Reports nobody waited for are still cached
+    EXPECT_TRUE(cache.update(sta, agent, report, sizeof(report), &first, &waiters));
+    EXPECT_FALSE(cache.update(sta, other_agent, report, sizeof(report), &second, &waiters));
+    EXPECT_EQ(first.get(), second.get());
+
+    // One changed rate is new capabilities
+    report[sizeof(report) - 1] = 0x98;
+    EXPECT_TRUE(cache.update(sta, agent, report, sizeof(report), &second, &waiters));
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(cache.get_stats()->unchanged, 1u);
+    EXPECT_EQ(cache.get_stats()->changed, 2u);
+    EXPECT_EQ(cache.get_stats()->num_stas, 1u);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "db_client.h"
+
+namespace {
+
+class DbRowTest : public ::testing::Test {
+protected:
+    const char *m_cols[6] = {"aa:bb:cc:dd:ee:0f", "-42", NULL, "0a1B2c", "AABBCCDDEEFF", "not:a:mac:at:all:!"};
+    unsigned long m_lengths[6];
+    db_row_t m_row;
+
+    void SetUp() override {
+        for (unsigned int i = 0; i < 6; i++) {
+            m_lengths[i] = (m_cols[i] != NULL) ? strlen(m_cols[i]):0;
+        }
+        m_row.set(m_cols, m_lengths, 6);
+    }
+};
+
+TEST_F(DbRowTest, DecodesMacAddresses) {
+    unsigned char mac[6];
+    const unsigned char colon[6] = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0x0f};
+    const unsigned char plain[6] = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    const unsigned char zero[6] = {0};
+
+    EXPECT_EQ(m_row.get_mac(1, mac), 0);
+    EXPECT_EQ(memcmp(mac, colon, sizeof(mac)), 0);
+    EXPECT_EQ(m_row.get_mac(5, mac), 0);
+    EXPECT_EQ(memcmp(mac, plain, sizeof(mac)), 0);
+
+    // malformed and NULL values leave a zero address, as an empty string did with string_to_macbytes()
+    EXPECT_EQ(m_row.get_mac(6, mac), -1);
+    EXPECT_EQ(memcmp(mac, zero, sizeof(mac)), 0);
+    EXPECT_EQ(m_row.get_mac(3, mac), -1);
+    EXPECT_EQ(memcmp(mac, zero, sizeof(mac)), 0);
+}
+
+TEST_F(DbRowTest, DecodesNumbersAndNulls) {
+    EXPECT_EQ(m_row.get_number(2), -42);
+    EXPECT_EQ(m_row.get_number(3), 0);
+    EXPECT_EQ(m_row.get_number(7), 0);
+    EXPECT_EQ(m_row.get_number(0), 0);
+}
+
+TEST_F(DbRowTest, CopiesStringsBounded) {
+    char str[8];
+
+    memset(str, 'x', sizeof(str));
+    EXPECT_STREQ(m_row.get_string(1, str, sizeof(str)), "aa:bb:c");
+    EXPECT_STREQ(m_row.get_string(2, str, sizeof(str)), "-42");
+    EXPECT_STREQ(m_row.get_string(3, str, sizeof(str)), "");
+}
+
+TEST_F(DbRowTest, DecodesHex) {
+    unsigned char buff[8];
+    const unsigned char expected[3] = {0x0a, 0x1b, 0x2c};
+
+    EXPECT_EQ(m_row.get_hex(4, buff, sizeof(buff)), 3u);
+    EXPECT_EQ(memcmp(buff, expected, sizeof(expected)), 0);
+    EXPECT_EQ(m_row.get_hex(4, buff, 2), 2u);
+    EXPECT_EQ(m_row.get_hex(3, buff, sizeof(buff)), 0u);
+}
+
+} // namespace
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <vector>
+
+#include "em_disc_sched.h"
+
+// Runs the scheduler every second from @p from to @p to, returns the probes sent
+static unsigned int run(em_disc_sched_t& sched, unsigned long long from, unsigned long long to, std::vector<em_disc_probe_t> *lost)
+{
+    std::vector<em_disc_probe_t> probe;
+    unsigned long long t;
+    unsigned int num = 0;
+
+    for (t = from; t < to; t += 1000) {
+        probe.clear();
+        num += sched.run(t, &probe, lost);
+    }
+
+    return num;
+}
+
+// Topology Response frame from @p src with message id @p mid, one Device Information TLV holding @p al
+static std::vector<unsigned char> make_resp(const mac_address_t src, unsigned short mid, const mac_address_t al, unsigned int pad)
+{
+    std::vector<unsigned char> frame(sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t) + 2 * sizeof(em_tlv_t) + sizeof(mac_address_t) + pad, 0);
+    em_raw_hdr_t *hdr = reinterpret_cast<em_raw_hdr_t *>(frame.data());
+    em_cmdu_t *cmdu = reinterpret_cast<em_cmdu_t *>(frame.data() + sizeof(em_raw_hdr_t));
+    em_tlv_t *tlv = reinterpret_cast<em_tlv_t *>(frame.data() + sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
+
+    memcpy(hdr->src, src, sizeof(mac_address_t));
+    hdr->type = htons(ETH_P_1905);
+    cmdu->type = htons(em_msg_type_topo_resp);
+    cmdu->id = htons(mid);
+    cmdu->last_frag_ind = 1;
+
+    tlv->type = em_tlv_type_device_info;
+    tlv->len = htons(sizeof(mac_address_t));
+    memcpy(tlv->value, al, sizeof(mac_address_t));
+
+    // End of Message, the padding after it stays zero
+    tlv = reinterpret_cast<em_tlv_t *>(tlv->value + sizeof(mac_address_t));
+    tlv->type = em_tlv_type_eom;
+    tlv->len = 0;
+
+    return frame;
+}
+
+TEST(EmDiscSchedTest, TestHashesOnlyTheTlvs) {
+    const mac_address_t src = {0x02, 0x42, 0xac, 0x11, 0x00, 0x02};
+    const mac_address_t relay = {0x02, 0x42, 0xac, 0x11, 0x00, 0x03};
+    const mac_address_t al = {0x02, 0x42, 0xac, 0x11, 0x00, 0x10};
+    const mac_address_t moved_al = {0x02, 0x42, 0xac, 0x11, 0x00, 0x11};
+    std::vector<unsigned char> first = make_resp(src, 0x0101, al, 0);
+    std::vector<unsigned char> next = make_resp(relay, 0x0102, al, 0);
+    std::vector<unsigned char> padded = make_resp(src, 0x0103, al, 30);
+    std::vector<unsigned char> changed = make_resp(src, 0x0101, moved_al, 0);
+    unsigned long long h = em_disc_sched_t::hash(first.data(), static_cast<unsigned int>(first.size()));
+
+    // Another message id, source or frame padding is the same topology
+    EXPECT_EQ(em_disc_sched_t::hash(next.data(), static_cast<unsigned int>(next.size())), h);
+    EXPECT_EQ(em_disc_sched_t::hash(padded.data(), static_cast<unsigned int>(padded.size())), h);
+
+    // One byte of a TLV is not
+    EXPECT_NE(em_disc_sched_t::hash(changed.data(), static_cast<unsigned int>(changed.size())), h);
+
+    // A frame cut inside its TLVs hashes what it holds
+    EXPECT_NE(em_disc_sched_t::hash(first.data(), static_cast<unsigned int>(first.size() - 4)), h);
+}
+
+TEST(EmDiscSchedTest, TestBacksOffWhileTheTopologyIsUnchanged) {
+    em_disc_sched_t sched;
+    const mac_address_t al = {0x00, 0x10, 0x18, 0xaa, 0x00, 0x01};
+    std::vector<em_disc_probe_t> lost;
+
+    EXPECT_TRUE(sched.heard(al, 0x1234, 0));
+    EXPECT_EQ(run(sched, 0, EM_DISC_MIN_INTERVAL_MS + 1000, &lost), 1u);
+
+    // Each identical response doubles the interval
+    EXPECT_FALSE(sched.heard(al, 0x1234, EM_DISC_MIN_INTERVAL_MS));
+    EXPECT_EQ(run(sched, EM_DISC_MIN_INTERVAL_MS + 1000, 3 * EM_DISC_MIN_INTERVAL_MS, &lost), 0u);
+    EXPECT_EQ(run(sched, 3 * EM_DISC_MIN_INTERVAL_MS, 3 * EM_DISC_MIN_INTERVAL_MS + 1000, &lost), 1u);
+
+    EXPECT_FALSE(sched.heard(al, 0x1234, 3 * EM_DISC_MIN_INTERVAL_MS));
+    EXPECT_EQ(sched.get_stats()->unchanged, 2u);
+    EXPECT_TRUE(lost.empty());
+}
+
+TEST(EmDiscSchedTest, TestReprobesOnChangeAndNotification) {
+    em_disc_sched_t sched;
+    const mac_address_t al = {0x3c, 0x7c, 0x3f, 0x00, 0x20, 0x01};
+    std::vector<em_disc_probe_t> lost;
+
+    EXPECT_TRUE(sched.heard(al, 0xbeef, 0));
+    EXPECT_FALSE(sched.heard(al, 0xbeef, 0));
+
+    // A notification is probed on the next run, a changed response restarts from the shortest interval
+    sched.notify(al, 1000);
+    EXPECT_EQ(run(sched, 1000, 2000, &lost), 1u);
+    EXPECT_TRUE(sched.heard(al, 0xcafe, 1000));
+    EXPECT_EQ(run(sched, 2000, 1000 + EM_DISC_MIN_INTERVAL_MS, &lost), 0u);
+    EXPECT_EQ(run(sched, 1000 + EM_DISC_MIN_INTERVAL_MS, 2000 + EM_DISC_MIN_INTERVAL_MS, &lost), 1u);
+    EXPECT_EQ(sched.get_stats()->notified, 1u);
+    EXPECT_EQ(sched.get_stats()->changed, 2u);
+}
+
+TEST(EmDiscSchedTest, TestDeclaresLossAfterMissedProbes) {
+    em_disc_sched_t sched;
+    const mac_address_t al = {0xb0, 0xbe, 0x76, 0x00, 0x00, 0x7f};
+    std::vector<em_disc_probe_t> lost;
+    unsigned long long now;
+    unsigned int probes = 0;
+
+    sched.observe(al, 0);
+    for (now = 0; lost.empty() && (now < 60000); now += 1000) {
+        probes += run(sched, now, now + 1000, &lost);
+    }
+    ASSERT_EQ(lost.size(), 1u);
+    EXPECT_EQ(probes, EM_DISC_MAX_MISSED + 1u);
+    EXPECT_EQ(memcmp(lost[0].al, al, sizeof(mac_address_t)), 0);
+    EXPECT_EQ(sched.get_stats()->num_lost, 1u);
+
+    // Any response brings it back, as a change
+    EXPECT_TRUE(sched.heard(al, 0x1, now));
+    EXPECT_EQ(sched.get_stats()->recoveries, 1u);
+    EXPECT_EQ(sched.get_stats()->num_lost, 0u);
+}
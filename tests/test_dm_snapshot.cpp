@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "em.h"
+#include "em_dm_snapshot.h"
+#include "em_metrics_store.h"
+
+// Segment of its own for @p test, away from the one of a running controller and from other test runs
+static std::string make_name(const char *test)
+{
+    char name[64];
+
+    snprintf(name, sizeof(name), "/em_dm_snapshot_test_%d_%s", static_cast<int> (getpid()), test);
+
+    return name;
+}
+
+// STAList of a data model, its clients encoded the way the get command does
+static std::string render_sta_list(dm_easy_mesh_t& dm)
+{
+    cJSON *list = cJSON_CreateArray(), *obj;
+    dm_sta_t *sta;
+    char *str;
+    std::string doc;
+
+    sta = static_cast<dm_sta_t *> (hash_map_get_first(dm.m_sta_map));
+    while (sta != NULL) {
+        obj = cJSON_CreateObject();
+        sta->encode(obj);
+        cJSON_AddItemToArray(list, obj);
+        sta = static_cast<dm_sta_t *> (hash_map_get_next(dm.m_sta_map, sta));
+    }
+    str = cJSON_PrintUnformatted(list);
+    doc = str;
+    cJSON_free(str);
+    cJSON_Delete(list);
+
+    return doc;
+}
+
+// Whether the controller renders @p name again once @p changed_cfg tables changed
+static bool is_rendered(const char *name, unsigned int changed_cfg)
+{
+    const em_dm_snapshot_subdoc_t *subdoc;
+    unsigned int i;
+
+    for (i = 0; (subdoc = em_dm_snapshot_t::get_subdoc(i)) != NULL; i++) {
+        if (strcmp(subdoc->name, name) == 0) {
+            return em_dm_snapshot_t::is_changed(subdoc, changed_cfg);
+        }
+    }
+
+    return false;
+}
+
+TEST(EmDmSnapshotTest, TestRewritesOnlyChangedSubdocs) {
+    std::string name = make_name("changed");
+    em_dm_snapshot_t writer(name.c_str());
+    em_dm_snapshot_t reader(name.c_str());
+    std::vector<char> buff(EM_DM_SNAPSHOT_SLOT_SZ);
+    unsigned long long epoch = 0;
+
+    ASSERT_EQ(writer.create(), 0);
+    EXPECT_EQ(writer.publish("DeviceList", "OneWifiMesh", "{\"ID\":\"OneWifiMesh\"}"), 1);
+    EXPECT_EQ(writer.publish("RadioList", "OneWifiMesh", "{\"RadioList\":[]}"), 1);
+    writer.commit(true);
+
+    EXPECT_EQ(writer.publish("DeviceList", "OneWifiMesh", "{\"ID\":\"OneWifiMesh\"}"), 0);
+    EXPECT_EQ(writer.publish("RadioList", "OneWifiMesh", "{\"RadioList\":[{\"Enabled\":true}]}"), 1);
+    writer.commit(true);
+
+    ASSERT_EQ(reader.read("DeviceList", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size()), &epoch), 21);
+    EXPECT_STREQ(buff.data(), "{\"ID\":\"OneWifiMesh\"}");
+    EXPECT_EQ(epoch, 1u);
+    ASSERT_GT(reader.read("RadioList", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size()), &epoch), 0);
+    EXPECT_STREQ(buff.data(), "{\"RadioList\":[{\"Enabled\":true}]}");
+    EXPECT_EQ(epoch, 2u);
+
+    EXPECT_EQ(writer.get_stats()->published, 3u);
+    EXPECT_EQ(writer.get_stats()->unchanged, 1u);
+}
+
+TEST(EmDmSnapshotTest, TestTellsWhetherAnyoneReads) {
+    std::string name = make_name("readers");
+    em_dm_snapshot_t writer(name.c_str());
+    em_dm_snapshot_t cli(name.c_str());
+    em_dm_snapshot_t other_cli(name.c_str());
+    em_dm_snapshot_t elsewhere(make_name("elsewhere").c_str());
+
+    ASSERT_EQ(writer.create(), 0);
+    EXPECT_FALSE(writer.has_readers());
+
+    // A reader of another segment does not count
+    EXPECT_EQ(elsewhere.open(), -1);
+    EXPECT_FALSE(writer.has_readers());
+
+    ASSERT_EQ(cli.open(), 0);
+    ASSERT_EQ(other_cli.open(), 0);
+    EXPECT_TRUE(writer.has_readers());
+    cli.close();
+    EXPECT_TRUE(writer.has_readers());
+    other_cli.close();
+    EXPECT_FALSE(writer.has_readers());
+    EXPECT_EQ(writer.get_stats()->unread, 3u);
+
+    // Readers only probe, they never take the segment over
+    EXPECT_FALSE(cli.has_readers());
+}
+
+TEST(EmDmSnapshotTest, TestFallsBackUntilPublished) {
+    std::string name = make_name("fallback");
+    em_dm_snapshot_t writer(name.c_str());
+    em_dm_snapshot_t reader(name.c_str());
+    std::vector<char> buff(EM_DM_SNAPSHOT_SLOT_SZ);
+    char small[4];
+
+    // No segment yet
+    EXPECT_EQ(reader.read("Policy", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size())), -1);
+
+    ASSERT_EQ(writer.create(), 0);
+    EXPECT_EQ(writer.publish("Policy", "OneWifiMesh", "{\"Policy\":{}}"), 1);
+    writer.commit(true);
+
+    EXPECT_EQ(reader.read("Policy", "OtherMesh", buff.data(), static_cast<unsigned int> (buff.size())), -1);
+    EXPECT_EQ(reader.read("STAList", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size())), -1);
+    EXPECT_EQ(reader.read("Policy", "OneWifiMesh", small, sizeof(small)), -1);
+    EXPECT_GT(reader.read("Policy", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size())), 0);
+
+    // A controller gone is a stale snapshot
+    writer.close();
+    EXPECT_EQ(reader.read("Policy", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size())), -1);
+}
+
+TEST(EmDmSnapshotTest, TestReadersNeverSeeATornSubdoc) {
+    std::string name = make_name("torn");
+    em_dm_snapshot_t writer(name.c_str());
+    em_dm_snapshot_t reader(name.c_str());
+    std::vector<char> buff(EM_DM_SNAPSHOT_SLOT_SZ);
+    std::atomic<bool> done(false);
+    std::string docs[2] = {std::string(64 * 1024, 'a'), std::string(32 * 1024, 'b')};
+    unsigned int reads = 0;
+    int len;
+
+    ASSERT_EQ(writer.create(), 0);
+    writer.publish("STAList", "OneWifiMesh", docs[0].c_str());
+    writer.commit(true);
+
+    std::thread controller([&]() {
+        for (unsigned int i = 1; i < 2000; i++) {
+            writer.publish("STAList", "OneWifiMesh", docs[i & 1].c_str());
+            writer.commit(true);
+        }
+        done = true;
+    });
+
+    while (done == false) {
+        if ((len = reader.read("STAList", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size()))) < 0) {
+            continue;
+        }
+        const std::string& doc = docs[(buff[0] == 'a') ? 0:1];
+        ASSERT_EQ(static_cast<size_t> (len), doc.size() + 1);
+        ASSERT_EQ(memcmp(buff.data(), doc.c_str(), doc.size() + 1), 0);
+        reads++;
+    }
+    controller.join();
+    EXPECT_GT(reads, 0u);
+}
+
+// A controller em whose metrics go to a store of the test, as they do once the manager has one
+class test_metrics_em_t : public em_t {
+public:
+    em_metrics_store_t *store;
+
+    em_metrics_store_t *get_metrics_store() override { return store; }
+
+    test_metrics_em_t(em_interface_t *ruid, dm_easy_mesh_t *dm, em_metrics_store_t *metrics) :
+        em_t(ruid, em_freq_band_5, dm, NULL, em_profile_type_3, em_service_type_ctrl), store(metrics) { }
+};
+
+TEST(EmDmSnapshotTest, TestStaMetricsRepublishStaList) {
+    const mac_address_t sta_mac = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+    const mac_address_t bssid = {0x02, 0x00, 0x00, 0x00, 0x10, 0x02};
+    std::string name = make_name("sta_metrics");
+    em_dm_snapshot_t writer(name.c_str());
+    em_dm_snapshot_t reader(name.c_str());
+    std::vector<char> buff(EM_DM_SNAPSHOT_SLOT_SZ);
+    std::vector<unsigned char> frame(sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t) + 2 * sizeof(em_tlv_t) +
+            sizeof(em_assoc_sta_link_metrics_t) + sizeof(em_assoc_link_metrics_t));
+    em_metrics_store_t store(nullptr);
+    em_interface_t ruid;
+    dm_easy_mesh_t dm;
+    em_assoc_sta_link_metrics_t *metrics;
+    em_cmdu_t *cmdu;
+    em_tlv_t *tlv;
+    dm_sta_t *sta;
+    unsigned int changed;
+
+    memset(&ruid, 0, sizeof(em_interface_t));
+    dm.init();
+    sta = new dm_sta_t();
+    memcpy(sta->m_sta_info.id, sta_mac, sizeof(mac_address_t));
+    memcpy(sta->m_sta_info.bssid, bssid, sizeof(mac_address_t));
+    sta->m_sta_info.associated = true;
+    sta->m_sta_info.rcpi = 100;
+    hash_map_put(dm.m_sta_map, strdup("10:20:30:40:50:60@02:00:00:00:10:02@00:00:00:00:00:00"), sta);
+
+    ASSERT_EQ(writer.create(), 0);
+    ASSERT_EQ(reader.open(), 0);
+    EXPECT_EQ(writer.publish("STAList", "OneWifiMesh", render_sta_list(dm).c_str()), 1);
+    writer.commit(true);
+
+    // Associated STA Link Metrics Response with a new RCPI for the client
+    cmdu = reinterpret_cast<em_cmdu_t *> (frame.data() + sizeof(em_raw_hdr_t));
+    cmdu->type = htons(em_msg_type_assoc_sta_link_metrics_rsp);
+    tlv = reinterpret_cast<em_tlv_t *> (frame.data() + sizeof(em_raw_hdr_t) + sizeof(em_cmdu_t));
+    tlv->type = em_tlv_type_assoc_sta_link_metric;
+    tlv->len = htons(sizeof(em_assoc_sta_link_metrics_t) + sizeof(em_assoc_link_metrics_t));
+    metrics = reinterpret_cast<em_assoc_sta_link_metrics_t *> (tlv->value);
+    memcpy(metrics->sta_mac, sta_mac, sizeof(mac_address_t));
+    metrics->num_bssids = 1;
+    memcpy(metrics->assoc_link_metrics[0].bssid, bssid, sizeof(bssid_t));
+    metrics->assoc_link_metrics[0].rcpi = 180;
+    tlv = reinterpret_cast<em_tlv_t *> (tlv->value + htons(tlv->len));
+    tlv->type = em_tlv_type_eom;
+
+    test_metrics_em_t em(&ruid, &dm, &store);
+    em.em_metrics_t::process_msg(frame.data(), static_cast<unsigned int> (frame.size()));
+
+    // The history went to the store, not to the database, yet the controller still sees a change
+    EXPECT_EQ(store.get_stats()->num_samples, 3u);
+    EXPECT_FALSE(dm.db_cfg_type_is_set(db_cfg_type_sta_metrics_update));
+    changed = dm.take_unsaved_cfg_type();
+    EXPECT_EQ(changed, static_cast<unsigned int> (db_cfg_type_sta_metrics_update));
+    EXPECT_EQ(dm.take_unsaved_cfg_type(), 0u);
+    ASSERT_TRUE(is_rendered("STAList", changed));
+    EXPECT_FALSE(is_rendered("DeviceList", changed));
+
+    EXPECT_EQ(writer.publish("STAList", "OneWifiMesh", render_sta_list(dm).c_str()), 1);
+    writer.commit(true);
+    ASSERT_GT(reader.read("STAList", "OneWifiMesh", buff.data(), static_cast<unsigned int> (buff.size())), 0);
+    EXPECT_NE(strstr(buff.data(), "\"RCPI\":180"), nullptr);
+    EXPECT_EQ(strstr(buff.data(), "\"RCPI\":100"), nullptr);
+
+    dm.deinit();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <thread>
+#include <chrono>
+
+#include "ec_session_cache.h"
+
+// Counts the release calls per key, a value must be released exactly once
+class ECSessionCacheTest : public ::testing::Test {
+protected:
+    std::map<uint64_t, int> released;
+
+    ec_session_cache_t<uint64_t, int>::release_func counter() {
+        return [this](const uint64_t& key, int&) { released[key]++; };
+    }
+
+    // Entries expire once idle for longer than the TTL, which is in whole seconds
+    static void wait_past_ttl() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    }
+};
+
+TEST_F(ECSessionCacheTest, EvictsLeastRecentlyUsed) {
+    ec_session_cache_t<uint64_t, int> cache(2, 0, counter());
+
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    ASSERT_NE(cache.find(1), nullptr);
+
+    // 2 is now the least recently used
+    cache.insert(3, 30);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_EQ(*cache.find(1), 10);
+    EXPECT_EQ(*cache.find(3), 30);
+
+    EXPECT_EQ(released.size(), 1u);
+    EXPECT_EQ(released[2], 1);
+    EXPECT_EQ(cache.get_stats().evictions, 1u);
+}
+
+TEST_F(ECSessionCacheTest, PinnedEntriesSurviveEviction) {
+    ec_session_cache_t<uint64_t, int> cache(2, 0, counter());
+
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    ASSERT_TRUE(cache.pin(1));
+    EXPECT_FALSE(cache.pin(9));
+
+    // 1 is the least recently used but pinned, 2 goes instead
+    cache.insert(3, 30);
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_EQ(released[2], 1);
+
+    // With every entry pinned the cache grows past its capacity rather than drop one
+    ASSERT_TRUE(cache.pin(3));
+    cache.insert(4, 40);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(released.count(1), 0u);
+    EXPECT_EQ(released.count(3), 0u);
+
+    // Once unpinned the entry is evictable again
+    cache.unpin(1);
+    cache.unpin(3);
+    cache.insert(5, 50);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(released[1], 1);
+    EXPECT_EQ(released[3], 1);
+}
+
+TEST_F(ECSessionCacheTest, ExpiredEntriesReleasedOnce) {
+    ec_session_cache_t<uint64_t, int> cache(8, 1, counter());
+
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    wait_past_ttl();
+
+    // Dropped by the lookup itself
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(released[1], 1);
+
+    // The rest on the next sweep, a second sweep and a clear find nothing left to release
+    cache.expire();
+    EXPECT_EQ(cache.size(), 0u);
+    cache.expire();
+    cache.clear();
+    EXPECT_EQ(released[1], 1);
+    EXPECT_EQ(released[2], 1);
+    EXPECT_EQ(cache.get_stats().expirations, 2u);
+
+    // An insert also sweeps expired entries before adding its own
+    cache.insert(3, 30);
+    wait_past_ttl();
+    cache.insert(4, 40);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(released[3], 1);
+    EXPECT_EQ(released.count(4), 0u);
+}
+
+TEST_F(ECSessionCacheTest, PinnedEntriesDoNotExpire) {
+    ec_session_cache_t<uint64_t, int> cache(8, 1, counter());
+
+    cache.insert(1, 10);
+    ASSERT_TRUE(cache.pin(1));
+    wait_past_ttl();
+
+    cache.expire();
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(released.count(1), 0u);
+
+    // Unpinning restarts the idle time rather than expiring it right away
+    cache.unpin(1);
+    cache.expire();
+    EXPECT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(released.count(1), 0u);
+}
+
+TEST_F(ECSessionCacheTest, ReleasesOnReplaceClearAndDestruction) {
+    {
+        ec_session_cache_t<uint64_t, int> cache(8, 0, counter());
+
+        cache.insert(1, 10);
+        cache.insert(2, 20);
+
+        // Replacing a value releases the old one and keeps the entry
+        cache.insert(1, 11);
+        EXPECT_EQ(released[1], 1);
+        EXPECT_EQ(*cache.find(1), 11);
+
+        // An erase releases even a pinned entry
+        cache.pin(2);
+        EXPECT_TRUE(cache.erase(2));
+        EXPECT_FALSE(cache.erase(2));
+        EXPECT_EQ(released[2], 1);
+
+        cache.insert(3, 30);
+        cache.clear();
+        EXPECT_EQ(cache.size(), 0u);
+        EXPECT_EQ(released[1], 2);
+        EXPECT_EQ(released[3], 1);
+
+        cache.insert(4, 40);
+    }
+
+    // The destructor releases what is left
+    EXPECT_EQ(released[4], 1);
+    EXPECT_EQ(released[1], 2);
+}
@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "em.h"
+#include "em_cmd.h"
+#include "em_sm.h"
+
+// Forces a state machine or an em into a state through legal transitions, found by a breadth first search
+template <typename T>
+static bool walk_to(T& sm, em_service_type_t service, em_state_t target)
+{
+    std::map<em_state_t, em_state_t> prev;
+    std::deque<em_state_t> queue;
+    std::vector<em_state_t> path;
+    const em_sm_state_desc_t *desc;
+    em_state_t state;
+    unsigned int i;
+
+    queue.push_back(sm.get_state());
+    prev[sm.get_state()] = sm.get_state();
+    while ((queue.empty() == false) && (prev.count(target) == 0)) {
+        state = queue.front();
+        queue.pop_front();
+        for (i = 0; (desc = em_sm_t::get_state_desc(service, i)) != NULL; i++) {
+            if ((prev.count(desc->state) == 0) && em_sm_t::is_legal_transition(state, desc->state)) {
+                prev[desc->state] = state;
+                queue.push_back(desc->state);
+            }
+        }
+    }
+    if (prev.count(target) == 0) {
+        return false;
+    }
+    for (state = target; state != sm.get_state(); state = prev[state]) {
+        path.insert(path.begin(), state);
+    }
+    for (auto s : path) {
+        sm.set_state(s);
+        if (sm.get_state() != s) {
+            return false;
+        }
+    }
+
+    return sm.get_state() == target;
+}
+
+TEST(EmSmTest, TableOrder) {
+    const em_sm_state_desc_t *desc;
+    unsigned int i;
+
+    for (i = 0; (desc = em_sm_t::get_state_desc(em_service_type_agent, i)) != NULL; i++) {
+        EXPECT_EQ(EM_SM_STATE_INDEX(desc->state), i);
+        EXPECT_LT(desc->state, em_state_ctrl_unconfigured);
+    }
+    EXPECT_EQ(i, EM_SM_STATE_INDEX(em_state_agent_ap_metrics_pending) + 1);
+
+    for (i = 0; (desc = em_sm_t::get_state_desc(em_service_type_ctrl, i)) != NULL; i++) {
+        EXPECT_EQ(EM_SM_STATE_INDEX(desc->state), i);
+        EXPECT_GE(desc->state, em_state_ctrl_unconfigured);
+    }
+    EXPECT_EQ(i, EM_SM_STATE_INDEX(em_state_ctrl_avail_spectrum_inquiry_pending) + 1);
+    EXPECT_LE(i, static_cast<unsigned int> (EM_SM_MAX_STATES));
+}
+
+// Every state with a deadline is reachable from the initial state and recovers through a legal transition
+TEST(EmSmTest, DeadlineStatesRecover) {
+    const em_service_type_t services[] = {em_service_type_agent, em_service_type_ctrl};
+    const em_sm_state_desc_t *desc;
+    unsigned int i;
+
+    for (auto service : services) {
+        for (i = 0; (desc = em_sm_t::get_state_desc(service, i)) != NULL; i++) {
+            if (desc->deadline == 0) {
+                EXPECT_EQ(desc->recovery, em_sm_recovery_none);
+                continue;
+            }
+            em_sm_t sm;
+            sm.init_sm(service);
+            EXPECT_TRUE(walk_to(sm, service, desc->state)) << "unreachable state 0x" << std::hex << desc->state;
+            EXPECT_TRUE(em_sm_t::is_legal_transition(desc->state, desc->recover_to))
+                << "illegal recovery from 0x" << std::hex << desc->state;
+        }
+    }
+}
+
+TEST(EmSmTest, IllegalTransitionsRejected) {
+    em_sm_t sm;
+
+    sm.init_sm(em_service_type_ctrl);
+    ASSERT_TRUE(walk_to(sm, em_service_type_ctrl, em_state_ctrl_configured));
+
+    // a stray AP MLD ack, an agent state, and skipping the channel query
+    EXPECT_EQ(sm.set_state(em_state_ctrl_ap_mld_req_ack_rcvd), -1);
+    EXPECT_EQ(sm.set_state(em_state_agent_configured), -1);
+    EXPECT_EQ(sm.set_state(em_state_ctrl_channel_queried), -1);
+    EXPECT_EQ(sm.get_state(), em_state_ctrl_configured);
+    EXPECT_EQ(sm.get_stats().rejected, 3u);
+
+    sm.init_sm(em_service_type_agent);
+    EXPECT_EQ(sm.set_state(em_state_agent_configured), -1);
+    EXPECT_EQ(sm.set_state(em_state_ctrl_configured), -1);
+    EXPECT_EQ(sm.set_state(em_state_agent_unconfigured), 0);
+}
+
+TEST(EmSmTest, DeadlineFires) {
+    em_state_t next = em_state_max;
+    unsigned long long start;
+    em_sm_t sm;
+
+    sm.init_sm(em_service_type_agent);
+    start = em_sm_t::now_ms();
+    ASSERT_EQ(sm.set_state(em_state_agent_autoconfig_rsp_pending), 0);
+
+    EXPECT_EQ(sm.check_deadline(start, &next), em_sm_recovery_none);
+    EXPECT_EQ(sm.check_deadline(start + EM_SM_CONFIG_DEADLINE * 1000 - 1000, &next), em_sm_recovery_none);
+    EXPECT_EQ(sm.check_deadline(start + EM_SM_CONFIG_DEADLINE * 1000 + 1000, &next), em_sm_recovery_restart_autoconfig);
+    EXPECT_EQ(next, em_state_agent_unconfigured);
+    EXPECT_EQ(sm.set_state(next), 0);
+    EXPECT_EQ(sm.check_deadline(start + EM_SM_CONFIG_DEADLINE * 2000, &next), em_sm_recovery_none);
+
+    EXPECT_EQ(sm.get_stats().timeouts, 1u);
+    EXPECT_EQ(sm.get_stats().states[EM_SM_STATE_INDEX(em_state_agent_autoconfig_rsp_pending)].timeouts, 1u);
+}
+
+TEST(EmSmTest, RecoverEntersTheRecoveryStateOnce) {
+    em_state_t from = em_state_max, next = em_state_max;
+    unsigned long long late;
+    em_sm_t sm;
+
+    sm.init_sm(em_service_type_agent);
+    late = em_sm_t::now_ms() + EM_SM_CONFIG_DEADLINE * 1000 + 1000;
+    ASSERT_EQ(sm.set_state(em_state_agent_autoconfig_rsp_pending), 0);
+
+    EXPECT_EQ(sm.recover(late, &from, &next), em_sm_recovery_restart_autoconfig);
+    EXPECT_EQ(from, em_state_agent_autoconfig_rsp_pending);
+    EXPECT_EQ(next, em_state_agent_unconfigured);
+    EXPECT_EQ(sm.get_state(), em_state_agent_unconfigured);
+
+    // Entering the state again restarts its deadline
+    ASSERT_EQ(sm.set_state(em_state_agent_autoconfig_rsp_pending), 0);
+    EXPECT_EQ(sm.recover(late - 2000, &from, &next), em_sm_recovery_none);
+    EXPECT_EQ(sm.get_state(), em_state_agent_autoconfig_rsp_pending);
+    EXPECT_EQ(sm.get_stats().timeouts, 1u);
+}
+
+TEST(EmSmTest, Stats) {
+    const em_sm_state_stats_t *configured;
+    em_sm_stats_t stats;
+    unsigned int dwell = 0, i;
+    em_sm_t sm;
+
+    sm.init_sm(em_service_type_agent);
+    ASSERT_TRUE(walk_to(sm, em_service_type_agent, em_state_agent_configured));
+    ASSERT_EQ(sm.set_state(em_state_agent_ap_metrics_pending), 0);
+    ASSERT_EQ(sm.set_state(em_state_agent_ap_metrics_pending), 0);
+    ASSERT_EQ(sm.set_state(em_state_agent_configured), 0);
+
+    stats = sm.get_stats();
+    configured = &stats.states[EM_SM_STATE_INDEX(em_state_agent_configured)];
+    EXPECT_EQ(configured->entered, 2u);
+    for (i = 0; i < EM_SM_NUM_DWELL_BUCKETS; i++) {
+        dwell += configured->dwell[i];
+    }
+    EXPECT_EQ(dwell, 1u);
+    EXPECT_EQ(sm.get_stats().states[EM_SM_STATE_INDEX(em_state_agent_ap_metrics_pending)].entered, 1u);
+    EXPECT_EQ(sm.get_stats().rejected, 0u);
+}
+
+// An em with its frames counted rather than sent, commands run through orch_execute() and the state
+// handlers of the em thread, so every transition below is one the handlers make themselves
+class EmSmHandlerTest : public ::testing::Test {
+protected:
+    class test_em_t : public em_t {
+    public:
+        unsigned int frames = 0;
+
+        int send_frame(unsigned char *buff, unsigned int len, bool multicast = false) override {
+            frames++;
+            return static_cast<int>(len);
+        }
+
+        test_em_t(em_interface_t *ruid, dm_easy_mesh_t *dm, em_service_type_t type) :
+            em_t(ruid, em_freq_band_5, dm, NULL, em_profile_type_3, type) { }
+    };
+
+    em_interface_t ruid;
+    dm_easy_mesh_t dm;
+
+    void SetUp() override {
+        const mac_address_t mac = {0x02, 0x00, 0x00, 0x00, 0x10, 0x01};
+
+        memset(&ruid, 0, sizeof(em_interface_t));
+        memcpy(ruid.mac, mac, sizeof(mac_address_t));
+        dm.init();
+        // the reports look the radio of the em up in the data model
+        dm.m_num_radios = 1;
+        memcpy(dm.m_radio[0].m_radio_info.intf.mac, mac, sizeof(mac_address_t));
+    }
+
+    void TearDown() override {
+        dm.deinit();
+    }
+
+    // Hands the command to the em and runs its state handler once, as em_orch_t and the em thread do
+    void run(test_em_t& em, em_cmd_type_t type) {
+        em_cmd_params_t param;
+        em_cmd_t *cmd;
+
+        memset(&param, 0, sizeof(em_cmd_params_t));
+        cmd = new em_cmd_t(type, param, dm);
+        em.orch_execute(cmd);
+        if (em.get_service_type() == em_service_type_agent) {
+            em.handle_agent_state();
+        } else {
+            em.handle_ctrl_state();
+        }
+        em.clear_cmd();
+        cmd->deinit();
+        delete cmd;
+    }
+};
+
+TEST_F(EmSmHandlerTest, AgentConfiguration) {
+    test_em_t em(&ruid, &dm, em_service_type_agent);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_agent, em_state_agent_configured));
+
+    // topology notify and back, with no client to report
+    run(em, em_cmd_type_sta_list);
+    EXPECT_EQ(em.get_state(), em_state_agent_configured);
+    EXPECT_EQ(em.get_sm_stats().states[EM_SM_STATE_INDEX(em_state_agent_topology_notify)].entered, 1u);
+    EXPECT_EQ(em.get_sm_stats().rejected, 0u);
+}
+
+TEST_F(EmSmHandlerTest, AgentChannel) {
+    test_em_t em(&ruid, &dm, em_service_type_agent);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_agent, em_state_agent_topo_synchronized));
+
+    // the preference report is sent and the agent waits for the selection
+    run(em, em_cmd_type_channel_pref_query);
+    EXPECT_EQ(em.get_state(), em_state_agent_channel_selection_pending);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_agent, em_state_agent_configured));
+    run(em, em_cmd_type_op_channel_report);
+    EXPECT_EQ(em.get_state(), em_state_agent_configured);
+
+    // no scan result to report
+    run(em, em_cmd_type_scan_result);
+    EXPECT_EQ(em.get_state(), em_state_agent_configured);
+    EXPECT_EQ(em.get_sm_stats().states[EM_SM_STATE_INDEX(em_state_agent_channel_scan_result_pending)].entered, 1u);
+    EXPECT_EQ(em.get_sm_stats().rejected, 0u);
+}
+
+TEST_F(EmSmHandlerTest, AgentMetrics) {
+    test_em_t em(&ruid, &dm, em_service_type_agent);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_agent, em_state_agent_configured));
+
+    run(em, em_cmd_type_sta_link_metrics);
+    EXPECT_EQ(em.get_state(), em_state_agent_configured);
+
+    run(em, em_cmd_type_ap_metrics_report);
+    EXPECT_EQ(em.get_state(), em_state_agent_configured);
+    EXPECT_EQ(em.frames, 1u);
+    EXPECT_EQ(em.get_sm_stats().states[EM_SM_STATE_INDEX(em_state_agent_ap_metrics_pending)].entered, 1u);
+    EXPECT_EQ(em.get_sm_stats().rejected, 0u);
+}
+
+TEST_F(EmSmHandlerTest, CtrlChannel) {
+    test_em_t em(&ruid, &dm, em_service_type_ctrl);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_ctrl, em_state_ctrl_topo_synchronized));
+
+    // the query is sent and the controller waits for the preference report
+    run(em, em_cmd_type_dev_test);
+    EXPECT_EQ(em.get_state(), em_state_ctrl_channel_pref_report_pending);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_ctrl, em_state_ctrl_configured));
+    em.frames = 0;
+    run(em, em_cmd_type_scan_channel);
+    EXPECT_EQ(em.get_state(), em_state_ctrl_configured);
+    EXPECT_EQ(em.frames, 1u);
+    EXPECT_EQ(em.get_sm_stats().rejected, 0u);
+}
+
+TEST_F(EmSmHandlerTest, CtrlMetrics) {
+    test_em_t em(&ruid, &dm, em_service_type_ctrl);
+
+    ASSERT_TRUE(walk_to(em, em_service_type_ctrl, em_state_ctrl_configured));
+
+    // the controller stays pending until the agent responds
+    run(em, em_cmd_type_sta_link_metrics);
+    EXPECT_EQ(em.get_state(), em_state_ctrl_sta_link_metrics_pending);
+    EXPECT_EQ(em.get_sm_stats().rejected, 0u);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include "em_fanout.h"
+
+// One target per agent, agents numbered from 0 in the last byte of @p base
+static std::vector<em_fanout_target_t> make_targets(const mac_address_t base, unsigned int num)
+{
+    std::vector<em_fanout_target_t> targets(num);
+    unsigned int i;
+
+    for (i = 0; i < num; i++) {
+        memcpy(targets[i].mac, base, sizeof(mac_address_t));
+        targets[i].mac[5] = static_cast<unsigned char>(base[5] + i);
+        targets[i].state = em_fanout_target_queued;
+    }
+
+    return targets;
+}
+
+TEST(EmFanoutTest, TestDispatchesWithinTheWindow) {
+    em_fanout_t fanout;
+    const mac_address_t agents = {0x02, 0x5e, 0x10, 0x00, 0x00, 0x10};
+    em_fanout_payload_t payload = std::make_shared<std::vector<unsigned char>>(64, 0xa5);
+    em_fanout_dispatch_t d;
+    unsigned int job;
+
+    job = fanout.start(em_cmd_type_set_policy, make_targets(agents, 5), payload, 2);
+    ASSERT_NE(job, 0u);
+
+    // One job of a type at a time
+    EXPECT_EQ(fanout.start(em_cmd_type_set_policy, make_targets(agents, 1), payload, 2), 0u);
+    EXPECT_TRUE(fanout.is_in_progress(em_cmd_type_set_policy));
+
+    ASSERT_TRUE(fanout.next(&d));
+    EXPECT_EQ(d.job, job);
+    EXPECT_EQ(d.index, 0u);
+    EXPECT_EQ(d.payload.get(), payload.get());
+    ASSERT_TRUE(fanout.next(&d));
+    EXPECT_EQ(d.mac[5], 0x11);
+    EXPECT_FALSE(fanout.next(&d));
+
+    // A finished target makes room for the next one, its outcome is reported once
+    EXPECT_TRUE(fanout.complete(job, 0, em_fanout_target_succeeded));
+    EXPECT_FALSE(fanout.complete(job, 0, em_fanout_target_failed));
+    EXPECT_FALSE(fanout.complete(job, 4, em_fanout_target_succeeded));
+    ASSERT_TRUE(fanout.next(&d));
+    EXPECT_EQ(d.index, 2u);
+    EXPECT_FALSE(fanout.next(&d));
+    EXPECT_EQ(fanout.get_stats().in_flight, 2u);
+}
+
+TEST(EmFanoutTest, TestReportsTheOutcomeOfEveryTarget) {
+    em_fanout_t fanout;
+    const mac_address_t agents = {0x00, 0x1b, 0x2c, 0x3d, 0x00, 0x40};
+    em_fanout_payload_t payload = std::make_shared<std::vector<unsigned char>>(32, 0);
+    em_fanout_dispatch_t d;
+    em_fanout_result_t result;
+    std::vector<em_fanout_result_t> done;
+    std::vector<em_fanout_target_t> targets;
+    unsigned int job;
+
+    job = fanout.start(em_cmd_type_set_policy, make_targets(agents, 3), payload, 0);
+    while (fanout.next(&d) == true);
+
+    EXPECT_TRUE(fanout.complete(job, 0, em_fanout_target_succeeded));
+    EXPECT_TRUE(fanout.complete(job, 1, em_fanout_target_failed));
+    EXPECT_EQ(fanout.expire(&done), 0u);
+    ASSERT_TRUE(fanout.get_result(job, &result));
+    EXPECT_FALSE(result.done);
+    EXPECT_EQ(result.in_flight, 1u);
+
+    // The job ends with its last target
+    EXPECT_TRUE(fanout.complete(job, 2, em_fanout_target_timed_out));
+    EXPECT_EQ(fanout.expire(&done), 1u);
+    ASSERT_EQ(done.size(), 1u);
+    EXPECT_TRUE(done[0].done);
+    EXPECT_EQ(done[0].succeeded, 1u);
+    EXPECT_EQ(done[0].failed, 1u);
+    EXPECT_EQ(done[0].timed_out, 1u);
+    EXPECT_FALSE(fanout.is_in_progress(em_cmd_type_set_policy));
+
+    // The outcome of each target is kept with the result once the job is gone
+    ASSERT_TRUE(fanout.get_result(job, &result));
+    EXPECT_EQ(result.num_targets, 3u);
+    ASSERT_TRUE(fanout.get_targets(job, &targets));
+    ASSERT_EQ(targets.size(), 3u);
+    EXPECT_EQ(targets[0].mac[5], 0x40);
+    EXPECT_EQ(targets[0].state, em_fanout_target_succeeded);
+    EXPECT_EQ(targets[1].state, em_fanout_target_failed);
+    EXPECT_EQ(targets[2].mac[5], 0x42);
+    EXPECT_EQ(targets[2].state, em_fanout_target_timed_out);
+    EXPECT_FALSE(fanout.get_targets(job + 1, &targets));
+
+    // The finished job released the payload
+    d.payload.reset();
+    EXPECT_EQ(payload.use_count(), 1);
+}
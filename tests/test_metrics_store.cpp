@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include "em_metrics_store.h"
+
+// Sample times are passed in explicitly, 0 would mean now
+static const long long base_ms = 1700000000000LL;
+static const mac_address_t sta = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+
+TEST(EmMetricsStoreTest, TestSamplesRoundTrip) {
+    em_metrics_store_t store(nullptr);
+    // Small and large, positive and negative deltas, so both zigzag signs and multi-byte varints are decoded
+    const long long vals[] = {0, 1, -1, 63, -64, 64, -65, 1LL << 40, -(1LL << 40), 7, 7, -300000};
+    const unsigned int num = sizeof(vals) / sizeof(vals[0]);
+    long long ts[num], out[num];
+    unsigned int i;
+
+    for (i = 0; i < num; i++) {
+        ASSERT_EQ(store.record(sta, em_metrics_id_sta_rcpi, vals[i], base_ms + i * 1500), 0);
+    }
+
+    ASSERT_EQ(store.get_samples(sta, em_metrics_id_sta_rcpi, ts, out, num), static_cast<int>(num));
+    for (i = 0; i < num; i++) {
+        EXPECT_EQ(ts[i], base_ms + i * 1500);
+        EXPECT_EQ(out[i], vals[i]);
+    }
+
+    EXPECT_EQ(store.get_stats()->num_samples, num);
+    EXPECT_EQ(store.get_samples(sta, em_metrics_id_sta_dl_rate, ts, out, num), -1);
+}
+
+TEST(EmMetricsStoreTest, TestEvictionAcrossWrap) {
+    em_metrics_store_t store(nullptr);
+    std::vector<long long> ts(EM_METRICS_RAW_BYTES), out(EM_METRICS_RAW_BYTES);
+    const unsigned int total = 4 * EM_METRICS_RAW_BYTES;
+    unsigned int i;
+    int num;
+
+    // Deltas of 2 to 6 bytes so samples straddle the end of the byte ring as it wraps several times
+    for (i = 0; i < total; i++) {
+        long long val = (i % 3 == 0) ? static_cast<long long>(i) * 100000 : -static_cast<long long>(i);
+        ASSERT_EQ(store.record(sta, em_metrics_id_sta_tx_bytes, val, base_ms + i * 1000), 0);
+    }
+
+    EXPECT_LE(store.get_stats()->raw_bytes, static_cast<unsigned long long>(EM_METRICS_RAW_BYTES));
+
+    num = store.get_samples(sta, em_metrics_id_sta_tx_bytes, ts.data(), out.data(), EM_METRICS_RAW_BYTES);
+    ASSERT_GT(num, 0);
+    EXPECT_EQ(static_cast<unsigned long long>(num), store.get_stats()->num_samples);
+
+    // The newest samples survive, contiguous and exact, the oldest were evicted
+    for (int j = 0; j < num; j++) {
+        i = total - num + j;
+        long long val = (i % 3 == 0) ? static_cast<long long>(i) * 100000 : -static_cast<long long>(i);
+        EXPECT_EQ(ts[j], base_ms + i * 1000LL);
+        EXPECT_EQ(out[j], val);
+    }
+}
+
+TEST(EmMetricsStoreTest, TestRollupBoundaries) {
+    const em_metrics_level_cfg_t levels[] = {{10, 3, true}};
+    std::vector<unsigned int> persisted;
+    em_metrics_store_t store([&persisted](const unsigned char *, em_metrics_id_t, unsigned int resolution, const em_metrics_bucket_t *bucket) {
+        EXPECT_EQ(resolution, 10u);
+        persisted.push_back(bucket->start);
+    }, levels, 1);
+    em_metrics_bucket_t buckets[8];
+    const unsigned int start = static_cast<unsigned int>(base_ms / 1000);
+
+    // The last ms of a bucket and the first ms of the next one land in different buckets
+    store.record(sta, em_metrics_id_bss_util, 5, base_ms + 9999);
+    store.record(sta, em_metrics_id_bss_util, 7, base_ms + 10000);
+    ASSERT_EQ(persisted.size(), 1u);
+    EXPECT_EQ(persisted[0], start);
+
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_bss_util, 10, buckets, 8), 2);
+    EXPECT_EQ(buckets[0].start, start);
+    EXPECT_EQ(buckets[0].count, 1u);
+    EXPECT_EQ(buckets[0].max, 5);
+    EXPECT_EQ(buckets[1].start, start + 10);
+    EXPECT_EQ(buckets[1].min, 7);
+
+    // flush() closes the open bucket only once its period is over
+    store.flush(base_ms + 19999);
+    EXPECT_EQ(persisted.size(), 1u);
+    store.flush(base_ms + 20000);
+    EXPECT_EQ(persisted.size(), 2u);
+
+    // Only closed buckets left, all of them fit even when the caller has room for exactly that many
+    store.record(sta, em_metrics_id_bss_util, 9, base_ms + 20000);
+    store.flush(base_ms + 30000);
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_bss_util, 10, buckets, 3), 3);
+    EXPECT_EQ(buckets[0].start, start);
+    EXPECT_EQ(buckets[2].start, start + 20);
+
+    // Past num_buckets the oldest closed bucket is overwritten, and a short buffer keeps the newest
+    store.record(sta, em_metrics_id_bss_util, 11, base_ms + 30000);
+    store.flush(base_ms + 40000);
+    store.record(sta, em_metrics_id_bss_util, 13, base_ms + 40000);
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_bss_util, 10, buckets, 8), 4);
+    EXPECT_EQ(buckets[0].start, start + 10);
+    EXPECT_EQ(buckets[2].start, start + 30);
+    EXPECT_EQ(buckets[3].start, start + 40);
+    EXPECT_EQ(buckets[3].count, 1u);
+
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_bss_util, 10, buckets, 2), 2);
+    EXPECT_EQ(buckets[0].start, start + 30);
+    EXPECT_EQ(buckets[1].start, start + 40);
+
+    EXPECT_EQ(store.get_rollups(sta, em_metrics_id_bss_util, 60, buckets, 8), -1);
+}
+
+TEST(EmMetricsStoreTest, TestBucketStatistics) {
+    const em_metrics_level_cfg_t levels[] = {{60, 4, false}};
+    em_metrics_store_t store(nullptr, levels, 1);
+    em_metrics_bucket_t bucket;
+    unsigned int i;
+
+    // Up to EM_METRICS_RESERVOIR samples the p95 is exact, nearest rank of 1..20 is 19
+    for (i = 1; i <= 20; i++) {
+        store.record(sta, em_metrics_id_radio_noise, 21 - i, base_ms + i * 100);
+    }
+
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_radio_noise, 60, &bucket, 1), 1);
+    EXPECT_EQ(bucket.count, 20u);
+    EXPECT_EQ(bucket.min, 1);
+    EXPECT_EQ(bucket.max, 20);
+    EXPECT_EQ(bucket.sum, 210);
+    EXPECT_EQ(bucket.p95, 19);
+
+    // Past the reservoir the p95 is an estimate drawn from the bucket's own samples
+    for (i = 0; i < 1000; i++) {
+        store.record(sta, em_metrics_id_radio_util, i % 100, base_ms + i);
+    }
+    ASSERT_EQ(store.get_rollups(sta, em_metrics_id_radio_util, 60, &bucket, 1), 1);
+    EXPECT_EQ(bucket.count, 1000u);
+    EXPECT_EQ(bucket.max, 99);
+    EXPECT_GE(bucket.p95, bucket.min);
+    EXPECT_LE(bucket.p95, bucket.max);
+}
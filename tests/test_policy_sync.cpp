@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "em_policy_sync.h"
+
+TEST(EmPolicySyncTest, TestSuppressesAcknowledgedValues) {
+    em_policy_sync_t sync;
+    const mac_address_t agent = {0x02, 0x11, 0x32, 0x00, 0x00, 0x01};
+    const mac_address_t ruid = {0x02, 0x11, 0x32, 0x00, 0x01, 0x00};
+    const mac_address_t other_ruid = {0x02, 0x11, 0x32, 0x00, 0x02, 0x00};
+    const unsigned char steering[] = {0x00, 0x00, 0x01, 0x02, 0x11, 0x32, 0x00, 0x01, 0x00, 0x01, 0x14, 0x50};
+    unsigned long long h = em_policy_sync_t::hash(steering, sizeof(steering));
+    unsigned short mid;
+
+    EXPECT_TRUE(sync.is_stale(agent, ruid, em_tlv_type_steering_policy, h));
+    mid = sync.next_mid(agent);
+    sync.set_sent(agent, ruid, em_tlv_type_steering_policy, h, mid);
+
+    // In flight with the same value, another value or another radio still goes out
+    EXPECT_FALSE(sync.is_stale(agent, ruid, em_tlv_type_steering_policy, h));
+    EXPECT_TRUE(sync.is_stale(agent, ruid, em_tlv_type_steering_policy, h + 1));
+    EXPECT_TRUE(sync.is_stale(agent, other_ruid, em_tlv_type_steering_policy, h));
+
+    EXPECT_TRUE(sync.ack(agent, mid));
+    EXPECT_FALSE(sync.is_stale(agent, ruid, em_tlv_type_steering_policy, h));
+    EXPECT_EQ(sync.get_stats()->acked, 1u);
+    EXPECT_EQ(sync.get_stats()->in_flight, 0u);
+
+    // The request is answered, a second Ack of it is not claimed
+    EXPECT_FALSE(sync.ack(agent, mid));
+}
+
+TEST(EmPolicySyncTest, TestLeavesOtherAcksToTheirExchange) {
+    em_policy_sync_t sync;
+    const mac_address_t agent = {0x44, 0xa5, 0x6e, 0x10, 0x20, 0x30};
+    const mac_address_t other_agent = {0x44, 0xa5, 0x6e, 0x10, 0x20, 0x31};
+    const mac_address_t ruid = {0x44, 0xa5, 0x6e, 0x10, 0x21, 0x00};
+    const unsigned char metrics[] = {0x05, 0x01, 0x44, 0xa5, 0x6e, 0x10, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00};
+    unsigned long long h = em_policy_sync_t::hash(metrics, sizeof(metrics));
+    unsigned short mid;
+    unsigned int i;
+
+    // Policy requests take their ids from their own range, away from the message types other requests use
+    for (i = 0; i < 8; i++) {
+        mid = sync.next_mid(agent);
+        EXPECT_GE(mid, EM_POLICY_SYNC_MID_BASE);
+        EXPECT_LT(mid, EM_POLICY_SYNC_MID_BASE + EM_POLICY_SYNC_MID_SPAN);
+    }
+    sync.set_sent(agent, ruid, em_tlv_type_metric_reporting_policy, h, mid);
+
+    // Acks of a steering request, an MLD request or an id never sent pass through
+    EXPECT_FALSE(sync.ack(agent, em_msg_type_client_steering_req));
+    EXPECT_FALSE(sync.ack(agent, em_msg_type_ap_mld_config_req));
+    EXPECT_FALSE(sync.ack(agent, static_cast<unsigned short> (mid + 1)));
+    EXPECT_FALSE(sync.ack(other_agent, mid));
+    EXPECT_EQ(sync.get_stats()->in_flight, 1u);
+
+    EXPECT_TRUE(sync.ack(agent, mid));
+    EXPECT_EQ(sync.get_stats()->in_flight, 0u);
+}
+
+TEST(EmPolicySyncTest, TestLateAckOfARetriedRequest) {
+    em_policy_sync_t sync;
+    const mac_address_t agent = {0x00, 0x90, 0x4c, 0x00, 0x00, 0x0a};
+    const mac_address_t ruid = {0x00, 0x90, 0x4c, 0x00, 0x0a, 0x01};
+    const unsigned char vendor[] = {0x00, 0x90, 0x4c, 'm', 'a', 'r', 'k', 'e', 'r'};
+    unsigned long long h = em_policy_sync_t::hash(vendor, sizeof(vendor));
+    unsigned short first, retry;
+
+    first = sync.next_mid(agent);
+    sync.set_sent(agent, ruid, em_tlv_vendor_plolicy_cfg, h, first);
+    retry = sync.next_mid(agent);
+    sync.set_sent(agent, ruid, em_tlv_vendor_plolicy_cfg, h, retry);
+    EXPECT_NE(first, retry);
+    EXPECT_EQ(sync.get_stats()->retries, 1u);
+
+    // The agent got the value with the first request, its Ack is enough
+    EXPECT_TRUE(sync.ack(agent, first));
+    EXPECT_FALSE(sync.is_stale(agent, ruid, em_tlv_vendor_plolicy_cfg, h));
+    EXPECT_EQ(sync.get_stats()->acked, 1u);
+
+    // The Ack of the retry is still claimed, there is nothing left to acknowledge
+    EXPECT_TRUE(sync.ack(agent, retry));
+    EXPECT_EQ(sync.get_stats()->acked, 1u);
+}
+
+TEST(EmPolicySyncTest, TestForgetResendsEveryTlvOfTheRadio) {
+    em_policy_sync_t sync;
+    const mac_address_t agent = {0xd8, 0x3a, 0xdd, 0x00, 0x10, 0x00};
+    const mac_address_t ruid_2g = {0xd8, 0x3a, 0xdd, 0x00, 0x10, 0x01};
+    const mac_address_t ruid_5g = {0xd8, 0x3a, 0xdd, 0x00, 0x10, 0x02};
+    const unsigned char steering[] = {0x00, 0x00, 0x02, 0xd8, 0x3a, 0xdd, 0x00, 0x10, 0x01, 0x00, 0x1e, 0x64};
+    unsigned long long h = em_policy_sync_t::hash(steering, sizeof(steering));
+    unsigned short mid;
+
+    mid = sync.next_mid(agent);
+    sync.set_sent(agent, ruid_2g, em_tlv_type_steering_policy, h, mid);
+    sync.set_sent(agent, ruid_5g, em_tlv_type_steering_policy, h, mid);
+    EXPECT_TRUE(sync.ack(agent, mid));
+    EXPECT_EQ(sync.get_stats()->acked, 2u);
+
+    sync.forget(agent, ruid_2g);
+    EXPECT_TRUE(sync.is_stale(agent, ruid_2g, em_tlv_type_steering_policy, h));
+    EXPECT_FALSE(sync.is_stale(agent, ruid_5g, em_tlv_type_steering_policy, h));
+
+    // A value changed since it was sent is not acknowledged by the Ack of the old one
+    mid = sync.next_mid(agent);
+    sync.set_sent(agent, ruid_5g, em_tlv_type_steering_policy, h + 1, mid);
+    sync.set_sent(agent, ruid_5g, em_tlv_type_steering_policy, h + 2, sync.next_mid(agent));
+    EXPECT_TRUE(sync.ack(agent, mid));
+    EXPECT_TRUE(sync.is_stale(agent, ruid_5g, em_tlv_type_steering_policy, h + 1));
+    EXPECT_EQ(sync.get_stats()->retries, 0u);
+    EXPECT_EQ(sync.get_stats()->in_flight, 1u);
+}
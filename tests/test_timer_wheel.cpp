@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "em_timer.h"
+
+static long long elapsed_ms(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000LL + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+// Drives the wheel the way em_mgr_t does, sleeping for get_wait_ms() between runs, for @p ms
+static void run_for(em_timer_wheel_t& wheel, unsigned int ms)
+{
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (elapsed_ms(&start) < ms) {
+        usleep(wheel.get_wait_ms(5) * 1000);
+        wheel.run();
+    }
+}
+
+TEST(EmTimerWheelTest, TestInsertionOrder) {
+    em_timer_wheel_t wheel;
+    std::vector<int> fired;
+
+    wheel.add(60, false, [&fired]() { fired.push_back(60); });
+    wheel.add(20, false, [&fired]() { fired.push_back(20); });
+    wheel.add(40, false, [&fired]() { fired.push_back(40); });
+    EXPECT_EQ(wheel.count(), 3u);
+
+    // Nothing is due before the first deadline
+    EXPECT_EQ(wheel.run(), 0u);
+    EXPECT_GT(wheel.get_wait_ms(1000), 0u);
+
+    run_for(wheel, 120);
+    ASSERT_EQ(fired.size(), 3u);
+    EXPECT_EQ(fired[0], 20);
+    EXPECT_EQ(fired[1], 40);
+    EXPECT_EQ(fired[2], 60);
+
+    // One-shot timers are gone once they ran
+    EXPECT_EQ(wheel.count(), 0u);
+    EXPECT_EQ(wheel.get_wait_ms(1000), 1000u);
+}
+
+TEST(EmTimerWheelTest, TestCascadeFromUpperLevel) {
+    em_timer_wheel_t wheel;
+    struct timespec start;
+    long long fired_at = -1;
+
+    // Past EM_TIMER_SLOTS ticks the timer starts on level 1 and has to cascade down to fire
+    const unsigned int delay = (EM_TIMER_SLOTS + 16) * EM_TIMER_TICK_MS;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    wheel.add(delay, false, [&fired_at, &start]() { fired_at = elapsed_ms(&start); });
+
+    run_for(wheel, delay - 100);
+    EXPECT_EQ(fired_at, -1);
+
+    run_for(wheel, 200);
+    // Deadlines are counted in whole ticks from the tick the timer was added in
+    EXPECT_GE(fired_at, static_cast<long long>(delay - EM_TIMER_TICK_MS));
+    EXPECT_LT(fired_at, static_cast<long long>(delay + 50));
+}
+
+TEST(EmTimerWheelTest, TestCancel) {
+    em_timer_wheel_t wheel;
+    int fired = 0;
+    unsigned int id, upper_id;
+
+    id = wheel.add(20, false, [&fired]() { fired++; });
+    upper_id = wheel.add((EM_TIMER_SLOTS + 4) * EM_TIMER_TICK_MS, false, [&fired]() { fired++; });
+    EXPECT_NE(id, static_cast<unsigned int>(EM_TIMER_INVALID_ID));
+    EXPECT_NE(id, upper_id);
+
+    EXPECT_EQ(wheel.cancel(id), 0);
+    EXPECT_EQ(wheel.cancel(upper_id), 0);
+    EXPECT_EQ(wheel.count(), 0u);
+
+    // A second cancel and an unknown id are reported
+    EXPECT_EQ(wheel.cancel(id), -1);
+    EXPECT_EQ(wheel.cancel(EM_TIMER_INVALID_ID), -1);
+
+    run_for(wheel, 60);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST(EmTimerWheelTest, TestPeriodicRearm) {
+    em_timer_wheel_t wheel;
+    int fired = 0;
+    unsigned int id;
+
+    id = wheel.add(20, true, [&fired]() { fired++; });
+
+    run_for(wheel, 110);
+    // Re-armed from its deadline, so five periods fit in 110 ms
+    EXPECT_GE(fired, 4);
+    EXPECT_LE(fired, 5);
+    EXPECT_EQ(wheel.count(), 1u);
+
+    EXPECT_EQ(wheel.cancel(id), 0);
+    fired = 0;
+    run_for(wheel, 60);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST(EmTimerWheelTest, TestCancelFromOwnCallback) {
+    em_timer_wheel_t wheel;
+    int fired = 0;
+    unsigned int id = EM_TIMER_INVALID_ID;
+
+    id = wheel.add(10, true, [&wheel, &fired, &id]() {
+        if (++fired == 3) {
+            EXPECT_EQ(wheel.cancel(id), 0);
+        }
+    });
+
+    run_for(wheel, 100);
+    EXPECT_EQ(fired, 3);
+    EXPECT_EQ(wheel.count(), 0u);
+}
+
+TEST(EmTimerWheelTest, TestRearmFromCallback) {
+    em_timer_wheel_t wheel;
+    int fired = 0;
+    em_timer_cb_t cb;
+
+    // A one-shot timer arming its successor, the way a retry loop does
+    cb = [&wheel, &fired, &cb]() {
+        if (++fired < 3) {
+            wheel.add(10, false, cb);
+        }
+    };
+    wheel.add(10, false, cb);
+
+    run_for(wheel, 100);
+    EXPECT_EQ(fired, 3);
+    EXPECT_EQ(wheel.count(), 0u);
+}
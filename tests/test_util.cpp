@@ -72,3 +72,82 @@ TEST_F(EmUtilByteOrderTest, TestSetNetUint16) {
     #pragma GCC diagnostic pop
     EXPECT_EQ(bad_mut_struct.data16, net_val16);
 }
+
+// The operating class table as util::em_chan_to_freq() / em_freq_to_chan() scanned it before the lookup tables
+class EmUtilFreqTableTest : public ::testing::Test {
+protected:
+    struct freq_range {
+        uint8_t op_class;
+        uint8_t min_chan;
+        uint8_t max_chan;
+        uint16_t base_freq;
+        uint16_t spacing;
+        std::string region;  // "" for global
+    };
+
+    static std::vector<freq_range> legacy_ranges() {
+        const char *names[em_freq_region_max] = { "", "US", "EU", "JP", "CN", "" };
+        std::vector<freq_range> ranges;
+        for (const em_freq_range_t& r : em_freq_ranges) {
+            ranges.push_back({r.op_class, r.min_chan, r.max_chan, r.base_freq, r.spacing, names[r.region]});
+        }
+        return ranges;
+    }
+
+    static int legacy_chan_to_freq(const std::vector<freq_range>& ranges, uint8_t op_class, uint8_t channel, const std::string& region) {
+        for (const auto& range : ranges) {
+            if ((range.region.empty() || range.region == region) &&
+                range.op_class == op_class &&
+                channel >= range.min_chan &&
+                channel <= range.max_chan) {
+                return range.base_freq + (channel * range.spacing);
+            }
+        }
+        return -1;
+    }
+
+    static std::pair<uint8_t, uint8_t> legacy_freq_to_chan(const std::vector<freq_range>& ranges, unsigned int frequency, const std::string& region) {
+        std::pair<uint8_t, uint8_t> global_result;
+
+        for (const auto& range : ranges) {
+            unsigned int min_freq = static_cast<unsigned int>(range.base_freq + (range.min_chan * range.spacing));
+            unsigned int max_freq = static_cast<unsigned int>(range.base_freq + (range.max_chan * range.spacing));
+            if (frequency < min_freq || frequency > max_freq) continue;
+            if ((frequency - range.base_freq) % range.spacing != 0) continue;
+            unsigned int channel_calc = (frequency - range.base_freq) / range.spacing;
+            if (channel_calc < range.min_chan || channel_calc > range.max_chan) continue;
+
+            auto result = std::make_pair(range.op_class, static_cast<uint8_t>(channel_calc));
+            if (range.region == region) return result;
+            if (range.region.empty()) {
+                global_result = result;
+            }
+        }
+        return global_result;
+    }
+
+    const std::vector<std::string> regions = { "", "US", "EU", "JP", "CN", "DE" };
+};
+
+TEST_F(EmUtilFreqTableTest, ChanToFreqMatchesScan) {
+    auto ranges = legacy_ranges();
+    for (const auto& region : regions) {
+        for (unsigned int op_class = 0; op_class <= 0xff; op_class++) {
+            for (unsigned int chan = 0; chan <= 0xff; chan++) {
+                uint8_t op = static_cast<uint8_t>(op_class), ch = static_cast<uint8_t>(chan);
+                ASSERT_EQ(util::em_chan_to_freq(op, ch, region), legacy_chan_to_freq(ranges, op, ch, region))
+                    << "region '" << region << "' op class " << op_class << " channel " << chan;
+            }
+        }
+    }
+}
+
+TEST_F(EmUtilFreqTableTest, FreqToChanMatchesScan) {
+    auto ranges = legacy_ranges();
+    for (const auto& region : regions) {
+        for (unsigned int freq = 0; freq <= 130000; freq++) {
+            ASSERT_EQ(util::em_freq_to_chan(freq, region), legacy_freq_to_chan(ranges, freq, region))
+                << "region '" << region << "' frequency " << freq;
+        }
+    }
+}